@@ -0,0 +1,133 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_BENCH_H
+#define LCC_BENCH_H
+
+#include <atomic>
+#include <string>
+#include <utils/Histogram.h>
+
+namespace Bench {
+    /**
+     * 压测参数
+     */
+    struct Config {
+        // 传输方式: tcp/tls/ws/wss/unix
+        std::string transport;
+        // 外部服务地址(host:port, unix时为套接字路径), 为空时在进程内启动回显服务
+        std::string target;
+        // 进程内回显服务的端口
+        unsigned short port;
+        // 并发连接数
+        unsigned int connections;
+        // 压测线程数, 连接平均分配到各线程
+        unsigned int threads;
+        // 消息长度
+        unsigned int size;
+        // 每个连接每秒发送的消息数, 0表示收到回显后立即发送下一条(闭环)
+        unsigned int rate;
+        // 闭环模式下每个连接同时在途的消息数
+        unsigned int window;
+        // 预热与统计时长(秒)
+        double warmup;
+        double duration;
+        // 证书与私钥(tls/wss), 客户端同时以该证书作为信任的根证书校验服务端
+        std::string cert;
+        std::string key;
+        // 结果输出文件, 为空时输出到标准输出
+        std::string output;
+
+        Config() : transport("tcp"), port(18500), connections(64), threads(1), size(64), rate(0), window(1),
+                   warmup(1.0), duration(5.0) {
+        }
+
+        /**
+         * 获取客户端连接地址
+         * @return 地址
+         */
+        std::string ClientUrl() const;
+
+        /**
+         * 获取进程内回显服务的监听地址
+         * @return 地址
+         */
+        std::string ListenUrl() const;
+
+        /**
+         * 获取服务端主机名, 用于TLS校验
+         * @return 主机名
+         */
+        std::string Host() const;
+
+        /**
+         * 是否需要TLS
+         * @return 是否需要
+         */
+        bool Tls() const {
+            return transport == "tls" || transport == "wss";
+        }
+
+        /**
+         * 是否需要WebSocket
+         * @return 是否需要
+         */
+        bool WebSocket() const {
+            return transport == "ws" || transport == "wss";
+        }
+
+        /**
+         * 是否使用本机unix域套接字
+         * @return 是否使用
+         */
+        bool Unix() const {
+            return transport == "unix";
+        }
+    };
+
+    /**
+     * 单个压测线程的统计, 线程结束后由主线程合并
+     */
+    struct Stats {
+        // 连接成功与失败数
+        std::atomic<unsigned int> connected;
+        std::atomic<unsigned int> failed;
+        // 已完全关闭的连接数
+        std::atomic<unsigned int> closed;
+        // 首个连接发起与最后一个连接建立的时间
+        unsigned long long connectBegin;
+        unsigned long long connectEnd;
+        // 统计窗口内完成的消息数与字节数
+        unsigned long long messages;
+        unsigned long long bytes;
+        // 统计窗口内发送的消息数
+        unsigned long long sent;
+        // 连接异常断开数
+        unsigned long long errors;
+        // 往返延迟(纳秒)
+        Lcc::Utils::Histogram latency;
+
+        Stats() : connected(0), failed(0), closed(0), connectBegin(0), connectEnd(0), messages(0), bytes(0), sent(0),
+                  errors(0) {
+        }
+    };
+
+    /**
+     * 发给压测线程的命令
+     */
+    struct Command {
+        enum class Type {
+            // 开始发送, 只统计[start, end)内计划发送的消息
+            Start,
+            // 停止发送并关闭连接
+            Stop,
+        };
+
+        Type type;
+        unsigned long long start;
+        unsigned long long end;
+    };
+}
+
+#endif //LCC_BENCH_H
@@ -0,0 +1,79 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <network/plugin/MbedTLSPlugin.h>
+#include <network/plugin/WebSocketPlugin.h>
+#include "EchoServer.h"
+
+namespace Bench {
+    EchoServer::EchoServer(const Config &config) : _config(config), _listen(0), _server(this) {
+    }
+
+    EchoServer::~EchoServer() = default;
+
+    int EchoServer::ListenState() const {
+        return _listen.load();
+    }
+
+    void EchoServer::Stop() {
+        QueueMessage(this);
+    }
+
+    bool EchoServer::IInit() {
+        if (_config.WebSocket()) {
+            auto websocket = new Lcc::WebSocketPluginCreator;
+            websocket->InitializeServerMode(Lcc::WebSocketOpcode::Binary);
+            _server.Enable(websocket);
+        }
+        if (_config.Tls()) {
+            auto ssl = new Lcc::MbedTLSPluginCreator;
+            if (!ssl->InitializeServerMode(_config.cert.c_str(), _config.key.c_str(), "")) {
+                delete ssl;
+                _listen = -1;
+                return false;
+            }
+            _server.Enable(ssl);
+        }
+        const std::string host = _config.ListenUrl();
+        if (_config.Unix()) {
+            // 清理上次异常退出遗留的套接字文件
+            unlink(host.c_str() + strlen("unix://"));
+        }
+        _server.Listen(host.c_str());
+        return true;
+    }
+
+    void EchoServer::IMessage(void *message) {
+        _server.Shutdown();
+    }
+
+    void EchoServer::IShutdown() {
+    }
+
+    bool EchoServer::IServerInit(Lcc::StreamHandle &handle) {
+        return handle.Init(GetEventLoop()) == 0;
+    }
+
+    void EchoServer::IServerListenReport(bool listened, int err, const char *errMsg) {
+        _listen = listened ? 1 : -1;
+    }
+
+    void EchoServer::IServerShutdown() {
+    }
+
+    void EchoServer::IServerSessionOpen(unsigned int session) {
+    }
+
+    void EchoServer::IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) {
+        _server.SessionWrite(session, buf, size);
+    }
+
+    void EchoServer::IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) {
+    }
+
+    void EchoServer::IServerSessionAfterClose(unsigned int session) {
+    }
+}
@@ -0,0 +1,63 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_BENCH_ECHOSERVER_H
+#define LCC_BENCH_ECHOSERVER_H
+
+#include <atomic>
+#include <thread/Thread.h>
+#include <network/TcpServer.h>
+#include "Bench.h"
+
+namespace Bench {
+    /**
+     * 进程内回显服务, 独占一个线程, 收到的数据原样写回
+     */
+    class EchoServer final : public Lcc::Thread, public Lcc::ServerImplement {
+    public:
+        explicit EchoServer(const Config &config);
+
+        ~EchoServer() override;
+
+        /**
+         * 获取监听状态
+         * @return 0为尚未报告, 1为成功, -1为失败
+         */
+        int ListenState() const;
+
+        /**
+         * 请求关闭监听与全部会话
+         */
+        void Stop();
+
+    protected:
+        bool IInit() override;
+
+        void IMessage(void *message) override;
+
+        void IShutdown() override;
+
+    protected:
+        bool IServerInit(Lcc::StreamHandle &handle) override;
+
+        void IServerListenReport(bool listened, int err, const char *errMsg) override;
+
+        void IServerShutdown() override;
+
+        void IServerSessionOpen(unsigned int session) override;
+
+        void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override;
+
+        void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override;
+
+        void IServerSessionAfterClose(unsigned int session) override;
+
+    private:
+        const Config &_config;
+        std::atomic<int> _listen;
+        Lcc::TcpServer _server;
+    };
+}
+
+#endif //LCC_BENCH_ECHOSERVER_H
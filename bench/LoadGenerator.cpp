@@ -0,0 +1,186 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <network/plugin/MbedTLSPlugin.h>
+#include "LoadGenerator.h"
+
+namespace Bench {
+    static const unsigned long long kNanoPerSecond = 1000000000ULL;
+
+    Connection::Connection(LoadGenerator *owner, unsigned int session) : _connected(false), _reported(false), _closing(false),
+                                                                         _session(session), _received(0),
+                                                                         _nextSend(0), _owner(owner),
+                                                                         _client(this) {
+    }
+
+    Connection::~Connection() = default;
+
+    void Connection::Connect(const std::string &url) {
+        if (_owner->_config.WebSocket()) {
+            _client.EnableWebSocketOpcode(Lcc::WebSocketOpcode::Binary);
+        }
+        if (_owner->_config.Tls()) {
+            auto ssl = new Lcc::MbedTLSPluginCreator;
+            ssl->InitializeClientMode(_owner->_config.Host().c_str(), _owner->_config.cert.c_str());
+            _client.Enable(ssl);
+        }
+        _client.Connect(url.c_str());
+    }
+
+    void Connection::Send(unsigned long long scheduled) {
+        if (scheduled >= _owner->_start && scheduled < _owner->_end) {
+            ++_owner->_stats.sent;
+        }
+        _inflight.push_back(scheduled);
+        _client.Write(_owner->_payload.data(), static_cast<unsigned int>(_owner->_payload.size()));
+    }
+
+    void Connection::Close() {
+        _closing = true;
+        _client.Shutdown();
+    }
+
+    bool Connection::IClientInit(Lcc::StreamHandle &handle) {
+        handle.tcpSession = _session;
+        return handle.Init(_owner->GetEventLoop()) == 0;
+    }
+
+    void Connection::IClientReport(bool connected, const char *err) {
+        _connected = connected;
+        _reported = true;
+        _owner->OnConnect(connected);
+    }
+
+    void Connection::IClientReceive(const char *buf, unsigned int size) {
+        const unsigned int message = static_cast<unsigned int>(_owner->_payload.size());
+        _received += size;
+        while (_received >= message && !_inflight.empty()) {
+            _received -= message;
+            const unsigned long long scheduled = _inflight.front();
+            _inflight.pop_front();
+            _owner->OnComplete(this, scheduled);
+        }
+    }
+
+    void Connection::IClientBeforeDisconnect(int err, const char *errMsg) {
+        _connected = false;
+    }
+
+    void Connection::IClientAfterDisconnect() {
+        if (!_reported) {
+            // 握手(TLS/WebSocket)失败时连接直接关闭, 没有连接结果的报告
+            _reported = true;
+            _owner->OnConnect(false);
+            return;
+        }
+        _owner->OnClose(!_closing);
+    }
+
+    LoadGenerator::LoadGenerator(const Config &config, unsigned int first, unsigned int count) : _config(config),
+        _first(first), _count(count), _sending(false), _start(0), _end(0), _period(0), _timer(),
+        _payload(config.size, 'x') {
+    }
+
+    LoadGenerator::~LoadGenerator() {
+        for (auto connection: _connections) {
+            delete connection;
+        }
+    }
+
+    Stats &LoadGenerator::GetStats() {
+        return _stats;
+    }
+
+    bool LoadGenerator::IInit() {
+        uv_timer_init(GetEventLoop(), &_timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_timer), this);
+        const std::string url = _config.ClientUrl();
+        _stats.connectBegin = uv_hrtime();
+        for (unsigned int n = 0; n < _count; ++n) {
+            auto connection = new Connection(this, _first + n + 1);
+            _connections.emplace_back(connection);
+            connection->Connect(url);
+        }
+        return true;
+    }
+
+    void LoadGenerator::IMessage(void *message) {
+        auto command = static_cast<Command *>(message);
+        if (command->type == Command::Type::Start) {
+            _start = command->start;
+            _end = command->end;
+            _sending = true;
+            const unsigned long long now = uv_hrtime();
+            if (_config.rate > 0) {
+                // 各连接的发送时间错开, 避免同一毫秒集中发送
+                _period = kNanoPerSecond / _config.rate;
+                for (size_t n = 0; n < _connections.size(); ++n) {
+                    _connections[n]->_nextSend = now + _period * n / _connections.size();
+                }
+                uv_timer_start(&_timer, LoadGenerator::UvTickCallback, 0, 1);
+            } else {
+                for (auto connection: _connections) {
+                    for (unsigned int n = 0; connection->_connected && n < _config.window; ++n) {
+                        connection->Send(now);
+                    }
+                }
+            }
+        } else {
+            _sending = false;
+            uv_timer_stop(&_timer);
+            for (auto connection: _connections) {
+                connection->Close();
+            }
+        }
+        delete command;
+    }
+
+    void LoadGenerator::IShutdown() {
+        uv_close(reinterpret_cast<uv_handle_t *>(&_timer), nullptr);
+    }
+
+    void LoadGenerator::OnConnect(bool connected) {
+        if (connected) {
+            _stats.connectEnd = uv_hrtime();
+            ++_stats.connected;
+        } else {
+            ++_stats.failed;
+        }
+    }
+
+    void LoadGenerator::OnComplete(Connection *connection, unsigned long long scheduled) {
+        const unsigned long long now = uv_hrtime();
+        if (scheduled >= _start && scheduled < _end) {
+            ++_stats.messages;
+            _stats.bytes += _payload.size();
+            _stats.latency.Record(now - scheduled);
+        }
+        if (_sending && _config.rate == 0 && now < _end) {
+            connection->Send(now);
+        }
+    }
+
+    void LoadGenerator::OnClose(bool error) {
+        if (error) {
+            ++_stats.errors;
+        }
+        ++_stats.closed;
+    }
+
+    void LoadGenerator::Tick() {
+        const unsigned long long now = uv_hrtime();
+        for (auto connection: _connections) {
+            while (connection->_connected && connection->_nextSend <= now && connection->_nextSend < _end) {
+                connection->Send(connection->_nextSend);
+                connection->_nextSend += _period;
+            }
+        }
+        if (now >= _end) {
+            uv_timer_stop(&_timer);
+        }
+    }
+
+    void LoadGenerator::UvTickCallback(uv_timer_t *handle) {
+        static_cast<LoadGenerator *>(uv_handle_get_data(reinterpret_cast<uv_handle_t *>(handle)))->Tick();
+    }
+}
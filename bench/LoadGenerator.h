@@ -0,0 +1,137 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_BENCH_LOADGENERATOR_H
+#define LCC_BENCH_LOADGENERATOR_H
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <thread/Thread.h>
+#include <network/TcpClient.h>
+#include "Bench.h"
+
+namespace Bench {
+    class LoadGenerator;
+
+    /**
+     * 单个压测连接, 按字节数匹配回显: 回显按发送顺序返回, 每收满一条消息的长度即完成最早的一条
+     */
+    class Connection final : public Lcc::ClientImplement {
+    public:
+        Connection(LoadGenerator *owner, unsigned int session);
+
+        ~Connection() override;
+
+        /**
+         * 发起连接
+         * @param url 地址
+         */
+        void Connect(const std::string &url);
+
+        /**
+         * 发送一条消息
+         * @param scheduled 计划发送时间, 延迟从该时间算起, 避免限速模式下的协同遗漏
+         */
+        void Send(unsigned long long scheduled);
+
+        /**
+         * 关闭连接
+         */
+        void Close();
+
+    protected:
+        bool IClientInit(Lcc::StreamHandle &handle) override;
+
+        void IClientReport(bool connected, const char *err) override;
+
+        void IClientReceive(const char *buf, unsigned int size) override;
+
+        void IClientBeforeDisconnect(int err, const char *errMsg) override;
+
+        void IClientAfterDisconnect() override;
+
+    private:
+        friend class LoadGenerator;
+
+        bool _connected;
+        // 是否已报告过连接结果
+        bool _reported;
+        bool _closing;
+        unsigned int _session;
+        unsigned int _received;
+        // 下一条消息的计划发送时间(限速模式)
+        unsigned long long _nextSend;
+        LoadGenerator *_owner;
+        std::deque<unsigned long long> _inflight;
+        Lcc::TcpClient _client;
+    };
+
+    /**
+     * 压测线程, 持有一组连接, 在线程事件循环上收发
+     */
+    class LoadGenerator final : public Lcc::Thread {
+    public:
+        LoadGenerator(const Config &config, unsigned int first, unsigned int count);
+
+        ~LoadGenerator() override;
+
+        /**
+         * 获取统计, 线程运行期间只能读取原子字段
+         * @return 统计
+         */
+        Stats &GetStats();
+
+    protected:
+        bool IInit() override;
+
+        void IMessage(void *message) override;
+
+        void IShutdown() override;
+
+    private:
+        friend class Connection;
+
+        /**
+         * 连接建立或失败
+         * @param connected 是否成功
+         */
+        void OnConnect(bool connected);
+
+        /**
+         * 一条消息完成往返
+         * @param connection 连接
+         * @param scheduled 计划发送时间
+         */
+        void OnComplete(Connection *connection, unsigned long long scheduled);
+
+        /**
+         * 连接关闭
+         * @param error 是否异常断开
+         */
+        void OnClose(bool error);
+
+        /**
+         * 限速模式下补发到期的消息
+         */
+        void Tick();
+
+        static void UvTickCallback(uv_timer_t *handle);
+
+    private:
+        const Config &_config;
+        unsigned int _first;
+        unsigned int _count;
+        bool _sending;
+        unsigned long long _start;
+        unsigned long long _end;
+        unsigned long long _period;
+        uv_timer_t _timer;
+        Stats _stats;
+        std::string _payload;
+        std::vector<Connection *> _connections;
+    };
+}
+
+#endif //LCC_BENCH_LOADGENERATOR_H
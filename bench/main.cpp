@@ -0,0 +1,234 @@
+//
+// Created by liao on 2026/10/19.
+//
+// 回显压测: 对TcpServer/TcpClient做吞吐与往返延迟测试, 结果输出为JSON, 便于各版本之间对比
+//   LccBench --transport tcp|tls|ws|wss|unix --connections 64 --threads 1 --size 64 --rate 0 --window 1
+//            --warmup 1 --duration 5 [--target host:port] [--port 18500] [--cert file --key file] [--output file]
+// rate为0时为闭环模式(每个连接保持window条在途消息), 否则按每个连接每秒rate条定速发送
+// unix与tcp使用相同参数各跑一次, 即可对比本机进程间走unix域套接字与走回环TCP的延迟和吞吐
+//
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <csignal>
+#include <uv.h>
+#include "Bench.h"
+#include "EchoServer.h"
+#include "LoadGenerator.h"
+
+namespace Bench {
+    /**
+     * 进程内回显服务的unix域套接字路径, 按端口区分以便同时运行多个实例
+     */
+    static std::string SocketPath(unsigned short port) {
+        return "/tmp/lcc-bench-" + std::to_string(port) + ".sock";
+    }
+
+    std::string Config::ClientUrl() const {
+        if (Unix()) {
+            return "unix://" + (target.empty() ? SocketPath(port) : target);
+        }
+        // TLS由连接自行启用(需要指定根证书), 地址中只区分是否WebSocket
+        const std::string scheme = WebSocket() ? "ws://" : "tcp://";
+        return scheme + (target.empty() ? "127.0.0.1:" + std::to_string(port) : target);
+    }
+
+    std::string Config::ListenUrl() const {
+        return Unix() ? "unix://" + SocketPath(port) : "tcp://127.0.0.1:" + std::to_string(port);
+    }
+
+    std::string Config::Host() const {
+        return target.empty() ? "127.0.0.1" : target.substr(0, target.rfind(':'));
+    }
+}
+
+static const unsigned long long kNanoPerSecond = 1000000000ULL;
+// 等待连接建立与关闭的最长时间(秒)
+static const unsigned long long kPhaseTimeout = 30;
+
+static void Usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [--transport tcp|tls|ws|wss|unix] [--connections N] [--threads N] [--size BYTES]\n"
+            "          [--rate MSG_PER_SEC_PER_CONN] [--window N] [--warmup SEC] [--duration SEC]\n"
+            "          [--target HOST:PORT|PATH] [--port PORT] [--cert FILE] [--key FILE] [--output FILE]\n", name);
+}
+
+static bool ParseArgs(int argc, char *argv[], Bench::Config &config) {
+    config.cert = LCC_BENCH_CERT_DIR "/server.crt";
+    config.key = LCC_BENCH_CERT_DIR "/server.key";
+    for (int n = 1; n < argc; ++n) {
+        const std::string arg = argv[n];
+        if (n + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++n];
+        if (arg == "--transport") {
+            config.transport = value;
+        } else if (arg == "--connections") {
+            config.connections = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--threads") {
+            config.threads = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--size") {
+            config.size = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--rate") {
+            config.rate = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--window") {
+            config.window = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--warmup") {
+            config.warmup = strtod(value, nullptr);
+        } else if (arg == "--duration") {
+            config.duration = strtod(value, nullptr);
+        } else if (arg == "--target") {
+            config.target = value;
+        } else if (arg == "--port") {
+            config.port = static_cast<unsigned short>(strtoul(value, nullptr, 10));
+        } else if (arg == "--cert") {
+            config.cert = value;
+        } else if (arg == "--key") {
+            config.key = value;
+        } else if (arg == "--output") {
+            config.output = value;
+        } else {
+            return false;
+        }
+    }
+    return (config.transport == "tcp" || config.transport == "tls" || config.transport == "ws" ||
+            config.transport == "wss" || config.transport == "unix") && config.connections > 0 && config.threads > 0 && config.size > 0 &&
+           config.window > 0 && config.duration > 0 && config.warmup >= 0;
+}
+
+/**
+ * 等待条件成立
+ * @return 是否在超时前成立
+ */
+template<typename Predicate>
+static bool WaitFor(Predicate predicate, unsigned long long timeout) {
+    const unsigned long long deadline = uv_hrtime() + timeout;
+    while (!predicate()) {
+        if (uv_hrtime() >= deadline) {
+            return false;
+        }
+        uv_sleep(5);
+    }
+    return true;
+}
+
+static void Report(const Bench::Config &config, const Bench::Stats &total, unsigned int connected,
+                   unsigned int failed, double connectSeconds) {
+    const double micro = 1000.0;
+    const Lcc::Utils::Histogram &latency = total.latency;
+    char buf[2048];
+    const int n = snprintf(
+        buf, sizeof(buf),
+        "{\"transport\":\"%s\",\"connections\":%u,\"threads\":%u,\"size\":%u,\"rate\":%u,\"window\":%u,"
+        "\"warmup\":%.3f,\"duration\":%.3f,"
+        "\"connect\":{\"ok\":%u,\"failed\":%u,\"seconds\":%.6f,\"per_second\":%.1f},"
+        "\"messages\":{\"sent\":%llu,\"completed\":%llu,\"errors\":%llu},"
+        "\"throughput\":{\"messages_per_second\":%.1f,\"bytes_per_second\":%.1f},"
+        "\"latency_us\":{\"min\":%.3f,\"mean\":%.3f,\"p50\":%.3f,\"p99\":%.3f,\"p999\":%.3f,\"max\":%.3f}}\n",
+        config.transport.c_str(), config.connections, config.threads, config.size, config.rate, config.window,
+        config.warmup, config.duration, connected, failed, connectSeconds,
+        connectSeconds > 0 ? connected / connectSeconds : 0.0, total.sent, total.messages, total.errors,
+        total.messages / config.duration, total.bytes / config.duration,
+        latency.Min() / micro, latency.Mean() / micro, latency.Percentile(50) / micro,
+        latency.Percentile(99) / micro, latency.Percentile(99.9) / micro, latency.Max() / micro);
+    FILE *out = config.output.empty() ? stdout : fopen(config.output.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "open %s failed\n", config.output.c_str());
+        out = stdout;
+    }
+    fwrite(buf, 1, static_cast<size_t>(n), out);
+    if (out != stdout) {
+        fclose(out);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    // 对端先关闭时写入不应终止进程
+    signal(SIGPIPE, SIG_IGN);
+    Bench::Config config;
+    if (!ParseArgs(argc, argv, config)) {
+        Usage(argv[0]);
+        return 2;
+    }
+    if (config.threads > config.connections) {
+        config.threads = config.connections;
+    }
+
+    Bench::EchoServer server(config);
+    if (config.target.empty()) {
+        if (!server.Startup() || !WaitFor([&server]() { return server.ListenState() != 0; },
+                                          kPhaseTimeout * kNanoPerSecond) || server.ListenState() < 0) {
+            fprintf(stderr, "echo server start failed\n");
+            return 1;
+        }
+    }
+
+    // 连接阶段: 连接平均分到各线程, 全部建立(或失败)后开始预热
+    std::vector<Bench::LoadGenerator *> generators;
+    for (unsigned int n = 0, first = 0; n < config.threads; ++n) {
+        const unsigned int count = config.connections / config.threads + (n < config.connections % config.threads);
+        generators.push_back(new Bench::LoadGenerator(config, first, count));
+        first += count;
+    }
+    for (auto generator: generators) {
+        generator->Startup();
+    }
+    auto countOf = [&generators](std::atomic<unsigned int> Bench::Stats::*field) {
+        unsigned int count = 0;
+        for (auto generator: generators) {
+            count += (generator->GetStats().*field).load();
+        }
+        return count;
+    };
+    WaitFor([&]() {
+        return countOf(&Bench::Stats::connected) + countOf(&Bench::Stats::failed) >= config.connections;
+    }, kPhaseTimeout * kNanoPerSecond);
+    const unsigned int connected = countOf(&Bench::Stats::connected);
+    const unsigned int failed = config.connections - connected;
+
+    // 统计阶段: 预热之后统计duration秒内计划发送的消息, 结束后留出时间接收在途回显
+    const unsigned long long start = uv_hrtime() + static_cast<unsigned long long>(config.warmup * kNanoPerSecond);
+    const unsigned long long end = start + static_cast<unsigned long long>(config.duration * kNanoPerSecond);
+    for (auto generator: generators) {
+        generator->QueueMessage(new Bench::Command{Bench::Command::Type::Start, start, end});
+    }
+    while (uv_hrtime() < end + kNanoPerSecond / 2) {
+        uv_sleep(10);
+    }
+    for (auto generator: generators) {
+        generator->QueueMessage(new Bench::Command{Bench::Command::Type::Stop, 0, 0});
+    }
+    WaitFor([&]() { return countOf(&Bench::Stats::closed) >= connected; }, kPhaseTimeout * kNanoPerSecond);
+
+    Bench::Stats total;
+    unsigned long long connectBegin = ~0ULL;
+    unsigned long long connectEnd = 0;
+    for (auto generator: generators) {
+        generator->Shutdown();
+        const Bench::Stats &stats = generator->GetStats();
+        total.sent += stats.sent;
+        total.messages += stats.messages;
+        total.bytes += stats.bytes;
+        total.errors += stats.errors;
+        total.latency.Merge(stats.latency);
+        if (stats.connectBegin && stats.connectBegin < connectBegin) {
+            connectBegin = stats.connectBegin;
+        }
+        if (stats.connectEnd > connectEnd) {
+            connectEnd = stats.connectEnd;
+        }
+        delete generator;
+    }
+    if (config.target.empty()) {
+        server.Stop();
+        uv_sleep(100);
+        server.Shutdown();
+    }
+    const double connectSeconds = connectEnd > connectBegin
+                                      ? static_cast<double>(connectEnd - connectBegin) / kNanoPerSecond
+                                      : 0;
+    Report(config, total, connected, failed, connectSeconds);
+    return failed == 0 && total.errors == 0 && total.messages > 0 ? 0 : 1;
+}
@@ -0,0 +1,38 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <string>
+#include <utils/Address.h>
+#include "legacy/HostParse.h"
+#include "MicroBench.h"
+
+static const char *kHosts[] = {
+    "tcp://127.0.0.1:8080",
+    "wss://gate.example.com:443",
+    "https://www.example.com",
+    "tcp://[::1]:8080",
+};
+
+// 解析一个地址, 参数为kHosts的下标
+static void HostParse(MicroBench::State &state) {
+    const char *host = kHosts[state.Range()];
+    Lcc::Utils::HostAddress addr{};
+    for (auto _: state) {
+        MicroBench::DoNotOptimize(Lcc::Utils::HostParse(host, addr));
+    }
+    state.SetLabel(host);
+}
+
+MICROBENCH(HostParse)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
+
+// 原正则实现解析同一地址
+static void RegexHostParse(MicroBench::State &state) {
+    const std::string host = kHosts[state.Range()];
+    Lcc::Utils::HostAddress addr{};
+    for (auto _: state) {
+        MicroBench::DoNotOptimize(Legacy::HostParse(std::string(host), addr));
+    }
+    state.SetLabel(host);
+}
+
+MICROBENCH(RegexHostParse)->Arg(0)->Arg(1)->Arg(2);
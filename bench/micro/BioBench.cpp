@@ -0,0 +1,71 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <string>
+#include <buffer/Bio.h>
+#include "MicroBench.h"
+#include "Sizes.h"
+
+static const char *BackendName(Lcc::BufferBioBackend backend) {
+    return backend == Lcc::BufferBioBackend::Mirror ? "mirror" : "heap";
+}
+
+// 稳态写入再读出一条消息
+static void BioWriteRead(MicroBench::State &state, Lcc::BufferBioBackend backend) {
+    const auto size = static_cast<unsigned int>(state.Range());
+    std::string in(size, 'x');
+    std::string out(size, 0);
+    Lcc::BufferBio bio(backend);
+    for (auto _: state) {
+        bio.Write(in.data(), size);
+        MicroBench::DoNotOptimize(bio.Read(&out[0], size));
+    }
+    state.SetBytesProcessed(state.Iterations() * size);
+    state.SetLabel(BackendName(bio.Backend()));
+}
+
+static void BioWriteReadHeap(MicroBench::State &state) {
+    BioWriteRead(state, Lcc::BufferBioBackend::Heap);
+}
+
+static void BioWriteReadMirror(MicroBench::State &state) {
+    BioWriteRead(state, Lcc::BufferBioBackend::Mirror);
+}
+
+// 按混合大小写入一批再全部读出, 模拟一次读回调内积压多条消息, 读写位置会跨越环形缓冲的末尾
+static void BioMixed(MicroBench::State &state, Lcc::BufferBioBackend backend) {
+    const auto batch = static_cast<size_t>(state.Range());
+    const std::vector<unsigned int> sizes = MicroBench::MixedSizes(4096);
+    std::string in(65536, 'x');
+    std::string out(65536, 0);
+    Lcc::BufferBio bio(backend);
+    uint64_t bytes = 0;
+    size_t index = 0;
+    for (auto _: state) {
+        for (size_t n = 0; n < batch; ++n) {
+            const unsigned int size = sizes[(index + n) & 4095];
+            bio.Write(in.data(), size);
+            bytes += size;
+        }
+        for (size_t n = 0; n < batch; ++n) {
+            MicroBench::DoNotOptimize(bio.Read(&out[0], sizes[(index + n) & 4095]));
+        }
+        index += batch;
+    }
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.Iterations() * batch);
+    state.SetLabel(BackendName(bio.Backend()));
+}
+
+static void BioMixedHeap(MicroBench::State &state) {
+    BioMixed(state, Lcc::BufferBioBackend::Heap);
+}
+
+static void BioMixedMirror(MicroBench::State &state) {
+    BioMixed(state, Lcc::BufferBioBackend::Mirror);
+}
+
+MICROBENCH(BioWriteReadHeap)->Arg(16)->Arg(128)->Arg(1024)->Arg(16384)->Arg(65536);
+MICROBENCH(BioWriteReadMirror)->Arg(16)->Arg(128)->Arg(1024)->Arg(16384)->Arg(65536);
+MICROBENCH(BioMixedHeap)->Arg(1)->Arg(8);
+MICROBENCH(BioMixedMirror)->Arg(1)->Arg(8);
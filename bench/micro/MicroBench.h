@@ -0,0 +1,491 @@
+//
+// Created by liao on 2026/10/19.
+//
+// 单头文件的微基准框架, 用法与Google Benchmark一致:
+//   static void BenchFoo(MicroBench::State &state) {
+//       ...准备(不计时)
+//       for (auto _: state) {       // _不需要使用, 也不会产生未使用变量的警告
+//           ...被测代码
+//       }
+//       state.SetBytesProcessed(state.Iterations() * size);
+//   }
+//   MICROBENCH(BenchFoo)->Arg(64)->Arg(1024);
+// 迭代次数自动增长到单次运行不短于最短时间, 报告最后一次运行的结果
+// --perf模式下用perf_event_open统计调用线程在计时区间内的cycles/instructions/cache-misses
+//
+
+#ifndef LCC_MICROBENCH_H
+#define LCC_MICROBENCH_H
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <uv.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace MicroBench {
+    /**
+     * 阻止编译器把结果当作无用代码消除
+     * @param value 结果
+     */
+    template<typename T>
+    inline void DoNotOptimize(T const &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * 阻止编译器把内存写入推迟或合并到屏障之后
+     */
+    inline void ClobberMemory() {
+        asm volatile("" : : : "memory");
+    }
+
+    /**
+     * 硬件计数器, 以组的方式同时开关, 只统计调用线程的用户态
+     */
+    class PerfCounters {
+    public:
+        enum Index {
+            Cycles,
+            Instructions,
+            CacheMisses,
+            Count,
+        };
+
+        PerfCounters() : _fds(), _values() {
+            for (auto &fd: _fds) {
+                fd = -1;
+            }
+        }
+
+        ~PerfCounters() {
+            Close();
+        }
+
+        /**
+         * 打开计数器
+         * @return 是否成功, 失败时可通过Error()获取原因
+         */
+        bool Open() {
+#if defined(__linux__)
+            static const uint64_t configs[Count] = {
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            };
+            for (int n = 0; n < Count; ++n) {
+                perf_event_attr attr{};
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = configs[n];
+                attr.disabled = n == 0;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                   PERF_FORMAT_TOTAL_TIME_RUNNING;
+                _fds[n] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, n == 0 ? -1 : _fds[0], 0));
+                if (_fds[n] < 0) {
+                    _error = std::string("perf_event_open: ") + strerror(errno);
+                    Close();
+                    return false;
+                }
+            }
+            return true;
+#else
+            _error = "perf_event_open: unsupported platform";
+            return false;
+#endif
+        }
+
+        /**
+         * 是否已打开
+         * @return 是否已打开
+         */
+        bool Opened() const {
+            return _fds[0] >= 0;
+        }
+
+        /**
+         * 清零并开始计数
+         */
+        void Start() {
+#if defined(__linux__)
+            if (Opened()) {
+                ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        /**
+         * 停止计数并读取, 计数器被复用时按实际运行时间比例还原
+         */
+        void Stop() {
+#if defined(__linux__)
+            if (!Opened()) {
+                return;
+            }
+            ioctl(_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            // nr, time_enabled, time_running, values[nr]
+            uint64_t data[3 + Count] = {0};
+            if (read(_fds[0], data, sizeof(data)) < static_cast<ssize_t>(sizeof(uint64_t) * 3)) {
+                return;
+            }
+            const double scale = data[2] ? static_cast<double>(data[1]) / data[2] : 0;
+            for (int n = 0; n < Count && n < static_cast<int>(data[0]); ++n) {
+                _values[n] = static_cast<double>(data[3 + n]) * scale;
+            }
+#endif
+        }
+
+        /**
+         * 获取最近一次计数
+         * @param index 计数器
+         * @return 计数值
+         */
+        double Value(Index index) const {
+            return _values[index];
+        }
+
+        const std::string &Error() const {
+            return _error;
+        }
+
+    private:
+        void Close() {
+            for (auto &fd: _fds) {
+                if (fd >= 0) {
+#if defined(__linux__)
+                    close(fd);
+#endif
+                    fd = -1;
+                }
+            }
+        }
+
+    private:
+        int _fds[Count];
+        double _values[Count];
+        std::string _error;
+    };
+
+    /**
+     * 单次运行的状态, 被测函数通过范围for驱动迭代, 计时只覆盖循环本身
+     */
+    class State {
+    public:
+        /**
+         * 循环变量的类型, 自定义析构使编译器把它当作有副作用的变量,
+         * for (auto _: state)不会触发-Wunused-but-set-variable
+         */
+        struct Value {
+            ~Value() {
+            }
+        };
+
+        class Iterator {
+        public:
+            Iterator(State *state, uint64_t left) : _state(state), _left(left) {
+            }
+
+            Value operator*() const {
+                return Value();
+            }
+
+            Iterator &operator++() {
+                --_left;
+                return *this;
+            }
+
+            bool operator!=(const Iterator &) {
+                if (_left) {
+                    return true;
+                }
+                _state->FinishLoop();
+                return false;
+            }
+
+        private:
+            State *_state;
+            uint64_t _left;
+        };
+
+        State(uint64_t iterations, const std::vector<long> &args, PerfCounters *perf) : _iterations(iterations),
+            _args(args), _perf(perf), _begin(0), _elapsed(0), _bytes(0), _items(0) {
+        }
+
+        Iterator begin() {
+            if (_perf) {
+                _perf->Start();
+            }
+            _begin = uv_hrtime();
+            return Iterator(this, _iterations);
+        }
+
+        Iterator end() {
+            return Iterator(this, 0);
+        }
+
+        /**
+         * 获取参数
+         * @param index 参数序号
+         * @return 参数值
+         */
+        long Range(size_t index = 0) const {
+            return index < _args.size() ? _args[index] : 0;
+        }
+
+        uint64_t Iterations() const {
+            return _iterations;
+        }
+
+        /**
+         * 设置处理的字节数, 用于计算带宽
+         * @param bytes 字节数
+         */
+        void SetBytesProcessed(uint64_t bytes) {
+            _bytes = bytes;
+        }
+
+        /**
+         * 设置处理的条目数, 默认等于迭代次数
+         * @param items 条目数
+         */
+        void SetItemsProcessed(uint64_t items) {
+            _items = items;
+        }
+
+        /**
+         * 设置结果标签, 如实际使用的后端
+         * @param label 标签
+         */
+        void SetLabel(const std::string &label) {
+            _label = label;
+        }
+
+        uint64_t Elapsed() const {
+            return _elapsed;
+        }
+
+        uint64_t Bytes() const {
+            return _bytes;
+        }
+
+        uint64_t Items() const {
+            return _items ? _items : _iterations;
+        }
+
+        const std::string &Label() const {
+            return _label;
+        }
+
+    private:
+        void FinishLoop() {
+            _elapsed = uv_hrtime() - _begin;
+            if (_perf) {
+                _perf->Stop();
+            }
+        }
+
+    private:
+        uint64_t _iterations;
+        const std::vector<long> &_args;
+        PerfCounters *_perf;
+        uint64_t _begin;
+        uint64_t _elapsed;
+        uint64_t _bytes;
+        uint64_t _items;
+        std::string _label;
+    };
+
+    typedef void (*Function)(State &);
+
+    /**
+     * 已注册的基准, 每组参数运行一次
+     */
+    class Benchmark {
+    public:
+        Benchmark(const char *name, Function function) : _name(name), _function(function) {
+        }
+
+        Benchmark *Arg(long arg) {
+            _args.push_back(std::vector<long>{arg});
+            return this;
+        }
+
+        Benchmark *Args(const std::vector<long> &args) {
+            _args.push_back(args);
+            return this;
+        }
+
+        const std::string &Name() const {
+            return _name;
+        }
+
+        Function GetFunction() const {
+            return _function;
+        }
+
+        const std::vector<std::vector<long> > &GetArgs() const {
+            return _args;
+        }
+
+    private:
+        std::string _name;
+        Function _function;
+        std::vector<std::vector<long> > _args;
+    };
+
+    inline std::vector<Benchmark *> &Benchmarks() {
+        static std::vector<Benchmark *> benchmarks;
+        return benchmarks;
+    }
+
+    inline Benchmark *Register(const char *name, Function function) {
+        Benchmarks().push_back(new Benchmark(name, function));
+        return Benchmarks().back();
+    }
+
+    /**
+     * 运行参数
+     */
+    struct Options {
+        // 名称包含该子串的基准才运行
+        std::string filter;
+        // 单次运行的最短时间(秒)
+        double minTime = 0.5;
+        // 是否统计硬件计数器
+        bool perf = false;
+        // 是否输出JSON
+        bool json = false;
+    };
+
+    /**
+     * 单个结果
+     */
+    struct Result {
+        std::string name;
+        std::string label;
+        uint64_t iterations;
+        double nsPerOp;
+        double itemsPerSecond;
+        double bytesPerSecond;
+        bool counters;
+        double cyclesPerOp;
+        double instructionsPerOp;
+        double cacheMissesPerOp;
+    };
+
+    inline void PrintResult(const Result &result, bool json, bool first) {
+        if (json) {
+            printf("%s\n  {\"name\":\"%s\",\"label\":\"%s\",\"iterations\":%llu,\"ns_per_op\":%.3f,"
+                   "\"items_per_second\":%.1f,\"bytes_per_second\":%.1f",
+                   first ? "" : ",", result.name.c_str(), result.label.c_str(),
+                   static_cast<unsigned long long>(result.iterations), result.nsPerOp, result.itemsPerSecond,
+                   result.bytesPerSecond);
+            if (result.counters) {
+                printf(",\"cycles_per_op\":%.2f,\"instructions_per_op\":%.2f,\"cache_misses_per_op\":%.4f",
+                       result.cyclesPerOp, result.instructionsPerOp, result.cacheMissesPerOp);
+            }
+            printf("}");
+            return;
+        }
+        printf("%-40s %12llu %12.2f ns %12.0f/s", result.name.c_str(),
+               static_cast<unsigned long long>(result.iterations), result.nsPerOp, result.itemsPerSecond);
+        if (result.bytesPerSecond > 0) {
+            printf(" %10.1f MB/s", result.bytesPerSecond / 1e6);
+        }
+        if (result.counters) {
+            printf(" %10.1f cyc %10.1f ins %5.2f ipc %8.3f miss", result.cyclesPerOp, result.instructionsPerOp,
+                   result.cyclesPerOp > 0 ? result.instructionsPerOp / result.cyclesPerOp : 0,
+                   result.cacheMissesPerOp);
+        }
+        if (!result.label.empty()) {
+            printf(" [%s]", result.label.c_str());
+        }
+        printf("\n");
+    }
+
+    /**
+     * 运行所有匹配的基准
+     * @param options 运行参数
+     * @return 运行的基准数量
+     */
+    inline int Run(const Options &options) {
+#if !defined(__OPTIMIZE__)
+        fprintf(stderr, "warning: built without optimization, use -DCMAKE_BUILD_TYPE=Release\n");
+#endif
+        PerfCounters perf;
+        if (options.perf && !perf.Open()) {
+            fprintf(stderr, "hardware counters unavailable (%s), timing only\n", perf.Error().c_str());
+        }
+        const auto minTime = static_cast<uint64_t>(options.minTime * 1e9);
+        int count = 0;
+        if (options.json) {
+            printf("[");
+        }
+        for (auto benchmark: Benchmarks()) {
+            std::vector<std::vector<long> > argsList = benchmark->GetArgs();
+            if (argsList.empty()) {
+                argsList.emplace_back();
+            }
+            for (const auto &args: argsList) {
+                std::string name = benchmark->Name();
+                for (auto arg: args) {
+                    name.append("/").append(std::to_string(arg));
+                }
+                if (name.find(options.filter) == std::string::npos) {
+                    continue;
+                }
+                // 迭代次数按上次耗时预估, 每轮最多放大10倍
+                uint64_t iterations = 1;
+                while (true) {
+                    State state(iterations, args, perf.Opened() ? &perf : nullptr);
+                    benchmark->GetFunction()(state);
+                    const uint64_t elapsed = state.Elapsed() ? state.Elapsed() : 1;
+                    if (elapsed >= minTime || iterations >= 1000000000ULL) {
+                        Result result{};
+                        result.name = name;
+                        result.label = state.Label();
+                        result.iterations = iterations;
+                        result.nsPerOp = static_cast<double>(elapsed) / iterations;
+                        result.itemsPerSecond = state.Items() * 1e9 / elapsed;
+                        result.bytesPerSecond = state.Bytes() * 1e9 / elapsed;
+                        result.counters = perf.Opened();
+                        if (result.counters) {
+                            result.cyclesPerOp = perf.Value(PerfCounters::Cycles) / iterations;
+                            result.instructionsPerOp = perf.Value(PerfCounters::Instructions) / iterations;
+                            result.cacheMissesPerOp = perf.Value(PerfCounters::CacheMisses) / iterations;
+                        }
+                        PrintResult(result, options.json, count == 0);
+                        fflush(stdout);
+                        ++count;
+                        break;
+                    }
+                    const double predict = static_cast<double>(iterations) * minTime * 1.4 / elapsed;
+                    const double limit = static_cast<double>(iterations) * 10;
+                    iterations = static_cast<uint64_t>(predict < limit ? predict : limit) + 1;
+                }
+            }
+        }
+        if (options.json) {
+            printf("\n]\n");
+        }
+        return count;
+    }
+}
+
+#define MICROBENCH_CONCAT_(a, b) a##b
+#define MICROBENCH_CONCAT(a, b) MICROBENCH_CONCAT_(a, b)
+#define MICROBENCH(function) \
+    static MicroBench::Benchmark *MICROBENCH_CONCAT(_microbench_, __LINE__) = \
+        MicroBench::Register(#function, function)
+
+#endif //LCC_MICROBENCH_H
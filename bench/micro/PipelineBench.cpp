@@ -0,0 +1,269 @@
+//
+// Created by liao on 2026/10/19.
+//
+// 同一条协议栈的三种实现对照: 流水线改造前的插件(legacy), 改造后作为层适配器的插件(plugins), 编译期组合的Pipeline
+// 两个真实的TcpStream在内存中对接, 每次迭代客户端写入batch条消息, 全部密文/帧交给服务端一次读取,
+// 计时覆盖客户端的写入封装与服务端的解析回调, 握手不计时
+//   参数: 实现(0=legacy, 1=plugins, 2=pipeline), 消息大小, 每次读取的消息数
+//
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <network/TcpStream.h>
+#include <network/pipeline/Pipeline.h>
+#include <network/pipeline/FramingLayer.h>
+#include <network/pipeline/TlsLayer.h>
+#include <network/pipeline/WebSocketLayer.h>
+#include <network/plugin/FramePlugin.h>
+#include <network/plugin/MbedTLSPlugin.h>
+#include <network/plugin/WebSocketPlugin.h>
+#include "legacy/Plugins.h"
+#include "MicroBench.h"
+
+static const char *kCert = LCC_BENCH_CERT_DIR "/server.crt";
+static const char *kKey = LCC_BENCH_CERT_DIR "/server.key";
+static const char *kHostname = "127.0.0.1";
+static const unsigned int kMaxFrame = 0x10000;
+static const size_t kReadBuffer = 0x10000;
+
+enum class Stack {
+    Frame,
+    WebSocket,
+    Tls,
+};
+
+static const char *kImplNames[] = {"legacy", "plugins", "pipeline"};
+
+/**
+ * 不经过套接字的流, 最底层的写出数据留在wire中, 由Flush交给对端读取
+ */
+class PairStream : public Lcc::StreamImplement, public Lcc::TcpStream {
+public:
+    explicit PairStream(uv_loop_t *loop) : TcpStream(this), opened(false), closed(false), frames(0), bad(0),
+                                           _loop(loop), _handle(nullptr), _bottom(Lcc::ProtocolLevel::Stream) {
+    }
+
+    void Start() {
+        auto plugin = GetLevelPlugin(Lcc::ProtocolLevel::Stream);
+        _bottom = plugin ? plugin->GetLevel() : Lcc::ProtocolLevel::Stream;
+        Init();
+        IProtocolOpen(Lcc::ProtocolLevel::Stream);
+    }
+
+    void Send(const char *buf, unsigned int size) {
+        IProtocolWrite(Lcc::ProtocolLevel::User, buf, size);
+    }
+
+    void Feed(const char *buf, unsigned int size) {
+        IProtocolRead(Lcc::ProtocolLevel::Stream, buf, size);
+    }
+
+    void Close() {
+        uv_close(reinterpret_cast<uv_handle_t *>(_handle), TcpStream::UvCloseCallback);
+        uv_run(_loop, UV_RUN_DEFAULT);
+    }
+
+public:
+    std::string wire;
+    // 交给对端读取中的数据, 与wire交换以复用容量
+    std::string flight;
+    bool opened;
+    bool closed;
+    unsigned long long frames;
+    unsigned long long bad;
+
+protected:
+    void IProtocolWrite(Lcc::ProtocolLevel streamLevel, const char *buf, unsigned int size) override {
+        if (streamLevel == _bottom) {
+            wire.append(buf, size);
+        } else {
+            TcpStream::IProtocolWrite(streamLevel, buf, size);
+        }
+    }
+
+    bool IStreamInit(Lcc::StreamHandle &handle) override {
+        handle.tcpSession = 1;
+        _handle = &handle.tcpHandle;
+        return handle.Init(_loop) == 0;
+    }
+
+    void IStreamOpen(unsigned int session) override {
+        opened = true;
+    }
+
+    void IStreamReceive(unsigned int session, const char *buf, unsigned int size) override {
+        const auto expect = static_cast<char>(frames);
+        if (size == 0 || buf[0] != expect || buf[size - 1] != expect) {
+            ++bad;
+        }
+        ++frames;
+    }
+
+    void IStreamBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IStreamAfterClose(unsigned int session) override {
+        closed = true;
+    }
+
+private:
+    uv_loop_t *_loop;
+    uv_tcp_t *_handle;
+    Lcc::ProtocolLevel _bottom;
+};
+
+/**
+ * 把from写出的数据按读缓冲区大小交给to, WebSocket掩码在读缓冲区内原地解码, 先复制
+ */
+static void Flush(PairStream &from, PairStream &to) {
+    static char buffer[kReadBuffer];
+    from.flight.swap(from.wire);
+    for (size_t offset = 0; offset < from.flight.size(); offset += kReadBuffer) {
+        const size_t size = std::min(kReadBuffer, from.flight.size() - offset);
+        memcpy(buffer, from.flight.data() + offset, size);
+        to.Feed(buffer, static_cast<unsigned int>(size));
+    }
+    from.flight.clear();
+}
+
+/**
+ * 一端的插件构造器, 析构时释放
+ */
+class Creators {
+public:
+    ~Creators() {
+        for (auto creator: _creators) {
+            creator->ICreatorRelease();
+        }
+        _tls.Release();
+    }
+
+    void Build(Stack stack, long impl, bool server) {
+        const char *hostname = server ? "" : kHostname;
+        if (impl == 2) {
+            const Lcc::FramingLayer::Config frame{Lcc::FrameHeader::Varint, kMaxFrame};
+            if (stack == Stack::Frame) {
+                auto creator = new Lcc::PipelineCreator<Lcc::FramingLayer>;
+                creator->Initialize(frame);
+                _creators.push_back(creator);
+            } else if (stack == Stack::WebSocket) {
+                auto creator = new Lcc::PipelineCreator<Lcc::WebSocketLayer, Lcc::FramingLayer>;
+                creator->Initialize({Lcc::WebSocketOpcode::Binary, hostname}, frame);
+                _creators.push_back(creator);
+            } else {
+                if (server) {
+                    _tls.InitializeForServer(kCert, kKey, "");
+                }
+                auto creator = new Lcc::PipelineCreator<Lcc::TlsLayer, Lcc::FramingLayer>;
+                creator->Initialize({server ? &_tls : nullptr, hostname, server ? "" : kCert}, frame);
+                _creators.push_back(creator);
+            }
+            return;
+        }
+        if (impl == 0) {
+            Add<Legacy::FramePluginCreator, Legacy::WebSocketPluginCreator, Legacy::MbedTLSPluginCreator>(stack,
+                server);
+        } else {
+            Add<Lcc::FramePluginCreator, Lcc::WebSocketPluginCreator, Lcc::MbedTLSPluginCreator>(stack, server);
+        }
+    }
+
+    void Enable(PairStream &stream) {
+        for (auto creator: _creators) {
+            stream.EnableProtocolPlugin(creator->ICreatorAlloc(&stream));
+        }
+    }
+
+private:
+    template<typename Frame, typename WebSocket, typename Tls>
+    void Add(Stack stack, bool server) {
+        auto frame = new Frame;
+        frame->Initialize(Lcc::FrameHeader::Varint, kMaxFrame);
+        _creators.push_back(frame);
+        if (stack == Stack::WebSocket) {
+            auto ws = new WebSocket;
+            if (server) {
+                ws->InitializeServerMode(Lcc::WebSocketOpcode::Binary);
+            } else {
+                ws->InitializeClientMode(Lcc::WebSocketOpcode::Binary, kHostname);
+            }
+            _creators.push_back(ws);
+        } else if (stack == Stack::Tls) {
+            auto tls = new Tls;
+            if (server) {
+                tls->InitializeServerMode(kCert, kKey, "");
+            } else {
+                tls->InitializeClientMode(kHostname, kCert);
+            }
+            _creators.push_back(tls);
+        }
+    }
+
+private:
+    std::vector<Lcc::ProtocolPluginCreator *> _creators;
+    Lcc::Protocol::MbedTLS _tls;
+};
+
+static void Transfer(MicroBench::State &state, Stack stack) {
+    const long impl = state.Range(0);
+    const auto size = static_cast<unsigned int>(state.Range(1));
+    const long batch = state.Range(2);
+    uv_loop_t *loop = uv_default_loop();
+    Creators serverCreators;
+    Creators clientCreators;
+    serverCreators.Build(stack, impl, true);
+    clientCreators.Build(stack, impl, false);
+    PairStream server(loop);
+    PairStream client(loop);
+    serverCreators.Enable(server);
+    clientCreators.Enable(client);
+    server.Start();
+    client.Start();
+    for (int n = 0; n < 16 && !(server.opened && client.opened); ++n) {
+        Flush(client, server);
+        Flush(server, client);
+    }
+    // TLS1.3的会话票据在握手后发出
+    Flush(server, client);
+
+    std::vector<std::string> payloads(256);
+    for (size_t n = 0; n < payloads.size(); ++n) {
+        payloads[n].assign(size, static_cast<char>(n));
+    }
+    unsigned long long sent = 0;
+    for (auto _: state) {
+        for (long n = 0; n < batch; ++n) {
+            const std::string &payload = payloads[sent++ & 0xFF];
+            client.Send(payload.data(), size);
+        }
+        Flush(client, server);
+    }
+    state.SetItemsProcessed(sent);
+    state.SetBytesProcessed(sent * size);
+    const bool ok = server.opened && client.opened && server.frames == sent && server.bad == 0;
+    state.SetLabel(ok ? kImplNames[impl] : std::string(kImplNames[impl]) + " FAILED");
+    server.Close();
+    client.Close();
+}
+
+static void PipelineFrame(MicroBench::State &state) {
+    Transfer(state, Stack::Frame);
+}
+
+static void PipelineWebSocket(MicroBench::State &state) {
+    Transfer(state, Stack::WebSocket);
+}
+
+static void PipelineTls(MicroBench::State &state) {
+    Transfer(state, Stack::Tls);
+}
+
+MICROBENCH(PipelineFrame)->Args({0, 16, 1})->Args({1, 16, 1})->Args({2, 16, 1})
+                         ->Args({0, 16, 32})->Args({1, 16, 32})->Args({2, 16, 32})
+                         ->Args({0, 256, 32})->Args({1, 256, 32})->Args({2, 256, 32});
+MICROBENCH(PipelineWebSocket)->Args({0, 16, 1})->Args({1, 16, 1})->Args({2, 16, 1})
+                             ->Args({0, 16, 32})->Args({1, 16, 32})->Args({2, 16, 32})
+                             ->Args({0, 256, 32})->Args({1, 256, 32})->Args({2, 256, 32});
+MICROBENCH(PipelineTls)->Args({0, 16, 1})->Args({1, 16, 1})->Args({2, 16, 1})
+                       ->Args({0, 256, 32})->Args({1, 256, 32})->Args({2, 256, 32});
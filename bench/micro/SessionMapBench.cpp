@@ -0,0 +1,71 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "MicroBench.h"
+
+/**
+ * 与TcpServer的会话表同构: 会话id自增分配, 连接断开后留下空洞
+ */
+struct SessionObject {
+    bool valid;
+    void *stream;
+};
+
+typedef std::unordered_map<unsigned int, SessionObject *> SessionMap;
+
+static const size_t kLookupMask = 4095;
+
+/**
+ * 分配2倍会话再随机关闭一半, 返回存活的会话id
+ */
+static std::vector<unsigned int> Populate(SessionMap &sessions, SessionObject *object, size_t count) {
+    std::mt19937 engine(20261019);
+    std::vector<unsigned int> ids;
+    for (unsigned int id = 1; id <= count * 2; ++id) {
+        sessions[id] = object;
+        ids.push_back(id);
+    }
+    std::shuffle(ids.begin(), ids.end(), engine);
+    for (size_t n = count; n < ids.size(); ++n) {
+        sessions.erase(ids[n]);
+    }
+    ids.resize(count);
+    return ids;
+}
+
+// 按随机顺序查找存活会话, 对应SessionWrite等按id的操作
+static void SessionMapLookup(MicroBench::State &state) {
+    SessionMap sessions;
+    SessionObject object{true, nullptr};
+    const std::vector<unsigned int> live = Populate(sessions, &object, static_cast<size_t>(state.Range()));
+    std::vector<unsigned int> order(kLookupMask + 1);
+    for (size_t n = 0; n < order.size(); ++n) {
+        order[n] = live[(n * 2654435761U) % live.size()];
+    }
+    size_t index = 0;
+    for (auto _: state) {
+        MicroBench::DoNotOptimize(sessions.find(order[index++ & kLookupMask])->second);
+    }
+}
+
+// 关闭最早的会话并以新id接入, 会话总数不变
+static void SessionMapChurn(MicroBench::State &state) {
+    SessionMap sessions;
+    SessionObject object{true, nullptr};
+    std::vector<unsigned int> live = Populate(sessions, &object, static_cast<size_t>(state.Range()));
+    unsigned int next = static_cast<unsigned int>(live.size() * 2);
+    size_t index = 0;
+    for (auto _: state) {
+        unsigned int &slot = live[index++ % live.size()];
+        sessions.erase(slot);
+        slot = ++next;
+        sessions[slot] = &object;
+    }
+}
+
+MICROBENCH(SessionMapLookup)->Arg(100)->Arg(10000)->Arg(100000);
+MICROBENCH(SessionMapChurn)->Arg(100)->Arg(10000)->Arg(100000);
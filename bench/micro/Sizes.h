@@ -0,0 +1,38 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_MICROBENCH_SIZES_H
+#define LCC_MICROBENCH_SIZES_H
+
+#include <random>
+#include <vector>
+
+namespace MicroBench {
+    /**
+     * 生成混合消息大小序列, 分布参照游戏业务流量: 60%小包(16~128), 30%中包(128~1K), 9%大包(1K~8K), 1%超大包(8K~64K)
+     * 种子固定, 各次运行的序列一致
+     * @param count 序列长度
+     * @return 大小序列
+     */
+    inline std::vector<unsigned int> MixedSizes(size_t count) {
+        std::mt19937 engine(20261019);
+        std::uniform_int_distribution<int> bucket(0, 99);
+        std::vector<unsigned int> sizes(count);
+        for (auto &size: sizes) {
+            const int n = bucket(engine);
+            unsigned int low = 16, high = 128;
+            if (n >= 99) {
+                low = 8192, high = 65536;
+            } else if (n >= 90) {
+                low = 1024, high = 8192;
+            } else if (n >= 60) {
+                low = 128, high = 1024;
+            }
+            size = std::uniform_int_distribution<unsigned int>(low, high)(engine);
+        }
+        return sizes;
+    }
+}
+
+#endif //LCC_MICROBENCH_SIZES_H
@@ -0,0 +1,69 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <atomic>
+#include <thread/Thread.h>
+#include "MicroBench.h"
+
+/**
+ * 收到消息后记录序号, 调用方自旋等待序号即完成一次往返
+ */
+class AckThread final : public Lcc::Thread {
+public:
+    AckThread() : acked(0) {
+    }
+
+protected:
+    bool IInit() override {
+        return true;
+    }
+
+    void IMessage(void *message) override {
+        acked.store(reinterpret_cast<uintptr_t>(message), std::memory_order_release);
+    }
+
+    void IShutdown() override {
+    }
+
+public:
+    std::atomic<uintptr_t> acked;
+};
+
+static void WaitAck(AckThread &thread, uintptr_t seq) {
+    while (thread.acked.load(std::memory_order_acquire) != seq) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+// 压入一条消息并等待线程处理, 包含队列、uv_async唤醒与循环派发的全部开销
+static void QueueMessageRoundTrip(MicroBench::State &state) {
+    AckThread thread;
+    thread.Startup();
+    uintptr_t seq = 0;
+    for (auto _: state) {
+        thread.QueueMessage(reinterpret_cast<void *>(++seq));
+        WaitAck(thread, seq);
+    }
+    thread.Shutdown();
+}
+
+// 连续压入一批消息后等待最后一条被处理, 唤醒被合并, 衡量队列本身的吞吐
+static void QueueMessageBurst(MicroBench::State &state) {
+    const auto batch = static_cast<uintptr_t>(state.Range());
+    AckThread thread;
+    thread.Startup();
+    uintptr_t seq = 0;
+    for (auto _: state) {
+        for (uintptr_t n = 0; n < batch; ++n) {
+            thread.QueueMessage(reinterpret_cast<void *>(++seq));
+        }
+        WaitAck(thread, seq);
+    }
+    thread.Shutdown();
+    state.SetItemsProcessed(state.Iterations() * batch);
+}
+
+MICROBENCH(QueueMessageRoundTrip);
+MICROBENCH(QueueMessageBurst)->Arg(16)->Arg(256);
@@ -0,0 +1,111 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <string>
+#include <network/protocol/WebSocket.h>
+#include "MicroBench.h"
+#include "Sizes.h"
+
+/**
+ * 只收集编码结果与统计解码回调的协议实现
+ */
+class Sink final : public Lcc::WebSocketImplement {
+public:
+    explicit Sink(bool mask) : frames(0), mask(mask) {
+    }
+
+    void IWebSocketInit(Lcc::WebSocketMode &mode) override {
+        mode.mark = mask;
+        mode.opcode = Lcc::WebSocketOpcode::Binary;
+    }
+
+    void IWebSocketReceive(Lcc::WebSocketFrameHeader &header, const char *buf, unsigned int size) override {
+        ++frames;
+        MicroBench::DoNotOptimize(buf);
+    }
+
+    void IWebSocketWrite(const char *buf, unsigned int size) override {
+        if (capture) {
+            out.append(buf, size);
+        }
+        MicroBench::DoNotOptimize(buf);
+    }
+
+public:
+    unsigned long long frames;
+    bool mask;
+    bool capture = false;
+    std::string out;
+};
+
+/**
+ * 用客户端(带掩码)或服务端模式编码一段帧流
+ */
+static std::string Encode(bool mask, const std::vector<unsigned int> &sizes) {
+    Sink sink(mask);
+    sink.capture = true;
+    Lcc::WebSocketProtocol protocol(&sink);
+    protocol.Initialize();
+    std::string payload(65536, 'x');
+    for (auto size: sizes) {
+        protocol.Write(payload.data(), size);
+    }
+    return sink.out;
+}
+
+// 编码一条消息, 掩码为客户端方向
+static void WebSocketWrite(MicroBench::State &state, bool mask) {
+    const auto size = static_cast<unsigned int>(state.Range());
+    std::string payload(size, 'x');
+    Sink sink(mask);
+    Lcc::WebSocketProtocol protocol(&sink);
+    protocol.Initialize();
+    for (auto _: state) {
+        protocol.Write(payload.data(), size);
+    }
+    state.SetBytesProcessed(state.Iterations() * size);
+}
+
+static void WebSocketWriteServer(MicroBench::State &state) {
+    WebSocketWrite(state, false);
+}
+
+static void WebSocketWriteClient(MicroBench::State &state) {
+    WebSocketWrite(state, true);
+}
+
+// 解码一段帧流, 掩码在原缓冲上异或还原, 重复解码同一缓冲只改变负载内容, 不影响帧结构
+static void WebSocketRead(MicroBench::State &state, bool mask, const std::vector<unsigned int> &sizes) {
+    std::string stream = Encode(mask, sizes);
+    uint64_t bytes = 0;
+    for (auto size: sizes) {
+        bytes += size;
+    }
+    Sink sink(!mask);
+    Lcc::WebSocketProtocol protocol(&sink);
+    protocol.Initialize();
+    for (auto _: state) {
+        MicroBench::DoNotOptimize(protocol.Read(&stream[0], static_cast<unsigned int>(stream.size())));
+    }
+    state.SetBytesProcessed(state.Iterations() * bytes);
+    state.SetItemsProcessed(sink.frames);
+}
+
+static void WebSocketReadServer(MicroBench::State &state) {
+    WebSocketRead(state, true, std::vector<unsigned int>{static_cast<unsigned int>(state.Range())});
+}
+
+static void WebSocketReadClient(MicroBench::State &state) {
+    WebSocketRead(state, false, std::vector<unsigned int>{static_cast<unsigned int>(state.Range())});
+}
+
+// 一次读回调中包含多条混合大小的消息
+static void WebSocketReadMixed(MicroBench::State &state) {
+    WebSocketRead(state, true, MicroBench::MixedSizes(static_cast<size_t>(state.Range())));
+}
+
+MICROBENCH(WebSocketWriteServer)->Arg(16)->Arg(128)->Arg(1024)->Arg(16384)->Arg(65536);
+MICROBENCH(WebSocketWriteClient)->Arg(16)->Arg(128)->Arg(1024)->Arg(16384)->Arg(65536);
+MICROBENCH(WebSocketReadServer)->Arg(16)->Arg(128)->Arg(1024)->Arg(16384)->Arg(65536);
+MICROBENCH(WebSocketReadClient)->Arg(16)->Arg(128)->Arg(1024)->Arg(16384)->Arg(65536);
+MICROBENCH(WebSocketReadMixed)->Arg(8)->Arg(64);
@@ -0,0 +1,62 @@
+//
+// Created by liao on 2026/10/19.
+//
+// 手写解析器之前的正则版HostParse, 供tests/HostParse差分对照与AddressBench对比耗时, 不支持IPv6与unix/shm/udp
+//
+
+#ifndef LCC_MICROBENCH_LEGACY_HOSTPARSE_H
+#define LCC_MICROBENCH_LEGACY_HOSTPARSE_H
+
+#include <cstring>
+#include <regex>
+#include <string>
+#include <utils/Address.h>
+#include <utils/Strings.h>
+
+namespace Legacy {
+    inline bool HostParse(std::string &&host, Lcc::Utils::HostAddress &addr) {
+        using Lcc::Utils::HostProtocol;
+        bool nonePort = false;
+        bool chkValid = false;
+        std::smatch sm;
+        std::regex regex_ip("(http|https|ws|wss|tcp)://([0-9]{1,3}.[0-9]{1,3}.[0-9]{1,3}.[0-9]{1,3}):([0-9]{2,5})");
+        if (std::regex_match(host, sm, regex_ip)) {
+            chkValid = true;
+        } else {
+            std::regex regex_host("(http|https|ws|wss|tcp)://([0-9a-zA-z\\-_.]+):([0-9]{2,5})");
+            if (std::regex_match(host, sm, regex_host)) {
+                chkValid = true;
+            } else if (host.find("http") != std::string::npos) {
+                std::regex regex_host2("(http|https|ws|wss|tcp)://([0-9a-zA-z\\-_.]+)");
+                if (std::regex_match(host, sm, regex_host2)) {
+                    chkValid = true;
+                    nonePort = true;
+                }
+            }
+        }
+        if (chkValid) {
+            addr.port = 0;
+            memset(&addr.host, 0, sizeof(addr.host));
+            std::string protocol = sm[1].str();
+            if (protocol.find("ws") != std::string::npos) {
+                addr.protocol = HostProtocol::Websocket;
+                addr.ssl = protocol.find("wss") != std::string::npos;
+            } else if (protocol.find("http") != std::string::npos) {
+                addr.protocol = HostProtocol::Http;
+                addr.ssl = protocol.find("https") != std::string::npos;
+            } else {
+                addr.protocol = HostProtocol::Tcp;
+                addr.ssl = false;
+            }
+            Lcc::Utils::StringCopy(addr.host, sizeof(addr.host), sm[2].str().c_str(), sm[2].str().size());
+            if (!nonePort) {
+                chkValid = Lcc::Utils::StringToNumber(sm[3].str(), &addr.port);
+            } else {
+                addr.port = addr.ssl ? 443 : 80;
+            }
+        }
+        return chkValid;
+    }
+}
+
+#endif //LCC_MICROBENCH_LEGACY_HOSTPARSE_H
@@ -0,0 +1,585 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <algorithm>
+#include "legacy/Plugins.h"
+
+namespace Legacy {
+    // 超过该容量的残帧缓存用完即释放, 避免偶发大帧长期占用内存
+    static const size_t kKeepPendingCapacity = 0x10000;
+
+    FramePlugin::FramePlugin(FrameHeader header, unsigned int maxSize, ProtocolImplement *impl) : ProtocolPlugin(
+            ProtocolLevel::Application, impl),
+        _error(0),
+        _closed(false),
+        _header(header),
+        // 2字节长度头最多表示0xFFFF
+        _maxSize(header == FrameHeader::Fixed16 ? std::min(maxSize, 0xFFFFU) : maxSize),
+        _need(0),
+        _head(0),
+        _direct(0),
+        _buffered(0) {
+    }
+
+    FramePlugin::~FramePlugin() = default;
+
+    unsigned int FramePlugin::EncodeHead(FrameHeader header, unsigned int size, char *out) {
+        switch (header) {
+            case FrameHeader::Fixed16:
+                out[0] = static_cast<char>(size >> 8);
+                out[1] = static_cast<char>(size);
+                return 2;
+            case FrameHeader::Fixed32:
+                out[0] = static_cast<char>(size >> 24);
+                out[1] = static_cast<char>(size >> 16);
+                out[2] = static_cast<char>(size >> 8);
+                out[3] = static_cast<char>(size);
+                return 4;
+            default: {
+                unsigned int n = 0;
+                while (size >= 0x80) {
+                    out[n++] = static_cast<char>((size & 0x7F) | 0x80);
+                    size >>= 7;
+                }
+                out[n++] = static_cast<char>(size);
+                return n;
+            }
+        }
+    }
+
+    int FramePlugin::DecodeHead(FrameHeader header, const char *buf, unsigned int size, unsigned int &body) {
+        const auto p = reinterpret_cast<const unsigned char *>(buf);
+        switch (header) {
+            case FrameHeader::Fixed16:
+                if (size < 2) {
+                    return 0;
+                }
+                body = static_cast<unsigned int>(p[0]) << 8 | p[1];
+                return 2;
+            case FrameHeader::Fixed32:
+                if (size < 4) {
+                    return 0;
+                }
+                body = static_cast<unsigned int>(p[0]) << 24 | static_cast<unsigned int>(p[1]) << 16 |
+                       static_cast<unsigned int>(p[2]) << 8 | p[3];
+                return 4;
+            default: {
+                unsigned int value = 0;
+                for (unsigned int n = 0; n < kMaxHeadSize; ++n) {
+                    if (n >= size) {
+                        return 0;
+                    }
+                    // 第5字节只能携带32位中剩余的4位
+                    if (n == kMaxHeadSize - 1 && p[n] > 0x0F) {
+                        return -1;
+                    }
+                    value |= static_cast<unsigned int>(p[n] & 0x7F) << (7 * n);
+                    if (!(p[n] & 0x80)) {
+                        body = value;
+                        return static_cast<int>(n + 1);
+                    }
+                }
+                return -1;
+            }
+        }
+    }
+
+    unsigned long long FramePlugin::DirectFrames() const {
+        return _direct;
+    }
+
+    unsigned long long FramePlugin::BufferedFrames() const {
+        return _buffered;
+    }
+
+    void FramePlugin::ImplementClose(int err, const char *desc) {
+        _error = err;
+        _errorstr = desc;
+        _closed = true;
+        _impl->IProtocolClose(ProtocolLevel::Application);
+    }
+
+    int FramePlugin::IProtocolLastError() {
+        return _error;
+    }
+
+    const char *FramePlugin::IProtocolLastErrDesc() {
+        return _errorstr.c_str();
+    }
+
+    bool FramePlugin::IProtocolPluginOpen() {
+        _impl->IProtocolOpen(ProtocolLevel::Application);
+        return true;
+    }
+
+    bool FramePlugin::IProtocolPluginRead(const char *buf, unsigned int size) {
+        while (size > 0 && !_closed) {
+            if (_pending.empty()) {
+                unsigned int body = 0;
+                const int head = DecodeHead(_header, buf, size, body);
+                if (head < 0 || body > _maxSize) {
+                    ImplementClose(UV_E2BIG, head < 0 ? "frame header malformed" : "frame too large");
+                    return false;
+                }
+                if (head > 0 && size - head >= body) {
+                    // 完整帧直接回调, 不经过缓存
+                    ++_direct;
+                    _impl->IProtocolRead(ProtocolLevel::Application, buf + head, body);
+                    buf += head + body;
+                    size -= head + body;
+                    continue;
+                }
+                _head = static_cast<unsigned int>(head);
+                _need = head > 0 ? _head + body : 0;
+                if (_need > 0) {
+                    _pending.reserve(_need);
+                }
+                _pending.assign(buf, size);
+                return true;
+            }
+            if (_need == 0) {
+                // 长度头跨读取时逐字节补齐, 最多kMaxHeadSize字节
+                _pending.push_back(*buf++);
+                --size;
+                unsigned int body = 0;
+                const int head = DecodeHead(_header, _pending.data(), static_cast<unsigned int>(_pending.size()),
+                                            body);
+                if (head < 0 || body > _maxSize) {
+                    ImplementClose(UV_E2BIG, head < 0 ? "frame header malformed" : "frame too large");
+                    return false;
+                }
+                if (head == 0) {
+                    continue;
+                }
+                _head = static_cast<unsigned int>(head);
+                _need = _head + body;
+                _pending.reserve(_need);
+            } else {
+                const unsigned int take = std::min(size, _need - static_cast<unsigned int>(_pending.size()));
+                _pending.append(buf, take);
+                buf += take;
+                size -= take;
+            }
+            if (_pending.size() == _need) {
+                ++_buffered;
+                // 回调期间可能再次进入读取, 先取出缓存
+                std::string frame;
+                frame.swap(_pending);
+                _need = 0;
+                _impl->IProtocolRead(ProtocolLevel::Application, frame.data() + _head,
+                                     static_cast<unsigned int>(frame.size()) - _head);
+                if (_pending.empty() && frame.capacity() <= kKeepPendingCapacity) {
+                    // 复用缓存容量
+                    frame.clear();
+                    _pending.swap(frame);
+                }
+            }
+        }
+        return true;
+    }
+
+    void FramePlugin::IProtocolPluginWrite(const char *buf, unsigned int size) {
+        if (size > _maxSize) {
+            ImplementClose(UV_E2BIG, "frame too large");
+            return;
+        }
+        // 长度头与数据合并为一次写入, 输出缓存容量复用
+        char head[kMaxHeadSize];
+        const unsigned int headSize = EncodeHead(_header, size, head);
+        _output.assign(head, headSize);
+        _output.append(buf, size);
+        _impl->IProtocolWrite(ProtocolLevel::Application, _output.data(), static_cast<unsigned int>(_output.size()));
+    }
+
+    void FramePlugin::IProtocolPluginClose() {
+        _closed = true;
+        _impl->IProtocolClose(ProtocolLevel::Application);
+    }
+
+    void FramePlugin::IProtocolPluginRelease() {
+        delete this;
+    }
+
+    FramePluginCreator::FramePluginCreator() : _init(false), _header(FrameHeader::Fixed32), _maxSize(0x100000) {
+    }
+
+    void FramePluginCreator::Initialize(FrameHeader header, unsigned int maxSize) {
+        _init = true;
+        _header = header;
+        _maxSize = maxSize;
+    }
+
+    bool FramePluginCreator::ICreatorInit() {
+        return _init;
+    }
+
+    void FramePluginCreator::ICreatorRelease() {
+        delete this;
+    }
+
+    ProtocolPlugin *FramePluginCreator::ICreatorAlloc(ProtocolImplement *impl) {
+        return new FramePlugin(_header, _maxSize, impl);
+    }
+
+    WebSocketPlugin::WebSocketPlugin(ProtocolImplement *impl): WebSocketPlugin(WebSocketOpcode::Text, impl) {
+    }
+
+    WebSocketPlugin::WebSocketPlugin(WebSocketOpcode opcode, ProtocolImplement *impl) : ProtocolPlugin(
+            ProtocolLevel::WebSocket, impl),
+        _error(0),
+        _handshaked(false),
+        _opcode(opcode),
+        _protocol(this) {
+        _errorstr.resize(256);
+        _errorstr.clear();
+    }
+
+    WebSocketPlugin::~WebSocketPlugin() = default;
+
+    void WebSocketPlugin::InitializeServerMode() {
+        _protocol.Initialize();
+    }
+
+    void WebSocketPlugin::InitializeClientMode(const char *host) {
+        if (host) {
+            _hostname = host;
+            _protocol.Initialize();
+        }
+    }
+
+    void WebSocketPlugin::ImplementClose(WebSocketCode code) {
+        _protocol.Close(code);
+        _error = static_cast<int>(code);
+        _errorstr = _protocol.GetErrorDesc(code);
+        _impl->IProtocolClose(ProtocolLevel::WebSocket);
+    }
+
+    int WebSocketPlugin::IProtocolLastError() {
+        return _error;
+    }
+
+    const char *WebSocketPlugin::IProtocolLastErrDesc() {
+        return _errorstr.c_str();
+    }
+
+    bool WebSocketPlugin::IProtocolPluginOpen() {
+        if (!_hostname.empty() && !_handshaked) {
+            _protocol.HandshakeRequest(_hostname.c_str(), _serverKey);
+        }
+        return true;
+    }
+
+    bool WebSocketPlugin::IProtocolPluginRead(const char *buf, unsigned int size) {
+        if (!_handshaked) {
+            if (!_hostname.empty()) {
+                if (!_protocol.CheckServerSecKey(buf, size, _serverKey)) {
+                    _impl->IProtocolClose(ProtocolLevel::WebSocket);
+                    return false;
+                }
+            } else {
+                if (!_protocol.HandshakeResponse(buf, size)) {
+                    _impl->IProtocolClose(ProtocolLevel::WebSocket);
+                    return false;
+                }
+            }
+            _handshaked = true;
+            _impl->IProtocolOpen(ProtocolLevel::WebSocket);
+        } else {
+            if (!_protocol.Read(buf, size)) {
+                ImplementClose(WebSocketCode::AbNormal);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void WebSocketPlugin::IProtocolPluginWrite(const char *buf, unsigned int size) {
+        _protocol.Write(buf, size);
+    }
+
+    void WebSocketPlugin::IProtocolPluginClose() {
+        ImplementClose(WebSocketCode::Normal);
+    }
+
+    void WebSocketPlugin::IProtocolPluginRelease() {
+        delete this;
+    }
+
+    void WebSocketPlugin::IWebSocketInit(WebSocketMode &mode) {
+        mode.mark = !_hostname.empty();
+        mode.opcode = _opcode;
+    }
+
+    void WebSocketPlugin::IWebSocketReceive(WebSocketFrameHeader &header, const char *buf, unsigned int size) {
+        switch (header.opcode) {
+            case WebSocketOpcode::Close:
+                ImplementClose(WebSocketCode::Normal);
+                break;
+            case WebSocketOpcode::Pong:
+                _protocol.Pong(buf, size);
+                break;
+            default: {
+                if (header.opcode != _opcode) {
+                    ImplementClose(WebSocketCode::Unsupported);
+                    break;
+                }
+                _impl->IProtocolRead(ProtocolLevel::WebSocket, buf, size);
+                break;
+            }
+        }
+    }
+
+    void WebSocketPlugin::IWebSocketWrite(const char *buf, unsigned int size) {
+        _impl->IProtocolWrite(ProtocolLevel::WebSocket, buf, size);
+    }
+
+    WebSocketPluginCreator::WebSocketPluginCreator(): _init(false), _opcode(WebSocketOpcode::Binary) {
+    }
+
+    void WebSocketPluginCreator::InitializeServerMode(WebSocketOpcode opcode) {
+        _init = true;
+        _opcode = opcode;
+    }
+
+    void WebSocketPluginCreator::InitializeClientMode(WebSocketOpcode opcode, const char *hostname) {
+        if (hostname) {
+            _hostname = hostname;
+        }
+        _init = true;
+        _opcode = opcode;
+    }
+
+    bool WebSocketPluginCreator::ICreatorInit() {
+        return _init;
+    }
+
+    void WebSocketPluginCreator::ICreatorRelease() {
+        delete this;
+    }
+
+    ProtocolPlugin * WebSocketPluginCreator::ICreatorAlloc(ProtocolImplement *impl) {
+        auto plugin = new WebSocketPlugin(_opcode, impl);
+        if (_hostname.empty()) {
+            plugin->InitializeServerMode();
+        } else {
+            plugin->InitializeClientMode(_hostname.c_str());
+        }
+        return plugin;
+    }
+
+    MbedTLSPlugin::MbedTLSPlugin(ProtocolImplement *impl) : ProtocolPlugin(ProtocolLevel::StreamWithSSL, impl),
+                                                            _error(0) {
+        _buffer.resize(0x4000); // 16384
+        _buffer.clear();
+        _errorstr.resize(256);
+        _errorstr.clear();
+    }
+
+    MbedTLSPlugin::~MbedTLSPlugin() {
+        _mbedtls.Release();
+    }
+
+    Protocol::MbedTLS &MbedTLSPlugin::GetMbedTLS() {
+        return _mbedtls;
+    }
+
+    int MbedTLSPlugin::IProtocolLastError() {
+        return _error;
+    }
+
+    const char *MbedTLSPlugin::IProtocolLastErrDesc() {
+        if (_error) {
+            mbedtls_strerror(_error, const_cast<char *>(_errorstr.data()), _errorstr.capacity());
+        }
+        return _errorstr.c_str();
+    }
+
+    bool MbedTLSPlugin::IProtocolPluginOpen() {
+        mbedtls_ssl_set_bio(_mbedtls.GetSSLContext(), this, MbedTLSPlugin::MbedTLSSendCallback,
+                            MbedTLSPlugin::MbedTLSRecvCallback, nullptr);
+        if (_mbedtls.ClientMode()) {
+            if (!Handshake()) {
+                ImplementClose();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool MbedTLSPlugin::IProtocolPluginRead(const char *buf, unsigned int size) {
+        _bufferIn.Write(buf, size);
+        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
+        if (ctx->private_state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            if (!Handshake()) {
+                ImplementClose();
+                return false;
+            }
+            if (ctx->private_state == MBEDTLS_SSL_HANDSHAKE_OVER) {
+                if (!_mbedtls.Verify()) {
+                    ImplementClose();
+                    return false;
+                }
+                ImplementOpen();
+            }
+        }
+        if (ctx->private_state == MBEDTLS_SSL_HANDSHAKE_OVER) {
+            while (_bufferIn.UsedSize() > 0) {
+                int r = mbedtls_ssl_read(ctx, reinterpret_cast<unsigned char *>(const_cast<char *>(_buffer.data())),
+                                         _buffer.capacity());
+                if (r <= 0 && r != MBEDTLS_ERR_SSL_WANT_READ && r != MBEDTLS_ERR_SSL_WANT_WRITE) {
+                    _error = r;
+                    ImplementClose();
+                    return false;
+                }
+                if (r <= 0) {
+                    // 原实现在此把负长度交给上层, 基准中跳过
+                    break;
+                }
+                ImplementReceive(_buffer.data(), r);
+            }
+        }
+        return true;
+    }
+
+    void MbedTLSPlugin::IProtocolPluginWrite(const char *buf, unsigned int size) {
+        unsigned int offset = 0;
+        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
+        do {
+            int r = mbedtls_ssl_write(ctx, reinterpret_cast<const unsigned char *>(buf + offset), size - offset);
+            if (r > 0 || r == MBEDTLS_ERR_SSL_WANT_READ || r == MBEDTLS_ERR_SSL_WANT_WRITE) {
+                WantFlush();
+            } else {
+                _error = r;
+                return ImplementClose();
+            }
+            offset += r;
+        } while (offset < size);
+    }
+
+    void MbedTLSPlugin::IProtocolPluginClose() {
+        bool handshaked = _mbedtls.GetSSLContext()->private_state == MBEDTLS_SSL_HANDSHAKE_OVER;
+        _mbedtls.Release();
+        if (handshaked) {
+            ImplementClose();
+        }
+    }
+
+    void MbedTLSPlugin::IProtocolPluginRelease() {
+        delete this;
+    }
+
+    bool MbedTLSPlugin::Handshake() {
+        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
+        while (ctx->private_state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            _error = mbedtls_ssl_handshake_step(ctx);
+            if (_error != 0 && _error != MBEDTLS_ERR_SSL_WANT_READ && _error != MBEDTLS_ERR_SSL_WANT_WRITE) {
+                return false;
+            }
+            if (_error == MBEDTLS_ERR_SSL_WANT_READ) {
+                break;
+            }
+        }
+        WantFlush();
+        return true;
+    }
+
+    void MbedTLSPlugin::WantFlush() {
+        unsigned int l = _bufferOut.UsedSize();
+        while (l > 0) {
+            const unsigned int r = _bufferOut.Read(const_cast<char *>(_buffer.data()), _buffer.capacity());
+            GetImpl()->IProtocolWrite(ProtocolLevel::StreamWithSSL, _buffer.data(), r);
+            l -= r;
+        }
+    }
+
+    void MbedTLSPlugin::ImplementOpen() {
+        GetImpl()->IProtocolOpen(ProtocolLevel::StreamWithSSL);
+    }
+
+    void MbedTLSPlugin::ImplementClose() {
+        GetImpl()->IProtocolClose(ProtocolLevel::StreamWithSSL);
+    }
+
+    void MbedTLSPlugin::ImplementReceive(const char *buf, unsigned int size) {
+        GetImpl()->IProtocolRead(ProtocolLevel::StreamWithSSL, buf, size);
+    }
+
+
+    int MbedTLSPlugin::MbedTLSRecvCallback(void *ctx, unsigned char *buf, size_t size) {
+        auto plugin = static_cast<MbedTLSPlugin *>(ctx);
+        const int r = static_cast<int>(plugin->_bufferIn.Read(reinterpret_cast<char *>(buf), size));
+        if (r > 0) {
+            return r;
+        }
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+
+    int MbedTLSPlugin::MbedTLSSendCallback(void *ctx, const unsigned char *buf, size_t size) {
+        auto plugin = static_cast<MbedTLSPlugin *>(ctx);
+        const int r = static_cast<int>(plugin->_bufferOut.Write(reinterpret_cast<const char *>(buf), size));
+        if (r > 0) {
+            return r;
+        }
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+
+    MbedTLSPluginCreator::MbedTLSPluginCreator(): _init(false), _mbedtls(nullptr) {
+    }
+
+    MbedTLSPluginCreator::~MbedTLSPluginCreator() {
+        if (_mbedtls) {
+            _mbedtls->Release();
+            delete _mbedtls;
+        }
+    };
+
+    bool MbedTLSPluginCreator::InitializeClientMode(const char *host, const char *caroot) {
+        if (!host) {
+            return false;
+        }
+        _host.assign(host);
+        if (caroot) {
+            _caroot.assign(caroot);
+        }
+        _init = true;
+        return true;
+    }
+
+    bool MbedTLSPluginCreator::InitializeServerMode(const char *cert, const char *key, const char *password) {
+        if (!_mbedtls) {
+            _mbedtls = new Protocol::MbedTLS;
+            if (_mbedtls->InitializeForServer(cert, key, password)) {
+                _init = true;
+                return true;
+            }
+            _mbedtls->Release();
+            delete _mbedtls;
+            _mbedtls = nullptr;
+        }
+        return false;
+    }
+
+    bool MbedTLSPluginCreator::ICreatorInit() {
+        return _init;
+    }
+
+    void MbedTLSPluginCreator::ICreatorRelease() {
+        delete this;
+    }
+
+    ProtocolPlugin *MbedTLSPluginCreator::ICreatorAlloc(ProtocolImplement *impl) {
+        auto plugin = new MbedTLSPlugin(impl);
+        if (_mbedtls) {
+            if (plugin->GetMbedTLS().InitializeForSession(*_mbedtls)) {
+                return plugin;
+            }
+            _mbedtls->Release();
+        } else {
+            if (plugin->GetMbedTLS().InitializeForClient(_host.c_str(), _caroot.empty() ? nullptr : _caroot.c_str())) {
+                return plugin;
+            }
+        }
+        delete plugin;
+        return nullptr;
+    }
+}
@@ -0,0 +1,301 @@
+//
+// Created by liao on 2026/10/19.
+//
+// 流水线改造(Pipeline)之前的FramePlugin/WebSocketPlugin/MbedTLSPlugin原始实现, 只作为基准对照
+// 与库内的插件同名, 放在Legacy命名空间, 除MbedTLSPlugin读取时丢弃WANT_READ的负长度外保持原样
+//
+
+#ifndef LCC_MICROBENCH_LEGACY_PLUGINS_H
+#define LCC_MICROBENCH_LEGACY_PLUGINS_H
+
+#include <string>
+#include <buffer/Bio.h>
+#include <network/ProtocolPlugin.h>
+#include <network/pipeline/FramingLayer.h>
+#include <network/protocol/MbedTLS.h>
+#include <network/protocol/WebSocket.h>
+
+namespace Legacy {
+    using Lcc::BufferBio;
+    using Lcc::FrameHeader;
+    using Lcc::ProtocolImplement;
+    using Lcc::ProtocolLevel;
+    using Lcc::ProtocolPlugin;
+    using Lcc::ProtocolPluginCreator;
+    using Lcc::WebSocketCode;
+    using Lcc::WebSocketFrameHeader;
+    using Lcc::WebSocketImplement;
+    using Lcc::WebSocketMode;
+    using Lcc::WebSocketOpcode;
+    using Lcc::WebSocketProtocol;
+    namespace Protocol = Lcc::Protocol;
+
+    /**
+     * 长度前缀分帧插件, 位于应用层: 收到的数据按帧回调, 写入的数据自动添加长度头
+     * 完整落在一次读取内的帧直接指向读缓冲区回调, 只有跨读取的残帧才会缓存
+     */
+    class FramePlugin : public ProtocolPlugin {
+    public:
+        FramePlugin(FrameHeader header, unsigned int maxSize, ProtocolImplement *impl);
+
+        ~FramePlugin() override;
+
+        /**
+         * 编码长度头
+         * @param header 长度头格式
+         * @param size 帧长度
+         * @param out 输出缓冲区, 至少kMaxHeadSize字节
+         * @return 长度头字节数
+         */
+        static unsigned int EncodeHead(FrameHeader header, unsigned int size, char *out);
+
+        /**
+         * 解码长度头
+         * @param header 长度头格式
+         * @param buf 数据
+         * @param size 数据长度
+         * @param body 输出帧长度
+         * @return 长度头字节数, 数据不足返回0, 格式错误返回负数
+         */
+        static int DecodeHead(FrameHeader header, const char *buf, unsigned int size, unsigned int &body);
+
+        /**
+         * 获取直接从读缓冲区回调的帧数量
+         * @return 帧数量
+         */
+        unsigned long long DirectFrames() const;
+
+        /**
+         * 获取经过缓存拼接后回调的帧数量
+         * @return 帧数量
+         */
+        unsigned long long BufferedFrames() const;
+
+    public:
+        static const unsigned int kMaxHeadSize = 5;
+
+    protected:
+        /**
+         * 出错关闭
+         * @param err 错误码
+         * @param desc 错误描述
+         */
+        void ImplementClose(int err, const char *desc);
+
+    protected:
+        int IProtocolLastError() override;
+
+        const char *IProtocolLastErrDesc() override;
+
+        bool IProtocolPluginOpen() override;
+
+        bool IProtocolPluginRead(const char *buf, unsigned int size) override;
+
+        void IProtocolPluginWrite(const char *buf, unsigned int size) override;
+
+        void IProtocolPluginClose() override;
+
+        void IProtocolPluginRelease() override;
+
+    private:
+        int _error;
+        bool _closed;
+        FrameHeader _header;
+        unsigned int _maxSize;
+        // 残帧完整长度(含长度头), 0表示长度头尚不完整
+        unsigned int _need;
+        unsigned int _head;
+        unsigned long long _direct;
+        unsigned long long _buffered;
+        std::string _errorstr;
+        std::string _pending;
+        std::string _output;
+    };
+
+    class FramePluginCreator : public ProtocolPluginCreator {
+    public:
+        FramePluginCreator();
+
+        /**
+         * 初始化
+         * @param header 长度头格式
+         * @param maxSize 单帧最大长度(不含长度头), 超出时关闭连接
+         */
+        void Initialize(FrameHeader header, unsigned int maxSize);
+
+    protected:
+        bool ICreatorInit() override;
+
+        void ICreatorRelease() override;
+
+        ProtocolPlugin *ICreatorAlloc(ProtocolImplement *impl) override;
+
+    private:
+        bool _init;
+        FrameHeader _header;
+        unsigned int _maxSize;
+    };
+
+    class WebSocketPlugin : public ProtocolPlugin, public WebSocketImplement {
+    public:
+        explicit WebSocketPlugin(ProtocolImplement *impl);
+
+        WebSocketPlugin(WebSocketOpcode opcode, ProtocolImplement *impl);
+
+        ~WebSocketPlugin() override;
+
+        /**
+         * 初始化服务端模式
+         */
+        void InitializeServerMode();
+
+        /**
+         * 初始化客户端模式
+         * @param host 远端地址
+         */
+        void InitializeClientMode(const char *host);
+
+    protected:
+        /**
+         * 关闭
+         * @param code 原因
+         */
+        void ImplementClose(WebSocketCode code);
+
+    protected:
+        int IProtocolLastError() override;
+
+        const char *IProtocolLastErrDesc() override;
+
+        bool IProtocolPluginOpen() override;
+
+        bool IProtocolPluginRead(const char *buf, unsigned int size) override;
+
+        void IProtocolPluginWrite(const char *buf, unsigned int size) override;
+
+        void IProtocolPluginClose() override;
+
+        void IProtocolPluginRelease() override;
+
+    protected:
+        void IWebSocketInit(WebSocketMode &mode) override;
+
+        void IWebSocketReceive(WebSocketFrameHeader &header, const char *buf, unsigned int size) override;
+
+        void IWebSocketWrite(const char *buf, unsigned int size) override;
+
+    private:
+        int _error;
+        bool _handshaked;
+        std::string _errorstr;
+        std::string _hostname;
+        std::string _serverKey;
+        WebSocketOpcode _opcode;
+        WebSocketProtocol _protocol;
+    };
+
+    class WebSocketPluginCreator : public ProtocolPluginCreator {
+    public:
+        WebSocketPluginCreator();
+
+        /**
+         * 初始化服务端模式
+         * @param opcode 启用的操作码
+         */
+        void InitializeServerMode(WebSocketOpcode opcode);
+
+        /**
+         * 初始化客户端模式
+         * @param opcode 启用的操作码
+         * @param hostname 远端地址
+         */
+        void InitializeClientMode(WebSocketOpcode opcode, const char *hostname);
+
+    protected:
+        bool ICreatorInit() override;
+
+        void ICreatorRelease() override;
+
+        ProtocolPlugin *ICreatorAlloc(ProtocolImplement *impl) override;
+
+    private:
+        bool _init;
+        std::string _hostname;
+        WebSocketOpcode _opcode;
+    };
+
+    class MbedTLSPlugin : public ProtocolPlugin {
+    public:
+        explicit MbedTLSPlugin(ProtocolImplement *impl);
+
+        ~MbedTLSPlugin() override;
+
+        Protocol::MbedTLS &GetMbedTLS();
+
+    protected:
+        int IProtocolLastError() override;
+
+        const char *IProtocolLastErrDesc() override;
+
+        bool IProtocolPluginOpen() override;
+
+        bool IProtocolPluginRead(const char *buf, unsigned int size) override;
+
+        void IProtocolPluginWrite(const char *buf, unsigned int size) override;
+
+        void IProtocolPluginClose() override;
+
+        void IProtocolPluginRelease() override;
+
+    protected:
+        bool Handshake();
+
+        void WantFlush();
+
+    protected:
+        void ImplementOpen();
+
+        void ImplementClose();
+
+        void ImplementReceive(const char *buf, unsigned int size);
+
+    protected:
+        static int MbedTLSRecvCallback(void *ctx, unsigned char *buf, size_t size);
+
+        static int MbedTLSSendCallback(void *ctx, const unsigned char *buf, size_t size);
+
+    private:
+        int _error;
+        std::string _buffer;
+        std::string _errorstr;
+        BufferBio _bufferIn;
+        BufferBio _bufferOut;
+        Protocol::MbedTLS _mbedtls;
+    };
+
+    class MbedTLSPluginCreator : public ProtocolPluginCreator {
+    public:
+        MbedTLSPluginCreator();
+
+        ~MbedTLSPluginCreator() override;
+
+        bool InitializeClientMode(const char *host, const char *caroot);
+
+        bool InitializeServerMode(const char *cert, const char *key, const char *password);
+
+    protected:
+        bool ICreatorInit() override;
+
+        void ICreatorRelease() override;
+
+        ProtocolPlugin *ICreatorAlloc(ProtocolImplement *impl) override;
+
+    private:
+        bool _init;
+        std::string _host;
+        std::string _caroot;
+        Protocol::MbedTLS *_mbedtls;
+    };
+}
+
+#endif //LCC_MICROBENCH_LEGACY_PLUGINS_H
@@ -0,0 +1,39 @@
+//
+// Created by liao on 2026/10/19.
+//
+// 库内热点路径的微基准, 结果只在Release编译下有参考意义
+//   LccMicroBench [--filter NAME] [--min-time SEC] [--perf] [--json] [--list]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "MicroBench.h"
+
+static void Usage(const char *name) {
+    fprintf(stderr, "usage: %s [--filter NAME] [--min-time SEC] [--perf] [--json] [--list]\n", name);
+}
+
+int main(int argc, char *argv[]) {
+    MicroBench::Options options;
+    for (int n = 1; n < argc; ++n) {
+        const std::string arg = argv[n];
+        if (arg == "--perf") {
+            options.perf = true;
+        } else if (arg == "--json") {
+            options.json = true;
+        } else if (arg == "--list") {
+            for (auto benchmark: MicroBench::Benchmarks()) {
+                printf("%s\n", benchmark->Name().c_str());
+            }
+            return 0;
+        } else if (arg == "--filter" && n + 1 < argc) {
+            options.filter = argv[++n];
+        } else if (arg == "--min-time" && n + 1 < argc) {
+            options.minTime = strtod(argv[++n], nullptr);
+        } else {
+            Usage(argv[0]);
+            return 2;
+        }
+    }
+    return MicroBench::Run(options) > 0 ? 0 : 1;
+}
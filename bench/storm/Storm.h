@@ -0,0 +1,156 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_STORM_H
+#define LCC_STORM_H
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <uv.h>
+
+namespace Storm {
+    /**
+     * 测试参数
+     */
+    struct Config {
+        // 模式: storm为连接风暴, soak为长时间循环建连断连
+        std::string mode;
+        // 传输方式: tcp/tls/ws/wss
+        std::string transport;
+        // 服务端口
+        unsigned short port;
+        // 连接数: storm为发起的总连接数, soak为同时保持的连接数
+        unsigned int connections;
+        // 客户端线程数
+        unsigned int threads;
+        // 每秒发起的连接数(所有线程合计), 0表示不限速
+        unsigned int rate;
+        // 源地址个数, 依次使用127.0.0.1~127.0.0.N
+        unsigned int sourceIps;
+        // 源端口范围, 为0时由系统分配(所有源地址共用临时端口范围, 约2.8万个)
+        unsigned short portLow;
+        unsigned short portHigh;
+        // storm: 全部连接完成后保持的时间(秒)
+        double hold;
+        // soak: 运行时间(秒)
+        double duration;
+        // soak: 连接平均存活时间(秒), 实际在0.5~1.5倍之间随机
+        double lifetime;
+        // 采样间隔(秒)
+        double interval;
+        // soak: 每次连接循环的内存增长超过该值(字节)视为泄漏
+        double leakThreshold;
+        // 证书与私钥(tls/wss)
+        std::string cert;
+        std::string key;
+        // 输出文件, 为空时输出到标准输出
+        std::string output;
+
+        Config() : mode("storm"), transport("tcp"), port(18600), connections(1000), threads(2), rate(0),
+                   sourceIps(1), portLow(0), portHigh(0), hold(1.0), duration(60.0), lifetime(1.0), interval(1.0),
+                   leakThreshold(64.0) {
+        }
+
+        bool Soak() const {
+            return mode == "soak";
+        }
+
+        bool Tls() const {
+            return transport == "tls" || transport == "wss";
+        }
+
+        bool WebSocket() const {
+            return transport == "ws" || transport == "wss";
+        }
+
+        /**
+         * 获取客户端连接地址, TLS由连接自行启用
+         * @return 地址
+         */
+        std::string ClientUrl() const {
+            return (WebSocket() ? "ws://127.0.0.1:" : "tcp://127.0.0.1:") + std::to_string(port);
+        }
+    };
+
+    /**
+     * 客户端计数, 各线程累加, 采样时读取
+     */
+    struct Counters {
+        // 发起的连接数
+        std::atomic<unsigned long long> attempted;
+        // 完成握手的连接数
+        std::atomic<unsigned long long> established;
+        // 连接或握手失败数
+        std::atomic<unsigned long long> failed;
+        // 建立后正常关闭的连接数, soak模式下即完成的循环次数
+        std::atomic<unsigned long long> cycles;
+        // 绑定源地址失败数
+        std::atomic<unsigned long long> bindErrors;
+        // 尚未回收的连接对象数
+        std::atomic<long long> live;
+
+        Counters() : attempted(0), established(0), failed(0), cycles(0), bindErrors(0), live(0) {
+        }
+    };
+
+    /**
+     * 连接发起时刻表, 以源地址和端口为键, 服务端接受连接时取出计算接受延迟
+     */
+    class ConnectClock {
+    public:
+        ConnectClock() {
+            uv_mutex_init(&_mutex);
+        }
+
+        ~ConnectClock() {
+            uv_mutex_destroy(&_mutex);
+        }
+
+        static unsigned long long Key(const sockaddr_in &addr) {
+            return (static_cast<unsigned long long>(addr.sin_addr.s_addr) << 16) | addr.sin_port;
+        }
+
+        void Mark(unsigned long long key, unsigned long long time) {
+            uv_mutex_lock(&_mutex);
+            _clock[key] = time;
+            uv_mutex_unlock(&_mutex);
+        }
+
+        /**
+         * 取出发起时刻
+         * @param key 键
+         * @return 发起时刻, 未找到时为0
+         */
+        unsigned long long Take(unsigned long long key) {
+            unsigned long long time = 0;
+            uv_mutex_lock(&_mutex);
+            const auto it = _clock.find(key);
+            if (it != _clock.end()) {
+                time = it->second;
+                _clock.erase(it);
+            }
+            uv_mutex_unlock(&_mutex);
+            return time;
+        }
+
+    private:
+        uv_mutex_t _mutex;
+        std::unordered_map<unsigned long long, unsigned long long> _clock;
+    };
+
+    /**
+     * 获取进程打开的文件描述符数
+     * @return 描述符数, 不支持时为-1
+     */
+    long OpenFiles();
+
+    /**
+     * 获取进程常驻内存
+     * @return 字节数
+     */
+    unsigned long long ResidentBytes();
+}
+
+#endif //LCC_STORM_H
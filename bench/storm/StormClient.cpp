@@ -0,0 +1,219 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <algorithm>
+#include <network/plugin/MbedTLSPlugin.h>
+#include "StormClient.h"
+
+namespace Storm {
+    static const double kNanoPerSecond = 1e9;
+    // 不限速时每次定时回调最多发起的连接数, 避免单次回调过长
+    static const unsigned int kBurst = 1024;
+
+    Connection::Connection(StormClient *owner, unsigned long long index) : _established(false), _closing(false),
+                                                                           _retired(false), _slot(0),
+                                                                           _index(index), _start(0), _deadline(0),
+                                                                           _owner(owner), _client(this) {
+    }
+
+    Connection::~Connection() = default;
+
+    void Connection::Connect() {
+        const Config &config = _owner->_config;
+        if (config.Tls()) {
+            auto ssl = new Lcc::MbedTLSPluginCreator;
+            ssl->SetMaxVersion(MBEDTLS_SSL_VERSION_TLS1_2);
+            ssl->InitializeClientMode("127.0.0.1", config.cert.c_str());
+            _client.Enable(ssl);
+        }
+        if (config.WebSocket()) {
+            _client.EnableWebSocketOpcode(Lcc::WebSocketOpcode::Binary);
+        }
+        ++_owner->_counters.attempted;
+        _start = uv_hrtime();
+        _client.Connect(_owner->_url.c_str());
+    }
+
+    void Connection::Close() {
+        if (_established && !_closing) {
+            _closing = true;
+            _client.Shutdown();
+        }
+    }
+
+    bool Connection::IClientInit(Lcc::StreamHandle &handle) {
+        handle.tcpSession = static_cast<unsigned int>(_index);
+        if (uv_tcp_init(_owner->GetEventLoop(), &handle.tcpHandle) != 0) {
+            return false;
+        }
+        Bind(&handle.tcpHandle);
+        return true;
+    }
+
+    void Connection::Bind(uv_tcp_t *handle) {
+        const Config &config = _owner->_config;
+        const unsigned long long ports = config.portLow ? config.portHigh - config.portLow + 1 : 1;
+        sockaddr_in addr{};
+        uv_ip4_addr("127.0.0.1", config.portLow ? static_cast<int>(config.portLow + _index % ports) : 0, &addr);
+        // 127.0.0.0/8都在回环接口上
+        addr.sin_addr.s_addr = htonl(ntohl(addr.sin_addr.s_addr) + static_cast<uint32_t>(_index / ports % config.sourceIps));
+        if (uv_tcp_bind(handle, reinterpret_cast<const sockaddr *>(&addr), 0) != 0) {
+            // 绑定失败时由系统在连接时分配, 该连接不计接受延迟
+            ++_owner->_counters.bindErrors;
+            return;
+        }
+        int len = sizeof(addr);
+        if (uv_tcp_getsockname(handle, reinterpret_cast<sockaddr *>(&addr), &len) == 0) {
+            _owner->_clock.Mark(ConnectClock::Key(addr), uv_hrtime());
+        }
+    }
+
+    void Connection::IClientReport(bool connected, const char *err) {
+        if (connected) {
+            _established = true;
+            _owner->OnEstablished(this);
+        } else {
+            ++_owner->_counters.failed;
+            _owner->Retire(this);
+        }
+    }
+
+    void Connection::IClientReceive(const char *buf, unsigned int size) {
+    }
+
+    void Connection::IClientBeforeDisconnect(int err, const char *errMsg) {
+    }
+
+    void Connection::IClientAfterDisconnect() {
+        if (!_established) {
+            // 握手(TLS/WebSocket)失败
+            ++_owner->_counters.failed;
+        } else {
+            ++_owner->_counters.cycles;
+        }
+        _owner->Retire(this);
+    }
+
+    StormClient::StormClient(const Config &config, Counters &counters, ConnectClock &clock, unsigned int first,
+                             unsigned int count) : _config(config), _counters(counters), _clock(clock),
+                                                   _url(config.ClientUrl()), _count(count), _stopping(false),
+                                                   _next(first), _launched(0), _budget(0), _lastTick(0),
+                                                   _seed(first * 2654435761ULL + 1), _timer() {
+    }
+
+    StormClient::~StormClient() {
+        for (auto connection: _live) {
+            delete connection;
+        }
+        for (auto connection: _retired) {
+            delete connection;
+        }
+    }
+
+    void StormClient::Stop() {
+        QueueMessage(this);
+    }
+
+    const Lcc::Utils::Histogram &StormClient::ConnectLatency() const {
+        return _connectLatency;
+    }
+
+    bool StormClient::IInit() {
+        uv_timer_init(GetEventLoop(), &_timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_timer), this);
+        uv_timer_start(&_timer, StormClient::UvTickCallback, 0, 1);
+        _lastTick = uv_hrtime();
+        return true;
+    }
+
+    void StormClient::IMessage(void *message) {
+        _stopping = true;
+        for (auto connection: _live) {
+            connection->Close();
+        }
+    }
+
+    void StormClient::IShutdown() {
+        uv_close(reinterpret_cast<uv_handle_t *>(&_timer), nullptr);
+    }
+
+    void StormClient::OnEstablished(Connection *connection) {
+        const unsigned long long now = uv_hrtime();
+        ++_counters.established;
+        _connectLatency.Record(now - connection->_start);
+        if (_stopping) {
+            connection->Close();
+        } else if (_config.Soak()) {
+            connection->_deadline = now + Lifetime();
+        }
+    }
+
+    void StormClient::Retire(Connection *connection) {
+        if (connection->_retired) {
+            return;
+        }
+        connection->_retired = true;
+        // 从存活列表中交换删除
+        Connection *last = _live.back();
+        _live[connection->_slot] = last;
+        last->_slot = connection->_slot;
+        _live.pop_back();
+        _retired.push_back(connection);
+    }
+
+    void StormClient::Tick() {
+        const unsigned long long now = uv_hrtime();
+        // 关闭回调在上一轮循环中已完成, 可以安全释放
+        for (auto connection: _retired) {
+            delete connection;
+            --_counters.live;
+        }
+        _retired.clear();
+        if (_stopping) {
+            return;
+        }
+        if (_config.Soak()) {
+            for (size_t n = 0; n < _live.size(); ++n) {
+                Connection *connection = _live[n];
+                if (connection->_established && connection->_deadline <= now) {
+                    connection->Close();
+                }
+            }
+        }
+        unsigned int allowed = kBurst;
+        if (_config.rate > 0) {
+            _budget += (now - _lastTick) / kNanoPerSecond * _config.rate / _config.threads;
+            allowed = static_cast<unsigned int>(_budget);
+        }
+        _lastTick = now;
+        unsigned int launched = 0;
+        while (launched < allowed && _live.size() < _count && (_config.Soak() || _launched < _count)) {
+            auto connection = new Connection(this, _next);
+            _next += _config.threads;
+            ++_launched;
+            ++launched;
+            ++_counters.live;
+            connection->_slot = _live.size();
+            _live.push_back(connection);
+            connection->Connect();
+        }
+        if (_config.rate > 0) {
+            // 连接数已满时配额最多累积10毫秒, 避免补连时瞬间突发
+            const double cap = std::max(1.0, static_cast<double>(_config.rate) / _config.threads / 100);
+            _budget = std::min(_budget - launched, cap);
+        }
+    }
+
+    unsigned long long StormClient::Lifetime() {
+        // xorshift
+        _seed ^= _seed << 13;
+        _seed ^= _seed >> 7;
+        _seed ^= _seed << 17;
+        const double jitter = 0.5 + static_cast<double>(_seed % 1000000) / 1000000;
+        return static_cast<unsigned long long>(_config.lifetime * jitter * kNanoPerSecond);
+    }
+
+    void StormClient::UvTickCallback(uv_timer_t *handle) {
+        static_cast<StormClient *>(uv_handle_get_data(reinterpret_cast<uv_handle_t *>(handle)))->Tick();
+    }
+}
@@ -0,0 +1,151 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_STORM_STORMCLIENT_H
+#define LCC_STORM_STORMCLIENT_H
+
+#include <vector>
+#include <thread/Thread.h>
+#include <network/TcpClient.h>
+#include <utils/Histogram.h>
+#include "Storm.h"
+
+namespace Storm {
+    class StormClient;
+
+    /**
+     * 单个连接, 每次连接使用新的对象, 关闭后由所属线程在下一次定时回调时回收
+     */
+    class Connection final : public Lcc::ClientImplement {
+        friend class StormClient;
+
+    public:
+        Connection(StormClient *owner, unsigned long long index);
+
+        ~Connection() override;
+
+        /**
+         * 发起连接
+         */
+        void Connect();
+
+        /**
+         * 关闭已建立的连接
+         */
+        void Close();
+
+    protected:
+        bool IClientInit(Lcc::StreamHandle &handle) override;
+
+        void IClientReport(bool connected, const char *err) override;
+
+        void IClientReceive(const char *buf, unsigned int size) override;
+
+        void IClientBeforeDisconnect(int err, const char *errMsg) override;
+
+        void IClientAfterDisconnect() override;
+
+    private:
+        /**
+         * 绑定源地址与端口
+         * @param handle 句柄
+         */
+        void Bind(uv_tcp_t *handle);
+
+    private:
+        bool _established;
+        bool _closing;
+        bool _retired;
+        // 在存活列表中的位置
+        size_t _slot;
+        unsigned long long _index;
+        unsigned long long _start;
+        // soak: 到期关闭的时刻
+        unsigned long long _deadline;
+        StormClient *_owner;
+        Lcc::TcpClient _client;
+    };
+
+    /**
+     * 客户端线程, 按速率发起连接; soak模式下连接到期后关闭并以新连接补足
+     */
+    class StormClient final : public Lcc::Thread {
+        friend class Connection;
+
+    public:
+        /**
+         * @param config 参数
+         * @param counters 计数
+         * @param clock 发起时刻表
+         * @param first 首个连接序号, 之后每次增加threads, 由序号决定源地址与端口
+         * @param count 本线程的连接数
+         */
+        StormClient(const Config &config, Counters &counters, ConnectClock &clock, unsigned int first,
+                    unsigned int count);
+
+        ~StormClient() override;
+
+        /**
+         * 请求停止发起并关闭所有连接
+         */
+        void Stop();
+
+        /**
+         * 客户端发起到握手完成的延迟(纳秒), 线程结束后读取
+         * @return 延迟
+         */
+        const Lcc::Utils::Histogram &ConnectLatency() const;
+
+    protected:
+        bool IInit() override;
+
+        void IMessage(void *message) override;
+
+        void IShutdown() override;
+
+    private:
+        void OnEstablished(Connection *connection);
+
+        /**
+         * 连接结束, 移出存活列表等待回收
+         * @param connection 连接
+         */
+        void Retire(Connection *connection);
+
+        /**
+         * 定时回调: 回收连接、关闭到期连接、按速率发起新连接
+         */
+        void Tick();
+
+        /**
+         * 随机的连接存活时间
+         * @return 纳秒
+         */
+        unsigned long long Lifetime();
+
+        static void UvTickCallback(uv_timer_t *handle);
+
+    private:
+        const Config &_config;
+        Counters &_counters;
+        ConnectClock &_clock;
+        std::string _url;
+        unsigned int _count;
+        bool _stopping;
+        // 下一个连接序号
+        unsigned long long _next;
+        // storm: 已发起的连接数
+        unsigned int _launched;
+        // 限速时可发起的连接数配额
+        double _budget;
+        unsigned long long _lastTick;
+        unsigned long long _seed;
+        uv_timer_t _timer;
+        std::vector<Connection *> _live;
+        std::vector<Connection *> _retired;
+        Lcc::Utils::Histogram _connectLatency;
+    };
+}
+
+#endif //LCC_STORM_STORMCLIENT_H
@@ -0,0 +1,234 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <string>
+#include <network/plugin/MbedTLSPlugin.h>
+#include <network/plugin/WebSocketPlugin.h>
+#include "StormServer.h"
+
+#if defined(__linux__)
+#include <dirent.h>
+#endif
+
+namespace Storm {
+    static const double kNanoPerSecond = 1e9;
+    static const double kNanoPerMicro = 1e3;
+
+    long OpenFiles() {
+#if defined(__linux__)
+        DIR *dir = opendir("/proc/self/fd");
+        if (!dir) {
+            return -1;
+        }
+        long count = 0;
+        while (readdir(dir)) {
+            ++count;
+        }
+        closedir(dir);
+        // 去掉.和..以及目录本身
+        return count - 3;
+#else
+        return -1;
+#endif
+    }
+
+    unsigned long long ResidentBytes() {
+        size_t rss = 0;
+        uv_resident_set_memory(&rss);
+        return rss;
+    }
+
+    AcceptServer::AcceptServer(StormServer *owner, Lcc::ServerImplement *impl) : Lcc::TcpServer(impl),
+                                                                                 _owner(owner) {
+    }
+
+    bool AcceptServer::IStreamInit(Lcc::StreamHandle &handle) {
+        const bool init = TcpServer::IStreamInit(handle);
+        sockaddr_storage storage{};
+        int len = sizeof(storage);
+        unsigned long long key = 0;
+        if (uv_tcp_getpeername(&handle.tcpHandle, reinterpret_cast<sockaddr *>(&storage), &len) == 0 &&
+            storage.ss_family == AF_INET) {
+            key = ConnectClock::Key(reinterpret_cast<const sockaddr_in &>(storage));
+        }
+        _owner->OnAccept(handle.tcpSession, key);
+        return init;
+    }
+
+    void AcceptServer::IStreamOpen(unsigned int session) {
+        _owner->OnHandshake(session);
+        TcpServer::IStreamOpen(session);
+    }
+
+    void AcceptServer::IStreamAfterClose(unsigned int session) {
+        _owner->OnClose(session);
+        TcpServer::IStreamAfterClose(session);
+    }
+
+    StormServer::StormServer(const Config &config, Counters &counters, ConnectClock &clock, FILE *out) :
+        _config(config), _counters(counters), _clock(clock), _out(out), _listen(0), _sessions(0),
+        _server(this, this), _timer(), _begin(0), _accepts(0), _handshakes(0), _lastAccepts(0),
+        _lastEstablished(0), _peakResident(0), _peakOpenFiles(0) {
+    }
+
+    StormServer::~StormServer() = default;
+
+    int StormServer::ListenState() const {
+        return _listen.load();
+    }
+
+    long long StormServer::Sessions() const {
+        return _sessions.load();
+    }
+
+    void StormServer::Stop() {
+        QueueMessage(this);
+    }
+
+    const Lcc::Utils::Histogram &StormServer::AcceptLatency() const {
+        return _acceptTotal;
+    }
+
+    const Lcc::Utils::Histogram &StormServer::HandshakeLatency() const {
+        return _handshakeTotal;
+    }
+
+    const std::vector<Sample> &StormServer::Samples() const {
+        return _samples;
+    }
+
+    unsigned long long StormServer::PeakResident() const {
+        return _peakResident;
+    }
+
+    long StormServer::PeakOpenFiles() const {
+        return _peakOpenFiles;
+    }
+
+    bool StormServer::IInit() {
+        if (_config.WebSocket()) {
+            auto websocket = new Lcc::WebSocketPluginCreator;
+            websocket->InitializeServerMode(Lcc::WebSocketOpcode::Binary);
+            _server.Enable(websocket);
+        }
+        if (_config.Tls()) {
+            auto ssl = new Lcc::MbedTLSPluginCreator;
+            // 内置mbedtls的PSA密钥槽只够十几个TLS1.3连接, 风暴测试限制为TLS1.2
+            ssl->SetMaxVersion(MBEDTLS_SSL_VERSION_TLS1_2);
+            if (!ssl->InitializeServerMode(_config.cert.c_str(), _config.key.c_str(), "")) {
+                delete ssl;
+                _listen = -1;
+                return false;
+            }
+            _server.Enable(ssl);
+        }
+        uv_timer_init(GetEventLoop(), &_timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_timer), this);
+        const auto interval = static_cast<uint64_t>(_config.interval * 1000);
+        uv_timer_start(&_timer, StormServer::UvSampleCallback, interval, interval);
+        _begin = uv_hrtime();
+        const std::string host = "tcp://127.0.0.1:" + std::to_string(_config.port);
+        _server.Listen(host.c_str());
+        return true;
+    }
+
+    void StormServer::IMessage(void *message) {
+        uv_timer_stop(&_timer);
+        Report();
+        _server.Shutdown();
+    }
+
+    void StormServer::IShutdown() {
+        uv_close(reinterpret_cast<uv_handle_t *>(&_timer), nullptr);
+    }
+
+    bool StormServer::IServerInit(Lcc::StreamHandle &handle) {
+        return handle.Init(GetEventLoop()) == 0;
+    }
+
+    void StormServer::IServerListenReport(bool listened, int err, const char *errMsg) {
+        _listen = listened ? 1 : -1;
+    }
+
+    void StormServer::IServerShutdown() {
+    }
+
+    void StormServer::IServerSessionOpen(unsigned int session) {
+    }
+
+    void StormServer::IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) {
+    }
+
+    void StormServer::IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) {
+    }
+
+    void StormServer::IServerSessionAfterClose(unsigned int session) {
+    }
+
+    void StormServer::OnAccept(unsigned int session, unsigned long long key) {
+        const unsigned long long now = uv_hrtime();
+        ++_accepts;
+        ++_sessions;
+        _accepted[session] = now;
+        const unsigned long long start = key ? _clock.Take(key) : 0;
+        if (start && start <= now) {
+            _acceptInterval.Record(now - start);
+            _acceptTotal.Record(now - start);
+        }
+    }
+
+    void StormServer::OnHandshake(unsigned int session) {
+        const auto it = _accepted.find(session);
+        if (it != _accepted.end()) {
+            const unsigned long long elapsed = uv_hrtime() - it->second;
+            _handshakeInterval.Record(elapsed);
+            _handshakeTotal.Record(elapsed);
+        }
+        ++_handshakes;
+    }
+
+    void StormServer::OnClose(unsigned int session) {
+        if (_accepted.erase(session)) {
+            --_sessions;
+        }
+    }
+
+    void StormServer::Report() {
+        const unsigned long long now = uv_hrtime();
+        const double interval = _config.interval;
+        const unsigned long long rss = ResidentBytes();
+        const long files = OpenFiles();
+        const unsigned long long attempted = _counters.attempted.load();
+        const unsigned long long established = _counters.established.load();
+        const unsigned long long cycles = _counters.cycles.load();
+        if (rss > _peakResident) {
+            _peakResident = rss;
+        }
+        if (files > _peakOpenFiles) {
+            _peakOpenFiles = files;
+        }
+        _samples.push_back(Sample{static_cast<double>(cycles), static_cast<double>(rss)});
+        fprintf(_out,
+                "{\"t\":%.3f,\"sessions\":%lld,\"accepted\":%llu,\"accepts_per_second\":%.1f,"
+                "\"attempted\":%llu,\"established\":%llu,\"failed\":%llu,\"handshakes_per_second\":%.1f,"
+                "\"completion\":%.4f,\"accept_us\":{\"p50\":%.1f,\"p99\":%.1f,\"max\":%.1f},"
+                "\"handshake_us\":{\"p50\":%.1f,\"p99\":%.1f,\"max\":%.1f},"
+                "\"cycles\":%llu,\"rss_bytes\":%llu,\"fds\":%ld}\n",
+                (now - _begin) / kNanoPerSecond, _sessions.load(), _accepts, (_accepts - _lastAccepts) / interval,
+                attempted, established, _counters.failed.load(), (established - _lastEstablished) / interval,
+                attempted ? static_cast<double>(established) / attempted : 0.0,
+                _acceptInterval.Percentile(50) / kNanoPerMicro, _acceptInterval.Percentile(99) / kNanoPerMicro,
+                _acceptInterval.Max() / kNanoPerMicro, _handshakeInterval.Percentile(50) / kNanoPerMicro,
+                _handshakeInterval.Percentile(99) / kNanoPerMicro, _handshakeInterval.Max() / kNanoPerMicro,
+                cycles, rss, files);
+        fflush(_out);
+        _lastAccepts = _accepts;
+        _lastEstablished = established;
+        _acceptInterval.Reset();
+        _handshakeInterval.Reset();
+    }
+
+    void StormServer::UvSampleCallback(uv_timer_t *handle) {
+        static_cast<StormServer *>(uv_handle_get_data(reinterpret_cast<uv_handle_t *>(handle)))->Report();
+    }
+}
@@ -0,0 +1,150 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_STORM_STORMSERVER_H
+#define LCC_STORM_STORMSERVER_H
+
+#include <atomic>
+#include <cstdio>
+#include <vector>
+#include <unordered_map>
+#include <thread/Thread.h>
+#include <network/TcpServer.h>
+#include <utils/Histogram.h>
+#include "Storm.h"
+
+namespace Storm {
+    class StormServer;
+
+    /**
+     * 在接受连接与握手完成处记录时间的TcpServer
+     */
+    class AcceptServer final : public Lcc::TcpServer {
+    public:
+        AcceptServer(StormServer *owner, Lcc::ServerImplement *impl);
+
+    protected:
+        bool IStreamInit(Lcc::StreamHandle &handle) override;
+
+        void IStreamOpen(unsigned int session) override;
+
+        void IStreamAfterClose(unsigned int session) override;
+
+    private:
+        StormServer *_owner;
+    };
+
+    /**
+     * 一次采样, soak模式用于估算每次连接循环的内存增长
+     */
+    struct Sample {
+        double cycles;
+        double rss;
+    };
+
+    /**
+     * 被测服务端, 在独立线程上运行, 按间隔输出采样
+     */
+    class StormServer final : public Lcc::Thread, public Lcc::ServerImplement {
+        friend class AcceptServer;
+
+    public:
+        StormServer(const Config &config, Counters &counters, ConnectClock &clock, FILE *out);
+
+        ~StormServer() override;
+
+        /**
+         * 监听状态: 0未完成, 1成功, -1失败
+         * @return 监听状态
+         */
+        int ListenState() const;
+
+        /**
+         * 当前会话数(含握手中)
+         * @return 会话数
+         */
+        long long Sessions() const;
+
+        /**
+         * 请求关闭监听与所有会话
+         */
+        void Stop();
+
+        /**
+         * 以下在线程结束后读取
+         */
+        const Lcc::Utils::Histogram &AcceptLatency() const;
+
+        const Lcc::Utils::Histogram &HandshakeLatency() const;
+
+        const std::vector<Sample> &Samples() const;
+
+        unsigned long long PeakResident() const;
+
+        long PeakOpenFiles() const;
+
+    protected:
+        bool IInit() override;
+
+        void IMessage(void *message) override;
+
+        void IShutdown() override;
+
+        bool IServerInit(Lcc::StreamHandle &handle) override;
+
+        void IServerListenReport(bool listened, int err, const char *errMsg) override;
+
+        void IServerShutdown() override;
+
+        void IServerSessionOpen(unsigned int session) override;
+
+        void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override;
+
+        void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override;
+
+        void IServerSessionAfterClose(unsigned int session) override;
+
+    private:
+        void OnAccept(unsigned int session, unsigned long long key);
+
+        void OnHandshake(unsigned int session);
+
+        void OnClose(unsigned int session);
+
+        /**
+         * 输出一次采样
+         */
+        void Report();
+
+        static void UvSampleCallback(uv_timer_t *handle);
+
+    private:
+        const Config &_config;
+        Counters &_counters;
+        ConnectClock &_clock;
+        FILE *_out;
+        std::atomic<int> _listen;
+        std::atomic<long long> _sessions;
+        AcceptServer _server;
+        uv_timer_t _timer;
+        unsigned long long _begin;
+        // 会话接受时刻
+        std::unordered_map<unsigned int, unsigned long long> _accepted;
+        unsigned long long _accepts;
+        unsigned long long _handshakes;
+        // 上次采样时的累计值
+        unsigned long long _lastAccepts;
+        unsigned long long _lastEstablished;
+        // 客户端发起到服务端接受的延迟, 服务端接受到握手完成的延迟(纳秒), 分别记录本次采样间隔与全程
+        Lcc::Utils::Histogram _acceptInterval;
+        Lcc::Utils::Histogram _acceptTotal;
+        Lcc::Utils::Histogram _handshakeInterval;
+        Lcc::Utils::Histogram _handshakeTotal;
+        std::vector<Sample> _samples;
+        unsigned long long _peakResident;
+        long _peakOpenFiles;
+    };
+}
+
+#endif //LCC_STORM_STORMSERVER_H
@@ -0,0 +1,253 @@
+//
+// Created by liao on 2026/10/19.
+//
+// 连接风暴与长稳测试: 在回环上驱动TcpServer, 按间隔输出接受延迟、握手完成率、常驻内存与描述符数(JSON Lines), 结束时输出汇总
+//   LccStorm --mode storm --transport tcp|tls|ws|wss --connections 100000 --threads 4 --rate 0
+//            --source-ips 4 --source-ports 10000-60000 --hold 5
+//   LccStorm --mode soak --connections 1000 --lifetime 1 --duration 14400 --leak-threshold 64
+// storm: 按速率(0为不限速)发起全部连接, 完成后保持hold秒再全部关闭
+// soak: 保持connections个连接, 每个连接存活约lifetime秒后关闭并以新连接补足, 按每次循环的内存增长判断泄漏
+//
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include "Storm.h"
+#include "StormClient.h"
+#include "StormServer.h"
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+static const unsigned long long kNanoPerSecond = 1000000000ULL;
+// 等待连接全部完成或关闭的最长时间(秒)
+static const unsigned long long kPhaseTimeout = 120;
+// 结束时描述符数允许的差值, 如库内部按需打开的文件
+static const long kFileTolerance = 4;
+
+static void Usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [--mode storm|soak] [--transport tcp|tls|ws|wss] [--connections N] [--threads N]\n"
+            "          [--rate CONN_PER_SEC] [--source-ips N] [--source-ports LOW-HIGH] [--hold SEC]\n"
+            "          [--duration SEC] [--lifetime SEC] [--interval SEC] [--leak-threshold BYTES]\n"
+            "          [--port PORT] [--cert FILE] [--key FILE] [--output FILE]\n", name);
+}
+
+static bool ParseArgs(int argc, char *argv[], Storm::Config &config) {
+    config.cert = LCC_BENCH_CERT_DIR "/server.crt";
+    config.key = LCC_BENCH_CERT_DIR "/server.key";
+    for (int n = 1; n < argc; ++n) {
+        const std::string arg = argv[n];
+        if (n + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++n];
+        if (arg == "--mode") {
+            config.mode = value;
+        } else if (arg == "--transport") {
+            config.transport = value;
+        } else if (arg == "--connections") {
+            config.connections = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--threads") {
+            config.threads = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--rate") {
+            config.rate = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--source-ips") {
+            config.sourceIps = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+        } else if (arg == "--source-ports") {
+            unsigned int low = 0, high = 0;
+            if (sscanf(value, "%u-%u", &low, &high) != 2 || low == 0 || high < low || high > 65535) {
+                return false;
+            }
+            config.portLow = static_cast<unsigned short>(low);
+            config.portHigh = static_cast<unsigned short>(high);
+        } else if (arg == "--hold") {
+            config.hold = strtod(value, nullptr);
+        } else if (arg == "--duration") {
+            config.duration = strtod(value, nullptr);
+        } else if (arg == "--lifetime") {
+            config.lifetime = strtod(value, nullptr);
+        } else if (arg == "--interval") {
+            config.interval = strtod(value, nullptr);
+        } else if (arg == "--leak-threshold") {
+            config.leakThreshold = strtod(value, nullptr);
+        } else if (arg == "--port") {
+            config.port = static_cast<unsigned short>(strtoul(value, nullptr, 10));
+        } else if (arg == "--cert") {
+            config.cert = value;
+        } else if (arg == "--key") {
+            config.key = value;
+        } else if (arg == "--output") {
+            config.output = value;
+        } else {
+            return false;
+        }
+    }
+    return (config.mode == "storm" || config.mode == "soak") &&
+           (config.transport == "tcp" || config.transport == "tls" || config.transport == "ws" ||
+            config.transport == "wss") && config.connections > 0 && config.threads > 0 && config.sourceIps > 0 &&
+           config.sourceIps < 255 && config.interval > 0 && config.lifetime > 0;
+}
+
+/**
+ * 每个连接占用客户端与服务端两个描述符, 按需提高上限
+ * @param connections 连接数
+ */
+static void RaiseFileLimit(unsigned int connections) {
+#if defined(__linux__)
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        const rlim_t want = static_cast<rlim_t>(connections) * 2 + 1024;
+        if (limit.rlim_cur < want) {
+            limit.rlim_cur = limit.rlim_max < want ? limit.rlim_max : want;
+            setrlimit(RLIMIT_NOFILE, &limit);
+        }
+        if (limit.rlim_cur < want) {
+            fprintf(stderr, "warning: open file limit %llu is below %llu\n",
+                    static_cast<unsigned long long>(limit.rlim_cur), static_cast<unsigned long long>(want));
+        }
+    }
+#endif
+}
+
+template<typename Predicate>
+static bool WaitFor(Predicate predicate, unsigned long long timeout) {
+    const unsigned long long deadline = uv_hrtime() + timeout;
+    while (!predicate()) {
+        if (uv_hrtime() >= deadline) {
+            return false;
+        }
+        uv_sleep(10);
+    }
+    return true;
+}
+
+/**
+ * 最小二乘估计常驻内存随循环次数的增长, 跳过前20%的采样(连接池、分配器等预热)
+ * @param samples 采样
+ * @return 每次循环增长的字节数
+ */
+static double GrowthPerCycle(const std::vector<Storm::Sample> &samples) {
+    const size_t first = samples.size() / 5;
+    const size_t count = samples.size() - first;
+    if (count < 3) {
+        return 0;
+    }
+    double meanX = 0, meanY = 0;
+    for (size_t n = first; n < samples.size(); ++n) {
+        meanX += samples[n].cycles;
+        meanY += samples[n].rss;
+    }
+    meanX /= count;
+    meanY /= count;
+    double cov = 0, var = 0;
+    for (size_t n = first; n < samples.size(); ++n) {
+        cov += (samples[n].cycles - meanX) * (samples[n].rss - meanY);
+        var += (samples[n].cycles - meanX) * (samples[n].cycles - meanX);
+    }
+    return var > 0 ? cov / var : 0;
+}
+
+static void PrintLatency(FILE *out, const char *name, const Lcc::Utils::Histogram &histogram) {
+    const double micro = 1000.0;
+    fprintf(out, "\"%s\":{\"count\":%llu,\"p50\":%.1f,\"p99\":%.1f,\"p999\":%.1f,\"max\":%.1f}", name,
+            histogram.Count(), histogram.Percentile(50) / micro, histogram.Percentile(99) / micro,
+            histogram.Percentile(99.9) / micro, histogram.Max() / micro);
+}
+
+int main(int argc, char *argv[]) {
+    signal(SIGPIPE, SIG_IGN);
+    Storm::Config config;
+    if (!ParseArgs(argc, argv, config)) {
+        Usage(argv[0]);
+        return 2;
+    }
+    if (config.threads > config.connections) {
+        config.threads = config.connections;
+    }
+    RaiseFileLimit(config.connections);
+    FILE *out = config.output.empty() ? stdout : fopen(config.output.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "open %s failed\n", config.output.c_str());
+        return 1;
+    }
+
+    Storm::Counters counters;
+    Storm::ConnectClock clock;
+    Storm::StormServer server(config, counters, clock, out);
+    if (!server.Startup() || !WaitFor([&server]() { return server.ListenState() != 0; },
+                                      kPhaseTimeout * kNanoPerSecond) || server.ListenState() < 0) {
+        fprintf(stderr, "server start failed\n");
+        return 1;
+    }
+    const unsigned long long rssStart = Storm::ResidentBytes();
+    const long filesStart = Storm::OpenFiles();
+
+    const unsigned long long begin = uv_hrtime();
+    std::vector<Storm::StormClient *> clients;
+    for (unsigned int n = 0; n < config.threads; ++n) {
+        const unsigned int count = config.connections / config.threads + (n < config.connections % config.threads);
+        clients.push_back(new Storm::StormClient(config, counters, clock, n, count));
+    }
+    for (auto client: clients) {
+        client->Startup();
+    }
+
+    double stormSeconds = 0;
+    if (config.Soak()) {
+        uv_sleep(static_cast<unsigned int>(config.duration * 1000));
+    } else {
+        WaitFor([&]() { return counters.established + counters.failed >= config.connections; },
+                kPhaseTimeout * kNanoPerSecond);
+        stormSeconds = static_cast<double>(uv_hrtime() - begin) / kNanoPerSecond;
+        uv_sleep(static_cast<unsigned int>(config.hold * 1000));
+    }
+
+    // 关闭全部连接, 等待服务端会话也全部释放后再对比描述符与内存
+    for (auto client: clients) {
+        client->Stop();
+    }
+    const bool drained = WaitFor([&]() { return counters.live == 0 && server.Sessions() == 0; },
+                                 kPhaseTimeout * kNanoPerSecond);
+    const double elapsed = static_cast<double>(uv_hrtime() - begin) / kNanoPerSecond;
+    Lcc::Utils::Histogram connectLatency;
+    for (auto client: clients) {
+        client->Shutdown();
+        connectLatency.Merge(client->ConnectLatency());
+        delete client;
+    }
+    const unsigned long long rssEnd = Storm::ResidentBytes();
+    const long filesEnd = Storm::OpenFiles();
+    server.Stop();
+    uv_sleep(100);
+    server.Shutdown();
+
+    const double growth = config.Soak() ? GrowthPerCycle(server.Samples()) : 0;
+    const bool memoryLeak = config.Soak() && growth > config.leakThreshold;
+    const bool fileLeak = filesStart >= 0 && filesEnd - filesStart > kFileTolerance;
+    const unsigned long long attempted = counters.attempted;
+    const unsigned long long established = counters.established;
+    fprintf(out, "{\"summary\":true,\"mode\":\"%s\",\"transport\":\"%s\",\"connections\":%u,\"threads\":%u,"
+                 "\"rate\":%u,\"elapsed\":%.3f,\"storm_seconds\":%.3f,\"attempted\":%llu,\"established\":%llu,"
+                 "\"failed\":%llu,\"bind_errors\":%llu,\"completion\":%.4f,\"cycles\":%llu,\"drained\":%s,",
+            config.mode.c_str(), config.transport.c_str(), config.connections, config.threads, config.rate, elapsed,
+            stormSeconds, attempted, established, counters.failed.load(), counters.bindErrors.load(),
+            attempted ? static_cast<double>(established) / attempted : 0.0, counters.cycles.load(),
+            drained ? "true" : "false");
+    PrintLatency(out, "accept_us", server.AcceptLatency());
+    fprintf(out, ",");
+    PrintLatency(out, "server_handshake_us", server.HandshakeLatency());
+    fprintf(out, ",");
+    PrintLatency(out, "client_connect_us", connectLatency);
+    fprintf(out, ",\"rss\":{\"start\":%llu,\"peak\":%llu,\"end\":%llu},\"fds\":{\"start\":%ld,\"peak\":%ld,\"end\":%ld},"
+                 "\"rss_bytes_per_cycle\":%.2f,\"memory_leak_suspected\":%s,\"fd_leak_suspected\":%s}\n",
+            rssStart, server.PeakResident(), rssEnd, filesStart, server.PeakOpenFiles(), filesEnd, growth,
+            memoryLeak ? "true" : "false", fileLeak ? "true" : "false");
+    if (out != stdout) {
+        fclose(out);
+    }
+    return established > 0 && drained && !memoryLeak && !fileLeak ? 0 : 1;
+}
@@ -6,10 +6,24 @@
 #define LCC_BIO_H
 
 namespace Lcc {
+    // 缓冲区内存后端
+    enum class BufferBioBackend {
+        // 堆内存环形缓冲区
+        Heap,
+        // memfd双重映射的镜像环形缓冲区, 数据始终连续
+        Mirror,
+    };
+
     class BufferBio {
     public:
         BufferBio();
 
+        /**
+         * 指定内存后端构造
+         * @param backend 内存后端, Mirror不可用时自动回退为Heap
+         */
+        explicit BufferBio(BufferBioBackend backend);
+
         virtual ~BufferBio();
 
         /**
@@ -23,6 +37,18 @@ namespace Lcc {
          */
         char *Data() const;
 
+        /**
+         * 获取从Data()开始可连续访问的数据大小, Mirror后端下等于UsedSize()
+         * @return 连续数据大小
+         */
+        unsigned int ContiguousSize() const;
+
+        /**
+         * 获取实际使用的内存后端
+         * @return 内存后端
+         */
+        BufferBioBackend Backend() const;
+
         /**
          * 获取当前容量大小
          * @return 容量大小
@@ -49,6 +75,13 @@ namespace Lcc {
          */
         unsigned int Read(char *out, unsigned int size);
 
+        /**
+         * 丢弃缓存区头部数据, 用于直接在Data()上解析后的消费
+         * @param size 丢弃大小
+         * @return 实际丢弃字节数
+         */
+        unsigned int Skip(unsigned int size);
+
         /**
          * 写入缓存区数据
          * @param in 输入缓存区
@@ -57,11 +90,25 @@ namespace Lcc {
          */
         unsigned int Write(const char *in, unsigned int size);
 
+    protected:
+        /**
+         * 扩容到指定容量, 已有数据会被整理到新缓冲区头部
+         * @param size 新容量(2的幂)
+         * @return 是否扩容成功
+         */
+        bool Expand(unsigned int size);
+
+        /**
+         * 释放缓冲区内存
+         */
+        void Release();
+
     private:
         unsigned int _in;
         unsigned int _out;
         unsigned int _size;
         unsigned char *_chunk;
+        BufferBioBackend _backend;
     };
 }
 
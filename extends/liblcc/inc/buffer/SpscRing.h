@@ -0,0 +1,165 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_SPSC_RING_H
+#define LCC_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace Lcc {
+    // 环形缓冲区中一条记录的只读视图, 在消费者调用Release前有效
+    struct SpscSpan {
+        const char *data;
+        unsigned int size;
+    };
+
+    /**
+     * 环的生产/消费位置, 两者各自对齐到一个缓存行
+     * 可放在共享内存中由两个进程各自Attach, 原子量需为无锁实现(与地址无关), 放置地址需按64字节对齐
+     */
+    struct SpscControl {
+        alignas(64) std::atomic<unsigned int> tail;
+        alignas(64) std::atomic<unsigned int> head;
+
+        SpscControl() : tail(0), head(0) {
+        }
+    };
+
+    /**
+     * 单生产者/单消费者无锁字节环, 支持变长记录
+     * 生产者: Reserve/Write写入若干记录后调用Publish批量发布
+     * 消费者: Peek/Read获取若干记录视图后调用Release批量归还空间
+     */
+    class SpscRing {
+        static constexpr unsigned int kCacheLine = 64;
+        static constexpr unsigned int kAlign = 8;
+        static constexpr unsigned int kHeaderSize = 8;
+        static constexpr unsigned int kWrapMarker = 0xffffffffU;
+
+    public:
+        SpscRing();
+
+        virtual ~SpscRing();
+
+        /**
+         * 按缓存行对齐分配, C++17之前的new不保证超过默认对齐的类型
+         */
+        static void *operator new(size_t size);
+
+        static void operator delete(void *ptr);
+
+        /**
+         * 初始化缓冲区
+         * @param capacity 容量, 向上取整为2的幂
+         * @return 是否初始化成功
+         */
+        bool Initialize(unsigned int capacity);
+
+        /**
+         * 使用外部内存作为缓冲区(如共享内存), 内存由调用方管理, 位置从control中的当前值继续
+         * @param control 生产/消费位置
+         * @param chunk 缓冲区
+         * @param capacity 缓冲区大小, 需为2的幂且不小于64
+         * @return 是否成功
+         */
+        bool Attach(SpscControl *control, char *chunk, unsigned int capacity);
+
+        /**
+         * 获取容量大小
+         * @return 容量大小
+         */
+        unsigned int Capacity() const;
+
+        /**
+         * 获取单条记录允许的最大长度
+         * @return 最大长度
+         */
+        unsigned int MaxRecordSize() const;
+
+        /**
+         * 获取消费者尚未归还的字节数(近似值)
+         * @return 已使用大小
+         */
+        unsigned int UsedSize() const;
+
+        /**
+         * [生产者] 预留一条记录的空间, 调用方直接填充返回的内存
+         * @param size 记录长度
+         * @return 记录数据地址, 空间不足返回nullptr
+         */
+        char *Reserve(unsigned int size);
+
+        /**
+         * [生产者] 写入一条记录, 需要Publish后消费者才可见
+         * @param buf 数据
+         * @param size 数据长度
+         * @return 是否写入成功
+         */
+        bool Write(const char *buf, unsigned int size);
+
+        /**
+         * [生产者] 发布所有已写入的记录
+         * @return 本次是否有新的记录被发布
+         */
+        bool Publish();
+
+        /**
+         * [消费者] 获取下一条记录
+         * 共享内存中的记录与位置可能被对端写坏, 越界或与发布位置不符时不返回视图, LastErrCode()为UV_EPROTO
+         * @param span 输出记录视图
+         * @return 是否获取成功
+         */
+        bool Peek(SpscSpan &span);
+
+        /**
+         * [消费者] 批量获取记录
+         * @param spans 输出记录视图数组
+         * @param count 数组长度
+         * @return 实际获取条数
+         */
+        unsigned int Read(SpscSpan *spans, unsigned int count);
+
+        /**
+         * [消费者] 是否还有未获取的已发布记录
+         * @return 是否有记录
+         */
+        bool Readable();
+
+        /**
+         * [消费者] 归还所有已获取记录占用的空间, 之前获取的视图失效
+         */
+        void Release();
+
+        /**
+         * [消费者] 获取异常错误码, 出错后Peek/Read不再返回记录
+         * @return 异常错误码
+         */
+        int LastErrCode() const;
+
+    protected:
+        static unsigned int RecordSize(unsigned int size);
+
+    private:
+        // 初始化后只读
+        unsigned int _size;
+        bool _owned;
+        char *_chunk;
+        SpscControl *_control;
+
+        // 生产者独占的缓存行
+        alignas(kCacheLine) unsigned int _pendingTail;
+        unsigned int _headCache;
+
+        // 消费者独占的缓存行
+        alignas(kCacheLine) unsigned int _pendingHead;
+        unsigned int _tailCache;
+        int _error;
+
+        // Initialize时使用的位置, 自身按缓存行对齐
+        SpscControl _local;
+    };
+}
+
+#endif //LCC_SPSC_RING_H
@@ -0,0 +1,139 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_AWAIT_H
+#define LCC_AWAIT_H
+
+#include <new>
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include "coroutine/Coroutine.h"
+
+namespace Lcc {
+    /**
+     * 协程内等待libuv异步请求: 当前协程让出, 请求完成后在事件循环中恢复
+     * 请求内存位于协程对象内(CoroutineAwait), 不做额外的堆分配
+     * 交给请求的缓冲区不能位于共享栈上(会在挂起期间被换出), 此时返回UV_EINVAL
+     * 文件操作在协程外调用时退化为同步执行, 其余操作返回UV_EINVAL
+     */
+    namespace Await {
+        /**
+         * 睡眠
+         * @param loop 事件循环
+         * @param ms 毫秒
+         * @return 0或错误码
+         */
+        int Sleep(uv_loop_t *loop, uint64_t ms);
+
+        /**
+         * 打开文件
+         * @param loop 事件循环
+         * @param path 路径
+         * @param flags 打开标志(O_RDONLY等)
+         * @param mode 创建权限
+         * @return 文件描述符或错误码
+         */
+        int FsOpen(uv_loop_t *loop, const char *path, int flags, int mode = 0644);
+
+        /**
+         * 关闭文件
+         * @param loop 事件循环
+         * @param file 文件描述符
+         * @return 0或错误码
+         */
+        int FsClose(uv_loop_t *loop, uv_file file);
+
+        /**
+         * 读文件
+         * @param loop 事件循环
+         * @param file 文件描述符
+         * @param buf 输出缓冲区
+         * @param size 读取长度
+         * @param offset 偏移, -1表示当前位置
+         * @return 读取字节数或错误码
+         */
+        int FsRead(uv_loop_t *loop, uv_file file, char *buf, size_t size, int64_t offset = -1);
+
+        /**
+         * 写文件
+         * @param loop 事件循环
+         * @param file 文件描述符
+         * @param buf 数据
+         * @param size 数据长度
+         * @param offset 偏移, -1表示当前位置
+         * @return 写入字节数或错误码
+         */
+        int FsWrite(uv_loop_t *loop, uv_file file, const char *buf, size_t size, int64_t offset = -1);
+
+        /**
+         * 获取文件信息
+         * @param loop 事件循环
+         * @param path 路径
+         * @param stat 输出文件信息
+         * @return 0或错误码
+         */
+        int FsStat(uv_loop_t *loop, const char *path, uv_stat_t &stat);
+
+        /**
+         * 读取整个文件, 用于加载配置与资源
+         * @param loop 事件循环
+         * @param path 路径
+         * @param out 输出内容
+         * @return 文件长度或错误码
+         */
+        int ReadFile(uv_loop_t *loop, const char *path, std::string &out);
+
+        /**
+         * 解析域名, 返回全部地址
+         * @param loop 事件循环
+         * @param host 域名
+         * @param service 服务名或端口, 可为nullptr
+         * @param out 输出地址列表
+         * @param family 地址族, AF_UNSPEC表示不限
+         * @return 0或错误码
+         */
+        int GetAddrInfo(uv_loop_t *loop, const char *host, const char *service, std::vector<sockaddr_storage> &out,
+                        int family = AF_UNSPEC);
+
+        /**
+         * 在线程池执行任务
+         * @param loop 事件循环
+         * @param invoke 任务函数, 在线程池线程中执行
+         * @param arg 任务参数, 不能位于共享栈上
+         * @return 0或错误码
+         */
+        int QueueWork(uv_loop_t *loop, void (*invoke)(void *), void *arg);
+
+        template<typename T>
+        void InvokeCallable(void *callable) {
+            (*static_cast<T *>(callable))();
+        }
+
+        /**
+         * 在线程池执行可调用对象, 对象复制到协程对象内
+         * 按引用捕获的变量同样不能位于共享栈上, 结果应写入协程对象成员或堆内存
+         * @param loop 事件循环
+         * @param f 可调用对象
+         * @return 0或错误码
+         */
+        template<typename F>
+        int Work(uv_loop_t *loop, F &&f) {
+            typedef typename std::decay<F>::type T;
+            static_assert(sizeof(T) <= CoroutineAwait::kCallableSize, "callable too large for CoroutineAwait");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "callable over-aligned");
+            Coroutine *co = Coroutine::Current();
+            if (!co) {
+                return UV_EINVAL;
+            }
+            T *callable = new(co->Awaiting().callable) T(std::forward<F>(f));
+            const int err = QueueWork(loop, &InvokeCallable<T>, callable);
+            callable->~T();
+            return err;
+        }
+    }
+}
+
+#endif //LCC_AWAIT_H
@@ -0,0 +1,255 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_COROUTINE_H
+#define LCC_COROUTINE_H
+
+#include <cstddef>
+#include <vector>
+#include "uv.h"
+#include "libaco/aco.h"
+#include "utils/Histogram.h"
+
+namespace Lcc {
+    /**
+     * 协程环境统计
+     */
+    struct CoroutineStats {
+        // 新分配的协程对象数
+        unsigned long long created;
+        // 从池中复用的次数
+        unsigned long long reused;
+        // 超出池容量或保存栈过大而直接释放的次数
+        unsigned long long destroyed;
+        // 当前存活的协程数
+        unsigned long long live;
+        // 池中空闲的协程数
+        unsigned long long pooled;
+        // 池中空闲协程保存栈占用的字节数
+        unsigned long long pooledBytes;
+    };
+
+    /**
+     * 线程协程环境: 主协程、M个共享栈以及协程对象池, 每个运行协程的线程各持有一个
+     * 新协程分配到存活协程最少的共享栈, 减少同一共享栈上的栈拷贝
+     */
+    class CoroutineEnv {
+        struct Stack {
+            aco_share_stack_t *stack;
+            unsigned int live;
+        };
+
+    public:
+        CoroutineEnv();
+
+        virtual ~CoroutineEnv();
+
+        /**
+         * 在当前线程初始化协程环境
+         * @param stackSize 共享栈大小, 0表示使用libaco默认值(2MB)
+         * @param stacks 共享栈数量
+         * @return 是否初始化成功
+         */
+        bool Init(size_t stackSize = 0, unsigned int stacks = 1);
+
+        /**
+         * 释放协程环境, 需保证其上的协程均已销毁
+         */
+        void Release();
+
+        /**
+         * 设置对象池上限
+         * @param count 池中最多保留的协程数
+         * @param saveStack 保存栈超过该字节数的协程不回池
+         */
+        void SetPoolLimit(size_t count, size_t saveStack);
+
+        /**
+         * 从池中取出或新建协程
+         * @param fp 协程入口
+         * @param arg 入口参数
+         * @return 协程
+         */
+        aco_t *Acquire(aco_cofuncp_t fp, void *arg);
+
+        /**
+         * 归还协程, 未结束的协程也可以归还(放弃其执行状态)
+         * @param co 协程
+         */
+        void Recycle(aco_t *co);
+
+        /**
+         * 获取主协程
+         * @return 主协程
+         */
+        aco_t *MainCo() const;
+
+        /**
+         * 获取共享栈数量
+         * @return 共享栈数量
+         */
+        unsigned int StackCount() const;
+
+        /**
+         * 获取共享栈上存活的协程数
+         * @param index 共享栈序号
+         * @return 协程数
+         */
+        unsigned int StackLoad(unsigned int index) const;
+
+        /**
+         * 获取统计
+         * @return 统计
+         */
+        CoroutineStats GetStats() const;
+
+        /**
+         * 获取已归还协程的最大保存栈大小分布(字节)
+         * @return 直方图
+         */
+        const Utils::Histogram &SavedStackHistogram() const;
+
+    private:
+        /**
+         * 选择存活协程最少的共享栈
+         * @return 共享栈
+         */
+        Stack &PickStack();
+
+    private:
+        aco_t *_mainCo;
+        size_t _poolLimit;
+        size_t _saveStackLimit;
+        void *_fpu[2];
+        CoroutineStats _stats;
+        Utils::Histogram _savedStack;
+        std::vector<Stack> _stacks;
+        std::vector<aco_t *> _pool;
+    };
+
+    /**
+     * 协程挂起期间异步请求使用的内存
+     * 共享栈上的局部变量会在其他协程运行时被换出, libuv与线程池回写的请求必须放在协程对象内
+     */
+    struct CoroutineAwait {
+        static constexpr size_t kCallableSize = 64;
+
+        union {
+            uv_req_t req;
+            uv_fs_t fs;
+            uv_getaddrinfo_t addrinfo;
+            uv_work_t work;
+            uv_timer_t timer;
+        };
+
+        int status;
+        void (*invoke)(void *);
+        void *arg;
+        // 线程池任务的可调用对象
+        alignas(std::max_align_t) unsigned char callable[kCallableSize];
+
+        CoroutineAwait() : req(), status(0), invoke(nullptr), arg(nullptr), callable() {
+        }
+    };
+
+    /**
+     * 运行在共享栈上的协程, 只能由主协程(事件循环所在的线程栈)恢复
+     */
+    class Coroutine {
+    public:
+        Coroutine();
+
+        virtual ~Coroutine();
+
+        /**
+         * 创建协程并执行到第一次让出
+         * @param env 协程环境
+         * @return 是否启动成功
+         */
+        bool Start(CoroutineEnv *env);
+
+        /**
+         * 恢复协程执行, 直到下一次让出或结束
+         */
+        void Resume();
+
+        /**
+         * 获取协程是否已结束
+         * @return 是否结束
+         */
+        bool IsEnd() const;
+
+        /**
+         * 获取协程被恢复的次数
+         * @return 恢复次数
+         */
+        unsigned long long Resumes() const;
+
+        /**
+         * 获取协程私有保存栈的容量(切出时共享栈内容复制到这里)
+         * @return 字节数
+         */
+        size_t SavedStackSize() const;
+
+        /**
+         * 获取切出时复制的最大栈字节数
+         * @return 字节数
+         */
+        size_t MaxSavedStack() const;
+
+        /**
+         * 获取栈拷贝次数(切出保存与切入恢复之和), 同一共享栈上交替运行的协程越多拷贝越多
+         * @return 拷贝次数
+         */
+        size_t StackCopies() const;
+
+        /**
+         * 获取异步等待使用的请求内存, 供coroutine/Await.h中的等待函数使用
+         * @return 请求内存
+         */
+        CoroutineAwait &Awaiting();
+
+        /**
+         * 判断地址是否位于本协程的共享栈上(挂起后会被换出, 不能交给异步请求)
+         * @param ptr 地址
+         * @return 是否位于共享栈
+         */
+        bool OnShareStack(const void *ptr) const;
+
+    public:
+        /**
+         * 获取当前正在执行的协程
+         * @return 协程对象, 主协程中返回nullptr
+         */
+        static Coroutine *Current();
+
+        /**
+         * 让出当前协程, 回到主协程
+         */
+        static void Yield();
+
+    protected:
+        /**
+         * 协程主体
+         */
+        virtual void ICoroutineRun() = 0;
+
+        /**
+         * 每次让出或结束回到主协程后触发, 可在其中回收已结束的协程(回收后不得再访问成员)
+         */
+        virtual void ICoroutineSuspend() {
+        }
+
+    private:
+        static void AcoEntry();
+
+    private:
+        aco_t *_co;
+        CoroutineEnv *_env;
+        unsigned long long _resumes;
+        CoroutineAwait _await;
+    };
+}
+
+#endif //LCC_COROUTINE_H
@@ -0,0 +1,79 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_LOOPMETRICS_H
+#define LCC_LOOPMETRICS_H
+
+#include <atomic>
+#include <string>
+#include "libuv/uv.h"
+#include "metrics/Metrics.h"
+
+namespace Lcc {
+    namespace Metrics {
+        /**
+         * 事件循环指标, 以loop="name"标签区分各个循环, 名称应保持唯一
+         * 用uv_prepare/uv_check夹住poll阶段, 结合libuv的空闲时间统计(UV_METRICS_IDLE_TIME)算出poll返回的时刻:
+         * - 延迟(lag): poll返回到下一次进入poll的时间, 即新就绪的事件最长需要等待多久才会被处理
+         * - 回调耗时: phase="io"为poll内的IO回调, phase="timers"为check到下一轮prepare之间的定时器、关闭等回调
+         * 挂载后同时登记到卡顿检测(LoopWatchdog), 由其在循环卡住时采样调用栈
+         */
+        class LoopMetrics {
+            friend class LoopWatchdog;
+
+        public:
+            LoopMetrics();
+
+            ~LoopMetrics();
+
+            /**
+             * 挂到事件循环上, 只能在循环线程内调用, 循环运行期间不应长时间停在uv_run之外
+             * @param loop 事件循环
+             * @param name 循环名称
+             * @return 是否成功
+             */
+            bool Attach(uv_loop_t *loop, const char *name);
+
+            /**
+             * 从事件循环上摘下, 对象需要保持到循环处理完关闭回调
+             */
+            void Detach();
+
+            /**
+             * 获取循环名称
+             * @return 名称
+             */
+            const std::string &GetName() const;
+
+        private:
+            static void UvPrepareCallback(uv_prepare_t *handle);
+
+            static void UvCheckCallback(uv_check_t *handle);
+
+        private:
+            bool _attached;
+            uv_loop_t *_loop;
+            uv_thread_t _thread;
+            std::string _name;
+            // 本轮进入poll的时刻与当时的空闲时间
+            uint64_t _prepareTime;
+            uint64_t _prepareIdle;
+            // 本轮poll返回与check的时刻
+            uint64_t _pollExit;
+            uint64_t _checkTime;
+            // prepare/check每触发一次加一, 供卡顿检测判断循环是否前进
+            std::atomic<unsigned long long> _beats;
+            uv_prepare_t _prepare;
+            uv_check_t _check;
+            Counter _iterations;
+            Histogram _lag;
+            Histogram _ioCallbacks;
+            Histogram _timerCallbacks;
+            Counter _stalls;
+            Histogram _stallTime;
+        };
+    }
+}
+
+#endif //LCC_LOOPMETRICS_H
@@ -0,0 +1,137 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_LOOPWATCHDOG_H
+#define LCC_LOOPWATCHDOG_H
+
+#include <deque>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "libuv/uv.h"
+
+namespace Lcc {
+    namespace Metrics {
+        class LoopMetrics;
+
+        /**
+         * 卡顿检测参数
+         */
+        struct WatchdogOptions {
+            // 循环停在同一轮超过该时间(毫秒)视为卡顿
+            unsigned int threshold;
+            // 检查间隔(毫秒), 0表示取threshold的1/4
+            unsigned int interval;
+            // 采样调用栈使用的信号(仅Linux), 0表示不采样
+            int signal;
+            // 保留的卡顿记录条数
+            unsigned int keep;
+
+            WatchdogOptions();
+        };
+
+        /**
+         * 卡顿记录
+         */
+        struct StallSample {
+            // 循环名称
+            std::string loop;
+            // 检测到的时刻(unix毫秒)
+            long long timestamp;
+            // 检测到时已卡住的时间(纳秒)
+            unsigned long long duration;
+            // 卡住时循环线程的调用栈, 由内到外
+            std::vector<std::string> frames;
+        };
+
+        /**
+         * 事件循环卡顿检测, 进程内唯一, 由独立线程周期检查所有挂载了LoopMetrics的循环
+         * 循环的prepare/check计数与空闲时间都没有前进即认为卡在某个回调里(阻塞在poll中时空闲时间会持续增长),
+         * 超过阈值时向循环线程发送信号, 在信号处理函数中记录调用栈, 并计入lcc_loop_stalls_total
+         */
+        class LoopWatchdog {
+            struct Watched {
+                LoopMetrics *metrics;
+                unsigned long long beats;
+                uint64_t idle;
+                uint64_t since;
+                bool stalled;
+            };
+
+        public:
+            static LoopWatchdog &Instance();
+
+            /**
+             * 启动检测线程
+             * @param options 检测参数
+             * @return 是否启动成功
+             */
+            bool Start(const WatchdogOptions &options = WatchdogOptions());
+
+            /**
+             * 停止检测线程
+             */
+            void Stop();
+
+            /**
+             * 是否运行中
+             * @return 是否运行中
+             */
+            bool Running() const;
+
+            /**
+             * 登记循环, 由LoopMetrics::Attach调用
+             * @param metrics 循环指标
+             */
+            void Watch(LoopMetrics *metrics);
+
+            /**
+             * 注销循环, 由LoopMetrics::Detach调用
+             * @param metrics 循环指标
+             */
+            void Unwatch(LoopMetrics *metrics);
+
+            /**
+             * 获取最近的卡顿记录
+             * @param samples 输出记录, 由旧到新
+             */
+            void GetSamples(std::vector<StallSample> &samples);
+
+            /**
+             * 以文本形式导出最近的卡顿记录
+             * @param out 输出
+             */
+            void Export(std::string &out);
+
+        private:
+            LoopWatchdog();
+
+            /**
+             * 检查所有循环, 在持有锁时调用
+             * @param now 当前时间
+             */
+            void Inspect(uint64_t now);
+
+            /**
+             * 采样循环线程的调用栈
+             * @param thread 循环线程
+             * @param frames 输出调用栈
+             */
+            void Capture(uv_thread_t thread, std::vector<std::string> &frames) const;
+
+            static void UvWatchdogMain(void *arg);
+
+        private:
+            std::atomic<bool> _running;
+            WatchdogOptions _options;
+            uv_thread_t _thread;
+            uv_mutex_t _mutex;
+            uv_cond_t _cond;
+            std::vector<Watched> _watched;
+            std::deque<StallSample> _samples;
+        };
+    }
+}
+
+#endif //LCC_LOOPWATCHDOG_H
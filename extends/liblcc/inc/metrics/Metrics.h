@@ -0,0 +1,249 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_METRICS_H
+#define LCC_METRICS_H
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "utils/Histogram.h"
+
+namespace Lcc {
+    namespace Metrics {
+        typedef std::atomic<unsigned long long> Slot;
+
+        /**
+         * 线程分片: 每个线程(即每个事件循环)持有一整块计数槽, 记录时只写本线程的槽, 不需要原子读改写
+         * 槽按指标注册顺序分配, 所有分片布局一致, 导出时逐槽求和
+         * 线程退出后分片交还给下一个线程继续累加, 数据不会丢失
+         */
+        class Shard {
+        public:
+            // 每个分片的槽数
+            static constexpr unsigned int kSlots = 0x2000;
+            // 末尾的丢弃区: 默认构造的句柄与容量不足时注册的指标写入这里, 不导出
+            static constexpr unsigned int kDiscardSlot = kSlots - 0x200;
+
+        public:
+            /**
+             * 获取当前线程的分片
+             * @return 槽数组
+             */
+            static inline Slot *Local() {
+                Slot *slots = _local;
+                return slots ? slots : Attach();
+            }
+
+            /**
+             * 槽累加, 只由所属线程写入, 松散序加载与存储即可
+             * @param slot 槽
+             * @param value 增量
+             */
+            static inline void Add(Slot &slot, unsigned long long value) {
+                slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+
+        private:
+            static Slot *Attach();
+
+        private:
+            static thread_local Slot *_local;
+        };
+
+        /**
+         * 计数器, 只增不减
+         */
+        class Counter {
+        public:
+            Counter() : _slot(Shard::kDiscardSlot) {
+            }
+
+            explicit Counter(unsigned int slot) : _slot(slot) {
+            }
+
+            inline void Add(unsigned long long value = 1) const {
+                Shard::Add(Shard::Local()[_slot], value);
+            }
+
+            /**
+             * 获取所有线程的合计值
+             * @return 合计值
+             */
+            unsigned long long Value() const;
+
+        private:
+            unsigned int _slot;
+        };
+
+        /**
+         * 增减型仪表(如队列深度), 各线程记录增量, 合计为当前值
+         */
+        class Gauge {
+        public:
+            Gauge() : _slot(Shard::kDiscardSlot) {
+            }
+
+            explicit Gauge(unsigned int slot) : _slot(slot) {
+            }
+
+            inline void Add(long long value) const {
+                Shard::Add(Shard::Local()[_slot], static_cast<unsigned long long>(value));
+            }
+
+            inline void Sub(long long value) const {
+                Add(-value);
+            }
+
+            /**
+             * 获取所有线程的合计值
+             * @return 合计值
+             */
+            long long Value() const;
+
+        private:
+            unsigned int _slot;
+        };
+
+        /**
+         * 分布统计, 分桶与Utils::Histogram一致(对数线性, 相对误差不超过12.5%)
+         * 占用槽: 计数, 总和, 各分桶
+         */
+        class Histogram {
+        public:
+            static constexpr unsigned int kSlots = Utils::Histogram::kBuckets + 2;
+
+        public:
+            Histogram() : _slot(Shard::kDiscardSlot) {
+            }
+
+            explicit Histogram(unsigned int slot) : _slot(slot) {
+            }
+
+            inline void Record(unsigned long long value) const {
+                Slot *slots = Shard::Local() + _slot;
+                Shard::Add(slots[0], 1);
+                Shard::Add(slots[1], value);
+                Shard::Add(slots[2 + Utils::Histogram::BucketIndex(value)], 1);
+            }
+
+            /**
+             * 合并所有线程的分布
+             * @param out 输出直方图(只有分桶、计数与总和有效)
+             */
+            void Collect(Utils::Histogram &out) const;
+
+        private:
+            unsigned int _slot;
+        };
+
+        /**
+         * 指标注册表, 进程内唯一
+         * 指标在启动阶段注册, 返回的句柄可以复制到任意线程使用; 同名不同标签的指标导出为同一组
+         * 同名同标签重复注册时返回同一个指标
+         */
+        class Registry {
+            enum class Type {
+                Counter,
+                Gauge,
+                Histogram,
+            };
+
+            struct Definition {
+                Type type;
+                unsigned int slot;
+                double scale;
+                std::string name;
+                std::string help;
+                std::string labels;
+            };
+
+        public:
+            static Registry &Instance();
+
+            /**
+             * 注册计数器
+             * @param name 指标名
+             * @param help 说明
+             * @param labels 标签, 如 reason="eof", 可为空
+             * @return 计数器
+             */
+            Counter AddCounter(const char *name, const char *help, const char *labels = nullptr);
+
+            /**
+             * 注册仪表
+             * @param name 指标名
+             * @param help 说明
+             * @param labels 标签, 可为空
+             * @return 仪表
+             */
+            Gauge AddGauge(const char *name, const char *help, const char *labels = nullptr);
+
+            /**
+             * 注册分布统计
+             * @param name 指标名
+             * @param help 说明
+             * @param labels 标签, 可为空
+             * @param scale 导出时的单位换算, 如纳秒记录、秒导出时为1e-9
+             * @return 分布统计
+             */
+            Histogram AddHistogram(const char *name, const char *help, const char *labels = nullptr,
+                                   double scale = 1.0);
+
+            /**
+             * 按Prometheus文本格式(0.0.4)导出全部指标
+             * @param out 输出
+             */
+            void Export(std::string &out);
+
+            /**
+             * 合计各线程分片中的槽
+             * @param slot 起始槽
+             * @param count 槽数
+             * @param sums 输出合计值
+             */
+            void Sum(unsigned int slot, unsigned int count, unsigned long long *sums);
+
+            /**
+             * 线程首次记录时领取分片
+             * @return 槽数组
+             */
+            Slot *AcquireShard();
+
+            /**
+             * 线程退出时归还分片, 已记录的值保留
+             * @param slots 槽数组
+             */
+            void ReleaseShard(Slot *slots);
+
+        private:
+            Registry();
+
+            /**
+             * 分配连续的槽
+             * @param count 槽数
+             * @return 起始槽, 容量不足时返回丢弃槽
+             */
+            unsigned int Allocate(unsigned int count);
+
+            unsigned int Define(Type type, const char *name, const char *help, const char *labels, unsigned int count,
+                                double scale);
+
+            /**
+             * 导出一个分布统计
+             */
+            void ExportHistogram(const Definition &def, std::string &out);
+
+        private:
+            std::mutex _mutex;
+            unsigned int _nextSlot;
+            std::vector<Definition> _definitions;
+            std::vector<Slot *> _shards;
+            std::vector<Slot *> _freeShards;
+        };
+    }
+}
+
+#endif //LCC_METRICS_H
@@ -0,0 +1,275 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_CO_TCP_SERVER_H
+#define LCC_CO_TCP_SERVER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "buffer/Bio.h"
+#include "coroutine/Coroutine.h"
+#include "network/TcpServer.h"
+
+namespace Lcc {
+    class CoTcpServer;
+
+    /**
+     * 会话协程: 读写与睡眠会让出到事件循环, 事件完成后恢复
+     * 所有等待接口只能在会话协程内调用
+     */
+    class CoSession : public Coroutine {
+        friend class CoTcpServer;
+
+        enum class Wait {
+            None,
+            Read,
+            Write,
+            Sleep,
+        };
+
+    public:
+        CoSession(CoTcpServer *server, unsigned int session);
+
+        ~CoSession() override;
+
+        /**
+         * 获取会话id
+         * @return 会话id
+         */
+        unsigned int GetSession() const;
+
+        /**
+         * 读取指定长度的数据, 数据不足时让出
+         * @param buf 输出缓冲区
+         * @param size 读取长度
+         * @return 读取长度, 连接关闭时返回负数错误码
+         */
+        int Read(char *buf, unsigned int size);
+
+        /**
+         * 读取一帧数据, 帧格式为4字节大端长度头+数据
+         * @param frame 输出帧数据(不含长度头)
+         * @return 帧长度, 连接关闭或帧超长时返回负数错误码
+         */
+        int ReadFrame(std::string &frame);
+
+        /**
+         * 写数据, 待发送数据超过高水位时让出直到发送完成
+         * @param buf 数据
+         * @param size 数据长度
+         * @return 是否写入成功
+         */
+        bool Write(const char *buf, unsigned int size);
+
+        /**
+         * 写一帧数据, 自动添加4字节大端长度头
+         * @param buf 数据
+         * @param size 数据长度
+         * @return 是否写入成功
+         */
+        bool WriteFrame(const char *buf, unsigned int size);
+
+        /**
+         * 睡眠指定时间
+         * @param ms 毫秒
+         * @return 是否正常睡醒, 连接关闭时提前返回false
+         */
+        bool Sleep(unsigned int ms);
+
+        /**
+         * 关闭会话, 协程继续执行到结束
+         */
+        void Close();
+
+        /**
+         * 获取连接是否已关闭
+         * @return 是否关闭
+         */
+        bool IsClosed() const;
+
+        /**
+         * 获取关闭原因错误码
+         * @return 错误码
+         */
+        int LastErrCode() const;
+
+    protected:
+        void ICoroutineRun() override;
+
+        void ICoroutineSuspend() override;
+
+    private:
+        /**
+         * 等待条件满足, 协程让出直到被Wake唤醒
+         * @param wait 等待类型
+         */
+        void Await(Wait wait);
+
+        /**
+         * 事件到达时唤醒协程
+         * @param wait 触发的等待类型
+         */
+        void Wake(Wait wait);
+
+        /**
+         * 协程结束且连接与定时器均关闭后释放
+         * @return 是否已释放
+         */
+        bool TryRelease();
+
+        static void UvSleepCallback(uv_timer_t *handle);
+
+        static void UvTimerCloseCallback(uv_handle_t *handle);
+
+    private:
+        CoTcpServer *_server;
+        unsigned int _session;
+        int _error;
+        bool _closed;
+        bool _detached;
+        bool _timerInit;
+        bool _timerClosed;
+        Wait _wait;
+        unsigned int _need;
+        uv_timer_t _timer;
+        BufferBio _input;
+    };
+
+    /**
+     * 每个会话一个协程的TCP服务, 协程分布在少量共享执行栈上
+     * 只能在事件循环线程内使用
+     */
+    class CoTcpServer : public ServerImplement {
+        friend class CoSession;
+
+    public:
+        /**
+         * @param loop 事件循环
+         * @param stackSize 共享栈大小, 0表示使用默认值
+         * @param stacks 共享栈数量
+         */
+        explicit CoTcpServer(uv_loop_t *loop, size_t stackSize = 0, unsigned int stacks = 1);
+
+        ~CoTcpServer() override;
+
+        /**
+         * 启动监听
+         * @param host 监听地址
+         * @return 是否初始化协程环境成功
+         */
+        bool Listen(const char *host);
+
+        /**
+         * 关闭监听和所有会话
+         */
+        void Shutdown();
+
+        /**
+         * 启用协议插件支持
+         * @param creator 协议插件创造器
+         */
+        void Enable(ProtocolPluginCreator *creator);
+
+        /**
+         * 设置单帧最大长度
+         * @param size 最大长度
+         */
+        void SetMaxFrameSize(unsigned int size);
+
+        /**
+         * 设置写入高水位, 待发送数据超过该值时Write让出
+         * @param size 字节数
+         */
+        void SetWriteHighWater(size_t size);
+
+        /**
+         * 获取存活的会话协程数量
+         * @return 会话数量
+         */
+        size_t SessionCount() const;
+
+        /**
+         * 获取协程环境, 可用于调整对象池和查看统计
+         * @return 协程环境
+         */
+        CoroutineEnv &GetCoroutineEnv();
+
+        /**
+         * 获取底层服务对象
+         * @return 服务对象
+         */
+        TcpServer &GetServer();
+
+    protected:
+        /**
+         * 会话协程主体, 返回后关闭连接
+         * @param session 会话协程
+         */
+        virtual void ISessionRun(CoSession &session) = 0;
+
+    protected:
+        bool IServerInit(StreamHandle &handle) override;
+
+        void IServerListenReport(bool listened, int err, const char *errMsg) override;
+
+        void IServerShutdown() override;
+
+        void IServerSessionOpen(unsigned int session) override;
+
+        void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override;
+
+        void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override;
+
+        void IServerSessionAfterClose(unsigned int session) override;
+
+        void IServerSessionWriteDrain(unsigned int session) override;
+
+    private:
+        /**
+         * 查询会话协程
+         * @param session 会话id
+         * @return 会话协程
+         */
+        CoSession *GetCoSession(unsigned int session);
+
+        /**
+         * 恢复会话协程, 在其他协程内调用时加入待恢复列表, 回到主协程后再恢复
+         * @param coSession 会话协程
+         */
+        void ResumeSession(CoSession *coSession);
+
+        /**
+         * 在主协程中恢复待恢复列表内的会话协程, 恢复过程中新加入的也一并处理
+         */
+        void ResumePending();
+
+        /**
+         * 会话协程让出后的处理, 协程已结束时关闭连接并尝试回收
+         * 由CoSession::ICoroutineSuspend触发, 因此coroutine/Await.h中的等待恢复协程时同样生效
+         * @param coSession 会话协程
+         */
+        void SessionYield(CoSession *coSession);
+
+        static void UvResumeCallback(uv_idle_t *handle);
+
+    private:
+        uv_loop_t *_loop;
+        size_t _stackSize;
+        unsigned int _stacks;
+        size_t _writeHighWater;
+        unsigned int _maxFrameSize;
+        TcpServer _server;
+        CoroutineEnv _env;
+        std::unordered_map<unsigned int, CoSession *> _sessionMap;
+        // 在协程内被唤醒的会话, 列表内的协程均处于挂起状态
+        std::vector<CoSession *> _resumeVec;
+        bool _resuming;
+        bool _idleInit;
+        // 唤醒方不是会话协程时, 由下一轮事件循环恢复
+        uv_idle_t _resumeIdle;
+    };
+}
+
+#endif //LCC_CO_TCP_SERVER_H
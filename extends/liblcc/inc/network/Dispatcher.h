@@ -0,0 +1,112 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_DISPATCHER_H
+#define LCC_DISPATCHER_H
+
+#include "network/Rpc.h"
+
+namespace Lcc {
+    /**
+     * 消息id分发表: 以消息id为下标的函数指针数组, 分发为一次数组访问
+     * 处理函数在注册时通过模板参数绑定, 编译期生成跳板函数并检查消息id范围
+     * @tparam Context 处理上下文(通常为服务对象)
+     * @tparam MaxId 消息id上限(不含)
+     */
+    template<typename Context, unsigned short MaxId = 1024>
+    class Dispatcher {
+    public:
+        typedef void (*Handler)(Context &context, unsigned int session, const RpcMessage &msg);
+
+    public:
+        Dispatcher() : _table() {
+        }
+
+        /**
+         * 注册处理函数
+         * @tparam Id 消息id
+         * @tparam Fn 处理函数
+         */
+        template<unsigned short Id, void (*Fn)(Context &, unsigned int, const RpcMessage &)>
+        void Register() {
+            static_assert(Id < MaxId, "message id out of dispatcher range");
+            _table[Id] = Fn;
+        }
+
+        /**
+         * 注册成员处理函数
+         * @tparam Id 消息id
+         * @tparam T 上下文类型或其派生类
+         * @tparam Method 成员函数
+         */
+        template<unsigned short Id, typename T, void (T::*Method)(unsigned int, const RpcMessage &)>
+        void Register() {
+            static_assert(Id < MaxId, "message id out of dispatcher range");
+            _table[Id] = &Dispatcher::MemberThunk<T, Method>;
+        }
+
+        /**
+         * 注册带原地解码的成员处理函数, 消息数据先解码为Request再回调
+         * Request需提供static bool Decode(RpcReader &reader, Request &request), 字节串字段使用RpcSlice指向接收缓冲区
+         * 解码失败的请求以UV_EPROTO回复(需要Context提供RpcEndpoint &GetRpcEndpoint())
+         * @tparam Id 消息id
+         * @tparam Request 请求结构
+         * @tparam T 上下文类型或其派生类
+         * @tparam Method 成员函数
+         */
+        template<unsigned short Id, typename Request, typename T,
+            void (T::*Method)(unsigned int, const RpcMessage &, const Request &)>
+        void Register() {
+            static_assert(Id < MaxId, "message id out of dispatcher range");
+            _table[Id] = &Dispatcher::DecodeThunk<Request, T, Method>;
+        }
+
+        /**
+         * 注销处理函数
+         * @param id 消息id
+         */
+        void Unregister(unsigned short id) {
+            if (id < MaxId) {
+                _table[id] = nullptr;
+            }
+        }
+
+        /**
+         * 分发消息
+         * @param context 处理上下文
+         * @param session 会话id
+         * @param msg 消息
+         * @return 是否找到处理函数
+         */
+        bool Dispatch(Context &context, unsigned int session, const RpcMessage &msg) const {
+            if (msg.id >= MaxId || !_table[msg.id]) {
+                return false;
+            }
+            _table[msg.id](context, session, msg);
+            return true;
+        }
+
+    private:
+        template<typename T, void (T::*Method)(unsigned int, const RpcMessage &)>
+        static void MemberThunk(Context &context, unsigned int session, const RpcMessage &msg) {
+            (static_cast<T &>(context).*Method)(session, msg);
+        }
+
+        template<typename Request, typename T, void (T::*Method)(unsigned int, const RpcMessage &, const Request &)>
+        static void DecodeThunk(Context &context, unsigned int session, const RpcMessage &msg) {
+            Request request;
+            RpcReader reader(msg);
+            if (!Request::Decode(reader, request) || !reader.Ok()) {
+                context.GetRpcEndpoint().ReplyError(session, msg, UV_EPROTO);
+                return;
+            }
+            (static_cast<T &>(context).*Method)(session, msg, request);
+        }
+
+    private:
+        Handler _table[MaxId];
+    };
+}
+
+#endif //LCC_DISPATCHER_H
@@ -18,6 +18,8 @@ namespace Lcc {
         WebSocket,
         // 应用层
         Application,
+        // 用户读写入口, 不挂插件
+        User,
     };
 
     /**
@@ -56,13 +58,47 @@ namespace Lcc {
         virtual void IProtocolClose(ProtocolLevel streamLevel) = 0;
     };
 
+    /**
+     * 流句柄, TCP与本机管道(unix域套接字)共用同一块内存, 其余代码按uv_stream_t使用
+     * UDP传输同样通过它初始化uv_udp_t
+     */
     class StreamHandle {
     public:
-        uv_tcp_t tcpHandle;
+        union {
+            uv_tcp_t tcpHandle;
+            uv_pipe_t pipeHandle;
+            uv_udp_t udpHandle;
+        };
+        // 句柄类型(UV_TCP/UV_NAMED_PIPE/UV_UDP), 由库在初始化回调前按地址设置
+        uv_handle_type type;
         unsigned int tcpSession;
 
     public:
-        inline StreamHandle() : tcpHandle(), tcpSession(0) {
+        inline StreamHandle() : pipeHandle(), type(UV_TCP), tcpSession(0) {
+        }
+
+        /**
+         * 按type初始化句柄
+         * @param loop 事件循环
+         * @return 错误码, 0为成功
+         */
+        inline int Init(uv_loop_t *loop) {
+            if (type == UV_NAMED_PIPE) {
+                return uv_pipe_init(loop, &pipeHandle, 0);
+            }
+            if (type == UV_UDP) {
+                // 按批接收(recvmmsg), 不支持的平台上libuv退回逐个接收
+                return uv_udp_init_ex(loop, &udpHandle, AF_UNSPEC | UV_UDP_RECVMMSG);
+            }
+            return uv_tcp_init(loop, &tcpHandle);
+        }
+
+        inline bool IsPipe() const {
+            return type == UV_NAMED_PIPE;
+        }
+
+        inline uv_loop_t *Loop() const {
+            return tcpHandle.loop;
         }
 
         inline bool IsActive() const {
@@ -108,6 +144,13 @@ namespace Lcc {
          * @param session 流处理会话
          */
         virtual void IStreamAfterClose(unsigned int session) = 0;
+
+        /**
+         * 写队列全部发送完成时触发, 可用于写入背压
+         * @param session 流处理会话
+         */
+        virtual void IStreamWriteDrain(unsigned int session) {
+        }
     };
 
     class ClientImplement {
@@ -115,7 +158,7 @@ namespace Lcc {
         virtual ~ClientImplement() = default;
 
         /**
-         *  初始化流处理句柄
+         *  初始化流处理句柄, 需按handle.type初始化(可直接调用handle.Init)
          * @param handle 流处理句柄
          * @return 初始化是否成功
          */
@@ -153,11 +196,11 @@ namespace Lcc {
         virtual ~ServerImplement() = default;
 
         /**
-         * 初始化流处理句柄
-         * @param handle uv_tcp_t句柄
+         * 初始化监听句柄, 需按handle.type初始化(可直接调用handle.Init)
+         * @param handle 监听句柄
          * @return 初始化是否成功
          */
-        virtual bool IServerInit(uv_tcp_t *handle) = 0;
+        virtual bool IServerInit(StreamHandle &handle) = 0;
 
         /**
          * 服务监听状态触发
@@ -199,6 +242,13 @@ namespace Lcc {
          * @param session 会话id
          */
         virtual void IServerSessionAfterClose(unsigned int session) = 0;
+
+        /**
+         * 会话写队列全部发送完成时触发
+         * @param session 会话id
+         */
+        virtual void IServerSessionWriteDrain(unsigned int session) {
+        }
     };
 }
 
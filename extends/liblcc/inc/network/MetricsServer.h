@@ -0,0 +1,82 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_METRICSSERVER_H
+#define LCC_METRICSSERVER_H
+
+#include <string>
+#include <unordered_map>
+#include "network/TcpServer.h"
+
+namespace Lcc {
+    /**
+     * 指标拉取服务: 极简HTTP/1.0监听, 应答后关闭连接
+     * GET /metrics 返回Prometheus文本格式, GET /stalls 返回最近的事件循环卡顿记录与调用栈
+     * 只能在事件循环线程内使用, 导出时合计各线程分片
+     */
+    class MetricsServer : public ServerImplement {
+    public:
+        // 单个请求头的最大长度
+        static constexpr size_t kMaxRequestSize = 0x2000;
+
+    public:
+        explicit MetricsServer(uv_loop_t *loop);
+
+        ~MetricsServer() override;
+
+        /**
+         * 启动监听
+         * @param host 监听地址
+         */
+        void Listen(const char *host);
+
+        /**
+         * 关闭监听和所有会话
+         */
+        void Shutdown();
+
+        /**
+         * 是否处于监听状态
+         * @return 是否监听中
+         */
+        bool IsListening() const;
+
+        /**
+         * 获取底层服务对象
+         * @return 服务对象
+         */
+        TcpServer &GetServer();
+
+    protected:
+        bool IServerInit(StreamHandle &handle) override;
+
+        void IServerListenReport(bool listened, int err, const char *errMsg) override;
+
+        void IServerShutdown() override;
+
+        void IServerSessionOpen(unsigned int session) override;
+
+        void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override;
+
+        void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override;
+
+        void IServerSessionAfterClose(unsigned int session) override;
+
+    private:
+        /**
+         * 应答请求并关闭会话
+         * @param session 会话id
+         * @param request 请求头
+         */
+        void Respond(unsigned int session, const std::string &request);
+
+    private:
+        bool _listening;
+        uv_loop_t *_loop;
+        TcpServer _server;
+        std::unordered_map<unsigned int, std::string> _requestMap;
+    };
+}
+
+#endif //LCC_METRICSSERVER_H
@@ -0,0 +1,79 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_NETMETRICS_H
+#define LCC_NETMETRICS_H
+
+#include "metrics/Metrics.h"
+
+namespace Lcc {
+    // 连接关闭原因
+    enum class CloseReason {
+        // 本端主动关闭
+        Local,
+        // 对端关闭
+        Eof,
+        // 连接被重置
+        Reset,
+        // 超时
+        Timeout,
+        // 其它错误(含协议插件错误)
+        Error,
+        Count,
+    };
+
+    // 地址解析的结果来源
+    enum class ResolveSource {
+        // 数字地址, 不查询
+        Literal,
+        // 命中成功缓存
+        Hit,
+        // 命中失败缓存
+        NegativeHit,
+        // 发起uv_getaddrinfo
+        Query,
+        // 并入进行中的同名查询
+        Coalesced,
+        Count,
+    };
+
+    /**
+     * 网络层内置指标, 首次使用时注册到全局指标注册表
+     */
+    struct NetMetrics {
+        Metrics::Counter bytesIn;
+        Metrics::Counter bytesOut;
+        Metrics::Counter messagesIn;
+        Metrics::Counter messagesOut;
+        Metrics::Counter accepts;
+        Metrics::Counter closes[static_cast<int>(CloseReason::Count)];
+        Metrics::Gauge writeQueueBytes;
+        Metrics::Histogram tlsHandshake;
+        Metrics::Histogram wsHandshake;
+        Metrics::Counter resolves[static_cast<int>(ResolveSource::Count)];
+        Metrics::Histogram resolveTime;
+
+        static NetMetrics &Instance();
+
+        /**
+         * 按错误码归类关闭原因
+         * @param err 错误码
+         * @return 关闭原因
+         */
+        static CloseReason Classify(int err);
+
+        /**
+         * 记录一次连接关闭
+         * @param err 关闭时的错误码
+         */
+        inline void RecordClose(int err) {
+            closes[static_cast<int>(Classify(err))].Add();
+        }
+
+    private:
+        NetMetrics();
+    };
+}
+
+#endif //LCC_NETMETRICS_H
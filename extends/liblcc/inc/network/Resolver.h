@@ -0,0 +1,148 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_RESOLVER_H
+#define LCC_RESOLVER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "libuv/uv.h"
+
+namespace Lcc {
+    /**
+     * 解析得到的地址, 端口为0, 由使用方填入
+     */
+    union ResolvedAddress {
+        sockaddr addr;
+        sockaddr_in addr4;
+        sockaddr_in6 addr6;
+    };
+
+    class ResolveImplement {
+    public:
+        virtual ~ResolveImplement() = default;
+
+        /**
+         * 异步解析完成时触发
+         * @param status 错误码, 0为成功
+         * @param addresses 全部地址, 保持系统返回的顺序
+         */
+        virtual void IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) = 0;
+    };
+
+    /**
+     * 解析参数
+     */
+    struct ResolverOptions {
+        // 成功结果的缓存时间(毫秒), 0表示不缓存
+        unsigned int ttl;
+        // 失败结果的缓存时间(毫秒), 0表示不缓存
+        unsigned int negativeTtl;
+        // 缓存的主机名上限, 超出时先淘汰过期项, 再淘汰最早到期的项
+        unsigned int capacity;
+
+        ResolverOptions();
+    };
+
+    /**
+     * 主机名解析, 每个线程一个, 供线程上的事件循环使用, 不跨线程共享
+     * - 数字地址(IPv4/IPv6)直接转换, 不经过uv_getaddrinfo
+     * - 结果按主机名缓存, 失败结果同样缓存一段时间, 避免反复查询不存在的域名
+     * - 同一主机名的并发查询合并为一次uv_getaddrinfo, 完成后通知全部等待者
+     */
+    class Resolver {
+        struct Lookup;
+
+        struct Entry {
+            // 固定的结果不过期也不被淘汰
+            bool pinned;
+            int status;
+            // 到期时刻(uv_hrtime纳秒)
+            uint64_t expire;
+            std::vector<ResolvedAddress> addresses;
+            // 进行中的查询, 完成前不为空
+            Lookup *lookup;
+            std::vector<ResolveImplement *> waiters;
+        };
+
+    public:
+        /**
+         * 获取当前线程的解析器
+         * @return 解析器
+         */
+        static Resolver &Local();
+
+        /**
+         * 把数字地址转换为套接字地址
+         * @param host 主机, IPv6不带方括号
+         * @param address 输出地址
+         * @return 是否为数字地址
+         */
+        static bool ParseLiteral(const char *host, ResolvedAddress &address);
+
+        /**
+         * 设置解析参数, 只影响之后写入的缓存
+         * @param options 参数
+         */
+        void SetOptions(const ResolverOptions &options);
+
+        /**
+         * 解析主机名
+         * 数字地址或命中缓存时直接写出结果并返回true, 不触发回调;
+         * 否则发起查询(或并入进行中的同名查询)并返回false, 完成后在loop线程触发impl->IResolveReport
+         * @param loop 事件循环
+         * @param host 主机名
+         * @param impl 异步结果接收者
+         * @param status 同步结果的错误码
+         * @param addresses 同步结果的地址
+         * @return 是否同步得到结果
+         */
+        bool Resolve(uv_loop_t *loop, const char *host, ResolveImplement *impl, int &status,
+                     std::vector<ResolvedAddress> &addresses);
+
+        /**
+         * 固定主机名的解析结果(类似hosts文件), 之后的解析直接返回该结果, 可用于测试或服务发现
+         * @param host 主机名
+         * @param addresses 地址, 为空时取消固定
+         */
+        void Pin(const char *host, const std::vector<ResolvedAddress> &addresses);
+
+        /**
+         * 取消接收者的全部等待, 查询本身继续进行并写入缓存
+         * @param impl 接收者
+         */
+        void Cancel(ResolveImplement *impl);
+
+        /**
+         * 清空缓存, 进行中的查询与固定的结果不受影响
+         */
+        void Clear();
+
+        /**
+         * 获取缓存的主机名数量(含进行中的查询)
+         * @return 数量
+         */
+        size_t Size() const;
+
+    private:
+        Resolver() = default;
+
+        /**
+         * 超出上限时淘汰缓存
+         * @param now 当前时刻
+         */
+        void Evict(uint64_t now);
+
+        static void UvResolveCallback(uv_getaddrinfo_t *req, int status, addrinfo *res);
+
+    private:
+        ResolverOptions _options;
+        std::unordered_map<std::string, Entry> _entries;
+        // 正在通知的等待者, Cancel时同样从中移除
+        std::vector<ResolveImplement *> *_reporting = nullptr;
+    };
+}
+
+#endif //LCC_RESOLVER_H
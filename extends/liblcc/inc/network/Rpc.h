@@ -0,0 +1,323 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_RPC_H
+#define LCC_RPC_H
+
+#include <string>
+#include <vector>
+#include "uv.h"
+#include "utils/Histogram.h"
+
+namespace Lcc {
+    // 消息类型
+    enum class RpcKind : unsigned char {
+        // 单向通知, 不需要回复
+        Notify,
+        // 请求, 需要回复Response或Error
+        Request,
+        // 回复
+        Response,
+        // 错误回复, 数据为4字节大端错误码
+        Error,
+    };
+
+    /**
+     * 消息视图, 数据直接指向接收缓冲区, 只在回调期间有效
+     * 线上格式(位于一帧内): 2字节大端消息id + 1字节类型 + 4字节大端关联序号 + 数据
+     */
+    struct RpcMessage {
+        static const unsigned int kHeadSize = 7;
+
+        unsigned short id;
+        RpcKind kind;
+        unsigned int seq;
+        const char *data;
+        unsigned int size;
+
+        /**
+         * 从一帧数据解析消息头, 不复制数据
+         * @param buf 帧数据
+         * @param size 帧长度
+         * @param msg 输出消息
+         * @return 是否解析成功
+         */
+        static bool Decode(const char *buf, unsigned int size, RpcMessage &msg);
+
+        /**
+         * 编码消息头
+         * @param id 消息id
+         * @param kind 消息类型
+         * @param seq 关联序号
+         * @param out 输出缓冲区, 至少kHeadSize字节
+         */
+        static void EncodeHead(unsigned short id, RpcKind kind, unsigned int seq, char *out);
+    };
+
+    /**
+     * 指向接收缓冲区的字节片段
+     */
+    struct RpcSlice {
+        const char *data;
+        unsigned int size;
+
+        std::string ToString() const { return std::string(data, size); }
+    };
+
+    /**
+     * 原地解码: 整数为大端, 字节串为4字节大端长度+数据, 字节串以片段形式返回不复制
+     * 任一读取越界后所有读取均失败, 解码结束检查Ok()即可
+     */
+    class RpcReader {
+    public:
+        RpcReader(const char *buf, unsigned int size);
+
+        explicit RpcReader(const RpcMessage &msg);
+
+        bool Read(unsigned char &value);
+
+        bool Read(unsigned short &value);
+
+        bool Read(unsigned int &value);
+
+        bool Read(unsigned long long &value);
+
+        bool Read(RpcSlice &value);
+
+        /**
+         * 是否全部读取成功
+         * @return 是否成功
+         */
+        bool Ok() const;
+
+        /**
+         * 获取剩余字节数
+         * @return 字节数
+         */
+        unsigned int Remain() const;
+
+    private:
+        /**
+         * 按大端读取
+         * @param bytes 字节数
+         * @param value 输出值
+         * @return 是否成功
+         */
+        bool ReadBigEndian(unsigned int bytes, unsigned long long &value);
+
+    private:
+        const char *_buf;
+        unsigned int _size;
+        unsigned int _offset;
+        bool _ok;
+    };
+
+    /**
+     * 编码到调用者提供的缓冲区, 与RpcReader格式对应, 缓冲区容量可复用
+     */
+    class RpcWriter {
+    public:
+        explicit RpcWriter(std::string &out);
+
+        RpcWriter &Write(unsigned char value);
+
+        RpcWriter &Write(unsigned short value);
+
+        RpcWriter &Write(unsigned int value);
+
+        RpcWriter &Write(unsigned long long value);
+
+        RpcWriter &Write(const char *data, unsigned int size);
+
+    private:
+        /**
+         * 按大端写入
+         * @param bytes 字节数
+         * @param value 值
+         */
+        void WriteBigEndian(unsigned int bytes, unsigned long long value);
+
+    private:
+        std::string &_out;
+    };
+
+    class RpcImplement {
+    public:
+        virtual ~RpcImplement() = default;
+
+        /**
+         * 需要发送一帧消息时触发, 由底层连接负责分帧(如FramePlugin)
+         * @param session 会话id
+         * @param buf 消息数据
+         * @param size 消息长度
+         */
+        virtual void IRpcWrite(unsigned int session, const char *buf, unsigned int size) = 0;
+
+        /**
+         * 收到通知或请求时触发, 请求需调用Reply/ReplyError回复
+         * @param session 会话id
+         * @param msg 消息
+         */
+        virtual void IRpcReceive(unsigned int session, const RpcMessage &msg) = 0;
+
+        /**
+         * 请求完成时触发: 收到回复、错误、超时或连接断开
+         * @param session 会话id
+         * @param context 发起请求时传入的上下文
+         * @param status 0表示收到回复, 否则为错误码(UV_ETIMEDOUT/UV_ECONNRESET/对端返回的错误码)
+         * @param msg 回复消息, 失败时数据为空
+         */
+        virtual void IRpcResponse(unsigned int session, void *context, int status, const RpcMessage &msg) = 0;
+    };
+
+    /**
+     * 请求/回复关联: 序号由槽位下标与代数组成, 在途请求存放在槽位数组内, 稳定运行时不做堆分配
+     * 超时由单个uv_timer驱动, 指向最早的截止时间
+     * 只能在事件循环线程内使用
+     */
+    class RpcEndpoint {
+        struct Pending {
+            bool active;
+            unsigned int seq;
+            unsigned int session;
+            void *context;
+            uint64_t start;
+            uint64_t deadline;
+        };
+
+        struct Deadline {
+            uint64_t deadline;
+            unsigned int seq;
+
+            bool operator<(const Deadline &other) const { return deadline > other.deadline; }
+        };
+
+    public:
+        static const unsigned int kMaxPending = 0x10000;
+
+    public:
+        RpcEndpoint(uv_loop_t *loop, RpcImplement *impl);
+
+        virtual ~RpcEndpoint();
+
+        /**
+         * 处理收到的一帧, 回复在此完成关联, 通知与请求交给IRpcReceive
+         * @param session 会话id
+         * @param buf 帧数据
+         * @param size 帧长度
+         * @return 是否为合法消息
+         */
+        bool Receive(unsigned int session, const char *buf, unsigned int size);
+
+        /**
+         * 发起请求
+         * @param session 会话id
+         * @param id 消息id
+         * @param buf 请求数据
+         * @param size 请求长度
+         * @param context 完成时回传的上下文
+         * @param timeout 超时毫秒
+         * @return 关联序号, 在途请求已满时返回0
+         */
+        unsigned int Call(unsigned int session, unsigned short id, const char *buf, unsigned int size,
+                          void *context, uint64_t timeout);
+
+        /**
+         * 发送通知
+         * @param session 会话id
+         * @param id 消息id
+         * @param buf 数据
+         * @param size 数据长度
+         */
+        void Notify(unsigned int session, unsigned short id, const char *buf, unsigned int size);
+
+        /**
+         * 回复请求
+         * @param session 会话id
+         * @param request 请求消息
+         * @param buf 回复数据
+         * @param size 回复长度
+         */
+        void Reply(unsigned int session, const RpcMessage &request, const char *buf, unsigned int size);
+
+        /**
+         * 以错误码回复请求
+         * @param session 会话id
+         * @param request 请求消息
+         * @param status 错误码
+         */
+        void ReplyError(unsigned int session, const RpcMessage &request, int status);
+
+        /**
+         * 连接断开, 该会话上的在途请求以UV_ECONNRESET完成
+         * @param session 会话id
+         */
+        void SessionClosed(unsigned int session);
+
+        /**
+         * 所有在途请求以UV_ECANCELED完成并关闭定时器, 析构时自动调用
+         */
+        void Release();
+
+        /**
+         * 获取在途请求数
+         * @return 请求数
+         */
+        size_t PendingCount() const;
+
+        /**
+         * 获取请求往返耗时分布(纳秒)
+         * @return 直方图
+         */
+        const Utils::Histogram &Latency() const;
+
+        /**
+         * 清空往返耗时统计
+         */
+        void ResetLatency();
+
+    private:
+        /**
+         * 编码消息头与数据, 一次写出
+         */
+        void Send(unsigned int session, unsigned short id, RpcKind kind, unsigned int seq, const char *buf,
+                  unsigned int size);
+
+        /**
+         * 完成在途请求
+         * @param index 槽位下标
+         * @param status 状态
+         * @param msg 回复消息
+         */
+        void Complete(unsigned int index, int status, const RpcMessage &msg);
+
+        /**
+         * 按最早的截止时间重新设置定时器
+         */
+        void ArmTimer();
+
+        /**
+         * 截止时间对应的请求是否仍在途
+         * @param deadline 截止时间
+         * @return 是否在途
+         */
+        bool IsLive(const Deadline &deadline) const;
+
+        static void UvTimeoutCallback(uv_timer_t *handle);
+
+    private:
+        uv_loop_t *_loop;
+        RpcImplement *_impl;
+        uv_timer_t *_timer;
+        uint64_t _armed;
+        size_t _pendingCount;
+        std::string _output;
+        Utils::Histogram _latency;
+        std::vector<Pending> _slots;
+        std::vector<unsigned int> _freeSlots;
+        std::vector<Deadline> _deadlines;
+    };
+}
+
+#endif //LCC_RPC_H
@@ -0,0 +1,185 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_SHM_CHANNEL_H
+#define LCC_SHM_CHANNEL_H
+
+#include <deque>
+#include <string>
+#include "libuv/uv.h"
+#include "buffer/SpscRing.h"
+
+namespace Lcc {
+    class ShmChannelImplement {
+    public:
+        virtual ~ShmChannelImplement() = default;
+
+        /**
+         * 收到一条消息时触发
+         * @param buf 消息内容, 回调返回后失效
+         * @param size 消息长度
+         */
+        virtual void IChannelReceive(const char *buf, unsigned int size) = 0;
+
+        /**
+         * 本地积压的消息全部写入共享环时触发
+         */
+        virtual void IChannelWriteDrain() {
+        }
+
+        /**
+         * 唤醒失败或对端写入非法记录时触发, 需关闭通道
+         * @param err 错误码
+         */
+        virtual void IChannelError(int err) = 0;
+
+        /**
+         * 通道关闭完成时触发, 之后可以释放通道
+         */
+        virtual void IChannelClosed() = 0;
+    };
+
+    /**
+     * 共享内存通道的一端, 两个进程映射同一段memfd, 每个方向一个SpscRing
+     * 消费者处理完已发布的记录后标记休眠, 生产者只在对端休眠时写eventfd唤醒, 持续收发时不产生系统调用
+     * 消息按条收发, 单条不超过MaxMessageSize, 共享环写满时在本地排队
+     * 仅支持Linux
+     */
+    class ShmChannel {
+        // 共享内存布局与每个方向的共享状态, 定义在实现中
+        struct Segment;
+        struct Direction;
+
+    public:
+        // 交给对端的描述符: 共享内存, 接受方等待的eventfd, 发起方等待的eventfd
+        static constexpr unsigned int kFdCount = 3;
+
+    public:
+        explicit ShmChannel(ShmChannelImplement *impl);
+
+        virtual ~ShmChannel();
+
+        /**
+         * [发起方] 创建共享内存与eventfd
+         * @param capacity 每个方向的环大小, 向上取整为2的幂
+         * @param fds 输出描述符
+         * @return 错误码, 0为成功
+         */
+        static int Create(unsigned int capacity, int fds[kFdCount]);
+
+        /**
+         * 通过unix域套接字发送描述符
+         * @param socket 套接字
+         * @param fds 描述符
+         * @return 错误码, 0为成功
+         */
+        static int SendFds(int socket, const int fds[kFdCount]);
+
+        /**
+         * 从unix域套接字接收描述符
+         * @param socket 非阻塞套接字
+         * @param fds 输出描述符
+         * @return 错误码, 0为成功, 尚未到达时为UV_EAGAIN, 对端关闭时为UV_EOF
+         */
+        static int ReceiveFds(int socket, int fds[kFdCount]);
+
+        /**
+         * 关闭描述符并置为-1
+         * @param fds 描述符
+         */
+        static void CloseFds(int fds[kFdCount]);
+
+        /**
+         * 映射共享内存并开始接收, 无论成功与否描述符都归通道所有
+         * @param loop 事件循环
+         * @param fds 描述符
+         * @param initiator 是否为发起方
+         * @return 错误码, 0为成功
+         */
+        int Open(uv_loop_t *loop, int fds[kFdCount], bool initiator);
+
+        /**
+         * 关闭通道, 完成后触发IChannelClosed, 本地尚未写入共享环的消息被丢弃
+         */
+        void Close();
+
+        /**
+         * 立即处理已到达的消息, 用于对端断开前写入的最后一批消息
+         */
+        void Receive();
+
+        /**
+         * 写入一条消息
+         * @param buf 数据
+         * @param size 数据长度
+         * @return 是否写入(或排队)成功, 未打开或超过MaxMessageSize时失败
+         */
+        bool Write(const char *buf, unsigned int size);
+
+        /**
+         * 获取对端尚未处理与本地排队的字节数
+         * @return 字节数
+         */
+        size_t WriteQueueSize() const;
+
+        /**
+         * 获取单条消息的最大长度
+         * @return 最大长度, 未打开时为0
+         */
+        unsigned int MaxMessageSize() const;
+
+        /**
+         * 是否已打开且未关闭
+         * @return 是否可用
+         */
+        bool IsOpen() const;
+
+    protected:
+        /**
+         * 处理唤醒: 先写入本地排队的消息, 再读取对端消息直到环为空
+         */
+        void Process();
+
+        /**
+         * 把本地排队的消息写入共享环
+         * @return 是否有消息写入
+         */
+        bool Flush();
+
+        /**
+         * 对端消费者休眠时唤醒它
+         */
+        void WakeSleepingPeer();
+
+        /**
+         * 对端生产者等待空间时唤醒它
+         */
+        void WakeBlockedPeer();
+
+    protected:
+        static void UvWakeCallback(uv_poll_t *handle, int status, int events);
+
+        static void UvCloseCallback(uv_handle_t *handle);
+
+    private:
+        ShmChannelImplement *_implement;
+        Segment *_segment;
+        size_t _segmentSize;
+        bool _closing;
+        int _fds[kFdCount];
+        // 本端等待与对端等待的eventfd
+        int _wakeFd;
+        int _peerFd;
+        // 本端写入与读取方向的共享状态
+        Direction *_txDirection;
+        Direction *_rxDirection;
+        SpscRing *_tx;
+        SpscRing *_rx;
+        uv_poll_t _wakePoll;
+        size_t _backlogBytes;
+        std::deque<std::string> _backlog;
+    };
+}
+
+#endif //LCC_SHM_CHANNEL_H
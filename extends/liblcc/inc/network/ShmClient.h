@@ -0,0 +1,127 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_SHM_CLIENT_H
+#define LCC_SHM_CLIENT_H
+
+#include "utils/Address.h"
+#include "network/Interface.h"
+#include "network/ShmChannel.h"
+
+namespace Lcc {
+    /**
+     * 共享内存客户端, 连接shm://套接字路径, 与TcpClient使用相同的ClientImplement回调
+     * 连上后创建共享内存与eventfd并通过套接字交给服务端, 服务端确认后报告连接成功
+     * IClientInit按管道初始化句柄; 消息按条收发, 不经过协议插件
+     */
+    class ShmClient : public ShmChannelImplement {
+        enum class Status {
+            None,
+            Connecting,
+            Handshake,
+            Connected,
+            ConnectFail,
+            Closing,
+        };
+
+    public:
+        explicit ShmClient(ClientImplement *impl);
+
+        ~ShmClient() override;
+
+        /**
+         * 设置每个方向的共享环大小, 需在Connect前设置
+         * @param capacity 大小, 默认1MB, 单条消息不超过一半
+         */
+        void SetCapacity(unsigned int capacity);
+
+        /**
+         * 连接服务端
+         * @param host 服务端地址, 如shm:///tmp/game.sock
+         */
+        void Connect(const char *host);
+
+        /**
+         * 关闭连接
+         */
+        void Shutdown();
+
+        /**
+         * 写一条消息, 超过单条上限时关闭连接(UV_EMSGSIZE)
+         * @param buf 数据
+         * @param size 数据长度
+         */
+        void Write(const char *buf, unsigned int size);
+
+        /**
+         * 获取会话id
+         * @return 会话id, 未连接时为0
+         */
+        unsigned int GetSession() const;
+
+        /**
+         * 获取对端尚未处理的字节数
+         * @return 字节数, 未连接时为0
+         */
+        size_t WriteQueueSize() const;
+
+    protected:
+        /**
+         * 套接字连上后发送共享内存
+         */
+        void Handshake();
+
+        /**
+         * 连接或握手失败
+         * @param status 失败错误码
+         */
+        void ConnectFail(int status);
+
+        /**
+         * 关闭套接字与通道
+         * @param err 错误码
+         */
+        void Close(int err);
+
+        /**
+         * 套接字或通道关闭完成
+         */
+        void Done();
+
+    protected:
+        void IChannelReceive(const char *buf, unsigned int size) override;
+
+        void IChannelWriteDrain() override;
+
+        void IChannelError(int err) override;
+
+        void IChannelClosed() override;
+
+    protected:
+        static void UvConnectCallback(uv_connect_t *req, int status);
+
+        static void UvAllocCallback(uv_handle_t *handle, size_t suggested, uv_buf_t *buf);
+
+        static void UvReadCallback(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+
+        static void UvCloseCallback(uv_handle_t *handle);
+
+    private:
+        Status _status;
+        // 关闭前的状态, 决定是否触发断开回调
+        bool _connected;
+        StreamHandle *_handle;
+        ClientImplement *_implement;
+        uv_connect_t _connectReq;
+        unsigned int _capacity;
+        // 等待关闭完成的句柄数
+        unsigned int _pending;
+        int _fds[ShmChannel::kFdCount];
+        char _readBuf[16];
+        ShmChannel _channel;
+        Utils::HostAddress _hostAddress;
+    };
+}
+
+#endif //LCC_SHM_CLIENT_H
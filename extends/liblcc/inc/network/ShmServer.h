@@ -0,0 +1,113 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_SHM_SERVER_H
+#define LCC_SHM_SERVER_H
+
+#include <string>
+#include <unordered_map>
+#include "utils/Address.h"
+#include "network/Interface.h"
+#include "network/ShmChannel.h"
+
+namespace Lcc {
+    /**
+     * 共享内存服务端, 监听shm://套接字路径, 与TcpServer使用相同的ServerImplement回调
+     * 客户端连上后通过套接字传来共享内存与eventfd, 之后消息经共享内存收发, 套接字只用于感知对端断开
+     * IServerInit按管道初始化监听句柄; 消息按条收发, 不经过协议插件
+     */
+    class ShmServer {
+        enum class Status {
+            None,
+            Listened,
+            ListenFail,
+        };
+
+        class Session;
+
+    public:
+        explicit ShmServer(ServerImplement *impl);
+
+        virtual ~ShmServer();
+
+        /**
+         * 启动监听
+         * @param host 监听地址, 如shm:///tmp/game.sock
+         */
+        void Listen(const char *host);
+
+        /**
+         * 关闭监听
+         */
+        void Shutdown();
+
+        /**
+         * 关闭所有连接
+         */
+        void ShutdownAllSessions();
+
+        /**
+         * 关闭指定会话
+         * @param session 会话id
+         */
+        void ShutdownSession(unsigned int session);
+
+        /**
+         * 获取监听地址信息
+         * @return 地址信息
+         */
+        const Utils::HostAddress &GetListenAddress() const;
+
+        /**
+         * 向会话写一条消息, 超过单条上限时关闭会话(UV_EMSGSIZE)
+         * @param session 会话id
+         * @param buf 数据
+         * @param size 数据长度
+         */
+        void SessionWrite(unsigned int session, const char *buf, unsigned int size);
+
+        /**
+         * 获取会话对端尚未处理的字节数
+         * @param session 会话id
+         * @return 字节数, 会话不存在时为0
+         */
+        size_t SessionWriteQueueSize(unsigned int session);
+
+    protected:
+        /**
+         * 监听失败
+         * @param status 失败错误码
+         */
+        void ListenFail(int status);
+
+        /**
+         * 查询已打开的会话
+         * @param session 会话id
+         * @return 会话, 不存在或未打开时为nullptr
+         */
+        Session *GetOpenSession(unsigned int session);
+
+        /**
+         * 会话关闭完成, 释放会话
+         * @param session 会话
+         */
+        void SessionClosed(Session *session);
+
+    protected:
+        static void UvNewSessionCallback(uv_stream_t *server, int status);
+
+        static void UvServerShutdownCallback(uv_handle_t *handle);
+
+    private:
+        Status _status;
+        StreamHandle *_handle;
+        unsigned int _isession;
+        ServerImplement *_implement;
+        std::string _errdesc;
+        Utils::HostAddress _hostAddress;
+        std::unordered_map<unsigned int, Session *> _sessionMap;
+    };
+}
+
+#endif //LCC_SHM_SERVER_H
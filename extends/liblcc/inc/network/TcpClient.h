@@ -6,11 +6,25 @@
 #define LCC_TCPCLIENT_H
 
 #include "utils/Address.h"
+#include "network/Resolver.h"
 #include "network/TcpStream.h"
 #include "protocol/WebSocket.h"
 
 namespace Lcc {
-    class TcpClient : public StreamImplement {
+    /**
+     * 客户端连接, 解析出多个地址时按RFC 8305竞速(Happy Eyeballs):
+     * 地址按协议族交替排列, 每隔一段时间发起下一个尝试, 任一尝试失败时立即发起下一个, 先连上的胜出, 其余取消
+     * unix://地址直接连接本机套接字路径
+     */
+    class TcpClient : public StreamImplement, public ResolveImplement {
+        // 竞速中的一次连接尝试, 胜出后套接字转交给流
+        struct ConnectAttempt {
+            uv_tcp_t handle;
+            uv_connect_t req;
+            TcpClient *client;
+            ResolvedAddress address;
+        };
+
         enum class Status {
             None,
             Address,
@@ -37,7 +51,19 @@ namespace Lcc {
         void Shutdown();
 
         /**
-         * 启用协议插件支持
+         * 设置连接超时, 从发起第一个尝试算起, 需在Connect前设置
+         * @param timeout 超时(毫秒), 0表示不限制, 由系统决定
+         */
+        void SetConnectTimeout(unsigned int timeout);
+
+        /**
+         * 设置竞速时相邻两次尝试的间隔(RFC 8305 Connection Attempt Delay), 需在Connect前设置
+         * @param delay 间隔(毫秒), 默认250
+         */
+        void SetAttemptDelay(unsigned int delay);
+
+        /**
+         * 启用协议插件支持, 创造器在重连之间复用, 析构时释放
          * @param creator 协议插件创造器
          */
         void Enable(ProtocolPluginCreator *creator);
@@ -61,12 +87,25 @@ namespace Lcc {
          */
         unsigned int GetSession() const;
 
+        /**
+         * 获取待发送的字节数
+         * @return 字节数, 未连接时为0
+         */
+        size_t WriteQueueSize() const;
+
     protected:
         /**
          * 解析地址
          */
         void AddressParse();
 
+        /**
+         * 地址解析完成
+         * @param status 错误码
+         * @param addresses 解析得到的全部地址
+         */
+        void AddressResolved(int status, const std::vector<ResolvedAddress> &addresses);
+
         /**
          * 解析地址后的连接
          */
@@ -78,6 +117,32 @@ namespace Lcc {
          */
         void AddressConnectFail(int status);
 
+        /**
+         * 连接建立, 挂载协议插件并启动流
+         */
+        void AddressConnected();
+
+        /**
+         * 向下一个地址发起竞速尝试
+         */
+        void AttemptNext();
+
+        /**
+         * 尝试胜出, 把套接字转交给流
+         * @param attempt 胜出的尝试
+         */
+        void AttemptWon(ConnectAttempt *attempt);
+
+        /**
+         * 取消全部尝试并停止计时
+         */
+        void StopConnecting();
+
+        /**
+         * 按地址准备WebSocket/SSL创造器, 地址不变时复用上次的创造器
+         */
+        void PrepareSchemeCreators();
+
     protected:
         bool IStreamInit(StreamHandle &handle) override;
 
@@ -89,21 +154,47 @@ namespace Lcc {
 
         void IStreamAfterClose(unsigned int session) override;
 
-    protected:
-        static void UvAddressParseCallback(uv_getaddrinfo_t *info, int status, addrinfo *res);
+        void IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) override;
 
+    protected:
         static void UvConnectStatusCallback(uv_connect_t *req, int status);
 
+        static void UvAttemptCallback(uv_connect_t *req, int status);
+
+        static void UvAttemptCloseCallback(uv_handle_t *handle);
+
+        static void UvAttemptTimerCallback(uv_timer_t *handle);
+
+        static void UvTimeoutCallback(uv_timer_t *handle);
+
+        static void UvTimerCloseCallback(uv_handle_t *handle);
+
     private:
         Status _status;
-        uv_tcp_t *_handle;
+        StreamHandle *_handle;
         TcpStream *_tcpStream;
         ClientImplement *_implement;
+        // 同一时刻只有一个连接请求, 请求内存随对象分配
+        uv_connect_t _connectReq;
+        // 解析得到的全部地址, 已按协议族交替排列
+        std::vector<ResolvedAddress> _addresses;
+        // 竞速状态, 只有多个地址时使用
+        size_t _nextAddress;
+        int _lastError;
+        unsigned int _attemptDelay;
+        unsigned int _connectTimeout;
+        std::vector<ConnectAttempt *> _attempts;
+        uv_timer_t *_attemptTimer;
+        uv_timer_t *_timeoutTimer;
 
     private:
         WebSocketOpcode _opcode;
         Utils::HostAddress _hostAddress;
         std::vector<ProtocolPluginCreator *> _creatorVec;
+        // 按地址自动创建的创造器, 以及创建时的地址
+        std::vector<ProtocolPluginCreator *> _schemeCreatorVec;
+        Utils::HostAddress _schemeAddress;
+        WebSocketOpcode _schemeOpcode;
     };
 }
 
@@ -0,0 +1,221 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_TCPCLIENTPOOL_H
+#define LCC_TCPCLIENTPOOL_H
+
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "network/TcpClient.h"
+
+namespace Lcc {
+    // 连接池写入时的分发方式
+    enum class PoolDispatch {
+        // 依次轮换
+        RoundRobin,
+        // 待发送字节最少的连接, 相同时轮换
+        LeastLoaded,
+    };
+
+    /**
+     * 连接池参数
+     */
+    struct ClientPoolOptions {
+        // 每个端点保持的连接数
+        unsigned int connections;
+        // 重连退避的基准间隔(毫秒), 连续失败时翻倍
+        unsigned int backoffBase;
+        // 重连退避的最大间隔(毫秒), 连接保持超过该时长后退避重新计算
+        unsigned int backoffMax;
+        // 单次连接超时(毫秒), 0表示由系统决定
+        unsigned int connectTimeout;
+        // 连接空闲多久后做健康检查(毫秒), 0表示不检查
+        unsigned int idleTimeout;
+        // 健康检查等待应答的时间(毫秒), 超时后断开重连
+        unsigned int checkTimeout;
+        PoolDispatch dispatch;
+
+        ClientPoolOptions();
+    };
+
+    class ClientPoolImplement {
+    public:
+        virtual ~ClientPoolImplement() = default;
+
+        /**
+         * 连接对象创建时触发一次, 可在此启用协议插件, 创造器在之后的重连中复用
+         * @param endpoint 端点id
+         * @param link 连接id
+         * @param client 连接对象
+         */
+        virtual void IPoolLinkSetup(unsigned int endpoint, unsigned int link, TcpClient &client) {
+        }
+
+        /**
+         * 连接建立(含重连)时触发
+         * @param endpoint 端点id
+         * @param link 连接id
+         */
+        virtual void IPoolLinkUp(unsigned int endpoint, unsigned int link) = 0;
+
+        /**
+         * 已建立的连接将要断开时触发, 之后按退避间隔自动重连
+         * @param endpoint 端点id
+         * @param link 连接id
+         * @param err 错误码
+         * @param errMsg 错误信息
+         */
+        virtual void IPoolLinkDown(unsigned int endpoint, unsigned int link, int err, const char *errMsg) = 0;
+
+        /**
+         * 等待重连时触发
+         * @param endpoint 端点id
+         * @param link 连接id
+         * @param failures 连续失败次数
+         * @param delay 重连间隔(毫秒)
+         */
+        virtual void IPoolLinkRetry(unsigned int endpoint, unsigned int link, unsigned int failures,
+                                    unsigned int delay) {
+        }
+
+        /**
+         * 连接收到数据时触发
+         * @param endpoint 端点id
+         * @param link 连接id
+         * @param buf 数据
+         * @param size 数据长度
+         */
+        virtual void IPoolReceive(unsigned int endpoint, unsigned int link, const char *buf, unsigned int size) = 0;
+
+        /**
+         * 连接空闲超过idleTimeout时触发, 可通过WriteTo发送探测, 之后checkTimeout内没有收到任何数据则断开重连
+         * @param endpoint 端点id
+         * @param link 连接id
+         * @return 是否发送了探测, 默认不探测, 只依赖TCP保活
+         */
+        virtual bool IPoolHealthCheck(unsigned int endpoint, unsigned int link) {
+            return false;
+        }
+
+        /**
+         * 连接池完全关闭时触发
+         */
+        virtual void IPoolShutdown() = 0;
+    };
+
+    /**
+     * 客户端连接池: 每个端点保持固定数量的连接, 断开或连接失败后按带抖动的指数退避自动重连,
+     * 空闲连接做健康检查, 写入按轮换或最少待发送分发到已连接的连接上
+     * 只能在事件循环线程内使用, 析构前需Shutdown并等待IPoolShutdown
+     */
+    class TcpClientPool {
+        class Link;
+
+        struct Endpoint {
+            unsigned int id;
+            std::string host;
+            bool removed;
+            size_t next;
+            // 全部连接对象
+            std::vector<Link *> links;
+            // 已连接的连接, 写入在其中分发
+            std::vector<Link *> ready;
+        };
+
+    public:
+        TcpClientPool(uv_loop_t *loop, ClientPoolImplement *impl);
+
+        ~TcpClientPool();
+
+        /**
+         * 设置参数, 需在AddEndpoint前设置
+         * @param options 参数
+         */
+        void SetOptions(const ClientPoolOptions &options);
+
+        /**
+         * 添加端点并开始建立连接
+         * @param host 远端地址, 格式同TcpClient::Connect
+         * @return 端点id, 地址无效或已关闭时返回0
+         */
+        unsigned int AddEndpoint(const char *host);
+
+        /**
+         * 移除端点, 关闭其全部连接
+         * @param endpoint 端点id
+         */
+        void RemoveEndpoint(unsigned int endpoint);
+
+        /**
+         * 向端点写数据, 按分发方式选择一个已连接的连接
+         * @param endpoint 端点id
+         * @param buf 数据
+         * @param size 数据长度
+         * @return 写入的连接id, 没有可用连接时返回0
+         */
+        unsigned int Write(unsigned int endpoint, const char *buf, unsigned int size);
+
+        /**
+         * 向指定连接写数据
+         * @param link 连接id
+         * @param buf 数据
+         * @param size 数据长度
+         * @return 连接是否可写
+         */
+        bool WriteTo(unsigned int link, const char *buf, unsigned int size);
+
+        /**
+         * 获取端点已连接的连接数
+         * @param endpoint 端点id
+         * @return 连接数
+         */
+        size_t ConnectedCount(unsigned int endpoint) const;
+
+        /**
+         * 关闭全部端点, 全部连接关闭后触发IPoolShutdown
+         */
+        void Shutdown();
+
+    private:
+        /**
+         * 连接断开或连接失败后, 按退避间隔等待重连; 已移除的连接释放
+         * @param link 连接
+         */
+        void LinkClosed(Link *link);
+
+        /**
+         * 计算重连间隔: 上限为基准间隔按失败次数翻倍, 在上限的一半到上限之间随机
+         * @param failures 连续失败次数
+         * @return 间隔(毫秒)
+         */
+        unsigned int Backoff(unsigned int failures);
+
+        /**
+         * 关闭连接并在关闭后释放
+         * @param link 连接
+         */
+        void Release(Link *link);
+
+        /**
+         * 连接对象已释放
+         * @param link 连接
+         */
+        void LinkReleased(Link *link);
+
+    private:
+        uv_loop_t *_loop;
+        ClientPoolImplement *_impl;
+        ClientPoolOptions _options;
+        bool _shutdown;
+        unsigned int _iendpoint;
+        unsigned int _ilink;
+        std::minstd_rand _random;
+        std::unordered_map<unsigned int, Endpoint *> _endpoints;
+        std::unordered_map<unsigned int, Link *> _links;
+    };
+}
+
+#endif //LCC_TCPCLIENTPOOL_H
@@ -9,10 +9,14 @@
 #include <unordered_map>
 #include "utils/Address.h"
 #include "network/Interface.h"
+#include "network/Resolver.h"
 #include "network/TcpStream.h"
 
 namespace Lcc {
-    class TcpServer : public StreamImplement {
+    /**
+     * 服务端, 监听tcp/ws等地址或unix://套接字路径(本机进程间通信, 不经过TCP协议栈)
+     */
+    class TcpServer : public StreamImplement, public ResolveImplement {
         enum class Status {
             None,
             Address,
@@ -73,12 +77,34 @@ namespace Lcc {
          */
         void SessionWrite(unsigned int session, const char *buf, unsigned int size);
 
+        /**
+         * 获取会话等待发送的字节数
+         * @param session 会话id
+         * @return 字节数, 会话不存在时为0
+         */
+        size_t SessionWriteQueueSize(unsigned int session);
+
+        /**
+         * 获取会话收发统计
+         * @param session 会话id
+         * @param stats 输出统计
+         * @return 会话是否存在
+         */
+        bool GetSessionStats(unsigned int session, StreamStats &stats);
+
     protected:
         /**
          * 解析地址
          */
         void AddressParse();
 
+        /**
+         * 地址解析完成
+         * @param status 错误码
+         * @param addresses 解析得到的全部地址
+         */
+        void AddressResolved(int status, const std::vector<ResolvedAddress> &addresses);
+
         /**
          * 解析地址后的监听
          */
@@ -115,9 +141,11 @@ namespace Lcc {
 
         void IStreamAfterClose(unsigned int session) override;
 
-    protected:
-        static void UvAddressParseCallback(uv_getaddrinfo_t *info, int status, addrinfo *res);
+        void IStreamWriteDrain(unsigned int session) override;
+
+        void IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) override;
 
+    protected:
         static void UvNewSessionCallback(uv_stream_t *server, int status);
 
         static void UvServerShutdownCallback(uv_handle_t *handle);
@@ -125,9 +153,11 @@ namespace Lcc {
     private:
         int _error;
         Status _status;
-        uv_tcp_t *_handle;
+        StreamHandle *_handle;
         unsigned int _isession;
         ServerImplement *_implement;
+        // 监听使用解析结果中的第一个地址
+        ResolvedAddress _address;
 
     private:
         std::string _errdesc;
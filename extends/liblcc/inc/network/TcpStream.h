@@ -10,6 +10,21 @@
 #include "network/ProtocolPlugin.h"
 
 namespace Lcc {
+    // 单个连接的收发统计
+    struct StreamStats {
+        // 从套接字读到的字节数
+        unsigned long long bytesIn;
+        // 已写出到套接字的字节数
+        unsigned long long bytesOut;
+        // 交给应用层的消息数
+        unsigned long long messagesIn;
+        // 应用层写入的消息数
+        unsigned long long messagesOut;
+    };
+
+    /**
+     * 连接流, 句柄为TCP或本机管道, 协议插件只经过uv_stream_t读写, 与传输无关
+     */
     class TcpStream : public ProtocolImplement {
     public:
         /**
@@ -77,6 +92,18 @@ namespace Lcc {
          */
         void Write(const char *buf, unsigned int size);
 
+        /**
+         * 获取等待发送的字节数
+         * @return 字节数
+         */
+        size_t WriteQueueSize() const;
+
+        /**
+         * 获取收发统计
+         * @return 统计
+         */
+        const StreamStats &GetStats() const;
+
     protected:
         /**
          * 根据传入的协议等级，按排序方式获取下一个需要操作的协议插件
@@ -113,13 +140,17 @@ namespace Lcc {
 
     protected:
         bool _init;
+        // 已开始读取, 之前(连接中)没有待发送的数据, 关闭时不需要shutdown
+        bool _started;
         int _error;
         StreamImplement *_implement;
 
     private:
         std::string _errdesc;
-        std::string _allocBuffer;
+        StreamStats _stats{};
         StreamHandle _streamHandle{};
+        // 流只会关闭一次, 重复调用时uv_shutdown在使用请求前即返回错误
+        uv_shutdown_t _shutdownReq{};
         std::vector<ProtocolPlugin *> _protocolPluginVec;
     };
 }
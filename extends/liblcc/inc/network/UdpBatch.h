@@ -0,0 +1,97 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_UDP_BATCH_H
+#define LCC_UDP_BATCH_H
+
+#include <string>
+#include "libuv/uv.h"
+#include "network/Resolver.h"
+#include "network/protocol/Kcp.h"
+
+namespace Lcc {
+    /**
+     * 可靠UDP参数
+     */
+    struct UdpOptions {
+        // ARQ参数, 两端需一致
+        KcpOptions arq;
+        // 多久没有收到对端报文视为断开(毫秒), 客户端每三分之一的时间发送一次保活
+        unsigned int idleTimeout;
+        // 客户端握手超时(毫秒)
+        unsigned int connectTimeout;
+
+        UdpOptions();
+    };
+
+    /**
+     * 可靠UDP的连接状态
+     */
+    struct UdpStats {
+        // 当前重传超时(毫秒)
+        uint32_t rto;
+        // 累计重传次数
+        uint64_t retransmits;
+        // 等待发送与等待确认的报文段数
+        size_t waitSend;
+    };
+
+    /**
+     * UDP批量发送, 一轮事件循环中产生的报文先缓存, 再一次发出
+     * Linux上用sendmmsg, 一次系统调用发出多个报文, 其余平台逐个uv_udp_try_send
+     * 发送缓冲区满(EAGAIN)时丢弃剩余报文, 由ARQ重传
+     */
+    class UdpBatch {
+    public:
+        static constexpr unsigned int kMaxPackets = 64;
+
+    public:
+        UdpBatch();
+
+        /**
+         * 绑定发送用的句柄, 需已绑定或连接
+         * @param handle 句柄, nullptr时丢弃之后的报文
+         */
+        void Attach(uv_udp_t *handle);
+
+        /**
+         * 缓存一个报文, 缓存满时先发出
+         * @param buf 报文
+         * @param size 报文长度
+         * @param addr 目标地址, 已连接的句柄传nullptr
+         */
+        void Push(const char *buf, unsigned int size, const sockaddr *addr);
+
+        /**
+         * 发出全部缓存的报文
+         * @return 上次调用以来第一个非EAGAIN的发送错误, 0为没有错误
+         */
+        int Flush();
+
+        /**
+         * 获取累计发出的报文数
+         * @return 报文数
+         */
+        uint64_t Packets() const;
+
+        /**
+         * 获取累计的发送系统调用次数
+         * @return 次数
+         */
+        uint64_t Calls() const;
+
+    private:
+        uv_udp_t *_handle;
+        unsigned int _count;
+        int _error;
+        uint64_t _packets;
+        uint64_t _calls;
+        std::string _data;
+        unsigned int _offsets[kMaxPackets + 1];
+        bool _hasAddr[kMaxPackets];
+        ResolvedAddress _addrs[kMaxPackets];
+    };
+}
+
+#endif //LCC_UDP_BATCH_H
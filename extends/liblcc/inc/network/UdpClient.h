@@ -0,0 +1,150 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_UDP_CLIENT_H
+#define LCC_UDP_CLIENT_H
+
+#include <vector>
+#include "utils/Address.h"
+#include "network/Interface.h"
+#include "network/Resolver.h"
+#include "network/UdpBatch.h"
+
+namespace Lcc {
+    /**
+     * 可靠UDP客户端, 连接udp://地址, 与TcpClient使用相同的ClientImplement回调
+     * 连接时选一个随机会话号, 反复发送窗口询问直到服务端回复, 之后用窗口询问保活
+     * IClientInit按UDP初始化句柄; 消息按条收发, 不经过协议插件
+     */
+    class UdpClient : public KcpImplement, public ResolveImplement {
+        enum class Status {
+            None,
+            Address,
+            Connecting,
+            Connected,
+            ConnectFail,
+            Closing,
+        };
+
+    public:
+        explicit UdpClient(ClientImplement *impl);
+
+        ~UdpClient() override;
+
+        /**
+         * 设置参数, 需在Connect前设置
+         * @param options 参数
+         */
+        void SetOptions(const UdpOptions &options);
+
+        /**
+         * 连接服务端
+         * @param host 服务端地址, 如udp://127.0.0.1:7000
+         */
+        void Connect(const char *host);
+
+        /**
+         * 关闭连接, 已写入的数据全部确认后关闭
+         */
+        void Shutdown();
+
+        /**
+         * 写一条消息, 超过单条上限时关闭连接(UV_EMSGSIZE)
+         * @param buf 数据
+         * @param size 数据长度
+         */
+        void Write(const char *buf, unsigned int size);
+
+        /**
+         * 获取会话号
+         * @return 会话号, 开始握手前与关闭完成后为0
+         */
+        unsigned int GetSession() const;
+
+        /**
+         * 获取等待发送与等待确认的报文段数
+         * @return 报文段数, 未连接时为0
+         */
+        size_t WriteQueueSize() const;
+
+        /**
+         * 获取连接状态
+         * @param stats 输出状态
+         * @return 是否已连接
+         */
+        bool GetStats(UdpStats &stats) const;
+
+    protected:
+        void AddressResolved(int status, const std::vector<ResolvedAddress> &addresses);
+
+        /**
+         * 连接或握手失败
+         * @param status 失败错误码
+         */
+        void ConnectFail(int status);
+
+        /**
+         * 立即关闭连接
+         * @param err 错误码
+         */
+        void Close(int err);
+
+        /**
+         * 已写入的数据全部确认后关闭
+         */
+        void Check();
+
+        /**
+         * 发出缓存的报文, 发送出错时关闭连接
+         */
+        void Flush();
+
+        /**
+         * 句柄关闭完成
+         */
+        void Done();
+
+        void IKcpOutput(const char *buf, unsigned int size) override;
+
+        void IKcpReceive(const char *buf, unsigned int size) override;
+
+        void IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) override;
+
+    protected:
+        static void UvAllocCallback(uv_handle_t *handle, size_t suggested, uv_buf_t *buf);
+
+        static void UvRecvCallback(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr,
+                                   unsigned flags);
+
+        static void UvTimerCallback(uv_timer_t *handle);
+
+        static void UvPrepareCallback(uv_prepare_t *handle);
+
+        static void UvCloseCallback(uv_handle_t *handle);
+
+    private:
+        Status _status;
+        // 关闭前的状态, 决定是否触发断开回调
+        bool _connected;
+        // 等待已写入的数据确认后关闭
+        bool _shutdown;
+        bool _dirty;
+        StreamHandle *_handle;
+        ClientImplement *_implement;
+        Kcp *_kcp;
+        // 等待关闭完成的句柄数
+        unsigned int _pending;
+        uint32_t _connectTime;
+        uint32_t _lastRecv;
+        uint32_t _lastAsk;
+        UdpOptions _options;
+        uv_timer_t _timer;
+        uv_prepare_t _prepare;
+        UdpBatch _batch;
+        std::vector<char> _recvBuf;
+        Utils::HostAddress _hostAddress;
+    };
+}
+
+#endif //LCC_UDP_CLIENT_H
@@ -0,0 +1,190 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_UDP_SERVER_H
+#define LCC_UDP_SERVER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "utils/Address.h"
+#include "network/Interface.h"
+#include "network/Resolver.h"
+#include "network/UdpBatch.h"
+
+namespace Lcc {
+    /**
+     * 可靠UDP服务端, 监听udp://地址, 与TcpServer使用相同的ServerImplement回调
+     * 所有会话共用一个套接字, 按会话号与对端地址区分; 客户端以窗口询问报文握手
+     * 接收按批(recvmmsg), 一轮事件循环中产生的确认与数据合并后批量发出
+     * IServerInit按UDP初始化句柄; 消息按条收发, 不经过协议插件
+     */
+    class UdpServer : public ResolveImplement {
+        enum class Status {
+            None,
+            Address,
+            Listened,
+            ListenFail,
+            Closing,
+        };
+
+        class Session;
+
+        // 一次recvmmsg最多接收的报文数
+        static constexpr unsigned int kRecvBatch = 16;
+
+    public:
+        explicit UdpServer(ServerImplement *impl);
+
+        ~UdpServer() override;
+
+        /**
+         * 设置参数, 需在Listen前设置
+         * @param options 参数
+         */
+        void SetOptions(const UdpOptions &options);
+
+        /**
+         * 启动监听
+         * @param host 监听地址, 如udp://0.0.0.0:7000
+         */
+        void Listen(const char *host);
+
+        /**
+         * 关闭监听, 所有会话立即关闭, 未确认的数据不再重传
+         */
+        void Shutdown();
+
+        /**
+         * 关闭所有会话, 已写入的数据全部确认后关闭
+         */
+        void ShutdownAllSessions();
+
+        /**
+         * 关闭指定会话, 已写入的数据全部确认后关闭
+         * @param session 会话id
+         */
+        void ShutdownSession(unsigned int session);
+
+        /**
+         * 获取监听地址信息, 端口为0时监听成功后为实际端口
+         * @return 地址信息
+         */
+        const Utils::HostAddress &GetListenAddress() const;
+
+        /**
+         * 向会话写一条消息, 超过单条上限时关闭会话(UV_EMSGSIZE)
+         * @param session 会话id
+         * @param buf 数据
+         * @param size 数据长度
+         */
+        void SessionWrite(unsigned int session, const char *buf, unsigned int size);
+
+        /**
+         * 获取会话等待发送与等待确认的报文段数
+         * @param session 会话id
+         * @return 报文段数, 会话不存在时为0
+         */
+        size_t SessionWriteQueueSize(unsigned int session);
+
+        /**
+         * 获取会话的连接状态
+         * @param session 会话id
+         * @param stats 输出状态
+         * @return 会话是否存在
+         */
+        bool GetSessionStats(unsigned int session, UdpStats &stats);
+
+        /**
+         * 获取批量发送的统计
+         * @return 批量发送
+         */
+        const UdpBatch &GetBatch() const;
+
+    protected:
+        void AddressResolved(int status, const std::vector<ResolvedAddress> &addresses);
+
+        /**
+         * 监听失败
+         * @param status 失败错误码
+         */
+        void ListenFail(int status);
+
+        /**
+         * 处理收到的一个报文
+         * @param buf 报文
+         * @param size 报文长度
+         * @param addr 对端地址
+         */
+        void Dispatch(const char *buf, unsigned int size, const sockaddr *addr);
+
+        /**
+         * 查询可写的会话
+         * @param session 会话id
+         * @return 会话, 不存在或正在关闭时为nullptr
+         */
+        Session *GetOpenSession(unsigned int session);
+
+        /**
+         * 会话有待发送的数据, 在本轮事件循环结束前刷新
+         * @param session 会话
+         */
+        void MarkDirty(Session *session);
+
+        /**
+         * 会话关闭, 从id表移除, 保留在地址表中一段时间用于回复关闭报文
+         * @param session 会话
+         */
+        void SessionClosed(Session *session);
+
+        /**
+         * 通知已关闭的会话
+         */
+        void ReportClosed();
+
+        /**
+         * 句柄关闭完成
+         */
+        void Done();
+
+        void IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) override;
+
+    protected:
+        static void UvAllocCallback(uv_handle_t *handle, size_t suggested, uv_buf_t *buf);
+
+        static void UvRecvCallback(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr,
+                                   unsigned flags);
+
+        static void UvTimerCallback(uv_timer_t *handle);
+
+        static void UvPrepareCallback(uv_prepare_t *handle);
+
+        static void UvCloseCallback(uv_handle_t *handle);
+
+    private:
+        Status _status;
+        StreamHandle *_handle;
+        unsigned int _isession;
+        // 等待关闭完成的句柄数
+        unsigned int _pending;
+        ServerImplement *_implement;
+        UdpOptions _options;
+        std::string _errdesc;
+        Utils::HostAddress _hostAddress;
+        ResolvedAddress _address;
+        uv_timer_t _timer;
+        uv_prepare_t _prepare;
+        UdpBatch _batch;
+        std::vector<char> _recvBuf;
+        // 会话号与对端地址 -> 会话, 包含关闭后暂留的会话
+        std::unordered_map<std::string, Session *> _addressMap;
+        // 会话id -> 未关闭的会话
+        std::unordered_map<unsigned int, Session *> _sessionMap;
+        std::vector<Session *> _dirtyVec;
+        // 已关闭, 等待通知IServerSessionAfterClose的会话id
+        std::vector<unsigned int> _closedVec;
+    };
+}
+
+#endif //LCC_UDP_SERVER_H
@@ -0,0 +1,206 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_FRAMINGLAYER_H
+#define LCC_FRAMINGLAYER_H
+
+#include <string>
+#include <algorithm>
+#include "libuv/uv.h"
+#include "trace/Trace.h"
+
+namespace Lcc {
+    // 帧长度头格式
+    enum class FrameHeader {
+        // 变长整数(每字节7位, 小端在前, 最多5字节)
+        Varint,
+        // 2字节大端
+        Fixed16,
+        // 4字节大端
+        Fixed32,
+    };
+
+    /**
+     * 长度前缀分帧层: 收到的数据按帧交给上层, 写入的数据自动添加长度头
+     * 完整落在一次读取内的帧直接指向读缓冲区交出, 只有跨读取的残帧才会缓存
+     */
+    class FramingLayer {
+    public:
+        struct Config {
+            FrameHeader header;
+            // 单帧最大长度(不含长度头), 超出时关闭连接
+            unsigned int maxSize;
+        };
+
+    public:
+        static const unsigned int kMaxHeadSize = 5;
+
+    public:
+        explicit FramingLayer(const Config &config);
+
+        /**
+         * 编码长度头
+         * @param header 长度头格式
+         * @param size 帧长度
+         * @param out 输出缓冲区, 至少kMaxHeadSize字节
+         * @return 长度头字节数
+         */
+        static unsigned int EncodeHead(FrameHeader header, unsigned int size, char *out);
+
+        /**
+         * 解码长度头
+         * @param header 长度头格式
+         * @param buf 数据
+         * @param size 数据长度
+         * @param body 输出帧长度
+         * @return 长度头字节数, 数据不足返回0, 格式错误返回负数
+         */
+        static int DecodeHead(FrameHeader header, const char *buf, unsigned int size, unsigned int &body);
+
+        bool Init();
+
+        int LastError() const;
+
+        const char *LastErrDesc() const;
+
+        /**
+         * 获取直接从读缓冲区交出的帧数量
+         * @return 帧数量
+         */
+        unsigned long long DirectFrames() const;
+
+        /**
+         * 获取经过缓存拼接后交出的帧数量
+         * @return 帧数量
+         */
+        unsigned long long BufferedFrames() const;
+
+        template<typename Port>
+        bool Open(Port &port) {
+            port.Open();
+            return true;
+        }
+
+        template<typename Port>
+        bool Read(Port &port, const char *buf, unsigned int size) {
+            while (size > 0 && !_closed) {
+                if (_pending.empty()) {
+                    unsigned int body = 0;
+                    const int head = DecodeHead(_header, buf, size, body);
+                    if (head < 0 || body > _maxSize) {
+                        Fail(port, UV_E2BIG, head < 0 ? "frame header malformed" : "frame too large");
+                        return false;
+                    }
+                    if (head > 0 && size - head >= body) {
+                        // 完整帧直接交出, 不经过缓存
+                        ++_direct;
+                        LCC_TRACE_POINT(FrameRead, body);
+                        port.Read(buf + head, body);
+                        buf += head + body;
+                        size -= head + body;
+                        continue;
+                    }
+                    Hold(head, body, buf, size);
+                    return true;
+                }
+                if (_need == 0) {
+                    // 长度头跨读取时逐字节补齐, 最多kMaxHeadSize字节
+                    _pending.push_back(*buf++);
+                    --size;
+                    const int head = CompleteHead();
+                    if (head < 0) {
+                        Fail(port, UV_E2BIG, _errorstr);
+                        return false;
+                    }
+                    if (head == 0) {
+                        continue;
+                    }
+                } else {
+                    const unsigned int take = std::min(size, _need - static_cast<unsigned int>(_pending.size()));
+                    _pending.append(buf, take);
+                    buf += take;
+                    size -= take;
+                }
+                if (_pending.size() == _need) {
+                    ++_buffered;
+                    // 交出期间可能再次进入读取, 先取出缓存
+                    std::string frame;
+                    frame.swap(_pending);
+                    _need = 0;
+                    LCC_TRACE_POINT(FrameRead, frame.size() - _head);
+                    port.Read(frame.data() + _head, static_cast<unsigned int>(frame.size()) - _head);
+                    Recycle(frame);
+                }
+            }
+            return true;
+        }
+
+        template<typename Port>
+        void Write(Port &port, const char *buf, unsigned int size) {
+            if (size > _maxSize) {
+                Fail(port, UV_E2BIG, "frame too large");
+                return;
+            }
+            // 长度头与数据合并为一次写入, 输出缓存容量复用
+            char head[kMaxHeadSize];
+            const unsigned int headSize = EncodeHead(_header, size, head);
+            _output.assign(head, headSize);
+            _output.append(buf, size);
+            LCC_TRACE_POINT(FrameWrite, _output.size());
+            port.Write(_output.data(), static_cast<unsigned int>(_output.size()));
+        }
+
+        template<typename Port>
+        void Close(Port &port) {
+            _closed = true;
+            port.Close();
+        }
+
+    private:
+        template<typename Port>
+        void Fail(Port &port, int err, const std::string &desc) {
+            _error = err;
+            _errorstr = desc;
+            _closed = true;
+            port.Close();
+        }
+
+        /**
+         * 缓存残帧
+         * @param head 已解出的长度头字节数, 0表示长度头不完整
+         * @param body 帧长度
+         * @param buf 残帧数据
+         * @param size 残帧长度
+         */
+        void Hold(int head, unsigned int body, const char *buf, unsigned int size);
+
+        /**
+         * 尝试从缓存中解出长度头
+         * @return 长度头字节数, 数据不足返回0, 格式错误或超长返回负数(错误描述写入_errorstr)
+         */
+        int CompleteHead();
+
+        /**
+         * 交出后回收缓存容量
+         * @param frame 已交出的帧缓存
+         */
+        void Recycle(std::string &frame);
+
+    private:
+        int _error;
+        bool _closed;
+        FrameHeader _header;
+        unsigned int _maxSize;
+        // 残帧完整长度(含长度头), 0表示长度头尚不完整
+        unsigned int _need;
+        unsigned int _head;
+        unsigned long long _direct;
+        unsigned long long _buffered;
+        std::string _errorstr;
+        std::string _pending;
+        std::string _output;
+    };
+}
+
+#endif //LCC_FRAMINGLAYER_H
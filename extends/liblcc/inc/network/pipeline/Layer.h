@@ -0,0 +1,114 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_LAYER_H
+#define LCC_LAYER_H
+
+#include "network/ProtocolPlugin.h"
+
+namespace Lcc {
+    /**
+     * 协议层约定: 层不感知自己处于动态插件链还是编译期流水线, 所有出口都经由调用时传入的端口Port
+     *   template<typename Port> bool Open(Port &port);                         下层已启动
+     *   template<typename Port> bool Read(Port &port, const char *, unsigned);  收到下层数据
+     *   template<typename Port> void Write(Port &port, const char *, unsigned); 上层写入数据
+     *   template<typename Port> void Close(Port &port);                         上层请求关闭
+     *   bool Init(); int LastError(); const char *LastErrDesc();
+     * 端口提供Read/Open(交给上层)与Write/Close(交给下层), 并以Owner *owner标识所属宿主
+     * 每个层提供Config结构与以Config构造的构造函数
+     */
+
+    /**
+     * 动态插件链端口: 出口经由ProtocolImplement按插件等级转发
+     */
+    struct PluginPort {
+        typedef ProtocolPlugin Owner;
+
+        Owner *owner;
+
+        explicit PluginPort(Owner *plugin) : owner(plugin) {
+        }
+
+        void Open() {
+            owner->GetImpl()->IProtocolOpen(owner->GetLevel());
+        }
+
+        void Read(const char *buf, unsigned int size) {
+            owner->GetImpl()->IProtocolRead(owner->GetLevel(), buf, size);
+        }
+
+        void Write(const char *buf, unsigned int size) {
+            owner->GetImpl()->IProtocolWrite(owner->GetLevel(), buf, size);
+        }
+
+        void Close() {
+            owner->GetImpl()->IProtocolClose(owner->GetLevel());
+        }
+    };
+
+    /**
+     * 端口的类型擦除形式, 供内部通过回调驱动的协议引擎(WebSocket、mbedtls)在回调中找回端口
+     * 每次进入层时重新绑定, 只保存宿主指针与静态跳板函数
+     */
+    class LayerLink {
+    public:
+        LayerLink() : _owner(nullptr), _open(nullptr), _read(nullptr), _write(nullptr), _close(nullptr) {
+        }
+
+        template<typename Port>
+        void Bind(Port &port) {
+            _owner = port.owner;
+            _open = &LayerLink::OpenThunk<Port>;
+            _read = &LayerLink::ReadThunk<Port>;
+            _write = &LayerLink::WriteThunk<Port>;
+            _close = &LayerLink::CloseThunk<Port>;
+        }
+
+        void Open() {
+            _open(_owner);
+        }
+
+        void Read(const char *buf, unsigned int size) {
+            _read(_owner, buf, size);
+        }
+
+        void Write(const char *buf, unsigned int size) {
+            _write(_owner, buf, size);
+        }
+
+        void Close() {
+            _close(_owner);
+        }
+
+    private:
+        template<typename Port>
+        static void OpenThunk(void *owner) {
+            Port(static_cast<typename Port::Owner *>(owner)).Open();
+        }
+
+        template<typename Port>
+        static void ReadThunk(void *owner, const char *buf, unsigned int size) {
+            Port(static_cast<typename Port::Owner *>(owner)).Read(buf, size);
+        }
+
+        template<typename Port>
+        static void WriteThunk(void *owner, const char *buf, unsigned int size) {
+            Port(static_cast<typename Port::Owner *>(owner)).Write(buf, size);
+        }
+
+        template<typename Port>
+        static void CloseThunk(void *owner) {
+            Port(static_cast<typename Port::Owner *>(owner)).Close();
+        }
+
+    private:
+        void *_owner;
+        void (*_open)(void *owner);
+        void (*_read)(void *owner, const char *buf, unsigned int size);
+        void (*_write)(void *owner, const char *buf, unsigned int size);
+        void (*_close)(void *owner);
+    };
+}
+
+#endif //LCC_LAYER_H
@@ -0,0 +1,259 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_PIPELINE_H
+#define LCC_PIPELINE_H
+
+#include <tuple>
+#include <type_traits>
+#include "network/pipeline/Layer.h"
+
+namespace Lcc {
+    template<size_t... I>
+    struct PipelineIndex {
+    };
+
+    template<size_t N, size_t... I>
+    struct MakePipelineIndex : MakePipelineIndex<N - 1, N - 1, I...> {
+    };
+
+    template<size_t... I>
+    struct MakePipelineIndex<0, I...> {
+        typedef PipelineIndex<I...> type;
+    };
+
+    /**
+     * 编译期组合的协议流水线, 按从下到上的顺序列出协议层, 例如Pipeline<TlsLayer, WebSocketLayer, FramingLayer>
+     * 整条流水线作为一个应用层插件挂到流上: 层与层之间的跳转在编译期确定并可内联,
+     * 不再经过每次转发时的插件等级查找与虚函数调用, 只有流水线两端与流交互
+     * 动态插件(FramePlugin/WebSocketPlugin/MbedTLSPlugin)复用同样的协议层, 仍可作为运行时组合的方式使用
+     * 与原插件实现的对照见bench/micro/PipelineBench.cpp, 在-O2/-O3下单条消息的耗时差异未超出测量误差
+     * @tparam Layers 协议层, 约定见network/pipeline/Layer.h
+     */
+    template<typename... Layers>
+    class Pipeline : public ProtocolPlugin {
+    public:
+        static const size_t kLayers = sizeof...(Layers);
+        typedef std::tuple<Layers...> LayerTuple;
+
+        /**
+         * 第I层的端口, Read/Open交给第I+1层, Write/Close交给第I-1层, 越过两端时交给流
+         */
+        template<size_t I>
+        struct Port {
+            typedef Pipeline Owner;
+
+            Owner *owner;
+
+            explicit Port(Owner *pipeline) : owner(pipeline) {
+            }
+
+            void Open() {
+                owner->template OpenAt<I + 1>();
+            }
+
+            void Read(const char *buf, unsigned int size) {
+                owner->template ReadAt<I + 1>(buf, size);
+            }
+
+            void Write(const char *buf, unsigned int size) {
+                owner->template WriteAt<I>(buf, size);
+            }
+
+            void Close() {
+                owner->template CloseAt<I>();
+            }
+        };
+
+    public:
+        Pipeline(ProtocolImplement *impl, const typename Layers::Config &... configs) : ProtocolPlugin(
+                ProtocolLevel::Application, impl),
+            _failed(false),
+            _layers(configs...) {
+        }
+
+        ~Pipeline() override = default;
+
+        /**
+         * 依次初始化各层
+         * @return 是否全部初始化成功
+         */
+        bool Init() {
+            return InitAt<0>();
+        }
+
+        /**
+         * 获取第I层
+         * @return 协议层
+         */
+        template<size_t I>
+        typename std::tuple_element<I, LayerTuple>::type &GetLayer() {
+            return std::get<I>(_layers);
+        }
+
+    protected:
+        int IProtocolLastError() override {
+            return ErrorAt<0>();
+        }
+
+        const char *IProtocolLastErrDesc() override {
+            return DescAt<0>();
+        }
+
+        bool IProtocolPluginOpen() override {
+            _failed = false;
+            OpenAt<0>();
+            return !_failed;
+        }
+
+        bool IProtocolPluginRead(const char *buf, unsigned int size) override {
+            _failed = false;
+            ReadAt<0>(buf, size);
+            return !_failed;
+        }
+
+        void IProtocolPluginWrite(const char *buf, unsigned int size) override {
+            WriteAt<kLayers>(buf, size);
+        }
+
+        void IProtocolPluginClose() override {
+            CloseAt<kLayers>();
+        }
+
+        void IProtocolPluginRelease() override {
+            delete this;
+        }
+
+    private:
+        template<size_t I>
+        typename std::enable_if<(I < kLayers)>::type OpenAt() {
+            Port<I> port(this);
+            if (!std::get<I>(_layers).Open(port)) {
+                _failed = true;
+            }
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I == kLayers)>::type OpenAt() {
+            _impl->IProtocolOpen(_level);
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I < kLayers)>::type ReadAt(const char *buf, unsigned int size) {
+            Port<I> port(this);
+            if (!std::get<I>(_layers).Read(port, buf, size)) {
+                _failed = true;
+            }
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I == kLayers)>::type ReadAt(const char *buf, unsigned int size) {
+            _impl->IProtocolRead(_level, buf, size);
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I > 0)>::type WriteAt(const char *buf, unsigned int size) {
+            Port<I - 1> port(this);
+            std::get<I - 1>(_layers).Write(port, buf, size);
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I == 0)>::type WriteAt(const char *buf, unsigned int size) {
+            _impl->IProtocolWrite(_level, buf, size);
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I > 0)>::type CloseAt() {
+            Port<I - 1> port(this);
+            std::get<I - 1>(_layers).Close(port);
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I == 0)>::type CloseAt() {
+            _impl->IProtocolClose(_level);
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I < kLayers), bool>::type InitAt() {
+            return std::get<I>(_layers).Init() && InitAt<I + 1>();
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I == kLayers), bool>::type InitAt() {
+            return true;
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I < kLayers), int>::type ErrorAt() {
+            const int err = std::get<I>(_layers).LastError();
+            return err ? err : ErrorAt<I + 1>();
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I == kLayers), int>::type ErrorAt() {
+            return 0;
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I < kLayers), const char *>::type DescAt() {
+            auto &layer = std::get<I>(_layers);
+            return layer.LastError() ? layer.LastErrDesc() : DescAt<I + 1>();
+        }
+
+        template<size_t I>
+        typename std::enable_if<(I == kLayers), const char *>::type DescAt() {
+            return "";
+        }
+
+    private:
+        bool _failed;
+        LayerTuple _layers;
+    };
+
+    template<typename... Layers>
+    class PipelineCreator : public ProtocolPluginCreator {
+    public:
+        PipelineCreator() : _init(false) {
+        }
+
+        /**
+         * 初始化
+         * @param configs 各层配置, 顺序与协议层一致
+         */
+        void Initialize(const typename Layers::Config &... configs) {
+            _configs = std::tuple<typename Layers::Config...>(configs...);
+            _init = true;
+        }
+
+    protected:
+        bool ICreatorInit() override {
+            return _init;
+        }
+
+        void ICreatorRelease() override {
+            delete this;
+        }
+
+        ProtocolPlugin *ICreatorAlloc(ProtocolImplement *impl) override {
+            return Alloc(impl, typename MakePipelineIndex<sizeof...(Layers)>::type());
+        }
+
+    private:
+        template<size_t... I>
+        ProtocolPlugin *Alloc(ProtocolImplement *impl, PipelineIndex<I...>) {
+            auto pipeline = new Pipeline<Layers...>(impl, std::get<I>(_configs)...);
+            if (!pipeline->Init()) {
+                delete pipeline;
+                return nullptr;
+            }
+            return pipeline;
+        }
+
+    private:
+        bool _init;
+        std::tuple<typename Layers::Config...> _configs;
+    };
+}
+
+#endif //LCC_PIPELINE_H
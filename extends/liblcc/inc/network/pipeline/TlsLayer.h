@@ -0,0 +1,105 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_TLSLAYER_H
+#define LCC_TLSLAYER_H
+
+#include <string>
+#include "buffer/Bio.h"
+#include "network/pipeline/Layer.h"
+#include "network/protocol/MbedTLS.h"
+
+namespace Lcc {
+    /**
+     * TLS层: 握手完成后向上层报告启动, 收发数据经mbedtls加解密
+     * mbedtls通过bio回调输出数据, 层在每次进入时绑定端口供回调使用
+     */
+    class TlsLayer {
+    public:
+        struct Config {
+            // 服务端证书, 非空时为服务端模式, 需要在所有会话关闭前保持有效
+            const Protocol::MbedTLS *server;
+            // 客户端模式的远端地址
+            std::string hostname;
+            // 客户端模式的根证书路径(可选)
+            std::string caroot;
+        };
+
+    public:
+        explicit TlsLayer(const Config &config);
+
+        ~TlsLayer();
+
+        /**
+         * 按配置初始化会话证书
+         * @return 是否初始化成功
+         */
+        bool Init();
+
+        Protocol::MbedTLS &GetMbedTLS();
+
+        int LastError() const;
+
+        const char *LastErrDesc();
+
+        template<typename Port>
+        bool Open(Port &port) {
+            _link.Bind(port);
+            return LinkOpen();
+        }
+
+        template<typename Port>
+        bool Read(Port &port, const char *buf, unsigned int size) {
+            _link.Bind(port);
+            return LinkRead(buf, size);
+        }
+
+        template<typename Port>
+        void Write(Port &port, const char *buf, unsigned int size) {
+            _link.Bind(port);
+            LinkWrite(buf, size);
+        }
+
+        template<typename Port>
+        void Close(Port &port) {
+            _link.Bind(port);
+            LinkClose();
+        }
+
+    protected:
+        bool LinkOpen();
+
+        bool LinkRead(const char *buf, unsigned int size);
+
+        void LinkWrite(const char *buf, unsigned int size);
+
+        void LinkClose();
+
+        bool Handshake();
+
+        void WantFlush();
+
+    protected:
+        static int MbedTLSRecvCallback(void *ctx, unsigned char *buf, size_t size);
+
+        static int MbedTLSSendCallback(void *ctx, const unsigned char *buf, size_t size);
+
+    private:
+        // 已关闭, mbedtls上下文已释放
+        bool _closed;
+        int _error;
+        uint64_t _handshakeStart;
+        const Protocol::MbedTLS *_server;
+        std::string _hostname;
+        std::string _caroot;
+        std::string _buffer;
+        std::string _errorstr;
+        BufferBio _bufferIn;
+        BufferBio _bufferOut;
+        Protocol::MbedTLS _mbedtls;
+        LayerLink _link;
+    };
+}
+
+#endif //LCC_TLSLAYER_H
@@ -0,0 +1,107 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_WEBSOCKETLAYER_H
+#define LCC_WEBSOCKETLAYER_H
+
+#include <string>
+#include "network/pipeline/Layer.h"
+#include "network/protocol/WebSocket.h"
+
+namespace Lcc {
+    /**
+     * WebSocket层: 完成握手后按帧收发, 启用的操作码以外的数据帧关闭连接
+     * 协议引擎通过回调输出数据, 层在每次进入时绑定端口供回调使用
+     */
+    class WebSocketLayer : public WebSocketImplement {
+    public:
+        struct Config {
+            // 启用的操作码
+            WebSocketOpcode opcode;
+            // 远端地址, 为空时为服务端模式
+            std::string hostname;
+        };
+
+    public:
+        explicit WebSocketLayer(const Config &config);
+
+        ~WebSocketLayer() override;
+
+        /**
+         * 按配置初始化服务端或客户端模式
+         * @return 是否初始化成功
+         */
+        bool Init();
+
+        /**
+         * 初始化服务端模式
+         */
+        void InitializeServerMode();
+
+        /**
+         * 初始化客户端模式
+         * @param host 远端地址
+         */
+        void InitializeClientMode(const char *host);
+
+        int LastError() const;
+
+        const char *LastErrDesc() const;
+
+        template<typename Port>
+        bool Open(Port &port) {
+            _link.Bind(port);
+            return LinkOpen();
+        }
+
+        template<typename Port>
+        bool Read(Port &port, const char *buf, unsigned int size) {
+            _link.Bind(port);
+            return LinkRead(buf, size);
+        }
+
+        template<typename Port>
+        void Write(Port &port, const char *buf, unsigned int size) {
+            _link.Bind(port);
+            _protocol.Write(buf, size);
+        }
+
+        template<typename Port>
+        void Close(Port &port) {
+            _link.Bind(port);
+            ImplementClose(WebSocketCode::Normal);
+        }
+
+    protected:
+        bool LinkOpen();
+
+        bool LinkRead(const char *buf, unsigned int size);
+
+        /**
+         * 关闭
+         * @param code 原因
+         */
+        void ImplementClose(WebSocketCode code);
+
+    protected:
+        void IWebSocketInit(WebSocketMode &mode) override;
+
+        void IWebSocketReceive(WebSocketFrameHeader &header, const char *buf, unsigned int size) override;
+
+        void IWebSocketWrite(const char *buf, unsigned int size) override;
+
+    private:
+        int _error;
+        bool _handshaked;
+        uint64_t _handshakeStart;
+        std::string _errorstr;
+        std::string _hostname;
+        std::string _serverKey;
+        WebSocketOpcode _opcode;
+        WebSocketProtocol _protocol;
+        LayerLink _link;
+    };
+}
+
+#endif //LCC_WEBSOCKETLAYER_H
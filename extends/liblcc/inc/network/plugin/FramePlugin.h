@@ -0,0 +1,100 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_FRAMEPLUGIN_H
+#define LCC_FRAMEPLUGIN_H
+
+#include "network/pipeline/Layer.h"
+#include "network/pipeline/FramingLayer.h"
+
+namespace Lcc {
+    /**
+     * 长度前缀分帧插件, 位于应用层: 收到的数据按帧回调, 写入的数据自动添加长度头
+     * 分帧逻辑由FramingLayer实现, 与编译期流水线Pipeline共用
+     */
+    class FramePlugin : public ProtocolPlugin {
+    public:
+        FramePlugin(FrameHeader header, unsigned int maxSize, ProtocolImplement *impl);
+
+        ~FramePlugin() override;
+
+        /**
+         * 编码长度头
+         * @param header 长度头格式
+         * @param size 帧长度
+         * @param out 输出缓冲区, 至少kMaxHeadSize字节
+         * @return 长度头字节数
+         */
+        static unsigned int EncodeHead(FrameHeader header, unsigned int size, char *out);
+
+        /**
+         * 解码长度头
+         * @param header 长度头格式
+         * @param buf 数据
+         * @param size 数据长度
+         * @param body 输出帧长度
+         * @return 长度头字节数, 数据不足返回0, 格式错误返回负数
+         */
+        static int DecodeHead(FrameHeader header, const char *buf, unsigned int size, unsigned int &body);
+
+        /**
+         * 获取直接从读缓冲区回调的帧数量
+         * @return 帧数量
+         */
+        unsigned long long DirectFrames() const;
+
+        /**
+         * 获取经过缓存拼接后回调的帧数量
+         * @return 帧数量
+         */
+        unsigned long long BufferedFrames() const;
+
+    public:
+        static const unsigned int kMaxHeadSize = FramingLayer::kMaxHeadSize;
+
+    protected:
+        int IProtocolLastError() override;
+
+        const char *IProtocolLastErrDesc() override;
+
+        bool IProtocolPluginOpen() override;
+
+        bool IProtocolPluginRead(const char *buf, unsigned int size) override;
+
+        void IProtocolPluginWrite(const char *buf, unsigned int size) override;
+
+        void IProtocolPluginClose() override;
+
+        void IProtocolPluginRelease() override;
+
+    private:
+        FramingLayer _layer;
+    };
+
+    class FramePluginCreator : public ProtocolPluginCreator {
+    public:
+        FramePluginCreator();
+
+        /**
+         * 初始化
+         * @param header 长度头格式
+         * @param maxSize 单帧最大长度(不含长度头), 超出时关闭连接
+         */
+        void Initialize(FrameHeader header, unsigned int maxSize);
+
+    protected:
+        bool ICreatorInit() override;
+
+        void ICreatorRelease() override;
+
+        ProtocolPlugin *ICreatorAlloc(ProtocolImplement *impl) override;
+
+    private:
+        bool _init;
+        FrameHeader _header;
+        unsigned int _maxSize;
+    };
+}
+
+#endif //LCC_FRAMEPLUGIN_H
@@ -6,11 +6,12 @@
 #define LCC_MBEDTLSPLUGIN_H
 
 #include <string>
-#include <buffer/Bio.h>
-#include <network/ProtocolPlugin.h>
-#include <network/protocol/MbedTLS.h>
+#include <network/pipeline/TlsLayer.h>
 
 namespace Lcc {
+    /**
+     * TLS插件, 协议逻辑由TlsLayer实现, 与编译期流水线Pipeline共用
+     */
     class MbedTLSPlugin : public ProtocolPlugin {
     public:
         explicit MbedTLSPlugin(ProtocolImplement *impl);
@@ -34,30 +35,8 @@ namespace Lcc {
 
         void IProtocolPluginRelease() override;
 
-    protected:
-        bool Handshake();
-
-        void WantFlush();
-
-    protected:
-        void ImplementOpen();
-
-        void ImplementClose();
-
-        void ImplementReceive(const char *buf, unsigned int size);
-
-    protected:
-        static int MbedTLSRecvCallback(void *ctx, unsigned char *buf, size_t size);
-
-        static int MbedTLSSendCallback(void *ctx, const unsigned char *buf, size_t size);
-
     private:
-        int _error;
-        std::string _buffer;
-        std::string _errorstr;
-        BufferBio _bufferIn;
-        BufferBio _bufferOut;
-        Protocol::MbedTLS _mbedtls;
+        TlsLayer _layer;
     };
 
     class MbedTLSPluginCreator : public ProtocolPluginCreator {
@@ -66,6 +45,14 @@ namespace Lcc {
 
         ~MbedTLSPluginCreator() override;
 
+        /**
+         * 设置最高协商版本, 需在Initialize*Mode前调用
+         * 内置的mbedtls未启用MBEDTLS_THREADING_C且只有32个PSA密钥槽, TLS1.3连接在整个生命周期占用PSA密钥,
+         * 需要大量并发TLS连接时可限制为MBEDTLS_SSL_VERSION_TLS1_2
+         * @param version 最高版本, 默认使用mbedtls默认值
+         */
+        void SetMaxVersion(mbedtls_ssl_protocol_version version);
+
         bool InitializeClientMode(const char *host, const char *caroot);
 
         bool InitializeServerMode(const char *cert, const char *key, const char *password);
@@ -79,6 +66,7 @@ namespace Lcc {
 
     private:
         bool _init;
+        mbedtls_ssl_protocol_version _maxVersion;
         std::string _host;
         std::string _caroot;
         Protocol::MbedTLS *_mbedtls;
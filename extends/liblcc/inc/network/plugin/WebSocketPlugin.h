@@ -6,11 +6,13 @@
 #define LCC_WEBSOCKETPLUGIN_H
 
 #include <string>
-#include "network/ProtocolPlugin.h"
-#include "network/protocol/WebSocket.h"
+#include "network/pipeline/WebSocketLayer.h"
 
 namespace Lcc {
-    class WebSocketPlugin : public ProtocolPlugin, public WebSocketImplement {
+    /**
+     * WebSocket插件, 协议逻辑由WebSocketLayer实现, 与编译期流水线Pipeline共用
+     */
+    class WebSocketPlugin : public ProtocolPlugin {
     public:
         explicit WebSocketPlugin(ProtocolImplement *impl);
 
@@ -29,13 +31,6 @@ namespace Lcc {
          */
         void InitializeClientMode(const char *host);
 
-    protected:
-        /**
-         * 关闭
-         * @param code 原因
-         */
-        void ImplementClose(WebSocketCode code);
-
     protected:
         int IProtocolLastError() override;
 
@@ -51,21 +46,8 @@ namespace Lcc {
 
         void IProtocolPluginRelease() override;
 
-    protected:
-        void IWebSocketInit(WebSocketMode &mode) override;
-
-        void IWebSocketReceive(WebSocketFrameHeader &header, const char *buf, unsigned int size) override;
-
-        void IWebSocketWrite(const char *buf, unsigned int size) override;
-
     private:
-        int _error;
-        bool _handshaked;
-        std::string _errorstr;
-        std::string _hostname;
-        std::string _serverKey;
-        WebSocketOpcode _opcode;
-        WebSocketProtocol _protocol;
+        WebSocketLayer _layer;
     };
 
     class WebSocketPluginCreator : public ProtocolPluginCreator {
@@ -0,0 +1,253 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_KCP_H
+#define LCC_KCP_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace Lcc {
+    // 报文命令
+    enum class KcpCommand : unsigned char {
+        // 数据
+        Push = 81,
+        // 确认
+        Ack = 82,
+        // 询问对端接收窗口, 同时用于握手与保活
+        WindowAsk = 83,
+        // 告知本端接收窗口
+        WindowTell = 84,
+        // 关闭会话, 不保证送达
+        Fin = 85,
+    };
+
+    struct KcpOptions {
+        // 单个UDP报文的最大长度
+        unsigned int mtu;
+        // 发送窗口(报文段数)
+        unsigned int sendWindow;
+        // 接收窗口(报文段数)
+        unsigned int recvWindow;
+        // 定时刷新间隔(毫秒)
+        unsigned int interval;
+        // 最小重传超时(毫秒)
+        unsigned int minRto;
+        // 被跳过几次确认后快速重传, 0为关闭
+        unsigned int fastResend;
+        // 同一报文段发送几次仍未确认视为链路断开
+        unsigned int deadLink;
+        // 超时重传时RTO按1.5倍而不是2倍增长
+        bool nodelay;
+
+        KcpOptions();
+    };
+
+    class KcpImplement {
+    public:
+        virtual ~KcpImplement() = default;
+
+        /**
+         * 需要发送一个UDP报文时触发
+         * @param buf 报文
+         * @param size 报文长度
+         */
+        virtual void IKcpOutput(const char *buf, unsigned int size) = 0;
+
+        /**
+         * 按序收到一条完整消息时触发
+         * @param buf 消息
+         * @param size 消息长度
+         */
+        virtual void IKcpReceive(const char *buf, unsigned int size) = 0;
+    };
+
+    /**
+     * KCP风格的ARQ, 只处理报文, 不做IO
+     * 每个报文段单独确认(选择确认)并携带累计确认una, 被后续确认跳过fastResend次即快速重传,
+     * 超时重传按平滑RTT估计RTO; 发送受本端发送窗口与对端接收窗口限制
+     * 消息按mss拆成最多255个分片, 接收端按序重组后回调
+     * 报文头24字节, 小端: conv(4) cmd(1) frg(1) wnd(2) ts(4) sn(4) una(4) len(4)
+     */
+    class Kcp {
+        struct Segment {
+            uint32_t sn;
+            uint32_t ts;
+            unsigned char frg;
+            uint32_t resendTs;
+            uint32_t rto;
+            uint32_t fastAck;
+            uint32_t xmit;
+            std::string data;
+        };
+
+    public:
+        static constexpr unsigned int kHeaderSize = 24;
+        static constexpr unsigned int kMaxFragments = 255;
+
+    public:
+        Kcp(uint32_t conv, KcpImplement *impl);
+
+        virtual ~Kcp();
+
+        /**
+         * 从报文中读取会话号
+         * @param buf 报文
+         * @param size 报文长度
+         * @param conv 输出会话号
+         * @return 是否为合法长度的报文
+         */
+        static bool PeekConv(const char *buf, unsigned int size, uint32_t &conv);
+
+        /**
+         * 从报文中读取第一个报文段的命令
+         * @param buf 报文
+         * @param size 报文长度
+         * @param cmd 输出命令
+         * @return 是否为合法长度的报文
+         */
+        static bool PeekCommand(const char *buf, unsigned int size, KcpCommand &cmd);
+
+        /**
+         * 设置参数, 需在收发前设置
+         * @param options 参数
+         */
+        void SetOptions(const KcpOptions &options);
+
+        /**
+         * 获取会话号
+         * @return 会话号
+         */
+        uint32_t Conv() const;
+
+        /**
+         * 输入收到的UDP报文
+         * @param buf 报文
+         * @param size 报文长度
+         * @param current 当前时间(毫秒)
+         * @return 0为成功, 收到关闭时为UV_EOF, 报文非法时为UV_EPROTO
+         */
+        int Input(const char *buf, unsigned int size, uint32_t current);
+
+        /**
+         * 发送一条消息, 进入发送队列, 在下一次Flush时按窗口发出
+         * @param buf 消息
+         * @param size 消息长度
+         * @return 是否成功, 超过MaxMessageSize时失败
+         */
+        bool Send(const char *buf, unsigned int size);
+
+        /**
+         * 到达刷新间隔时刷新
+         * @param current 当前时间(毫秒)
+         */
+        void Update(uint32_t current);
+
+        /**
+         * 立即发出确认、窗口探测、新数据与到期的重传
+         * @param current 当前时间(毫秒)
+         */
+        void Flush(uint32_t current);
+
+        /**
+         * 在下一次Flush时询问对端窗口, 对端会回复窗口告知
+         */
+        void AskWindow();
+
+        /**
+         * 立即发出关闭报文
+         * @param current 当前时间(毫秒)
+         */
+        void SendFin(uint32_t current);
+
+        /**
+         * 获取等待发送与等待确认的报文段数
+         * @return 报文段数
+         */
+        size_t WaitSend() const;
+
+        /**
+         * 获取单条消息的最大长度
+         * @return 最大长度
+         */
+        unsigned int MaxMessageSize() const;
+
+        /**
+         * 是否有报文段重传次数达到deadLink
+         * @return 链路是否断开
+         */
+        bool IsDead() const;
+
+        /**
+         * 获取当前重传超时
+         * @return 毫秒
+         */
+        uint32_t Rto() const;
+
+        /**
+         * 获取累计重传次数(超时与快速重传)
+         * @return 次数
+         */
+        uint64_t Retransmits() const;
+
+    protected:
+        void UpdateAck(int32_t rtt);
+
+        void ParseUna(uint32_t una);
+
+        void ParseAck(uint32_t sn);
+
+        void ParseFastAck(uint32_t sn);
+
+        void ParseData(Segment &&segment);
+
+        /**
+         * 把接收缓冲区中连续的报文段移入接收队列, 并回调其中的完整消息
+         */
+        void Deliver();
+
+        /**
+         * 在输出缓冲区中追加一个报文头, 放不下时先发出
+         */
+        char *Append(KcpCommand cmd, unsigned char frg, uint32_t ts, uint32_t sn, unsigned int len);
+
+        void Output();
+
+        unsigned int WindowUnused() const;
+
+    private:
+        uint32_t _conv;
+        KcpImplement *_implement;
+        KcpOptions _options;
+        unsigned int _mss;
+        uint32_t _sndUna;
+        uint32_t _sndNxt;
+        uint32_t _rcvNxt;
+        uint32_t _rmtWnd;
+        int32_t _rxSrtt;
+        int32_t _rxRttval;
+        uint32_t _rxRto;
+        uint32_t _tsFlush;
+        bool _updated;
+        uint32_t _probe;
+        uint32_t _tsProbe;
+        uint32_t _probeWait;
+        bool _dead;
+        uint64_t _retransmits;
+        // 等待进入发送窗口的报文段与已发出待确认的报文段
+        std::deque<Segment> _sndQueue;
+        std::deque<Segment> _sndBuf;
+        // 乱序到达待补齐的报文段(按sn排序)与已按序待重组的报文段
+        std::deque<Segment> _rcvBuf;
+        std::deque<Segment> _rcvQueue;
+        // 待发送的确认: sn与对端发送时间
+        std::vector<std::pair<uint32_t, uint32_t>> _ackList;
+        std::string _buffer;
+        std::string _message;
+    };
+}
+
+#endif //LCC_KCP_H
@@ -78,18 +78,22 @@ namespace Lcc {
              * 初始化客户端证书信息
              * @param host 远端地址
              * @param caroot 根证书路径(可选)
+             * @param maxVersion 最高协商版本, MBEDTLS_SSL_VERSION_UNKNOWN表示使用mbedtls默认值
              * @return 是否初始化成功
              */
-            bool InitializeForClient(const char *host, const char *caroot);
+            bool InitializeForClient(const char *host, const char *caroot,
+                                     mbedtls_ssl_protocol_version maxVersion = MBEDTLS_SSL_VERSION_UNKNOWN);
 
             /**
              * 初始化服务端证书信息
              * @param cert 证书路径
              * @param key 证书密钥路径
              * @param password 证书密码
+             * @param maxVersion 最高协商版本, MBEDTLS_SSL_VERSION_UNKNOWN表示使用mbedtls默认值
              * @return 是否初始化成功
              */
-            bool InitializeForServer(const char *cert, const char *key, const char *password);
+            bool InitializeForServer(const char *cert, const char *key, const char *password,
+                                     mbedtls_ssl_protocol_version maxVersion = MBEDTLS_SSL_VERSION_UNKNOWN);
 
         private:
             int _error;
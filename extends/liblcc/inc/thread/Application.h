@@ -6,8 +6,80 @@
 #define LCC_APPLICATION_H
 
 #include <atomic>
+#include "uv.h"
+#include "utils/Histogram.h"
+#include "metrics/LoopMetrics.h"
 
 namespace Lcc {
+    /**
+     * 帧阶段
+     */
+    enum class TickPhase {
+        // 输入排空(网络消息、线程回传)
+        Input,
+        // 逻辑模拟
+        Simulate,
+        // 状态广播
+        Broadcast,
+        Count,
+    };
+
+    /**
+     * 固定步长参数
+     */
+    struct TickOptions {
+        // 帧率, 如20/30/60
+        unsigned int hz;
+        // 单次唤醒最多追帧次数, 超出的步数直接丢弃并重新对齐时间轴
+        unsigned int maxCatchUp;
+        // 唤醒晚于计划时间超过该值(纳秒)视为迟到帧, 0表示取周期的1/4
+        unsigned long long lateThreshold;
+        // 各阶段预算(纳秒), 0表示按周期20%/50%/20%分配
+        unsigned long long budgets[static_cast<int>(TickPhase::Count)];
+
+        explicit TickOptions(unsigned int rate = 20) : hz(rate), maxCatchUp(5), lateThreshold(0), budgets() {
+        }
+    };
+
+    /**
+     * 当前帧上下文
+     */
+    struct TickContext {
+        // 模拟步序号, 从0开始连续递增
+        unsigned long long tick;
+        // 本帧内第几次追帧, 0为正常步
+        unsigned int step;
+        // 固定步长(秒)
+        double dt;
+        // 帧开始时间(uv_hrtime纳秒)
+        unsigned long long now;
+    };
+
+    /**
+     * 帧统计(单位纳秒)
+     */
+    struct TickStats {
+        // 已执行的模拟步数
+        unsigned long long ticks;
+        // 已执行的帧数(一帧可包含多个模拟步)
+        unsigned long long frames;
+        // 迟到帧数
+        unsigned long long lateFrames;
+        // 因超出追帧上限丢弃的模拟步数
+        unsigned long long droppedTicks;
+        // 各阶段超出预算次数
+        unsigned long long overBudget[static_cast<int>(TickPhase::Count)];
+        // 整帧耗时
+        Utils::Histogram frame;
+        // 唤醒相对计划时间的延迟
+        Utils::Histogram lateness;
+        // 各阶段耗时
+        Utils::Histogram phases[static_cast<int>(TickPhase::Count)];
+
+        TickStats() : ticks(0), frames(0), lateFrames(0), droppedTicks(0), overBudget() {
+        }
+    };
+
     class Application {
     public:
         Application();
@@ -20,6 +92,48 @@ namespace Lcc {
 
         void Sleep(unsigned int ms);
 
+        /**
+         * 启用固定步长调度, 需在Run之前调用
+         * 启用后Run不再循环调用IRun, 改为在事件循环上按帧执行ITickInput/ITickSimulate/ITickBroadcast
+         * @param options 调度参数
+         * @return 参数是否有效
+         */
+        bool EnableTick(const TickOptions &options);
+
+        /**
+         * 获取帧统计, 只能在主线程读取
+         * @return 统计
+         */
+        const TickStats &GetTickStats() const;
+
+        /**
+         * 清空帧统计
+         */
+        void ResetTickStats();
+
+        /**
+         * 获取主线程事件循环, 固定步长模式下可在其上挂载网络服务等句柄
+         * @return 事件loop句柄
+         */
+        uv_loop_t *GetEventLoop();
+
+    protected:
+        /**
+         * 经过elapsed纳秒时应已开始的步数(向下取整), 按秒拆分计算, 运行任意时长都不会溢出
+         * @param elapsed 距时间轴起点的纳秒数
+         * @param hz 帧率
+         * @return 步数
+         */
+        static unsigned long long TickStepsAt(unsigned long long elapsed, unsigned int hz);
+
+        /**
+         * 第index步相对时间轴起点的计划时间(向上取整到纳秒), 按秒拆分计算, 运行任意时长都不会溢出
+         * @param index 步序号
+         * @param hz 帧率
+         * @return 纳秒数
+         */
+        static unsigned long long TickOffset(unsigned long long index, unsigned int hz);
+
     protected:
         virtual bool IInit() = 0;
 
@@ -27,8 +141,84 @@ namespace Lcc {
 
         virtual void IShutdown() = 0;
 
+        /**
+         * 帧开始: 排空输入
+         * @param context 帧上下文
+         */
+        virtual void ITickInput(const TickContext &context) {
+        }
+
+        /**
+         * 固定步长模拟, 追帧时一帧内会调用多次
+         * @param context 帧上下文
+         */
+        virtual void ITickSimulate(const TickContext &context) {
+        }
+
+        /**
+         * 帧结束: 广播状态
+         * @param context 帧上下文
+         */
+        virtual void ITickBroadcast(const TickContext &context) {
+        }
+
+        /**
+         * 迟到帧通知
+         * @param lateness 唤醒延迟(纳秒)
+         * @param cost 整帧耗时(纳秒)
+         */
+        virtual void ITickLate(unsigned long long lateness, unsigned long long cost) {
+        }
+
+    private:
+        /**
+         * 固定步长主循环
+         */
+        void TickRun();
+
+        /**
+         * 执行一帧
+         */
+        void TickFrame();
+
+        /**
+         * 预约下一次唤醒
+         * @param deadline 绝对时间(uv_hrtime纳秒)
+         */
+        void TickArm(unsigned long long deadline);
+
+        /**
+         * 计算第index步的计划时间
+         * @param index 步序号
+         * @return 绝对时间
+         */
+        unsigned long long TickDeadline(unsigned long long index) const;
+
+        /**
+         * 关闭事件循环
+         */
+        void EventLoopClose();
+
+        static void UvTickTimerCallback(uv_timer_t *handle);
+
+        static void UvTickPollCallback(uv_poll_t *handle, int status, int events);
+
     private:
         std::atomic<bool> _running;
+        bool _tick;
+        bool _loopInit;
+        int _timerFd;
+        unsigned long long _period;
+        unsigned long long _base;
+        unsigned long long _index;
+        // 下一个模拟步的序号, 不属于统计, 清空统计时不回退
+        unsigned long long _nextTick;
+        TickOptions _options;
+        TickStats _stats;
+        uv_loop_t _loop;
+        uv_timer_t _timer;
+        uv_poll_t _poll;
+        Metrics::LoopMetrics _loopMetrics;
     };
 }
 
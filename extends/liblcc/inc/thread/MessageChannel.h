@@ -0,0 +1,251 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_MESSAGE_CHANNEL_H
+#define LCC_MESSAGE_CHANNEL_H
+
+#include <atomic>
+#include <memory>
+#include <iterator>
+#include <type_traits>
+#include "uv.h"
+#include "concurrentqueue.h"
+
+namespace Lcc {
+    /**
+     * 跨线程消息通道的非模板部分: 负责uv_async唤醒、唤醒合并以及统计
+     */
+    class ChannelBase {
+    public:
+        ChannelBase();
+
+        virtual ~ChannelBase();
+
+        /**
+         * 将通道绑定到事件循环, 必须在事件循环所在线程调用
+         * @param loop 事件循环
+         * @return 是否绑定成功
+         */
+        bool Open(uv_loop_t *loop);
+
+        /**
+         * 关闭通道, 未派发的消息会被直接销毁, 必须在事件循环所在线程调用
+         * 调用前需保证生产端已停止投递
+         */
+        void Close();
+
+        /**
+         * 获取通道是否可用
+         * @return 是否可用
+         */
+        bool Active() const;
+
+        /**
+         * 获取消费端被唤醒的次数
+         * @return 唤醒次数
+         */
+        unsigned long long Wakeups() const;
+
+        /**
+         * 获取生产端实际调用uv_async_send的次数
+         * @return 发送唤醒次数
+         */
+        unsigned long long Signals() const;
+
+    protected:
+        // 单次唤醒最多派发的消息数, 持续投递时也能让出事件循环
+        static constexpr size_t kDrainLimit = 4096;
+
+        /**
+         * 生产端入队后调用, 只在消费端已停车(无唤醒在途且不在派发)时唤醒
+         */
+        void Notify();
+
+    protected:
+        /**
+         * 派发队列中的消息, 单次最多kDrainLimit条, 超出部分留到下一轮事件循环
+         * @return 是否因达到上限而停止
+         */
+        virtual bool IChannelDrain() = 0;
+
+        /**
+         * 销毁队列中的全部消息
+         */
+        virtual void IChannelDiscard() = 0;
+
+        /**
+         * 队列是否可能还有消息
+         * @return 是否有消息
+         */
+        virtual bool IChannelPending() const = 0;
+
+    protected:
+        static void UvChannelTrigger(uv_async_t *async);
+
+        static void UvChannelClose(uv_handle_t *handle);
+
+    private:
+        std::atomic<bool> _open;
+        // true: 已有唤醒在途或消费端正在派发
+        std::atomic<bool> _notified;
+        std::atomic<unsigned long long> _wakeups;
+        std::atomic<unsigned long long> _signals;
+        uv_async_t *_async;
+    };
+
+    template<typename T>
+    class ChannelImplement {
+    public:
+        virtual ~ChannelImplement() = default;
+
+        /**
+         * 在事件循环线程收到消息, 返回后消息被销毁
+         * @param message 消息
+         */
+        virtual void IChannelReceive(T &message) = 0;
+    };
+
+    /**
+     * 消息存储: 不超过InlineSize的消息直接存放在队列块内, 否则单独分配
+     */
+    template<typename T, bool Inline>
+    struct ChannelStorage {
+        typedef T Type;
+
+        static Type Box(T &&message) { return std::move(message); }
+        static T &Unbox(Type &storage) { return storage; }
+    };
+
+    template<typename T>
+    struct ChannelStorage<T, false> {
+        typedef std::unique_ptr<T> Type;
+
+        static Type Box(T &&message) { return Type(new T(std::move(message))); }
+        static T &Unbox(Type &storage) { return *storage; }
+    };
+
+    /**
+     * 多生产者单消费者的类型化消息通道
+     * 消息以移动方式转移所有权, 派发完成或通道关闭时在消费线程销毁
+     * T需要可默认构造与移动
+     */
+    template<typename T, unsigned int InlineSize = 64>
+    class MessageChannel : public ChannelBase {
+        static constexpr size_t kBulkSize = 64;
+        typedef ChannelStorage<T, (sizeof(T) <= InlineSize)> Storage;
+        typedef typename Storage::Type Slot;
+
+    public:
+        explicit MessageChannel(ChannelImplement<T> *impl) : _implement(impl), _consumerToken(_queue) {
+        }
+
+        ~MessageChannel() override {
+            IChannelDiscard();
+        }
+
+        /**
+         * 压入一条消息, 可在任意线程调用
+         * 消费端停车时才会唤醒; 高频投递优先使用EnqueueBulk, 一批只需一次入队与一次唤醒检查
+         * @param message 消息
+         * @return 是否压入成功
+         */
+        bool Enqueue(T &&message) {
+            if (!Active() || !_queue.enqueue(Storage::Box(std::move(message)))) {
+                return false;
+            }
+            Notify();
+            return true;
+        }
+
+        /**
+         * 批量压入消息, 只触发一次唤醒, 可在任意线程调用
+         * @param messages 消息数组, 成功后元素处于被移动状态
+         * @param count 消息数量
+         * @return 是否压入成功
+         */
+        bool EnqueueBulk(T *messages, size_t count) {
+            if (!Active()) {
+                return false;
+            }
+            if (!BulkInsert(messages, count, std::integral_constant<bool, (sizeof(T) <= InlineSize)>())) {
+                return false;
+            }
+            Notify();
+            return true;
+        }
+
+        /**
+         * 批量取出消息, 仅在消费线程调用
+         * @param messages 输出消息数组
+         * @param max 最大数量
+         * @return 实际取出数量
+         */
+        size_t TryDequeueBulk(T *messages, size_t max) {
+            Slot slots[kBulkSize];
+            size_t total = 0;
+            while (total < max) {
+                const size_t n = _queue.try_dequeue_bulk(_consumerToken, slots,
+                                                        max - total < kBulkSize ? max - total : kBulkSize);
+                if (n == 0) {
+                    break;
+                }
+                for (size_t i = 0; i < n; ++i) {
+                    messages[total++] = std::move(Storage::Unbox(slots[i]));
+                }
+            }
+            return total;
+        }
+
+    protected:
+        bool IChannelDrain() override {
+            Slot slots[kBulkSize];
+            size_t total = 0;
+            size_t n;
+            while (total < kDrainLimit && (n = _queue.try_dequeue_bulk(_consumerToken, slots, kBulkSize)) > 0) {
+                for (size_t i = 0; i < n; ++i) {
+                    _implement->IChannelReceive(Storage::Unbox(slots[i]));
+                    slots[i] = Slot();
+                }
+                total += n;
+            }
+            return total >= kDrainLimit;
+        }
+
+        void IChannelDiscard() override {
+            Slot slots[kBulkSize];
+            while (_queue.try_dequeue_bulk(_consumerToken, slots, kBulkSize) > 0) {
+            }
+        }
+
+        bool IChannelPending() const override {
+            return _queue.size_approx() > 0;
+        }
+
+    private:
+        bool BulkInsert(T *messages, size_t count, std::true_type) {
+            return _queue.enqueue_bulk(std::make_move_iterator(messages), count);
+        }
+
+        bool BulkInsert(T *messages, size_t count, std::false_type) {
+            Slot slots[kBulkSize];
+            for (size_t offset = 0; offset < count; offset += kBulkSize) {
+                const size_t n = count - offset < kBulkSize ? count - offset : kBulkSize;
+                for (size_t i = 0; i < n; ++i) {
+                    slots[i] = Storage::Box(std::move(messages[offset + i]));
+                }
+                if (!_queue.enqueue_bulk(std::make_move_iterator(slots), n)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        ChannelImplement<T> *_implement;
+        moodycamel::ConcurrentQueue<Slot> _queue;
+        moodycamel::ConsumerToken _consumerToken;
+    };
+}
+
+#endif //LCC_MESSAGE_CHANNEL_H
@@ -0,0 +1,348 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_TASK_SCHEDULER_H
+#define LCC_TASK_SCHEDULER_H
+
+#include <atomic>
+#include <vector>
+#include "uv.h"
+#include "thread/Thread.h"
+
+namespace Lcc {
+    class TaskGroup;
+    class TaskWorker;
+    class TaskScheduler;
+
+    /**
+     * 调度任务基类
+     */
+    class Task {
+        friend class TaskWorker;
+        friend class TaskScheduler;
+
+    public:
+        Task();
+
+        virtual ~Task();
+
+    protected:
+        /**
+         * 执行任务
+         * @param worker 执行任务的工作线程, 可通过其事件循环发起异步I/O
+         */
+        virtual void ITaskExecute(TaskWorker *worker) = 0;
+
+        /**
+         * 任务执行完成后释放, 默认不做处理
+         */
+        virtual void ITaskRelease();
+
+    private:
+        TaskGroup *_group;
+    };
+
+    /**
+     * 任务组: 用于等待一批任务完成(join)以及设置完成后的后续任务(continuation)
+     * 一个任务组只能等待一次
+     */
+    class TaskGroup {
+        friend class TaskWorker;
+        friend class TaskScheduler;
+
+    public:
+        TaskGroup();
+
+        ~TaskGroup();
+
+        /**
+         * 设置全部任务完成后提交的后续任务, 需在提交任务前设置
+         * @param task 后续任务
+         */
+        void Then(Task *task);
+
+        /**
+         * 获取未完成的任务数量
+         * @return 未完成数量
+         */
+        int Pending() const;
+
+        /**
+         * 等待全部任务完成, 在工作线程中调用时会帮助执行其他任务
+         * @param scheduler 任务所属调度器
+         */
+        void Wait(TaskScheduler *scheduler);
+
+    protected:
+        void Add();
+
+        void Done(TaskScheduler *scheduler);
+
+    private:
+        bool _done;
+        std::atomic<bool> _added;
+        Task *_continuation;
+        std::atomic<int> _pending;
+        uv_mutex_t _mutex;
+        uv_cond_t _cond;
+    };
+
+    /**
+     * Chase-Lev工作窃取双端队列: 拥有者在底部压入/弹出, 其他线程从顶部窃取
+     */
+    class TaskDeque {
+        struct Array {
+            long long size;
+            std::atomic<Task *> *buffer;
+        };
+
+    public:
+        TaskDeque();
+
+        ~TaskDeque();
+
+        /**
+         * [拥有者] 压入任务
+         * @param task 任务
+         */
+        void Push(Task *task);
+
+        /**
+         * [拥有者] 弹出最近压入的任务
+         * @return 任务, 没有返回nullptr
+         */
+        Task *Pop();
+
+        /**
+         * [任意线程] 窃取最早压入的任务
+         * @return 任务, 没有或竞争失败返回nullptr
+         */
+        Task *Steal();
+
+        /**
+         * 获取任务数量(近似值)
+         * @return 任务数量
+         */
+        long long Size() const;
+
+    protected:
+        Array *Grow(Array *array, long long bottom, long long top);
+
+        static Array *AllocArray(long long size);
+
+    private:
+        std::atomic<long long> _top;
+        char _pad0[64 - sizeof(std::atomic<long long>)];
+        std::atomic<long long> _bottom;
+        std::atomic<Array *> _array;
+        // 扩容后的旧数组可能仍被窃取者读取, 延迟到析构时释放
+        std::vector<Array *> _garbage;
+    };
+
+    /**
+     * 工作线程: 每个工作线程拥有独立的uv事件循环和任务队列
+     */
+    class TaskWorker : public Thread {
+        friend class TaskGroup;
+        friend class TaskScheduler;
+
+    public:
+        TaskWorker(TaskScheduler *scheduler, unsigned int index);
+
+        ~TaskWorker() override;
+
+        /**
+         * 获取工作线程序号
+         * @return 序号
+         */
+        unsigned int Index() const;
+
+        /**
+         * 获取工作线程的事件循环, 仅在该线程内使用
+         * @return 事件循环
+         */
+        uv_loop_t *Loop();
+
+        /**
+         * 获取已执行任务数量
+         * @return 已执行数量
+         */
+        unsigned long long Executed() const;
+
+        /**
+         * 获取成功窃取任务数量
+         * @return 窃取数量
+         */
+        unsigned long long Stolen() const;
+
+    protected:
+        /**
+         * 查找下一个任务: 先取本地队列, 再从其他工作线程窃取
+         * @return 任务
+         */
+        Task *FindTask();
+
+        /**
+         * 唤醒并开始处理任务
+         */
+        void Activate();
+
+    protected:
+        bool IInit() override;
+
+        void IMessage(void *message) override;
+
+        void IShutdown() override;
+
+    protected:
+        static void UvWorkerIdle(uv_idle_t *idle);
+
+    private:
+        std::atomic<bool> _sleeping;
+        unsigned int _index;
+        unsigned int _victim;
+        uv_idle_t _idle;
+        TaskDeque _deque;
+        TaskScheduler *_scheduler;
+        std::atomic<unsigned long long> _executed;
+        std::atomic<unsigned long long> _stolen;
+    };
+
+    /**
+     * 工作窃取任务调度器
+     */
+    class TaskScheduler {
+        friend class TaskWorker;
+        friend class TaskGroup;
+
+        template<typename Func>
+        class RangeTask : public Task {
+        public:
+            RangeTask(TaskScheduler *scheduler, TaskGroup *group, unsigned int begin, unsigned int end,
+                      unsigned int grain, const Func *func) : _scheduler(scheduler), _group(group), _begin(begin),
+                                                              _end(end), _grain(grain), _func(func) {
+            }
+
+        protected:
+            void ITaskExecute(TaskWorker *worker) override {
+                // 二分拆分, 右半部分交给其他线程窃取
+                while (_end - _begin > _grain) {
+                    const unsigned int middle = _begin + (_end - _begin) / 2;
+                    _scheduler->Spawn(new RangeTask(_scheduler, _group, middle, _end, _grain, _func), _group);
+                    _end = middle;
+                }
+                for (unsigned int i = _begin; i < _end; ++i) {
+                    (*_func)(i);
+                }
+            }
+
+            void ITaskRelease() override {
+                delete this;
+            }
+
+        private:
+            TaskScheduler *_scheduler;
+            TaskGroup *_group;
+            unsigned int _begin;
+            unsigned int _end;
+            unsigned int _grain;
+            const Func *_func;
+        };
+
+    public:
+        TaskScheduler();
+
+        virtual ~TaskScheduler();
+
+        /**
+         * 启动工作线程
+         * @param workers 工作线程数量, 0表示使用cpu核数
+         * @return 是否全部启动成功
+         */
+        bool Startup(unsigned int workers);
+
+        /**
+         * 按线程参数启动工作线程, 每个参数对应一个工作线程
+         * @param options 线程参数, 可由CpuTopology::Layout生成
+         * @return 是否全部启动成功
+         */
+        bool Startup(const std::vector<ThreadOptions> &options);
+
+        /**
+         * 关闭全部工作线程, 未执行的任务会被直接释放并计入所属任务组的完成
+         */
+        void Shutdown();
+
+        /**
+         * 获取工作线程数量
+         * @return 工作线程数量
+         */
+        unsigned int WorkerCount() const;
+
+        /**
+         * 获取工作线程
+         * @param index 序号
+         * @return 工作线程
+         */
+        TaskWorker *GetWorker(unsigned int index) const;
+
+        /**
+         * 获取当前线程所在的工作线程
+         * @return 工作线程, 非本调度器线程返回nullptr
+         */
+        TaskWorker *CurrentWorker() const;
+
+        /**
+         * 提交任务, 工作线程内提交时压入本地队列, 否则轮询投递到工作线程
+         * @param task 任务
+         * @param group 所属任务组(可选)
+         * @return 是否提交成功
+         */
+        bool Spawn(Task *task, TaskGroup *group = nullptr);
+
+        /**
+         * 并行执行[begin, end)区间, 阻塞到全部完成, 没有工作线程时在调用线程内执行
+         * @param begin 起始序号
+         * @param end 结束序号
+         * @param grain 单个任务的最小区间
+         * @param func 执行函数 void(unsigned int)
+         */
+        template<typename Func>
+        void ParallelFor(unsigned int begin, unsigned int end, unsigned int grain, const Func &func) {
+            if (begin >= end) {
+                return;
+            }
+            if (_workers.empty()) {
+                for (unsigned int i = begin; i < end; ++i) {
+                    func(i);
+                }
+                return;
+            }
+            TaskGroup group;
+            Spawn(new RangeTask<Func>(this, &group, begin, end, grain ? grain : 1, &func), &group);
+            group.Wait(this);
+        }
+
+    protected:
+        /**
+         * 执行任务并处理任务组计数
+         * @param worker 工作线程
+         * @param task 任务
+         */
+        void Execute(TaskWorker *worker, Task *task);
+
+        /**
+         * 有工作线程休眠时唤醒其中一个来窃取任务
+         * @param self 发起唤醒的工作线程
+         */
+        void WakeOne(TaskWorker *self);
+
+    private:
+        std::atomic<int> _sleeping;
+        std::atomic<unsigned int> _next;
+        std::vector<TaskWorker *> _workers;
+    };
+}
+
+#endif //LCC_TASK_SCHEDULER_H
@@ -5,8 +5,13 @@
 #ifndef LCC_THREAD_H
 #define LCC_THREAD_H
 
+#include <atomic>
+#include <vector>
 #include "uv.h"
 #include "concurrentqueue.h"
+#include "metrics/LoopMetrics.h"
+#include "thread/Topology.h"
+#include "thread/MessageChannel.h"
 
 namespace Lcc {
     class Thread {
@@ -26,6 +31,13 @@ namespace Lcc {
          */
         bool Startup();
 
+        /**
+         * 按指定参数启动线程(线程名、cpu绑定、NUMA节点、栈大小)
+         * @param options 线程参数
+         * @return 是否启动线程成功
+         */
+        bool Startup(const ThreadOptions &options);
+
         /**
          * 关闭线程
          */
@@ -37,6 +49,18 @@ namespace Lcc {
          */
         bool Running() const;
 
+        /**
+         * 获取异常错误码, 包括线程创建失败和cpu绑定失败
+         * @return 错误码
+         */
+        int LastErrCode() const;
+
+        /**
+         * 获取线程启动参数
+         * @return 线程参数
+         */
+        const ThreadOptions &GetOptions() const;
+
         /**
          * 尝试压入消息队列
          * @param message 消息
@@ -44,7 +68,32 @@ namespace Lcc {
          */
         bool QueueMessage(void *message);
 
+        /**
+         * 获取消息事件唤醒线程的次数
+         * @return 唤醒次数
+         */
+        unsigned long long Wakeups() const;
+
+        /**
+         * 获取事件循环名称, 即线程名, 未命名时为thread-序号
+         * @return 名称
+         */
+        const std::string &GetLoopName() const;
+
     protected:
+        /**
+         * 在线程事件循环上打开消息通道, 线程关闭时自动关闭通道
+         * 只能在线程内调用(如IInit)
+         * @param channel 消息通道
+         * @return 是否打开成功
+         */
+        bool OpenChannel(ChannelBase *channel);
+
+        /**
+         * 在线程内应用启动参数
+         */
+        void ApplyOptions();
+
         /**
          * 事件驱动初始化
          */
@@ -96,6 +145,10 @@ namespace Lcc {
         uv_barrier_t _waitSignal;
         uv_async_t _eventTrigger;
         uv_async_t _shutdownTrigger;
+        ThreadOptions _options;
+        Metrics::LoopMetrics _loopMetrics;
+        std::vector<ChannelBase *> _channels;
+        std::atomic<unsigned long long> _wakeups;
         moodycamel::ConcurrentQueue<void *> _messages;
     };
 }
@@ -0,0 +1,110 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_TOPOLOGY_H
+#define LCC_TOPOLOGY_H
+
+#include <string>
+#include <vector>
+
+namespace Lcc {
+    /**
+     * 线程启动参数
+     */
+    struct ThreadOptions {
+        // 线程名(Linux下最长15个字符), 便于perf/top识别
+        std::string name;
+        // 绑定的cpu列表, 为空时不绑定
+        std::vector<int> cpus;
+        // 优先分配内存的NUMA节点, -1表示不指定; cpus为空时同时绑定到该节点的全部cpu
+        int numaNode;
+        // 线程栈大小, 0表示使用默认值
+        size_t stackSize;
+
+        ThreadOptions() : numaNode(-1), stackSize(0) {
+        }
+    };
+
+    /**
+     * 机器cpu拓扑, 从/sys读取
+     */
+    class CpuTopology {
+    public:
+        struct Cpu {
+            int id;
+            int core;
+            int package;
+            int node;
+        };
+
+    public:
+        CpuTopology();
+
+        /**
+         * 读取拓扑信息, /sys不可用时按uv_available_parallelism退化为单节点
+         * @return 是否从/sys读取成功
+         */
+        bool Load();
+
+        /**
+         * 获取在线cpu数量
+         * @return cpu数量
+         */
+        unsigned int CpuCount() const;
+
+        /**
+         * 获取NUMA节点数量
+         * @return 节点数量
+         */
+        unsigned int NodeCount() const;
+
+        /**
+         * 获取节点下的cpu列表
+         * @param node 节点序号
+         * @param physical 是否每个物理核只取一个超线程
+         * @return cpu列表
+         */
+        std::vector<int> NodeCpus(int node, bool physical = false) const;
+
+        /**
+         * 获取全部cpu信息
+         * @return cpu信息
+         */
+        const std::vector<Cpu> &Cpus() const;
+
+        /**
+         * 按拓扑规划网络线程和逻辑线程:
+         * 网络线程轮流分布到各NUMA节点, 各自独占一个物理核; 逻辑线程使用节点剩余cpu
+         * @param networkLoops 网络线程数量
+         * @param workers 逻辑线程数量
+         * @param network 输出网络线程参数
+         * @param logic 输出逻辑线程参数
+         */
+        void Layout(unsigned int networkLoops, unsigned int workers, std::vector<ThreadOptions> &network,
+                    std::vector<ThreadOptions> &logic) const;
+
+    public:
+        /**
+         * 解析cpulist格式, 如"0-3,8,10-11"
+         * @param list 文本
+         * @param out 输出cpu列表
+         * @return 是否解析成功
+         */
+        static bool ParseCpuList(const std::string &list, std::vector<int> &out);
+
+        /**
+         * 读取NUMA节点下的cpu列表
+         * @param node 节点序号
+         * @param out 输出cpu列表
+         * @return 是否读取成功
+         */
+        static bool ReadNodeCpus(int node, std::vector<int> &out);
+
+    private:
+        unsigned int _nodes;
+        std::vector<Cpu> _cpus;
+    };
+}
+
+#endif //LCC_TOPOLOGY_H
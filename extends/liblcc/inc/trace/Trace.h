@@ -0,0 +1,203 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_TRACE_H
+#define LCC_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace Lcc {
+    namespace Trace {
+        /**
+         * 数据包经过的阶段, 读方向从套接字到应用, 写方向从应用到套接字
+         */
+        enum class Stage : uint16_t {
+            None,
+            // 套接字读到数据
+            StreamRead,
+            // TLS解密出明文
+            TlsRead,
+            // WebSocket解出一条消息
+            WsRead,
+            // 长度前缀帧解出一帧
+            FrameRead,
+            // 交给应用(IServerSessionReceive等)
+            UserReceive,
+            // 应用写入
+            UserWrite,
+            // 长度前缀帧编码
+            FrameWrite,
+            // WebSocket编码
+            WsWrite,
+            // TLS加密
+            TlsWrite,
+            // 提交uv_write
+            StreamWrite,
+            // uv_write完成
+            WriteDone,
+            Count,
+        };
+
+        /**
+         * 定长二进制记录, 24字节
+         */
+        struct Record {
+            // 时间戳, x86上为TSC, 其他平台为uv_hrtime纳秒
+            uint64_t tsc;
+            // 会话id
+            uint32_t session;
+            // 字节数
+            uint32_t bytes;
+            // 阶段
+            uint16_t stage;
+            uint16_t reserved;
+            // 附加参数
+            uint32_t arg;
+        };
+
+        /**
+         * 单线程环形缓冲, 只由所属线程写入, 写满后覆盖最旧的记录
+         */
+        struct Ring {
+            Record *records;
+            uint64_t mask;
+            // 已写入的记录总数, 写入记录后以release序发布
+            std::atomic<uint64_t> head;
+            // 线程序号, 从1开始
+            uint32_t thread;
+            char name[16];
+        };
+
+        /**
+         * 读取时间戳
+         * @return 时间戳
+         */
+        uint64_t ReadClock();
+
+        /**
+         * 线程缓冲的分配与登记, 线程退出后缓冲保留到被新线程复用, 转储时仍可读到
+         */
+        class Rings {
+        public:
+            /**
+             * 获取当前线程的环形缓冲
+             * @return 环形缓冲
+             */
+            static inline Ring *Local() {
+                Ring *ring = _local;
+                return ring ? ring : Attach();
+            }
+
+        private:
+            static Ring *Attach();
+
+        private:
+            static thread_local Ring *_local;
+        };
+
+        /**
+         * 写入一条记录, 只写本线程的缓冲, 不加锁
+         * @param stage 阶段
+         * @param session 会话id
+         * @param bytes 字节数
+         * @param arg 附加参数
+         */
+        inline void Emit(Stage stage, uint32_t session, uint32_t bytes, uint32_t arg = 0) {
+            Ring *ring = Rings::Local();
+            const uint64_t head = ring->head.load(std::memory_order_relaxed);
+            Record &record = ring->records[head & ring->mask];
+#if defined(__x86_64__) || defined(__i386__)
+            record.tsc = __rdtsc();
+#else
+            record.tsc = ReadClock();
+#endif
+            record.session = session;
+            record.bytes = bytes;
+            record.stage = static_cast<uint16_t>(stage);
+            record.reserved = 0;
+            record.arg = arg;
+            ring->head.store(head + 1, std::memory_order_release);
+        }
+
+        /**
+         * 当前处理的会话, 在流的回调入口设置, 协议层记录时沿用, 不需要知道会话id
+         */
+        class Scope {
+        public:
+            explicit Scope(uint32_t session) : _previous(_current) {
+                _current = session;
+            }
+
+            ~Scope() {
+                _current = _previous;
+            }
+
+            static inline uint32_t Current() {
+                return _current;
+            }
+
+        private:
+            uint32_t _previous;
+            static thread_local uint32_t _current;
+        };
+
+        /**
+         * 设置每个线程的缓冲记录数, 向上取整到2的幂, 只影响之后首次记录的线程
+         * @param records 记录数
+         */
+        void SetCapacity(size_t records);
+
+        /**
+         * 设置当前线程在跟踪中显示的名称
+         * @param name 名称, 最长15个字符
+         */
+        void SetThreadName(const char *name);
+
+        /**
+         * 把所有线程的缓冲写成二进制跟踪文件, 可在任意线程调用, 不影响记录
+         * @param path 文件路径
+         * @return 错误码, 0为成功
+         */
+        int Dump(const char *path);
+
+        /**
+         * 把二进制跟踪文件转换为Chrome trace/Perfetto可加载的JSON
+         * 每个线程一个进程分组, 每个会话一条轨道, 记录为瞬时事件, uv_write提交到完成为一段持续事件
+         * @param input 跟踪文件路径
+         * @param output JSON文件路径
+         * @return 错误码, 0为成功
+         */
+        int ConvertToJson(const char *input, const char *output);
+
+        /**
+         * 获取阶段名称
+         * @param stage 阶段
+         * @return 名称
+         */
+        const char *StageName(uint16_t stage);
+    }
+}
+
+/**
+ * 跟踪点按编译开关启用, 关闭时不产生任何代码: cmake -DLCC_TRACE=ON
+ */
+#if defined(LCC_TRACE)
+#define LCC_TRACE_SCOPE(session) Lcc::Trace::Scope _lccTraceScope(session)
+#define LCC_TRACE_POINT(stage, bytes) \
+    Lcc::Trace::Emit(Lcc::Trace::Stage::stage, Lcc::Trace::Scope::Current(), static_cast<uint32_t>(bytes))
+#define LCC_TRACE_SESSION(stage, session, bytes) \
+    Lcc::Trace::Emit(Lcc::Trace::Stage::stage, session, static_cast<uint32_t>(bytes))
+#else
+#define LCC_TRACE_SCOPE(session) do { } while (0)
+#define LCC_TRACE_POINT(stage, bytes) do { } while (0)
+#define LCC_TRACE_SESSION(stage, session, bytes) do { } while (0)
+#endif
+
+#endif //LCC_TRACE_H
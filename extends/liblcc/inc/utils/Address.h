@@ -6,8 +6,7 @@
 #define LCC_ADDRESS_H
 
 #include <cstring>
-#include <regex>
-#include "utils/Strings.h"
+#include <string>
 
 namespace Lcc {
     namespace Utils {
@@ -15,6 +14,12 @@ namespace Lcc {
             Tcp,
             Http,
             Websocket,
+            // 本机unix域套接字, 路径存放在path中
+            Unix,
+            // 本机共享内存通道, 路径为握手用的unix域套接字
+            Shm,
+            // 可靠UDP
+            Udp,
         };
 
         struct HostAddress {
@@ -23,67 +28,192 @@ namespace Lcc {
             int port;
             char ip[128];
             char host[128];
+            // 路径及查询参数, 未指定时为"/"
+            char path[256];
             HostProtocol protocol;
         };
 
-        inline bool HostParse(std::string &&host, HostAddress &addr) {
-            bool nonePort = false;
-            bool chkValid = false;
-            std::smatch sm;
-            // 匹配ip端口类
-            std::regex regex_ip("(http|https|ws|wss|tcp)://([0-9]{1,3}.[0-9]{1,3}.[0-9]{1,3}.[0-9]{1,3}):([0-9]{2,5})");
-            if (std::regex_match(host, sm, regex_ip)) {
-                // (协议) (xxx.xxx.xxx.xxx) (端口)
-                chkValid = true;
-            } else {
-                // 匹配域名类
-                std::regex regex_host("(http|https|ws|wss|tcp)://([0-9a-zA-z\\-_.]+):([0-9]{2,5})");
-                if (std::regex_match(host, sm, regex_host)) {
-                    // (协议) (域名) (端口)
-                    chkValid = true;
-                } else {
-                    if (host.find("http") != std::string::npos) {
-                        std::regex regex_host2("(http|https|ws|wss|tcp)://([0-9a-zA-z\\-_.]+)");
-                        if (std::regex_match(host, sm, regex_host2)) {
-                            // (https) (域名) (80|443)
-                            chkValid = true;
-                            nonePort = true;
-                        }
+        namespace Detail {
+            struct HostScheme {
+                const char *name;
+                unsigned int size;
+                HostProtocol protocol;
+                bool ssl;
+                // 默认端口, 0表示必须指定
+                int port;
+            };
+
+            inline bool HostSchemeMatch(const char *in, unsigned int size, const HostScheme &scheme) {
+                if (size != scheme.size) {
+                    return false;
+                }
+                for (unsigned int n = 0; n < size; ++n) {
+                    if ((in[n] | 0x20) != scheme.name[n]) {
+                        return false;
                     }
                 }
+                return true;
+            }
+
+            inline bool HostNameChar(char c) {
+                return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '-' ||
+                       c == '_' || c == '.';
+            }
+
+            inline bool HostIpv6Char(char c) {
+                return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F') || c == ':' ||
+                       c == '.';
+            }
+        }
+
+        /**
+         * 解析地址, 单次扫描且不分配内存, 失败时不修改addr
+         * 格式: 协议://主机[:端口][/路径], 协议为tcp/udp/http/https/ws/wss(不区分大小写),
+         * 主机为域名、IPv4或方括号包围的IPv6([::1]), 省略端口时http/ws为80, https/wss为443, tcp/udp必须指定;
+         * unix://套接字路径(如unix:///tmp/game.sock), 主机为空, 端口为0; shm://同样只有路径
+         * @param url 地址
+         * @param size 地址长度
+         * @param addr 输出解析结果
+         * @return 是否解析成功
+         */
+        inline bool HostParse(const char *url, size_t size, HostAddress &addr) {
+            static const Detail::HostScheme schemes[] = {
+                {"tcp", 3, HostProtocol::Tcp, false, 0},
+                {"udp", 3, HostProtocol::Udp, false, 0},
+                {"http", 4, HostProtocol::Http, false, 80},
+                {"https", 5, HostProtocol::Http, true, 443},
+                {"ws", 2, HostProtocol::Websocket, false, 80},
+                {"wss", 3, HostProtocol::Websocket, true, 443},
+                {"unix", 4, HostProtocol::Unix, false, 0},
+                {"shm", 3, HostProtocol::Shm, false, 0},
+            };
+            if (!url) {
+                return false;
             }
-            if (chkValid) {
+            // 协议
+            size_t pos = 0;
+            while (pos < size && pos < 6 && url[pos] != ':') {
+                ++pos;
+            }
+            const Detail::HostScheme *scheme = nullptr;
+            for (const auto &it: schemes) {
+                if (Detail::HostSchemeMatch(url, static_cast<unsigned int>(pos), it)) {
+                    scheme = &it;
+                    break;
+                }
+            }
+            if (!scheme || size - pos < 3 || url[pos] != ':' || url[pos + 1] != '/' || url[pos + 2] != '/') {
+                return false;
+            }
+            pos += 3;
+            if (scheme->protocol == HostProtocol::Unix || scheme->protocol == HostProtocol::Shm) {
+                // 其余部分整体为套接字路径
+                if (pos >= size || size - pos >= sizeof(addr.path)) {
+                    return false;
+                }
+                for (size_t n = pos; n < size; ++n) {
+                    const auto c = static_cast<unsigned char>(url[n]);
+                    if (c < 0x20 || c == 0x7f) {
+                        return false;
+                    }
+                }
                 addr.v6 = false;
+                addr.ssl = false;
                 addr.port = 0;
-                memset(&addr.ip, 0, sizeof(addr.ip));
-                memset(&addr.host, 0, sizeof(addr.host));
-                // 匹配
-                std::string protocol = sm[1].str();
-                StringToLower(protocol);
-                if (protocol.find("ws") != std::string::npos) {
-                    addr.protocol = HostProtocol::Websocket;
-                    if (protocol.find("wss") != std::string::npos) {
-                        addr.ssl = true;
-                    }
-                } else if (protocol.find("http") != std::string::npos) {
-                    addr.protocol = HostProtocol::Http;
-                    if (protocol.find("https") != std::string::npos) {
-                        addr.ssl = true;
-                    }
-                } else {
-                    addr.protocol = HostProtocol::Tcp;
+                addr.protocol = scheme->protocol;
+                addr.ip[0] = '\0';
+                addr.host[0] = '\0';
+                memcpy(addr.path, url + pos, size - pos);
+                addr.path[size - pos] = '\0';
+                return true;
+            }
+            // 主机
+            bool v6 = false;
+            size_t hostBegin = pos;
+            size_t hostEnd;
+            if (pos < size && url[pos] == '[') {
+                hostBegin = ++pos;
+                bool colon = false;
+                while (pos < size && Detail::HostIpv6Char(url[pos])) {
+                    colon = colon || url[pos] == ':';
+                    ++pos;
+                }
+                if (pos >= size || url[pos] != ']' || !colon) {
+                    return false;
+                }
+                hostEnd = pos++;
+                v6 = true;
+            } else {
+                while (pos < size && Detail::HostNameChar(url[pos])) {
+                    ++pos;
+                }
+                hostEnd = pos;
+            }
+            if (hostEnd == hostBegin || hostEnd - hostBegin >= sizeof(addr.host)) {
+                return false;
+            }
+            // 端口
+            int port = scheme->port;
+            if (pos < size && url[pos] == ':') {
+                const size_t portBegin = ++pos;
+                port = 0;
+                while (pos < size && url[pos] >= '0' && url[pos] <= '9' && pos - portBegin < 5) {
+                    port = port * 10 + (url[pos++] - '0');
+                }
+                if (pos == portBegin || port > 0xffff || (pos < size && url[pos] >= '0' && url[pos] <= '9')) {
+                    return false;
+                }
+            } else if (port == 0) {
+                return false;
+            }
+            // 路径
+            const size_t pathBegin = pos;
+            if (pos < size) {
+                if (url[pos] != '/' && url[pos] != '?') {
+                    return false;
                 }
-                StringCopy(addr.host, sizeof(addr.host), sm[2].str().c_str(), sm[2].str().size());
-                if (!nonePort) {
-                    chkValid = StringToNumber(sm[3].str(), &addr.port);
-                } else {
-                    addr.port = 80;
-                    if (addr.ssl) {
-                        addr.port = 443;
+                for (; pos < size; ++pos) {
+                    const auto c = static_cast<unsigned char>(url[pos]);
+                    if (c <= 0x20 || c == 0x7f) {
+                        return false;
                     }
                 }
+                if (pos - pathBegin >= sizeof(addr.path)) {
+                    return false;
+                }
+            }
+            addr.v6 = v6;
+            addr.ssl = scheme->ssl;
+            addr.port = port;
+            addr.protocol = scheme->protocol;
+            addr.ip[0] = '\0';
+            memcpy(addr.host, url + hostBegin, hostEnd - hostBegin);
+            addr.host[hostEnd - hostBegin] = '\0';
+            if (pathBegin < size) {
+                memcpy(addr.path, url + pathBegin, size - pathBegin);
+                addr.path[size - pathBegin] = '\0';
+            } else {
+                addr.path[0] = '/';
+                addr.path[1] = '\0';
             }
-            return chkValid;
+            return true;
+        }
+
+        inline bool HostParse(const char *url, HostAddress &addr) {
+            return url && HostParse(url, strlen(url), addr);
+        }
+
+        inline bool HostParse(const std::string &url, HostAddress &addr) {
+            return HostParse(url.data(), url.size(), addr);
+        }
+
+        /**
+         * 是否为字节流地址(tcp/http/ws/unix), TcpServer/TcpClient只接受这类地址
+         * @param addr 解析结果
+         * @return 是否为字节流地址
+         */
+        inline bool HostIsStream(const HostAddress &addr) {
+            return addr.protocol != HostProtocol::Shm && addr.protocol != HostProtocol::Udp;
         }
     }
 }
@@ -0,0 +1,177 @@
+//
+// Created by liao on 2026/10/19.
+//
+
+#ifndef LCC_HISTOGRAM_H
+#define LCC_HISTOGRAM_H
+
+#include <cstring>
+
+namespace Lcc {
+    namespace Utils {
+        /**
+         * 对数线性分桶直方图(HDR风格): 每个2的幂区间再均分为8个子桶, 相对误差不超过12.5%
+         * 只允许单线程写入, 记录开销为常数次位运算
+         */
+        class Histogram {
+        public:
+            static constexpr unsigned int kSubBits = 3;
+            static constexpr unsigned int kSubBuckets = 1U << kSubBits;
+            static constexpr unsigned int kLinear = kSubBuckets * 2;
+            static constexpr unsigned int kBuckets = kLinear + (64 - kSubBits - 1) * kSubBuckets;
+
+        public:
+            Histogram() : _count(0), _sum(0), _min(0), _max(0), _buckets() {
+            }
+
+            /**
+             * 清空统计
+             */
+            inline void Reset() {
+                _count = _sum = _min = _max = 0;
+                memset(_buckets, 0, sizeof(_buckets));
+            }
+
+            /**
+             * 记录一个值
+             * @param value 值
+             */
+            inline void Record(unsigned long long value) {
+                ++_buckets[BucketIndex(value)];
+                if (_count == 0 || value < _min) {
+                    _min = value;
+                }
+                if (value > _max) {
+                    _max = value;
+                }
+                ++_count;
+                _sum += value;
+            }
+
+            /**
+             * 合并另一个直方图
+             * @param other 直方图
+             */
+            inline void Merge(const Histogram &other) {
+                if (other._count == 0) {
+                    return;
+                }
+                for (unsigned int n = 0; n < kBuckets; ++n) {
+                    _buckets[n] += other._buckets[n];
+                }
+                if (_count == 0 || other._min < _min) {
+                    _min = other._min;
+                }
+                if (other._max > _max) {
+                    _max = other._max;
+                }
+                _count += other._count;
+                _sum += other._sum;
+            }
+
+            /**
+             * 按分桶合并外部统计(如线程分片), 最小/最大值取非空分桶的边界
+             * @param buckets 分桶计数, kBuckets个
+             * @param sum 总和
+             */
+            inline void MergeBuckets(const unsigned long long *buckets, unsigned long long sum) {
+                for (unsigned int n = 0; n < kBuckets; ++n) {
+                    if (buckets[n] == 0) {
+                        continue;
+                    }
+                    const unsigned long long lower = n == 0 ? 0 : BucketUpper(n - 1) + 1;
+                    if (_count == 0 || lower < _min) {
+                        _min = lower;
+                    }
+                    if (BucketUpper(n) > _max) {
+                        _max = BucketUpper(n);
+                    }
+                    _buckets[n] += buckets[n];
+                    _count += buckets[n];
+                }
+                _sum += sum;
+            }
+
+            inline unsigned long long Count() const { return _count; }
+            inline unsigned long long Sum() const { return _sum; }
+            inline unsigned long long Min() const { return _min; }
+            inline unsigned long long Max() const { return _max; }
+
+            inline double Mean() const {
+                return _count ? static_cast<double>(_sum) / static_cast<double>(_count) : 0;
+            }
+
+            /**
+             * 获取百分位值
+             * @param percentile 百分位(0~100)
+             * @return 所在分桶的上界, 不超过最大值
+             */
+            inline unsigned long long Percentile(double percentile) const {
+                if (_count == 0) {
+                    return 0;
+                }
+                auto rank = static_cast<unsigned long long>(percentile / 100.0 * static_cast<double>(_count) + 0.5);
+                if (rank == 0) {
+                    rank = 1;
+                }
+                unsigned long long seen = 0;
+                for (unsigned int n = 0; n < kBuckets; ++n) {
+                    seen += _buckets[n];
+                    if (seen >= rank) {
+                        const unsigned long long upper = BucketUpper(n);
+                        return upper < _max ? upper : _max;
+                    }
+                }
+                return _max;
+            }
+
+            /**
+             * 获取分桶计数
+             * @param index 分桶序号
+             * @return 计数
+             */
+            inline unsigned long long BucketCount(unsigned int index) const {
+                return index < kBuckets ? _buckets[index] : 0;
+            }
+
+        public:
+            /**
+             * 计算值所在分桶
+             * @param value 值
+             * @return 分桶序号
+             */
+            static inline unsigned int BucketIndex(unsigned long long value) {
+                if (value < kLinear) {
+                    return static_cast<unsigned int>(value);
+                }
+                const unsigned int msb = 63 - static_cast<unsigned int>(__builtin_clzll(value));
+                const unsigned int sub = static_cast<unsigned int>(value >> (msb - kSubBits)) & (kSubBuckets - 1);
+                return kLinear + (msb - kSubBits - 1) * kSubBuckets + sub;
+            }
+
+            /**
+             * 计算分桶包含的最大值
+             * @param index 分桶序号
+             * @return 最大值
+             */
+            static inline unsigned long long BucketUpper(unsigned int index) {
+                if (index < kLinear) {
+                    return index;
+                }
+                const unsigned int msb = (index - kLinear) / kSubBuckets + kSubBits + 1;
+                const unsigned int sub = (index - kLinear) % kSubBuckets;
+                const unsigned long long base = (1ULL << msb) + (static_cast<unsigned long long>(sub) << (msb - kSubBits));
+                return base + (1ULL << (msb - kSubBits)) - 1;
+            }
+
+        private:
+            unsigned long long _count;
+            unsigned long long _sum;
+            unsigned long long _min;
+            unsigned long long _max;
+            unsigned long long _buckets[kBuckets];
+        };
+    }
+}
+
+#endif //LCC_HISTOGRAM_H
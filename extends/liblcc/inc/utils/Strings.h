@@ -5,6 +5,11 @@
 #ifndef LCC_STRINGS_H
 #define LCC_STRINGS_H
 
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <algorithm>
+
 namespace Lcc {
     namespace Utils {
         /**
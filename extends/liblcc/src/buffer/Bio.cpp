@@ -6,6 +6,12 @@
 #include <algorithm>
 #include "buffer/Bio.h"
 
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 namespace Lcc {
     unsigned int _roundup_pow_of_2(unsigned int x) {
         unsigned int y = 0;
@@ -18,13 +24,66 @@ namespace Lcc {
         return y;
     }
 
-    BufferBio::BufferBio(): _in(0), _out(0), _size(0), _chunk(nullptr) {
+    /**
+     * 创建镜像内存: 同一个memfd连续映射两次, [0, size)与[size, 2*size)指向同一物理页
+     * @param size 映射大小(页大小的整数倍)
+     * @return 映射首地址, 失败返回nullptr
+     */
+    static unsigned char *_mirror_alloc(unsigned int size) {
+#if defined(__linux__) && defined(SYS_memfd_create)
+        const int fd = static_cast<int>(::syscall(SYS_memfd_create, "lcc-bio", 1U /* MFD_CLOEXEC */));
+        if (fd < 0) {
+            return nullptr;
+        }
+        if (::ftruncate(fd, size) != 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        // 先预留2倍地址空间, 再固定映射到预留区域中
+        void *base = ::mmap(nullptr, static_cast<size_t>(size) * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            ::close(fd);
+            return nullptr;
+        }
+        auto *chunk = static_cast<unsigned char *>(base);
+        if (::mmap(chunk, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+            ::mmap(chunk + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            ::munmap(base, static_cast<size_t>(size) * 2);
+            ::close(fd);
+            return nullptr;
+        }
+        // 映射会持有文件引用, fd可以直接关闭
+        ::close(fd);
+        return chunk;
+#else
+        return nullptr;
+#endif
+    }
+
+    static void _mirror_free(unsigned char *chunk, unsigned int size) {
+#if defined(__linux__)
+        ::munmap(chunk, static_cast<size_t>(size) * 2);
+#endif
     }
 
-    BufferBio::~BufferBio() {
-        if (_chunk) {
-            ::free(_chunk);
+    static unsigned int _mirror_page_size() {
+#if defined(__linux__)
+        const long page = ::sysconf(_SC_PAGESIZE);
+        if (page > 0) {
+            return static_cast<unsigned int>(page);
         }
+#endif
+        return 0x1000;
+    }
+
+    BufferBio::BufferBio(): BufferBio(BufferBioBackend::Heap) {
+    }
+
+    BufferBio::BufferBio(BufferBioBackend backend): _in(0), _out(0), _size(0), _chunk(nullptr), _backend(backend) {
+    }
+
+    BufferBio::~BufferBio() {
+        Release();
     }
 
     void BufferBio::Clear() {
@@ -35,6 +94,17 @@ namespace Lcc {
         return reinterpret_cast<char *>(_chunk + (_out & (_size - 1)));
     }
 
+    unsigned int BufferBio::ContiguousSize() const {
+        if (_backend == BufferBioBackend::Mirror) {
+            return _in - _out;
+        }
+        return std::min(_in - _out, _size - (_out & (_size - 1)));
+    }
+
+    BufferBioBackend BufferBio::Backend() const {
+        return _backend;
+    }
+
     unsigned int BufferBio::Capacity() const {
         return _size;
     }
@@ -49,9 +119,19 @@ namespace Lcc {
 
     unsigned int BufferBio::Read(char *out, unsigned int size) {
         size = std::min(size, _in - _out);
-        unsigned int l = std::min(size, _size - (_out & (_size - 1)));
-        memcpy(out, _chunk + (_out & (_size - 1)), l);
-        memcpy(reinterpret_cast<unsigned char *>(out + l), _chunk, size - l);
+        if (_backend == BufferBioBackend::Mirror) {
+            memcpy(out, _chunk + (_out & (_size - 1)), size);
+        } else {
+            unsigned int l = std::min(size, _size - (_out & (_size - 1)));
+            memcpy(out, _chunk + (_out & (_size - 1)), l);
+            memcpy(reinterpret_cast<unsigned char *>(out + l), _chunk, size - l);
+        }
+        _out += size;
+        return size;
+    }
+
+    unsigned int BufferBio::Skip(unsigned int size) {
+        size = std::min(size, _in - _out);
         _out += size;
         return size;
     }
@@ -60,21 +140,64 @@ namespace Lcc {
         const unsigned int avail = _size - (_in - _out);
         if (avail < size) {
             unsigned int l = _roundup_pow_of_2(_size + (size - avail));
-            if (l > 0x80000000UL) {
+            if (l > 0x80000000UL || l < _size + (size - avail)) {
                 return 0;
             }
-            auto *chunk = static_cast<unsigned char *>(::realloc(_chunk, l));
-            if (!chunk) {
+            if (!Expand(l)) {
                 return 0;
             }
-            _size = l;
-            _chunk = chunk;
             return Write(in, size);
         }
-        unsigned int l = std::min(size, _size - (_in & (_size - 1)));
-        memcpy(_chunk + (_in & (_size - 1)), in, l);
-        memcpy(_chunk, reinterpret_cast<const unsigned char *>(in + l), size - l);
+        if (_backend == BufferBioBackend::Mirror) {
+            memcpy(_chunk + (_in & (_size - 1)), in, size);
+        } else {
+            unsigned int l = std::min(size, _size - (_in & (_size - 1)));
+            memcpy(_chunk + (_in & (_size - 1)), in, l);
+            memcpy(_chunk, reinterpret_cast<const unsigned char *>(in + l), size - l);
+        }
         _in += size;
         return size;
     }
+
+    bool BufferBio::Expand(unsigned int size) {
+        unsigned char *chunk = nullptr;
+        if (_backend == BufferBioBackend::Mirror) {
+            size = std::max(size, _mirror_page_size());
+            chunk = _mirror_alloc(size);
+            if (!chunk && !_chunk) {
+                // 首次分配即不支持镜像映射, 回退为堆内存
+                _backend = BufferBioBackend::Heap;
+            }
+        }
+        if (_backend == BufferBioBackend::Heap) {
+            chunk = static_cast<unsigned char *>(::malloc(size));
+        }
+        if (!chunk) {
+            return false;
+        }
+        // 旧数据可能跨越环尾, 按顺序整理到新缓冲区头部
+        const unsigned int used = _in - _out;
+        if (used > 0) {
+            const unsigned int l = std::min(used, _size - (_out & (_size - 1)));
+            memcpy(chunk, _chunk + (_out & (_size - 1)), l);
+            memcpy(chunk + l, _chunk, used - l);
+        }
+        Release();
+        _chunk = chunk;
+        _size = size;
+        _out = 0;
+        _in = used;
+        return true;
+    }
+
+    void BufferBio::Release() {
+        if (_chunk) {
+            if (_backend == BufferBioBackend::Mirror) {
+                _mirror_free(_chunk, _size);
+            } else {
+                ::free(_chunk);
+            }
+            _chunk = nullptr;
+        }
+    }
 }
@@ -0,0 +1,209 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+#include "buffer/SpscRing.h"
+#include "libuv/uv.h"
+
+namespace Lcc {
+    SpscRing::SpscRing(): _size(0),
+                          _owned(false),
+                          _chunk(nullptr),
+                          _control(&_local),
+                          _pendingTail(0),
+                          _headCache(0),
+                          _pendingHead(0),
+                          _tailCache(0),
+                          _error(0),
+                          _local() {
+    }
+
+    SpscRing::~SpscRing() {
+        if (_owned) {
+            ::free(_chunk);
+        }
+    }
+
+    void *SpscRing::operator new(size_t size) {
+        void *ptr = nullptr;
+#if defined(_WIN32)
+        ptr = ::_aligned_malloc(size, alignof(SpscRing));
+#else
+        if (::posix_memalign(&ptr, alignof(SpscRing), size) != 0) {
+            ptr = nullptr;
+        }
+#endif
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void SpscRing::operator delete(void *ptr) {
+#if defined(_WIN32)
+        ::_aligned_free(ptr);
+#else
+        ::free(ptr);
+#endif
+    }
+
+    bool SpscRing::Initialize(unsigned int capacity) {
+        if (_chunk || capacity == 0 || capacity > 0x80000000U) {
+            return false;
+        }
+        unsigned int size = kCacheLine;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _chunk = static_cast<char *>(::malloc(size));
+        if (!_chunk) {
+            return false;
+        }
+        _size = size;
+        _owned = true;
+        return true;
+    }
+
+    bool SpscRing::Attach(SpscControl *control, char *chunk, unsigned int capacity) {
+        if (_chunk || !control || !chunk || capacity < kCacheLine || (capacity & (capacity - 1)) != 0) {
+            return false;
+        }
+        _size = capacity;
+        _chunk = chunk;
+        _control = control;
+        _pendingTail = _control->tail.load(std::memory_order_acquire);
+        _pendingHead = _headCache = _control->head.load(std::memory_order_acquire);
+        _tailCache = _pendingTail;
+        return true;
+    }
+
+    unsigned int SpscRing::Capacity() const {
+        return _size;
+    }
+
+    unsigned int SpscRing::MaxRecordSize() const {
+        // 单条记录不超过一半容量时, 即使需要回绕也一定能在空环中放下
+        return _size / 2 - kHeaderSize;
+    }
+
+    unsigned int SpscRing::UsedSize() const {
+        return _control->tail.load(std::memory_order_relaxed) - _control->head.load(std::memory_order_relaxed);
+    }
+
+    char *SpscRing::Reserve(unsigned int size) {
+        if (!_chunk || size > MaxRecordSize()) {
+            return nullptr;
+        }
+        const unsigned int record = RecordSize(size);
+        unsigned int offset = _pendingTail & (_size - 1);
+        const unsigned int remain = _size - offset;
+        // 尾部剩余空间不足以放下整条记录时, 写入回绕标记并从头部开始
+        const unsigned int need = remain < record ? remain + record : record;
+        if (_pendingTail - _headCache + need > _size) {
+            _headCache = _control->head.load(std::memory_order_acquire);
+            if (_pendingTail - _headCache + need > _size) {
+                return nullptr;
+            }
+        }
+        if (remain < record) {
+            *reinterpret_cast<unsigned int *>(_chunk + offset) = kWrapMarker;
+            _pendingTail += remain;
+            offset = 0;
+        }
+        *reinterpret_cast<unsigned int *>(_chunk + offset) = size;
+        _pendingTail += record;
+        return _chunk + offset + kHeaderSize;
+    }
+
+    bool SpscRing::Write(const char *buf, unsigned int size) {
+        char *data = Reserve(size);
+        if (!data) {
+            return false;
+        }
+        if (size > 0) {
+            memcpy(data, buf, size);
+        }
+        return true;
+    }
+
+    bool SpscRing::Publish() {
+        if (_pendingTail == _control->tail.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        _control->tail.store(_pendingTail, std::memory_order_release);
+        return true;
+    }
+
+    bool SpscRing::Peek(SpscSpan &span) {
+        if (_error != 0) {
+            return false;
+        }
+        if (_pendingHead == _tailCache) {
+            _tailCache = _control->tail.load(std::memory_order_acquire);
+            if (_pendingHead == _tailCache) {
+                return false;
+            }
+        }
+        // 以下只信任本端的_size, 位置与记录头都来自可能被对端改写的内存
+        unsigned int available = _tailCache - _pendingHead;
+        unsigned int offset = _pendingHead & (_size - 1);
+        if (available > _size || (offset & (kAlign - 1)) != 0) {
+            _error = UV_EPROTO;
+            return false;
+        }
+        unsigned int wrap = 0;
+        unsigned int size = *reinterpret_cast<const unsigned int *>(_chunk + offset);
+        if (size == kWrapMarker) {
+            // 回绕标记与其后的记录总是一起发布, 回绕后不会紧跟另一个标记
+            wrap = _size - offset;
+            offset = 0;
+            size = *reinterpret_cast<const unsigned int *>(_chunk);
+            if (size == kWrapMarker || wrap >= available) {
+                _error = UV_EPROTO;
+                return false;
+            }
+            available -= wrap;
+        }
+        // 先限制长度再计算记录大小, 避免RecordSize回绕; 记录需完整落在缓冲区内且已发布
+        if (size > MaxRecordSize() || offset + RecordSize(size) > _size || RecordSize(size) > available) {
+            _error = UV_EPROTO;
+            return false;
+        }
+        span.data = _chunk + offset + kHeaderSize;
+        span.size = size;
+        _pendingHead += wrap + RecordSize(size);
+        return true;
+    }
+
+    unsigned int SpscRing::Read(SpscSpan *spans, unsigned int count) {
+        unsigned int n = 0;
+        while (n < count && Peek(spans[n])) {
+            ++n;
+        }
+        return n;
+    }
+
+    bool SpscRing::Readable() {
+        if (_pendingHead == _tailCache) {
+            _tailCache = _control->tail.load(std::memory_order_acquire);
+        }
+        return _pendingHead != _tailCache;
+    }
+
+    void SpscRing::Release() {
+        _control->head.store(_pendingHead, std::memory_order_release);
+    }
+
+    int SpscRing::LastErrCode() const {
+        return _error;
+    }
+
+    unsigned int SpscRing::RecordSize(unsigned int size) {
+        return (kHeaderSize + size + kAlign - 1) & ~(kAlign - 1);
+    }
+}
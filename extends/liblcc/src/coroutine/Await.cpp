@@ -0,0 +1,217 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstring>
+#include <memory>
+#include "coroutine/Await.h"
+
+namespace Lcc {
+    namespace Await {
+        static const size_t kReadFileChunk = 0x10000;
+
+        /**
+         * 让出当前协程直到请求回调恢复
+         * @param co 当前协程
+         * @return 请求结果
+         */
+        static int Suspend(Coroutine *co) {
+            Coroutine::Yield();
+            return co->Awaiting().status;
+        }
+
+        static void UvFsCallback(uv_fs_t *req) {
+            auto co = static_cast<Coroutine *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
+            co->Awaiting().status = static_cast<int>(uv_fs_get_result(req));
+            co->Resume();
+        }
+
+        /**
+         * 在协程内等待文件请求完成, 协程外同步执行
+         * @param submit 提交请求, 回调为nullptr时同步执行
+         * @param stat 完成后复制文件信息, 可为nullptr
+         * @return 请求结果
+         */
+        template<typename Submit>
+        static int Fs(Submit submit, uv_stat_t *stat = nullptr) {
+            Coroutine *co = Coroutine::Current();
+            if (!co) {
+                uv_fs_t req;
+                int err = submit(&req, nullptr);
+                if (err >= 0) {
+                    err = static_cast<int>(uv_fs_get_result(&req));
+                    if (err >= 0 && stat) {
+                        *stat = *uv_fs_get_statbuf(&req);
+                    }
+                }
+                uv_fs_req_cleanup(&req);
+                return err;
+            }
+            uv_fs_t *req = &co->Awaiting().fs;
+            uv_req_set_data(reinterpret_cast<uv_req_t *>(req), co);
+            int err = submit(req, UvFsCallback);
+            if (err < 0) {
+                uv_fs_req_cleanup(req);
+                return err;
+            }
+            err = Suspend(co);
+            if (err >= 0 && stat) {
+                *stat = *uv_fs_get_statbuf(req);
+            }
+            uv_fs_req_cleanup(req);
+            return err;
+        }
+
+        /**
+         * 缓冲区会在协程挂起期间被写入或读取, 不能位于共享栈上
+         */
+        static bool BufferUnsafe(const void *buf) {
+            Coroutine *co = Coroutine::Current();
+            return co && co->OnShareStack(buf);
+        }
+
+        int Sleep(uv_loop_t *loop, uint64_t ms) {
+            Coroutine *co = Coroutine::Current();
+            if (!co) {
+                return UV_EINVAL;
+            }
+            uv_timer_t *timer = &co->Awaiting().timer;
+            int err = uv_timer_init(loop, timer);
+            if (err < 0) {
+                return err;
+            }
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(timer), co);
+            // 协程可能在事件循环之外长时间运行, 以当前时间为起点计时
+            uv_update_time(loop);
+            err = uv_timer_start(timer, [](uv_timer_t *handle) {
+                // 句柄关闭完成后再恢复, 协程随后可以复用同一块内存
+                uv_close(reinterpret_cast<uv_handle_t *>(handle), [](uv_handle_t *handle) {
+                    auto co = static_cast<Coroutine *>(uv_handle_get_data(handle));
+                    co->Awaiting().status = 0;
+                    co->Resume();
+                });
+            }, ms, 0);
+            if (err < 0) {
+                uv_close(reinterpret_cast<uv_handle_t *>(timer), [](uv_handle_t *handle) {
+                    static_cast<Coroutine *>(uv_handle_get_data(handle))->Resume();
+                });
+                Suspend(co);
+                return err;
+            }
+            return Suspend(co);
+        }
+
+        int FsOpen(uv_loop_t *loop, const char *path, int flags, int mode) {
+            return Fs([&](uv_fs_t *req, uv_fs_cb cb) {
+                return uv_fs_open(loop, req, path, flags, mode, cb);
+            });
+        }
+
+        int FsClose(uv_loop_t *loop, uv_file file) {
+            return Fs([&](uv_fs_t *req, uv_fs_cb cb) {
+                return uv_fs_close(loop, req, file, cb);
+            });
+        }
+
+        int FsRead(uv_loop_t *loop, uv_file file, char *buf, size_t size, int64_t offset) {
+            if (BufferUnsafe(buf)) {
+                return UV_EINVAL;
+            }
+            // uv_buf_t数组由libuv复制到请求内
+            uv_buf_t b = uv_buf_init(buf, static_cast<unsigned int>(size));
+            return Fs([&](uv_fs_t *req, uv_fs_cb cb) {
+                return uv_fs_read(loop, req, file, &b, 1, offset, cb);
+            });
+        }
+
+        int FsWrite(uv_loop_t *loop, uv_file file, const char *buf, size_t size, int64_t offset) {
+            if (BufferUnsafe(buf)) {
+                return UV_EINVAL;
+            }
+            uv_buf_t b = uv_buf_init(const_cast<char *>(buf), static_cast<unsigned int>(size));
+            return Fs([&](uv_fs_t *req, uv_fs_cb cb) {
+                return uv_fs_write(loop, req, file, &b, 1, offset, cb);
+            });
+        }
+
+        int FsStat(uv_loop_t *loop, const char *path, uv_stat_t &stat) {
+            return Fs([&](uv_fs_t *req, uv_fs_cb cb) {
+                return uv_fs_stat(loop, req, path, cb);
+            }, &stat);
+        }
+
+        int ReadFile(uv_loop_t *loop, const char *path, std::string &out) {
+            const int file = FsOpen(loop, path, UV_FS_O_RDONLY);
+            if (file < 0) {
+                return file;
+            }
+            // 读缓冲区放在堆上, 输出字符串的短串缓冲可能位于共享栈
+            std::unique_ptr<char[]> chunk(new char[kReadFileChunk]);
+            out.clear();
+            int err;
+            while ((err = FsRead(loop, file, chunk.get(), kReadFileChunk)) > 0) {
+                out.append(chunk.get(), static_cast<size_t>(err));
+            }
+            FsClose(loop, file);
+            return err < 0 ? err : static_cast<int>(out.size());
+        }
+
+        int GetAddrInfo(uv_loop_t *loop, const char *host, const char *service, std::vector<sockaddr_storage> &out,
+                        int family) {
+            Coroutine *co = Coroutine::Current();
+            if (!co) {
+                return UV_EINVAL;
+            }
+            CoroutineAwait &aw = co->Awaiting();
+            addrinfo hints{};
+            hints.ai_family = family;
+            hints.ai_socktype = SOCK_STREAM;
+            aw.arg = nullptr;
+            uv_req_set_data(&aw.req, co);
+            // 域名、服务名与hints由libuv复制, 可以位于共享栈
+            int err = uv_getaddrinfo(loop, &aw.addrinfo, [](uv_getaddrinfo_t *req, int status, addrinfo *res) {
+                auto co = static_cast<Coroutine *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
+                co->Awaiting().status = status;
+                co->Awaiting().arg = res;
+                co->Resume();
+            }, host, service, &hints);
+            if (err < 0) {
+                return err;
+            }
+            err = Suspend(co);
+            // 恢复后共享栈已换回, 此时才能写入调用者的输出
+            auto res = static_cast<addrinfo *>(aw.arg);
+            aw.arg = nullptr;
+            out.clear();
+            for (addrinfo *it = res; it; it = it->ai_next) {
+                sockaddr_storage addr{};
+                memcpy(&addr, it->ai_addr, it->ai_addrlen);
+                out.push_back(addr);
+            }
+            uv_freeaddrinfo(res);
+            return err;
+        }
+
+        int QueueWork(uv_loop_t *loop, void (*invoke)(void *), void *arg) {
+            Coroutine *co = Coroutine::Current();
+            if (!co || co->OnShareStack(arg)) {
+                return UV_EINVAL;
+            }
+            CoroutineAwait &aw = co->Awaiting();
+            aw.invoke = invoke;
+            aw.arg = arg;
+            uv_req_set_data(&aw.req, co);
+            const int err = uv_queue_work(loop, &aw.work, [](uv_work_t *req) {
+                auto co = static_cast<Coroutine *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
+                co->Awaiting().invoke(co->Awaiting().arg);
+            }, [](uv_work_t *req, int status) {
+                auto co = static_cast<Coroutine *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
+                co->Awaiting().status = status;
+                co->Resume();
+            });
+            if (err < 0) {
+                return err;
+            }
+            return Suspend(co);
+        }
+    }
+}
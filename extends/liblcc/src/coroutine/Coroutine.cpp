@@ -0,0 +1,259 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdlib>
+#include <cstring>
+#include "coroutine/Coroutine.h"
+
+namespace Lcc {
+    static const size_t kDefaultPoolLimit = 4096;
+    static const size_t kDefaultSaveStackLimit = 0x4000;
+
+    /**
+     * 按aco_create的方式重新初始化一个已分配的协程, 保留其保存栈内存
+     */
+    static void _aco_reset(aco_t *co, aco_t *mainCo, aco_share_stack_t *stack, aco_cofuncp_t fp, void *arg,
+                           void *const fpu[2]) {
+        void *ptr = co->save_stack.ptr;
+        const size_t sz = co->save_stack.sz;
+        memset(co, 0, sizeof(aco_t));
+        co->share_stack = stack;
+#ifdef __i386__
+        co->reg[ACO_REG_IDX_RETADDR] = reinterpret_cast<void *>(fp);
+        co->reg[ACO_REG_IDX_SP] = stack->align_retptr;
+#ifndef ACO_CONFIG_SHARE_FPU_MXCSR_ENV
+        co->reg[ACO_REG_IDX_FPU] = fpu[0];
+        co->reg[ACO_REG_IDX_FPU + 1] = fpu[1];
+#endif
+#elif __x86_64__
+        co->reg[ACO_REG_IDX_RETADDR] = reinterpret_cast<void *>(fp);
+        co->reg[ACO_REG_IDX_SP] = stack->align_retptr;
+#ifndef ACO_CONFIG_SHARE_FPU_MXCSR_ENV
+        co->reg[ACO_REG_IDX_FPU] = fpu[0];
+#endif
+#endif
+        co->main_co = mainCo;
+        co->arg = arg;
+        co->fp = fp;
+        co->save_stack.ptr = ptr;
+        co->save_stack.sz = sz;
+        co->save_stack.valid_sz = 0;
+    }
+
+    CoroutineEnv::CoroutineEnv(): _mainCo(nullptr),
+                                  _poolLimit(kDefaultPoolLimit),
+                                  _saveStackLimit(kDefaultSaveStackLimit),
+                                  _fpu(),
+                                  _stats() {
+    }
+
+    CoroutineEnv::~CoroutineEnv() {
+        Release();
+    }
+
+    bool CoroutineEnv::Init(size_t stackSize, unsigned int stacks) {
+        if (_mainCo || stacks == 0) {
+            return false;
+        }
+        aco_thread_init(nullptr);
+        // 与aco_thread_init保存的值一致, 复用协程时写回寄存器上下文
+        aco_save_fpucw_mxcsr(_fpu);
+        _mainCo = aco_create(nullptr, nullptr, 0, nullptr, nullptr);
+        for (unsigned int n = 0; n < stacks; ++n) {
+            _stacks.push_back(Stack{aco_share_stack_new(stackSize), 0});
+        }
+        return true;
+    }
+
+    void CoroutineEnv::Release() {
+        for (auto co: _pool) {
+            aco_destroy(co);
+        }
+        _pool.clear();
+        for (auto &it: _stacks) {
+            aco_share_stack_destroy(it.stack);
+        }
+        _stacks.clear();
+        if (_mainCo) {
+            // 主线程恢复协程返回后aco_gtls_co指向主协程, 释放后需清空避免Current()误判
+            if (aco_gtls_co == _mainCo) {
+                aco_gtls_co = nullptr;
+            }
+            aco_destroy(_mainCo);
+            _mainCo = nullptr;
+        }
+        _stats.pooled = _stats.pooledBytes = 0;
+    }
+
+    void CoroutineEnv::SetPoolLimit(size_t count, size_t saveStack) {
+        _poolLimit = count;
+        _saveStackLimit = saveStack;
+        while (_pool.size() > _poolLimit) {
+            _stats.pooledBytes -= _pool.back()->save_stack.sz;
+            aco_destroy(_pool.back());
+            _pool.pop_back();
+            ++_stats.destroyed;
+        }
+        _stats.pooled = _pool.size();
+    }
+
+    aco_t *CoroutineEnv::Acquire(aco_cofuncp_t fp, void *arg) {
+        if (!_mainCo) {
+            return nullptr;
+        }
+        Stack &stack = PickStack();
+        aco_t *co;
+        if (!_pool.empty()) {
+            co = _pool.back();
+            _pool.pop_back();
+            _stats.pooledBytes -= co->save_stack.sz;
+            _aco_reset(co, _mainCo, stack.stack, fp, arg, _fpu);
+            ++_stats.reused;
+        } else {
+            co = aco_create(_mainCo, stack.stack, 0, fp, arg);
+            ++_stats.created;
+        }
+        ++stack.live;
+        ++_stats.live;
+        _stats.pooled = _pool.size();
+        return co;
+    }
+
+    void CoroutineEnv::Recycle(aco_t *co) {
+        if (!co) {
+            return;
+        }
+        for (auto &it: _stacks) {
+            if (it.stack == co->share_stack) {
+                --it.live;
+                break;
+            }
+        }
+        --_stats.live;
+        _savedStack.Record(co->save_stack.max_cpsz);
+        // 协程未结束时仍可能占用共享栈
+        if (co->share_stack->owner == co) {
+            co->share_stack->owner = nullptr;
+            co->share_stack->align_validsz = 0;
+        }
+        if (_pool.size() < _poolLimit && co->save_stack.sz <= _saveStackLimit) {
+            _pool.push_back(co);
+            _stats.pooledBytes += co->save_stack.sz;
+        } else {
+            aco_destroy(co);
+            ++_stats.destroyed;
+        }
+        _stats.pooled = _pool.size();
+    }
+
+    aco_t *CoroutineEnv::MainCo() const {
+        return _mainCo;
+    }
+
+    unsigned int CoroutineEnv::StackCount() const {
+        return static_cast<unsigned int>(_stacks.size());
+    }
+
+    unsigned int CoroutineEnv::StackLoad(unsigned int index) const {
+        return index < _stacks.size() ? _stacks[index].live : 0;
+    }
+
+    CoroutineStats CoroutineEnv::GetStats() const {
+        return _stats;
+    }
+
+    const Utils::Histogram &CoroutineEnv::SavedStackHistogram() const {
+        return _savedStack;
+    }
+
+    CoroutineEnv::Stack &CoroutineEnv::PickStack() {
+        size_t pick = 0;
+        for (size_t n = 1; n < _stacks.size(); ++n) {
+            if (_stacks[n].live < _stacks[pick].live) {
+                pick = n;
+            }
+        }
+        return _stacks[pick];
+    }
+
+    Coroutine::Coroutine(): _co(nullptr), _env(nullptr), _resumes(0) {
+    }
+
+    Coroutine::~Coroutine() {
+        if (_co) {
+            _env->Recycle(_co);
+            _co = nullptr;
+        }
+    }
+
+    bool Coroutine::Start(CoroutineEnv *env) {
+        if (_co || !env || !env->MainCo() || Current()) {
+            return false;
+        }
+        _env = env;
+        _co = env->Acquire(Coroutine::AcoEntry, this);
+        Resume();
+        return true;
+    }
+
+    void Coroutine::Resume() {
+        if (_co && !_co->is_end) {
+            ++_resumes;
+            aco_resume(_co);
+            ICoroutineSuspend();
+        }
+    }
+
+    bool Coroutine::IsEnd() const {
+        return !_co || _co->is_end;
+    }
+
+    unsigned long long Coroutine::Resumes() const {
+        return _resumes;
+    }
+
+    size_t Coroutine::SavedStackSize() const {
+        return _co ? _co->save_stack.sz : 0;
+    }
+
+    size_t Coroutine::MaxSavedStack() const {
+        return _co ? _co->save_stack.max_cpsz : 0;
+    }
+
+    size_t Coroutine::StackCopies() const {
+        return _co ? _co->save_stack.ct_save + _co->save_stack.ct_restore : 0;
+    }
+
+    CoroutineAwait &Coroutine::Awaiting() {
+        return _await;
+    }
+
+    bool Coroutine::OnShareStack(const void *ptr) const {
+        if (!_co || !_co->share_stack) {
+            return false;
+        }
+        const auto begin = static_cast<const char *>(_co->share_stack->ptr);
+        const auto p = static_cast<const char *>(ptr);
+        return p >= begin && p < begin + _co->share_stack->sz;
+    }
+
+    Coroutine *Coroutine::Current() {
+        aco_t *co = aco_gtls_co;
+        if (co && !aco_is_main_co(co)) {
+            return static_cast<Coroutine *>(co->arg);
+        }
+        return nullptr;
+    }
+
+    void Coroutine::Yield() {
+        if (Current()) {
+            aco_yield();
+        }
+    }
+
+    void Coroutine::AcoEntry() {
+        auto self = static_cast<Coroutine *>(aco_get_arg());
+        self->ICoroutineRun();
+        aco_exit();
+    }
+}
@@ -0,0 +1,100 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include "metrics/LoopMetrics.h"
+#include "metrics/LoopWatchdog.h"
+
+namespace Lcc {
+    namespace Metrics {
+        LoopMetrics::LoopMetrics() : _attached(false), _loop(nullptr), _thread(), _prepareTime(0), _prepareIdle(0),
+                                     _pollExit(0), _checkTime(0), _beats(0), _prepare(), _check() {
+        }
+
+        LoopMetrics::~LoopMetrics() = default;
+
+        bool LoopMetrics::Attach(uv_loop_t *loop, const char *name) {
+            if (_attached || !loop || !name) {
+                return false;
+            }
+            if (_name != name) {
+                _name = name;
+                const std::string labels = "loop=\"" + _name + "\"";
+                auto &registry = Registry::Instance();
+                _iterations = registry.AddCounter("lcc_loop_iterations_total", "Event loop iterations", labels.c_str());
+                _lag = registry.AddHistogram("lcc_loop_lag_seconds", "Time from poll returning to the next poll",
+                                             labels.c_str(), 1e-9);
+                _ioCallbacks = registry.AddHistogram("lcc_loop_callback_seconds", "Callback time per iteration",
+                                                     (labels + ",phase=\"io\"").c_str(), 1e-9);
+                _timerCallbacks = registry.AddHistogram("lcc_loop_callback_seconds", "Callback time per iteration",
+                                                        (labels + ",phase=\"timers\"").c_str(), 1e-9);
+                _stalls = registry.AddCounter("lcc_loop_stalls_total", "Iterations exceeding the stall threshold",
+                                              labels.c_str());
+                _stallTime = registry.AddHistogram("lcc_loop_stall_seconds", "Duration of detected stalls",
+                                                   labels.c_str(), 1e-9);
+            }
+            uv_loop_configure(loop, UV_METRICS_IDLE_TIME);
+            if (uv_prepare_init(loop, &_prepare) != 0) {
+                return false;
+            }
+            if (uv_check_init(loop, &_check) != 0) {
+                uv_close(reinterpret_cast<uv_handle_t *>(&_prepare), nullptr);
+                return false;
+            }
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_prepare), this);
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_check), this);
+            uv_prepare_start(&_prepare, LoopMetrics::UvPrepareCallback);
+            uv_check_start(&_check, LoopMetrics::UvCheckCallback);
+            // 不阻止循环退出
+            uv_unref(reinterpret_cast<uv_handle_t *>(&_prepare));
+            uv_unref(reinterpret_cast<uv_handle_t *>(&_check));
+            _loop = loop;
+            _thread = uv_thread_self();
+            _prepareTime = _pollExit = 0;
+            _attached = true;
+            LoopWatchdog::Instance().Watch(this);
+            return true;
+        }
+
+        void LoopMetrics::Detach() {
+            if (_attached) {
+                _attached = false;
+                LoopWatchdog::Instance().Unwatch(this);
+                uv_close(reinterpret_cast<uv_handle_t *>(&_prepare), nullptr);
+                uv_close(reinterpret_cast<uv_handle_t *>(&_check), nullptr);
+            }
+        }
+
+        const std::string &LoopMetrics::GetName() const {
+            return _name;
+        }
+
+        void LoopMetrics::UvPrepareCallback(uv_prepare_t *handle) {
+            auto self = static_cast<LoopMetrics *>(uv_handle_get_data(reinterpret_cast<uv_handle_t *>(handle)));
+            const uint64_t now = uv_hrtime();
+            if (self->_pollExit) {
+                self->_lag.Record(now - self->_pollExit);
+                self->_timerCallbacks.Record(now - self->_checkTime);
+                self->_iterations.Add();
+            }
+            self->_prepareTime = now;
+            self->_prepareIdle = uv_metrics_idle_time(handle->loop);
+            self->_beats.store(self->_beats.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        void LoopMetrics::UvCheckCallback(uv_check_t *handle) {
+            auto self = static_cast<LoopMetrics *>(uv_handle_get_data(reinterpret_cast<uv_handle_t *>(handle)));
+            const uint64_t now = uv_hrtime();
+            if (self->_prepareTime) {
+                // prepare之后到poll返回之间几乎全部是空闲时间
+                uint64_t pollExit = self->_prepareTime + (uv_metrics_idle_time(handle->loop) - self->_prepareIdle);
+                if (pollExit > now) {
+                    pollExit = now;
+                }
+                self->_ioCallbacks.Record(now - pollExit);
+                self->_pollExit = pollExit;
+                self->_checkTime = now;
+            }
+            self->_beats.store(self->_beats.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+}
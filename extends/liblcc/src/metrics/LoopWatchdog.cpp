@@ -0,0 +1,223 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdlib>
+#include <algorithm>
+#include "metrics/LoopMetrics.h"
+#include "metrics/LoopWatchdog.h"
+
+#if defined(__linux__)
+#include <csignal>
+#include <pthread.h>
+#include <execinfo.h>
+#endif
+
+namespace Lcc {
+    namespace Metrics {
+        namespace {
+            const uint64_t kNanoPerMilli = 1000000;
+            // 信号处理函数与回溯本身占用的栈帧
+            const int kSkipFrames = 2;
+            const int kMaxFrames = 64;
+            // 等待循环线程响应采样信号的时间(毫秒)
+            const unsigned int kCaptureWait = 100;
+
+#if defined(__linux__)
+            // 同一时刻只有检测线程在采样, 结果通过静态缓冲交给检测线程
+            void *_frames[kMaxFrames];
+            std::atomic<int> _depth(-1);
+            struct sigaction _previous;
+
+            void CaptureHandler(int) {
+                _depth.store(backtrace(_frames, kMaxFrames), std::memory_order_release);
+            }
+#endif
+        }
+
+        WatchdogOptions::WatchdogOptions() : threshold(100), interval(0),
+#if defined(__linux__)
+                                             signal(SIGURG),
+#else
+                                             signal(0),
+#endif
+                                             keep(16) {
+        }
+
+        LoopWatchdog &LoopWatchdog::Instance() {
+            // 不析构: 线程中的LoopMetrics可能晚于静态对象析构才注销
+            static auto instance = new LoopWatchdog;
+            return *instance;
+        }
+
+        LoopWatchdog::LoopWatchdog() : _running(false), _thread() {
+            uv_mutex_init(&_mutex);
+            uv_cond_init(&_cond);
+        }
+
+        bool LoopWatchdog::Start(const WatchdogOptions &options) {
+            uv_mutex_lock(&_mutex);
+            if (_running || options.threshold == 0) {
+                uv_mutex_unlock(&_mutex);
+                return false;
+            }
+            _options = options;
+            if (_options.interval == 0) {
+                _options.interval = std::max(_options.threshold / 4, 1U);
+            }
+            const uint64_t now = uv_hrtime();
+            for (auto &watched: _watched) {
+                watched.since = now;
+                watched.stalled = false;
+            }
+#if defined(__linux__)
+            if (_options.signal > 0) {
+                // 首次回溯会加载libgcc, 提前在检测线程外完成, 信号处理函数内不再分配内存
+                void *warm[1];
+                backtrace(warm, 1);
+                struct sigaction action{};
+                action.sa_handler = CaptureHandler;
+                action.sa_flags = SA_RESTART;
+                sigemptyset(&action.sa_mask);
+                sigaction(_options.signal, &action, &_previous);
+            }
+#endif
+            _running = true;
+            uv_mutex_unlock(&_mutex);
+            if (uv_thread_create(&_thread, LoopWatchdog::UvWatchdogMain, this) != 0) {
+                Stop();
+                return false;
+            }
+            return true;
+        }
+
+        void LoopWatchdog::Stop() {
+            uv_mutex_lock(&_mutex);
+            if (!_running) {
+                uv_mutex_unlock(&_mutex);
+                return;
+            }
+            _running = false;
+            uv_cond_signal(&_cond);
+            uv_mutex_unlock(&_mutex);
+            uv_thread_join(&_thread);
+#if defined(__linux__)
+            if (_options.signal > 0) {
+                sigaction(_options.signal, &_previous, nullptr);
+            }
+#endif
+        }
+
+        bool LoopWatchdog::Running() const {
+            return _running;
+        }
+
+        void LoopWatchdog::Watch(LoopMetrics *metrics) {
+            uv_mutex_lock(&_mutex);
+            _watched.push_back(Watched{metrics, metrics->_beats.load(std::memory_order_relaxed), 0, uv_hrtime(), false});
+            uv_mutex_unlock(&_mutex);
+        }
+
+        void LoopWatchdog::Unwatch(LoopMetrics *metrics) {
+            uv_mutex_lock(&_mutex);
+            _watched.erase(std::remove_if(_watched.begin(), _watched.end(), [metrics](const Watched &watched) {
+                return watched.metrics == metrics;
+            }), _watched.end());
+            uv_mutex_unlock(&_mutex);
+        }
+
+        void LoopWatchdog::GetSamples(std::vector<StallSample> &samples) {
+            uv_mutex_lock(&_mutex);
+            samples.assign(_samples.begin(), _samples.end());
+            uv_mutex_unlock(&_mutex);
+        }
+
+        void LoopWatchdog::Export(std::string &out) {
+            std::vector<StallSample> samples;
+            GetSamples(samples);
+            for (const auto &sample: samples) {
+                out.append("loop=").append(sample.loop);
+                out.append(" timestamp=").append(std::to_string(sample.timestamp));
+                out.append(" stalled_ms=").append(std::to_string(sample.duration / kNanoPerMilli)).push_back('\n');
+                for (const auto &frame: sample.frames) {
+                    out.append("    ").append(frame).push_back('\n');
+                }
+                out.push_back('\n');
+            }
+        }
+
+        void LoopWatchdog::Inspect(uint64_t now) {
+            for (auto &watched: _watched) {
+                LoopMetrics *metrics = watched.metrics;
+                const unsigned long long beats = metrics->_beats.load(std::memory_order_relaxed);
+                // 空闲时间带锁, 可以跨线程读取
+                const uint64_t idle = uv_metrics_idle_time(metrics->_loop);
+                if (beats != watched.beats || idle != watched.idle) {
+                    if (watched.stalled) {
+                        metrics->_stallTime.Record(now - watched.since);
+                    }
+                    watched.beats = beats;
+                    watched.idle = idle;
+                    watched.since = now;
+                    watched.stalled = false;
+                    continue;
+                }
+                if (watched.stalled || now - watched.since < _options.threshold * kNanoPerMilli) {
+                    continue;
+                }
+                watched.stalled = true;
+                metrics->_stalls.Add();
+                StallSample sample;
+                sample.loop = metrics->_name;
+                uv_timeval64_t tv{};
+                uv_gettimeofday(&tv);
+                sample.timestamp = tv.tv_sec * 1000 + tv.tv_usec / 1000;
+                sample.duration = now - watched.since;
+                Capture(metrics->_thread, sample.frames);
+                _samples.push_back(std::move(sample));
+                while (_samples.size() > _options.keep) {
+                    _samples.pop_front();
+                }
+            }
+        }
+
+        void LoopWatchdog::Capture(uv_thread_t thread, std::vector<std::string> &frames) const {
+#if defined(__linux__)
+            if (_options.signal <= 0) {
+                return;
+            }
+            _depth.store(-1, std::memory_order_relaxed);
+            if (pthread_kill(thread, _options.signal) != 0) {
+                return;
+            }
+            int depth = -1;
+            for (unsigned int n = 0; n < kCaptureWait; ++n) {
+                depth = _depth.load(std::memory_order_acquire);
+                if (depth >= 0) {
+                    break;
+                }
+                uv_sleep(1);
+            }
+            if (depth <= kSkipFrames) {
+                return;
+            }
+            char **symbols = backtrace_symbols(_frames + kSkipFrames, depth - kSkipFrames);
+            if (symbols) {
+                frames.assign(symbols, symbols + depth - kSkipFrames);
+                free(symbols);
+            }
+#endif
+        }
+
+        void LoopWatchdog::UvWatchdogMain(void *arg) {
+            auto self = static_cast<LoopWatchdog *>(arg);
+            uv_mutex_lock(&self->_mutex);
+            while (self->_running) {
+                uv_cond_timedwait(&self->_cond, &self->_mutex, self->_options.interval * kNanoPerMilli);
+                if (self->_running) {
+                    self->Inspect(uv_hrtime());
+                }
+            }
+            uv_mutex_unlock(&self->_mutex);
+        }
+    }
+}
@@ -0,0 +1,256 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include "metrics/Metrics.h"
+
+namespace Lcc {
+    namespace Metrics {
+        namespace {
+            // 线程退出时归还分片
+            struct ShardHolder {
+                Slot *slots = nullptr;
+
+                ~ShardHolder() {
+                    if (slots) {
+                        Registry::Instance().ReleaseShard(slots);
+                    }
+                }
+            };
+
+            thread_local ShardHolder _holder;
+
+            void AppendNumber(std::string &out, double value) {
+                char buf[32];
+                const int n = snprintf(buf, sizeof(buf), "%.9g", value);
+                out.append(buf, n > 0 ? static_cast<size_t>(n) : 0);
+            }
+
+            void AppendNumber(std::string &out, unsigned long long value) {
+                char buf[32];
+                const int n = snprintf(buf, sizeof(buf), "%llu", value);
+                out.append(buf, n > 0 ? static_cast<size_t>(n) : 0);
+            }
+
+            void AppendNumber(std::string &out, long long value) {
+                char buf[32];
+                const int n = snprintf(buf, sizeof(buf), "%lld", value);
+                out.append(buf, n > 0 ? static_cast<size_t>(n) : 0);
+            }
+
+            /**
+             * 输出 name{labels,extra}
+             */
+            void AppendSeries(std::string &out, const std::string &name, const char *suffix, const std::string &labels,
+                              const std::string &extra) {
+                out.append(name).append(suffix);
+                if (!labels.empty() || !extra.empty()) {
+                    out.push_back('{');
+                    out.append(labels);
+                    if (!labels.empty() && !extra.empty()) {
+                        out.push_back(',');
+                    }
+                    out.append(extra);
+                    out.push_back('}');
+                }
+                out.push_back(' ');
+            }
+        }
+
+        static_assert(Histogram::kSlots <= Shard::kSlots - Shard::kDiscardSlot, "discard area too small");
+
+        thread_local Slot *Shard::_local = nullptr;
+
+        Slot *Shard::Attach() {
+            Slot *slots = Registry::Instance().AcquireShard();
+            _holder.slots = slots;
+            _local = slots;
+            return slots;
+        }
+
+        unsigned long long Counter::Value() const {
+            unsigned long long value = 0;
+            Registry::Instance().Sum(_slot, 1, &value);
+            return value;
+        }
+
+        long long Gauge::Value() const {
+            unsigned long long value = 0;
+            Registry::Instance().Sum(_slot, 1, &value);
+            return static_cast<long long>(value);
+        }
+
+        void Histogram::Collect(Utils::Histogram &out) const {
+            std::vector<unsigned long long> sums(kSlots);
+            Registry::Instance().Sum(_slot, kSlots, sums.data());
+            out.MergeBuckets(sums.data() + 2, sums[1]);
+        }
+
+        Registry &Registry::Instance() {
+            // 不析构: 线程退出归还分片可能晚于静态对象析构
+            static auto instance = new Registry;
+            return *instance;
+        }
+
+        Registry::Registry() : _nextSlot(0) {
+        }
+
+        Counter Registry::AddCounter(const char *name, const char *help, const char *labels) {
+            return Counter(Define(Type::Counter, name, help, labels, 1, 1.0));
+        }
+
+        Gauge Registry::AddGauge(const char *name, const char *help, const char *labels) {
+            return Gauge(Define(Type::Gauge, name, help, labels, 1, 1.0));
+        }
+
+        Histogram Registry::AddHistogram(const char *name, const char *help, const char *labels, double scale) {
+            return Histogram(Define(Type::Histogram, name, help, labels, Histogram::kSlots, scale));
+        }
+
+        void Registry::Export(std::string &out) {
+            std::vector<Definition> definitions;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                definitions = _definitions;
+            }
+            std::vector<bool> done(definitions.size(), false);
+            for (size_t i = 0; i < definitions.size(); ++i) {
+                if (done[i]) {
+                    continue;
+                }
+                const Definition &head = definitions[i];
+                out.append("# HELP ").append(head.name).push_back(' ');
+                out.append(head.help).push_back('\n');
+                out.append("# TYPE ").append(head.name);
+                switch (head.type) {
+                    case Type::Counter:
+                        out.append(" counter\n");
+                        break;
+                    case Type::Gauge:
+                        out.append(" gauge\n");
+                        break;
+                    default:
+                        out.append(" histogram\n");
+                        break;
+                }
+                for (size_t j = i; j < definitions.size(); ++j) {
+                    const Definition &def = definitions[j];
+                    if (done[j] || def.name != head.name) {
+                        continue;
+                    }
+                    done[j] = true;
+                    if (def.type == Type::Histogram) {
+                        ExportHistogram(def, out);
+                        continue;
+                    }
+                    unsigned long long value = 0;
+                    Sum(def.slot, 1, &value);
+                    AppendSeries(out, def.name, "", def.labels, std::string());
+                    if (def.type == Type::Gauge) {
+                        AppendNumber(out, static_cast<long long>(value));
+                    } else {
+                        AppendNumber(out, value);
+                    }
+                    out.push_back('\n');
+                }
+            }
+        }
+
+        void Registry::Sum(unsigned int slot, unsigned int count, unsigned long long *sums) {
+            for (unsigned int n = 0; n < count; ++n) {
+                sums[n] = 0;
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto shard: _shards) {
+                for (unsigned int n = 0; n < count; ++n) {
+                    sums[n] += shard[slot + n].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        unsigned int Registry::Allocate(unsigned int count) {
+            if (_nextSlot + count > Shard::kDiscardSlot) {
+                return Shard::kDiscardSlot;
+            }
+            const unsigned int slot = _nextSlot;
+            _nextSlot += count;
+            return slot;
+        }
+
+        unsigned int Registry::Define(Type type, const char *name, const char *help, const char *labels,
+                                      unsigned int count, double scale) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            // 重复注册(如线程重启)复用已有的槽
+            for (const auto &def: _definitions) {
+                if (def.type == type && def.name == name && def.labels == (labels ? labels : "")) {
+                    return def.slot;
+                }
+            }
+            const unsigned int slot = Allocate(count);
+            if (slot == Shard::kDiscardSlot) {
+                return slot;
+            }
+            _definitions.push_back(Definition{type, slot, scale, name, help ? help : "", labels ? labels : ""});
+            return slot;
+        }
+
+        void Registry::ExportHistogram(const Definition &def, std::string &out) {
+            std::vector<unsigned long long> sums(Histogram::kSlots);
+            Sum(def.slot, Histogram::kSlots, sums.data());
+            const unsigned long long *buckets = sums.data() + 2;
+            unsigned int last = 0;
+            for (unsigned int n = 0; n < Utils::Histogram::kBuckets; ++n) {
+                if (buckets[n]) {
+                    last = n;
+                }
+            }
+            // 按2的幂合并子桶输出, 到最高的非空分桶为止
+            unsigned long long cumulative = 0;
+            for (unsigned int n = 0; sums[0] > 0 && n < Utils::Histogram::kBuckets; ++n) {
+                cumulative += buckets[n];
+                const bool groupEnd = n + 1 == Utils::Histogram::kLinear ||
+                                      (n >= Utils::Histogram::kLinear &&
+                                       (n - Utils::Histogram::kLinear) % Utils::Histogram::kSubBuckets ==
+                                       Utils::Histogram::kSubBuckets - 1);
+                if (!groupEnd) {
+                    continue;
+                }
+                std::string le("le=\"");
+                AppendNumber(le, static_cast<double>(Utils::Histogram::BucketUpper(n)) * def.scale);
+                le.push_back('"');
+                AppendSeries(out, def.name, "_bucket", def.labels, le);
+                AppendNumber(out, cumulative);
+                out.push_back('\n');
+                if (n >= last) {
+                    break;
+                }
+            }
+            AppendSeries(out, def.name, "_bucket", def.labels, "le=\"+Inf\"");
+            AppendNumber(out, sums[0]);
+            out.push_back('\n');
+            AppendSeries(out, def.name, "_sum", def.labels, std::string());
+            AppendNumber(out, static_cast<double>(sums[1]) * def.scale);
+            out.push_back('\n');
+            AppendSeries(out, def.name, "_count", def.labels, std::string());
+            AppendNumber(out, sums[0]);
+            out.push_back('\n');
+        }
+
+        Slot *Registry::AcquireShard() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_freeShards.empty()) {
+                Slot *slots = _freeShards.back();
+                _freeShards.pop_back();
+                return slots;
+            }
+            auto slots = new Slot[Shard::kSlots]();
+            _shards.push_back(slots);
+            return slots;
+        }
+
+        void Registry::ReleaseShard(Slot *slots) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _freeShards.push_back(slots);
+        }
+    }
+}
@@ -0,0 +1,334 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include "network/CoTcpServer.h"
+
+namespace Lcc {
+    static const size_t kDefaultWriteHighWater = 0x40000;
+    static const unsigned int kDefaultMaxFrameSize = 0x100000;
+
+    CoSession::CoSession(CoTcpServer *server, unsigned int session): _server(server),
+                                                                     _session(session),
+                                                                     _error(0),
+                                                                     _closed(false),
+                                                                     _detached(false),
+                                                                     _timerInit(false),
+                                                                     _timerClosed(false),
+                                                                     _wait(Wait::None),
+                                                                     _need(0),
+                                                                     _timer() {
+    }
+
+    CoSession::~CoSession() = default;
+
+    unsigned int CoSession::GetSession() const {
+        return _session;
+    }
+
+    int CoSession::Read(char *buf, unsigned int size) {
+        while (_input.UsedSize() < size) {
+            if (_closed) {
+                return _error ? _error : UV_EOF;
+            }
+            _need = size;
+            Await(Wait::Read);
+        }
+        return static_cast<int>(_input.Read(buf, size));
+    }
+
+    int CoSession::ReadFrame(std::string &frame) {
+        unsigned char head[4] = {0};
+        int err = Read(reinterpret_cast<char *>(head), sizeof(head));
+        if (err < 0) {
+            return err;
+        }
+        const unsigned int size = static_cast<unsigned int>(head[0]) << 24 | static_cast<unsigned int>(head[1]) << 16 |
+                                  static_cast<unsigned int>(head[2]) << 8 | static_cast<unsigned int>(head[3]);
+        if (size > _server->_maxFrameSize) {
+            Close();
+            return UV_E2BIG;
+        }
+        frame.resize(size);
+        if (size > 0) {
+            err = Read(&frame[0], size);
+            if (err < 0) {
+                return err;
+            }
+        }
+        return static_cast<int>(size);
+    }
+
+    bool CoSession::Write(const char *buf, unsigned int size) {
+        if (_closed) {
+            return false;
+        }
+        _server->_server.SessionWrite(_session, buf, size);
+        while (!_closed && _server->_server.SessionWriteQueueSize(_session) > _server->_writeHighWater) {
+            Await(Wait::Write);
+        }
+        return !_closed;
+    }
+
+    bool CoSession::WriteFrame(const char *buf, unsigned int size) {
+        const char head[4] = {
+            static_cast<char>(size >> 24), static_cast<char>(size >> 16), static_cast<char>(size >> 8),
+            static_cast<char>(size)
+        };
+        if (_closed) {
+            return false;
+        }
+        _server->_server.SessionWrite(_session, head, sizeof(head));
+        return Write(buf, size);
+    }
+
+    bool CoSession::Sleep(unsigned int ms) {
+        if (_closed) {
+            return false;
+        }
+        if (!_timerInit) {
+            uv_timer_init(_server->_loop, &_timer);
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_timer), this);
+            _timerInit = true;
+        }
+        uv_timer_start(&_timer, CoSession::UvSleepCallback, ms, 0);
+        Await(Wait::Sleep);
+        return !_closed;
+    }
+
+    void CoSession::Close() {
+        if (!_closed) {
+            _server->_server.ShutdownSession(_session);
+        }
+    }
+
+    bool CoSession::IsClosed() const {
+        return _closed;
+    }
+
+    int CoSession::LastErrCode() const {
+        return _error;
+    }
+
+    void CoSession::ICoroutineRun() {
+        _server->ISessionRun(*this);
+    }
+
+    void CoSession::ICoroutineSuspend() {
+        // 可能在此释放自身, 之后不得访问成员
+        _server->SessionYield(this);
+    }
+
+    void CoSession::Await(Wait wait) {
+        _wait = wait;
+        Yield();
+    }
+
+    void CoSession::Wake(Wait wait) {
+        if (_wait == wait) {
+            _wait = Wait::None;
+            _server->ResumeSession(this);
+        }
+    }
+
+    bool CoSession::TryRelease() {
+        if (!IsEnd() || !_detached) {
+            return false;
+        }
+        if (_timerInit && !_timerClosed) {
+            if (!uv_is_closing(reinterpret_cast<const uv_handle_t *>(&_timer))) {
+                uv_close(reinterpret_cast<uv_handle_t *>(&_timer), CoSession::UvTimerCloseCallback);
+            }
+            return false;
+        }
+        _server->_sessionMap.erase(_session);
+        delete this;
+        return true;
+    }
+
+    void CoSession::UvSleepCallback(uv_timer_t *handle) {
+        auto self = static_cast<CoSession *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        self->Wake(Wait::Sleep);
+    }
+
+    void CoSession::UvTimerCloseCallback(uv_handle_t *handle) {
+        auto self = static_cast<CoSession *>(uv_handle_get_data(handle));
+        self->_timerClosed = true;
+        self->TryRelease();
+    }
+
+    CoTcpServer::CoTcpServer(uv_loop_t *loop, size_t stackSize, unsigned int stacks): _loop(loop),
+                                                                                       _stackSize(stackSize),
+                                                                                       _stacks(stacks),
+                                                                                       _writeHighWater(kDefaultWriteHighWater),
+                                                                                       _maxFrameSize(kDefaultMaxFrameSize),
+                                                                                       _server(this),
+                                                                                       _resuming(false),
+                                                                                       _idleInit(false),
+                                                                                       _resumeIdle() {
+    }
+
+    CoTcpServer::~CoTcpServer() {
+        // 未结束的协程无法再恢复, 直接回收
+        for (auto &it: _sessionMap) {
+            delete it.second;
+        }
+        _sessionMap.clear();
+        _resumeVec.clear();
+        _env.Release();
+    }
+
+    bool CoTcpServer::Listen(const char *host) {
+        if (!_env.MainCo() && !_env.Init(_stackSize, _stacks)) {
+            return false;
+        }
+        if (!_idleInit) {
+            uv_idle_init(_loop, &_resumeIdle);
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_resumeIdle), this);
+            _idleInit = true;
+        }
+        _server.Listen(host);
+        return true;
+    }
+
+    void CoTcpServer::Shutdown() {
+        _server.Shutdown();
+        if (_idleInit && !uv_is_closing(reinterpret_cast<const uv_handle_t *>(&_resumeIdle))) {
+            uv_close(reinterpret_cast<uv_handle_t *>(&_resumeIdle), nullptr);
+        }
+    }
+
+    void CoTcpServer::Enable(ProtocolPluginCreator *creator) {
+        _server.Enable(creator);
+    }
+
+    void CoTcpServer::SetMaxFrameSize(unsigned int size) {
+        _maxFrameSize = size;
+    }
+
+    void CoTcpServer::SetWriteHighWater(size_t size) {
+        _writeHighWater = size;
+    }
+
+    size_t CoTcpServer::SessionCount() const {
+        return _sessionMap.size();
+    }
+
+    CoroutineEnv &CoTcpServer::GetCoroutineEnv() {
+        return _env;
+    }
+
+    TcpServer &CoTcpServer::GetServer() {
+        return _server;
+    }
+
+    bool CoTcpServer::IServerInit(StreamHandle &handle) {
+        return handle.Init(_loop) == 0;
+    }
+
+    void CoTcpServer::IServerListenReport(bool listened, int err, const char *errMsg) {
+    }
+
+    void CoTcpServer::IServerShutdown() {
+    }
+
+    void CoTcpServer::IServerSessionOpen(unsigned int session) {
+        auto coSession = new CoSession(this, session);
+        _sessionMap[session] = coSession;
+        if (!coSession->Start(&_env)) {
+            coSession->Close();
+        }
+    }
+
+    void CoTcpServer::IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) {
+        const auto coSession = GetCoSession(session);
+        if (coSession) {
+            coSession->_input.Write(buf, size);
+            if (coSession->_input.UsedSize() >= coSession->_need) {
+                coSession->Wake(CoSession::Wait::Read);
+            }
+        }
+    }
+
+    void CoTcpServer::IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) {
+        const auto coSession = GetCoSession(session);
+        if (coSession) {
+            coSession->_closed = true;
+            coSession->_error = err;
+            if (coSession->_wait == CoSession::Wait::Sleep) {
+                uv_timer_stop(&coSession->_timer);
+            }
+            if (coSession->_wait != CoSession::Wait::None) {
+                coSession->Wake(coSession->_wait);
+            }
+        }
+    }
+
+    void CoTcpServer::IServerSessionAfterClose(unsigned int session) {
+        const auto coSession = GetCoSession(session);
+        if (coSession) {
+            coSession->_closed = true;
+            coSession->_detached = true;
+            coSession->TryRelease();
+        }
+    }
+
+    void CoTcpServer::IServerSessionWriteDrain(unsigned int session) {
+        const auto coSession = GetCoSession(session);
+        if (coSession) {
+            coSession->Wake(CoSession::Wait::Write);
+        }
+    }
+
+    CoSession *CoTcpServer::GetCoSession(unsigned int session) {
+        const auto it = _sessionMap.find(session);
+        if (it != _sessionMap.end()) {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    void CoTcpServer::ResumeSession(CoSession *coSession) {
+        if (!Coroutine::Current()) {
+            coSession->Resume();
+            return;
+        }
+        // 协程内不能嵌套恢复, 唤醒方为会话协程时在其SessionYield中恢复, 否则等下一轮事件循环
+        _resumeVec.emplace_back(coSession);
+        if (_idleInit && !uv_is_closing(reinterpret_cast<const uv_handle_t *>(&_resumeIdle))) {
+            uv_idle_start(&_resumeIdle, CoTcpServer::UvResumeCallback);
+        }
+    }
+
+    void CoTcpServer::ResumePending() {
+        if (_resuming || Coroutine::Current()) {
+            return;
+        }
+        _resuming = true;
+        std::vector<CoSession *> resumeVec;
+        while (!_resumeVec.empty()) {
+            resumeVec.swap(_resumeVec);
+            for (auto coSession: resumeVec) {
+                coSession->Resume();
+            }
+            resumeVec.clear();
+        }
+        _resuming = false;
+        if (_idleInit) {
+            uv_idle_stop(&_resumeIdle);
+        }
+    }
+
+    void CoTcpServer::SessionYield(CoSession *coSession) {
+        if (coSession->IsEnd()) {
+            // 协程返回即结束会话, 连接关闭后回收
+            coSession->Close();
+            coSession->TryRelease();
+        }
+        ResumePending();
+    }
+
+    void CoTcpServer::UvResumeCallback(uv_idle_t *handle) {
+        auto self = static_cast<CoTcpServer *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        self->ResumePending();
+    }
+}
@@ -0,0 +1,91 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include "metrics/Metrics.h"
+#include "metrics/LoopWatchdog.h"
+#include "network/MetricsServer.h"
+
+namespace Lcc {
+    MetricsServer::MetricsServer(uv_loop_t *loop) : _listening(false), _loop(loop), _server(this) {
+    }
+
+    MetricsServer::~MetricsServer() = default;
+
+    void MetricsServer::Listen(const char *host) {
+        _server.Listen(host);
+    }
+
+    void MetricsServer::Shutdown() {
+        _server.Shutdown();
+    }
+
+    bool MetricsServer::IsListening() const {
+        return _listening;
+    }
+
+    TcpServer &MetricsServer::GetServer() {
+        return _server;
+    }
+
+    bool MetricsServer::IServerInit(StreamHandle &handle) {
+        return handle.Init(_loop) == 0;
+    }
+
+    void MetricsServer::IServerListenReport(bool listened, int err, const char *errMsg) {
+        _listening = listened;
+    }
+
+    void MetricsServer::IServerShutdown() {
+        _listening = false;
+    }
+
+    void MetricsServer::IServerSessionOpen(unsigned int session) {
+        _requestMap[session];
+    }
+
+    void MetricsServer::IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) {
+        auto it = _requestMap.find(session);
+        if (it == _requestMap.end()) {
+            return;
+        }
+        std::string &request = it->second;
+        request.append(buf, size);
+        if (request.find("\r\n\r\n") != std::string::npos) {
+            Respond(session, request);
+            _requestMap.erase(it);
+        } else if (request.size() > kMaxRequestSize) {
+            _requestMap.erase(it);
+            _server.ShutdownSession(session);
+        }
+    }
+
+    void MetricsServer::IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) {
+    }
+
+    void MetricsServer::IServerSessionAfterClose(unsigned int session) {
+        _requestMap.erase(session);
+    }
+
+    void MetricsServer::Respond(unsigned int session, const std::string &request) {
+        std::string body;
+        const char *status = "404 Not Found";
+        const char *type = "text/plain";
+        if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 13, "GET /metrics?") == 0) {
+            Metrics::Registry::Instance().Export(body);
+            status = "200 OK";
+            type = "text/plain; version=0.0.4";
+        } else if (request.compare(0, 12, "GET /stalls ") == 0) {
+            Metrics::LoopWatchdog::Instance().Export(body);
+            status = "200 OK";
+        } else {
+            body = "not found\n";
+        }
+        std::string response("HTTP/1.0 ");
+        response.append(status).append("\r\nContent-Type: ").append(type);
+        response.append("\r\nContent-Length: ").append(std::to_string(body.size()));
+        response.append("\r\nConnection: close\r\n\r\n").append(body);
+        _server.SessionWrite(session, response.data(), static_cast<unsigned int>(response.size()));
+        // Shutdown会先发送完写队列再关闭
+        _server.ShutdownSession(session);
+    }
+}
@@ -0,0 +1,54 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include "libuv/uv.h"
+#include "network/NetMetrics.h"
+
+namespace Lcc {
+    NetMetrics &NetMetrics::Instance() {
+        static NetMetrics metrics;
+        return metrics;
+    }
+
+    CloseReason NetMetrics::Classify(int err) {
+        switch (err) {
+            case 0:
+                return CloseReason::Local;
+            case UV_EOF:
+                return CloseReason::Eof;
+            case UV_ECONNRESET:
+            case UV_EPIPE:
+                return CloseReason::Reset;
+            case UV_ETIMEDOUT:
+                return CloseReason::Timeout;
+            default:
+                return CloseReason::Error;
+        }
+    }
+
+    NetMetrics::NetMetrics() {
+        auto &registry = Metrics::Registry::Instance();
+        bytesIn = registry.AddCounter("lcc_net_bytes_in_total", "Bytes read from sockets");
+        bytesOut = registry.AddCounter("lcc_net_bytes_out_total", "Bytes written to sockets");
+        messagesIn = registry.AddCounter("lcc_net_messages_in_total", "Messages delivered to the application");
+        messagesOut = registry.AddCounter("lcc_net_messages_out_total", "Messages written by the application");
+        accepts = registry.AddCounter("lcc_net_accepts_total", "Accepted connections");
+        static const char *reasons[] = {
+            "reason=\"local\"", "reason=\"eof\"", "reason=\"reset\"", "reason=\"timeout\"", "reason=\"error\"",
+        };
+        for (int n = 0; n < static_cast<int>(CloseReason::Count); ++n) {
+            closes[n] = registry.AddCounter("lcc_net_closes_total", "Closed connections by reason", reasons[n]);
+        }
+        writeQueueBytes = registry.AddGauge("lcc_net_write_queue_bytes", "Bytes queued for writing");
+        tlsHandshake = registry.AddHistogram("lcc_tls_handshake_seconds", "TLS handshake duration", nullptr, 1e-9);
+        wsHandshake = registry.AddHistogram("lcc_ws_handshake_seconds", "WebSocket handshake duration", nullptr, 1e-9);
+        static const char *sources[] = {
+            "source=\"literal\"", "source=\"hit\"", "source=\"negative_hit\"", "source=\"query\"",
+            "source=\"coalesced\"",
+        };
+        for (int n = 0; n < static_cast<int>(ResolveSource::Count); ++n) {
+            resolves[n] = registry.AddCounter("lcc_dns_resolves_total", "Host resolutions by source", sources[n]);
+        }
+        resolveTime = registry.AddHistogram("lcc_dns_query_seconds", "uv_getaddrinfo duration", nullptr, 1e-9);
+    }
+}
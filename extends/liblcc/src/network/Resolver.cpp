@@ -0,0 +1,233 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstring>
+#include <algorithm>
+#include "network/Resolver.h"
+#include "network/NetMetrics.h"
+
+namespace Lcc {
+    namespace {
+        const uint64_t kNanoPerMilli = 1000000;
+
+        inline void Count(ResolveSource source) {
+            NetMetrics::Instance().resolves[static_cast<int>(source)].Add();
+        }
+
+        inline bool SameAddress(const ResolvedAddress &a, const ResolvedAddress &b) {
+            if (a.addr.sa_family != b.addr.sa_family) {
+                return false;
+            }
+            if (a.addr.sa_family == AF_INET) {
+                return a.addr4.sin_addr.s_addr == b.addr4.sin_addr.s_addr;
+            }
+            return memcmp(&a.addr6.sin6_addr, &b.addr6.sin6_addr, sizeof(a.addr6.sin6_addr)) == 0 &&
+                   a.addr6.sin6_scope_id == b.addr6.sin6_scope_id;
+        }
+    }
+
+    struct Resolver::Lookup {
+        uv_getaddrinfo_t req;
+        Resolver *resolver;
+        std::string host;
+        uint64_t start;
+    };
+
+    ResolverOptions::ResolverOptions() : ttl(60000), negativeTtl(5000), capacity(1024) {
+    }
+
+    Resolver &Resolver::Local() {
+        // 线程退出时仍可能有查询未完成, 不析构
+        static thread_local auto resolver = new Resolver;
+        return *resolver;
+    }
+
+    bool Resolver::ParseLiteral(const char *host, ResolvedAddress &address) {
+        memset(&address, 0, sizeof(address));
+        if (uv_inet_pton(AF_INET, host, &address.addr4.sin_addr) == 0) {
+            address.addr4.sin_family = AF_INET;
+            return true;
+        }
+        if (uv_inet_pton(AF_INET6, host, &address.addr6.sin6_addr) == 0) {
+            address.addr6.sin6_family = AF_INET6;
+            return true;
+        }
+        return false;
+    }
+
+    void Resolver::SetOptions(const ResolverOptions &options) {
+        _options = options;
+    }
+
+    bool Resolver::Resolve(uv_loop_t *loop, const char *host, ResolveImplement *impl, int &status,
+                           std::vector<ResolvedAddress> &addresses) {
+        ResolvedAddress literal{};
+        if (ParseLiteral(host, literal)) {
+            Count(ResolveSource::Literal);
+            status = 0;
+            addresses.assign(1, literal);
+            return true;
+        }
+        const uint64_t now = uv_hrtime();
+        auto it = _entries.find(host);
+        if (it != _entries.end()) {
+            Entry &entry = it->second;
+            if (entry.lookup && !entry.pinned) {
+                Count(ResolveSource::Coalesced);
+                entry.waiters.push_back(impl);
+                return false;
+            }
+            if (entry.pinned || entry.expire > now) {
+                Count(entry.status == 0 ? ResolveSource::Hit : ResolveSource::NegativeHit);
+                status = entry.status;
+                addresses = entry.addresses;
+                return true;
+            }
+        } else {
+            Evict(now);
+            it = _entries.emplace(host, Entry{false, 0, 0, {}, nullptr, {}}).first;
+        }
+        Count(ResolveSource::Query);
+        auto lookup = new Lookup;
+        lookup->resolver = this;
+        lookup->host = host;
+        lookup->start = now;
+        uv_req_set_data(reinterpret_cast<uv_req_t *>(&lookup->req), lookup);
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        const int err = uv_getaddrinfo(loop, &lookup->req, Resolver::UvResolveCallback, host, nullptr, &hints);
+        if (err != 0) {
+            delete lookup;
+            _entries.erase(it);
+            status = err;
+            addresses.clear();
+            return true;
+        }
+        it->second.lookup = lookup;
+        it->second.waiters.push_back(impl);
+        return false;
+    }
+
+    void Resolver::Pin(const char *host, const std::vector<ResolvedAddress> &addresses) {
+        auto it = _entries.find(host);
+        if (addresses.empty()) {
+            if (it != _entries.end() && it->second.pinned) {
+                if (it->second.lookup) {
+                    it->second.pinned = false;
+                } else {
+                    _entries.erase(it);
+                }
+            }
+            return;
+        }
+        if (it == _entries.end()) {
+            it = _entries.emplace(host, Entry{false, 0, 0, {}, nullptr, {}}).first;
+        }
+        Entry &entry = it->second;
+        entry.pinned = true;
+        entry.status = 0;
+        entry.addresses = addresses;
+    }
+
+    void Resolver::Cancel(ResolveImplement *impl) {
+        for (auto &it: _entries) {
+            auto &waiters = it.second.waiters;
+            waiters.erase(std::remove(waiters.begin(), waiters.end(), impl), waiters.end());
+        }
+        if (_reporting) {
+            std::replace(_reporting->begin(), _reporting->end(), impl, static_cast<ResolveImplement *>(nullptr));
+        }
+    }
+
+    void Resolver::Clear() {
+        for (auto it = _entries.begin(); it != _entries.end();) {
+            if (it->second.lookup || it->second.pinned) {
+                ++it;
+            } else {
+                it = _entries.erase(it);
+            }
+        }
+    }
+
+    size_t Resolver::Size() const {
+        return _entries.size();
+    }
+
+    void Resolver::Evict(uint64_t now) {
+        if (_entries.size() < _options.capacity) {
+            return;
+        }
+        auto oldest = _entries.end();
+        for (auto it = _entries.begin(); it != _entries.end();) {
+            if (it->second.lookup || it->second.pinned) {
+                ++it;
+            } else if (it->second.expire <= now) {
+                it = _entries.erase(it);
+            } else {
+                if (oldest == _entries.end() || it->second.expire < oldest->second.expire) {
+                    oldest = it;
+                }
+                ++it;
+            }
+        }
+        if (_entries.size() >= _options.capacity && oldest != _entries.end()) {
+            _entries.erase(oldest);
+        }
+    }
+
+    void Resolver::UvResolveCallback(uv_getaddrinfo_t *req, int status, addrinfo *res) {
+        auto lookup = static_cast<Lookup *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
+        auto self = lookup->resolver;
+        const uint64_t now = uv_hrtime();
+        NetMetrics::Instance().resolveTime.Record(now - lookup->start);
+        std::vector<ResolvedAddress> addresses;
+        if (status == 0) {
+            for (auto ai = res; ai; ai = ai->ai_next) {
+                ResolvedAddress address{};
+                if (ai->ai_family == AF_INET && ai->ai_addrlen >= sizeof(sockaddr_in)) {
+                    memcpy(&address.addr4, ai->ai_addr, sizeof(sockaddr_in));
+                } else if (ai->ai_family == AF_INET6 && ai->ai_addrlen >= sizeof(sockaddr_in6)) {
+                    memcpy(&address.addr6, ai->ai_addr, sizeof(sockaddr_in6));
+                } else {
+                    continue;
+                }
+                if (std::none_of(addresses.begin(), addresses.end(), [&address](const ResolvedAddress &it) {
+                    return SameAddress(it, address);
+                })) {
+                    addresses.push_back(address);
+                }
+            }
+            if (addresses.empty()) {
+                status = UV_EAI_NODATA;
+            }
+        }
+        uv_freeaddrinfo(res);
+        std::vector<ResolveImplement *> waiters;
+        auto it = self->_entries.find(lookup->host);
+        if (it != self->_entries.end() && it->second.lookup == lookup) {
+            Entry &entry = it->second;
+            entry.lookup = nullptr;
+            waiters.swap(entry.waiters);
+            const unsigned int ttl = status == 0 ? self->_options.ttl : self->_options.negativeTtl;
+            if (entry.pinned) {
+                // 查询期间被固定, 保留固定的结果
+            } else if (ttl == 0 || status == UV_EAI_CANCELED) {
+                self->_entries.erase(it);
+            } else {
+                entry.status = status;
+                entry.expire = now + ttl * kNanoPerMilli;
+                entry.addresses = addresses;
+            }
+        }
+        delete lookup;
+        auto previous = self->_reporting;
+        self->_reporting = &waiters;
+        for (auto waiter: waiters) {
+            if (waiter) {
+                waiter->IResolveReport(status, addresses);
+            }
+        }
+        self->_reporting = previous;
+    }
+}
@@ -0,0 +1,356 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdlib>
+#include <algorithm>
+#include "network/Rpc.h"
+
+namespace Lcc {
+    static const unsigned int kSeqIndexBits = 16;
+    static const unsigned int kSeqIndexMask = (1U << kSeqIndexBits) - 1;
+
+    bool RpcMessage::Decode(const char *buf, unsigned int size, RpcMessage &msg) {
+        if (size < kHeadSize) {
+            return false;
+        }
+        const auto p = reinterpret_cast<const unsigned char *>(buf);
+        if (p[2] > static_cast<unsigned char>(RpcKind::Error)) {
+            return false;
+        }
+        msg.id = static_cast<unsigned short>(p[0] << 8 | p[1]);
+        msg.kind = static_cast<RpcKind>(p[2]);
+        msg.seq = static_cast<unsigned int>(p[3]) << 24 | static_cast<unsigned int>(p[4]) << 16 |
+                  static_cast<unsigned int>(p[5]) << 8 | p[6];
+        msg.data = buf + kHeadSize;
+        msg.size = size - kHeadSize;
+        return true;
+    }
+
+    void RpcMessage::EncodeHead(unsigned short id, RpcKind kind, unsigned int seq, char *out) {
+        out[0] = static_cast<char>(id >> 8);
+        out[1] = static_cast<char>(id);
+        out[2] = static_cast<char>(kind);
+        out[3] = static_cast<char>(seq >> 24);
+        out[4] = static_cast<char>(seq >> 16);
+        out[5] = static_cast<char>(seq >> 8);
+        out[6] = static_cast<char>(seq);
+    }
+
+    RpcReader::RpcReader(const char *buf, unsigned int size) : _buf(buf), _size(size), _offset(0), _ok(true) {
+    }
+
+    RpcReader::RpcReader(const RpcMessage &msg) : RpcReader(msg.data, msg.size) {
+    }
+
+    bool RpcReader::Read(unsigned char &value) {
+        unsigned long long v = 0;
+        if (ReadBigEndian(1, v)) {
+            value = static_cast<unsigned char>(v);
+        }
+        return _ok;
+    }
+
+    bool RpcReader::Read(unsigned short &value) {
+        unsigned long long v = 0;
+        if (ReadBigEndian(2, v)) {
+            value = static_cast<unsigned short>(v);
+        }
+        return _ok;
+    }
+
+    bool RpcReader::Read(unsigned int &value) {
+        unsigned long long v = 0;
+        if (ReadBigEndian(4, v)) {
+            value = static_cast<unsigned int>(v);
+        }
+        return _ok;
+    }
+
+    bool RpcReader::Read(unsigned long long &value) {
+        return ReadBigEndian(8, value);
+    }
+
+    bool RpcReader::Read(RpcSlice &value) {
+        unsigned int size = 0;
+        if (!Read(size)) {
+            return false;
+        }
+        if (size > _size - _offset) {
+            _ok = false;
+            return false;
+        }
+        value.data = _buf + _offset;
+        value.size = size;
+        _offset += size;
+        return true;
+    }
+
+    bool RpcReader::Ok() const {
+        return _ok;
+    }
+
+    unsigned int RpcReader::Remain() const {
+        return _size - _offset;
+    }
+
+    bool RpcReader::ReadBigEndian(unsigned int bytes, unsigned long long &value) {
+        if (!_ok || bytes > _size - _offset) {
+            _ok = false;
+            return false;
+        }
+        const auto p = reinterpret_cast<const unsigned char *>(_buf + _offset);
+        unsigned long long v = 0;
+        for (unsigned int n = 0; n < bytes; ++n) {
+            v = v << 8 | p[n];
+        }
+        value = v;
+        _offset += bytes;
+        return true;
+    }
+
+    RpcWriter::RpcWriter(std::string &out) : _out(out) {
+    }
+
+    RpcWriter &RpcWriter::Write(unsigned char value) {
+        WriteBigEndian(1, value);
+        return *this;
+    }
+
+    RpcWriter &RpcWriter::Write(unsigned short value) {
+        WriteBigEndian(2, value);
+        return *this;
+    }
+
+    RpcWriter &RpcWriter::Write(unsigned int value) {
+        WriteBigEndian(4, value);
+        return *this;
+    }
+
+    RpcWriter &RpcWriter::Write(unsigned long long value) {
+        WriteBigEndian(8, value);
+        return *this;
+    }
+
+    RpcWriter &RpcWriter::Write(const char *data, unsigned int size) {
+        WriteBigEndian(4, size);
+        _out.append(data, size);
+        return *this;
+    }
+
+    void RpcWriter::WriteBigEndian(unsigned int bytes, unsigned long long value) {
+        char buf[8];
+        for (unsigned int n = 0; n < bytes; ++n) {
+            buf[n] = static_cast<char>(value >> (8 * (bytes - 1 - n)));
+        }
+        _out.append(buf, bytes);
+    }
+
+    RpcEndpoint::RpcEndpoint(uv_loop_t *loop, RpcImplement *impl) : _loop(loop),
+                                                                   _impl(impl),
+                                                                   _timer(nullptr),
+                                                                   _armed(0),
+                                                                   _pendingCount(0) {
+        _timer = static_cast<uv_timer_t *>(::malloc(sizeof(uv_timer_t)));
+        uv_timer_init(_loop, _timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(_timer), this);
+    }
+
+    RpcEndpoint::~RpcEndpoint() {
+        Release();
+    }
+
+    bool RpcEndpoint::Receive(unsigned int session, const char *buf, unsigned int size) {
+        RpcMessage msg{};
+        if (!RpcMessage::Decode(buf, size, msg)) {
+            return false;
+        }
+        if (msg.kind == RpcKind::Notify || msg.kind == RpcKind::Request) {
+            _impl->IRpcReceive(session, msg);
+            return true;
+        }
+        const unsigned int index = msg.seq & kSeqIndexMask;
+        if (index >= _slots.size() || !_slots[index].active || _slots[index].seq != msg.seq) {
+            // 已超时或已断开的请求, 丢弃迟到的回复
+            return true;
+        }
+        int status = 0;
+        if (msg.kind == RpcKind::Error) {
+            unsigned int code = 0;
+            RpcReader reader(msg);
+            status = reader.Read(code) ? static_cast<int>(code) : UV_EPROTO;
+            if (status == 0) {
+                status = UV_EPROTO;
+            }
+        }
+        Complete(index, status, msg);
+        return true;
+    }
+
+    unsigned int RpcEndpoint::Call(unsigned int session, unsigned short id, const char *buf, unsigned int size,
+                                   void *context, uint64_t timeout) {
+        if (!_timer) {
+            return 0;
+        }
+        unsigned int index;
+        if (!_freeSlots.empty()) {
+            index = _freeSlots.back();
+            _freeSlots.pop_back();
+        } else if (_slots.size() < kMaxPending) {
+            index = static_cast<unsigned int>(_slots.size());
+            _slots.push_back(Pending{false, 0, 0, nullptr, 0, 0});
+        } else {
+            return 0;
+        }
+        Pending &pending = _slots[index];
+        // 代数跳过0, 保证序号非0且槽位复用后旧回复不会误匹配
+        unsigned int generation = (pending.seq >> kSeqIndexBits) + 1;
+        if (generation > kSeqIndexMask) {
+            generation = 1;
+        }
+        pending.active = true;
+        pending.seq = generation << kSeqIndexBits | index;
+        pending.session = session;
+        pending.context = context;
+        pending.start = uv_hrtime();
+        pending.deadline = uv_now(_loop) + timeout;
+        ++_pendingCount;
+        const unsigned int seq = pending.seq;
+
+        // 完成的请求在截止时间队列中惰性删除, 积压过多时整体重建
+        if (_deadlines.size() > _pendingCount * 2 + 64) {
+            _deadlines.erase(std::remove_if(_deadlines.begin(), _deadlines.end(), [this](const Deadline &it) {
+                return !IsLive(it);
+            }), _deadlines.end());
+            std::make_heap(_deadlines.begin(), _deadlines.end());
+        }
+        _deadlines.push_back(Deadline{pending.deadline, seq});
+        std::push_heap(_deadlines.begin(), _deadlines.end());
+        if (_armed == 0 || _deadlines.front().deadline < _armed) {
+            ArmTimer();
+        }
+        Send(session, id, RpcKind::Request, seq, buf, size);
+        return seq;
+    }
+
+    void RpcEndpoint::Notify(unsigned int session, unsigned short id, const char *buf, unsigned int size) {
+        Send(session, id, RpcKind::Notify, 0, buf, size);
+    }
+
+    void RpcEndpoint::Reply(unsigned int session, const RpcMessage &request, const char *buf, unsigned int size) {
+        if (request.kind == RpcKind::Request) {
+            Send(session, request.id, RpcKind::Response, request.seq, buf, size);
+        }
+    }
+
+    void RpcEndpoint::ReplyError(unsigned int session, const RpcMessage &request, int status) {
+        if (request.kind == RpcKind::Request) {
+            const auto code = static_cast<unsigned int>(status);
+            const char buf[4] = {
+                static_cast<char>(code >> 24), static_cast<char>(code >> 16), static_cast<char>(code >> 8),
+                static_cast<char>(code)
+            };
+            Send(session, request.id, RpcKind::Error, request.seq, buf, sizeof(buf));
+        }
+    }
+
+    void RpcEndpoint::SessionClosed(unsigned int session) {
+        const RpcMessage empty{};
+        for (unsigned int index = 0; index < _slots.size(); ++index) {
+            if (_slots[index].active && _slots[index].session == session) {
+                Complete(index, UV_ECONNRESET, empty);
+            }
+        }
+    }
+
+    void RpcEndpoint::Release() {
+        const RpcMessage empty{};
+        for (unsigned int index = 0; index < _slots.size(); ++index) {
+            if (_slots[index].active) {
+                Complete(index, UV_ECANCELED, empty);
+            }
+        }
+        _deadlines.clear();
+        if (_timer) {
+            uv_close(reinterpret_cast<uv_handle_t *>(_timer), [](uv_handle_t *handle) {
+                ::free(handle);
+            });
+            _timer = nullptr;
+            _armed = 0;
+        }
+    }
+
+    size_t RpcEndpoint::PendingCount() const {
+        return _pendingCount;
+    }
+
+    const Utils::Histogram &RpcEndpoint::Latency() const {
+        return _latency;
+    }
+
+    void RpcEndpoint::ResetLatency() {
+        _latency.Reset();
+    }
+
+    void RpcEndpoint::Send(unsigned int session, unsigned short id, RpcKind kind, unsigned int seq, const char *buf,
+                           unsigned int size) {
+        _output.resize(RpcMessage::kHeadSize);
+        RpcMessage::EncodeHead(id, kind, seq, &_output[0]);
+        _output.append(buf, size);
+        _impl->IRpcWrite(session, _output.data(), static_cast<unsigned int>(_output.size()));
+    }
+
+    void RpcEndpoint::Complete(unsigned int index, int status, const RpcMessage &msg) {
+        // 回调内可能发起新请求导致槽位数组扩容, 先复制
+        const Pending pending = _slots[index];
+        _slots[index].active = false;
+        _freeSlots.push_back(index);
+        --_pendingCount;
+        if (status == 0 || msg.kind == RpcKind::Error) {
+            _latency.Record(uv_hrtime() - pending.start);
+        }
+        _impl->IRpcResponse(pending.session, pending.context, status, msg);
+    }
+
+    void RpcEndpoint::ArmTimer() {
+        while (!_deadlines.empty() && !IsLive(_deadlines.front())) {
+            std::pop_heap(_deadlines.begin(), _deadlines.end());
+            _deadlines.pop_back();
+        }
+        if (!_timer) {
+            return;
+        }
+        if (_deadlines.empty()) {
+            uv_timer_stop(_timer);
+            _armed = 0;
+            return;
+        }
+        const uint64_t deadline = _deadlines.front().deadline;
+        if (deadline != _armed) {
+            const uint64_t now = uv_now(_loop);
+            uv_timer_start(_timer, RpcEndpoint::UvTimeoutCallback, deadline > now ? deadline - now : 0, 0);
+            _armed = deadline;
+        }
+    }
+
+    bool RpcEndpoint::IsLive(const Deadline &deadline) const {
+        const unsigned int index = deadline.seq & kSeqIndexMask;
+        return index < _slots.size() && _slots[index].active && _slots[index].seq == deadline.seq &&
+               _slots[index].deadline == deadline.deadline;
+    }
+
+    void RpcEndpoint::UvTimeoutCallback(uv_timer_t *handle) {
+        auto self = static_cast<RpcEndpoint *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        self->_armed = 0;
+        const uint64_t now = uv_now(self->_loop);
+        const RpcMessage empty{};
+        while (!self->_deadlines.empty() && self->_deadlines.front().deadline <= now) {
+            const Deadline top = self->_deadlines.front();
+            std::pop_heap(self->_deadlines.begin(), self->_deadlines.end());
+            self->_deadlines.pop_back();
+            if (self->IsLive(top)) {
+                self->Complete(top.seq & kSeqIndexMask, UV_ETIMEDOUT, empty);
+            }
+        }
+        self->ArmTimer();
+    }
+}
@@ -0,0 +1,427 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include "network/ShmChannel.h"
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Lcc {
+    static constexpr unsigned int kShmMagic = 0x4d43434c;
+    static constexpr unsigned int kShmVersion = 1;
+    // 单次唤醒最多处理的记录数, 超过后让出事件循环
+    static constexpr unsigned int kShmBatch = 1024;
+    static constexpr unsigned int kShmMaxCapacity = 0x40000000U;
+
+    struct ShmChannel::Direction {
+        SpscControl ring;
+        // 消费者已处理完全部记录, 生产者发布后需唤醒
+        std::atomic<unsigned int> sleeping;
+        char pad0[64 - sizeof(std::atomic<unsigned int>)];
+        // 生产者因空间不足在本地排队, 消费者归还空间后需唤醒
+        std::atomic<unsigned int> blocked;
+        char pad1[64 - sizeof(std::atomic<unsigned int>)];
+
+        Direction() : ring(), sleeping(1), pad0(), blocked(0), pad1() {
+        }
+    };
+
+    /**
+     * 共享内存布局: 头部, 两个方向的共享状态, 之后依次是两个方向的环
+     * 方向0由发起方写入, 方向1由接受方写入
+     */
+    struct ShmChannel::Segment {
+        unsigned int magic;
+        unsigned int version;
+        unsigned int capacity;
+        char pad[64 - sizeof(unsigned int) * 3];
+        Direction direction[2];
+
+        explicit Segment(unsigned int capacity) : magic(kShmMagic), version(kShmVersion), capacity(capacity), pad() {
+        }
+
+        char *Ring(unsigned int index) {
+            return reinterpret_cast<char *>(this) + sizeof(Segment) + static_cast<size_t>(capacity) * index;
+        }
+    };
+
+#if defined(__linux__)
+    static int _shm_errno() {
+        return errno ? -errno : UV_EIO;
+    }
+
+    static void _shm_signal(int fd) {
+        const uint64_t one = 1;
+        // 计数已非零时写入失败也无妨, 对端总会被唤醒
+        while (::write(fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+        }
+    }
+#endif
+
+    ShmChannel::ShmChannel(ShmChannelImplement *impl) : _implement(impl),
+                                                        _segment(nullptr),
+                                                        _segmentSize(0),
+                                                        _closing(false),
+                                                        _fds{-1, -1, -1},
+                                                        _wakeFd(-1),
+                                                        _peerFd(-1),
+                                                        _txDirection(nullptr),
+                                                        _rxDirection(nullptr),
+                                                        _tx(nullptr),
+                                                        _rx(nullptr),
+                                                        _wakePoll(),
+                                                        _backlogBytes(0) {
+    }
+
+    ShmChannel::~ShmChannel() {
+        delete _tx;
+        delete _rx;
+    }
+
+    int ShmChannel::Create(unsigned int capacity, int fds[kFdCount]) {
+#if defined(__linux__) && defined(SYS_memfd_create)
+        if (capacity == 0 || capacity > kShmMaxCapacity) {
+            return UV_EINVAL;
+        }
+        unsigned int size = 64;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        fds[0] = fds[1] = fds[2] = -1;
+        const size_t total = sizeof(Segment) + static_cast<size_t>(size) * 2;
+        int err = 0;
+        fds[0] = static_cast<int>(::syscall(SYS_memfd_create, "lcc-shm", 1U /* MFD_CLOEXEC */));
+        if (fds[0] < 0 || ::ftruncate(fds[0], static_cast<off_t>(total)) != 0) {
+            err = _shm_errno();
+        }
+        for (unsigned int n = 1; n < kFdCount && err == 0; ++n) {
+            fds[n] = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fds[n] < 0) {
+                err = _shm_errno();
+            }
+        }
+        if (err == 0) {
+            void *memory = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+            if (memory == MAP_FAILED) {
+                err = _shm_errno();
+            } else {
+                // ftruncate得到的内存全为0, 构造后对端映射即可看到初始状态
+                new(memory) Segment(size);
+                ::munmap(memory, total);
+            }
+        }
+        if (err != 0) {
+            CloseFds(fds);
+        }
+        return err;
+#else
+        return UV_ENOTSUP;
+#endif
+    }
+
+    int ShmChannel::SendFds(int socket, const int fds[kFdCount]) {
+#if defined(__linux__)
+        char tag = 'S';
+        iovec iov{&tag, sizeof(tag)};
+        char control[CMSG_SPACE(sizeof(int) * kFdCount)];
+        memset(control, 0, sizeof(control));
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * kFdCount);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * kFdCount);
+        ssize_t sent;
+        while ((sent = ::sendmsg(socket, &msg, MSG_NOSIGNAL)) < 0 && errno == EINTR) {
+        }
+        return sent == 1 ? 0 : _shm_errno();
+#else
+        return UV_ENOTSUP;
+#endif
+    }
+
+    int ShmChannel::ReceiveFds(int socket, int fds[kFdCount]) {
+#if defined(__linux__)
+        char tag = 0;
+        iovec iov{&tag, sizeof(tag)};
+        char control[CMSG_SPACE(sizeof(int) * kFdCount)];
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        ssize_t received;
+        while ((received = ::recvmsg(socket, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC)) < 0 && errno == EINTR) {
+        }
+        if (received < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK ? UV_EAGAIN : _shm_errno();
+        }
+        if (received == 0) {
+            return UV_EOF;
+        }
+        fds[0] = fds[1] = fds[2] = -1;
+        unsigned int count = 0;
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+                count = static_cast<unsigned int>((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+                memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * (count < kFdCount ? count : kFdCount));
+                for (unsigned int n = kFdCount; n < count; ++n) {
+                    int extra;
+                    memcpy(&extra, CMSG_DATA(cmsg) + sizeof(int) * n, sizeof(int));
+                    ::close(extra);
+                }
+            }
+        }
+        if (tag != 'S' || count != kFdCount || (msg.msg_flags & MSG_CTRUNC)) {
+            CloseFds(fds);
+            return UV_EPROTO;
+        }
+        return 0;
+#else
+        return UV_ENOTSUP;
+#endif
+    }
+
+    void ShmChannel::CloseFds(int fds[kFdCount]) {
+#if defined(__linux__)
+        for (unsigned int n = 0; n < kFdCount; ++n) {
+            if (fds[n] >= 0) {
+                ::close(fds[n]);
+                fds[n] = -1;
+            }
+        }
+#endif
+    }
+
+    int ShmChannel::Open(uv_loop_t *loop, int fds[kFdCount], bool initiator) {
+#if defined(__linux__)
+        if (_segment || _closing) {
+            CloseFds(fds);
+            return UV_EBUSY;
+        }
+        memcpy(_fds, fds, sizeof(_fds));
+        fds[0] = fds[1] = fds[2] = -1;
+        struct stat st{};
+        if (::fstat(_fds[0], &st) != 0) {
+            const int err = _shm_errno();
+            CloseFds(_fds);
+            return err;
+        }
+        // 先按头部映射取得容量, 对端构造的内容不可信, 需校验后再使用
+        const auto size = static_cast<size_t>(st.st_size);
+        void *memory = size < sizeof(Segment)
+                           ? MAP_FAILED
+                           : ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fds[0], 0);
+        if (memory == MAP_FAILED) {
+            CloseFds(_fds);
+            return UV_EPROTO;
+        }
+        auto segment = static_cast<Segment *>(memory);
+        const unsigned int capacity = segment->capacity;
+        if (segment->magic != kShmMagic || segment->version != kShmVersion || capacity < 64 ||
+            capacity > kShmMaxCapacity || (capacity & (capacity - 1)) != 0 ||
+            sizeof(Segment) + static_cast<size_t>(capacity) * 2 > size) {
+            ::munmap(memory, size);
+            CloseFds(_fds);
+            return UV_EPROTO;
+        }
+        const unsigned int tx = initiator ? 0 : 1;
+        _segment = segment;
+        _segmentSize = size;
+        _wakeFd = _fds[initiator ? 2 : 1];
+        _peerFd = _fds[initiator ? 1 : 2];
+        _txDirection = &segment->direction[tx];
+        _rxDirection = &segment->direction[1 - tx];
+        _tx = new SpscRing;
+        _rx = new SpscRing;
+        _tx->Attach(&_txDirection->ring, segment->Ring(tx), capacity);
+        _rx->Attach(&_rxDirection->ring, segment->Ring(1 - tx), capacity);
+        uv_poll_init(loop, &_wakePoll, _wakeFd);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_wakePoll), this);
+        const int err = uv_poll_start(&_wakePoll, UV_READABLE, ShmChannel::UvWakeCallback);
+        if (err != 0) {
+            // 关闭回调中释放映射与描述符
+            Close();
+            return err;
+        }
+        // 对端在本端打开前写入的消息已经通过eventfd计数唤醒, 在下一轮事件循环中处理
+        return 0;
+#else
+        CloseFds(fds);
+        return UV_ENOTSUP;
+#endif
+    }
+
+    void ShmChannel::Close() {
+        if (!_segment || _closing) {
+            return;
+        }
+        _closing = true;
+        _backlog.clear();
+        _backlogBytes = 0;
+        uv_poll_stop(&_wakePoll);
+        uv_close(reinterpret_cast<uv_handle_t *>(&_wakePoll), ShmChannel::UvCloseCallback);
+    }
+
+    void ShmChannel::Receive() {
+        if (IsOpen()) {
+            Process();
+        }
+    }
+
+    bool ShmChannel::Write(const char *buf, unsigned int size) {
+        if (!IsOpen() || size > _tx->MaxRecordSize()) {
+            return false;
+        }
+        if (_backlog.empty() && _tx->Write(buf, size)) {
+            _tx->Publish();
+            WakeSleepingPeer();
+            return true;
+        }
+        _backlog.emplace_back(buf, size);
+        _backlogBytes += size;
+        // 标记等待空间并重试一次, 之后由对端归还空间时唤醒
+        Flush();
+        return true;
+    }
+
+    size_t ShmChannel::WriteQueueSize() const {
+        return IsOpen() ? _backlogBytes + _tx->UsedSize() : 0;
+    }
+
+    unsigned int ShmChannel::MaxMessageSize() const {
+        return _tx ? _tx->MaxRecordSize() : 0;
+    }
+
+    bool ShmChannel::IsOpen() const {
+        return _segment && !_closing;
+    }
+
+    void ShmChannel::Process() {
+#if defined(__linux__)
+        uint64_t count;
+        while (::read(_wakeFd, &count, sizeof(count)) < 0 && errno == EINTR) {
+        }
+#endif
+        if (Flush() && _backlog.empty()) {
+            _implement->IChannelWriteDrain();
+        }
+        while (!_closing) {
+            unsigned int records = 0;
+            SpscSpan span{};
+            while (records < kShmBatch && !_closing && _rx->Peek(span)) {
+                ++records;
+                _implement->IChannelReceive(span.data, span.size);
+            }
+            if (_rx->LastErrCode() != 0) {
+                // 对端写坏了共享段, 已回调的记录照常归还
+                _rx->Release();
+                return _implement->IChannelError(_rx->LastErrCode());
+            }
+            if (records == 0) {
+                // 先标记休眠再检查一次, 与生产者"发布后检查休眠"配对, 不会漏掉唤醒
+                _rxDirection->sleeping.store(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!_rx->Readable()) {
+                    return;
+                }
+                _rxDirection->sleeping.store(0, std::memory_order_relaxed);
+                continue;
+            }
+            _rx->Release();
+            WakeBlockedPeer();
+            if (records == kShmBatch) {
+#if defined(__linux__)
+                // 保持非休眠状态, 唤醒自己在下一轮事件循环继续
+                _shm_signal(_wakeFd);
+#endif
+                return;
+            }
+        }
+    }
+
+    bool ShmChannel::Flush() {
+        bool written = false;
+        while (!_backlog.empty()) {
+            const std::string &message = _backlog.front();
+            const auto size = static_cast<unsigned int>(message.size());
+            if (!_tx->Write(message.data(), size)) {
+                _txDirection->blocked.store(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!_tx->Write(message.data(), size)) {
+                    break;
+                }
+            }
+            _backlogBytes -= size;
+            _backlog.pop_front();
+            written = true;
+        }
+        if (written) {
+            _tx->Publish();
+            WakeSleepingPeer();
+        }
+        return written;
+    }
+
+    void ShmChannel::WakeSleepingPeer() {
+        // 发布与读取休眠标记之间需要完整屏障
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_txDirection->sleeping.load(std::memory_order_relaxed) &&
+            _txDirection->sleeping.exchange(0, std::memory_order_relaxed)) {
+#if defined(__linux__)
+            _shm_signal(_peerFd);
+#endif
+        }
+    }
+
+    void ShmChannel::WakeBlockedPeer() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_rxDirection->blocked.load(std::memory_order_relaxed) &&
+            _rxDirection->blocked.exchange(0, std::memory_order_relaxed)) {
+#if defined(__linux__)
+            _shm_signal(_peerFd);
+#endif
+        }
+    }
+
+    void ShmChannel::UvWakeCallback(uv_poll_t *handle, int status, int events) {
+        auto self = static_cast<ShmChannel *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        if (self->_closing) {
+            return;
+        }
+        if (status < 0) {
+            return self->_implement->IChannelError(status);
+        }
+        self->Process();
+    }
+
+    void ShmChannel::UvCloseCallback(uv_handle_t *handle) {
+        auto self = static_cast<ShmChannel *>(uv_handle_get_data(handle));
+#if defined(__linux__)
+        ::munmap(self->_segment, self->_segmentSize);
+#endif
+        CloseFds(self->_fds);
+        delete self->_tx;
+        delete self->_rx;
+        self->_tx = self->_rx = nullptr;
+        self->_segment = nullptr;
+        self->_segmentSize = 0;
+        self->_txDirection = self->_rxDirection = nullptr;
+        self->_wakeFd = self->_peerFd = -1;
+        self->_closing = false;
+        self->_implement->IChannelClosed();
+    }
+}
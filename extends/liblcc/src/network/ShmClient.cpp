@@ -0,0 +1,189 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstring>
+#include "network/ShmClient.h"
+
+namespace Lcc {
+    ShmClient::ShmClient(ClientImplement *impl) : _status(Status::None),
+                                                  _connected(false),
+                                                  _handle(nullptr),
+                                                  _implement(impl),
+                                                  _connectReq(),
+                                                  _capacity(0x100000),
+                                                  _pending(0),
+                                                  _fds{-1, -1, -1},
+                                                  _readBuf(),
+                                                  _channel(this),
+                                                  _hostAddress() {
+    }
+
+    ShmClient::~ShmClient() {
+        ShmChannel::CloseFds(_fds);
+    }
+
+    void ShmClient::SetCapacity(unsigned int capacity) {
+        _capacity = capacity;
+    }
+
+    void ShmClient::Connect(const char *host) {
+        if (!host || _status != Status::None || !Utils::HostParse(host, _hostAddress) ||
+            _hostAddress.protocol != Utils::HostProtocol::Shm) {
+            return;
+        }
+        _handle = new StreamHandle;
+        _handle->type = UV_NAMED_PIPE;
+        _implement->IClientInit(*_handle);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_handle->pipeHandle), this);
+        _status = Status::Connecting;
+        if (uv_handle_get_type(reinterpret_cast<uv_handle_t *>(&_handle->pipeHandle)) != UV_NAMED_PIPE) {
+            // IClientInit未按管道初始化句柄
+            return ConnectFail(UV_EINVAL);
+        }
+        uv_req_set_data(reinterpret_cast<uv_req_t *>(&_connectReq), this);
+        const int err = uv_pipe_connect2(&_connectReq, &_handle->pipeHandle, _hostAddress.path,
+                                         strlen(_hostAddress.path), 0, ShmClient::UvConnectCallback);
+        if (err != 0) {
+            ConnectFail(err);
+        }
+    }
+
+    void ShmClient::Shutdown() {
+        Close(0);
+    }
+
+    void ShmClient::Write(const char *buf, unsigned int size) {
+        if (_status == Status::Connected && !_channel.Write(buf, size)) {
+            Close(UV_EMSGSIZE);
+        }
+    }
+
+    unsigned int ShmClient::GetSession() const {
+        return _handle ? _handle->tcpSession : 0;
+    }
+
+    size_t ShmClient::WriteQueueSize() const {
+        return _status == Status::Connected ? _channel.WriteQueueSize() : 0;
+    }
+
+    void ShmClient::Handshake() {
+        int err = ShmChannel::Create(_capacity, _fds);
+        uv_os_fd_t fd;
+        if (err == 0) {
+            err = uv_fileno(reinterpret_cast<uv_handle_t *>(&_handle->pipeHandle), &fd);
+        }
+        if (err == 0) {
+            // 套接字刚连上, 发送缓冲区为空, 直接发送不会阻塞
+            err = ShmChannel::SendFds(fd, _fds);
+        }
+        if (err == 0) {
+            err = uv_read_start(reinterpret_cast<uv_stream_t *>(&_handle->pipeHandle), ShmClient::UvAllocCallback,
+                                ShmClient::UvReadCallback);
+        }
+        if (err != 0) {
+            return ConnectFail(err);
+        }
+        _status = Status::Handshake;
+    }
+
+    void ShmClient::ConnectFail(int status) {
+        _status = Status::ConnectFail;
+        _implement->IClientReport(false, uv_strerror(status));
+        Close(status);
+    }
+
+    void ShmClient::Close(int err) {
+        if (!_handle || _status == Status::Closing) {
+            return;
+        }
+        _connected = _status == Status::Connected;
+        _status = Status::Closing;
+        if (_connected) {
+            _implement->IClientBeforeDisconnect(err, err != 0 ? uv_strerror(err) : nullptr);
+        }
+        ShmChannel::CloseFds(_fds);
+        _pending = 1;
+        uv_close(reinterpret_cast<uv_handle_t *>(&_handle->pipeHandle), ShmClient::UvCloseCallback);
+        if (_channel.IsOpen()) {
+            ++_pending;
+            _channel.Close();
+        }
+    }
+
+    void ShmClient::Done() {
+        if (--_pending > 0) {
+            return;
+        }
+        delete _handle;
+        _handle = nullptr;
+        _status = Status::None;
+        if (_connected) {
+            _connected = false;
+            _implement->IClientAfterDisconnect();
+        }
+    }
+
+    void ShmClient::IChannelReceive(const char *buf, unsigned int size) {
+        _implement->IClientReceive(buf, size);
+    }
+
+    void ShmClient::IChannelWriteDrain() {
+    }
+
+    void ShmClient::IChannelError(int err) {
+        Close(err);
+    }
+
+    void ShmClient::IChannelClosed() {
+        Done();
+    }
+
+    void ShmClient::UvConnectCallback(uv_connect_t *req, int status) {
+        auto self = static_cast<ShmClient *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
+        // 连接中关闭会以UV_ECANCELED回调
+        if (self->_status != Status::Connecting) {
+            return;
+        }
+        if (status != 0) {
+            return self->ConnectFail(status);
+        }
+        self->Handshake();
+    }
+
+    void ShmClient::UvAllocCallback(uv_handle_t *handle, size_t suggested, uv_buf_t *buf) {
+        auto self = static_cast<ShmClient *>(uv_handle_get_data(handle));
+        *buf = uv_buf_init(self->_readBuf, sizeof(self->_readBuf));
+    }
+
+    void ShmClient::UvReadCallback(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf) {
+        auto self = static_cast<ShmClient *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(stream)));
+        if (nread == 0) {
+            return;
+        }
+        if (self->_status == Status::Handshake) {
+            if (nread < 0) {
+                return self->ConnectFail(static_cast<int>(nread));
+            }
+            if (buf->base[0] != 'S') {
+                return self->ConnectFail(UV_EPROTO);
+            }
+            const int err = self->_channel.Open(stream->loop, self->_fds, true);
+            if (err != 0) {
+                return self->ConnectFail(err);
+            }
+            self->_status = Status::Connected;
+            self->_implement->IClientReport(true, nullptr);
+            return;
+        }
+        if (self->_status == Status::Connected && nread < 0) {
+            // 对端断开前写入的消息仍在共享环中
+            self->_channel.Receive();
+            self->Close(static_cast<int>(nread));
+        }
+    }
+
+    void ShmClient::UvCloseCallback(uv_handle_t *handle) {
+        auto self = static_cast<ShmClient *>(uv_handle_get_data(handle));
+        self->Done();
+    }
+}
@@ -0,0 +1,283 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "network/ShmServer.h"
+
+namespace Lcc {
+    /**
+     * 一个客户端会话: 握手前等待套接字上的描述符, 握手后套接字可读即视为对端断开
+     */
+    class ShmServer::Session : public ShmChannelImplement {
+    public:
+        Session(ShmServer *server, unsigned int id, int socket) : server(server),
+                                                                  id(id),
+                                                                  socket(socket),
+                                                                  open(false),
+                                                                  closing(false),
+                                                                  pending(0),
+                                                                  channel(this),
+                                                                  poll() {
+        }
+
+        int Start(uv_loop_t *loop) {
+            int err = uv_poll_init(loop, &poll, socket);
+            if (err != 0) {
+                ::close(socket);
+                return err;
+            }
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&poll), this);
+            err = uv_poll_start(&poll, UV_READABLE | UV_DISCONNECT, Session::UvSocketCallback);
+            if (err != 0) {
+                Close(err);
+            }
+            return err;
+        }
+
+        void Handshake() {
+            int fds[ShmChannel::kFdCount];
+            int err = ShmChannel::ReceiveFds(socket, fds);
+            if (err == UV_EAGAIN) {
+                return;
+            }
+            if (err == 0) {
+                err = channel.Open(poll.loop, fds, false);
+            }
+            if (err == 0) {
+                const char ack = 'S';
+                if (::send(socket, &ack, sizeof(ack), MSG_NOSIGNAL | MSG_DONTWAIT) != sizeof(ack)) {
+                    err = errno ? -errno : UV_EIO;
+                }
+            }
+            if (err != 0) {
+                return Close(err);
+            }
+            open = true;
+            server->_implement->IServerSessionOpen(id);
+        }
+
+        void Close(int err) {
+            if (closing) {
+                return;
+            }
+            closing = true;
+            if (open) {
+                server->_implement->IServerSessionBeforeClose(id, err, err != 0 ? uv_strerror(err) : nullptr);
+            }
+            pending = 1;
+            uv_poll_stop(&poll);
+            uv_close(reinterpret_cast<uv_handle_t *>(&poll), Session::UvCloseCallback);
+            if (channel.IsOpen()) {
+                ++pending;
+                channel.Close();
+            }
+        }
+
+        void Done() {
+            if (--pending == 0) {
+                server->SessionClosed(this);
+            }
+        }
+
+        static void UvSocketCallback(uv_poll_t *handle, int status, int events) {
+            auto self = static_cast<Session *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+            if (self->closing) {
+                return;
+            }
+            if (status < 0) {
+                return self->Close(status);
+            }
+            if (!self->open) {
+                return self->Handshake();
+            }
+            // 握手后对端不再发送数据, 读到结束或错误即为断开
+            char buf[64];
+            const ssize_t n = ::recv(self->socket, buf, sizeof(buf), MSG_DONTWAIT);
+            if (n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))) {
+                return;
+            }
+            const int err = n == 0 ? UV_EOF : -errno;
+            // 对端断开前写入的消息仍在共享环中
+            self->channel.Receive();
+            self->Close(err);
+        }
+
+        static void UvCloseCallback(uv_handle_t *handle) {
+            auto self = static_cast<Session *>(uv_handle_get_data(handle));
+            ::close(self->socket);
+            self->Done();
+        }
+
+    protected:
+        void IChannelReceive(const char *buf, unsigned int size) override {
+            server->_implement->IServerSessionReceive(id, buf, size);
+        }
+
+        void IChannelWriteDrain() override {
+            if (open && !closing) {
+                server->_implement->IServerSessionWriteDrain(id);
+            }
+        }
+
+        void IChannelError(int err) override {
+            Close(err);
+        }
+
+        void IChannelClosed() override {
+            Done();
+        }
+
+    public:
+        ShmServer *server;
+        unsigned int id;
+        int socket;
+        bool open;
+        bool closing;
+        // 等待关闭完成的句柄数
+        unsigned int pending;
+        ShmChannel channel;
+        uv_poll_t poll;
+    };
+
+    ShmServer::ShmServer(ServerImplement *impl) : _status(Status::None),
+                                                  _handle(nullptr),
+                                                  _isession(0),
+                                                  _implement(impl),
+                                                  _hostAddress() {
+    }
+
+    ShmServer::~ShmServer() = default;
+
+    void ShmServer::Listen(const char *host) {
+        if (!host || _status != Status::None || !Utils::HostParse(host, _hostAddress) ||
+            _hostAddress.protocol != Utils::HostProtocol::Shm) {
+            return;
+        }
+        _handle = new StreamHandle;
+        _handle->type = UV_NAMED_PIPE;
+        _implement->IServerInit(*_handle);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_handle->pipeHandle), this);
+        int err;
+        if (uv_handle_get_type(reinterpret_cast<uv_handle_t *>(&_handle->pipeHandle)) != UV_NAMED_PIPE) {
+            // IServerInit未按管道初始化句柄
+            err = UV_EINVAL;
+        } else {
+            err = uv_pipe_bind(&_handle->pipeHandle, _hostAddress.path);
+        }
+        if (err == 0) {
+            err = uv_listen(reinterpret_cast<uv_stream_t *>(&_handle->pipeHandle), 128,
+                            ShmServer::UvNewSessionCallback);
+        }
+        if (err != 0) {
+            return ListenFail(err);
+        }
+        _status = Status::Listened;
+        _implement->IServerListenReport(true, 0, nullptr);
+    }
+
+    void ShmServer::Shutdown() {
+        if (_handle && _handle->IsActive()) {
+            uv_close(reinterpret_cast<uv_handle_t *>(&_handle->pipeHandle), ShmServer::UvServerShutdownCallback);
+            ShutdownAllSessions();
+        }
+    }
+
+    void ShmServer::ShutdownAllSessions() {
+        for (const auto &it: _sessionMap) {
+            it.second->Close(0);
+        }
+    }
+
+    void ShmServer::ShutdownSession(unsigned int session) {
+        auto it = _sessionMap.find(session);
+        if (it != _sessionMap.end()) {
+            it->second->Close(0);
+        }
+    }
+
+    const Utils::HostAddress &ShmServer::GetListenAddress() const {
+        return _hostAddress;
+    }
+
+    void ShmServer::SessionWrite(unsigned int session, const char *buf, unsigned int size) {
+        auto sessionObject = GetOpenSession(session);
+        if (sessionObject && !sessionObject->channel.Write(buf, size)) {
+            sessionObject->Close(UV_EMSGSIZE);
+        }
+    }
+
+    size_t ShmServer::SessionWriteQueueSize(unsigned int session) {
+        auto sessionObject = GetOpenSession(session);
+        return sessionObject ? sessionObject->channel.WriteQueueSize() : 0;
+    }
+
+    void ShmServer::ListenFail(int status) {
+        _errdesc = uv_strerror(status);
+        _status = Status::ListenFail;
+        _implement->IServerListenReport(false, status, _errdesc.c_str());
+        Shutdown();
+    }
+
+    ShmServer::Session *ShmServer::GetOpenSession(unsigned int session) {
+        auto it = _sessionMap.find(session);
+        if (it != _sessionMap.end() && it->second->open && !it->second->closing) {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    void ShmServer::SessionClosed(Session *session) {
+        const unsigned int id = session->id;
+        const bool open = session->open;
+        _sessionMap.erase(id);
+        delete session;
+        if (open) {
+            _implement->IServerSessionAfterClose(id);
+        }
+    }
+
+    void ShmServer::UvNewSessionCallback(uv_stream_t *server, int status) {
+        if (status != 0) {
+            return;
+        }
+        auto self = static_cast<ShmServer *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(server)));
+        // 由libuv接受连接, 复制出描述符后关闭管道句柄, 之后用uv_poll等待描述符与断开
+        auto pipe = new uv_pipe_t;
+        uv_pipe_init(self->_handle->Loop(), pipe, 0);
+        int socket = -1;
+        uv_os_fd_t fd;
+        if (uv_accept(server, reinterpret_cast<uv_stream_t *>(pipe)) == 0 &&
+            uv_fileno(reinterpret_cast<uv_handle_t *>(pipe), &fd) == 0) {
+            socket = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+        }
+        uv_close(reinterpret_cast<uv_handle_t *>(pipe), [](uv_handle_t *handle) {
+            delete reinterpret_cast<uv_pipe_t *>(handle);
+        });
+        if (socket < 0) {
+            return;
+        }
+        unsigned int session = 0;
+        while (++self->_isession) {
+            if (self->_sessionMap.find(self->_isession) == self->_sessionMap.end()) {
+                session = self->_isession;
+                break;
+            }
+        }
+        auto sessionObject = new Session(self, session, socket);
+        self->_sessionMap[session] = sessionObject;
+        if (sessionObject->Start(self->_handle->Loop()) != 0 && !sessionObject->closing) {
+            self->_sessionMap.erase(session);
+            delete sessionObject;
+        }
+    }
+
+    void ShmServer::UvServerShutdownCallback(uv_handle_t *handle) {
+        auto self = static_cast<ShmServer *>(uv_handle_get_data(handle));
+        delete self->_handle;
+        self->_handle = nullptr;
+        self->_implement->IServerShutdown();
+    }
+}
@@ -1,34 +1,109 @@
 //
 // Created by liao on 2024/5/3.
 //
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
 #include "network/TcpClient.h"
 #include "network/plugin/MbedTLSPlugin.h"
 #include "network/plugin/WebSocketPlugin.h"
 
 namespace Lcc {
+    namespace {
+        /**
+         * 按RFC 8305第4节排列地址: 以第一个地址的协议族开头, 两种协议族交替, 同族内保持原顺序
+         */
+        void InterleaveFamilies(std::vector<ResolvedAddress> &addresses) {
+            std::vector<ResolvedAddress> first, second;
+            const auto family = addresses.front().addr.sa_family;
+            for (const auto &address: addresses) {
+                (address.addr.sa_family == family ? first : second).push_back(address);
+            }
+            addresses.clear();
+            for (size_t n = 0; n < first.size() || n < second.size(); ++n) {
+                if (n < first.size()) {
+                    addresses.push_back(first[n]);
+                }
+                if (n < second.size()) {
+                    addresses.push_back(second[n]);
+                }
+            }
+        }
+
+        void SetPort(ResolvedAddress &address, int port) {
+            if (address.addr.sa_family == AF_INET6) {
+                address.addr6.sin6_port = htons(static_cast<uint16_t>(port));
+            } else {
+                address.addr4.sin_port = htons(static_cast<uint16_t>(port));
+            }
+        }
+
+        void FormatAddress(const ResolvedAddress &address, Utils::HostAddress &host) {
+            host.v6 = address.addr.sa_family == AF_INET6;
+            if (host.v6) {
+                uv_ip6_name(&address.addr6, host.ip, sizeof(host.ip));
+            } else {
+                uv_ip4_name(&address.addr4, host.ip, sizeof(host.ip));
+            }
+        }
+
+        void ReleaseCreators(std::vector<ProtocolPluginCreator *> &creators) {
+            for (auto creator: creators) {
+                creator->ICreatorRelease();
+            }
+            creators.clear();
+        }
+    }
+
     TcpClient::TcpClient(ClientImplement *impl) : _status(Status::None),
                                                   _handle(nullptr),
                                                   _tcpStream(nullptr),
                                                   _implement(impl),
+                                                  _connectReq(),
+                                                  _nextAddress(0),
+                                                  _lastError(0),
+                                                  _attemptDelay(250),
+                                                  _connectTimeout(0),
+                                                  _attemptTimer(nullptr),
+                                                  _timeoutTimer(nullptr),
                                                   _opcode(WebSocketOpcode::Text),
-                                                  _hostAddress() {
+                                                  _hostAddress(),
+                                                  _schemeAddress(),
+                                                  _schemeOpcode(WebSocketOpcode::Text) {
     }
 
-    TcpClient::~TcpClient() = default;
+    TcpClient::~TcpClient() {
+        Resolver::Local().Cancel(this);
+        StopConnecting();
+        ReleaseCreators(_creatorVec);
+        ReleaseCreators(_schemeCreatorVec);
+    }
 
     void TcpClient::Connect(const char *host) {
-        if (host && _status == Status::None && HostParse(host, _hostAddress)) {
+        if (host && _status == Status::None && HostParse(host, _hostAddress) && HostIsStream(_hostAddress)) {
             _status = Status::Address;
             return AddressParse();
         }
     }
 
     void TcpClient::Shutdown() {
+        // 解析结果可能先于关闭回调到达, 不能再发起连接
+        Resolver::Local().Cancel(this);
+        StopConnecting();
         if (_tcpStream) {
             _tcpStream->Shutdown();
         }
     }
 
+    void TcpClient::SetConnectTimeout(unsigned int timeout) {
+        _connectTimeout = timeout;
+    }
+
+    void TcpClient::SetAttemptDelay(unsigned int delay) {
+        _attemptDelay = delay;
+    }
+
     void TcpClient::Enable(ProtocolPluginCreator *creator) {
         if (creator && creator->ICreatorInit()) {
             _creatorVec.emplace_back(creator);
@@ -52,51 +127,204 @@ namespace Lcc {
         return 0;
     }
 
+    size_t TcpClient::WriteQueueSize() const {
+        if (_status == Status::Connected && _tcpStream) {
+            return _tcpStream->WriteQueueSize();
+        }
+        return 0;
+    }
+
     void TcpClient::AddressParse() {
         if (_status == Status::Address) {
             _tcpStream = new TcpStream(reinterpret_cast<StreamImplement *>(this));
             if (!_tcpStream->Init()) {
                 return AddressConnectFail(_tcpStream->LastErrCode());
             }
-            auto req = static_cast<uv_getaddrinfo_t *>(::malloc(sizeof(uv_getaddrinfo_t)));
-            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(req), this);
-            uv_getaddrinfo(_handle->loop, req, TcpClient::UvAddressParseCallback, _hostAddress.host, nullptr, nullptr);
+            if (uv_handle_get_type(reinterpret_cast<uv_handle_t *>(&_handle->tcpHandle)) != _handle->type) {
+                // IClientInit未按地址类型初始化句柄
+                return AddressConnectFail(UV_EINVAL);
+            }
+            if (_handle->IsPipe()) {
+                _status = Status::Init;
+                return AddressConnecting();
+            }
+            int status = 0;
+            std::vector<ResolvedAddress> addresses;
+            if (Resolver::Local().Resolve(_handle->Loop(), _hostAddress.host, this, status, addresses)) {
+                AddressResolved(status, addresses);
+            }
         }
     }
 
+    void TcpClient::AddressResolved(int status, const std::vector<ResolvedAddress> &addresses) {
+        if (_status != Status::Address) {
+            return;
+        }
+        if (status != 0) {
+            return AddressConnectFail(status);
+        }
+        _addresses = addresses;
+        InterleaveFamilies(_addresses);
+        for (auto &address: _addresses) {
+            SetPort(address, _hostAddress.port);
+        }
+        FormatAddress(_addresses.front(), _hostAddress);
+        _status = Status::Init;
+        AddressConnecting();
+    }
+
     void TcpClient::AddressConnecting() {
-        if (_status == Status::Init) {
-            int err;
-            auto req = reinterpret_cast<uv_connect_t *>(::malloc(sizeof(uv_connect_t)));
-            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(req), this);
-            if (_hostAddress.v6) {
-                sockaddr_in6 addr6{};
-                uv_ip6_addr(_hostAddress.ip, _hostAddress.port, &addr6);
-                err = uv_tcp_connect(req, _handle, reinterpret_cast<const sockaddr *>(&addr6),
-                                     TcpClient::UvConnectStatusCallback);
-            } else {
-                sockaddr_in addr4{};
-                uv_ip4_addr(_hostAddress.ip, _hostAddress.port, &addr4);
-                err = uv_tcp_connect(req, _handle, reinterpret_cast<const sockaddr *>(&addr4),
-                                     TcpClient::UvConnectStatusCallback);
+        if (_status != Status::Init) {
+            return;
+        }
+        _status = Status::Connecting;
+        if (_connectTimeout > 0) {
+            _timeoutTimer = static_cast<uv_timer_t *>(::malloc(sizeof(uv_timer_t)));
+            uv_timer_init(_handle->Loop(), _timeoutTimer);
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(_timeoutTimer), this);
+            uv_timer_start(_timeoutTimer, TcpClient::UvTimeoutCallback, _connectTimeout, 0);
+        }
+        if (_handle->IsPipe()) {
+            uv_req_set_data(reinterpret_cast<uv_req_t *>(&_connectReq), this);
+            const int err = uv_pipe_connect2(&_connectReq, &_handle->pipeHandle, _hostAddress.path,
+                                             strlen(_hostAddress.path), 0, TcpClient::UvConnectStatusCallback);
+            if (err != 0) {
+                AddressConnectFail(err);
             }
-            if (err == 0) {
-                _status = Status::Connecting;
-            } else {
+            return;
+        }
+        uv_os_fd_t fd;
+        if (_addresses.size() == 1 || uv_fileno(reinterpret_cast<const uv_handle_t *>(&_handle->tcpHandle), &fd) == 0) {
+            // 只有一个地址, 或IClientInit中已创建了套接字(如绑定源地址)时, 直接用流的句柄连接第一个地址
+            uv_req_set_data(reinterpret_cast<uv_req_t *>(&_connectReq), this);
+            const int err = uv_tcp_connect(&_connectReq, &_handle->tcpHandle, &_addresses.front().addr,
+                                           TcpClient::UvConnectStatusCallback);
+            if (err != 0) {
                 AddressConnectFail(err);
             }
+            return;
         }
+        _attemptTimer = static_cast<uv_timer_t *>(::malloc(sizeof(uv_timer_t)));
+        uv_timer_init(_handle->Loop(), _attemptTimer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(_attemptTimer), this);
+        _nextAddress = 0;
+        _lastError = 0;
+        AttemptNext();
     }
 
     void TcpClient::AddressConnectFail(int status) {
+        StopConnecting();
         _status = Status::ConnectFail;
         _implement->IClientReport(false, uv_strerror(status));
         _tcpStream->Shutdown();
     }
 
+    void TcpClient::AddressConnected() {
+        StopConnecting();
+        _status = Status::Connected;
+        PrepareSchemeCreators();
+        for (auto creator: _creatorVec) {
+            _tcpStream->EnableProtocolPlugin(creator->ICreatorAlloc(reinterpret_cast<ProtocolImplement *>(_tcpStream)));
+        }
+        for (auto creator: _schemeCreatorVec) {
+            _tcpStream->EnableProtocolPlugin(creator->ICreatorAlloc(reinterpret_cast<ProtocolImplement *>(_tcpStream)));
+        }
+        if (!_tcpStream->Startup()) {
+            AddressConnectFail(_tcpStream->LastErrCode());
+        }
+    }
+
+    void TcpClient::AttemptNext() {
+        uv_timer_stop(_attemptTimer);
+        while (_nextAddress < _addresses.size()) {
+            auto attempt = new ConnectAttempt;
+            attempt->client = this;
+            attempt->address = _addresses[_nextAddress++];
+            uv_tcp_init(_handle->Loop(), &attempt->handle);
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&attempt->handle), attempt);
+            uv_req_set_data(reinterpret_cast<uv_req_t *>(&attempt->req), attempt);
+            const int err = uv_tcp_connect(&attempt->req, &attempt->handle, &attempt->address.addr,
+                                           TcpClient::UvAttemptCallback);
+            if (err == 0) {
+                _attempts.push_back(attempt);
+                if (_nextAddress < _addresses.size()) {
+                    uv_timer_start(_attemptTimer, TcpClient::UvAttemptTimerCallback, _attemptDelay, 0);
+                }
+                return;
+            }
+            // 同步失败(如本机没有该协议族的路由)立即尝试下一个
+            _lastError = err;
+            attempt->client = nullptr;
+            uv_close(reinterpret_cast<uv_handle_t *>(&attempt->handle), TcpClient::UvAttemptCloseCallback);
+        }
+        if (_attempts.empty()) {
+            AddressConnectFail(_lastError);
+        }
+    }
+
+    void TcpClient::AttemptWon(ConnectAttempt *attempt) {
+        _attempts.erase(std::find(_attempts.begin(), _attempts.end(), attempt));
+        uv_os_fd_t fd;
+        int err = uv_fileno(reinterpret_cast<const uv_handle_t *>(&attempt->handle), &fd);
+        if (err == 0) {
+            // 复制一份描述符交给流, 关闭尝试的句柄只关闭原描述符
+            const int dupFd = dup(fd);
+            err = dupFd < 0 ? uv_translate_sys_error(errno) : uv_tcp_open(&_handle->tcpHandle, dupFd);
+            if (err != 0 && dupFd >= 0) {
+                close(dupFd);
+            }
+        }
+        FormatAddress(attempt->address, _hostAddress);
+        attempt->client = nullptr;
+        uv_close(reinterpret_cast<uv_handle_t *>(&attempt->handle), TcpClient::UvAttemptCloseCallback);
+        if (err != 0) {
+            return AddressConnectFail(err);
+        }
+        AddressConnected();
+    }
+
+    void TcpClient::StopConnecting() {
+        for (auto attempt: _attempts) {
+            attempt->client = nullptr;
+            uv_close(reinterpret_cast<uv_handle_t *>(&attempt->handle), TcpClient::UvAttemptCloseCallback);
+        }
+        _attempts.clear();
+        if (_attemptTimer) {
+            uv_close(reinterpret_cast<uv_handle_t *>(_attemptTimer), TcpClient::UvTimerCloseCallback);
+            _attemptTimer = nullptr;
+        }
+        if (_timeoutTimer) {
+            uv_close(reinterpret_cast<uv_handle_t *>(_timeoutTimer), TcpClient::UvTimerCloseCallback);
+            _timeoutTimer = nullptr;
+        }
+    }
+
+    void TcpClient::PrepareSchemeCreators() {
+        if (!_schemeCreatorVec.empty() && _schemeAddress.protocol == _hostAddress.protocol &&
+            _schemeAddress.ssl == _hostAddress.ssl && _schemeOpcode == _opcode &&
+            strcmp(_schemeAddress.host, _hostAddress.host) == 0) {
+            return;
+        }
+        ReleaseCreators(_schemeCreatorVec);
+        if (_hostAddress.protocol == Utils::HostProtocol::Websocket) {
+            auto websocket = new WebSocketPluginCreator;
+            websocket->InitializeClientMode(_opcode, _hostAddress.host);
+            _schemeCreatorVec.emplace_back(websocket);
+        }
+        if (_hostAddress.ssl) {
+            // SSL配置(CA证书等)只在地址变化时重新加载
+            auto ssl = new MbedTLSPluginCreator;
+            ssl->InitializeClientMode(_hostAddress.host, nullptr);
+            _schemeCreatorVec.emplace_back(ssl);
+        }
+        _schemeAddress = _hostAddress;
+        _schemeOpcode = _opcode;
+    }
+
     bool TcpClient::IStreamInit(StreamHandle &handle) {
+        handle.type = _hostAddress.protocol == Utils::HostProtocol::Unix ? UV_NAMED_PIPE : UV_TCP;
         if (_implement->IClientInit(handle)) {
-            _handle = &handle.tcpHandle;
+            _handle = &handle;
             return true;
         }
         return false;
@@ -116,66 +344,65 @@ namespace Lcc {
         }
     }
 
+    void TcpClient::IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) {
+        AddressResolved(status, addresses);
+    }
+
     void TcpClient::IStreamAfterClose(unsigned int session) {
         delete _tcpStream;
         _tcpStream = nullptr;
         _handle = nullptr;
-        for (auto creator: _creatorVec) {
-            creator->ICreatorRelease();
-        }
-        _creatorVec.clear();
         if (_status == Status::Connected) {
             _implement->IClientAfterDisconnect();
         }
         _status = Status::None;
     }
 
-    void TcpClient::UvAddressParseCallback(uv_getaddrinfo_t *info, int status, addrinfo *res) {
-        auto self = static_cast<TcpClient *>(uv_handle_get_data(reinterpret_cast<uv_handle_t *>(info)));
-        if (status == 0) {
-            if (res->ai_protocol == IPPROTO_TCP || res->ai_protocol == IPPROTO_IP || res->ai_protocol == IPPROTO_UDP) {
-                uv_ip4_name(reinterpret_cast<sockaddr_in *>(res->ai_addr), self->_hostAddress.ip,
-                            sizeof(self->_hostAddress.ip));
-            } else if (res->ai_protocol == IPPROTO_IPV6) {
-                self->_hostAddress.v6 = true;
-                uv_ip6_name(reinterpret_cast<sockaddr_in6 *>(res->ai_addr), self->_hostAddress.ip,
-                            sizeof(self->_hostAddress.ip));
-            }
-            self->_status = Status::Init;
-        } else {
-            self->AddressConnectFail(status);
-        }
-        uv_freeaddrinfo(res);
-        ::free(info);
-        if (self->_status == Status::Init) {
-            self->AddressConnecting();
-        }
-    }
-
     void TcpClient::UvConnectStatusCallback(uv_connect_t *req, int status) {
-        auto self = static_cast<TcpClient *>(uv_handle_get_data(reinterpret_cast<uv_handle_t *>(req)));
-        ::free(req);
+        auto self = static_cast<TcpClient *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
+        // 超时后关闭流会以UV_ECANCELED回调, 此时已报告过失败
+        if (self->_status != Status::Connecting) {
+            return;
+        }
         if (status != 0) {
             self->AddressConnectFail(status);
         } else {
-            self->_status = Status::Connected;
-            if (self->_hostAddress.protocol == Utils::HostProtocol::Websocket) {
-                auto websocket = new WebSocketPluginCreator;
-                websocket->InitializeClientMode(self->_opcode, self->_hostAddress.host);
-                self->_creatorVec.emplace_back(websocket);
-            }
-            if (self->_hostAddress.ssl) {
-                auto ssl = new MbedTLSPluginCreator;
-                ssl->InitializeClientMode(self->_hostAddress.host, nullptr);
-                self->_creatorVec.emplace_back(ssl);
-            }
-            for (auto creator: self->_creatorVec) {
-                self->_tcpStream->EnableProtocolPlugin(
-                    creator->ICreatorAlloc(reinterpret_cast<ProtocolImplement *>(self->_tcpStream)));
-            }
-            if (!self->_tcpStream->Startup()) {
-                self->AddressConnectFail(self->_tcpStream->LastErrCode());
-            }
+            self->AddressConnected();
+        }
+    }
+
+    void TcpClient::UvAttemptCallback(uv_connect_t *req, int status) {
+        auto attempt = static_cast<ConnectAttempt *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
+        auto self = attempt->client;
+        if (!self) {
+            return;
+        }
+        if (status == 0) {
+            return self->AttemptWon(attempt);
         }
+        self->_lastError = status;
+        self->_attempts.erase(std::find(self->_attempts.begin(), self->_attempts.end(), attempt));
+        attempt->client = nullptr;
+        uv_close(reinterpret_cast<uv_handle_t *>(&attempt->handle), TcpClient::UvAttemptCloseCallback);
+        // 失败时不等间隔, 立即发起下一个; 没有后续地址时等待进行中的尝试
+        self->AttemptNext();
+    }
+
+    void TcpClient::UvAttemptCloseCallback(uv_handle_t *handle) {
+        delete static_cast<ConnectAttempt *>(uv_handle_get_data(handle));
+    }
+
+    void TcpClient::UvAttemptTimerCallback(uv_timer_t *handle) {
+        auto self = static_cast<TcpClient *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        self->AttemptNext();
+    }
+
+    void TcpClient::UvTimeoutCallback(uv_timer_t *handle) {
+        auto self = static_cast<TcpClient *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        self->AddressConnectFail(UV_ETIMEDOUT);
+    }
+
+    void TcpClient::UvTimerCloseCallback(uv_handle_t *handle) {
+        ::free(handle);
     }
 }
@@ -0,0 +1,306 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <algorithm>
+#include "network/TcpClientPool.h"
+
+namespace Lcc {
+    /**
+     * 池中的一个连接, 对象在重连之间保持不变, 协议插件创造器随之复用
+     */
+    class TcpClientPool::Link : public TcpClient, public ClientImplement {
+    public:
+        enum class State {
+            // 等待退避间隔后重连
+            Waiting,
+            Connecting,
+            Connected,
+            // 已移除, 关闭后释放
+            Closing,
+        };
+
+        Link(TcpClientPool *pool, Endpoint *endpoint, unsigned int id) : TcpClient(this),
+                                                                         pool(pool),
+                                                                         endpoint(endpoint),
+                                                                         id(id),
+                                                                         state(State::Waiting),
+                                                                         failures(0),
+                                                                         checking(false),
+                                                                         connectedAt(0),
+                                                                         lastActive(0),
+                                                                         timer() {
+            uv_timer_init(pool->_loop, &timer);
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&timer), this);
+        }
+
+        /**
+         * 发起连接
+         */
+        void Dial() {
+            state = State::Connecting;
+            SetConnectTimeout(pool->_options.connectTimeout);
+            Connect(endpoint->host.c_str());
+        }
+
+        /**
+         * 按空闲时长安排下一次健康检查
+         */
+        void ArmIdleCheck() {
+            const unsigned int idle = pool->_options.idleTimeout;
+            if (idle == 0) {
+                return;
+            }
+            const uint64_t elapsed = uv_now(pool->_loop) - lastActive;
+            if (elapsed < idle) {
+                uv_timer_start(&timer, Link::UvTimerCallback, idle - elapsed, 0);
+                return;
+            }
+            const bool probed = pool->_impl->IPoolHealthCheck(endpoint->id, id);
+            if (state != State::Connected) {
+                return;
+            }
+            if (probed) {
+                checking = true;
+                uv_timer_start(&timer, Link::UvTimerCallback, pool->_options.checkTimeout, 0);
+            } else {
+                lastActive = uv_now(pool->_loop);
+                uv_timer_start(&timer, Link::UvTimerCallback, idle, 0);
+            }
+        }
+
+        static void UvTimerCallback(uv_timer_t *handle) {
+            auto self = static_cast<Link *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+            if (self->state == State::Waiting) {
+                return self->Dial();
+            }
+            if (self->state != State::Connected) {
+                return;
+            }
+            if (self->checking) {
+                // 探测后没有任何应答, 断开后重连
+                return self->Shutdown();
+            }
+            self->ArmIdleCheck();
+        }
+
+    public:
+        TcpClientPool *pool;
+        Endpoint *endpoint;
+        unsigned int id;
+        State state;
+        unsigned int failures;
+        bool checking;
+        uint64_t connectedAt;
+        // 最近一次收到数据(或连上)的时刻, 收到数据不重启定时器, 定时器到期时再按该时刻计算
+        uint64_t lastActive;
+        uv_timer_t timer;
+
+    protected:
+        bool IClientInit(StreamHandle &handle) override {
+            handle.tcpSession = id;
+            return handle.Init(pool->_loop) == 0;
+        }
+
+        void IClientReport(bool connected, const char *err) override {
+            if (!connected) {
+                return;
+            }
+            state = State::Connected;
+            checking = false;
+            connectedAt = lastActive = uv_now(pool->_loop);
+            endpoint->ready.push_back(this);
+            ArmIdleCheck();
+            pool->_impl->IPoolLinkUp(endpoint->id, id);
+        }
+
+        void IClientReceive(const char *buf, unsigned int size) override {
+            lastActive = uv_now(pool->_loop);
+            checking = false;
+            pool->_impl->IPoolReceive(endpoint->id, id, buf, size);
+        }
+
+        void IClientBeforeDisconnect(int err, const char *errMsg) override {
+            auto &ready = endpoint->ready;
+            ready.erase(std::remove(ready.begin(), ready.end(), this), ready.end());
+            uv_timer_stop(&timer);
+            pool->_impl->IPoolLinkDown(endpoint->id, id, err, errMsg);
+        }
+
+        void IClientAfterDisconnect() override {
+        }
+
+        void IStreamAfterClose(unsigned int session) override {
+            TcpClient::IStreamAfterClose(session);
+            pool->LinkClosed(this);
+        }
+    };
+
+    ClientPoolOptions::ClientPoolOptions() : connections(4),
+                                             backoffBase(100),
+                                             backoffMax(30000),
+                                             connectTimeout(5000),
+                                             idleTimeout(30000),
+                                             checkTimeout(5000),
+                                             dispatch(PoolDispatch::RoundRobin) {
+    }
+
+    TcpClientPool::TcpClientPool(uv_loop_t *loop, ClientPoolImplement *impl) : _loop(loop),
+                                                                               _impl(impl),
+                                                                               _shutdown(false),
+                                                                               _iendpoint(0),
+                                                                               _ilink(0),
+                                                                               _random(static_cast<unsigned int>(uv_hrtime())) {
+    }
+
+    TcpClientPool::~TcpClientPool() = default;
+
+    void TcpClientPool::SetOptions(const ClientPoolOptions &options) {
+        _options = options;
+    }
+
+    unsigned int TcpClientPool::AddEndpoint(const char *host) {
+        Utils::HostAddress address{};
+        if (_shutdown || !host || !Utils::HostParse(host, address) || !Utils::HostIsStream(address)) {
+            return 0;
+        }
+        auto endpoint = new Endpoint{++_iendpoint, host, false, 0, {}, {}};
+        _endpoints.emplace(endpoint->id, endpoint);
+        for (unsigned int n = 0; n < _options.connections; ++n) {
+            auto link = new Link(this, endpoint, ++_ilink);
+            endpoint->links.push_back(link);
+            _links.emplace(link->id, link);
+            _impl->IPoolLinkSetup(endpoint->id, link->id, *link);
+            link->Dial();
+        }
+        return endpoint->id;
+    }
+
+    void TcpClientPool::RemoveEndpoint(unsigned int endpoint) {
+        auto it = _endpoints.find(endpoint);
+        if (it == _endpoints.end()) {
+            return;
+        }
+        auto ep = it->second;
+        _endpoints.erase(it);
+        ep->removed = true;
+        if (ep->links.empty()) {
+            delete ep;
+            return;
+        }
+        // 释放时会从links中移除, 先复制一份
+        const auto links = ep->links;
+        for (auto link: links) {
+            Release(link);
+        }
+    }
+
+    unsigned int TcpClientPool::Write(unsigned int endpoint, const char *buf, unsigned int size) {
+        auto it = _endpoints.find(endpoint);
+        if (it == _endpoints.end() || it->second->ready.empty()) {
+            return 0;
+        }
+        auto ep = it->second;
+        const size_t count = ep->ready.size();
+        size_t index = ep->next++ % count;
+        if (_options.dispatch == PoolDispatch::LeastLoaded) {
+            size_t least = ep->ready[index]->WriteQueueSize();
+            for (size_t n = 1; n < count && least > 0; ++n) {
+                const size_t candidate = (ep->next - 1 + n) % count;
+                const size_t load = ep->ready[candidate]->WriteQueueSize();
+                if (load < least) {
+                    least = load;
+                    index = candidate;
+                }
+            }
+        }
+        auto link = ep->ready[index];
+        link->Write(buf, size);
+        return link->id;
+    }
+
+    bool TcpClientPool::WriteTo(unsigned int link, const char *buf, unsigned int size) {
+        auto it = _links.find(link);
+        if (it == _links.end() || it->second->state != Link::State::Connected) {
+            return false;
+        }
+        it->second->Write(buf, size);
+        return true;
+    }
+
+    size_t TcpClientPool::ConnectedCount(unsigned int endpoint) const {
+        auto it = _endpoints.find(endpoint);
+        return it == _endpoints.end() ? 0 : it->second->ready.size();
+    }
+
+    void TcpClientPool::Shutdown() {
+        if (_shutdown) {
+            return;
+        }
+        _shutdown = true;
+        std::vector<unsigned int> endpoints;
+        for (auto &it: _endpoints) {
+            endpoints.push_back(it.first);
+        }
+        for (auto endpoint: endpoints) {
+            RemoveEndpoint(endpoint);
+        }
+        if (_links.empty()) {
+            _impl->IPoolShutdown();
+        }
+    }
+
+    void TcpClientPool::LinkClosed(Link *link) {
+        if (link->state == Link::State::Closing) {
+            return Release(link);
+        }
+        // 连接保持超过最大退避间隔视为恢复正常, 重新从基准间隔退避
+        if (link->connectedAt > 0 && uv_now(_loop) - link->connectedAt >= _options.backoffMax) {
+            link->failures = 0;
+        }
+        link->connectedAt = 0;
+        link->state = Link::State::Waiting;
+        const unsigned int delay = Backoff(++link->failures);
+        _impl->IPoolLinkRetry(link->endpoint->id, link->id, link->failures, delay);
+        uv_timer_start(&link->timer, Link::UvTimerCallback, delay, 0);
+    }
+
+    unsigned int TcpClientPool::Backoff(unsigned int failures) {
+        const unsigned int shift = std::min(failures > 0 ? failures - 1 : 0, 20U);
+        const uint64_t cap = std::min(static_cast<uint64_t>(_options.backoffBase) << shift,
+                                      static_cast<uint64_t>(_options.backoffMax));
+        // 等幅抖动: 同时断开的连接错开重连, 又不会立即重连
+        const uint64_t half = cap / 2;
+        return static_cast<unsigned int>(half + _random() % (cap - half + 1));
+    }
+
+    void TcpClientPool::Release(Link *link) {
+        const bool closing = link->state == Link::State::Closing;
+        link->state = Link::State::Closing;
+        uv_timer_stop(&link->timer);
+        if (link->GetSession() != 0) {
+            // 连接中或已连接, 关闭后在LinkClosed中再次释放
+            if (!closing) {
+                link->Shutdown();
+            }
+            return;
+        }
+        uv_close(reinterpret_cast<uv_handle_t *>(&link->timer), [](uv_handle_t *handle) {
+            auto link = static_cast<Link *>(uv_handle_get_data(handle));
+            link->pool->LinkReleased(link);
+        });
+    }
+
+    void TcpClientPool::LinkReleased(Link *link) {
+        auto endpoint = link->endpoint;
+        auto &links = endpoint->links;
+        links.erase(std::remove(links.begin(), links.end(), link), links.end());
+        _links.erase(link->id);
+        delete link;
+        if (endpoint->removed && links.empty()) {
+            delete endpoint;
+        }
+        if (_shutdown && _links.empty()) {
+            _impl->IPoolShutdown();
+        }
+    }
+}
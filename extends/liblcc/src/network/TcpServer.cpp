@@ -2,6 +2,7 @@
 // Created by liao on 2024/5/14.
 //
 #include "network/TcpServer.h"
+#include "network/NetMetrics.h"
 
 namespace Lcc {
     TcpServer::TcpServer(ServerImplement *impl): _error(0),
@@ -9,21 +10,25 @@ namespace Lcc {
                                                  _handle(nullptr),
                                                  _isession(0),
                                                  _implement(impl),
+                                                 _address(),
                                                  _hostAddress() {
     }
 
-    TcpServer::~TcpServer() = default;
+    TcpServer::~TcpServer() {
+        Resolver::Local().Cancel(this);
+    }
 
     void TcpServer::Listen(const char *host) {
-        if (host && _status == Status::None && HostParse(host, _hostAddress)) {
+        if (host && _status == Status::None && HostParse(host, _hostAddress) && HostIsStream(_hostAddress)) {
             _status = Status::Address;
             return AddressParse();
         }
     }
 
     void TcpServer::Shutdown() {
-        if (_handle && !uv_is_closing(reinterpret_cast<const uv_handle_t *>(_handle))) {
-            uv_close(reinterpret_cast<uv_handle_t *>(_handle), TcpServer::UvServerShutdownCallback);
+        Resolver::Local().Cancel(this);
+        if (_handle && _handle->IsActive()) {
+            uv_close(reinterpret_cast<uv_handle_t *>(&_handle->tcpHandle), TcpServer::UvServerShutdownCallback);
             ShutdownAllSessions();
         }
     }
@@ -58,31 +63,74 @@ namespace Lcc {
         }
     }
 
+    size_t TcpServer::SessionWriteQueueSize(unsigned int session) {
+        const auto sessionStream = GetSessionStream(session);
+        return sessionStream ? sessionStream->WriteQueueSize() : 0;
+    }
+
+    bool TcpServer::GetSessionStats(unsigned int session, StreamStats &stats) {
+        const auto sessionStream = GetSessionStream(session);
+        if (!sessionStream) {
+            return false;
+        }
+        stats = sessionStream->GetStats();
+        return true;
+    }
+
     void TcpServer::AddressParse() {
         if (_status == Status::Address) {
-            _handle = static_cast<uv_tcp_t *>(::malloc(sizeof(uv_tcp_t)));
-            _implement->IServerInit(_handle);
-            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(_handle), this);
-            auto req = static_cast<uv_getaddrinfo_t *>(::malloc(sizeof(uv_getaddrinfo_t)));
-            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(req), this);
-            uv_getaddrinfo(_handle->loop, req, TcpServer::UvAddressParseCallback, _hostAddress.host, nullptr, nullptr);
+            _handle = new StreamHandle;
+            _handle->type = _hostAddress.protocol == Utils::HostProtocol::Unix ? UV_NAMED_PIPE : UV_TCP;
+            _implement->IServerInit(*_handle);
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_handle->tcpHandle), this);
+            if (_handle->IsPipe()) {
+                // 套接字路径不需要解析
+                _status = Status::Init;
+                return AddressListening();
+            }
+            int status = 0;
+            std::vector<ResolvedAddress> addresses;
+            if (Resolver::Local().Resolve(_handle->Loop(), _hostAddress.host, this, status, addresses)) {
+                AddressResolved(status, addresses);
+            }
+        }
+    }
+
+    void TcpServer::AddressResolved(int status, const std::vector<ResolvedAddress> &addresses) {
+        if (_status != Status::Address || !_handle) {
+            return;
+        }
+        if (status != 0) {
+            return AddressListenFail(status);
+        }
+        _address = addresses.front();
+        _hostAddress.v6 = _address.addr.sa_family == AF_INET6;
+        if (_hostAddress.v6) {
+            _address.addr6.sin6_port = htons(static_cast<uint16_t>(_hostAddress.port));
+            uv_ip6_name(&_address.addr6, _hostAddress.ip, sizeof(_hostAddress.ip));
+        } else {
+            _address.addr4.sin_port = htons(static_cast<uint16_t>(_hostAddress.port));
+            uv_ip4_name(&_address.addr4, _hostAddress.ip, sizeof(_hostAddress.ip));
         }
+        _status = Status::Init;
+        AddressListening();
     }
 
     void TcpServer::AddressListening() {
         if (_status == Status::Init) {
             int err;
-            if (_hostAddress.v6) {
-                sockaddr_in6 addr6{};
-                uv_ip6_addr(_hostAddress.ip, _hostAddress.port, &addr6);
-                err = uv_tcp_bind(_handle, reinterpret_cast<const sockaddr *>(&addr6), 0);
+            if (uv_handle_get_type(reinterpret_cast<uv_handle_t *>(&_handle->tcpHandle)) != _handle->type) {
+                // IServerInit未按地址类型初始化句柄
+                err = UV_EINVAL;
+            } else if (_handle->IsPipe()) {
+                // 关闭监听时libuv会删除套接字文件, 异常退出遗留的文件需自行清理
+                err = uv_pipe_bind(&_handle->pipeHandle, _hostAddress.path);
             } else {
-                sockaddr_in addr4{};
-                uv_ip4_addr(_hostAddress.ip, _hostAddress.port, &addr4);
-                err = uv_tcp_bind(_handle, reinterpret_cast<const sockaddr *>(&addr4), 0);
+                err = uv_tcp_bind(&_handle->tcpHandle, &_address.addr, 0);
             }
             if (err == 0) {
-                err = uv_listen(reinterpret_cast<uv_stream_t *>(_handle), 128, TcpServer::UvNewSessionCallback);
+                err = uv_listen(reinterpret_cast<uv_stream_t *>(&_handle->tcpHandle), 128,
+                                TcpServer::UvNewSessionCallback);
                 if (err == 0) {
                     _status = Status::Listened;
                     _implement->IServerListenReport(true, 0, nullptr);
@@ -126,8 +174,12 @@ namespace Lcc {
             }
         }
         handle.tcpSession = session;
-        uv_tcp_init(_handle->loop, &handle.tcpHandle);
-        uv_accept(reinterpret_cast<uv_stream_t *>(_handle), reinterpret_cast<uv_stream_t *>(&handle.tcpHandle));
+        handle.type = _handle->type;
+        handle.Init(_handle->Loop());
+        if (uv_accept(reinterpret_cast<uv_stream_t *>(&_handle->tcpHandle),
+                      reinterpret_cast<uv_stream_t *>(&handle.tcpHandle)) == 0) {
+            NetMetrics::Instance().accepts.Add();
+        }
         return true;
     }
 
@@ -161,28 +213,17 @@ namespace Lcc {
         }
     }
 
-    void TcpServer::UvAddressParseCallback(uv_getaddrinfo_t *info, int status, addrinfo *res) {
-        auto self = static_cast<TcpServer *>(uv_handle_get_data(reinterpret_cast<uv_handle_t *>(info)));
-        if (status == 0) {
-            if (res->ai_protocol == IPPROTO_TCP || res->ai_protocol == IPPROTO_IP || res->ai_protocol == IPPROTO_UDP) {
-                uv_ip4_name(reinterpret_cast<sockaddr_in *>(res->ai_addr), self->_hostAddress.ip,
-                            sizeof(self->_hostAddress.ip));
-            } else if (res->ai_protocol == IPPROTO_IPV6) {
-                self->_hostAddress.v6 = true;
-                uv_ip6_name(reinterpret_cast<sockaddr_in6 *>(res->ai_addr), self->_hostAddress.ip,
-                            sizeof(self->_hostAddress.ip));
-            }
-            self->_status = Status::Init;
-        } else {
-            self->AddressListenFail(status);
-        }
-        uv_freeaddrinfo(res);
-        ::free(info);
-        if (self->_status == Status::Init) {
-            self->AddressListening();
+    void TcpServer::IStreamWriteDrain(unsigned int session) {
+        const auto sessionObject = GetSessionObject(session);
+        if (sessionObject && sessionObject->valid) {
+            _implement->IServerSessionWriteDrain(session);
         }
     }
 
+    void TcpServer::IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) {
+        AddressResolved(status, addresses);
+    }
+
     void TcpServer::UvNewSessionCallback(uv_stream_t *server, int status) {
         if (status == 0) {
             auto self = static_cast<TcpServer *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(server)));
@@ -210,7 +251,7 @@ namespace Lcc {
         for (auto creator: self->_creatorVec) {
             creator->ICreatorRelease();
         }
-        ::free(self->_handle);
+        delete self->_handle;
         self->_handle = nullptr;
         self->_creatorVec.clear();
         self->_implement->IServerShutdown();
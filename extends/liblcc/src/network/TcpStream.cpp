@@ -5,13 +5,17 @@
 #include <cstring>
 #include <algorithm>
 #include "network/TcpStream.h"
+#include "network/NetMetrics.h"
+#include "trace/Trace.h"
 
 namespace Lcc {
+    // 读到的数据在回调内同步消费(插件需要时自行缓存), 同一线程的所有流共用一块读缓冲区
+    static thread_local char _read_buffer[0x10000];
+
     TcpStream::TcpStream(StreamImplement *impl) : _init(false),
+                                                  _started(false),
                                                   _error(0),
                                                   _implement(impl) {
-        _allocBuffer.resize(0x10000);
-        _allocBuffer.clear();
     }
 
     TcpStream::~TcpStream() = default;
@@ -20,8 +24,10 @@ namespace Lcc {
         if (!_init) {
             _init = _implement->IStreamInit(_streamHandle);
             if (_init) {
-                uv_tcp_nodelay(&_streamHandle.tcpHandle, 1);
-                uv_tcp_keepalive(&_streamHandle.tcpHandle, 1, 0);
+                if (!_streamHandle.IsPipe()) {
+                    uv_tcp_nodelay(&_streamHandle.tcpHandle, 1);
+                    uv_tcp_keepalive(&_streamHandle.tcpHandle, 1, 0);
+                }
                 uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_streamHandle.tcpHandle), this);
             }
         }
@@ -35,6 +41,7 @@ namespace Lcc {
         _error = uv_read_start(reinterpret_cast<uv_stream_t *>(&_streamHandle.tcpHandle),
                                TcpStream::UvMemoryAlloc, TcpStream::UvReadCallback);
         if (_error == 0) {
+            _started = true;
             IProtocolOpen(ProtocolLevel::Stream);
             return true;
         }
@@ -44,7 +51,7 @@ namespace Lcc {
 
     void TcpStream::Shutdown() {
         if (_streamHandle.IsActive()) {
-            IProtocolClose(ProtocolLevel::Application);
+            IProtocolClose(ProtocolLevel::User);
         }
     }
 
@@ -68,7 +75,13 @@ namespace Lcc {
     }
 
     void TcpStream::GetPeerAddress(std::string &addr) const {
-        if (IsActive()) {
+        if (IsActive() && _streamHandle.IsPipe()) {
+            char path[256] = {0};
+            size_t len = sizeof(path);
+            if (uv_pipe_getpeername(&_streamHandle.pipeHandle, path, &len) == 0) {
+                addr.assign(path, len);
+            }
+        } else if (IsActive()) {
             sockaddr_storage storage{};
             int len = sizeof(storage);
             if (uv_tcp_getpeername(reinterpret_cast<const uv_tcp_t *>(&_streamHandle.tcpHandle),
@@ -95,10 +108,22 @@ namespace Lcc {
 
     void TcpStream::Write(const char *buf, unsigned int size) {
         if (IsActive() && uv_is_writable(reinterpret_cast<const uv_stream_t *>(&_streamHandle.tcpHandle))) {
-            IProtocolWrite(ProtocolLevel::Application, buf, size);
+            ++_stats.messagesOut;
+            NetMetrics::Instance().messagesOut.Add();
+            LCC_TRACE_SCOPE(_streamHandle.tcpSession);
+            LCC_TRACE_POINT(UserWrite, size);
+            IProtocolWrite(ProtocolLevel::User, buf, size);
         }
     }
 
+    size_t TcpStream::WriteQueueSize() const {
+        return uv_stream_get_write_queue_size(reinterpret_cast<const uv_stream_t *>(&_streamHandle.tcpHandle));
+    }
+
+    const StreamStats &TcpStream::GetStats() const {
+        return _stats;
+    }
+
     ProtocolPlugin *TcpStream::GetLevelPlugin(ProtocolLevel level, bool desc) {
         if (desc) {
             for (auto it = _protocolPluginVec.rbegin(); it != _protocolPluginVec.rend(); ++it) {
@@ -118,11 +143,16 @@ namespace Lcc {
     }
 
     void TcpStream::StreamShutdown() {
-        auto req = static_cast<uv_shutdown_t *>(::malloc(sizeof(uv_shutdown_t)));
-        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(req), this);
-        if (uv_shutdown(req, reinterpret_cast<uv_stream_t *>(&_streamHandle.tcpHandle),
-                        TcpStream::UvShutdownCallback)) {
-            ::free(req);
+        uv_req_set_data(reinterpret_cast<uv_req_t *>(&_shutdownReq), this);
+        if (!_started) {
+            // 连接中的流在shutdown请求上会一直等到连接结束, 直接关闭并取消连接
+            return UvShutdownCallback(&_shutdownReq, 0);
+        }
+        const int err = uv_shutdown(&_shutdownReq, reinterpret_cast<uv_stream_t *>(&_streamHandle.tcpHandle),
+                                    TcpStream::UvShutdownCallback);
+        if (err != 0 && !_shutdownReq.handle) {
+            // 读错误(如对端RST)后流已不可写, shutdown失败且回调不会触发, 直接关闭句柄; 已在shutdown中的重复调用不处理
+            UvShutdownCallback(&_shutdownReq, err);
         }
     }
 
@@ -155,8 +185,12 @@ namespace Lcc {
             }
             if (uv_write(req, reinterpret_cast<uv_stream_t *>(&_streamHandle.tcpHandle), ubuf, 1,
                          TcpStream::UvWriteCallback)) {
+                ::free(ubuf->base);
                 ::free(req);
+                return;
             }
+            LCC_TRACE_SESSION(StreamWrite, _streamHandle.tcpSession, size);
+            NetMetrics::Instance().writeQueueBytes.Add(size);
         }
     }
 
@@ -168,6 +202,9 @@ namespace Lcc {
                 _errdesc = plugin->IProtocolLastErrDesc();
             }
         } else {
+            ++_stats.messagesIn;
+            NetMetrics::Instance().messagesIn.Add();
+            LCC_TRACE_SESSION(UserReceive, _streamHandle.tcpSession, size);
             _implement->IStreamReceive(_streamHandle.tcpSession, buf, size);
         }
     }
@@ -182,42 +219,61 @@ namespace Lcc {
     }
 
     void TcpStream::UvMemoryAlloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
-        auto self = static_cast<TcpStream *>(uv_handle_get_data(handle));
-        buf->base = const_cast<char *>(self->_allocBuffer.data());
-        buf->len = self->_allocBuffer.capacity();
+        buf->base = _read_buffer;
+        buf->len = sizeof(_read_buffer);
     }
 
     void TcpStream::UvReadCallback(uv_stream_t *stream, ssize_t readLen, const uv_buf_t *buf) {
         auto self = static_cast<TcpStream *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(stream)));
         if (readLen > 0) {
+            self->_stats.bytesIn += readLen;
+            NetMetrics::Instance().bytesIn.Add(readLen);
+            // 解密、解帧等协议层在同一调用栈内完成, 记录时沿用该会话
+            LCC_TRACE_SCOPE(self->_streamHandle.tcpSession);
+            LCC_TRACE_POINT(StreamRead, readLen);
             self->IProtocolRead(ProtocolLevel::Stream, buf->base, readLen);
         } else if (readLen == 0) {
             // 可能为 0，这并不表示错误或 EOF。这相当于EAGAIN或EWOULDBLOCK
         } else {
             self->_error = static_cast<int>(readLen);
             self->_errdesc = uv_strerror(self->_error);
-            self->IProtocolClose(ProtocolLevel::Application);
+            self->IProtocolClose(ProtocolLevel::User);
         }
     }
 
     void TcpStream::UvWriteCallback(uv_write_t *req, int status) {
+        auto self = static_cast<TcpStream *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(req->handle)));
+        const bool drained = status == 0 && uv_stream_get_write_queue_size(req->handle) == 0;
         auto *ubuf = reinterpret_cast<uv_buf_t *>(req + 1);
+        NetMetrics &metrics = NetMetrics::Instance();
+        metrics.writeQueueBytes.Sub(static_cast<long long>(ubuf->len));
+        LCC_TRACE_SESSION(WriteDone, self->_streamHandle.tcpSession, ubuf->len);
+        if (status == 0) {
+            self->_stats.bytesOut += ubuf->len;
+            metrics.bytesOut.Add(ubuf->len);
+        }
         ::free(ubuf->base);
         ::free(req);
+        if (drained && self->IsActive()) {
+            self->_implement->IStreamWriteDrain(self->_streamHandle.tcpSession);
+        }
     }
 
     void TcpStream::UvShutdownCallback(uv_shutdown_t *req, int status) {
-        auto self = static_cast<TcpStream *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(req)));
+        auto self = static_cast<TcpStream *>(uv_req_get_data(reinterpret_cast<const uv_req_t *>(req)));
         if (self->_streamHandle.IsActive()) {
             uv_close(reinterpret_cast<uv_handle_t *>(&self->_streamHandle.tcpHandle), TcpStream::UvCloseCallback);
+            NetMetrics::Instance().RecordClose(self->_error);
             self->_implement->IStreamBeforeClose(self->_streamHandle.tcpSession, self->_error,
                                                  self->_errdesc.empty() ? nullptr : self->_errdesc.c_str());
         }
-        ::free(req);
     }
 
     void TcpStream::UvCloseCallback(uv_handle_t *handle) {
         auto self = static_cast<TcpStream *>(uv_handle_get_data(handle));
+        self->_started = false;
+        // 流对象可能被再次使用, 清除上次的shutdown请求
+        self->_shutdownReq = uv_shutdown_t();
         for (auto plugin: self->_protocolPluginVec) {
             plugin->IProtocolPluginRelease();
         }
@@ -0,0 +1,123 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cerrno>
+#include <cstring>
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+#include "network/UdpBatch.h"
+
+namespace Lcc {
+    constexpr unsigned int UdpBatch::kMaxPackets;
+
+    UdpOptions::UdpOptions() : arq(),
+                               idleTimeout(30000),
+                               connectTimeout(5000) {
+    }
+
+    UdpBatch::UdpBatch() : _handle(nullptr),
+                           _count(0),
+                           _error(0),
+                           _packets(0),
+                           _calls(0),
+                           _offsets(),
+                           _hasAddr(),
+                           _addrs() {
+    }
+
+    void UdpBatch::Attach(uv_udp_t *handle) {
+        _handle = handle;
+        _count = 0;
+        _data.clear();
+    }
+
+    void UdpBatch::Push(const char *buf, unsigned int size, const sockaddr *addr) {
+        if (!_handle) {
+            return;
+        }
+        if (_count == kMaxPackets) {
+            const int err = Flush();
+            _error = _error != 0 ? _error : err;
+        }
+        _offsets[_count] = static_cast<unsigned int>(_data.size());
+        _data.append(buf, size);
+        _hasAddr[_count] = addr != nullptr;
+        if (addr) {
+            memcpy(&_addrs[_count], addr, addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in));
+        }
+        _offsets[++_count] = static_cast<unsigned int>(_data.size());
+    }
+
+    int UdpBatch::Flush() {
+        int err = _error;
+        _error = 0;
+        if (!_handle || _count == 0) {
+            return err;
+        }
+        const unsigned int count = _count;
+        _count = 0;
+#if defined(__linux__)
+        uv_os_fd_t fd;
+        if (uv_fileno(reinterpret_cast<const uv_handle_t *>(_handle), &fd) != 0) {
+            _data.clear();
+            return err;
+        }
+        mmsghdr msgs[kMaxPackets];
+        iovec iovs[kMaxPackets];
+        memset(msgs, 0, sizeof(mmsghdr) * count);
+        for (unsigned int n = 0; n < count; ++n) {
+            iovs[n].iov_base = &_data[_offsets[n]];
+            iovs[n].iov_len = _offsets[n + 1] - _offsets[n];
+            msgs[n].msg_hdr.msg_iov = &iovs[n];
+            msgs[n].msg_hdr.msg_iovlen = 1;
+            if (_hasAddr[n]) {
+                msgs[n].msg_hdr.msg_name = &_addrs[n];
+                msgs[n].msg_hdr.msg_namelen = _addrs[n].addr.sa_family == AF_INET6
+                                                  ? sizeof(sockaddr_in6)
+                                                  : sizeof(sockaddr_in);
+            }
+        }
+        unsigned int sent = 0;
+        while (sent < count) {
+            ++_calls;
+            const int n = ::sendmmsg(fd, msgs + sent, count - sent, MSG_DONTWAIT);
+            if (n > 0) {
+                sent += static_cast<unsigned int>(n);
+                _packets += static_cast<unsigned int>(n);
+                continue;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+                break;
+            }
+            // 出错的报文(如ICMP不可达只影响该目标)跳过, 其余继续发送
+            err = err != 0 ? err : -errno;
+            ++sent;
+        }
+#else
+        for (unsigned int n = 0; n < count; ++n) {
+            const uv_buf_t buf = uv_buf_init(&_data[_offsets[n]], _offsets[n + 1] - _offsets[n]);
+            ++_calls;
+            const int status = uv_udp_try_send(_handle, &buf, 1, _hasAddr[n] ? &_addrs[n].addr : nullptr);
+            if (status >= 0) {
+                ++_packets;
+            } else if (status != UV_EAGAIN && status != UV_ENOBUFS) {
+                err = err != 0 ? err : status;
+            }
+        }
+#endif
+        _data.clear();
+        return err;
+    }
+
+    uint64_t UdpBatch::Packets() const {
+        return _packets;
+    }
+
+    uint64_t UdpBatch::Calls() const {
+        return _calls;
+    }
+}
@@ -0,0 +1,333 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <random>
+#include "network/UdpClient.h"
+
+namespace Lcc {
+    // 客户端收到的报文不超过mtu, 但recvmmsg按64KB切分接收缓冲区
+    static constexpr unsigned int kUdpClientRecvSize = 4 * 64 * 1024;
+    // 握手阶段重发窗口询问的间隔(毫秒)
+    static constexpr uint32_t kUdpHandshakeInterval = 100;
+
+    static inline int32_t _udp_elapsed(uint32_t current, uint32_t since) {
+        return static_cast<int32_t>(current - since);
+    }
+
+    UdpClient::UdpClient(ClientImplement *impl) : _status(Status::None),
+                                                  _connected(false),
+                                                  _shutdown(false),
+                                                  _dirty(false),
+                                                  _handle(nullptr),
+                                                  _implement(impl),
+                                                  _kcp(nullptr),
+                                                  _pending(0),
+                                                  _connectTime(0),
+                                                  _lastRecv(0),
+                                                  _lastAsk(0),
+                                                  _timer(),
+                                                  _prepare(),
+                                                  _hostAddress() {
+    }
+
+    UdpClient::~UdpClient() {
+        Resolver::Local().Cancel(this);
+        delete _kcp;
+    }
+
+    void UdpClient::SetOptions(const UdpOptions &options) {
+        _options = options;
+    }
+
+    void UdpClient::Connect(const char *host) {
+        if (!host || _status != Status::None || !Utils::HostParse(host, _hostAddress) ||
+            _hostAddress.protocol != Utils::HostProtocol::Udp) {
+            return;
+        }
+        _status = Status::Address;
+        _handle = new StreamHandle;
+        _handle->type = UV_UDP;
+        _implement->IClientInit(*_handle);
+        const auto handle = reinterpret_cast<uv_handle_t *>(&_handle->udpHandle);
+        uv_handle_set_data(handle, this);
+        if (uv_handle_get_type(handle) == UV_UNKNOWN_HANDLE) {
+            // 未初始化的句柄无法关闭
+            delete _handle;
+            _handle = nullptr;
+            _status = Status::None;
+            _implement->IClientReport(false, uv_strerror(UV_EINVAL));
+            return;
+        }
+        uv_timer_init(_handle->Loop(), &_timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_timer), this);
+        uv_prepare_init(_handle->Loop(), &_prepare);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_prepare), this);
+        if (uv_handle_get_type(handle) != UV_UDP) {
+            // IClientInit未按UDP初始化句柄
+            return ConnectFail(UV_EINVAL);
+        }
+        int status = 0;
+        std::vector<ResolvedAddress> addresses;
+        if (Resolver::Local().Resolve(_handle->Loop(), _hostAddress.host, this, status, addresses)) {
+            AddressResolved(status, addresses);
+        }
+    }
+
+    void UdpClient::Shutdown() {
+        if (_status == Status::Connected) {
+            _shutdown = true;
+            return Check();
+        }
+        Close(0);
+    }
+
+    void UdpClient::Write(const char *buf, unsigned int size) {
+        if (_status != Status::Connected || _shutdown) {
+            return;
+        }
+        if (!_kcp->Send(buf, size)) {
+            return Close(UV_EMSGSIZE);
+        }
+        _dirty = true;
+    }
+
+    unsigned int UdpClient::GetSession() const {
+        return _kcp ? _kcp->Conv() : 0;
+    }
+
+    size_t UdpClient::WriteQueueSize() const {
+        return _status == Status::Connected ? _kcp->WaitSend() : 0;
+    }
+
+    bool UdpClient::GetStats(UdpStats &stats) const {
+        if (_status != Status::Connected) {
+            return false;
+        }
+        stats.rto = _kcp->Rto();
+        stats.retransmits = _kcp->Retransmits();
+        stats.waitSend = _kcp->WaitSend();
+        return true;
+    }
+
+    void UdpClient::AddressResolved(int status, const std::vector<ResolvedAddress> &addresses) {
+        if (_status != Status::Address) {
+            return;
+        }
+        if (status != 0) {
+            return ConnectFail(status);
+        }
+        ResolvedAddress address = addresses.front();
+        _hostAddress.v6 = address.addr.sa_family == AF_INET6;
+        if (_hostAddress.v6) {
+            address.addr6.sin6_port = htons(static_cast<uint16_t>(_hostAddress.port));
+            uv_ip6_name(&address.addr6, _hostAddress.ip, sizeof(_hostAddress.ip));
+        } else {
+            address.addr4.sin_port = htons(static_cast<uint16_t>(_hostAddress.port));
+            uv_ip4_name(&address.addr4, _hostAddress.ip, sizeof(_hostAddress.ip));
+        }
+        // 连接后的套接字只收该地址的报文, 端口不可达时收发会返回UV_ECONNREFUSED
+        int err = uv_udp_connect(&_handle->udpHandle, &address.addr);
+        if (err == 0) {
+            _recvBuf.resize(kUdpClientRecvSize);
+            err = uv_udp_recv_start(&_handle->udpHandle, UdpClient::UvAllocCallback, UdpClient::UvRecvCallback);
+        }
+        if (err != 0) {
+            return ConnectFail(err);
+        }
+        std::random_device device;
+        uint32_t conv;
+        do {
+            conv = device();
+        } while (conv == 0);
+        _kcp = new Kcp(conv, this);
+        _kcp->SetOptions(_options.arq);
+        _batch.Attach(&_handle->udpHandle);
+        const auto current = static_cast<uint32_t>(uv_now(_handle->Loop()));
+        _connectTime = current;
+        _lastRecv = current;
+        _lastAsk = current;
+        _status = Status::Connecting;
+        uv_timer_start(&_timer, UdpClient::UvTimerCallback, _options.arq.interval, _options.arq.interval);
+        uv_prepare_start(&_prepare, UdpClient::UvPrepareCallback);
+        _kcp->AskWindow();
+        _kcp->Flush(current);
+        Flush();
+    }
+
+    void UdpClient::ConnectFail(int status) {
+        _status = Status::ConnectFail;
+        _implement->IClientReport(false, uv_strerror(status));
+        if (_kcp) {
+            // 服务端可能已建立会话, 只是回复丢失
+            _kcp->SendFin(static_cast<uint32_t>(uv_now(_handle->Loop())));
+            _batch.Flush();
+        }
+        Close(status);
+    }
+
+    void UdpClient::Close(int err) {
+        Resolver::Local().Cancel(this);
+        if (!_handle || _status == Status::Closing) {
+            return;
+        }
+        const auto status = _status;
+        _connected = status == Status::Connected;
+        _status = Status::Closing;
+        if (_connected) {
+            _implement->IClientBeforeDisconnect(err, err != 0 ? uv_strerror(err) : nullptr);
+        }
+        if (_kcp && err != UV_EOF && (status == Status::Connected || status == Status::Connecting)) {
+            _kcp->SendFin(static_cast<uint32_t>(uv_now(_handle->Loop())));
+            _batch.Flush();
+        }
+        _batch.Attach(nullptr);
+        _pending = 3;
+        uv_close(reinterpret_cast<uv_handle_t *>(&_timer), UdpClient::UvCloseCallback);
+        uv_close(reinterpret_cast<uv_handle_t *>(&_prepare), UdpClient::UvCloseCallback);
+        uv_close(reinterpret_cast<uv_handle_t *>(&_handle->udpHandle), UdpClient::UvCloseCallback);
+    }
+
+    void UdpClient::Check() {
+        if (_status == Status::Connected && _shutdown && _kcp->WaitSend() == 0) {
+            Close(0);
+        }
+    }
+
+    void UdpClient::Flush() {
+        const int err = _batch.Flush();
+        if (err == 0) {
+            return;
+        }
+        if (_status == Status::Connecting) {
+            return ConnectFail(err);
+        }
+        Close(err);
+    }
+
+    void UdpClient::Done() {
+        if (--_pending > 0) {
+            return;
+        }
+        delete _kcp;
+        _kcp = nullptr;
+        delete _handle;
+        _handle = nullptr;
+        _recvBuf.clear();
+        _recvBuf.shrink_to_fit();
+        _shutdown = false;
+        _dirty = false;
+        _status = Status::None;
+        if (_connected) {
+            _connected = false;
+            _implement->IClientAfterDisconnect();
+        }
+    }
+
+    void UdpClient::IKcpOutput(const char *buf, unsigned int size) {
+        _batch.Push(buf, size, nullptr);
+    }
+
+    void UdpClient::IKcpReceive(const char *buf, unsigned int size) {
+        if (_status == Status::Connected) {
+            _implement->IClientReceive(buf, size);
+        }
+    }
+
+    void UdpClient::IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) {
+        AddressResolved(status, addresses);
+    }
+
+    void UdpClient::UvAllocCallback(uv_handle_t *handle, size_t suggested, uv_buf_t *buf) {
+        auto self = static_cast<UdpClient *>(uv_handle_get_data(handle));
+        *buf = uv_buf_init(self->_recvBuf.data(), static_cast<unsigned int>(self->_recvBuf.size()));
+    }
+
+    void UdpClient::UvRecvCallback(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr,
+                                   unsigned flags) {
+        auto self = static_cast<UdpClient *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        if (nread == 0 || (self->_status != Status::Connecting && self->_status != Status::Connected)) {
+            return;
+        }
+        if (nread < 0) {
+            if (self->_status == Status::Connecting) {
+                return self->ConnectFail(static_cast<int>(nread));
+            }
+            return self->Close(static_cast<int>(nread));
+        }
+        uint32_t conv;
+        KcpCommand cmd;
+        if ((flags & UV_UDP_PARTIAL) || !Kcp::PeekConv(buf->base, static_cast<unsigned int>(nread), conv) ||
+            conv != self->_kcp->Conv() || !Kcp::PeekCommand(buf->base, static_cast<unsigned int>(nread), cmd)) {
+            return;
+        }
+        if (self->_status == Status::Connecting) {
+            if (cmd == KcpCommand::Fin) {
+                return self->ConnectFail(UV_ECONNRESET);
+            }
+            // 服务端对握手的第一个回复, 可能已带有数据, 先报告连接成功
+            self->_status = Status::Connected;
+            self->_implement->IClientReport(true, nullptr);
+            if (self->_status != Status::Connected) {
+                return;
+            }
+        }
+        const auto current = static_cast<uint32_t>(uv_now(handle->loop));
+        const int err = self->_kcp->Input(buf->base, static_cast<unsigned int>(nread), current);
+        if (err == UV_EPROTO || self->_status != Status::Connected) {
+            return;
+        }
+        self->_lastRecv = current;
+        if (err == UV_EOF) {
+            return self->Close(UV_EOF);
+        }
+        self->_dirty = true;
+        self->Check();
+    }
+
+    void UdpClient::UvTimerCallback(uv_timer_t *handle) {
+        auto self = static_cast<UdpClient *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        const auto current = static_cast<uint32_t>(uv_now(handle->loop));
+        if (self->_status == Status::Connecting) {
+            if (_udp_elapsed(current, self->_connectTime) >= static_cast<int32_t>(self->_options.connectTimeout)) {
+                return self->ConnectFail(UV_ETIMEDOUT);
+            }
+            if (_udp_elapsed(current, self->_lastAsk) >= static_cast<int32_t>(kUdpHandshakeInterval)) {
+                self->_lastAsk = current;
+                self->_kcp->AskWindow();
+                self->_kcp->Flush(current);
+                self->Flush();
+            }
+            return;
+        }
+        if (self->_status != Status::Connected) {
+            return;
+        }
+        if (_udp_elapsed(current, self->_lastAsk) >= static_cast<int32_t>(self->_options.idleTimeout / 3)) {
+            // 保活, 服务端回复窗口告知
+            self->_lastAsk = current;
+            self->_kcp->AskWindow();
+        }
+        self->_kcp->Update(current);
+        if (self->_kcp->IsDead() ||
+            _udp_elapsed(current, self->_lastRecv) >= static_cast<int32_t>(self->_options.idleTimeout)) {
+            return self->Close(UV_ETIMEDOUT);
+        }
+        self->Flush();
+        self->Check();
+    }
+
+    void UdpClient::UvPrepareCallback(uv_prepare_t *handle) {
+        auto self = static_cast<UdpClient *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        if (!self->_dirty || self->_status != Status::Connected) {
+            return;
+        }
+        self->_dirty = false;
+        self->_kcp->Flush(static_cast<uint32_t>(uv_now(handle->loop)));
+        self->Flush();
+    }
+
+    void UdpClient::UvCloseCallback(uv_handle_t *handle) {
+        auto self = static_cast<UdpClient *>(uv_handle_get_data(handle));
+        self->Done();
+    }
+}
@@ -0,0 +1,446 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <algorithm>
+#include <cstring>
+#include "network/UdpServer.h"
+
+namespace Lcc {
+    // 单个UDP报文的最大长度, recvmmsg按此大小切分接收缓冲区
+    static constexpr unsigned int kUdpDatagramSize = 64 * 1024;
+
+    static std::string _udp_session_key(uint32_t conv, const sockaddr *addr) {
+        std::string key(reinterpret_cast<const char *>(&conv), sizeof(conv));
+        if (addr->sa_family == AF_INET6) {
+            const auto addr6 = reinterpret_cast<const sockaddr_in6 *>(addr);
+            key.append(reinterpret_cast<const char *>(&addr6->sin6_port), sizeof(addr6->sin6_port));
+            key.append(reinterpret_cast<const char *>(&addr6->sin6_addr), sizeof(addr6->sin6_addr));
+        } else {
+            const auto addr4 = reinterpret_cast<const sockaddr_in *>(addr);
+            key.append(reinterpret_cast<const char *>(&addr4->sin_port), sizeof(addr4->sin_port));
+            key.append(reinterpret_cast<const char *>(&addr4->sin_addr), sizeof(addr4->sin_addr));
+        }
+        return key;
+    }
+
+    /**
+     * 一个客户端会话, 关闭后仍在地址表中暂留, 对迟到的报文回复关闭报文
+     */
+    class UdpServer::Session : public KcpImplement {
+    public:
+        Session(UdpServer *server, unsigned int id, const sockaddr *addr, uint32_t conv) : server(server),
+            id(id),
+            closing(false),
+            shutdown(false),
+            draining(false),
+            dirty(false),
+            lastRecv(0),
+            closeTime(0),
+            address(),
+            kcp(conv, this) {
+            memcpy(&address, addr, addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in));
+        }
+
+        void Input(const char *buf, unsigned int size, uint32_t current) {
+            if (closing) {
+                // 对端可能没有收到关闭报文
+                KcpCommand cmd;
+                if (Kcp::PeekCommand(buf, size, cmd) && cmd != KcpCommand::Fin) {
+                    kcp.SendFin(current);
+                }
+                return;
+            }
+            const int err = kcp.Input(buf, size, current);
+            if (err == UV_EPROTO || closing) {
+                return;
+            }
+            lastRecv = current;
+            if (err == UV_EOF) {
+                return Close(UV_EOF, current);
+            }
+            server->MarkDirty(this);
+            Check(current);
+        }
+
+        void Update(uint32_t current) {
+            kcp.Update(current);
+            if (kcp.IsDead() || static_cast<int32_t>(current - lastRecv) >= static_cast<int32_t>(server->_options.
+                    idleTimeout)) {
+                return Close(UV_ETIMEDOUT, current);
+            }
+            Check(current);
+        }
+
+        void Check(uint32_t current) {
+            if (closing || kcp.WaitSend() > 0) {
+                return;
+            }
+            if (shutdown) {
+                return Close(0, current);
+            }
+            if (draining) {
+                draining = false;
+                server->_implement->IServerSessionWriteDrain(id);
+            }
+        }
+
+        void Close(int err, uint32_t current) {
+            if (closing) {
+                return;
+            }
+            closing = true;
+            closeTime = current;
+            server->_implement->IServerSessionBeforeClose(id, err, err != 0 ? uv_strerror(err) : nullptr);
+            if (err != UV_EOF) {
+                kcp.SendFin(current);
+            }
+            server->SessionClosed(this);
+        }
+
+    protected:
+        void IKcpOutput(const char *buf, unsigned int size) override {
+            server->_batch.Push(buf, size, &address.addr);
+        }
+
+        void IKcpReceive(const char *buf, unsigned int size) override {
+            if (!closing) {
+                server->_implement->IServerSessionReceive(id, buf, size);
+            }
+        }
+
+    public:
+        UdpServer *server;
+        unsigned int id;
+        bool closing;
+        // 等待已写入的数据确认后关闭
+        bool shutdown;
+        // 写入后尚未全部确认, 确认后触发写完成回调
+        bool draining;
+        bool dirty;
+        uint32_t lastRecv;
+        uint32_t closeTime;
+        ResolvedAddress address;
+        Kcp kcp;
+    };
+
+    UdpServer::UdpServer(ServerImplement *impl) : _status(Status::None),
+                                                  _handle(nullptr),
+                                                  _isession(0),
+                                                  _pending(0),
+                                                  _implement(impl),
+                                                  _hostAddress(),
+                                                  _address(),
+                                                  _timer(),
+                                                  _prepare() {
+    }
+
+    UdpServer::~UdpServer() {
+        Resolver::Local().Cancel(this);
+    }
+
+    void UdpServer::SetOptions(const UdpOptions &options) {
+        _options = options;
+    }
+
+    void UdpServer::Listen(const char *host) {
+        if (!host || _status != Status::None || !Utils::HostParse(host, _hostAddress) ||
+            _hostAddress.protocol != Utils::HostProtocol::Udp) {
+            return;
+        }
+        _status = Status::Address;
+        _handle = new StreamHandle;
+        _handle->type = UV_UDP;
+        _implement->IServerInit(*_handle);
+        const auto handle = reinterpret_cast<uv_handle_t *>(&_handle->udpHandle);
+        uv_handle_set_data(handle, this);
+        if (uv_handle_get_type(handle) == UV_UNKNOWN_HANDLE) {
+            // 未初始化的句柄无法关闭
+            delete _handle;
+            _handle = nullptr;
+            _status = Status::ListenFail;
+            _implement->IServerListenReport(false, UV_EINVAL, uv_strerror(UV_EINVAL));
+            return;
+        }
+        uv_timer_init(_handle->Loop(), &_timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_timer), this);
+        uv_prepare_init(_handle->Loop(), &_prepare);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_prepare), this);
+        if (uv_handle_get_type(handle) != UV_UDP) {
+            // IServerInit未按UDP初始化句柄
+            return ListenFail(UV_EINVAL);
+        }
+        int status = 0;
+        std::vector<ResolvedAddress> addresses;
+        if (Resolver::Local().Resolve(_handle->Loop(), _hostAddress.host, this, status, addresses)) {
+            AddressResolved(status, addresses);
+        }
+    }
+
+    void UdpServer::Shutdown() {
+        Resolver::Local().Cancel(this);
+        if (!_handle || _status == Status::Closing) {
+            return;
+        }
+        const auto current = static_cast<uint32_t>(uv_now(_handle->Loop()));
+        std::vector<Session *> sessions;
+        sessions.reserve(_sessionMap.size());
+        for (const auto &it: _sessionMap) {
+            sessions.push_back(it.second);
+        }
+        for (auto session: sessions) {
+            session->Close(0, current);
+        }
+        _batch.Flush();
+        _batch.Attach(nullptr);
+        _status = Status::Closing;
+        _pending = 3;
+        uv_close(reinterpret_cast<uv_handle_t *>(&_timer), UdpServer::UvCloseCallback);
+        uv_close(reinterpret_cast<uv_handle_t *>(&_prepare), UdpServer::UvCloseCallback);
+        uv_close(reinterpret_cast<uv_handle_t *>(&_handle->udpHandle), UdpServer::UvCloseCallback);
+    }
+
+    void UdpServer::ShutdownAllSessions() {
+        std::vector<unsigned int> sessions;
+        sessions.reserve(_sessionMap.size());
+        for (const auto &it: _sessionMap) {
+            sessions.push_back(it.first);
+        }
+        for (auto session: sessions) {
+            ShutdownSession(session);
+        }
+    }
+
+    void UdpServer::ShutdownSession(unsigned int session) {
+        auto sessionObject = GetOpenSession(session);
+        if (sessionObject) {
+            sessionObject->shutdown = true;
+            sessionObject->Check(static_cast<uint32_t>(uv_now(_handle->Loop())));
+        }
+    }
+
+    const Utils::HostAddress &UdpServer::GetListenAddress() const {
+        return _hostAddress;
+    }
+
+    void UdpServer::SessionWrite(unsigned int session, const char *buf, unsigned int size) {
+        auto sessionObject = GetOpenSession(session);
+        if (!sessionObject) {
+            return;
+        }
+        if (!sessionObject->kcp.Send(buf, size)) {
+            return sessionObject->Close(UV_EMSGSIZE, static_cast<uint32_t>(uv_now(_handle->Loop())));
+        }
+        sessionObject->draining = true;
+        MarkDirty(sessionObject);
+    }
+
+    size_t UdpServer::SessionWriteQueueSize(unsigned int session) {
+        auto it = _sessionMap.find(session);
+        return it != _sessionMap.end() ? it->second->kcp.WaitSend() : 0;
+    }
+
+    bool UdpServer::GetSessionStats(unsigned int session, UdpStats &stats) {
+        auto it = _sessionMap.find(session);
+        if (it == _sessionMap.end()) {
+            return false;
+        }
+        stats.rto = it->second->kcp.Rto();
+        stats.retransmits = it->second->kcp.Retransmits();
+        stats.waitSend = it->second->kcp.WaitSend();
+        return true;
+    }
+
+    const UdpBatch &UdpServer::GetBatch() const {
+        return _batch;
+    }
+
+    void UdpServer::AddressResolved(int status, const std::vector<ResolvedAddress> &addresses) {
+        if (_status != Status::Address || !_handle) {
+            return;
+        }
+        if (status != 0) {
+            return ListenFail(status);
+        }
+        _address = addresses.front();
+        if (_address.addr.sa_family == AF_INET6) {
+            _address.addr6.sin6_port = htons(static_cast<uint16_t>(_hostAddress.port));
+        } else {
+            _address.addr4.sin_port = htons(static_cast<uint16_t>(_hostAddress.port));
+        }
+        int err = uv_udp_bind(&_handle->udpHandle, &_address.addr, 0);
+        if (err == 0) {
+            // 端口为0时取系统分配的端口
+            int size = sizeof(_address);
+            err = uv_udp_getsockname(&_handle->udpHandle, &_address.addr, &size);
+        }
+        if (err == 0) {
+            _recvBuf.resize(kRecvBatch * kUdpDatagramSize);
+            err = uv_udp_recv_start(&_handle->udpHandle, UdpServer::UvAllocCallback, UdpServer::UvRecvCallback);
+        }
+        if (err != 0) {
+            return ListenFail(err);
+        }
+        _hostAddress.v6 = _address.addr.sa_family == AF_INET6;
+        if (_hostAddress.v6) {
+            _hostAddress.port = ntohs(_address.addr6.sin6_port);
+            uv_ip6_name(&_address.addr6, _hostAddress.ip, sizeof(_hostAddress.ip));
+        } else {
+            _hostAddress.port = ntohs(_address.addr4.sin_port);
+            uv_ip4_name(&_address.addr4, _hostAddress.ip, sizeof(_hostAddress.ip));
+        }
+        _batch.Attach(&_handle->udpHandle);
+        uv_timer_start(&_timer, UdpServer::UvTimerCallback, _options.arq.interval, _options.arq.interval);
+        uv_prepare_start(&_prepare, UdpServer::UvPrepareCallback);
+        _status = Status::Listened;
+        _implement->IServerListenReport(true, 0, nullptr);
+    }
+
+    void UdpServer::ListenFail(int status) {
+        _errdesc = uv_strerror(status);
+        _status = Status::ListenFail;
+        _implement->IServerListenReport(false, status, _errdesc.c_str());
+        Shutdown();
+    }
+
+    void UdpServer::Dispatch(const char *buf, unsigned int size, const sockaddr *addr) {
+        uint32_t conv;
+        if (!Kcp::PeekConv(buf, size, conv)) {
+            return;
+        }
+        const auto current = static_cast<uint32_t>(uv_now(_handle->Loop()));
+        const auto key = _udp_session_key(conv, addr);
+        auto it = _addressMap.find(key);
+        if (it != _addressMap.end()) {
+            return it->second->Input(buf, size, current);
+        }
+        // 只有以窗口询问开头的报文才建立会话, 已清理的会话迟到的数据不会重新建立会话
+        KcpCommand cmd;
+        if (conv == 0 || !Kcp::PeekCommand(buf, size, cmd) || cmd != KcpCommand::WindowAsk) {
+            return;
+        }
+        unsigned int session = 0;
+        while (++_isession) {
+            if (_sessionMap.find(_isession) == _sessionMap.end()) {
+                session = _isession;
+                break;
+            }
+        }
+        auto sessionObject = new Session(this, session, addr, conv);
+        sessionObject->kcp.SetOptions(_options.arq);
+        sessionObject->lastRecv = current;
+        _addressMap[key] = sessionObject;
+        _sessionMap[session] = sessionObject;
+        _implement->IServerSessionOpen(session);
+        sessionObject->Input(buf, size, current);
+    }
+
+    UdpServer::Session *UdpServer::GetOpenSession(unsigned int session) {
+        auto it = _sessionMap.find(session);
+        if (it != _sessionMap.end() && !it->second->shutdown) {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    void UdpServer::MarkDirty(Session *session) {
+        if (!session->dirty && !session->closing) {
+            session->dirty = true;
+            _dirtyVec.push_back(session);
+        }
+    }
+
+    void UdpServer::SessionClosed(Session *session) {
+        _sessionMap.erase(session->id);
+        _closedVec.push_back(session->id);
+    }
+
+    void UdpServer::ReportClosed() {
+        while (!_closedVec.empty()) {
+            std::vector<unsigned int> closed;
+            closed.swap(_closedVec);
+            for (auto session: closed) {
+                _implement->IServerSessionAfterClose(session);
+            }
+        }
+    }
+
+    void UdpServer::Done() {
+        if (--_pending > 0) {
+            return;
+        }
+        ReportClosed();
+        for (const auto &it: _addressMap) {
+            delete it.second;
+        }
+        _addressMap.clear();
+        _sessionMap.clear();
+        _dirtyVec.clear();
+        _recvBuf.clear();
+        _recvBuf.shrink_to_fit();
+        delete _handle;
+        _handle = nullptr;
+        _status = Status::None;
+        _implement->IServerShutdown();
+    }
+
+    void UdpServer::IResolveReport(int status, const std::vector<ResolvedAddress> &addresses) {
+        AddressResolved(status, addresses);
+    }
+
+    void UdpServer::UvAllocCallback(uv_handle_t *handle, size_t suggested, uv_buf_t *buf) {
+        auto self = static_cast<UdpServer *>(uv_handle_get_data(handle));
+        *buf = uv_buf_init(self->_recvBuf.data(), static_cast<unsigned int>(self->_recvBuf.size()));
+    }
+
+    void UdpServer::UvRecvCallback(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr,
+                                   unsigned flags) {
+        auto self = static_cast<UdpServer *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        // nread为0时是没有数据或一批报文结束; 未连接的套接字上的错误不针对某个会话, 忽略
+        if (nread <= 0 || !addr || (flags & UV_UDP_PARTIAL) || self->_status != Status::Listened) {
+            return;
+        }
+        self->Dispatch(buf->base, static_cast<unsigned int>(nread), addr);
+    }
+
+    void UdpServer::UvTimerCallback(uv_timer_t *handle) {
+        auto self = static_cast<UdpServer *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        const auto current = static_cast<uint32_t>(uv_now(handle->loop));
+        const auto linger = static_cast<int32_t>(std::max(self->_options.idleTimeout, 1000U));
+        for (auto it = self->_addressMap.begin(); it != self->_addressMap.end();) {
+            auto session = it->second;
+            if (!session->closing) {
+                session->Update(current);
+                ++it;
+            } else if (static_cast<int32_t>(current - session->closeTime) >= linger) {
+                if (session->dirty) {
+                    self->_dirtyVec.erase(std::find(self->_dirtyVec.begin(), self->_dirtyVec.end(), session));
+                }
+                delete session;
+                it = self->_addressMap.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        // 发往单个对端的错误不影响其余会话
+        self->_batch.Flush();
+    }
+
+    void UdpServer::UvPrepareCallback(uv_prepare_t *handle) {
+        auto self = static_cast<UdpServer *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        self->ReportClosed();
+        const auto current = static_cast<uint32_t>(uv_now(handle->loop));
+        for (auto session: self->_dirtyVec) {
+            session->dirty = false;
+            if (!session->closing) {
+                session->kcp.Flush(current);
+            }
+        }
+        self->_dirtyVec.clear();
+        self->_batch.Flush();
+    }
+
+    void UdpServer::UvCloseCallback(uv_handle_t *handle) {
+        auto self = static_cast<UdpServer *>(uv_handle_get_data(handle));
+        self->Done();
+    }
+}
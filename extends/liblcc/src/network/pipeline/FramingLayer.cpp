@@ -0,0 +1,135 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include "network/pipeline/FramingLayer.h"
+
+namespace Lcc {
+    // 超过该容量的残帧缓存用完即释放, 避免偶发大帧长期占用内存
+    static const size_t kKeepPendingCapacity = 0x10000;
+
+    FramingLayer::FramingLayer(const Config &config) : _error(0),
+                                                       _closed(false),
+                                                       _header(config.header),
+                                                       // 2字节长度头最多表示0xFFFF
+                                                       _maxSize(config.header == FrameHeader::Fixed16
+                                                                    ? std::min(config.maxSize, 0xFFFFU)
+                                                                    : config.maxSize),
+                                                       _need(0),
+                                                       _head(0),
+                                                       _direct(0),
+                                                       _buffered(0) {
+    }
+
+    unsigned int FramingLayer::EncodeHead(FrameHeader header, unsigned int size, char *out) {
+        switch (header) {
+            case FrameHeader::Fixed16:
+                out[0] = static_cast<char>(size >> 8);
+                out[1] = static_cast<char>(size);
+                return 2;
+            case FrameHeader::Fixed32:
+                out[0] = static_cast<char>(size >> 24);
+                out[1] = static_cast<char>(size >> 16);
+                out[2] = static_cast<char>(size >> 8);
+                out[3] = static_cast<char>(size);
+                return 4;
+            default: {
+                unsigned int n = 0;
+                while (size >= 0x80) {
+                    out[n++] = static_cast<char>((size & 0x7F) | 0x80);
+                    size >>= 7;
+                }
+                out[n++] = static_cast<char>(size);
+                return n;
+            }
+        }
+    }
+
+    int FramingLayer::DecodeHead(FrameHeader header, const char *buf, unsigned int size, unsigned int &body) {
+        const auto p = reinterpret_cast<const unsigned char *>(buf);
+        switch (header) {
+            case FrameHeader::Fixed16:
+                if (size < 2) {
+                    return 0;
+                }
+                body = static_cast<unsigned int>(p[0]) << 8 | p[1];
+                return 2;
+            case FrameHeader::Fixed32:
+                if (size < 4) {
+                    return 0;
+                }
+                body = static_cast<unsigned int>(p[0]) << 24 | static_cast<unsigned int>(p[1]) << 16 |
+                       static_cast<unsigned int>(p[2]) << 8 | p[3];
+                return 4;
+            default: {
+                unsigned int value = 0;
+                for (unsigned int n = 0; n < kMaxHeadSize; ++n) {
+                    if (n >= size) {
+                        return 0;
+                    }
+                    // 第5字节只能携带32位中剩余的4位
+                    if (n == kMaxHeadSize - 1 && p[n] > 0x0F) {
+                        return -1;
+                    }
+                    value |= static_cast<unsigned int>(p[n] & 0x7F) << (7 * n);
+                    if (!(p[n] & 0x80)) {
+                        body = value;
+                        return static_cast<int>(n + 1);
+                    }
+                }
+                return -1;
+            }
+        }
+    }
+
+    bool FramingLayer::Init() {
+        return true;
+    }
+
+    int FramingLayer::LastError() const {
+        return _error;
+    }
+
+    const char *FramingLayer::LastErrDesc() const {
+        return _errorstr.c_str();
+    }
+
+    unsigned long long FramingLayer::DirectFrames() const {
+        return _direct;
+    }
+
+    unsigned long long FramingLayer::BufferedFrames() const {
+        return _buffered;
+    }
+
+    void FramingLayer::Hold(int head, unsigned int body, const char *buf, unsigned int size) {
+        _head = static_cast<unsigned int>(head);
+        _need = head > 0 ? _head + body : 0;
+        if (_need > 0) {
+            _pending.reserve(_need);
+        }
+        _pending.assign(buf, size);
+    }
+
+    int FramingLayer::CompleteHead() {
+        unsigned int body = 0;
+        const int head = DecodeHead(_header, _pending.data(), static_cast<unsigned int>(_pending.size()), body);
+        if (head < 0 || body > _maxSize) {
+            _errorstr = head < 0 ? "frame header malformed" : "frame too large";
+            return -1;
+        }
+        if (head > 0) {
+            _head = static_cast<unsigned int>(head);
+            _need = _head + body;
+            _pending.reserve(_need);
+        }
+        return head;
+    }
+
+    void FramingLayer::Recycle(std::string &frame) {
+        if (_pending.empty() && frame.capacity() <= kKeepPendingCapacity) {
+            // 复用缓存容量
+            frame.clear();
+            _pending.swap(frame);
+        }
+    }
+}
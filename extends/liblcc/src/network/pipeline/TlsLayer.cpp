@@ -0,0 +1,179 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include "network/pipeline/TlsLayer.h"
+#include "network/NetMetrics.h"
+#include "trace/Trace.h"
+
+namespace Lcc {
+    TlsLayer::TlsLayer(const Config &config) : _closed(false),
+                                               _error(0),
+                                               _handshakeStart(0),
+                                               _server(config.server),
+                                               _hostname(config.hostname),
+                                               _caroot(config.caroot) {
+        _buffer.resize(0x4000); // 16384
+        _errorstr.resize(256);
+        _errorstr.clear();
+    }
+
+    TlsLayer::~TlsLayer() {
+        _mbedtls.Release();
+    }
+
+    bool TlsLayer::Init() {
+        if (_server) {
+            return _mbedtls.InitializeForSession(*_server);
+        }
+        return _mbedtls.InitializeForClient(_hostname.c_str(), _caroot.empty() ? nullptr : _caroot.c_str());
+    }
+
+    Protocol::MbedTLS &TlsLayer::GetMbedTLS() {
+        return _mbedtls;
+    }
+
+    int TlsLayer::LastError() const {
+        return _error;
+    }
+
+    const char *TlsLayer::LastErrDesc() {
+        if (_error) {
+            mbedtls_strerror(_error, const_cast<char *>(_errorstr.data()), _errorstr.capacity());
+        }
+        return _errorstr.c_str();
+    }
+
+    bool TlsLayer::LinkOpen() {
+        _handshakeStart = uv_hrtime();
+        mbedtls_ssl_set_bio(_mbedtls.GetSSLContext(), this, TlsLayer::MbedTLSSendCallback,
+                            TlsLayer::MbedTLSRecvCallback, nullptr);
+        if (_mbedtls.ClientMode()) {
+            if (!Handshake()) {
+                _link.Close();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool TlsLayer::LinkRead(const char *buf, unsigned int size) {
+        if (_closed) {
+            return false;
+        }
+        _bufferIn.Write(buf, size);
+        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
+        if (ctx->private_state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            if (!Handshake()) {
+                _link.Close();
+                return false;
+            }
+            if (ctx->private_state == MBEDTLS_SSL_HANDSHAKE_OVER) {
+                if (!_mbedtls.Verify()) {
+                    _link.Close();
+                    return false;
+                }
+                NetMetrics::Instance().tlsHandshake.Record(uv_hrtime() - _handshakeStart);
+                _link.Open();
+                if (_closed) {
+                    return false;
+                }
+            }
+        }
+        if (ctx->private_state == MBEDTLS_SSL_HANDSHAKE_OVER) {
+            // 解密后的数据可能多于一次读取的缓冲区, 需要同时检查mbedtls内部剩余
+            while (_bufferIn.UsedSize() > 0 || mbedtls_ssl_get_bytes_avail(ctx) > 0) {
+                const int r = mbedtls_ssl_read(ctx, reinterpret_cast<unsigned char *>(&_buffer[0]), _buffer.size());
+                if (r == MBEDTLS_ERR_SSL_WANT_READ || r == MBEDTLS_ERR_SSL_WANT_WRITE) {
+                    // 记录不完整, 等待后续数据
+                    break;
+                }
+                if (r <= 0) {
+                    _error = r;
+                    _link.Close();
+                    return false;
+                }
+                LCC_TRACE_POINT(TlsRead, r);
+                _link.Read(_buffer.data(), static_cast<unsigned int>(r));
+                // 上层可能在回调中关闭, 此时mbedtls上下文已释放
+                if (_closed) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void TlsLayer::LinkWrite(const char *buf, unsigned int size) {
+        if (_closed) {
+            return;
+        }
+        LCC_TRACE_POINT(TlsWrite, size);
+        unsigned int offset = 0;
+        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
+        do {
+            const int r = mbedtls_ssl_write(ctx, reinterpret_cast<const unsigned char *>(buf + offset), size - offset);
+            if (r < 0 && r != MBEDTLS_ERR_SSL_WANT_READ && r != MBEDTLS_ERR_SSL_WANT_WRITE) {
+                _error = r;
+                return _link.Close();
+            }
+            WantFlush();
+            if (r > 0) {
+                offset += r;
+            }
+        } while (offset < size);
+    }
+
+    void TlsLayer::LinkClose() {
+        if (_closed) {
+            return;
+        }
+        _closed = true;
+        _mbedtls.Release();
+        // 握手未完成时同样需要关闭下层流
+        _link.Close();
+    }
+
+    bool TlsLayer::Handshake() {
+        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
+        while (ctx->private_state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            const int r = mbedtls_ssl_handshake_step(ctx);
+            if (r != 0 && r != MBEDTLS_ERR_SSL_WANT_READ && r != MBEDTLS_ERR_SSL_WANT_WRITE) {
+                // 只记录真正的失败, 等待数据不算错误
+                _error = r;
+                return false;
+            }
+            if (r == MBEDTLS_ERR_SSL_WANT_READ) {
+                break;
+            }
+        }
+        WantFlush();
+        return true;
+    }
+
+    void TlsLayer::WantFlush() {
+        // 直接从输出缓冲区写出, 不占用读取用的_buffer(上层可能在收到数据的回调中写入)
+        while (_bufferOut.UsedSize() > 0) {
+            const unsigned int size = _bufferOut.ContiguousSize();
+            _link.Write(_bufferOut.Data(), size);
+            _bufferOut.Skip(size);
+        }
+    }
+
+    int TlsLayer::MbedTLSRecvCallback(void *ctx, unsigned char *buf, size_t size) {
+        auto layer = static_cast<TlsLayer *>(ctx);
+        const int r = static_cast<int>(layer->_bufferIn.Read(reinterpret_cast<char *>(buf), size));
+        if (r > 0) {
+            return r;
+        }
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+
+    int TlsLayer::MbedTLSSendCallback(void *ctx, const unsigned char *buf, size_t size) {
+        auto layer = static_cast<TlsLayer *>(ctx);
+        const int r = static_cast<int>(layer->_bufferOut.Write(reinterpret_cast<const char *>(buf), size));
+        if (r > 0) {
+            return r;
+        }
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+}
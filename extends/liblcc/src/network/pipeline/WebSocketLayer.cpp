@@ -0,0 +1,115 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include "network/pipeline/WebSocketLayer.h"
+#include "network/NetMetrics.h"
+#include "trace/Trace.h"
+
+namespace Lcc {
+    WebSocketLayer::WebSocketLayer(const Config &config) : _error(0),
+                                                           _handshaked(false),
+                                                           _handshakeStart(0),
+                                                           _hostname(config.hostname),
+                                                           _opcode(config.opcode),
+                                                           _protocol(this) {
+        _errorstr.resize(256);
+        _errorstr.clear();
+    }
+
+    WebSocketLayer::~WebSocketLayer() = default;
+
+    bool WebSocketLayer::Init() {
+        _protocol.Initialize();
+        return true;
+    }
+
+    void WebSocketLayer::InitializeServerMode() {
+        _hostname.clear();
+        _protocol.Initialize();
+    }
+
+    void WebSocketLayer::InitializeClientMode(const char *host) {
+        if (host) {
+            _hostname = host;
+            _protocol.Initialize();
+        }
+    }
+
+    int WebSocketLayer::LastError() const {
+        return _error;
+    }
+
+    const char *WebSocketLayer::LastErrDesc() const {
+        return _errorstr.c_str();
+    }
+
+    bool WebSocketLayer::LinkOpen() {
+        _handshakeStart = uv_hrtime();
+        if (!_hostname.empty() && !_handshaked) {
+            _protocol.HandshakeRequest(_hostname.c_str(), _serverKey);
+        }
+        return true;
+    }
+
+    bool WebSocketLayer::LinkRead(const char *buf, unsigned int size) {
+        if (!_handshaked) {
+            if (!_hostname.empty()) {
+                if (!_protocol.CheckServerSecKey(buf, size, _serverKey)) {
+                    _link.Close();
+                    return false;
+                }
+            } else {
+                if (!_protocol.HandshakeResponse(buf, size)) {
+                    _link.Close();
+                    return false;
+                }
+            }
+            _handshaked = true;
+            NetMetrics::Instance().wsHandshake.Record(uv_hrtime() - _handshakeStart);
+            _link.Open();
+        } else {
+            if (!_protocol.Read(buf, size)) {
+                ImplementClose(WebSocketCode::AbNormal);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void WebSocketLayer::ImplementClose(WebSocketCode code) {
+        _protocol.Close(code);
+        _error = static_cast<int>(code);
+        _errorstr = _protocol.GetErrorDesc(code);
+        _link.Close();
+    }
+
+    void WebSocketLayer::IWebSocketInit(WebSocketMode &mode) {
+        mode.mark = !_hostname.empty();
+        mode.opcode = _opcode;
+    }
+
+    void WebSocketLayer::IWebSocketReceive(WebSocketFrameHeader &header, const char *buf, unsigned int size) {
+        switch (header.opcode) {
+            case WebSocketOpcode::Close:
+                ImplementClose(WebSocketCode::Normal);
+                break;
+            case WebSocketOpcode::Pong:
+                _protocol.Pong(buf, size);
+                break;
+            default: {
+                if (header.opcode != _opcode) {
+                    ImplementClose(WebSocketCode::Unsupported);
+                    break;
+                }
+                LCC_TRACE_POINT(WsRead, size);
+                _link.Read(buf, size);
+                break;
+            }
+        }
+    }
+
+    void WebSocketLayer::IWebSocketWrite(const char *buf, unsigned int size) {
+        LCC_TRACE_POINT(WsWrite, size);
+        _link.Write(buf, size);
+    }
+}
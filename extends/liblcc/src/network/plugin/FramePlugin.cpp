@@ -0,0 +1,82 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include "network/plugin/FramePlugin.h"
+
+namespace Lcc {
+    FramePlugin::FramePlugin(FrameHeader header, unsigned int maxSize, ProtocolImplement *impl) : ProtocolPlugin(
+            ProtocolLevel::Application, impl),
+        _layer({header, maxSize}) {
+    }
+
+    FramePlugin::~FramePlugin() = default;
+
+    unsigned int FramePlugin::EncodeHead(FrameHeader header, unsigned int size, char *out) {
+        return FramingLayer::EncodeHead(header, size, out);
+    }
+
+    int FramePlugin::DecodeHead(FrameHeader header, const char *buf, unsigned int size, unsigned int &body) {
+        return FramingLayer::DecodeHead(header, buf, size, body);
+    }
+
+    unsigned long long FramePlugin::DirectFrames() const {
+        return _layer.DirectFrames();
+    }
+
+    unsigned long long FramePlugin::BufferedFrames() const {
+        return _layer.BufferedFrames();
+    }
+
+    int FramePlugin::IProtocolLastError() {
+        return _layer.LastError();
+    }
+
+    const char *FramePlugin::IProtocolLastErrDesc() {
+        return _layer.LastErrDesc();
+    }
+
+    bool FramePlugin::IProtocolPluginOpen() {
+        PluginPort port(this);
+        return _layer.Open(port);
+    }
+
+    bool FramePlugin::IProtocolPluginRead(const char *buf, unsigned int size) {
+        PluginPort port(this);
+        return _layer.Read(port, buf, size);
+    }
+
+    void FramePlugin::IProtocolPluginWrite(const char *buf, unsigned int size) {
+        PluginPort port(this);
+        _layer.Write(port, buf, size);
+    }
+
+    void FramePlugin::IProtocolPluginClose() {
+        PluginPort port(this);
+        _layer.Close(port);
+    }
+
+    void FramePlugin::IProtocolPluginRelease() {
+        delete this;
+    }
+
+    FramePluginCreator::FramePluginCreator() : _init(false), _header(FrameHeader::Fixed32), _maxSize(0x100000) {
+    }
+
+    void FramePluginCreator::Initialize(FrameHeader header, unsigned int maxSize) {
+        _init = true;
+        _header = header;
+        _maxSize = maxSize;
+    }
+
+    bool FramePluginCreator::ICreatorInit() {
+        return _init;
+    }
+
+    void FramePluginCreator::ICreatorRelease() {
+        delete this;
+    }
+
+    ProtocolPlugin *FramePluginCreator::ICreatorAlloc(ProtocolImplement *impl) {
+        return new FramePlugin(_header, _maxSize, impl);
+    }
+}
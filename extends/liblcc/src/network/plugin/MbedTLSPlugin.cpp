@@ -5,158 +5,49 @@
 
 namespace Lcc {
     MbedTLSPlugin::MbedTLSPlugin(ProtocolImplement *impl) : ProtocolPlugin(ProtocolLevel::StreamWithSSL, impl),
-                                                            _error(0) {
-        _buffer.resize(0x4000); // 16384
-        _buffer.clear();
-        _errorstr.resize(256);
-        _errorstr.clear();
+                                                            _layer({nullptr, std::string(), std::string()}) {
     }
 
-    MbedTLSPlugin::~MbedTLSPlugin() {
-        _mbedtls.Release();
-    }
+    MbedTLSPlugin::~MbedTLSPlugin() = default;
 
     Protocol::MbedTLS &MbedTLSPlugin::GetMbedTLS() {
-        return _mbedtls;
+        return _layer.GetMbedTLS();
     }
 
     int MbedTLSPlugin::IProtocolLastError() {
-        return _error;
+        return _layer.LastError();
     }
 
     const char *MbedTLSPlugin::IProtocolLastErrDesc() {
-        if (_error) {
-            mbedtls_strerror(_error, const_cast<char *>(_errorstr.data()), _errorstr.capacity());
-        }
-        return _errorstr.c_str();
+        return _layer.LastErrDesc();
     }
 
     bool MbedTLSPlugin::IProtocolPluginOpen() {
-        mbedtls_ssl_set_bio(_mbedtls.GetSSLContext(), this, MbedTLSPlugin::MbedTLSSendCallback,
-                            MbedTLSPlugin::MbedTLSRecvCallback, nullptr);
-        if (_mbedtls.ClientMode()) {
-            if (!Handshake()) {
-                ImplementClose();
-                return false;
-            }
-        }
-        return true;
+        PluginPort port(this);
+        return _layer.Open(port);
     }
 
     bool MbedTLSPlugin::IProtocolPluginRead(const char *buf, unsigned int size) {
-        _bufferIn.Write(buf, size);
-        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
-        if (ctx->private_state != MBEDTLS_SSL_HANDSHAKE_OVER) {
-            if (!Handshake()) {
-                ImplementClose();
-                return false;
-            }
-            if (ctx->private_state == MBEDTLS_SSL_HANDSHAKE_OVER) {
-                if (!_mbedtls.Verify()) {
-                    ImplementClose();
-                    return false;
-                }
-                ImplementOpen();
-            }
-        }
-        if (ctx->private_state == MBEDTLS_SSL_HANDSHAKE_OVER) {
-            while (_bufferIn.UsedSize() > 0) {
-                int r = mbedtls_ssl_read(ctx, reinterpret_cast<unsigned char *>(const_cast<char *>(_buffer.data())),
-                                         _buffer.capacity());
-                if (r <= 0 && r != MBEDTLS_ERR_SSL_WANT_READ && r != MBEDTLS_ERR_SSL_WANT_WRITE) {
-                    _error = r;
-                    ImplementClose();
-                    return false;
-                }
-                ImplementReceive(_buffer.data(), r);
-            }
-        }
-        return true;
+        PluginPort port(this);
+        return _layer.Read(port, buf, size);
     }
 
     void MbedTLSPlugin::IProtocolPluginWrite(const char *buf, unsigned int size) {
-        unsigned int offset = 0;
-        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
-        do {
-            int r = mbedtls_ssl_write(ctx, reinterpret_cast<const unsigned char *>(buf + offset), size - offset);
-            if (r > 0 || r == MBEDTLS_ERR_SSL_WANT_READ || r == MBEDTLS_ERR_SSL_WANT_WRITE) {
-                WantFlush();
-            } else {
-                _error = r;
-                return ImplementClose();
-            }
-            offset += r;
-        } while (offset < size);
+        PluginPort port(this);
+        _layer.Write(port, buf, size);
     }
 
     void MbedTLSPlugin::IProtocolPluginClose() {
-        bool handshaked = _mbedtls.GetSSLContext()->private_state == MBEDTLS_SSL_HANDSHAKE_OVER;
-        _mbedtls.Release();
-        if (handshaked) {
-            ImplementClose();
-        }
+        PluginPort port(this);
+        _layer.Close(port);
     }
 
     void MbedTLSPlugin::IProtocolPluginRelease() {
         delete this;
     }
 
-    bool MbedTLSPlugin::Handshake() {
-        mbedtls_ssl_context *ctx = _mbedtls.GetSSLContext();
-        while (ctx->private_state != MBEDTLS_SSL_HANDSHAKE_OVER) {
-            _error = mbedtls_ssl_handshake_step(ctx);
-            if (_error != 0 && _error != MBEDTLS_ERR_SSL_WANT_READ && _error != MBEDTLS_ERR_SSL_WANT_WRITE) {
-                return false;
-            }
-            if (_error == MBEDTLS_ERR_SSL_WANT_READ) {
-                break;
-            }
-        }
-        WantFlush();
-        return true;
-    }
-
-    void MbedTLSPlugin::WantFlush() {
-        unsigned int l = _bufferOut.UsedSize();
-        while (l > 0) {
-            const unsigned int r = _bufferOut.Read(const_cast<char *>(_buffer.data()), _buffer.capacity());
-            GetImpl()->IProtocolWrite(ProtocolLevel::StreamWithSSL, _buffer.data(), r);
-            l -= r;
-        }
-    }
-
-    void MbedTLSPlugin::ImplementOpen() {
-        GetImpl()->IProtocolOpen(ProtocolLevel::StreamWithSSL);
-    }
-
-    void MbedTLSPlugin::ImplementClose() {
-        GetImpl()->IProtocolClose(ProtocolLevel::StreamWithSSL);
-    }
-
-    void MbedTLSPlugin::ImplementReceive(const char *buf, unsigned int size) {
-        GetImpl()->IProtocolRead(ProtocolLevel::StreamWithSSL, buf, size);
-    }
-
-
-    int MbedTLSPlugin::MbedTLSRecvCallback(void *ctx, unsigned char *buf, size_t size) {
-        auto plugin = static_cast<MbedTLSPlugin *>(ctx);
-        const int r = static_cast<int>(plugin->_bufferIn.Read(reinterpret_cast<char *>(buf), size));
-        if (r > 0) {
-            return r;
-        }
-        return MBEDTLS_ERR_SSL_WANT_READ;
-    }
-
-    int MbedTLSPlugin::MbedTLSSendCallback(void *ctx, const unsigned char *buf, size_t size) {
-        auto plugin = static_cast<MbedTLSPlugin *>(ctx);
-        const int r = static_cast<int>(plugin->_bufferOut.Write(reinterpret_cast<const char *>(buf), size));
-        if (r > 0) {
-            return r;
-        }
-        return MBEDTLS_ERR_SSL_WANT_WRITE;
-    }
-
-    MbedTLSPluginCreator::MbedTLSPluginCreator(): _init(false), _mbedtls(nullptr) {
+    MbedTLSPluginCreator::MbedTLSPluginCreator(): _init(false), _maxVersion(MBEDTLS_SSL_VERSION_UNKNOWN),
+                                                  _mbedtls(nullptr) {
     }
 
     MbedTLSPluginCreator::~MbedTLSPluginCreator() {
@@ -166,6 +57,10 @@ namespace Lcc {
         }
     };
 
+    void MbedTLSPluginCreator::SetMaxVersion(mbedtls_ssl_protocol_version version) {
+        _maxVersion = version;
+    }
+
     bool MbedTLSPluginCreator::InitializeClientMode(const char *host, const char *caroot) {
         if (!host) {
             return false;
@@ -181,7 +76,7 @@ namespace Lcc {
     bool MbedTLSPluginCreator::InitializeServerMode(const char *cert, const char *key, const char *password) {
         if (!_mbedtls) {
             _mbedtls = new Protocol::MbedTLS;
-            if (_mbedtls->InitializeForServer(cert, key, password)) {
+            if (_mbedtls->InitializeForServer(cert, key, password, _maxVersion)) {
                 _init = true;
                 return true;
             }
@@ -208,7 +103,8 @@ namespace Lcc {
             }
             _mbedtls->Release();
         } else {
-            if (plugin->GetMbedTLS().InitializeForClient(_host.c_str(), _caroot.empty() ? nullptr : _caroot.c_str())) {
+            if (plugin->GetMbedTLS().InitializeForClient(_host.c_str(), _caroot.empty() ? nullptr : _caroot.c_str(),
+                                                         _maxVersion)) {
                 return plugin;
             }
         }
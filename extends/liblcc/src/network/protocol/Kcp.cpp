@@ -0,0 +1,439 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <algorithm>
+#include <cstring>
+#include "libuv/uv.h"
+#include "network/protocol/Kcp.h"
+
+namespace Lcc {
+    static constexpr uint32_t kKcpAskSend = 1;
+    static constexpr uint32_t kKcpAskTell = 2;
+    static constexpr uint32_t kKcpRtoDefault = 200;
+    static constexpr uint32_t kKcpRtoMax = 60000;
+    static constexpr uint32_t kKcpProbeInit = 7000;
+    static constexpr uint32_t kKcpProbeLimit = 120000;
+
+    // 序号与时间均按32位回绕比较
+    static inline int32_t _kcp_diff(uint32_t later, uint32_t earlier) {
+        return static_cast<int32_t>(later - earlier);
+    }
+
+    static inline void _kcp_encode16(char *p, uint16_t v) {
+        p[0] = static_cast<char>(v & 0xff);
+        p[1] = static_cast<char>(v >> 8);
+    }
+
+    static inline void _kcp_encode32(char *p, uint32_t v) {
+        p[0] = static_cast<char>(v & 0xff);
+        p[1] = static_cast<char>((v >> 8) & 0xff);
+        p[2] = static_cast<char>((v >> 16) & 0xff);
+        p[3] = static_cast<char>(v >> 24);
+    }
+
+    static inline uint16_t _kcp_decode16(const char *p) {
+        const auto u = reinterpret_cast<const unsigned char *>(p);
+        return static_cast<uint16_t>(u[0] | (u[1] << 8));
+    }
+
+    static inline uint32_t _kcp_decode32(const char *p) {
+        const auto u = reinterpret_cast<const unsigned char *>(p);
+        return static_cast<uint32_t>(u[0]) | (static_cast<uint32_t>(u[1]) << 8) |
+               (static_cast<uint32_t>(u[2]) << 16) | (static_cast<uint32_t>(u[3]) << 24);
+    }
+
+    // C++11下被引用传递(如std::min)的静态常量需要类外定义
+    constexpr unsigned int Kcp::kHeaderSize;
+    constexpr unsigned int Kcp::kMaxFragments;
+
+    KcpOptions::KcpOptions() : mtu(1400),
+                               sendWindow(128),
+                               recvWindow(128),
+                               interval(10),
+                               minRto(30),
+                               fastResend(2),
+                               deadLink(20),
+                               nodelay(true) {
+    }
+
+    Kcp::Kcp(uint32_t conv, KcpImplement *impl) : _conv(conv),
+                                                  _implement(impl),
+                                                  _mss(_options.mtu - kHeaderSize),
+                                                  _sndUna(0),
+                                                  _sndNxt(0),
+                                                  _rcvNxt(0),
+                                                  _rmtWnd(_options.recvWindow),
+                                                  _rxSrtt(0),
+                                                  _rxRttval(0),
+                                                  _rxRto(kKcpRtoDefault),
+                                                  _tsFlush(0),
+                                                  _updated(false),
+                                                  _probe(0),
+                                                  _tsProbe(0),
+                                                  _probeWait(0),
+                                                  _dead(false),
+                                                  _retransmits(0) {
+    }
+
+    Kcp::~Kcp() = default;
+
+    bool Kcp::PeekConv(const char *buf, unsigned int size, uint32_t &conv) {
+        if (!buf || size < kHeaderSize) {
+            return false;
+        }
+        conv = _kcp_decode32(buf);
+        return true;
+    }
+
+    bool Kcp::PeekCommand(const char *buf, unsigned int size, KcpCommand &cmd) {
+        if (!buf || size < kHeaderSize) {
+            return false;
+        }
+        cmd = static_cast<KcpCommand>(buf[4]);
+        return true;
+    }
+
+    void Kcp::SetOptions(const KcpOptions &options) {
+        _options = options;
+        _options.mtu = std::max(_options.mtu, kHeaderSize + 8);
+        _options.sendWindow = std::max(_options.sendWindow, 1U);
+        // 窗口通过16位字段告知对端
+        _options.recvWindow = std::min(std::max(_options.recvWindow, 1U), 0xffffU);
+        _options.interval = std::min(std::max(_options.interval, 1U), 5000U);
+        _options.deadLink = std::max(_options.deadLink, 1U);
+        _mss = _options.mtu - kHeaderSize;
+        _rmtWnd = _options.recvWindow;
+        _buffer.reserve(_options.mtu);
+    }
+
+    uint32_t Kcp::Conv() const {
+        return _conv;
+    }
+
+    int Kcp::Input(const char *buf, unsigned int size, uint32_t current) {
+        if (!buf || size < kHeaderSize) {
+            return UV_EPROTO;
+        }
+        bool acked = false;
+        bool fin = false;
+        uint32_t maxAck = 0;
+        while (size >= kHeaderSize) {
+            const uint32_t conv = _kcp_decode32(buf);
+            const auto cmd = static_cast<unsigned char>(buf[4]);
+            const auto frg = static_cast<unsigned char>(buf[5]);
+            const uint16_t wnd = _kcp_decode16(buf + 6);
+            const uint32_t ts = _kcp_decode32(buf + 8);
+            const uint32_t sn = _kcp_decode32(buf + 12);
+            const uint32_t una = _kcp_decode32(buf + 16);
+            const uint32_t len = _kcp_decode32(buf + 20);
+            buf += kHeaderSize;
+            size -= kHeaderSize;
+            if (conv != _conv || len > size || cmd < static_cast<unsigned char>(KcpCommand::Push) ||
+                cmd > static_cast<unsigned char>(KcpCommand::Fin)) {
+                return UV_EPROTO;
+            }
+            _rmtWnd = wnd;
+            ParseUna(una);
+            switch (static_cast<KcpCommand>(cmd)) {
+                case KcpCommand::Ack:
+                    if (_kcp_diff(current, ts) >= 0) {
+                        UpdateAck(_kcp_diff(current, ts));
+                    }
+                    ParseAck(sn);
+                    if (!acked || _kcp_diff(sn, maxAck) > 0) {
+                        acked = true;
+                        maxAck = sn;
+                    }
+                    break;
+                case KcpCommand::Push:
+                    if (_kcp_diff(sn, _rcvNxt + _options.recvWindow) < 0) {
+                        // 重复的报文段也要确认, 对端的确认可能丢失
+                        _ackList.emplace_back(sn, ts);
+                        if (_kcp_diff(sn, _rcvNxt) >= 0) {
+                            ParseData(Segment{sn, ts, frg, 0, 0, 0, 0, std::string(buf, len)});
+                        }
+                    }
+                    break;
+                case KcpCommand::WindowAsk:
+                    _probe |= kKcpAskTell;
+                    break;
+                case KcpCommand::WindowTell:
+                    break;
+                case KcpCommand::Fin:
+                    fin = true;
+                    break;
+            }
+            buf += len;
+            size -= len;
+        }
+        if (acked) {
+            ParseFastAck(maxAck);
+        }
+        Deliver();
+        return fin ? UV_EOF : 0;
+    }
+
+    bool Kcp::Send(const char *buf, unsigned int size) {
+        if (size > MaxMessageSize()) {
+            return false;
+        }
+        const unsigned int count = size <= _mss ? 1 : (size + _mss - 1) / _mss;
+        unsigned int offset = 0;
+        for (unsigned int n = 0; n < count; ++n) {
+            const unsigned int len = std::min(_mss, size - offset);
+            Segment segment{0, 0, static_cast<unsigned char>(count - n - 1), 0, 0, 0, 0, std::string(buf + offset, len)};
+            _sndQueue.push_back(std::move(segment));
+            offset += len;
+        }
+        return true;
+    }
+
+    void Kcp::Update(uint32_t current) {
+        if (!_updated) {
+            _updated = true;
+            _tsFlush = current;
+        }
+        int32_t slap = _kcp_diff(current, _tsFlush);
+        if (slap >= 10000 || slap < -10000) {
+            _tsFlush = current;
+            slap = 0;
+        }
+        if (slap >= 0) {
+            _tsFlush += _options.interval;
+            if (_kcp_diff(current, _tsFlush) >= 0) {
+                _tsFlush = current + _options.interval;
+            }
+            Flush(current);
+        }
+    }
+
+    void Kcp::Flush(uint32_t current) {
+        for (const auto &ack: _ackList) {
+            Append(KcpCommand::Ack, 0, ack.second, ack.first, 0);
+        }
+        _ackList.clear();
+        // 对端接收窗口为0时按退避间隔探测
+        if (_rmtWnd == 0) {
+            if (_probeWait == 0) {
+                _probeWait = kKcpProbeInit;
+                _tsProbe = current + _probeWait;
+            } else if (_kcp_diff(current, _tsProbe) >= 0) {
+                _probeWait = std::min(_probeWait + _probeWait / 2, kKcpProbeLimit);
+                _tsProbe = current + _probeWait;
+                _probe |= kKcpAskSend;
+            }
+        } else {
+            _tsProbe = 0;
+            _probeWait = 0;
+        }
+        if (_probe & kKcpAskSend) {
+            Append(KcpCommand::WindowAsk, 0, current, 0, 0);
+        }
+        if (_probe & kKcpAskTell) {
+            Append(KcpCommand::WindowTell, 0, current, 0, 0);
+        }
+        _probe = 0;
+
+        const uint32_t window = std::min(_options.sendWindow, _rmtWnd);
+        while (!_sndQueue.empty() && _kcp_diff(_sndNxt, _sndUna + window) < 0) {
+            Segment &segment = _sndQueue.front();
+            segment.sn = _sndNxt++;
+            segment.xmit = 0;
+            segment.fastAck = 0;
+            _sndBuf.push_back(std::move(segment));
+            _sndQueue.pop_front();
+        }
+        const uint32_t resent = _options.fastResend > 0 ? _options.fastResend : 0xffffffffU;
+        const uint32_t rtoMin = _options.nodelay ? 0 : _rxRto >> 3;
+        for (auto &segment: _sndBuf) {
+            bool send = false;
+            if (segment.xmit == 0) {
+                send = true;
+                segment.rto = _rxRto;
+                segment.resendTs = current + segment.rto + rtoMin;
+            } else if (_kcp_diff(current, segment.resendTs) >= 0) {
+                send = true;
+                ++_retransmits;
+                segment.rto += _options.nodelay ? segment.rto / 2 : std::max(segment.rto, _rxRto);
+                segment.rto = std::min(segment.rto, kKcpRtoMax);
+                segment.resendTs = current + segment.rto;
+            } else if (segment.fastAck >= resent) {
+                send = true;
+                ++_retransmits;
+                segment.fastAck = 0;
+                segment.resendTs = current + segment.rto;
+            }
+            if (send) {
+                ++segment.xmit;
+                segment.ts = current;
+                const auto len = static_cast<unsigned int>(segment.data.size());
+                char *data = Append(KcpCommand::Push, segment.frg, current, segment.sn, len);
+                if (len > 0) {
+                    memcpy(data, segment.data.data(), len);
+                }
+                if (segment.xmit >= _options.deadLink) {
+                    _dead = true;
+                }
+            }
+        }
+        Output();
+    }
+
+    void Kcp::AskWindow() {
+        _probe |= kKcpAskSend;
+    }
+
+    void Kcp::SendFin(uint32_t current) {
+        Append(KcpCommand::Fin, 0, current, 0, 0);
+        Output();
+    }
+
+    size_t Kcp::WaitSend() const {
+        return _sndQueue.size() + _sndBuf.size();
+    }
+
+    unsigned int Kcp::MaxMessageSize() const {
+        // 整条消息的分片需同时放进对端的接收队列, 两端参数需一致
+        return _mss * std::min(kMaxFragments, _options.recvWindow);
+    }
+
+    bool Kcp::IsDead() const {
+        return _dead;
+    }
+
+    uint32_t Kcp::Rto() const {
+        return _rxRto;
+    }
+
+    uint64_t Kcp::Retransmits() const {
+        return _retransmits;
+    }
+
+    void Kcp::UpdateAck(int32_t rtt) {
+        if (_rxSrtt == 0) {
+            _rxSrtt = rtt;
+            _rxRttval = rtt / 2;
+        } else {
+            const int32_t delta = rtt > _rxSrtt ? rtt - _rxSrtt : _rxSrtt - rtt;
+            _rxRttval = (3 * _rxRttval + delta) / 4;
+            _rxSrtt = std::max((7 * _rxSrtt + rtt) / 8, 1);
+        }
+        const uint32_t rto = static_cast<uint32_t>(_rxSrtt) +
+                             std::max(_options.interval, static_cast<uint32_t>(4 * _rxRttval));
+        _rxRto = std::min(std::max(rto, _options.minRto), kKcpRtoMax);
+    }
+
+    void Kcp::ParseUna(uint32_t una) {
+        while (!_sndBuf.empty() && _kcp_diff(una, _sndBuf.front().sn) > 0) {
+            _sndBuf.pop_front();
+        }
+        _sndUna = _sndBuf.empty() ? _sndNxt : _sndBuf.front().sn;
+    }
+
+    void Kcp::ParseAck(uint32_t sn) {
+        if (_kcp_diff(sn, _sndUna) < 0 || _kcp_diff(sn, _sndNxt) >= 0) {
+            return;
+        }
+        for (auto it = _sndBuf.begin(); it != _sndBuf.end(); ++it) {
+            if (it->sn == sn) {
+                _sndBuf.erase(it);
+                break;
+            }
+            if (_kcp_diff(sn, it->sn) < 0) {
+                break;
+            }
+        }
+        _sndUna = _sndBuf.empty() ? _sndNxt : _sndBuf.front().sn;
+    }
+
+    void Kcp::ParseFastAck(uint32_t sn) {
+        if (_kcp_diff(sn, _sndUna) < 0 || _kcp_diff(sn, _sndNxt) >= 0) {
+            return;
+        }
+        for (auto &segment: _sndBuf) {
+            if (_kcp_diff(sn, segment.sn) < 0) {
+                break;
+            }
+            if (sn != segment.sn) {
+                ++segment.fastAck;
+            }
+        }
+    }
+
+    void Kcp::ParseData(Segment &&segment) {
+        // 多数报文段按序到达, 从尾部向前找插入位置
+        auto it = _rcvBuf.end();
+        while (it != _rcvBuf.begin()) {
+            auto prev = it - 1;
+            if (prev->sn == segment.sn) {
+                return;
+            }
+            if (_kcp_diff(segment.sn, prev->sn) > 0) {
+                break;
+            }
+            it = prev;
+        }
+        _rcvBuf.insert(it, std::move(segment));
+    }
+
+    void Kcp::Deliver() {
+        for (;;) {
+            while (!_rcvBuf.empty() && _rcvBuf.front().sn == _rcvNxt && _rcvQueue.size() < _options.recvWindow) {
+                _rcvQueue.push_back(std::move(_rcvBuf.front()));
+                _rcvBuf.pop_front();
+                ++_rcvNxt;
+            }
+            size_t count = 0;
+            bool complete = false;
+            for (const auto &segment: _rcvQueue) {
+                ++count;
+                if (segment.frg == 0) {
+                    complete = true;
+                    break;
+                }
+            }
+            if (!complete) {
+                return;
+            }
+            if (_rcvQueue.size() >= _options.recvWindow) {
+                // 接收窗口从满恢复, 主动告知对端
+                _probe |= kKcpAskTell;
+            }
+            _message.clear();
+            for (size_t n = 0; n < count; ++n) {
+                _message.append(_rcvQueue.front().data);
+                _rcvQueue.pop_front();
+            }
+            _implement->IKcpReceive(_message.data(), static_cast<unsigned int>(_message.size()));
+        }
+    }
+
+    char *Kcp::Append(KcpCommand cmd, unsigned char frg, uint32_t ts, uint32_t sn, unsigned int len) {
+        if (_buffer.size() + kHeaderSize + len > _options.mtu) {
+            Output();
+        }
+        const size_t offset = _buffer.size();
+        _buffer.resize(offset + kHeaderSize + len);
+        char *p = &_buffer[offset];
+        _kcp_encode32(p, _conv);
+        p[4] = static_cast<char>(cmd);
+        p[5] = static_cast<char>(frg);
+        _kcp_encode16(p + 6, static_cast<uint16_t>(WindowUnused()));
+        _kcp_encode32(p + 8, ts);
+        _kcp_encode32(p + 12, sn);
+        _kcp_encode32(p + 16, _rcvNxt);
+        _kcp_encode32(p + 20, len);
+        return p + kHeaderSize;
+    }
+
+    void Kcp::Output() {
+        if (!_buffer.empty()) {
+            _implement->IKcpOutput(_buffer.data(), static_cast<unsigned int>(_buffer.size()));
+            _buffer.clear();
+        }
+    }
+
+    unsigned int Kcp::WindowUnused() const {
+        return _rcvQueue.size() < _options.recvWindow ? _options.recvWindow - static_cast<unsigned int>(_rcvQueue.size()) : 0;
+    }
+}
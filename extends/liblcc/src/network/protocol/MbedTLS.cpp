@@ -5,6 +5,15 @@
 
 namespace Lcc {
     namespace Protocol {
+        /**
+         * PSA加密库是进程级的全局状态(TLS1.3的密钥交换与记录加密都依赖它), 只初始化一次且不随单个连接释放,
+         * 否则任一连接关闭都会清掉其他正在握手的连接的密钥
+         */
+        static void CryptoInit() {
+            static const psa_status_t status = psa_crypto_init();
+            (void) status;
+        }
+
         MbedTLS::MbedTLS() : _error(0), _mode(Mode::None), _caroot(false) {
             _errorstr.resize(512);
         }
@@ -32,7 +41,6 @@ namespace Lcc {
                     }
                     default: break;
                 }
-                mbedtls_psa_crypto_free();
                 _mode = Mode::None;
             }
         }
@@ -87,11 +95,11 @@ namespace Lcc {
             return false;
         }
 
-        bool MbedTLS::InitializeForClient(const char *host, const char *caroot) {
+        bool MbedTLS::InitializeForClient(const char *host, const char *caroot, mbedtls_ssl_protocol_version maxVersion) {
             if (!Enabled() && host) {
                 do {
                     _errorstr.clear();
-                    psa_crypto_init();
+                    CryptoInit();
                     mbedtls_pk_init(&_pkCtx);
                     mbedtls_ssl_init(&_sslCtx);
                     mbedtls_x509_crt_init(&_x509Crt);
@@ -107,6 +115,9 @@ namespace Lcc {
                     if (_error != 0) {
                         break;
                     }
+                    if (maxVersion != MBEDTLS_SSL_VERSION_UNKNOWN) {
+                        mbedtls_ssl_conf_max_tls_version(&_sslCfg, maxVersion);
+                    }
                     if (caroot) {
                         _error = mbedtls_x509_crt_parse_file(&_x509Crt, caroot);
                         if (_error != 0) {
@@ -135,10 +146,12 @@ namespace Lcc {
             return false;
         }
 
-        bool MbedTLS::InitializeForServer(const char *cert, const char *key, const char *password) {
+        bool MbedTLS::InitializeForServer(const char *cert, const char *key, const char *password,
+                                          mbedtls_ssl_protocol_version maxVersion) {
             if (!Enabled() && cert && key && password) {
                 do {
                     _errorstr.clear();
+                    CryptoInit();
                     mbedtls_pk_init(&_pkCtx);
                     mbedtls_ssl_init(&_sslCtx);
                     mbedtls_x509_crt_init(&_x509Crt);
@@ -162,6 +175,9 @@ namespace Lcc {
                     if (_error != 0) {
                         break;
                     }
+                    if (maxVersion != MBEDTLS_SSL_VERSION_UNKNOWN) {
+                        mbedtls_ssl_conf_max_tls_version(&_sslCfg, maxVersion);
+                    }
                     mbedtls_ssl_conf_rng(&_sslCfg, mbedtls_ctr_drbg_random, &_ctrDrbgCtx);
                     mbedtls_ssl_conf_ca_chain(&_sslCfg, _x509Crt.next, nullptr);
                     _error = mbedtls_ssl_conf_own_cert(&_sslCfg, &_x509Crt, &_pkCtx);
@@ -6,10 +6,9 @@
 #include <sstream>
 #include "mbedtls/sha1.h"
 #include "mbedtls/base64.h"
+#include "utils/Strings.h"
 #include "network/protocol/WebSocket.h"
 
-#include <utils/Address.h>
-
 namespace Lcc {
     WebSocketProtocol::WebSocketProtocol(WebSocketImplement *impl) : _mode({
                                                                          .mark = false, .opcode = WebSocketOpcode::Text
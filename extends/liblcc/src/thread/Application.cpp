@@ -1,24 +1,39 @@
 //
 // Created by liao on 2024/5/24.
 //
-#include "uv.h"
 #include "thread/Application.h"
 
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/timerfd.h>
+#endif
+
 namespace Lcc {
-    Application::Application(): _running(false) {
+    static const unsigned long long kNanoPerSecond = 1000000000ULL;
+    static const unsigned int kMaxTickRate = 1000;
+
+    Application::Application(): _running(false), _tick(false), _loopInit(false), _timerFd(-1), _period(0), _base(0),
+                                _index(0), _nextTick(0), _loop(), _timer(), _poll() {
     }
 
-    Application::~Application() = default;
+    Application::~Application() {
+        EventLoopClose();
+    }
 
     void Application::Run() {
         if (!_running) {
             if (IInit()) {
                 _running = true;
-                while (_running) {
-                    IRun();
+                if (_tick) {
+                    TickRun();
+                } else {
+                    while (_running) {
+                        IRun();
+                    }
                 }
             }
             IShutdown();
+            EventLoopClose();
         }
     }
 
@@ -29,4 +44,223 @@ namespace Lcc {
     void Application::Sleep(unsigned int ms) {
         uv_sleep(ms);
     }
+
+    bool Application::EnableTick(const TickOptions &options) {
+        if (_running || options.hz == 0 || options.hz > kMaxTickRate || options.maxCatchUp == 0) {
+            return false;
+        }
+        _options = options;
+        _period = kNanoPerSecond / options.hz;
+        if (_options.lateThreshold == 0) {
+            _options.lateThreshold = _period / 4;
+        }
+        static const unsigned int percent[static_cast<int>(TickPhase::Count)] = {20, 50, 20};
+        for (int n = 0; n < static_cast<int>(TickPhase::Count); ++n) {
+            if (_options.budgets[n] == 0) {
+                _options.budgets[n] = _period * percent[n] / 100;
+            }
+        }
+        _tick = true;
+        return true;
+    }
+
+    const TickStats &Application::GetTickStats() const {
+        return _stats;
+    }
+
+    void Application::ResetTickStats() {
+        _stats = TickStats();
+    }
+
+    uv_loop_t *Application::GetEventLoop() {
+        if (!_loopInit) {
+            if (uv_loop_init(&_loop) != 0) {
+                return nullptr;
+            }
+            uv_loop_set_data(&_loop, this);
+            _loopInit = true;
+        }
+        return &_loop;
+    }
+
+    void Application::TickRun() {
+        uv_loop_t *loop = GetEventLoop();
+        if (!loop) {
+            return;
+        }
+        uv_timer_init(loop, &_timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_timer), this);
+#ifdef __linux__
+        // timerfd按绝对时间纳秒级唤醒, uv_timer只有毫秒精度, 仅作为退化方案
+        _timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (_timerFd >= 0) {
+            if (uv_poll_init(loop, &_poll, _timerFd) == 0) {
+                uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_poll), this);
+                uv_poll_start(&_poll, UV_READABLE, Application::UvTickPollCallback);
+            } else {
+                close(_timerFd);
+                _timerFd = -1;
+            }
+        }
+#endif
+        // 固定步长模式下主线程始终停在uv_run内, 可以纳入卡顿检测
+        _loopMetrics.Attach(loop, "main");
+        _base = uv_hrtime();
+        _index = 0;
+        _nextTick = 0;
+        TickArm(TickDeadline(_index));
+        uv_run(loop, UV_RUN_DEFAULT);
+    }
+
+    void Application::TickFrame() {
+        if (!_running) {
+            uv_timer_stop(&_timer);
+            if (_timerFd >= 0) {
+                uv_poll_stop(&_poll);
+            }
+            uv_stop(&_loop);
+            return;
+        }
+        const unsigned long long now = uv_hrtime();
+        const unsigned long long deadline = TickDeadline(_index);
+        if (now < deadline) {
+            // 退化定时器提前唤醒
+            TickArm(deadline);
+            return;
+        }
+        const unsigned long long lateness = now - deadline;
+        // 截至当前时间应执行到的步数: 计划时间向上取整、步数向下取整, 到达计划时间时至少为1步
+        unsigned long long steps = TickStepsAt(now - _base, _options.hz) + 1 - _index;
+        bool realign = false;
+        if (steps > _options.maxCatchUp) {
+            _stats.droppedTicks += steps - _options.maxCatchUp;
+            steps = _options.maxCatchUp;
+            realign = true;
+        }
+
+        TickContext context{_nextTick, 0, 1.0 / _options.hz, now};
+        unsigned long long begin = now;
+        unsigned long long end = 0;
+        const int input = static_cast<int>(TickPhase::Input);
+        const int simulate = static_cast<int>(TickPhase::Simulate);
+        const int broadcast = static_cast<int>(TickPhase::Broadcast);
+
+        ITickInput(context);
+        end = uv_hrtime();
+        _stats.phases[input].Record(end - begin);
+        if (end - begin > _options.budgets[input]) {
+            ++_stats.overBudget[input];
+        }
+        for (unsigned int step = 0; step < steps; ++step) {
+            begin = end;
+            context.tick = _nextTick++;
+            ++_stats.ticks;
+            context.step = step;
+            ITickSimulate(context);
+            end = uv_hrtime();
+            _stats.phases[simulate].Record(end - begin);
+            if (end - begin > _options.budgets[simulate]) {
+                ++_stats.overBudget[simulate];
+            }
+        }
+        begin = end;
+        ITickBroadcast(context);
+        end = uv_hrtime();
+        _stats.phases[broadcast].Record(end - begin);
+        if (end - begin > _options.budgets[broadcast]) {
+            ++_stats.overBudget[broadcast];
+        }
+
+        const unsigned long long cost = end - now;
+        ++_stats.frames;
+        _stats.frame.Record(cost);
+        _stats.lateness.Record(lateness);
+        if (lateness > _options.lateThreshold || cost > _period) {
+            ++_stats.lateFrames;
+            ITickLate(lateness, cost);
+        }
+        if (realign) {
+            // 丢弃积压的步数, 从本帧开始重新计算时间轴
+            _base = now;
+            _index = 1;
+        } else {
+            _index += steps;
+        }
+        TickArm(TickDeadline(_index));
+    }
+
+    void Application::TickArm(unsigned long long deadline) {
+#ifdef __linux__
+        if (_timerFd >= 0) {
+            struct itimerspec spec{};
+            spec.it_value.tv_sec = static_cast<time_t>(deadline / kNanoPerSecond);
+            spec.it_value.tv_nsec = static_cast<long>(deadline % kNanoPerSecond);
+            if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+                spec.it_value.tv_nsec = 1;
+            }
+            if (timerfd_settime(_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0) {
+                return;
+            }
+        }
+#endif
+        const unsigned long long now = uv_hrtime();
+        // 向上取整到毫秒, 宁可晚到也不空转
+        const unsigned long long timeout = deadline > now ? (deadline - now + 999999) / 1000000 : 0;
+        uv_update_time(&_loop);
+        uv_timer_start(&_timer, Application::UvTickTimerCallback, timeout, 0);
+    }
+
+    unsigned long long Application::TickDeadline(unsigned long long index) const {
+        // 按序号直接计算, 避免周期取整误差逐帧累积
+        // 向上取整保证now >= 计划时间时TickStepsAt(now - base) >= index, 执行后的下一计划时间必定晚于now
+        return _base + TickOffset(index, _options.hz);
+    }
+
+    unsigned long long Application::TickStepsAt(unsigned long long elapsed, unsigned int hz) {
+        // 整秒部分精确, 余数不足1秒, 与hz的乘积不超过1e12
+        return elapsed / kNanoPerSecond * hz + elapsed % kNanoPerSecond * hz / kNanoPerSecond;
+    }
+
+    unsigned long long Application::TickOffset(unsigned long long index, unsigned int hz) {
+        // 每hz步恰好1秒, 余下不足hz步的部分与1e9的乘积不超过1e12
+        return index / hz * kNanoPerSecond + (index % hz * kNanoPerSecond + hz - 1) / hz;
+    }
+
+    void Application::EventLoopClose() {
+        if (!_loopInit) {
+            return;
+        }
+        _loopMetrics.Detach();
+        // 关闭应用遗留的句柄(包括定时器), 排空关闭回调后再释放loop
+        uv_walk(&_loop, [](uv_handle_t *handle, void *arg) {
+            if (!uv_is_closing(handle)) {
+                uv_close(handle, nullptr);
+            }
+        }, nullptr);
+        uv_run(&_loop, UV_RUN_DEFAULT);
+#ifdef __linux__
+        if (_timerFd >= 0) {
+            close(_timerFd);
+            _timerFd = -1;
+        }
+#endif
+        uv_loop_close(&_loop);
+        _loopInit = false;
+    }
+
+    void Application::UvTickTimerCallback(uv_timer_t *handle) {
+        auto self = static_cast<Application *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+        self->TickFrame();
+    }
+
+    void Application::UvTickPollCallback(uv_poll_t *handle, int status, int events) {
+        auto self = static_cast<Application *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(handle)));
+#ifdef __linux__
+        unsigned long long expirations = 0;
+        if (read(self->_timerFd, &expirations, sizeof(expirations)) < 0) {
+            return;
+        }
+#endif
+        self->TickFrame();
+    }
 }
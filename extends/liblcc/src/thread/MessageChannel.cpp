@@ -0,0 +1,91 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdlib>
+#include "thread/MessageChannel.h"
+
+namespace Lcc {
+    ChannelBase::ChannelBase(): _open(false), _notified(false), _wakeups(0), _signals(0), _async(nullptr) {
+    }
+
+    ChannelBase::~ChannelBase() {
+        if (_async) {
+            // 句柄仍在循环中, 解除与通道的关联, 由关闭回调负责释放
+            uv_handle_set_data(reinterpret_cast<uv_handle_t *>(_async), nullptr);
+        }
+    }
+
+    bool ChannelBase::Open(uv_loop_t *loop) {
+        if (_async || !loop) {
+            return false;
+        }
+        _async = static_cast<uv_async_t *>(::malloc(sizeof(uv_async_t)));
+        if (uv_async_init(loop, _async, ChannelBase::UvChannelTrigger) != 0) {
+            ::free(_async);
+            _async = nullptr;
+            return false;
+        }
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(_async), this);
+        _notified = false;
+        _open = true;
+        return true;
+    }
+
+    void ChannelBase::Close() {
+        if (_async && _open) {
+            _open = false;
+            uv_close(reinterpret_cast<uv_handle_t *>(_async), ChannelBase::UvChannelClose);
+            IChannelDiscard();
+        }
+    }
+
+    bool ChannelBase::Active() const {
+        return _open;
+    }
+
+    unsigned long long ChannelBase::Wakeups() const {
+        return _wakeups.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long ChannelBase::Signals() const {
+        return _signals.load(std::memory_order_relaxed);
+    }
+
+    void ChannelBase::Notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!_notified.exchange(true)) {
+            _signals.fetch_add(1, std::memory_order_relaxed);
+            uv_async_send(_async);
+        }
+    }
+
+    void ChannelBase::UvChannelTrigger(uv_async_t *async) {
+        auto self = static_cast<ChannelBase *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(async)));
+        if (!self || !self->_open) {
+            return;
+        }
+        self->_wakeups.fetch_add(1, std::memory_order_relaxed);
+        // 派发期间_notified保持为true, 生产端不会重复唤醒
+        if (self->IChannelDrain()) {
+            // 达到单次上限, 保持_notified并重新唤醒自身, 先让事件循环处理其他句柄
+            if (self->_open) {
+                uv_async_send(self->_async);
+            }
+            return;
+        }
+        self->_notified.store(false);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // 派发结束到清除标记之间入队的消息不会触发唤醒, 再确认一次队列
+        if (self->_open && self->IChannelPending() && !self->_notified.exchange(true)) {
+            uv_async_send(self->_async);
+        }
+    }
+
+    void ChannelBase::UvChannelClose(uv_handle_t *handle) {
+        auto self = static_cast<ChannelBase *>(uv_handle_get_data(handle));
+        if (self) {
+            self->_async = nullptr;
+        }
+        ::free(handle);
+    }
+}
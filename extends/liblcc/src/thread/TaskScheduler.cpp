@@ -0,0 +1,377 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <thread>
+#include "thread/TaskScheduler.h"
+
+namespace Lcc {
+    // 当前线程所在的工作线程
+    static thread_local TaskWorker *t_currentWorker = nullptr;
+
+    Task::Task(): _group(nullptr) {
+    }
+
+    Task::~Task() = default;
+
+    void Task::ITaskRelease() {
+    }
+
+    TaskGroup::TaskGroup(): _done(false), _added(false), _continuation(nullptr), _pending(0) {
+        uv_mutex_init(&_mutex);
+        uv_cond_init(&_cond);
+    }
+
+    TaskGroup::~TaskGroup() {
+        uv_cond_destroy(&_cond);
+        uv_mutex_destroy(&_mutex);
+    }
+
+    void TaskGroup::Then(Task *task) {
+        _continuation = task;
+    }
+
+    int TaskGroup::Pending() const {
+        return _pending.load(std::memory_order_acquire);
+    }
+
+    void TaskGroup::Wait(TaskScheduler *scheduler) {
+        if (!_added.load(std::memory_order_acquire)) {
+            return;
+        }
+        TaskWorker *worker = scheduler ? scheduler->CurrentWorker() : nullptr;
+        if (worker) {
+            // 工作线程内等待时继续执行任务, 避免占用线程空等
+            while (Pending() > 0) {
+                Task *task = worker->FindTask();
+                if (task) {
+                    scheduler->Execute(worker, task);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        // 计数归零后Done仍会访问本对象, 需等待其完成通知
+        uv_mutex_lock(&_mutex);
+        while (!_done) {
+            uv_cond_wait(&_cond, &_mutex);
+        }
+        uv_mutex_unlock(&_mutex);
+    }
+
+    void TaskGroup::Add() {
+        _added.store(true, std::memory_order_relaxed);
+        _pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TaskGroup::Done(TaskScheduler *scheduler) {
+        if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (_continuation) {
+                scheduler->Spawn(_continuation);
+            }
+            uv_mutex_lock(&_mutex);
+            _done = true;
+            uv_cond_broadcast(&_cond);
+            uv_mutex_unlock(&_mutex);
+        }
+    }
+
+    TaskDeque::TaskDeque(): _top(0), _pad0(), _bottom(0), _array(AllocArray(64)) {
+    }
+
+    TaskDeque::~TaskDeque() {
+        Array *array = _array.load(std::memory_order_relaxed);
+        delete[] array->buffer;
+        delete array;
+        for (auto garbage: _garbage) {
+            delete[] garbage->buffer;
+            delete garbage;
+        }
+    }
+
+    void TaskDeque::Push(Task *task) {
+        const long long b = _bottom.load(std::memory_order_relaxed);
+        const long long t = _top.load(std::memory_order_acquire);
+        Array *array = _array.load(std::memory_order_relaxed);
+        if (b - t > array->size - 1) {
+            array = Grow(array, b, t);
+        }
+        array->buffer[b & (array->size - 1)].store(task, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    Task *TaskDeque::Pop() {
+        const long long b = _bottom.load(std::memory_order_relaxed) - 1;
+        Array *array = _array.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = _top.load(std::memory_order_relaxed);
+        Task *task = nullptr;
+        if (t <= b) {
+            task = array->buffer[b & (array->size - 1)].load(std::memory_order_relaxed);
+            if (t == b) {
+                // 最后一个元素, 与窃取者竞争
+                if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    task = nullptr;
+                }
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    Task *TaskDeque::Steal() {
+        long long t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const long long b = _bottom.load(std::memory_order_acquire);
+        if (t < b) {
+            Array *array = _array.load(std::memory_order_acquire);
+            Task *task = array->buffer[t & (array->size - 1)].load(std::memory_order_relaxed);
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return task;
+        }
+        return nullptr;
+    }
+
+    long long TaskDeque::Size() const {
+        const long long b = _bottom.load(std::memory_order_relaxed);
+        const long long t = _top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    TaskDeque::Array *TaskDeque::Grow(Array *array, long long bottom, long long top) {
+        Array *grown = AllocArray(array->size * 2);
+        for (long long i = top; i < bottom; ++i) {
+            grown->buffer[i & (grown->size - 1)].store(array->buffer[i & (array->size - 1)].load(
+                std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        _garbage.emplace_back(array);
+        _array.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+    TaskDeque::Array *TaskDeque::AllocArray(long long size) {
+        auto array = new Array;
+        array->size = size;
+        array->buffer = new std::atomic<Task *>[size];
+        return array;
+    }
+
+    TaskWorker::TaskWorker(TaskScheduler *scheduler, unsigned int index): _sleeping(false),
+                                                                          _index(index),
+                                                                          _victim(index),
+                                                                          _idle(),
+                                                                          _scheduler(scheduler),
+                                                                          _executed(0),
+                                                                          _stolen(0) {
+    }
+
+    TaskWorker::~TaskWorker() = default;
+
+    unsigned int TaskWorker::Index() const {
+        return _index;
+    }
+
+    uv_loop_t *TaskWorker::Loop() {
+        return GetEventLoop();
+    }
+
+    unsigned long long TaskWorker::Executed() const {
+        return _executed.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long TaskWorker::Stolen() const {
+        return _stolen.load(std::memory_order_relaxed);
+    }
+
+    Task *TaskWorker::FindTask() {
+        Task *task = _deque.Pop();
+        if (task) {
+            return task;
+        }
+        const unsigned int count = _scheduler->WorkerCount();
+        for (unsigned int n = 1; n < count; ++n) {
+            _victim = (_victim + 1) % count;
+            if (_victim == _index) {
+                continue;
+            }
+            task = _scheduler->GetWorker(_victim)->_deque.Steal();
+            if (task) {
+                _stolen.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void TaskWorker::Activate() {
+        if (_sleeping.exchange(false)) {
+            _scheduler->_sleeping.fetch_sub(1);
+        }
+        uv_idle_start(&_idle, TaskWorker::UvWorkerIdle);
+    }
+
+    bool TaskWorker::IInit() {
+        t_currentWorker = this;
+        uv_idle_init(GetEventLoop(), &_idle);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_idle), this);
+        return true;
+    }
+
+    void TaskWorker::IMessage(void *message) {
+        if (message) {
+            _deque.Push(static_cast<Task *>(message));
+            if (_deque.Size() > 1) {
+                _scheduler->WakeOne(this);
+            }
+        }
+        Activate();
+    }
+
+    void TaskWorker::IShutdown() {
+        // 消息队列中尚未投递的任务先压入本地队列, 与未执行的任务一并释放
+        EventLoopQueueCommand();
+        uv_close(reinterpret_cast<uv_handle_t *>(&_idle), nullptr);
+        Task *task;
+        while ((task = _deque.Pop())) {
+            // 未执行的任务同样计入任务组完成, 避免Wait永久阻塞
+            TaskGroup *group = task->_group;
+            task->ITaskRelease();
+            if (group) {
+                group->Done(_scheduler);
+            }
+        }
+        t_currentWorker = nullptr;
+    }
+
+    void TaskWorker::UvWorkerIdle(uv_idle_t *idle) {
+        static constexpr int kBatch = 64;
+        auto self = static_cast<TaskWorker *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(idle)));
+        // 每轮最多执行一批任务后返回事件循环, 保证I/O回调得到处理
+        for (int n = 0; n < kBatch; ++n) {
+            Task *task = self->FindTask();
+            if (!task) {
+                uv_idle_stop(idle);
+                self->_sleeping.store(true);
+                self->_scheduler->_sleeping.fetch_add(1);
+                return;
+            }
+            self->_scheduler->Execute(self, task);
+        }
+    }
+
+    TaskScheduler::TaskScheduler(): _sleeping(0), _next(0) {
+    }
+
+    TaskScheduler::~TaskScheduler() {
+        Shutdown();
+    }
+
+    bool TaskScheduler::Startup(unsigned int workers) {
+        if (workers == 0) {
+            workers = uv_available_parallelism();
+        }
+        std::vector<ThreadOptions> options(workers);
+        for (unsigned int n = 0; n < workers; ++n) {
+            options[n].name = "lcc-task-" + std::to_string(n);
+        }
+        return Startup(options);
+    }
+
+    bool TaskScheduler::Startup(const std::vector<ThreadOptions> &options) {
+        if (!_workers.empty() || options.empty()) {
+            return false;
+        }
+        for (unsigned int n = 0; n < options.size(); ++n) {
+            _workers.emplace_back(new TaskWorker(this, n));
+        }
+        for (unsigned int n = 0; n < options.size(); ++n) {
+            if (!_workers[n]->Startup(options[n])) {
+                Shutdown();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TaskScheduler::Shutdown() {
+        for (auto worker: _workers) {
+            worker->Shutdown();
+        }
+        for (auto worker: _workers) {
+            delete worker;
+        }
+        _workers.clear();
+        _sleeping = 0;
+    }
+
+    unsigned int TaskScheduler::WorkerCount() const {
+        return static_cast<unsigned int>(_workers.size());
+    }
+
+    TaskWorker *TaskScheduler::GetWorker(unsigned int index) const {
+        return index < _workers.size() ? _workers[index] : nullptr;
+    }
+
+    TaskWorker *TaskScheduler::CurrentWorker() const {
+        if (t_currentWorker && t_currentWorker->_scheduler == this) {
+            return t_currentWorker;
+        }
+        return nullptr;
+    }
+
+    bool TaskScheduler::Spawn(Task *task, TaskGroup *group) {
+        if (!task || _workers.empty()) {
+            return false;
+        }
+        task->_group = group;
+        if (group) {
+            group->Add();
+        }
+        TaskWorker *worker = CurrentWorker();
+        if (worker) {
+            worker->_deque.Push(task);
+            WakeOne(worker);
+            return true;
+        }
+        const unsigned int index = _next.fetch_add(1, std::memory_order_relaxed) % WorkerCount();
+        if (_workers[index]->QueueMessage(task)) {
+            return true;
+        }
+        task->_group = nullptr;
+        task->ITaskRelease();
+        if (group) {
+            group->Done(this);
+        }
+        return false;
+    }
+
+    void TaskScheduler::Execute(TaskWorker *worker, Task *task) {
+        TaskGroup *group = task->_group;
+        task->ITaskExecute(worker);
+        task->ITaskRelease();
+        worker->_executed.fetch_add(1, std::memory_order_relaxed);
+        if (group) {
+            group->Done(this);
+        }
+    }
+
+    void TaskScheduler::WakeOne(TaskWorker *self) {
+        if (_sleeping.load(std::memory_order_relaxed) <= 0) {
+            return;
+        }
+        const unsigned int count = WorkerCount();
+        for (unsigned int n = 1; n < count; ++n) {
+            TaskWorker *worker = _workers[(self->_index + n) % count];
+            if (worker->_sleeping.exchange(false)) {
+                _sleeping.fetch_sub(1);
+                worker->QueueMessage(nullptr);
+                return;
+            }
+        }
+    }
+}
@@ -3,18 +3,44 @@
 //
 #include "thread/Thread.h"
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
 namespace Lcc {
-    Thread::Thread(): _status(Status::Shutdown) {
+    // 未命名线程的循环指标按启动顺序编号
+    static std::atomic<unsigned int> _loopSequence(0);
+
+    Thread::Thread(): _error(0), _status(Status::Shutdown), _wakeups(0) {
     }
 
     Thread::~Thread() {
     }
 
     bool Thread::Startup() {
+        return Startup(ThreadOptions());
+    }
+
+    bool Thread::Startup(const ThreadOptions &options) {
         if (_status == Status::Shutdown) {
+            _options = options;
+            uv_thread_options_t params{};
+            params.flags = UV_THREAD_NO_FLAGS;
+            if (_options.stackSize > 0) {
+                params.flags |= UV_THREAD_HAS_STACK_SIZE;
+                params.stack_size = _options.stackSize;
+            }
             uv_barrier_init(&_waitSignal, 2);
-            _error = uv_thread_create(&_thread, Thread::UvThreadRunMain, this);
-            uv_barrier_wait(&_waitSignal);
+            _error = uv_thread_create_ex(&_thread, &params, Thread::UvThreadRunMain, this);
+            if (_error == 0) {
+                uv_barrier_wait(&_waitSignal);
+                if (_status != Status::Running) {
+                    // 初始化失败, 线程事件循环已自行退出
+                    uv_thread_join(&_thread);
+                }
+            }
             uv_barrier_destroy(&_waitSignal);
         }
         return _status == Status::Running;
@@ -32,6 +58,14 @@ namespace Lcc {
         return _status == Status::Running;
     }
 
+    int Thread::LastErrCode() const {
+        return _error;
+    }
+
+    const ThreadOptions &Thread::GetOptions() const {
+        return _options;
+    }
+
     bool Thread::QueueMessage(void *message) {
         if (Running()) {
             _messages.enqueue(message);
@@ -41,16 +75,81 @@ namespace Lcc {
         return false;
     }
 
+    unsigned long long Thread::Wakeups() const {
+        return _wakeups.load(std::memory_order_relaxed);
+    }
+
+    const std::string &Thread::GetLoopName() const {
+        return _loopMetrics.GetName();
+    }
+
+    bool Thread::OpenChannel(ChannelBase *channel) {
+        if (channel && channel->Open(&_threadLoop)) {
+            _channels.emplace_back(channel);
+            return true;
+        }
+        return false;
+    }
+
+    void Thread::ApplyOptions() {
+#if defined(__linux__)
+        if (!_options.name.empty()) {
+            // 内核限制线程名最长15个字符
+            pthread_setname_np(pthread_self(), _options.name.substr(0, 15).c_str());
+        }
+        std::vector<int> cpus = _options.cpus;
+        if (cpus.empty() && _options.numaNode >= 0) {
+            CpuTopology::ReadNodeCpus(_options.numaNode, cpus);
+        }
+        if (!cpus.empty()) {
+            const int size = uv_cpumask_size();
+            if (size > 0) {
+                std::vector<char> mask(size, 0);
+                for (const int cpu: cpus) {
+                    if (cpu >= 0 && cpu < size) {
+                        mask[cpu] = 1;
+                    }
+                }
+                uv_thread_t self = uv_thread_self();
+                const int err = uv_thread_setaffinity(&self, mask.data(), nullptr, mask.size());
+                if (err != 0) {
+                    _error = err;
+                }
+            }
+        }
+#if defined(SYS_set_mempolicy)
+        if (_options.numaNode >= 0 && _options.numaNode < static_cast<int>(sizeof(unsigned long) * 8)) {
+            // MPOL_PREFERRED: 本线程首次访问的内存(事件循环、缓冲区池等)优先分配在指定节点
+            unsigned long nodemask = 1UL << _options.numaNode;
+            ::syscall(SYS_set_mempolicy, 1 /* MPOL_PREFERRED */, &nodemask, sizeof(nodemask) * 8 + 1);
+        }
+#endif
+#endif
+    }
+
     void Thread::EventLoopInit() {
         uv_loop_init(&_threadLoop);
         uv_async_init(&_threadLoop, &_eventTrigger, Thread::UvThreadEventTrigger);
         uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_eventTrigger), this);
         uv_async_init(&_threadLoop, &_shutdownTrigger, Thread::UvThreadShutdownTrigger);
         uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_shutdownTrigger), this);
+        std::string name = _options.name;
+        if (name.empty()) {
+            name = "thread-" + std::to_string(_loopSequence.fetch_add(1, std::memory_order_relaxed) + 1);
+        }
+        _loopMetrics.Attach(&_threadLoop, name.c_str());
         if (IInit()) {
             _status = Status::Running;
-            uv_barrier_wait(&_waitSignal);
+        } else {
+            for (auto channel: _channels) {
+                channel->Close();
+            }
+            _channels.clear();
+            _loopMetrics.Detach();
+            uv_close(reinterpret_cast<uv_handle_t *>(&_eventTrigger), nullptr);
+            uv_close(reinterpret_cast<uv_handle_t *>(&_shutdownTrigger), nullptr);
         }
+        uv_barrier_wait(&_waitSignal);
         uv_run(&_threadLoop, UV_RUN_DEFAULT);
         uv_loop_close(&_threadLoop);
     }
@@ -67,7 +166,9 @@ namespace Lcc {
     }
 
     void Thread::UvThreadRunMain(void *arg) {
-        static_cast<Thread *>(arg)->EventLoopInit();
+        auto self = static_cast<Thread *>(arg);
+        self->ApplyOptions();
+        self->EventLoopInit();
     }
 
     void Thread::UvThreadShutdown(uv_handle_t *handle) {
@@ -76,11 +177,17 @@ namespace Lcc {
 
     void Thread::UvThreadEventTrigger(uv_async_t *async) {
         auto self = static_cast<Thread *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(async)));
+        self->_wakeups.fetch_add(1, std::memory_order_relaxed);
         self->EventLoopQueueCommand();
     }
 
     void Thread::UvThreadShutdownTrigger(uv_async_t *async) {
         auto self = static_cast<Thread *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(async)));
+        for (auto channel: self->_channels) {
+            channel->Close();
+        }
+        self->_channels.clear();
+        self->_loopMetrics.Detach();
         uv_close(reinterpret_cast<uv_handle_t *>(&self->_eventTrigger), nullptr);
         uv_close(reinterpret_cast<uv_handle_t *>(&self->_shutdownTrigger), Thread::UvThreadShutdown);
     }
@@ -0,0 +1,199 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include "uv.h"
+#include "thread/Topology.h"
+
+namespace Lcc {
+    static bool _read_file(const std::string &path, std::string &out) {
+        FILE *fp = fopen(path.c_str(), "r");
+        if (!fp) {
+            return false;
+        }
+        char buf[1024] = {0};
+        const size_t l = fread(buf, 1, sizeof(buf) - 1, fp);
+        fclose(fp);
+        out.assign(buf, l);
+        while (!out.empty() && (out.back() == '\n' || out.back() == ' ')) {
+            out.pop_back();
+        }
+        return !out.empty();
+    }
+
+    static int _read_int(const std::string &path, int def) {
+        std::string text;
+        if (_read_file(path, text)) {
+            return atoi(text.c_str());
+        }
+        return def;
+    }
+
+    CpuTopology::CpuTopology(): _nodes(1) {
+    }
+
+    bool CpuTopology::Load() {
+        _cpus.clear();
+        _nodes = 1;
+        std::string text;
+        std::vector<int> online;
+        if (!_read_file("/sys/devices/system/cpu/online", text) || !ParseCpuList(text, online)) {
+            const unsigned int count = uv_available_parallelism();
+            for (unsigned int n = 0; n < count; ++n) {
+                _cpus.push_back(Cpu{static_cast<int>(n), static_cast<int>(n), 0, 0});
+            }
+            return false;
+        }
+        for (const int id: online) {
+            const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(id) + "/topology/";
+            _cpus.push_back(Cpu{
+                id, _read_int(base + "core_id", id), _read_int(base + "physical_package_id", 0), 0
+            });
+        }
+        // 节点编号可能不连续, 以最大编号+1作为节点数
+        std::vector<int> nodes;
+        if (_read_file("/sys/devices/system/node/online", text) && ParseCpuList(text, nodes)) {
+            std::vector<int> cpus;
+            for (const int node: nodes) {
+                if (!ReadNodeCpus(node, cpus)) {
+                    continue;
+                }
+                for (auto &cpu: _cpus) {
+                    if (std::find(cpus.begin(), cpus.end(), cpu.id) != cpus.end()) {
+                        cpu.node = node;
+                    }
+                }
+                _nodes = std::max(_nodes, static_cast<unsigned int>(node + 1));
+            }
+        }
+        return true;
+    }
+
+    unsigned int CpuTopology::CpuCount() const {
+        return static_cast<unsigned int>(_cpus.size());
+    }
+
+    unsigned int CpuTopology::NodeCount() const {
+        return _nodes;
+    }
+
+    std::vector<int> CpuTopology::NodeCpus(int node, bool physical) const {
+        std::vector<int> out;
+        std::vector<std::pair<int, int> > cores;
+        for (const auto &cpu: _cpus) {
+            if (cpu.node != node) {
+                continue;
+            }
+            if (physical) {
+                const std::pair<int, int> core(cpu.package, cpu.core);
+                if (std::find(cores.begin(), cores.end(), core) != cores.end()) {
+                    continue;
+                }
+                cores.push_back(core);
+            }
+            out.push_back(cpu.id);
+        }
+        return out;
+    }
+
+    const std::vector<CpuTopology::Cpu> &CpuTopology::Cpus() const {
+        return _cpus;
+    }
+
+    void CpuTopology::Layout(unsigned int networkLoops, unsigned int workers, std::vector<ThreadOptions> &network,
+                             std::vector<ThreadOptions> &logic) const {
+        network.clear();
+        logic.clear();
+        const unsigned int nodes = std::max(_nodes, 1U);
+        std::vector<std::vector<int> > physical(nodes);
+        std::vector<std::vector<int> > remain(nodes);
+        for (unsigned int node = 0; node < nodes; ++node) {
+            physical[node] = NodeCpus(static_cast<int>(node), true);
+            remain[node] = NodeCpus(static_cast<int>(node), false);
+        }
+        // 网络线程: 各节点轮流分配一个物理核
+        for (unsigned int n = 0; n < networkLoops; ++n) {
+            const unsigned int node = n % nodes;
+            ThreadOptions options;
+            options.name = "lcc-net-" + std::to_string(n);
+            options.numaNode = static_cast<int>(node);
+            if (!physical[node].empty()) {
+                const int cpu = physical[node].front();
+                physical[node].erase(physical[node].begin());
+                // 独占整个物理核, 同核超线程不再分给逻辑线程
+                int core = -1;
+                int package = -1;
+                for (const auto &it: _cpus) {
+                    if (it.id == cpu) {
+                        core = it.core;
+                        package = it.package;
+                    }
+                }
+                for (const auto &it: _cpus) {
+                    if (it.core == core && it.package == package) {
+                        remain[node].erase(std::remove(remain[node].begin(), remain[node].end(), it.id),
+                                           remain[node].end());
+                    }
+                }
+                options.cpus.push_back(cpu);
+            } else {
+                // 物理核不足时退化为绑定到整个节点
+                options.cpus = NodeCpus(static_cast<int>(node));
+            }
+            network.push_back(options);
+        }
+        // 逻辑线程: 按节点均分, 绑定到节点内剩余cpu集合, 由内核在集合内调度
+        for (unsigned int n = 0; n < workers; ++n) {
+            const unsigned int node = n % nodes;
+            ThreadOptions options;
+            options.name = "lcc-work-" + std::to_string(n);
+            options.numaNode = static_cast<int>(node);
+            options.cpus = remain[node].empty() ? NodeCpus(static_cast<int>(node)) : remain[node];
+            logic.push_back(options);
+        }
+    }
+
+    bool CpuTopology::ParseCpuList(const std::string &list, std::vector<int> &out) {
+        out.clear();
+        const char *p = list.c_str();
+        while (*p) {
+            char *end = nullptr;
+            const long first = strtol(p, &end, 10);
+            if (end == p) {
+                return false;
+            }
+            long last = first;
+            p = end;
+            if (*p == '-') {
+                ++p;
+                last = strtol(p, &end, 10);
+                if (end == p) {
+                    return false;
+                }
+                p = end;
+            }
+            for (long id = first; id <= last; ++id) {
+                out.push_back(static_cast<int>(id));
+            }
+            if (*p == ',') {
+                ++p;
+            } else if (*p && *p != '\n') {
+                return false;
+            } else {
+                break;
+            }
+        }
+        return !out.empty();
+    }
+
+    bool CpuTopology::ReadNodeCpus(int node, std::vector<int> &out) {
+        std::string text;
+        if (!_read_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", text)) {
+            out.clear();
+            return false;
+        }
+        return ParseCpuList(text, out);
+    }
+}
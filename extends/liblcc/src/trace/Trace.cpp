@@ -0,0 +1,295 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "libuv/uv.h"
+#include "trace/Trace.h"
+
+namespace Lcc {
+    namespace Trace {
+        namespace {
+            const char kMagic[8] = {'L', 'C', 'C', 'T', 'R', 'A', 'C', 'E'};
+            const uint32_t kVersion = 1;
+            // 时钟校准的最短间隔(纳秒)
+            const uint64_t kCalibrateSpan = 10000000;
+
+            // 文件头, 之后为各线程的RingHeader与记录
+            struct FileHeader {
+                char magic[8];
+                uint32_t version;
+                uint32_t recordSize;
+                // 时钟基准: 时间戳、对应的unix纳秒
+                uint64_t clockBase;
+                uint64_t unixBase;
+                // 每纳秒的时钟周期数
+                double ticksPerNano;
+                uint32_t rings;
+                uint32_t reserved;
+            };
+
+            struct RingHeader {
+                uint32_t thread;
+                uint32_t count;
+                char name[16];
+            };
+
+            struct Tracer {
+                std::mutex mutex;
+                size_t capacity = 0x10000;
+                uint32_t threads = 0;
+                uint64_t clockBase = 0;
+                uint64_t hrBase = 0;
+                uint64_t unixBase = 0;
+                std::vector<Ring *> rings;
+                std::vector<Ring *> freeRings;
+
+                Tracer() {
+                    uv_timeval64_t tv{};
+                    uv_gettimeofday(&tv);
+                    hrBase = uv_hrtime();
+                    clockBase = ReadClock();
+                    unixBase = static_cast<uint64_t>(tv.tv_sec) * 1000000000ULL + static_cast<uint64_t>(tv.tv_usec) * 1000;
+                }
+            };
+
+            Tracer &Instance() {
+                // 不析构: 线程退出归还缓冲可能晚于静态对象析构
+                static auto tracer = new Tracer;
+                return *tracer;
+            }
+
+            // 线程退出时归还缓冲
+            struct RingHolder {
+                Ring *ring = nullptr;
+
+                ~RingHolder() {
+                    if (ring) {
+                        Tracer &tracer = Instance();
+                        std::lock_guard<std::mutex> lock(tracer.mutex);
+                        tracer.freeRings.push_back(ring);
+                    }
+                }
+            };
+
+            thread_local RingHolder _holder;
+
+            /**
+             * 复制缓冲中仍然有效的记录, 复制期间被覆盖的记录丢弃
+             */
+            void Snapshot(Ring *ring, std::vector<Record> &out) {
+                const uint64_t size = ring->mask + 1;
+                const uint64_t head = ring->head.load(std::memory_order_acquire);
+                const uint64_t begin = head > size ? head - size : 0;
+                out.resize(head - begin);
+                for (uint64_t n = begin; n < head; ++n) {
+                    out[n - begin] = ring->records[n & ring->mask];
+                }
+                const uint64_t after = ring->head.load(std::memory_order_acquire);
+                const uint64_t valid = after > size ? after - size : 0;
+                if (valid > begin) {
+                    out.erase(out.begin(), out.begin() + static_cast<ptrdiff_t>(std::min(valid - begin, head - begin)));
+                }
+            }
+        }
+
+        static_assert(sizeof(Record) == 24, "trace record must stay 24 bytes");
+
+        thread_local Ring *Rings::_local = nullptr;
+        thread_local uint32_t Scope::_current = 0;
+
+        uint64_t ReadClock() {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return uv_hrtime();
+#endif
+        }
+
+        Ring *Rings::Attach() {
+            Tracer &tracer = Instance();
+            std::lock_guard<std::mutex> lock(tracer.mutex);
+            size_t capacity = 1;
+            while (capacity < tracer.capacity) {
+                capacity <<= 1;
+            }
+            Ring *ring = nullptr;
+            // 只复用容量一致的缓冲
+            auto it = std::find_if(tracer.freeRings.begin(), tracer.freeRings.end(), [capacity](const Ring *free) {
+                return free->mask + 1 == capacity;
+            });
+            if (it != tracer.freeRings.end()) {
+                ring = *it;
+                tracer.freeRings.erase(it);
+            } else {
+                ring = new Ring();
+                ring->records = new Record[capacity]();
+                ring->mask = capacity - 1;
+                ring->head.store(0, std::memory_order_relaxed);
+                tracer.rings.push_back(ring);
+            }
+            // 复用的缓冲保留旧记录, 只更换所属线程
+            ring->thread = ++tracer.threads;
+            memset(ring->name, 0, sizeof(ring->name));
+            _holder.ring = ring;
+            _local = ring;
+            return ring;
+        }
+
+        void SetCapacity(size_t records) {
+            Tracer &tracer = Instance();
+            std::lock_guard<std::mutex> lock(tracer.mutex);
+            tracer.capacity = records > 0 ? records : 1;
+        }
+
+        void SetThreadName(const char *name) {
+            Ring *ring = Rings::Local();
+            strncpy(ring->name, name ? name : "", sizeof(ring->name) - 1);
+        }
+
+        int Dump(const char *path) {
+            Tracer &tracer = Instance();
+            // 校准时钟频率, 距离基准太近时等待一小段时间
+            uint64_t hr = uv_hrtime();
+            while (hr - tracer.hrBase < kCalibrateSpan) {
+                uv_sleep(1);
+                hr = uv_hrtime();
+            }
+            const uint64_t clock = ReadClock();
+
+            FileHeader header{};
+            memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version = kVersion;
+            header.recordSize = sizeof(Record);
+            header.clockBase = tracer.clockBase;
+            header.unixBase = tracer.unixBase;
+            header.ticksPerNano = static_cast<double>(clock - tracer.clockBase) / static_cast<double>(hr - tracer.hrBase);
+
+            std::vector<Ring *> rings;
+            {
+                std::lock_guard<std::mutex> lock(tracer.mutex);
+                rings = tracer.rings;
+            }
+            FILE *file = fopen(path, "wb");
+            if (!file) {
+                return UV_EIO;
+            }
+            header.rings = static_cast<uint32_t>(rings.size());
+            bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+            std::vector<Record> records;
+            for (size_t n = 0; ok && n < rings.size(); ++n) {
+                Snapshot(rings[n], records);
+                RingHeader ringHeader{};
+                ringHeader.thread = rings[n]->thread;
+                ringHeader.count = static_cast<uint32_t>(records.size());
+                memcpy(ringHeader.name, rings[n]->name, sizeof(ringHeader.name));
+                ok = fwrite(&ringHeader, sizeof(ringHeader), 1, file) == 1 &&
+                     (records.empty() || fwrite(records.data(), sizeof(Record), records.size(), file) == records.size());
+            }
+            fclose(file);
+            return ok ? 0 : UV_EIO;
+        }
+
+        const char *StageName(uint16_t stage) {
+            static const char *names[] = {
+                "None", "StreamRead", "TlsRead", "WsRead", "FrameRead", "UserReceive",
+                "UserWrite", "FrameWrite", "WsWrite", "TlsWrite", "StreamWrite", "WriteDone",
+            };
+            static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(Stage::Count), "stage names");
+            return stage < static_cast<uint16_t>(Stage::Count) ? names[stage] : "Unknown";
+        }
+
+        int ConvertToJson(const char *input, const char *output) {
+            FILE *in = fopen(input, "rb");
+            if (!in) {
+                return UV_ENOENT;
+            }
+            FileHeader header{};
+            if (fread(&header, sizeof(header), 1, in) != 1 || memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+                header.version != kVersion || header.recordSize != sizeof(Record) || header.ticksPerNano <= 0) {
+                fclose(in);
+                return UV_EINVAL;
+            }
+            FILE *out = fopen(output, "wb");
+            if (!out) {
+                fclose(in);
+                return UV_EIO;
+            }
+            // 时间戳统一换算为相对时钟基准的微秒
+            auto micros = [&header](uint64_t tsc) {
+                return (static_cast<double>(tsc) - static_cast<double>(header.clockBase)) / header.ticksPerNano / 1000.0;
+            };
+            int err = 0;
+            bool first = true;
+            auto separator = [&first, out]() {
+                fputs(first ? "\n" : ",\n", out);
+                first = false;
+            };
+            fprintf(out, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"unixBaseNs\":%llu},\"traceEvents\":[",
+                    static_cast<unsigned long long>(header.unixBase));
+            std::vector<Record> records;
+            for (uint32_t n = 0; n < header.rings && err == 0; ++n) {
+                RingHeader ringHeader{};
+                if (fread(&ringHeader, sizeof(ringHeader), 1, in) != 1) {
+                    err = UV_EINVAL;
+                    break;
+                }
+                records.resize(ringHeader.count);
+                if (ringHeader.count && fread(records.data(), sizeof(Record), records.size(), in) != records.size()) {
+                    err = UV_EINVAL;
+                    break;
+                }
+                char name[sizeof(ringHeader.name) + 1] = {0};
+                memcpy(name, ringHeader.name, sizeof(ringHeader.name));
+                separator();
+                if (name[0]) {
+                    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"%s\"}}",
+                            ringHeader.thread, name);
+                } else {
+                    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"thread-%u\"}}",
+                            ringHeader.thread, ringHeader.thread);
+                }
+                // 每个会话的uv_write按提交顺序完成, 按先进先出配对
+                std::unordered_map<uint32_t, std::deque<const Record *> > writes;
+                std::unordered_map<uint32_t, bool> sessions;
+                for (const auto &record: records) {
+                    if (!sessions[record.session]) {
+                        sessions[record.session] = true;
+                        separator();
+                        fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,"
+                                "\"args\":{\"name\":\"session %u\"}}", ringHeader.thread, record.session, record.session);
+                    }
+                    separator();
+                    fprintf(out, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u,"
+                            "\"args\":{\"bytes\":%u,\"arg\":%u}}", StageName(record.stage), micros(record.tsc),
+                            ringHeader.thread, record.session, record.bytes, record.arg);
+                    if (record.stage == static_cast<uint16_t>(Stage::StreamWrite)) {
+                        writes[record.session].push_back(&record);
+                    } else if (record.stage == static_cast<uint16_t>(Stage::WriteDone)) {
+                        auto &pending = writes[record.session];
+                        if (!pending.empty()) {
+                            const Record *begin = pending.front();
+                            pending.pop_front();
+                            separator();
+                            fprintf(out, "{\"name\":\"uv_write\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%u,"
+                                    "\"tid\":%u,\"args\":{\"bytes\":%u}}", micros(begin->tsc),
+                                    micros(record.tsc) - micros(begin->tsc), ringHeader.thread, record.session,
+                                    begin->bytes);
+                        }
+                    }
+                }
+            }
+            fputs("\n]}\n", out);
+            fclose(in);
+            if (fclose(out) != 0 && err == 0) {
+                err = UV_EIO;
+            }
+            return err;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <buffer/Bio.h>
+#include <libuv/uv.h>
+
+// 每个用例处理的总字节数
+static const unsigned long long kTotalBytes = 0x4000000ULL; // 64MB
+// 环形缓冲区容量, 使消息周期性跨越环尾
+static const unsigned int kRingSize = 0x40000; // 256KB
+
+static const char *BackendName(Lcc::BufferBioBackend backend) {
+    return backend == Lcc::BufferBioBackend::Mirror ? "mirror" : "heap";
+}
+
+/**
+ * 预热缓冲区到固定容量, 并错开读写位置使消息跨越环尾
+ */
+static void Prepare(Lcc::BufferBio &bio, unsigned int size) {
+    std::string fill(kRingSize, 'x');
+    bio.Write(fill.data(), kRingSize);
+    bio.Skip(kRingSize);
+    fill.resize(size / 2 + 1);
+    bio.Write(fill.data(), fill.size());
+    bio.Skip(fill.size());
+}
+
+/**
+ * 写入后拷贝读出
+ */
+static double BenchCopy(Lcc::BufferBioBackend backend, unsigned int size) {
+    Lcc::BufferBio bio(backend);
+    Prepare(bio, size);
+    std::string in(size, 'a');
+    std::string out(size, 0);
+    const unsigned long long loops = kTotalBytes / size;
+    const uint64_t begin = uv_hrtime();
+    for (unsigned long long n = 0; n < loops; ++n) {
+        bio.Write(in.data(), size);
+        bio.Read(const_cast<char *>(out.data()), size);
+    }
+    return static_cast<double>(uv_hrtime() - begin) / static_cast<double>(loops);
+}
+
+/**
+ * 写入后原地解析, 不连续时才拷贝到临时缓冲区
+ */
+static double BenchInPlace(Lcc::BufferBioBackend backend, unsigned int size, unsigned long long &copied) {
+    Lcc::BufferBio bio(backend);
+    Prepare(bio, size);
+    std::string in(size, 'a');
+    std::string scratch(size, 0);
+    unsigned long long checksum = 0;
+    const unsigned long long loops = kTotalBytes / size;
+    copied = 0;
+    const uint64_t begin = uv_hrtime();
+    for (unsigned long long n = 0; n < loops; ++n) {
+        bio.Write(in.data(), size);
+        const char *frame = bio.Data();
+        if (bio.ContiguousSize() < size) {
+            bio.Read(const_cast<char *>(scratch.data()), size);
+            frame = scratch.data();
+            ++copied;
+        } else {
+            bio.Skip(size);
+        }
+        checksum += static_cast<unsigned char>(frame[size - 1]);
+    }
+    const uint64_t cost = uv_hrtime() - begin;
+    if (checksum != loops * 'a') {
+        printf("checksum mismatch\n");
+    }
+    return static_cast<double>(cost) / static_cast<double>(loops);
+}
+
+int main(int argc, char *argv[]) {
+    Lcc::BufferBio probe(Lcc::BufferBioBackend::Mirror);
+    probe.Write("probe", 5);
+    if (probe.Backend() != Lcc::BufferBioBackend::Mirror) {
+        printf("mirror backend unavailable, fallback to heap\n");
+    }
+    // 跨越环尾的连续性校验
+    Lcc::BufferBio check(Lcc::BufferBioBackend::Mirror);
+    check.Write(std::string(0x1000, 'x').data(), 0x1000 - 3);
+    check.Skip(0x1000 - 3);
+    check.Write("0123456789", 10);
+    if (check.Backend() == Lcc::BufferBioBackend::Mirror &&
+        (check.ContiguousSize() != 10 || memcmp(check.Data(), "0123456789", 10) != 0)) {
+        printf("mirror wrap check failed\n");
+        return 1;
+    }
+
+    const unsigned int sizes[] = {64, 256, 1024, 4096, 16384, 65536};
+    const Lcc::BufferBioBackend backends[] = {Lcc::BufferBioBackend::Heap, Lcc::BufferBioBackend::Mirror};
+    printf("%-8s %-8s %14s %14s %12s\n", "backend", "size", "copy(ns/op)", "inplace(ns/op)", "wrap-copies");
+    for (const unsigned int size: sizes) {
+        for (const auto backend: backends) {
+            unsigned long long copied = 0;
+            const double copy = BenchCopy(backend, size);
+            const double inplace = BenchInPlace(backend, size, copied);
+            printf("%-8s %-8u %14.1f %14.1f %12llu\n", BackendName(backend), size, copy, inplace, copied);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,298 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include <network/TcpClientPool.h>
+#include <network/TcpServer.h>
+
+static const int kPort = 18446;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+/**
+ * 计数用的创造器, 不挂载插件
+ */
+class CountingCreator : public Lcc::ProtocolPluginCreator {
+public:
+    static unsigned int _created;
+    static unsigned int _allocs;
+    static unsigned int _releases;
+
+    CountingCreator() {
+        ++_created;
+    }
+
+    bool ICreatorInit() override {
+        return true;
+    }
+
+    void ICreatorRelease() override {
+        ++_releases;
+        delete this;
+    }
+
+    Lcc::ProtocolPlugin *ICreatorAlloc(Lcc::ProtocolImplement *impl) override {
+        ++_allocs;
+        return nullptr;
+    }
+};
+
+unsigned int CountingCreator::_created = 0;
+unsigned int CountingCreator::_allocs = 0;
+unsigned int CountingCreator::_releases = 0;
+
+class EchoServer : public Lcc::TcpServer, public Lcc::ServerImplement {
+public:
+    EchoServer(uv_loop_t *loop, bool echo) : TcpServer(this), _loop(loop), _echo(echo) {
+    }
+
+    uv_loop_t *_loop;
+    bool _echo;
+    int _listen = 0;
+    int _sessions = 0;
+    bool _shutdown = false;
+    std::map<unsigned int, std::string> _received;
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : err;
+    }
+
+    void IServerShutdown() override {
+        _shutdown = true;
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        ++_sessions;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        _received[session].append(buf, size);
+        if (_echo) {
+            SessionWrite(session, buf, size);
+        }
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        --_sessions;
+    }
+};
+
+class Pool : public Lcc::TcpClientPool, public Lcc::ClientPoolImplement {
+public:
+    explicit Pool(uv_loop_t *loop) : TcpClientPool(loop, this) {
+    }
+
+    unsigned int _ups = 0;
+    unsigned int _downs = 0;
+    unsigned int _probes = 0;
+    bool _closed = false;
+    std::string _received;
+    std::vector<std::pair<unsigned int, unsigned int>> _retries;
+
+    void IPoolLinkSetup(unsigned int endpoint, unsigned int link, Lcc::TcpClient &client) override {
+        client.Enable(new CountingCreator);
+    }
+
+    void IPoolLinkUp(unsigned int endpoint, unsigned int link) override {
+        ++_ups;
+    }
+
+    void IPoolLinkDown(unsigned int endpoint, unsigned int link, int err, const char *errMsg) override {
+        ++_downs;
+    }
+
+    void IPoolLinkRetry(unsigned int endpoint, unsigned int link, unsigned int failures,
+                        unsigned int delay) override {
+        _retries.emplace_back(failures, delay);
+    }
+
+    void IPoolReceive(unsigned int endpoint, unsigned int link, const char *buf, unsigned int size) override {
+        _received.append(buf, size);
+    }
+
+    bool IPoolHealthCheck(unsigned int endpoint, unsigned int link) override {
+        ++_probes;
+        return WriteTo(link, "?", 1);
+    }
+
+    void IPoolShutdown() override {
+        _closed = true;
+    }
+};
+
+static uv_timer_t _ticker;
+
+static bool RunUntil(uv_loop_t *loop, bool (*done)(void *), void *arg, uint64_t timeout = 5000) {
+    const uint64_t deadline = uv_now(loop) + timeout;
+    while (!done(arg)) {
+        if (uv_now(loop) > deadline) {
+            return false;
+        }
+        uv_run(loop, UV_RUN_ONCE);
+    }
+    return true;
+}
+
+static void RunFor(uv_loop_t *loop, uint64_t time) {
+    const uint64_t deadline = uv_now(loop) + time;
+    while (uv_now(loop) < deadline) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+}
+
+static std::string Host(int port) {
+    return "tcp://127.0.0.1:" + std::to_string(port);
+}
+
+static void ClosePool(uv_loop_t *loop, Pool &pool) {
+    pool.Shutdown();
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_closed; }, &pool));
+}
+
+int main(int argc, char *argv[]) {
+    uv_loop_t *loop = uv_default_loop();
+    uv_timer_init(loop, &_ticker);
+    uv_timer_start(&_ticker, [](uv_timer_t *) {}, 10, 10);
+
+    EchoServer server(loop, true);
+    server.Listen(Host(kPort).c_str());
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_listen != 0; }, &server);
+    CHECK(server._listen == 1);
+    EchoServer silent(loop, false);
+    silent.Listen(Host(kPort + 2).c_str());
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_listen != 0; }, &silent);
+    CHECK(silent._listen == 1);
+
+    // 保持连接数, 轮换分发, 服务端断开后自动重连并复用创造器
+    {
+        Pool pool(loop);
+        Lcc::ClientPoolOptions options;
+        options.connections = 3;
+        options.idleTimeout = 0;
+        pool.SetOptions(options);
+        CHECK(pool.AddEndpoint("udp://127.0.0.1:1") == 0);
+        const unsigned int endpoint = pool.AddEndpoint(Host(kPort).c_str());
+        CHECK(endpoint != 0);
+        CHECK(pool.Write(endpoint, "x", 1) == 0);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_ups == 3; }, &pool));
+        CHECK(pool.ConnectedCount(endpoint) == 3);
+        std::map<unsigned int, int> used;
+        for (int n = 0; n < 6; ++n) {
+            ++used[pool.Write(endpoint, "x", 1)];
+        }
+        CHECK(used.size() == 3 && used.count(0) == 0);
+        for (auto &it: used) {
+            CHECK(it.second == 2);
+        }
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_received.size() == 6; }, &pool));
+
+        server.ShutdownAllSessions();
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_ups == 6; }, &pool));
+        CHECK(pool._downs == 3);
+        CHECK(pool._retries.size() == 3);
+        for (auto &retry: pool._retries) {
+            CHECK(retry.first == 1 && retry.second >= 50 && retry.second <= 100);
+        }
+        CHECK(CountingCreator::_created == 3 && CountingCreator::_allocs == 6 && CountingCreator::_releases == 0);
+        CHECK(pool.WriteTo(pool.Write(endpoint, "y", 1), "z", 1));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_received.size() == 8; }, &pool));
+        ClosePool(loop, pool);
+        CHECK(CountingCreator::_releases == 3);
+        CHECK(pool.Write(endpoint, "x", 1) == 0);
+        printf("reconnect ok\n");
+    }
+    // 最少待发送: 负载相同时依次轮换
+    {
+        Pool pool(loop);
+        Lcc::ClientPoolOptions options;
+        options.connections = 2;
+        options.dispatch = Lcc::PoolDispatch::LeastLoaded;
+        pool.SetOptions(options);
+        const unsigned int endpoint = pool.AddEndpoint(Host(kPort).c_str());
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_ups == 2; }, &pool));
+        const unsigned int first = pool.Write(endpoint, "a", 1);
+        const unsigned int second = pool.Write(endpoint, "b", 1);
+        CHECK(first != 0 && second != 0 && first != second);
+        ClosePool(loop, pool);
+        printf("least loaded ok\n");
+    }
+    // 连接失败: 退避间隔按失败次数翻倍直到上限, 每次在上限的一半到上限之间
+    {
+        Pool pool(loop);
+        Lcc::ClientPoolOptions options;
+        options.connections = 1;
+        options.backoffBase = 20;
+        options.backoffMax = 160;
+        pool.SetOptions(options);
+        const unsigned int endpoint = pool.AddEndpoint(Host(kPort + 1).c_str());
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_retries.size() >= 6; }, &pool));
+        for (size_t n = 0; n < pool._retries.size(); ++n) {
+            const unsigned int cap = std::min(20U << n, 160U);
+            printf("retry %u: %u ms\n", pool._retries[n].first, pool._retries[n].second);
+            CHECK(pool._retries[n].first == n + 1);
+            CHECK(pool._retries[n].second >= cap / 2 && pool._retries[n].second <= cap);
+        }
+        CHECK(pool.ConnectedCount(endpoint) == 0 && pool._ups == 0 && pool._downs == 0);
+        ClosePool(loop, pool);
+        printf("backoff ok\n");
+    }
+    // 健康检查: 应答的连接保持, 不应答的连接断开重连
+    {
+        Pool pool(loop);
+        Lcc::ClientPoolOptions options;
+        options.connections = 1;
+        options.backoffBase = 20;
+        options.idleTimeout = 100;
+        options.checkTimeout = 100;
+        pool.SetOptions(options);
+        const unsigned int endpoint = pool.AddEndpoint(Host(kPort).c_str());
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_ups == 1; }, &pool));
+        RunFor(loop, 450);
+        CHECK(pool._probes >= 3 && pool._downs == 0 && pool.ConnectedCount(endpoint) == 1);
+
+        Pool stale(loop);
+        stale.SetOptions(options);
+        stale.AddEndpoint(Host(kPort + 2).c_str());
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_downs == 1; }, &stale, 1000));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Pool *>(arg)->_ups == 2; }, &stale));
+        ClosePool(loop, pool);
+        ClosePool(loop, stale);
+        printf("health check ok\n");
+    }
+    // 连接中关闭
+    {
+        Pool pool(loop);
+        pool.AddEndpoint(Host(kPort).c_str());
+        ClosePool(loop, pool);
+        CHECK(pool._ups == 0);
+    }
+    CHECK(CountingCreator::_releases == CountingCreator::_created);
+
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server);
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &silent);
+    server.Shutdown();
+    silent.Shutdown();
+    uv_close(reinterpret_cast<uv_handle_t *>(&_ticker), nullptr);
+    uv_run(loop, UV_RUN_DEFAULT);
+    CHECK(uv_loop_close(loop) == 0);
+    if (_failed) {
+        printf("client pool fail %u\n", _failed);
+        return 1;
+    }
+    printf("client pool ok\n");
+    return 0;
+}
@@ -0,0 +1,366 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <malloc.h>
+#include <string>
+#include <functional>
+#include <vector>
+#include <network/CoTcpServer.h>
+
+static const char *kHost = "tcp://127.0.0.1:18432";
+static const unsigned int kPort = 18432;
+static const unsigned int kRounds = 4;
+static const unsigned int kWave = 100;
+
+// 堆上已分配字节数, 不受释放后内存复用的影响
+static size_t HeapInUse() {
+    return mallinfo2().uordblks;
+}
+
+/**
+ * 登录流程: 读请求帧 -> 模拟DB等待 -> 回复令牌, 全程顺序写法
+ */
+class LoginServer : public Lcc::CoTcpServer {
+public:
+    explicit LoginServer(uv_loop_t *loop) : CoTcpServer(loop), _logins(0), _sleep(1), _listen(0) {
+    }
+
+    unsigned long long _logins;
+    unsigned int _sleep;
+    int _listen;
+
+protected:
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : -1;
+    }
+
+    void ISessionRun(Lcc::CoSession &session) override {
+        std::string request;
+        while (session.ReadFrame(request) >= 0) {
+            if (_sleep && !session.Sleep(_sleep)) {
+                break;
+            }
+            const std::string token = "token:" + request;
+            if (!session.WriteFrame(token.data(), static_cast<unsigned int>(token.size()))) {
+                break;
+            }
+            ++_logins;
+        }
+    }
+};
+
+/**
+ * 转发: 等待方阻塞在读帧上, 转发方在自己的协程内把数据交给等待方并唤醒它
+ */
+class RelayServer : public Lcc::CoTcpServer {
+public:
+    explicit RelayServer(uv_loop_t *loop) : CoTcpServer(loop), _waiter(0), _listen(0) {
+    }
+
+    unsigned int _waiter;
+    int _listen;
+
+protected:
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : -1;
+    }
+
+    void ISessionRun(Lcc::CoSession &session) override {
+        std::string request;
+        if (session.ReadFrame(request) < 0) {
+            return;
+        }
+        if (request == "wait") {
+            _waiter = session.GetSession();
+            if (session.ReadFrame(request) >= 0) {
+                session.WriteFrame(request.data(), static_cast<unsigned int>(request.size()));
+            }
+        } else if (_waiter != 0) {
+            const char frame[] = {0, 0, 0, 5, 'h', 'e', 'l', 'l', 'o'};
+            IServerSessionReceive(_waiter, frame, sizeof(frame));
+            session.WriteFrame("sent", 4);
+        }
+        // 保持连接直到客户端关闭
+        session.ReadFrame(request);
+    }
+};
+
+/**
+ * 原生uv客户端, 每轮发送一帧并等待回复
+ */
+struct Client {
+    uv_tcp_t tcp;
+    uv_connect_t connect;
+    unsigned int id;
+    unsigned int rounds;
+    unsigned int target;
+    bool connected;
+    std::string input;
+    char buffer[256];
+};
+
+static unsigned int _connected = 0;
+static unsigned int _finished = 0;
+static unsigned int _failed = 0;
+
+static void SendRequest(Client *client) {
+    const std::string payload = "user" + std::to_string(client->id);
+    auto req = new uv_write_t;
+    auto data = new std::string(4, '\0');
+    (*data)[3] = static_cast<char>(payload.size());
+    data->append(payload);
+    req->data = data;
+    uv_buf_t buf = uv_buf_init(&(*data)[0], static_cast<unsigned int>(data->size()));
+    uv_write(req, reinterpret_cast<uv_stream_t *>(&client->tcp), &buf, 1, [](uv_write_t *req, int status) {
+        delete static_cast<std::string *>(req->data);
+        delete req;
+    });
+}
+
+static void OnRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf) {
+    auto client = static_cast<Client *>(stream->data);
+    if (nread < 0) {
+        ++_failed;
+        uv_close(reinterpret_cast<uv_handle_t *>(stream), nullptr);
+        return;
+    }
+    client->input.append(buf->base, nread);
+    while (client->input.size() >= 4) {
+        const auto size = static_cast<unsigned char>(client->input[3]);
+        if (client->input.size() < 4U + size) {
+            break;
+        }
+        const std::string token = client->input.substr(4, size);
+        client->input.erase(0, 4 + size);
+        if (token != "token:user" + std::to_string(client->id)) {
+            ++_failed;
+        }
+        if (++client->rounds < client->target) {
+            SendRequest(client);
+        } else {
+            ++_finished;
+        }
+    }
+}
+
+static void OnConnect(uv_connect_t *req, int status) {
+    auto client = static_cast<Client *>(req->data);
+    if (status != 0) {
+        ++_failed;
+        return;
+    }
+    client->connected = true;
+    ++_connected;
+    uv_read_start(reinterpret_cast<uv_stream_t *>(&client->tcp), [](uv_handle_t *handle, size_t, uv_buf_t *buf) {
+        auto client = static_cast<Client *>(handle->data);
+        *buf = uv_buf_init(client->buffer, sizeof(client->buffer));
+    }, OnRead);
+}
+
+static void RunUntil(uv_loop_t *loop, const std::function<bool()> &done) {
+    while (!done()) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+}
+
+/**
+ * 纯协程切换开销: 不含网络, 只测量共享栈协程的内存与切换成本
+ */
+class SwitchCoroutine : public Lcc::Coroutine {
+protected:
+    void ICoroutineRun() override {
+        char frame[256];
+        memset(frame, 0, sizeof(frame));
+        for (;;) {
+            Yield();
+            ++frame[0];
+        }
+    }
+};
+
+static void SwitchBenchmark(unsigned int count) {
+    Lcc::CoroutineEnv env;
+    env.Init();
+    const size_t before = HeapInUse();
+    std::vector<SwitchCoroutine *> coroutines(count);
+    for (auto &co: coroutines) {
+        co = new SwitchCoroutine;
+        co->Start(&env);
+    }
+    const size_t after = HeapInUse();
+    const unsigned int rounds = 20;
+    const uint64_t begin = uv_hrtime();
+    for (unsigned int r = 0; r < rounds; ++r) {
+        for (auto co: coroutines) {
+            co->Resume();
+        }
+    }
+    const double ns = static_cast<double>(uv_hrtime() - begin) / (static_cast<double>(count) * rounds);
+    printf("coroutines %u: %.0f bytes/coroutine (save stack %zu bytes), resume+yield %.1f ns\n", count,
+           static_cast<double>(after - before) / count, coroutines.front()->SavedStackSize(), ns);
+    for (auto co: coroutines) {
+        delete co;
+    }
+}
+
+static void RelayRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf) {
+    auto client = static_cast<Client *>(stream->data);
+    if (nread < 0) {
+        ++_failed;
+        uv_close(reinterpret_cast<uv_handle_t *>(stream), nullptr);
+        return;
+    }
+    client->input.append(buf->base, nread);
+}
+
+static void RelayConnect(uv_connect_t *req, int status) {
+    auto client = static_cast<Client *>(req->data);
+    if (status != 0) {
+        ++_failed;
+        return;
+    }
+    client->connected = true;
+    ++_connected;
+    uv_read_start(reinterpret_cast<uv_stream_t *>(&client->tcp), [](uv_handle_t *handle, size_t, uv_buf_t *buf) {
+        auto client = static_cast<Client *>(handle->data);
+        *buf = uv_buf_init(client->buffer, sizeof(client->buffer));
+    }, RelayRead);
+}
+
+static void SendFrame(Client *client, const std::string &payload) {
+    auto req = new uv_write_t;
+    auto data = new std::string(4, '\0');
+    (*data)[3] = static_cast<char>(payload.size());
+    data->append(payload);
+    req->data = data;
+    uv_buf_t buf = uv_buf_init(&(*data)[0], static_cast<unsigned int>(data->size()));
+    uv_write(req, reinterpret_cast<uv_stream_t *>(&client->tcp), &buf, 1, [](uv_write_t *req, int status) {
+        delete static_cast<std::string *>(req->data);
+        delete req;
+    });
+}
+
+/**
+ * 一个会话在协程内唤醒另一个会话, 被唤醒方须在回到主协程后恢复
+ */
+static bool RelayTest(uv_loop_t *loop) {
+    RelayServer server(loop);
+    if (!server.Listen(kHost)) {
+        return false;
+    }
+    RunUntil(loop, [&] { return server._listen != 0; });
+    if (server._listen < 0) {
+        return false;
+    }
+    _connected = _failed = 0;
+    sockaddr_in addr{};
+    uv_ip4_addr("127.0.0.1", kPort, &addr);
+    Client clients[2]{};
+    for (auto &client: clients) {
+        uv_tcp_init(loop, &client.tcp);
+        client.tcp.data = &client;
+        client.connect.data = &client;
+        uv_tcp_connect(&client.connect, &client.tcp, reinterpret_cast<const sockaddr *>(&addr), RelayConnect);
+    }
+    RunUntil(loop, [&] { return _connected + _failed >= 2 && server.SessionCount() + _failed >= 2; });
+    Client &waiter = clients[0];
+    Client &relay = clients[1];
+    SendFrame(&waiter, "wait");
+    RunUntil(loop, [&] { return server._waiter != 0 || _failed > 0; });
+    SendFrame(&relay, "relay");
+    const std::string hello("\0\0\0\5hello", 9);
+    const std::string sent("\0\0\0\4sent", 8);
+    const uint64_t deadline = uv_hrtime() + 3000000000ULL;
+    RunUntil(loop, [&] {
+        return (waiter.input == hello && relay.input == sent) || _failed > 0 || uv_hrtime() > deadline;
+    });
+    const bool ok = waiter.input == hello && relay.input == sent && _failed == 0;
+    printf("relay wake: waiter %s, relay %s\n", waiter.input == hello ? "resumed" : "lost",
+           relay.input == sent ? "done" : "lost");
+
+    for (auto &client: clients) {
+        uv_close(reinterpret_cast<uv_handle_t *>(&client.tcp), nullptr);
+    }
+    RunUntil(loop, [&] { return server.SessionCount() == 0; });
+    server.Shutdown();
+    uv_run(loop, UV_RUN_DEFAULT);
+    return ok;
+}
+
+static bool SessionBenchmark(uv_loop_t *loop, unsigned int count, unsigned int sleep) {
+    LoginServer server(loop);
+    server._sleep = sleep;
+    if (!server.Listen(kHost)) {
+        return false;
+    }
+    RunUntil(loop, [&] { return server._listen != 0; });
+    if (server._listen < 0) {
+        return false;
+    }
+    _connected = _finished = _failed = 0;
+    sockaddr_in addr{};
+    uv_ip4_addr("127.0.0.1", kPort, &addr);
+    const size_t before = HeapInUse();
+    std::vector<Client *> clients(count);
+    for (unsigned int n = 0; n < count; ++n) {
+        auto client = new Client();
+        client->id = n;
+        client->target = kRounds;
+        uv_tcp_init(loop, &client->tcp);
+        client->tcp.data = client;
+        client->connect.data = client;
+        uv_tcp_connect(&client->connect, &client->tcp, reinterpret_cast<const sockaddr *>(&addr), OnConnect);
+        clients[n] = client;
+        // 分批连接, 避免超出监听backlog导致SYN重传
+        const unsigned int total = n + 1;
+        if (total % kWave == 0 || total == count) {
+            RunUntil(loop, [&] { return _connected + _failed >= total && server.SessionCount() + _failed >= total; });
+        }
+    }
+    const size_t after = HeapInUse();
+
+    const uint64_t begin = uv_hrtime();
+    for (auto client: clients) {
+        if (client->connected) {
+            SendRequest(client);
+        }
+    }
+    RunUntil(loop, [&] { return _finished + _failed >= count; });
+    const double seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+    printf("sessions %u: %.0f bytes/session, %llu logins in %.3fs (%.0f/s), failed %u\n", count,
+           static_cast<double>(after - before) / count - sizeof(Client), server._logins, seconds, server._logins / seconds, _failed);
+
+    for (auto client: clients) {
+        uv_close(reinterpret_cast<uv_handle_t *>(&client->tcp), nullptr);
+    }
+    RunUntil(loop, [&] { return server.SessionCount() == 0; });
+    server.Shutdown();
+    uv_run(loop, UV_RUN_DEFAULT);
+    for (auto client: clients) {
+        delete client;
+    }
+    return _failed == 0 && server._logins == static_cast<unsigned long long>(count) * kRounds;
+}
+
+int main(int argc, char *argv[]) {
+    SwitchBenchmark(50000);
+
+    uv_loop_t *loop = uv_default_loop();
+    if (!RelayTest(loop)) {
+        printf("relay wake fail\n");
+        return 1;
+    }
+    if (!SessionBenchmark(loop, 100, 1)) {
+        printf("login flow fail\n");
+        return 1;
+    }
+    // 每个连接在进程内占用客户端和服务端两个fd
+    if (!SessionBenchmark(loop, 5000, 0)) {
+        printf("session benchmark fail\n");
+        return 1;
+    }
+    uv_loop_close(loop);
+    return 0;
+}
@@ -0,0 +1,148 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <malloc.h>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include <coroutine/Await.h>
+
+static const char *kPath = "/tmp/lcc_coroutine_await.txt";
+static const unsigned int kSleepers = 10000;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+/**
+ * 顺序写法的配置加载: 写文件 -> 读回 -> 获取信息 -> 解析域名 -> 线程池计算
+ */
+class LoaderCoroutine : public Lcc::Coroutine {
+public:
+    explicit LoaderCoroutine(uv_loop_t *loop) : _loop(loop), _sum(0), _done(false) {
+        _content = "name=login\nport=18432\n";
+    }
+
+    uv_loop_t *_loop;
+    std::string _content;
+    unsigned long long _sum;
+    bool _done;
+
+protected:
+    void ICoroutineRun() override {
+        const uint64_t begin = uv_hrtime();
+        CHECK(Lcc::Await::Sleep(_loop, 5) == 0);
+        CHECK(uv_hrtime() - begin >= 5000000);
+
+        const int file = Lcc::Await::FsOpen(_loop, kPath, UV_FS_O_WRONLY | UV_FS_O_CREAT | UV_FS_O_TRUNC);
+        CHECK(file >= 0);
+        CHECK(Lcc::Await::FsWrite(_loop, file, _content.data(), _content.size(), 0) ==
+              static_cast<int>(_content.size()));
+        // 共享栈上的缓冲区会在挂起期间被换出, 必须拒绝
+        char local[16];
+        CHECK(Lcc::Await::FsRead(_loop, file, local, sizeof(local), 0) == UV_EINVAL);
+        CHECK(Lcc::Await::FsClose(_loop, file) == 0);
+
+        std::string text;
+        CHECK(Lcc::Await::ReadFile(_loop, kPath, text) == static_cast<int>(_content.size()));
+        CHECK(text == _content);
+        uv_stat_t stat{};
+        CHECK(Lcc::Await::FsStat(_loop, kPath, stat) == 0);
+        CHECK(stat.st_size == _content.size());
+        CHECK(Lcc::Await::ReadFile(_loop, "/tmp/lcc_coroutine_await.missing", text) == UV_ENOENT);
+
+        std::vector<sockaddr_storage> addrs;
+        CHECK(Lcc::Await::GetAddrInfo(_loop, "localhost", nullptr, addrs) == 0);
+        CHECK(!addrs.empty());
+
+        unsigned long long *sum = &_sum;
+        CHECK(Lcc::Await::Work(_loop, [sum] {
+            for (unsigned long long n = 1; n <= 1000; ++n) {
+                *sum += n;
+            }
+        }) == 0);
+        CHECK(_sum == 500500);
+        _done = true;
+    }
+};
+
+/**
+ * 大量协程同时睡眠, 验证等待不产生堆分配
+ */
+class SleepCoroutine : public Lcc::Coroutine {
+public:
+    explicit SleepCoroutine(uv_loop_t *loop) : _loop(loop), _wakes(0) {
+    }
+
+    uv_loop_t *_loop;
+    unsigned int _wakes;
+
+protected:
+    void ICoroutineRun() override {
+        for (unsigned int n = 0; n < 3; ++n) {
+            if (Lcc::Await::Sleep(_loop, 1 + n) == 0) {
+                ++_wakes;
+            }
+        }
+    }
+};
+
+int main(int argc, char *argv[]) {
+    uv_loop_t *loop = uv_default_loop();
+    Lcc::CoroutineEnv env;
+    env.Init();
+
+    // 协程外文件操作同步执行, 其余等待返回错误
+    std::string text;
+    CHECK(Lcc::Await::ReadFile(loop, "/proc/self/stat", text) > 0);
+    CHECK(Lcc::Await::Sleep(loop, 1) == UV_EINVAL);
+
+    LoaderCoroutine loader(loop);
+    loader.Start(&env);
+    uv_run(loop, UV_RUN_DEFAULT);
+    CHECK(loader._done);
+    CHECK(loader.IsEnd());
+
+    std::vector<SleepCoroutine *> sleepers(kSleepers);
+    for (auto &co: sleepers) {
+        co = new SleepCoroutine(loop);
+    }
+    const size_t before = mallinfo2().uordblks;
+    const uint64_t begin = uv_hrtime();
+    for (auto co: sleepers) {
+        co->Start(&env);
+    }
+    uv_run(loop, UV_RUN_DEFAULT);
+    const double ms = static_cast<double>(uv_hrtime() - begin) / 1e6;
+    const size_t after = mallinfo2().uordblks;
+    unsigned long long wakes = 0;
+    for (auto co: sleepers) {
+        wakes += co->_wakes;
+        CHECK(co->IsEnd());
+    }
+    CHECK(wakes == 3ULL * kSleepers);
+    // 启动时分配libaco协程与保存栈, 之外的增长即为等待产生的堆分配
+    size_t saved = 0;
+    for (auto co: sleepers) {
+        saved += sizeof(aco_t) + co->SavedStackSize();
+    }
+    printf("sleepers %u: %llu wakes in %.1f ms, heap growth %.1f bytes/coroutine beyond aco objects\n", kSleepers,
+           wakes, ms, (static_cast<double>(after - before) - static_cast<double>(saved)) / kSleepers);
+    for (auto co: sleepers) {
+        delete co;
+    }
+
+    uv_fs_t req;
+    uv_fs_unlink(loop, &req, kPath, nullptr);
+    uv_fs_req_cleanup(&req);
+    env.Release();
+    uv_loop_close(loop);
+    if (_failed) {
+        printf("coroutine await fail %u\n", _failed);
+        return 1;
+    }
+    printf("coroutine await ok\n");
+    return 0;
+}
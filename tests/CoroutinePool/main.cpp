@@ -0,0 +1,134 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <uv.h>
+#include <coroutine/Coroutine.h>
+
+static const unsigned int kCount = 200000;
+
+/**
+ * 一次请求: 让出一次后结束
+ */
+class RequestCoroutine : public Lcc::Coroutine {
+protected:
+    void ICoroutineRun() override {
+        char frame[128];
+        memset(frame, 1, sizeof(frame));
+        Yield();
+        _sum += frame[0];
+    }
+
+public:
+    static unsigned long long _sum;
+};
+
+unsigned long long RequestCoroutine::_sum = 0;
+
+/**
+ * 常驻协程: 每次恢复使用一定深度的栈
+ */
+class DeepCoroutine : public Lcc::Coroutine {
+protected:
+    void ICoroutineRun() override {
+        char frame[2048];
+        memset(frame, 0, sizeof(frame));
+        for (;;) {
+            Yield();
+            ++frame[0];
+        }
+    }
+};
+
+static unsigned long long _rawSum = 0;
+
+static void RawRequest() {
+    char frame[128];
+    memset(frame, 1, sizeof(frame));
+    aco_yield();
+    _rawSum += frame[0];
+    aco_exit();
+}
+
+static void Report(const char *name, uint64_t begin, unsigned int count) {
+    const double seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+    printf("%-28s %10.0f ops/s %8.1f ns/op\n", name, count / seconds, seconds * 1e9 / count);
+}
+
+int main(int argc, char *argv[]) {
+    aco_thread_init(nullptr);
+    // 对照组: 每次请求aco_create/aco_destroy
+    {
+        aco_t *mainCo = aco_create(nullptr, nullptr, 0, nullptr, nullptr);
+        aco_share_stack_t *stack = aco_share_stack_new(0);
+        const uint64_t begin = uv_hrtime();
+        for (unsigned int n = 0; n < kCount; ++n) {
+            aco_t *co = aco_create(mainCo, stack, 0, RawRequest, nullptr);
+            aco_resume(co);
+            aco_resume(co);
+            aco_destroy(co);
+        }
+        Report("raw create/resume/destroy", begin, kCount);
+        aco_share_stack_destroy(stack);
+        aco_destroy(mainCo);
+    }
+    // 对象池: 协程对象和保存栈循环复用
+    {
+        Lcc::CoroutineEnv env;
+        env.Init();
+        const uint64_t begin = uv_hrtime();
+        for (unsigned int n = 0; n < kCount; ++n) {
+            RequestCoroutine co;
+            co.Start(&env);
+            co.Resume();
+        }
+        Report("pooled create/resume/destroy", begin, kCount);
+        const Lcc::CoroutineStats stats = env.GetStats();
+        printf("  created %llu reused %llu destroyed %llu pooled %llu (%llu bytes)\n", stats.created, stats.reused,
+               stats.destroyed, stats.pooled, stats.pooledBytes);
+        if (RequestCoroutine::_sum != kCount || stats.created != 1 || stats.live != 0) {
+            printf("pool mismatch\n");
+            return 1;
+        }
+    }
+    // 共享栈数量对栈拷贝的影响: 64个常驻协程交替恢复
+    const unsigned int stacks[] = {1, 4, 16, 64};
+    for (const unsigned int count: stacks) {
+        Lcc::CoroutineEnv env;
+        env.Init(0x10000, count);
+        std::vector<DeepCoroutine *> coroutines(64);
+        for (auto &co: coroutines) {
+            co = new DeepCoroutine;
+            co->Start(&env);
+        }
+        const unsigned int rounds = 2000;
+        const uint64_t begin = uv_hrtime();
+        for (unsigned int r = 0; r < rounds; ++r) {
+            for (auto co: coroutines) {
+                co->Resume();
+            }
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "resume 64 co on %u stacks", count);
+        Report(name, begin, rounds * 64);
+        size_t copies = 0;
+        for (auto co: coroutines) {
+            copies += co->StackCopies();
+        }
+        printf("  stack copies/resume %.2f, load per stack %u\n",
+               static_cast<double>(copies) / (rounds * 64.0), env.StackLoad(0));
+        if (env.StackLoad(0) != 64 / count) {
+            printf("stack spread mismatch\n");
+            return 1;
+        }
+        for (auto co: coroutines) {
+            delete co;
+        }
+        const Lcc::Utils::Histogram &saved = env.SavedStackHistogram();
+        printf("  saved stack p50 %llu p99 %llu max %llu bytes\n", saved.Percentile(50), saved.Percentile(99),
+               saved.Max());
+    }
+    return 0;
+}
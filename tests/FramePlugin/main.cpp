@@ -0,0 +1,288 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include <network/TcpServer.h>
+#include <network/plugin/FramePlugin.h>
+
+static const char *kHost = "tcp://127.0.0.1:18433";
+static const unsigned int kPort = 18433;
+static const size_t kStreamBytes = 0x2000000;
+static const size_t kChunk = 0x10000;
+static const unsigned int kSizes[] = {16, 64, 256, 1024};
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+static const char *HeaderName(Lcc::FrameHeader header) {
+    switch (header) {
+        case Lcc::FrameHeader::Fixed16:
+            return "fixed16";
+        case Lcc::FrameHeader::Fixed32:
+            return "fixed32";
+        default:
+            return "varint";
+    }
+}
+
+/**
+ * 生成帧流, 第n帧的数据字节均为n的低8位
+ */
+static std::string MakeStream(Lcc::FrameHeader header, unsigned int size, unsigned int count) {
+    std::string stream;
+    char head[Lcc::FramePlugin::kMaxHeadSize];
+    for (unsigned int n = 0; n < count; ++n) {
+        stream.append(head, Lcc::FramePlugin::EncodeHead(header, size, head));
+        stream.append(size, static_cast<char>(n));
+    }
+    return stream;
+}
+
+/**
+ * 不经过网络的插件宿主, 统计回调的帧
+ */
+class FrameSink : public Lcc::ProtocolImplement {
+public:
+    FrameSink() : _frames(0), _bytes(0), _bad(0), _closed(false) {
+    }
+
+    unsigned long long _frames;
+    unsigned long long _bytes;
+    unsigned long long _bad;
+    bool _closed;
+    std::string _written;
+
+    void IProtocolOpen(Lcc::ProtocolLevel streamLevel) override {
+    }
+
+    void IProtocolWrite(Lcc::ProtocolLevel streamLevel, const char *buf, unsigned int size) override {
+        _written.append(buf, size);
+    }
+
+    void IProtocolRead(Lcc::ProtocolLevel streamLevel, const char *buf, unsigned int size) override {
+        const auto expect = static_cast<char>(_frames);
+        if (size > 0 && (buf[0] != expect || buf[size - 1] != expect)) {
+            ++_bad;
+        }
+        ++_frames;
+        _bytes += size;
+    }
+
+    void IProtocolClose(Lcc::ProtocolLevel streamLevel) override {
+        _closed = true;
+    }
+};
+
+/**
+ * 帧头与帧体在任意位置被拆开时都能正确拼接
+ */
+static void SplitTest() {
+    const Lcc::FrameHeader headers[] = {Lcc::FrameHeader::Varint, Lcc::FrameHeader::Fixed16, Lcc::FrameHeader::Fixed32};
+    for (auto header: headers) {
+        std::string stream = MakeStream(header, 0, 2);
+        const std::string big = MakeStream(header, 300, 1);
+        stream.append(big);
+        for (size_t step = 1; step <= 7; ++step) {
+            FrameSink sink;
+            Lcc::FramePlugin plugin(header, 1024, &sink);
+            auto &proto = static_cast<Lcc::ProtocolPlugin &>(plugin);
+            for (size_t off = 0; off < stream.size(); off += step) {
+                const size_t len = std::min(step, stream.size() - off);
+                CHECK(proto.IProtocolPluginRead(stream.data() + off, static_cast<unsigned int>(len)));
+            }
+            CHECK(sink._frames == 3);
+            CHECK(sink._bytes == 300);
+            CHECK(!sink._closed);
+        }
+    }
+    // 超长帧与非法varint关闭连接
+    {
+        FrameSink sink;
+        Lcc::FramePlugin plugin(Lcc::FrameHeader::Fixed32, 100, &sink);
+        const std::string stream = MakeStream(Lcc::FrameHeader::Fixed32, 101, 1);
+        CHECK(!static_cast<Lcc::ProtocolPlugin &>(plugin).IProtocolPluginRead(stream.data(), 4));
+        CHECK(sink._closed);
+        CHECK(static_cast<Lcc::ProtocolPlugin &>(plugin).IProtocolLastError() == UV_E2BIG);
+    }
+    {
+        FrameSink sink;
+        Lcc::FramePlugin plugin(Lcc::FrameHeader::Varint, 100, &sink);
+        const char bad[] = {'\xff', '\xff', '\xff', '\xff', '\x7f'};
+        CHECK(!static_cast<Lcc::ProtocolPlugin &>(plugin).IProtocolPluginRead(bad, sizeof(bad)));
+        CHECK(sink._closed);
+    }
+    // 写入时添加长度头
+    {
+        FrameSink sink;
+        Lcc::FramePlugin plugin(Lcc::FrameHeader::Varint, 1024, &sink);
+        const std::string body(300, 'x');
+        static_cast<Lcc::ProtocolPlugin &>(plugin).IProtocolPluginWrite(body.data(), 300);
+        CHECK(sink._written.size() == 302);
+        CHECK(static_cast<unsigned char>(sink._written[0]) == 0xAC && sink._written[1] == 0x02);
+    }
+}
+
+/**
+ * 解析吞吐: 帧流按读缓冲区大小分块输入
+ */
+static void ParseBenchmark(Lcc::FrameHeader header, unsigned int size) {
+    char head[Lcc::FramePlugin::kMaxHeadSize];
+    const unsigned int count = static_cast<unsigned int>(kStreamBytes / (size + Lcc::FramePlugin::EncodeHead(header, size, head)));
+    const std::string stream = MakeStream(header, size, count);
+    FrameSink sink;
+    Lcc::FramePlugin plugin(header, 0x10000, &sink);
+    auto &proto = static_cast<Lcc::ProtocolPlugin &>(plugin);
+    const uint64_t begin = uv_hrtime();
+    for (size_t off = 0; off < stream.size(); off += kChunk) {
+        proto.IProtocolPluginRead(stream.data() + off, static_cast<unsigned int>(std::min(kChunk, stream.size() - off)));
+    }
+    const double seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+    CHECK(sink._frames == count);
+    CHECK(sink._bad == 0);
+    printf("parse %-7s %4u bytes: %10.0f msg/s %8.1f MB/s, direct %.1f%%\n", HeaderName(header), size,
+           count / seconds, stream.size() / seconds / 1e6, 100.0 * plugin.DirectFrames() / count);
+}
+
+/**
+ * 回环连接上的服务端分帧吞吐
+ */
+class FrameServer : public Lcc::TcpServer, public Lcc::ServerImplement {
+public:
+    explicit FrameServer(uv_loop_t *loop) : TcpServer(this), _loop(loop), _listen(0), _frames(0), _bad(0),
+                                            _target(0), _closed(0) {
+    }
+
+    uv_loop_t *_loop;
+    int _listen;
+    unsigned long long _frames;
+    unsigned long long _bad;
+    unsigned long long _target;
+    unsigned int _closed;
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : -1;
+    }
+
+    void IServerShutdown() override {
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        const auto expect = static_cast<char>(_frames);
+        if (size == 0 || buf[0] != expect || buf[size - 1] != expect) {
+            ++_bad;
+        }
+        if (++_frames == _target) {
+            SessionWrite(session, "done", 4);
+        }
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        ++_closed;
+    }
+};
+
+struct Client {
+    uv_tcp_t tcp;
+    uv_connect_t connect;
+    bool connected;
+    std::string reply;
+    char buffer[256];
+};
+
+static void RunUntil(uv_loop_t *loop, bool (*done)(void *), void *arg) {
+    while (!done(arg)) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+}
+
+static void LoopbackBenchmark(uv_loop_t *loop, Lcc::FrameHeader header, unsigned int size) {
+    FrameServer server(loop);
+    auto creator = new Lcc::FramePluginCreator;
+    creator->Initialize(header, 0x10000);
+    server.Enable(creator);
+    server.Listen(kHost);
+    RunUntil(loop, [](void *arg) { return static_cast<FrameServer *>(arg)->_listen != 0; }, &server);
+    CHECK(server._listen > 0);
+
+    char head[Lcc::FramePlugin::kMaxHeadSize];
+    const unsigned int count = static_cast<unsigned int>(kStreamBytes / (size + Lcc::FramePlugin::EncodeHead(header, size, head)));
+    const std::string stream = MakeStream(header, size, count);
+    server._target = count;
+
+    Client client{};
+    uv_tcp_init(loop, &client.tcp);
+    client.tcp.data = &client;
+    client.connect.data = &client;
+    sockaddr_in addr{};
+    uv_ip4_addr("127.0.0.1", kPort, &addr);
+    uv_tcp_connect(&client.connect, &client.tcp, reinterpret_cast<const sockaddr *>(&addr), [](uv_connect_t *req, int status) {
+        static_cast<Client *>(req->data)->connected = status == 0;
+    });
+    RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->connected; }, &client);
+    uv_read_start(reinterpret_cast<uv_stream_t *>(&client.tcp), [](uv_handle_t *handle, size_t, uv_buf_t *buf) {
+        auto client = static_cast<Client *>(handle->data);
+        *buf = uv_buf_init(client->buffer, sizeof(client->buffer));
+    }, [](uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf) {
+        if (nread > 0) {
+            static_cast<Client *>(stream->data)->reply.append(buf->base, nread);
+        }
+    });
+
+    const uint64_t begin = uv_hrtime();
+    std::vector<uv_write_t> reqs((stream.size() + kChunk - 1) / kChunk);
+    for (size_t n = 0; n < reqs.size(); ++n) {
+        const size_t off = n * kChunk;
+        uv_buf_t buf = uv_buf_init(const_cast<char *>(stream.data() + off),
+                                   static_cast<unsigned int>(std::min(kChunk, stream.size() - off)));
+        uv_write(&reqs[n], reinterpret_cast<uv_stream_t *>(&client.tcp), &buf, 1, nullptr);
+    }
+    RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->reply.size() >= 5; }, &client);
+    const double seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+    CHECK(server._frames == count);
+    CHECK(server._bad == 0);
+    CHECK(client.reply == std::string(head, Lcc::FramePlugin::EncodeHead(header, 4, head)) + "done");
+    printf("tcp   %-7s %4u bytes: %10.0f msg/s %8.1f MB/s\n", HeaderName(header), size, count / seconds,
+           stream.size() / seconds / 1e6);
+
+    uv_close(reinterpret_cast<uv_handle_t *>(&client.tcp), nullptr);
+    RunUntil(loop, [](void *arg) { return static_cast<FrameServer *>(arg)->_closed > 0; }, &server);
+    server.Shutdown();
+    uv_run(loop, UV_RUN_DEFAULT);
+}
+
+int main(int argc, char *argv[]) {
+    SplitTest();
+    const Lcc::FrameHeader headers[] = {Lcc::FrameHeader::Varint, Lcc::FrameHeader::Fixed16, Lcc::FrameHeader::Fixed32};
+    for (auto header: headers) {
+        for (auto size: kSizes) {
+            ParseBenchmark(header, size);
+        }
+    }
+    uv_loop_t *loop = uv_default_loop();
+    for (auto size: kSizes) {
+        LoopbackBenchmark(loop, Lcc::FrameHeader::Varint, size);
+    }
+    uv_loop_close(loop);
+    if (_failed) {
+        printf("frame plugin fail %u\n", _failed);
+        return 1;
+    }
+    printf("frame plugin ok\n");
+    return 0;
+}
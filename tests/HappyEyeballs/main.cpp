@@ -0,0 +1,287 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <uv.h>
+#include <network/Resolver.h>
+#include <network/TcpClient.h>
+#include <network/TcpServer.h>
+
+static const int kPort = 18436;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+static Lcc::ResolvedAddress Address(const char *ip) {
+    Lcc::ResolvedAddress address{};
+    Lcc::Resolver::ParseLiteral(ip, address);
+    return address;
+}
+
+/**
+ * 黑洞地址: 监听队列为0且已被占满的套接字, 之后的连接收不到SYN-ACK, 一直停在连接中
+ */
+class Blackhole {
+public:
+    explicit Blackhole(const char *ip) {
+        sockaddr_in addr{};
+        uv_ip4_addr(ip, kPort, &addr);
+        _listen = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(_listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        _ok = bind(_listen, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0 && listen(_listen, 0) == 0;
+        for (int n = 0; _ok && n < 2; ++n) {
+            const int fd = socket(AF_INET, SOCK_STREAM, 0);
+            fcntl(fd, F_SETFL, O_NONBLOCK);
+            connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            _fillers.push_back(fd);
+        }
+        uv_sleep(20);
+    }
+
+    ~Blackhole() {
+        for (auto fd: _fillers) {
+            close(fd);
+        }
+        close(_listen);
+    }
+
+    bool _ok;
+
+private:
+    int _listen;
+    std::vector<int> _fillers;
+};
+
+class EchoServer : public Lcc::TcpServer, public Lcc::ServerImplement {
+public:
+    explicit EchoServer(uv_loop_t *loop) : TcpServer(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    int _listen = 0;
+    int _sessions = 0;
+    unsigned int _opened = 0;
+    bool _shutdown = false;
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : err;
+    }
+
+    void IServerShutdown() override {
+        _shutdown = true;
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        ++_sessions;
+        ++_opened;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        SessionWrite(session, buf, size);
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        --_sessions;
+    }
+};
+
+class Client : public Lcc::TcpClient, public Lcc::ClientImplement {
+public:
+    explicit Client(uv_loop_t *loop) : TcpClient(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    int _connected = 0;
+    int _reports = 0;
+    bool _disconnected = false;
+    std::string _error;
+    std::string _received;
+
+    bool IClientInit(Lcc::StreamHandle &handle) override {
+        handle.tcpSession = 1;
+        return handle.Init(_loop) == 0;
+    }
+
+    void IClientReport(bool connected, const char *err) override {
+        ++_reports;
+        _connected = connected ? 1 : -1;
+        _error = err ? err : "";
+    }
+
+    void IClientReceive(const char *buf, unsigned int size) override {
+        _received.append(buf, size);
+    }
+
+    void IClientBeforeDisconnect(int err, const char *errMsg) override {
+    }
+
+    void IClientAfterDisconnect() override {
+        _disconnected = true;
+    }
+};
+
+static uv_timer_t _ticker;
+
+static bool RunUntil(uv_loop_t *loop, bool (*done)(void *), void *arg, uint64_t timeout = 5000) {
+    const uint64_t deadline = uv_now(loop) + timeout;
+    while (!done(arg)) {
+        if (uv_now(loop) > deadline) {
+            return false;
+        }
+        uv_run(loop, UV_RUN_ONCE);
+    }
+    return true;
+}
+
+static void RunFor(uv_loop_t *loop, uint64_t time) {
+    const uint64_t deadline = uv_now(loop) + time;
+    while (uv_now(loop) < deadline) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+}
+
+/**
+ * 连接并回显一次, 返回从发起连接到连上的毫秒数, 失败时返回-1
+ */
+static long ConnectEcho(uv_loop_t *loop, Client &client, const char *host) {
+    const uint64_t begin = uv_now(loop);
+    client.Connect(host);
+    if (!RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_connected != 0; }, &client) ||
+        client._connected != 1) {
+        return -1;
+    }
+    const long elapsed = static_cast<long>(uv_now(loop) - begin);
+    client.Write("ping", 4);
+    RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_received.size() >= 4; }, &client);
+    CHECK(client._received == "ping");
+    client.Shutdown();
+    RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_disconnected; }, &client);
+    return elapsed;
+}
+
+static std::string Host(const char *name) {
+    return std::string("tcp://") + name + ":" + std::to_string(kPort);
+}
+
+int main(int argc, char *argv[]) {
+    uv_loop_t *loop = uv_default_loop();
+    // 保持循环每10毫秒醒一次, 等待停在连接中的尝试时也能检查超时
+    uv_timer_init(loop, &_ticker);
+    uv_timer_start(&_ticker, [](uv_timer_t *) {}, 10, 10);
+    auto &resolver = Lcc::Resolver::Local();
+
+    EchoServer server(loop);
+    server.Listen(Host("127.0.0.1").c_str());
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_listen != 0; }, &server);
+    CHECK(server._listen == 1);
+    EchoServer server6(loop);
+    server6.Listen(Host("[::1]").c_str());
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_listen != 0; }, &server6);
+    Blackhole blackhole2("127.0.0.2");
+    Blackhole blackhole4("127.0.0.4");
+    CHECK(blackhole2._ok && blackhole4._ok);
+
+    // 第一个地址是黑洞: 间隔后向第二个地址发起尝试并胜出
+    {
+        resolver.Pin("blackhole.lcc", {Address("127.0.0.2"), Address("127.0.0.1")});
+        Client client(loop);
+        client.SetAttemptDelay(100);
+        const long elapsed = ConnectEcho(loop, client, Host("blackhole.lcc").c_str());
+        printf("blackhole first: connected in %ld ms\n", elapsed);
+        CHECK(elapsed >= 90 && elapsed < 1000);
+        CHECK(client._reports == 1);
+    }
+    // 第一个地址拒绝连接: 不等间隔立即尝试下一个
+    {
+        resolver.Pin("refused.lcc", {Address("127.0.0.3"), Address("127.0.0.1")});
+        Client client(loop);
+        client.SetAttemptDelay(5000);
+        const long elapsed = ConnectEcho(loop, client, Host("refused.lcc").c_str());
+        printf("refused first: connected in %ld ms\n", elapsed);
+        CHECK(elapsed >= 0 && elapsed < 1000);
+    }
+    // 协议族交替: 两个IPv4黑洞之后的IPv6地址排在第二个尝试
+    if (server6._listen == 1) {
+        resolver.Pin("interleave.lcc", {Address("127.0.0.2"), Address("127.0.0.4"), Address("::1")});
+        Client client(loop);
+        client.SetAttemptDelay(300);
+        const long elapsed = ConnectEcho(loop, client, Host("interleave.lcc").c_str());
+        printf("interleave: connected in %ld ms\n", elapsed);
+        CHECK(elapsed >= 290 && elapsed < 550);
+    } else {
+        printf("ipv6 loopback unavailable, interleave skipped\n");
+    }
+    // 全部黑洞: 连接超时报告失败, 客户端之后可以再次连接
+    {
+        resolver.Pin("timeout.lcc", {Address("127.0.0.2"), Address("127.0.0.4")});
+        Client client(loop);
+        client.SetAttemptDelay(50);
+        client.SetConnectTimeout(300);
+        const uint64_t begin = uv_now(loop);
+        client.Connect(Host("timeout.lcc").c_str());
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_connected != 0; }, &client));
+        const uint64_t elapsed = uv_now(loop) - begin;
+        printf("all blackholed: failed in %llu ms (%s)\n", static_cast<unsigned long long>(elapsed), client._error.c_str());
+        CHECK(client._connected == -1);
+        CHECK(client._error == uv_strerror(UV_ETIMEDOUT));
+        CHECK(elapsed >= 290 && elapsed < 1000);
+        RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->GetSession() == 0; }, &client);
+        RunFor(loop, 100);
+        CHECK(client._reports == 1);
+        client._connected = 0;
+        CHECK(ConnectEcho(loop, client, Host("127.0.0.1").c_str()) >= 0);
+    }
+    // 单个地址同样受超时限制
+    {
+        Client client(loop);
+        client.SetConnectTimeout(200);
+        client.Connect(Host("127.0.0.2").c_str());
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_connected != 0; }, &client));
+        CHECK(client._connected == -1 && client._error == uv_strerror(UV_ETIMEDOUT));
+        RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->GetSession() == 0; }, &client);
+        RunFor(loop, 50);
+        CHECK(client._reports == 1);
+    }
+    // 竞速中关闭: 取消全部尝试, 不再回调
+    {
+        resolver.Pin("shutdown.lcc", {Address("127.0.0.2"), Address("127.0.0.4")});
+        auto client = new Client(loop);
+        client->SetAttemptDelay(50);
+        client->Connect(Host("shutdown.lcc").c_str());
+        RunFor(loop, 120);
+        client->Shutdown();
+        RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->GetSession() == 0; }, client);
+        RunFor(loop, 50);
+        CHECK(client->_reports == 0);
+        delete client;
+    }
+
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server);
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server6);
+    CHECK(server._opened + server6._opened == (server6._listen == 1 ? 4u : 3u));
+    server.Shutdown();
+    server6.Shutdown();
+    uv_close(reinterpret_cast<uv_handle_t *>(&_ticker), nullptr);
+    uv_run(loop, UV_RUN_DEFAULT);
+    CHECK(uv_loop_close(loop) == 0);
+    if (_failed) {
+        printf("happy eyeballs fail %u\n", _failed);
+        return 1;
+    }
+    printf("happy eyeballs ok\n");
+    return 0;
+}
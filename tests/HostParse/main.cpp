@@ -0,0 +1,287 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <utils/Address.h>
+#include <legacy/HostParse.h>
+
+static unsigned int _failed = 0;
+static unsigned long _allocs = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+void *operator new(size_t size) {
+    ++_allocs;
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    free(ptr);
+}
+
+using Lcc::Utils::HostAddress;
+using Lcc::Utils::HostProtocol;
+
+static const char *SchemeName(const HostAddress &addr) {
+    switch (addr.protocol) {
+        case HostProtocol::Http:
+            return addr.ssl ? "https" : "http";
+        case HostProtocol::Websocket:
+            return addr.ssl ? "wss" : "ws";
+        case HostProtocol::Unix:
+            return "unix";
+        case HostProtocol::Shm:
+            return "shm";
+        case HostProtocol::Udp:
+            return "udp";
+        default:
+            return "tcp";
+    }
+}
+
+/**
+ * 按解析结果重新拼出地址
+ */
+static std::string Format(const HostAddress &addr) {
+    std::string url(SchemeName(addr));
+    url.append("://");
+    if (addr.protocol == HostProtocol::Unix || addr.protocol == HostProtocol::Shm) {
+        return url.append(addr.path);
+    }
+    if (addr.v6) {
+        url.append("[").append(addr.host).append("]");
+    } else {
+        url.append(addr.host);
+    }
+    url.append(":").append(std::to_string(addr.port)).append(addr.path);
+    return url;
+}
+
+static bool Same(const HostAddress &a, const HostAddress &b) {
+    return a.v6 == b.v6 && a.ssl == b.ssl && a.port == b.port && a.protocol == b.protocol &&
+           strcmp(a.host, b.host) == 0 && strcmp(a.path, b.path) == 0;
+}
+
+struct Case {
+    const char *url;
+    bool ok;
+    HostProtocol protocol;
+    bool ssl;
+    bool v6;
+    int port;
+    const char *host;
+    const char *path;
+};
+
+static const Case kCases[] = {
+    {"tcp://127.0.0.1:8080", true, HostProtocol::Tcp, false, false, 8080, "127.0.0.1", "/"},
+    {"TCP://localhost:1", true, HostProtocol::Tcp, false, false, 1, "localhost", "/"},
+    {"tcp://host:0", true, HostProtocol::Tcp, false, false, 0, "host", "/"},
+    {"tcp://host:65535", true, HostProtocol::Tcp, false, false, 65535, "host", "/"},
+    {"http://www.example.com", true, HostProtocol::Http, false, false, 80, "www.example.com", "/"},
+    {"https://www.example.com", true, HostProtocol::Http, true, false, 443, "www.example.com", "/"},
+    {"ws://gate", true, HostProtocol::Websocket, false, false, 80, "gate", "/"},
+    {"wss://gate.example.com:8443/chat?room=1", true, HostProtocol::Websocket, true, false, 8443,
+     "gate.example.com", "/chat?room=1"},
+    {"HtTpS://a_b-c.d?x=1", true, HostProtocol::Http, true, false, 443, "a_b-c.d", "?x=1"},
+    {"tcp://[::1]:9000", true, HostProtocol::Tcp, false, true, 9000, "::1", "/"},
+    {"wss://[fe80::1:2]/ws", true, HostProtocol::Websocket, true, true, 443, "fe80::1:2", "/ws"},
+    {"ws://[::ffff:127.0.0.1]:80", true, HostProtocol::Websocket, false, true, 80, "::ffff:127.0.0.1", "/"},
+    {"unix:///tmp/lcc.sock", true, HostProtocol::Unix, false, false, 0, "", "/tmp/lcc.sock"},
+    {"UNIX://run/game:1.sock", true, HostProtocol::Unix, false, false, 0, "", "run/game:1.sock"},
+    {"unix://", false},
+    {"unix:///tmp/a\nb", false},
+    {"shm:///tmp/lcc-shm.sock", true, HostProtocol::Shm, false, false, 0, "", "/tmp/lcc-shm.sock"},
+    {"shm://", false},
+    {"tcp://host", false},
+    {"tcp://host:", false},
+    {"tcp://host:65536", false},
+    {"tcp://host:123456", false},
+    {"tcp://host:80x", false},
+    {"tcp://:80", false},
+    {"tcp://[]:80", false},
+    {"tcp://[127.0.0.1]:80", false},
+    {"tcp://[::1:80", false},
+    {"tcp://[::g]:80", false},
+    {"tcp://user@host:80", false},
+    {"udp://host:80", true, HostProtocol::Udp, false, false, 80, "host", "/"},
+    {"udp://host", false},
+    {"httpss://host", false},
+    {"http:/host", false},
+    {"http//host", false},
+    {"://host:80", false},
+    {"http://host/a b", false},
+    {"http://host:80 ", false},
+    {"", false},
+};
+
+static void TestCases() {
+    for (const auto &c: kCases) {
+        HostAddress addr{};
+        const bool ok = Lcc::Utils::HostParse(c.url, addr);
+        if (ok != c.ok) {
+            printf("case %s expect %d\n", c.url, c.ok);
+        }
+        CHECK(ok == c.ok);
+        if (!ok || !c.ok) {
+            continue;
+        }
+        CHECK(addr.protocol == c.protocol);
+        CHECK(addr.ssl == c.ssl);
+        CHECK(addr.v6 == c.v6);
+        CHECK(addr.port == c.port);
+        CHECK(strcmp(addr.host, c.host) == 0);
+        CHECK(strcmp(addr.path, c.path) == 0);
+        CHECK(addr.ip[0] == '\0');
+    }
+    HostAddress addr{};
+    CHECK(!Lcc::Utils::HostParse(nullptr, addr));
+    // 长度参数之外的字节不参与解析
+    CHECK(Lcc::Utils::HostParse("tcp://host:80garbage", 13, addr));
+    CHECK(addr.port == 80 && strcmp(addr.host, "host") == 0);
+    // 主机最长127字节, 路径最长255字节
+    std::string host(127, 'a');
+    CHECK(Lcc::Utils::HostParse("tcp://" + host + ":1", addr));
+    CHECK(!Lcc::Utils::HostParse("tcp://" + host + "a:1", addr));
+    std::string path = "/" + std::string(254, 'p');
+    CHECK(Lcc::Utils::HostParse("ws://h" + path, addr));
+    CHECK(!Lcc::Utils::HostParse("ws://h" + path + "p", addr));
+    CHECK(Lcc::Utils::HostParse("unix://" + path, addr));
+    CHECK(!Lcc::Utils::HostParse("unix://" + path + "p", addr));
+    // 失败时不修改输出
+    HostAddress before = addr;
+    CHECK(!Lcc::Utils::HostParse("ws://h:99999", addr));
+    CHECK(memcmp(&before, &addr, sizeof(addr)) == 0);
+}
+
+static void TestNoAlloc() {
+    HostAddress addr{};
+    const unsigned long allocs = _allocs;
+    for (const auto &c: kCases) {
+        Lcc::Utils::HostParse(c.url, addr);
+    }
+    CHECK(_allocs == allocs);
+}
+
+/**
+ * 随机输入与变异输入: 不越界, 成功时结果合法且能原样往返
+ */
+static void TestFuzz() {
+    static const char alphabet[] = "tcphtpswTCPWS:/[]?@.-_0123456789abcdefxyz: #%\x01\xff";
+    static const char *seeds[] = {
+        "tcp://127.0.0.1:8080", "wss://gate.example.com:443/path?q", "http://[::1]:80/", "ws://h",
+    };
+    std::mt19937 rng(20261019);
+    char buffer[512];
+    unsigned int parsed = 0;
+    for (unsigned int round = 0; round < 200000; ++round) {
+        size_t size;
+        if (round & 1) {
+            size = rng() % 64;
+            for (size_t n = 0; n < size; ++n) {
+                buffer[n] = alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+        } else {
+            const char *seed = seeds[rng() % (sizeof(seeds) / sizeof(seeds[0]))];
+            size = strlen(seed);
+            memcpy(buffer, seed, size);
+            const unsigned int mutations = 1 + rng() % 3;
+            for (unsigned int m = 0; m < mutations && size > 0; ++m) {
+                const size_t at = rng() % size;
+                switch (rng() % 3) {
+                    case 0:
+                        buffer[at] = alphabet[rng() % (sizeof(alphabet) - 1)];
+                        break;
+                    case 1:
+                        memmove(buffer + at, buffer + at + 1, size - at - 1);
+                        --size;
+                        break;
+                    default:
+                        memmove(buffer + at + 1, buffer + at, size - at);
+                        buffer[at] = alphabet[rng() % (sizeof(alphabet) - 1)];
+                        ++size;
+                        break;
+                }
+            }
+        }
+        HostAddress addr;
+        memset(&addr, 0x5a, sizeof(addr));
+        const HostAddress before = addr;
+        if (!Lcc::Utils::HostParse(buffer, size, addr)) {
+            CHECK(memcmp(&before, &addr, sizeof(addr)) == 0);
+            continue;
+        }
+        ++parsed;
+        const size_t hostSize = strnlen(addr.host, sizeof(addr.host));
+        const size_t pathSize = strnlen(addr.path, sizeof(addr.path));
+        CHECK(hostSize > 0 && hostSize < sizeof(addr.host));
+        CHECK(pathSize > 0 && pathSize < sizeof(addr.path));
+        CHECK(addr.path[0] == '/' || addr.path[0] == '?');
+        CHECK(addr.port >= 0 && addr.port <= 0xffff);
+        HostAddress again{};
+        CHECK(Lcc::Utils::HostParse(Format(addr), again));
+        CHECK(Same(addr, again));
+    }
+    CHECK(parsed > 1000);
+}
+
+/**
+ * 规范形式 协议://主机:端口 与原正则实现的结果一致
+ */
+static void TestDifferential() {
+    static const char *schemes[] = {"tcp", "http", "https", "ws", "wss"};
+    static const char hostChars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_.";
+    std::mt19937 rng(7);
+    for (unsigned int round = 0; round < 3000; ++round) {
+        std::string url(schemes[rng() % 5]);
+        url.append("://");
+        if (rng() % 2) {
+            for (unsigned int n = 0; n < 4; ++n) {
+                url.append(n ? "." : "").append(std::to_string(rng() % 256));
+            }
+        } else {
+            const unsigned int size = 1 + rng() % 24;
+            for (unsigned int n = 0; n < size; ++n) {
+                url.push_back(hostChars[rng() % (sizeof(hostChars) - 1)]);
+            }
+        }
+        url.append(":").append(std::to_string(10 + rng() % 65526));
+        HostAddress expect{};
+        HostAddress actual{};
+        const bool expectOk = Legacy::HostParse(std::string(url), expect);
+        const bool actualOk = Lcc::Utils::HostParse(url, actual);
+        CHECK(expectOk && actualOk);
+        if (expectOk && actualOk) {
+            CHECK(expect.protocol == actual.protocol);
+            CHECK(expect.ssl == actual.ssl);
+            CHECK(expect.port == actual.port);
+            CHECK(strcmp(expect.host, actual.host) == 0);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    TestCases();
+    TestNoAlloc();
+    TestFuzz();
+    TestDifferential();
+    if (_failed) {
+        printf("host parse fail %u\n", _failed);
+        return 1;
+    }
+    printf("host parse ok\n");
+    return 0;
+}
@@ -0,0 +1,171 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include <thread/Thread.h>
+#include <metrics/Metrics.h>
+#include <metrics/LoopMetrics.h>
+#include <metrics/LoopWatchdog.h>
+
+static const unsigned int kThreshold = 50;
+static const unsigned int kBlock = 200;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+/**
+ * 模拟同步阻塞的处理函数
+ */
+static void __attribute__((noinline)) BlockFor(unsigned int ms) {
+    const uint64_t end = uv_hrtime() + ms * 1000000ULL;
+    while (uv_hrtime() < end) {
+    }
+}
+
+class StallThread final : public Lcc::Thread {
+protected:
+    bool IInit() override {
+        return true;
+    }
+
+    void IMessage(void *message) override {
+        BlockFor(kBlock);
+    }
+
+    void IShutdown() override {
+    }
+};
+
+class IdleThread final : public Lcc::Thread {
+protected:
+    bool IInit() override {
+        return true;
+    }
+
+    void IMessage(void *message) override {
+    }
+
+    void IShutdown() override {
+    }
+};
+
+static bool Contains(const std::string &text, const std::string &needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+/**
+ * 读取导出文本中某个序列的值
+ * @return 值, 不存在时为-1
+ */
+static long long SeriesValue(const std::string &text, const std::string &series) {
+    const size_t pos = text.find(series + " ");
+    return pos == std::string::npos ? -1 : std::stoll(text.substr(pos + series.size() + 1));
+}
+
+static void TestLoopLag() {
+    uv_loop_t loop;
+    uv_loop_init(&loop);
+    Lcc::Metrics::LoopMetrics metrics;
+    CHECK(metrics.Attach(&loop, "lag"));
+    CHECK(metrics.GetName() == "lag");
+
+    // 首轮poll之后定时器回调阻塞20ms, 之后再空转几轮
+    uv_timer_t timer;
+    uv_timer_init(&loop, &timer);
+    int fired = 0;
+    timer.data = &fired;
+    uv_timer_start(&timer, [](uv_timer_t *handle) {
+        if (++*static_cast<int *>(handle->data) == 1) {
+            BlockFor(20);
+        } else if (*static_cast<int *>(handle->data) == 5) {
+            uv_timer_stop(handle);
+        }
+    }, 10, 1);
+    uv_run(&loop, UV_RUN_DEFAULT);
+    CHECK(fired == 5);
+    metrics.Detach();
+    uv_close(reinterpret_cast<uv_handle_t *>(&timer), nullptr);
+    uv_run(&loop, UV_RUN_DEFAULT);
+    CHECK(uv_loop_close(&loop) == 0);
+
+    std::string text;
+    Lcc::Metrics::Registry::Instance().Export(text);
+    CHECK(Contains(text, "# TYPE lcc_loop_lag_seconds histogram\n"));
+    CHECK(Contains(text, "lcc_loop_callback_seconds_count{loop=\"lag\",phase=\"io\"} "));
+    CHECK(Contains(text, "lcc_loop_callback_seconds_count{loop=\"lag\",phase=\"timers\"} "));
+    // 20ms的阻塞落在(16.7ms, 33.5ms]分组, 之前的分组不包含全部迭代
+    const long long total = SeriesValue(text, "lcc_loop_lag_seconds_count{loop=\"lag\"}");
+    const long long below = SeriesValue(text, "lcc_loop_lag_seconds_bucket{loop=\"lag\",le=\"0.016777215\"}");
+    CHECK(total >= 3);
+    CHECK(below + 1 == total);
+    printf("loop lag ok\n");
+}
+
+static void TestStall() {
+    auto &watchdog = Lcc::Metrics::LoopWatchdog::Instance();
+    Lcc::Metrics::WatchdogOptions options;
+    options.threshold = kThreshold;
+    CHECK(watchdog.Start(options));
+    CHECK(watchdog.Running());
+    CHECK(!watchdog.Start(options));
+
+    StallThread stall;
+    Lcc::ThreadOptions threadOptions;
+    threadOptions.name = "stall-worker";
+    CHECK(stall.Startup(threadOptions));
+    CHECK(stall.GetLoopName() == "stall-worker");
+    IdleThread idle;
+    CHECK(idle.Startup());
+    CHECK(idle.GetLoopName().compare(0, 7, "thread-") == 0);
+
+    // 空闲的循环阻塞在poll中, 不应被判为卡顿
+    uv_sleep(kThreshold * 3);
+    std::vector<Lcc::Metrics::StallSample> samples;
+    watchdog.GetSamples(samples);
+    CHECK(samples.empty());
+
+    stall.QueueMessage(nullptr);
+    uv_sleep(kBlock + kThreshold * 2);
+    watchdog.GetSamples(samples);
+    CHECK(samples.size() == 1);
+    if (samples.size() == 1) {
+        CHECK(samples[0].loop == "stall-worker");
+        CHECK(samples[0].duration >= kThreshold * 1000000ULL);
+        CHECK(samples[0].timestamp > 0);
+        CHECK(!samples[0].frames.empty());
+        printf("stall sample: %zu frames\n", samples[0].frames.size());
+    }
+    std::string dump;
+    watchdog.Export(dump);
+    CHECK(Contains(dump, "loop=stall-worker "));
+
+    stall.Shutdown();
+    idle.Shutdown();
+    watchdog.Stop();
+    CHECK(!watchdog.Running());
+
+    std::string text;
+    Lcc::Metrics::Registry::Instance().Export(text);
+    CHECK(Contains(text, "lcc_loop_stalls_total{loop=\"stall-worker\"} 1\n"));
+    CHECK(Contains(text, "lcc_loop_stall_seconds_count{loop=\"stall-worker\"} 1\n"));
+    CHECK(SeriesValue(text, "lcc_loop_iterations_total{loop=\"" + idle.GetLoopName() + "\"}") >= 0);
+
+    // 线程重启后复用同名指标
+    CHECK(stall.Startup(threadOptions));
+    stall.Shutdown();
+    std::string again;
+    Lcc::Metrics::Registry::Instance().Export(again);
+    CHECK(again.find("lcc_loop_stalls_total{loop=\"stall-worker\"}") ==
+          again.rfind("lcc_loop_stalls_total{loop=\"stall-worker\"}"));
+    printf("stall ok\n");
+}
+
+int main(int argc, char *argv[]) {
+    TestLoopLag();
+    TestStall();
+    return _failed ? 1 : 0;
+}
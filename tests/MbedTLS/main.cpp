@@ -0,0 +1,247 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include <network/TcpClient.h>
+#include <network/TcpServer.h>
+#include <network/plugin/MbedTLSPlugin.h>
+
+static const char *kHost = "tcp://127.0.0.1:18438";
+static const char *kLegacyHost = "tcp://127.0.0.1:18439";
+static const char *kCert = LCC_TEST_CERT_DIR "/server.crt";
+static const char *kKey = LCC_TEST_CERT_DIR "/server.key";
+
+static unsigned int _failed = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("check fail: %s (line %d)\n", #cond, __LINE__); ++_failed; } } while (0)
+
+static void RunUntil(uv_loop_t *loop, const std::function<bool()> &done) {
+    const uint64_t deadline = uv_hrtime() + 10000000000ULL;
+    while (!done() && uv_hrtime() < deadline) {
+        uv_run(loop, UV_RUN_NOWAIT);
+    }
+}
+
+class EchoServer : public Lcc::TcpServer, public Lcc::ServerImplement {
+public:
+    explicit EchoServer(uv_loop_t *loop) : TcpServer(this), _loop(loop), listen(0), sessions(0), stopped(false) {
+    }
+
+    uv_loop_t *_loop;
+    int listen;
+    int sessions;
+    bool stopped;
+
+protected:
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        listen = listened ? 1 : -1;
+    }
+
+    void IServerShutdown() override {
+        stopped = true;
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        ++sessions;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        SessionWrite(session, buf, size);
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        --sessions;
+    }
+};
+
+/**
+ * 连接后发送一条消息, 收到完整回显即完成
+ */
+class EchoClient : public Lcc::ClientImplement {
+public:
+    explicit EchoClient(uv_loop_t *loop) : client(this), _loop(loop), connected(false), failed(false),
+                                           closed(false), _message("tls echo") {
+    }
+
+    void Connect(const char *host = kHost, mbedtls_ssl_protocol_version maxVersion = MBEDTLS_SSL_VERSION_UNKNOWN) {
+        auto ssl = new Lcc::MbedTLSPluginCreator;
+        ssl->SetMaxVersion(maxVersion);
+        ssl->InitializeClientMode("127.0.0.1", kCert);
+        client.Enable(ssl);
+        client.Connect(host);
+    }
+
+    bool Echoed() const {
+        return received == _message;
+    }
+
+    Lcc::TcpClient client;
+
+protected:
+    bool IClientInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IClientReport(bool ok, const char *err) override {
+        connected = ok;
+        failed = !ok;
+        if (ok) {
+            client.Write(_message.data(), static_cast<unsigned int>(_message.size()));
+        }
+    }
+
+    void IClientReceive(const char *buf, unsigned int size) override {
+        received.append(buf, size);
+    }
+
+    void IClientBeforeDisconnect(int err, const char *errMsg) override {
+        failed = failed || !Echoed();
+    }
+
+    void IClientAfterDisconnect() override {
+        closed = true;
+    }
+
+private:
+    uv_loop_t *_loop;
+
+public:
+    bool connected;
+    bool failed;
+    bool closed;
+    std::string received;
+
+private:
+    std::string _message;
+};
+
+/**
+ * PSA是进程级状态: 一个连接关闭时不能清掉其他连接正在握手所用的密钥
+ * 所有连接同时握手, 先完成回显的立即关闭, 其余连接此时仍在握手中
+ */
+static void LifecycleTest(uv_loop_t *loop, EchoServer &server) {
+    const unsigned int count = 8;
+    std::vector<EchoClient *> clients;
+    for (unsigned int n = 0; n < count; ++n) {
+        clients.push_back(new EchoClient(loop));
+        clients.back()->Connect();
+    }
+    RunUntil(loop, [&] {
+        bool done = true;
+        for (auto client: clients) {
+            if (client->Echoed() && !client->closed) {
+                client->client.Shutdown();
+            }
+            done = done && (client->closed || client->failed);
+        }
+        return done;
+    });
+    unsigned int echoed = 0;
+    for (auto client: clients) {
+        echoed += client->Echoed() ? 1 : 0;
+        client->client.Shutdown();
+    }
+    CHECK(echoed == count);
+    for (auto client: clients) {
+        RunUntil(loop, [&] { return client->closed; });
+        delete client;
+    }
+    RunUntil(loop, [&] { return server.sessions == 0; });
+
+    // 全部连接关闭后新连接仍可握手
+    EchoClient last(loop);
+    last.Connect();
+    RunUntil(loop, [&] { return last.Echoed() || last.failed; });
+    CHECK(last.Echoed());
+    last.client.Shutdown();
+    RunUntil(loop, [&] { return last.closed; });
+    printf("psa lifecycle: %u/%u echoed while other connections closed\n", echoed, count);
+}
+
+/**
+ * 限制为TLS1.2的创建器不受PSA密钥槽数量约束, 大量连接同时保持时都能完成回显
+ */
+static void ConcurrencyTest(uv_loop_t *loop) {
+    EchoServer server(loop);
+    auto ssl = new Lcc::MbedTLSPluginCreator;
+    ssl->SetMaxVersion(MBEDTLS_SSL_VERSION_TLS1_2);
+    if (!ssl->InitializeServerMode(kCert, kKey, "")) {
+        delete ssl;
+        CHECK(false);
+        return;
+    }
+    server.Enable(ssl);
+    server.Listen(kLegacyHost);
+    RunUntil(loop, [&] { return server.listen != 0; });
+    CHECK(server.listen > 0);
+
+    const unsigned int count = 40;
+    std::vector<EchoClient *> clients;
+    for (unsigned int n = 0; n < count; ++n) {
+        clients.push_back(new EchoClient(loop));
+        clients.back()->Connect(kLegacyHost, MBEDTLS_SSL_VERSION_TLS1_2);
+    }
+    RunUntil(loop, [&] {
+        bool done = true;
+        for (auto client: clients) {
+            done = done && (client->Echoed() || client->failed);
+        }
+        return done;
+    });
+    unsigned int echoed = 0;
+    for (auto client: clients) {
+        echoed += client->Echoed() ? 1 : 0;
+    }
+    CHECK(echoed == count);
+    CHECK(server.sessions == static_cast<int>(count));
+    for (auto client: clients) {
+        client->client.Shutdown();
+    }
+    for (auto client: clients) {
+        RunUntil(loop, [&] { return client->closed; });
+        delete client;
+    }
+    RunUntil(loop, [&] { return server.sessions == 0; });
+    server.Shutdown();
+    RunUntil(loop, [&] { return server.stopped; });
+    printf("tls1.2 concurrency: %u/%u echoed while all connections open\n", echoed, count);
+}
+
+int main(int argc, char *argv[]) {
+    uv_loop_t *loop = uv_default_loop();
+    EchoServer server(loop);
+    auto ssl = new Lcc::MbedTLSPluginCreator;
+    if (!ssl->InitializeServerMode(kCert, kKey, "")) {
+        printf("tls server init fail\n");
+        delete ssl;
+        return 1;
+    }
+    server.Enable(ssl);
+    server.Listen(kHost);
+    RunUntil(loop, [&] { return server.listen != 0; });
+    if (server.listen < 0) {
+        printf("listen fail\n");
+        return 1;
+    }
+    LifecycleTest(loop, server);
+    ConcurrencyTest(loop);
+    server.Shutdown();
+    uv_run(loop, UV_RUN_DEFAULT);
+    uv_loop_close(loop);
+    if (_failed) {
+        printf("mbedtls fail: %u\n", _failed);
+        return 1;
+    }
+    printf("mbedtls ok\n");
+    return 0;
+}
@@ -0,0 +1,298 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <thread/Thread.h>
+
+static const unsigned int kMessages = 1000000;
+static const unsigned int kBatch = 64;
+static const unsigned int kProducers = 4;
+
+struct Message {
+    unsigned int seq;
+    unsigned int kind;
+    char payload[24];
+};
+
+// 按生产者与序号填充负载, 消费端据此校验内容
+static void Fill(Message &message, unsigned int kind, unsigned int seq) {
+    message.seq = seq;
+    message.kind = kind;
+    for (unsigned int i = 0; i < sizeof(message.payload); ++i) {
+        message.payload[i] = static_cast<char>(seq + kind + i);
+    }
+}
+
+static bool Valid(const Message &message) {
+    for (unsigned int i = 0; i < sizeof(message.payload); ++i) {
+        if (message.payload[i] != static_cast<char>(message.seq + message.kind + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+class Thread : public Lcc::Thread, public Lcc::ChannelImplement<Message> {
+public:
+    Thread() : received(0), errors(0), channel(this), _next() {
+    }
+
+    ~Thread() override = default;
+
+    std::atomic<unsigned int> received;
+    std::atomic<unsigned int> errors;
+    Lcc::MessageChannel<Message> channel;
+
+protected:
+    inline bool IInit() override {
+        return OpenChannel(&channel);
+    }
+
+    inline void IMessage(void *message) override {
+        ::free(message);
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void IChannelReceive(Message &message) override {
+        // 每个生产者的消息须按序到达且内容完整
+        if (message.kind >= kProducers || message.seq != _next[message.kind]++ || !Valid(message)) {
+            errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void IShutdown() override {
+    }
+
+private:
+    unsigned int _next[kProducers];
+};
+
+/**
+ * 超过InlineSize且带析构的消息, 统计存活对象数以验证所有权转移与销毁
+ */
+struct Large {
+    static std::atomic<int> live;
+
+    unsigned int seq;
+    char payload[120];
+    std::string tag;
+
+    Large() : seq(0), payload() {
+        live.fetch_add(1);
+    }
+
+    Large(Large &&other) noexcept : seq(other.seq), tag(std::move(other.tag)) {
+        memcpy(payload, other.payload, sizeof(payload));
+        live.fetch_add(1);
+    }
+
+    Large &operator=(Large &&other) noexcept {
+        seq = other.seq;
+        memcpy(payload, other.payload, sizeof(payload));
+        tag = std::move(other.tag);
+        return *this;
+    }
+
+    ~Large() {
+        live.fetch_sub(1);
+    }
+};
+
+std::atomic<int> Large::live(0);
+
+class LargeReceiver : public Lcc::ChannelImplement<Large> {
+public:
+    void IChannelReceive(Large &message) override {
+    }
+};
+
+static unsigned int _failed = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("check fail: %s (line %d)\n", #cond, __LINE__); ++_failed; } } while (0)
+
+static void CloseLoop(uv_loop_t *loop) {
+    uv_walk(loop, [](uv_handle_t *handle, void *) {
+        if (!uv_is_closing(handle)) {
+            uv_close(handle, nullptr);
+        }
+    }, nullptr);
+    uv_run(loop, UV_RUN_DEFAULT);
+    uv_loop_close(loop);
+}
+
+static Large MakeLarge(unsigned int seq) {
+    Large message;
+    message.seq = seq;
+    memset(message.payload, static_cast<int>(seq & 0xff), sizeof(message.payload));
+    message.tag = "large-message-" + std::to_string(seq);
+    return message;
+}
+
+/**
+ * 大消息单独分配: TryDequeueBulk取出内容完整, Close与析构时销毁未派发的消息
+ */
+static void OwnershipTest() {
+    const unsigned int count = 300;
+    LargeReceiver receiver;
+    {
+        uv_loop_t loop;
+        uv_loop_init(&loop);
+        Lcc::MessageChannel<Large> channel(&receiver);
+        CHECK(channel.Open(&loop));
+        for (unsigned int n = 0; n < count; ++n) {
+            CHECK(channel.Enqueue(MakeLarge(n)));
+        }
+        Large batch[2];
+        batch[0] = MakeLarge(count);
+        batch[1] = MakeLarge(count + 1);
+        CHECK(channel.EnqueueBulk(batch, 2));
+        CHECK(batch[0].tag.empty() && batch[1].tag.empty());
+        // 队列中的消息加上batch两个空壳
+        CHECK(Large::live == static_cast<int>(count) + 4);
+
+        std::vector<Large> out(100);
+        const size_t got = channel.TryDequeueBulk(out.data(), out.size());
+        CHECK(got == out.size());
+        for (unsigned int n = 0; n < got; ++n) {
+            CHECK(out[n].seq == n && out[n].tag == "large-message-" + std::to_string(n) &&
+                  static_cast<unsigned char>(out[n].payload[119]) == (n & 0xff));
+        }
+        out.clear();
+        CHECK(Large::live == static_cast<int>(count) + 4 - 100);
+
+        channel.Close();
+        CHECK(!channel.Active());
+        CHECK(Large::live == 2);
+        CloseLoop(&loop);
+    }
+    CHECK(Large::live == 0);
+    {
+        uv_loop_t loop;
+        uv_loop_init(&loop);
+        {
+            Lcc::MessageChannel<Large> channel(&receiver);
+            CHECK(channel.Open(&loop));
+            for (unsigned int n = 0; n < count; ++n) {
+                CHECK(channel.Enqueue(MakeLarge(n)));
+            }
+            CHECK(Large::live == static_cast<int>(count));
+        }
+        // 未关闭就析构: 析构时销毁消息, 句柄由事件循环关闭后释放
+        CHECK(Large::live == 0);
+        CloseLoop(&loop);
+    }
+    printf("ownership and destruction %s\n", _failed == 0 ? "ok" : "fail");
+}
+
+/**
+ * 多生产者并发投递, 每个生产者的消息按序到达
+ */
+static void OrderTest() {
+    Thread thread;
+    thread.Startup();
+    std::vector<std::thread> producers;
+    const unsigned int each = kMessages / kProducers;
+    for (unsigned int kind = 0; kind < kProducers; ++kind) {
+        producers.emplace_back([&thread, kind, each] {
+            Message batch[kBatch];
+            unsigned int seq = 0;
+            while (seq < each) {
+                // 单条与批量交替投递
+                if (seq % (kBatch * 2) == 0 && each - seq >= kBatch) {
+                    for (unsigned int i = 0; i < kBatch; ++i) {
+                        Fill(batch[i], kind, seq + i);
+                    }
+                    thread.channel.EnqueueBulk(batch, kBatch);
+                    seq += kBatch;
+                } else {
+                    Message message{};
+                    Fill(message, kind, seq++);
+                    thread.channel.Enqueue(std::move(message));
+                }
+            }
+        });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    while (thread.received.load(std::memory_order_relaxed) < each * kProducers) {
+        std::this_thread::yield();
+    }
+    CHECK(thread.errors == 0);
+    printf("multi producer order %s: %u messages, %u errors\n", thread.errors == 0 ? "ok" : "fail",
+           thread.received.load(), thread.errors.load());
+    thread.Shutdown();
+}
+
+static void WaitReceived(Thread &thread) {
+    while (thread.received.load(std::memory_order_relaxed) < kMessages) {
+        std::this_thread::yield();
+    }
+}
+
+static void Report(const char *name, uint64_t cost, unsigned long long wakeups, unsigned long long signals) {
+    const double seconds = static_cast<double>(cost) / 1e9;
+    printf("%-32s %12.0f msg/s %12.0f wakeups/s %10llu wakeups %10llu async_send\n", name, kMessages / seconds,
+           wakeups / seconds, wakeups, signals);
+}
+
+int main(int argc, char *argv[]) {
+    {
+        Thread thread;
+        thread.Startup();
+        const uint64_t begin = uv_hrtime();
+        for (unsigned int n = 0; n < kMessages; ++n) {
+            auto message = static_cast<Message *>(::malloc(sizeof(Message)));
+            message->seq = n;
+            thread.QueueMessage(message);
+        }
+        WaitReceived(thread);
+        Report("Thread::QueueMessage", uv_hrtime() - begin, thread.Wakeups(), kMessages);
+        thread.Shutdown();
+    }
+    {
+        Thread thread;
+        thread.Startup();
+        const uint64_t begin = uv_hrtime();
+        for (unsigned int n = 0; n < kMessages; ++n) {
+            Message message{};
+            Fill(message, 0, n);
+            thread.channel.Enqueue(std::move(message));
+        }
+        WaitReceived(thread);
+        Report("MessageChannel::Enqueue", uv_hrtime() - begin, thread.channel.Wakeups(), thread.channel.Signals());
+        CHECK(thread.errors == 0);
+        thread.Shutdown();
+    }
+    {
+        Thread thread;
+        thread.Startup();
+        Message batch[kBatch];
+        const uint64_t begin = uv_hrtime();
+        for (unsigned int n = 0; n < kMessages; n += kBatch) {
+            for (unsigned int i = 0; i < kBatch; ++i) {
+                Fill(batch[i], 0, n + i);
+            }
+            thread.channel.EnqueueBulk(batch, kBatch);
+        }
+        WaitReceived(thread);
+        Report("MessageChannel::EnqueueBulk", uv_hrtime() - begin, thread.channel.Wakeups(), thread.channel.Signals());
+        CHECK(thread.errors == 0);
+        thread.Shutdown();
+    }
+    OrderTest();
+    OwnershipTest();
+    if (_failed) {
+        printf("message channel fail: %u\n", _failed);
+        return 1;
+    }
+    printf("message channel ok\n");
+    return 0;
+}
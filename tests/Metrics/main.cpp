@@ -0,0 +1,266 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <uv.h>
+#include <metrics/Metrics.h>
+#include <metrics/LoopMetrics.h>
+#include <network/NetMetrics.h>
+#include <network/TcpServer.h>
+#include <network/MetricsServer.h>
+
+static const char *kEchoHost = "tcp://127.0.0.1:18435";
+static const char *kMetricsHost = "tcp://127.0.0.1:18436";
+static const unsigned long long kHotLoops = 10000000;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+class EchoServer final : public Lcc::TcpServer, public Lcc::ServerImplement {
+public:
+    explicit EchoServer(uv_loop_t *loop) : Lcc::TcpServer(this), _loop(loop), _listen(0), _session(0),
+                                           _stats() {
+    }
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : -1;
+    }
+
+    void IServerShutdown() override {
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        _session = session;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        SessionWrite(session, buf, size);
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+        GetSessionStats(session, _stats);
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        _session = 0;
+    }
+
+    uv_loop_t *_loop;
+    int _listen;
+    unsigned int _session;
+    Lcc::StreamStats _stats;
+};
+
+/**
+ * 原始TCP客户端: 连接后发送请求, 收集应答直到对端关闭
+ */
+struct RawClient {
+    uv_tcp_t tcp;
+    uv_connect_t connect;
+    uv_write_t write;
+    std::string request;
+    std::string response;
+    bool closeAfterEcho;
+    bool closed;
+};
+
+static void RawClose(RawClient *client) {
+    if (!uv_is_closing(reinterpret_cast<uv_handle_t *>(&client->tcp))) {
+        uv_close(reinterpret_cast<uv_handle_t *>(&client->tcp), [](uv_handle_t *handle) {
+            static_cast<RawClient *>(handle->data)->closed = true;
+        });
+    }
+}
+
+static void RawFetch(uv_loop_t *loop, RawClient &client, unsigned short port) {
+    client.closed = false;
+    uv_tcp_init(loop, &client.tcp);
+    client.tcp.data = &client;
+    client.connect.data = &client;
+    sockaddr_in addr{};
+    uv_ip4_addr("127.0.0.1", port, &addr);
+    uv_tcp_connect(&client.connect, &client.tcp, reinterpret_cast<const sockaddr *>(&addr), [](uv_connect_t *req, int status) {
+        auto client = static_cast<RawClient *>(req->data);
+        if (status != 0) {
+            return RawClose(client);
+        }
+        uv_buf_t buf = uv_buf_init(&client->request[0], static_cast<unsigned int>(client->request.size()));
+        uv_write(&client->write, req->handle, &buf, 1, nullptr);
+        uv_read_start(req->handle, [](uv_handle_t *, size_t suggested, uv_buf_t *buf) {
+            buf->base = new char[suggested];
+            buf->len = suggested;
+        }, [](uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf) {
+            auto client = static_cast<RawClient *>(stream->data);
+            if (nread > 0) {
+                client->response.append(buf->base, static_cast<size_t>(nread));
+            }
+            delete[] buf->base;
+            if (nread < 0 || (client->closeAfterEcho && client->response.size() >= client->request.size())) {
+                RawClose(client);
+            }
+        });
+    });
+    while (!client.closed) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+}
+
+static void TestShards() {
+    auto &registry = Lcc::Metrics::Registry::Instance();
+    Lcc::Metrics::Counter counter = registry.AddCounter("test_events_total", "Test events", "kind=\"a\"");
+    Lcc::Metrics::Counter other = registry.AddCounter("test_events_total", "Test events", "kind=\"b\"");
+    Lcc::Metrics::Gauge gauge = registry.AddGauge("test_depth", "Test depth");
+    Lcc::Metrics::Histogram histogram = registry.AddHistogram("test_latency_seconds", "Test latency", nullptr, 1e-9);
+
+    // 各线程写入自己的分片, 线程退出后数值仍保留
+    std::vector<std::thread> threads;
+    for (int n = 0; n < 4; ++n) {
+        threads.emplace_back([&counter, &gauge, &histogram]() {
+            for (int i = 0; i < 100000; ++i) {
+                counter.Add();
+            }
+            gauge.Add(10);
+            gauge.Sub(3);
+            histogram.Record(1000);
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    other.Add(5);
+    CHECK(counter.Value() == 400000);
+    CHECK(other.Value() == 5);
+    CHECK(gauge.Value() == 28);
+    gauge.Sub(40);
+    CHECK(gauge.Value() == -12);
+
+    Lcc::Utils::Histogram merged;
+    histogram.Collect(merged);
+    CHECK(merged.Count() == 4);
+    CHECK(merged.Sum() == 4000);
+    CHECK(merged.Percentile(50) >= 1000 && merged.Percentile(50) < 1125);
+
+    // 未注册的句柄写入丢弃区, 不影响导出
+    Lcc::Metrics::Counter unused;
+    unused.Add();
+
+    std::string text;
+    registry.Export(text);
+    CHECK(text.find("# TYPE test_events_total counter\n") != std::string::npos);
+    CHECK(text.find("test_events_total{kind=\"a\"} 400000\n") != std::string::npos);
+    CHECK(text.find("test_events_total{kind=\"b\"} 5\n") != std::string::npos);
+    CHECK(text.find("# TYPE test_events_total", text.find("# TYPE test_events_total") + 1) == std::string::npos);
+    CHECK(text.find("test_depth -12\n") != std::string::npos);
+    CHECK(text.find("# TYPE test_latency_seconds histogram\n") != std::string::npos);
+    CHECK(text.find("test_latency_seconds_bucket{le=\"+Inf\"} 4\n") != std::string::npos);
+    CHECK(text.find("test_latency_seconds_count 4\n") != std::string::npos);
+    CHECK(text.find("test_latency_seconds_sum 4e-06\n") != std::string::npos);
+    // 1000落在[960,1023]子桶, 所在2的幂区间上界为1023ns
+    CHECK(text.find("test_latency_seconds_bucket{le=\"1.023e-06\"} 4\n") != std::string::npos);
+    CHECK(text.find("test_latency_seconds_bucket{le=\"5.11e-07\"} 0\n") != std::string::npos);
+    printf("shards ok\n");
+}
+
+static void BenchHotPath() {
+    auto &registry = Lcc::Metrics::Registry::Instance();
+    Lcc::Metrics::Counter counter = registry.AddCounter("bench_events_total", "Bench events");
+    Lcc::Metrics::Histogram histogram = registry.AddHistogram("bench_values", "Bench values");
+
+    uint64_t begin = uv_hrtime();
+    for (unsigned long long n = 0; n < kHotLoops; ++n) {
+        counter.Add(n & 7);
+    }
+    const double addNs = static_cast<double>(uv_hrtime() - begin) / static_cast<double>(kHotLoops);
+
+    begin = uv_hrtime();
+    for (unsigned long long n = 0; n < kHotLoops; ++n) {
+        histogram.Record(n & 0xffff);
+    }
+    const double recordNs = static_cast<double>(uv_hrtime() - begin) / static_cast<double>(kHotLoops);
+    CHECK(counter.Value() == kHotLoops / 8 * 28);
+    printf("counter add: %.2f ns, histogram record: %.2f ns\n", addNs, recordNs);
+}
+
+static void TestEndToEnd() {
+    uv_loop_t *loop = uv_default_loop();
+    Lcc::Metrics::LoopMetrics loopMetrics;
+    CHECK(loopMetrics.Attach(loop, "main"));
+    CHECK(!loopMetrics.Attach(loop, "main"));
+
+    const unsigned long long accepts = Lcc::NetMetrics::Instance().accepts.Value();
+    const unsigned long long bytesIn = Lcc::NetMetrics::Instance().bytesIn.Value();
+
+    EchoServer echo(loop);
+    echo.Listen(kEchoHost);
+    Lcc::MetricsServer metrics(loop);
+    metrics.Listen(kMetricsHost);
+    while (echo._listen == 0 || !metrics.IsListening()) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+    CHECK(echo._listen > 0);
+
+    RawClient client;
+    client.request = "hello metrics";
+    client.closeAfterEcho = true;
+    RawFetch(loop, client, 18435);
+    CHECK(client.response == client.request);
+    while (echo._session != 0) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+    CHECK(echo._stats.bytesIn == client.request.size());
+    CHECK(echo._stats.bytesOut == client.request.size());
+    CHECK(echo._stats.messagesIn == 1);
+    CHECK(echo._stats.messagesOut == 1);
+    CHECK(Lcc::NetMetrics::Instance().accepts.Value() == accepts + 1);
+    CHECK(Lcc::NetMetrics::Instance().bytesIn.Value() >= bytesIn + client.request.size());
+    CHECK(Lcc::NetMetrics::Instance().writeQueueBytes.Value() == 0);
+
+    RawClient scrape;
+    scrape.request = "GET /metrics HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    scrape.closeAfterEcho = false;
+    RawFetch(loop, scrape, 18436);
+    const std::string &text = scrape.response;
+    CHECK(text.compare(0, 15, "HTTP/1.0 200 OK") == 0);
+    CHECK(text.find("Content-Type: text/plain; version=0.0.4\r\n") != std::string::npos);
+    CHECK(text.find("\nlcc_net_accepts_total ") != std::string::npos);
+    CHECK(text.find("lcc_net_closes_total{reason=\"eof\"} ") != std::string::npos);
+    CHECK(text.find("# TYPE lcc_tls_handshake_seconds histogram\n") != std::string::npos);
+    CHECK(text.find("lcc_loop_iterations_total{loop=\"main\"} ") != std::string::npos);
+    CHECK(text.find("lcc_loop_lag_seconds_count{loop=\"main\"} ") != std::string::npos);
+    const size_t head = text.find("\r\n\r\n");
+    const size_t length = text.find("Content-Length: ");
+    CHECK(head != std::string::npos && length != std::string::npos);
+    if (head != std::string::npos && length != std::string::npos) {
+        CHECK(std::stoul(text.substr(length + 16)) == text.size() - head - 4);
+    }
+
+    RawClient missing;
+    missing.request = "GET / HTTP/1.0\r\n\r\n";
+    missing.closeAfterEcho = false;
+    RawFetch(loop, missing, 18436);
+    CHECK(missing.response.compare(0, 22, "HTTP/1.0 404 Not Found") == 0);
+
+    echo.Shutdown();
+    metrics.Shutdown();
+    loopMetrics.Detach();
+    uv_run(loop, UV_RUN_DEFAULT);
+    CHECK(!metrics.IsListening());
+    printf("end to end ok\n");
+}
+
+int main(int argc, char *argv[]) {
+    TestShards();
+    BenchHotPath();
+    TestEndToEnd();
+    uv_loop_close(uv_default_loop());
+    return _failed ? 1 : 0;
+}
@@ -0,0 +1,325 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include <network/TcpStream.h>
+#include <network/pipeline/Pipeline.h>
+#include <network/pipeline/FramingLayer.h>
+#include <network/pipeline/WebSocketLayer.h>
+#include <network/plugin/FramePlugin.h>
+#include <network/plugin/WebSocketPlugin.h>
+
+static const size_t kStreamBytes = 0x100000;
+static const size_t kChunk = 0x10000;
+static const unsigned int kSizes[] = {16, 64, 256};
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+typedef Lcc::Pipeline<Lcc::FramingLayer> FramingPipeline;
+typedef Lcc::Pipeline<Lcc::WebSocketLayer, Lcc::FramingLayer> WebSocketPipeline;
+
+static const char *kHandshake =
+        "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: upgrade\r\nUpgrade: websocket\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n";
+
+/**
+ * 编码一条客户端WebSocket帧(带掩码)
+ */
+static void AppendWebSocketFrame(std::string &out, unsigned char opcode, const std::string &payload) {
+    static const unsigned char mask[4] = {0x12, 0x34, 0x56, 0x78};
+    out.push_back(static_cast<char>(0x80 | opcode));
+    if (payload.size() < 126) {
+        out.push_back(static_cast<char>(0x80 | payload.size()));
+    } else {
+        out.push_back(static_cast<char>(0x80 | 126));
+        out.push_back(static_cast<char>(payload.size() >> 8));
+        out.push_back(static_cast<char>(payload.size()));
+    }
+    out.append(reinterpret_cast<const char *>(mask), 4);
+    for (size_t n = 0; n < payload.size(); ++n) {
+        out.push_back(static_cast<char>(payload[n] ^ mask[n % 4]));
+    }
+}
+
+/**
+ * 第n帧的数据字节均为n的低8位
+ */
+static std::string MakeFrame(unsigned int size, unsigned int n) {
+    char head[Lcc::FramingLayer::kMaxHeadSize];
+    std::string frame(head, Lcc::FramingLayer::EncodeHead(Lcc::FrameHeader::Varint, size, head));
+    frame.append(size, static_cast<char>(n));
+    return frame;
+}
+
+/**
+ * 按读缓冲区大小切分的输入, WebSocket帧不跨块
+ */
+static std::vector<std::string> MakeChunks(bool websocket, unsigned int size, unsigned int &count) {
+    std::vector<std::string> chunks(1);
+    count = 0;
+    size_t total = 0;
+    while (total < kStreamBytes) {
+        std::string unit;
+        if (websocket) {
+            AppendWebSocketFrame(unit, 0x2, MakeFrame(size, count));
+        } else {
+            unit = MakeFrame(size, count);
+        }
+        if (chunks.back().size() + unit.size() > kChunk) {
+            chunks.emplace_back();
+        }
+        chunks.back().append(unit);
+        total += unit.size();
+        ++count;
+    }
+    return chunks;
+}
+
+/**
+ * 不经过网络的协议宿主, 记录流水线两端的交互
+ */
+class Host : public Lcc::ProtocolImplement {
+public:
+    Host() : _opened(0), _closed(0) {
+    }
+
+    unsigned int _opened;
+    unsigned int _closed;
+    std::string _written;
+    std::vector<std::string> _frames;
+
+    void IProtocolOpen(Lcc::ProtocolLevel streamLevel) override {
+        ++_opened;
+    }
+
+    void IProtocolWrite(Lcc::ProtocolLevel streamLevel, const char *buf, unsigned int size) override {
+        _written.append(buf, size);
+    }
+
+    void IProtocolRead(Lcc::ProtocolLevel streamLevel, const char *buf, unsigned int size) override {
+        _frames.emplace_back(buf, size);
+    }
+
+    void IProtocolClose(Lcc::ProtocolLevel streamLevel) override {
+        ++_closed;
+    }
+};
+
+/**
+ * 流水线各层的衔接: 握手、跨WebSocket帧的分帧、写入封装与错误关闭
+ */
+static void LayerTest() {
+    {
+        Host host;
+        WebSocketPipeline pipeline(&host, {Lcc::WebSocketOpcode::Binary, std::string()},
+                                   {Lcc::FrameHeader::Varint, 1024});
+        CHECK(pipeline.Init());
+        auto &proto = static_cast<Lcc::ProtocolPlugin &>(pipeline);
+        CHECK(proto.IProtocolPluginOpen());
+        CHECK(host._opened == 0);
+        CHECK(proto.IProtocolPluginRead(kHandshake, static_cast<unsigned int>(strlen(kHandshake))));
+        CHECK(host._opened == 1);
+        CHECK(host._written.find("HTTP/1.1 101") == 0);
+        CHECK(host._written.find("s3pPLMBiTxaQ9kYGzzhZRbK+xOo=") != std::string::npos);
+
+        // 一个长度前缀帧被拆到两个WebSocket帧里, 两个帧放在同一个WebSocket帧里
+        const std::string frame = MakeFrame(300, 7);
+        std::string input;
+        AppendWebSocketFrame(input, 0x2, frame.substr(0, 100));
+        CHECK(proto.IProtocolPluginRead(input.data(), static_cast<unsigned int>(input.size())));
+        CHECK(host._frames.empty());
+        input.clear();
+        AppendWebSocketFrame(input, 0x2, frame.substr(100) + MakeFrame(0, 0) + MakeFrame(3, 9));
+        CHECK(proto.IProtocolPluginRead(input.data(), static_cast<unsigned int>(input.size())));
+        CHECK(host._frames.size() == 3);
+        CHECK(host._frames.size() == 3 && host._frames[0] == std::string(300, 7) && host._frames[1].empty() &&
+              host._frames[2] == std::string(3, 9));
+        CHECK(pipeline.GetLayer<1>().BufferedFrames() == 1);
+        CHECK(pipeline.GetLayer<1>().DirectFrames() == 2);
+
+        // 写入先加长度头再封装为WebSocket帧
+        host._written.clear();
+        proto.IProtocolPluginWrite("hello", 5);
+        CHECK(host._written == std::string("\x82\x06\x05hello", 8));
+
+        // 未启用的操作码关闭连接
+        input.clear();
+        AppendWebSocketFrame(input, 0x1, MakeFrame(1, 1));
+        CHECK(proto.IProtocolPluginRead(input.data(), static_cast<unsigned int>(input.size())));
+        CHECK(host._closed == 1);
+        CHECK(proto.IProtocolLastError() == static_cast<int>(Lcc::WebSocketCode::Unsupported));
+    }
+    {
+        // 分帧层出错时错误码取自出错的层
+        Host host;
+        FramingPipeline pipeline(&host, {Lcc::FrameHeader::Fixed16, 16});
+        auto &proto = static_cast<Lcc::ProtocolPlugin &>(pipeline);
+        CHECK(proto.IProtocolPluginOpen());
+        CHECK(host._opened == 1);
+        CHECK(!proto.IProtocolPluginRead("\x00\x20", 2));
+        CHECK(host._closed == 1);
+        CHECK(proto.IProtocolLastError() == UV_E2BIG);
+        CHECK(strcmp(proto.IProtocolLastErrDesc(), "frame too large") == 0);
+    }
+    {
+        // 构造器按配置生成流水线
+        Host host;
+        auto creator = new Lcc::PipelineCreator<Lcc::WebSocketLayer, Lcc::FramingLayer>;
+        auto &base = static_cast<Lcc::ProtocolPluginCreator &>(*creator);
+        CHECK(!base.ICreatorInit());
+        creator->Initialize({Lcc::WebSocketOpcode::Binary, "127.0.0.1"}, {Lcc::FrameHeader::Fixed32, 64});
+        CHECK(base.ICreatorInit());
+        Lcc::ProtocolPlugin *plugin = base.ICreatorAlloc(&host);
+        CHECK(plugin != nullptr);
+        CHECK(plugin->GetLevel() == Lcc::ProtocolLevel::Application);
+        // 客户端模式启动时发出握手请求
+        CHECK(plugin->IProtocolPluginOpen());
+        CHECK(host._written.find("GET / HTTP/1.1") == 0);
+        plugin->IProtocolPluginRelease();
+        base.ICreatorRelease();
+    }
+}
+
+/**
+ * 真实的TcpStream, 数据直接注入插件链, 不经过套接字
+ */
+class BenchStream : public Lcc::StreamImplement, public Lcc::TcpStream {
+public:
+    explicit BenchStream(uv_loop_t *loop) : TcpStream(this), _loop(loop), _handle(nullptr), _opened(false),
+                                            _closed(false), _frames(0), _bad(0) {
+    }
+
+    uv_loop_t *_loop;
+    uv_tcp_t *_handle;
+    bool _opened;
+    bool _closed;
+    unsigned long long _frames;
+    unsigned long long _bad;
+
+    void Start() {
+        Init();
+        IProtocolOpen(Lcc::ProtocolLevel::Stream);
+    }
+
+    void Feed(const char *buf, unsigned int size) {
+        IProtocolRead(Lcc::ProtocolLevel::Stream, buf, size);
+    }
+
+    void Close() {
+        uv_close(reinterpret_cast<uv_handle_t *>(_handle), TcpStream::UvCloseCallback);
+        uv_run(_loop, UV_RUN_DEFAULT);
+    }
+
+    bool IStreamInit(Lcc::StreamHandle &handle) override {
+        handle.tcpSession = 1;
+        _handle = &handle.tcpHandle;
+        // 未连接的句柄, 握手回复的写入直接失败返回
+        return handle.Init(_loop) == 0;
+    }
+
+    void IStreamOpen(unsigned int session) override {
+        _opened = true;
+    }
+
+    void IStreamReceive(unsigned int session, const char *buf, unsigned int size) override {
+        const auto expect = static_cast<char>(_frames);
+        if (size == 0 || buf[0] != expect || buf[size - 1] != expect) {
+            ++_bad;
+        }
+        ++_frames;
+    }
+
+    void IStreamBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IStreamAfterClose(unsigned int session) override {
+        _closed = true;
+    }
+};
+
+/**
+ * 以读缓冲区大小的块注入整条流, 检查每一帧按顺序完整到达
+ */
+static void Transfer(uv_loop_t *loop, bool websocket, const std::vector<std::string> &chunks, unsigned int count,
+                      const std::vector<Lcc::ProtocolPluginCreator *> &creators) {
+    // WebSocket掩码在读缓冲区内原地解码, 每块先复制到读缓冲区
+    static char buffer[kChunk];
+    BenchStream stream(loop);
+    for (auto creator: creators) {
+        stream.EnableProtocolPlugin(creator->ICreatorAlloc(&stream));
+    }
+    stream.Start();
+    if (websocket) {
+        memcpy(buffer, kHandshake, strlen(kHandshake));
+        stream.Feed(buffer, static_cast<unsigned int>(strlen(kHandshake)));
+    }
+    CHECK(stream._opened);
+    for (auto &chunk: chunks) {
+        memcpy(buffer, chunk.data(), chunk.size());
+        stream.Feed(buffer, static_cast<unsigned int>(chunk.size()));
+    }
+    CHECK(stream._frames == count);
+    CHECK(stream._bad == 0);
+    stream.Close();
+    CHECK(stream._closed);
+}
+
+/**
+ * 同一条流分别经过动态插件与流水线, 结果应一致; 两者的性能对照见bench/micro/PipelineBench.cpp
+ */
+static void StreamTest(uv_loop_t *loop, bool websocket, unsigned int size) {
+    unsigned int count = 0;
+    const std::vector<std::string> chunks = MakeChunks(websocket, size, count);
+
+    std::vector<Lcc::ProtocolPluginCreator *> dynamic;
+    std::vector<Lcc::ProtocolPluginCreator *> pipeline;
+    if (websocket) {
+        auto ws = new Lcc::WebSocketPluginCreator;
+        ws->InitializeServerMode(Lcc::WebSocketOpcode::Binary);
+        dynamic.push_back(ws);
+        auto composed = new Lcc::PipelineCreator<Lcc::WebSocketLayer, Lcc::FramingLayer>;
+        composed->Initialize({Lcc::WebSocketOpcode::Binary, std::string()}, {Lcc::FrameHeader::Varint, 0x10000});
+        pipeline.push_back(composed);
+    } else {
+        auto composed = new Lcc::PipelineCreator<Lcc::FramingLayer>;
+        composed->Initialize({Lcc::FrameHeader::Varint, 0x10000});
+        pipeline.push_back(composed);
+    }
+    auto frame = new Lcc::FramePluginCreator;
+    frame->Initialize(Lcc::FrameHeader::Varint, 0x10000);
+    dynamic.push_back(frame);
+
+    Transfer(loop, websocket, chunks, count, dynamic);
+    Transfer(loop, websocket, chunks, count, pipeline);
+
+    for (auto creator: dynamic) {
+        creator->ICreatorRelease();
+    }
+    for (auto creator: pipeline) {
+        creator->ICreatorRelease();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    LayerTest();
+    uv_loop_t *loop = uv_default_loop();
+    for (auto size: kSizes) {
+        StreamTest(loop, false, size);
+    }
+    for (auto size: kSizes) {
+        StreamTest(loop, true, size);
+    }
+    uv_loop_close(loop);
+    if (_failed) {
+        printf("pipeline fail %u\n", _failed);
+        return 1;
+    }
+    printf("pipeline ok\n");
+    return 0;
+}
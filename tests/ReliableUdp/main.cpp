@@ -0,0 +1,475 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include <network/UdpClient.h>
+#include <network/UdpServer.h>
+#include <network/protocol/Kcp.h>
+
+static const int kServerPort = 18451;
+static const int kRelayPort = 18452;
+static const int kClosedPort = 18453;
+static const unsigned int kMessages = 1000;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+static bool RunUntil(uv_loop_t *loop, bool (*done)(void *), void *arg, uint64_t timeout = 5000) {
+    const uint64_t deadline = uv_now(loop) + timeout;
+    while (!done(arg)) {
+        if (uv_now(loop) > deadline) {
+            return false;
+        }
+        uv_run(loop, UV_RUN_ONCE);
+    }
+    return true;
+}
+
+/**
+ * 消息长度覆盖单个分片、多个分片与接近接收窗口的大消息
+ */
+static std::string Message(unsigned int seq) {
+    if (seq % 500 == 499) {
+        return std::string(100000, static_cast<char>('A' + seq % 26)) + std::to_string(seq);
+    }
+    return std::string(8 + (seq * 397) % 4000, static_cast<char>('a' + seq % 26)) + std::to_string(seq);
+}
+
+static unsigned int Mismatch(const std::vector<std::string> &received, unsigned int count) {
+    unsigned int bad = received.size() == count ? 0 : 1;
+    for (unsigned int n = 0; n < received.size() && n < count; ++n) {
+        bad += received[n] != Message(n);
+    }
+    return bad;
+}
+
+/**
+ * 丢包与延迟模拟: 按概率丢弃报文, 其余延迟delay加随机抖动后转发, 抖动会打乱报文顺序
+ * 客户端发往relay端口, relay用另一个套接字转发给服务端, 回程反之
+ */
+class Relay {
+    struct Packet {
+        bool toServer;
+        std::string data;
+    };
+
+public:
+    double loss = 0;
+    unsigned int delay = 0;
+    unsigned int jitter = 0;
+    uint64_t forwarded = 0;
+    uint64_t dropped = 0;
+
+    void Start(uv_loop_t *loop, int port, int serverPort) {
+        _loop = loop;
+        uv_ip4_addr("127.0.0.1", serverPort, &_server);
+        sockaddr_in addr{};
+        uv_ip4_addr("127.0.0.1", port, &addr);
+        uv_udp_init(loop, &_front);
+        uv_udp_init(loop, &_back);
+        uv_timer_init(loop, &_timer);
+        _front.data = _back.data = _timer.data = this;
+        CHECK(uv_udp_bind(&_front, reinterpret_cast<const sockaddr *>(&addr), 0) == 0);
+        uv_ip4_addr("127.0.0.1", 0, &addr);
+        CHECK(uv_udp_bind(&_back, reinterpret_cast<const sockaddr *>(&addr), 0) == 0);
+        uv_udp_recv_start(&_front, Relay::Alloc, Relay::Recv);
+        uv_udp_recv_start(&_back, Relay::Alloc, Relay::Recv);
+        uv_timer_start(&_timer, Relay::Tick, 1, 1);
+    }
+
+    void Stop() {
+        uv_close(reinterpret_cast<uv_handle_t *>(&_front), nullptr);
+        uv_close(reinterpret_cast<uv_handle_t *>(&_back), nullptr);
+        uv_close(reinterpret_cast<uv_handle_t *>(&_timer), nullptr);
+    }
+
+private:
+    static void Alloc(uv_handle_t *handle, size_t suggested, uv_buf_t *buf) {
+        auto self = static_cast<Relay *>(handle->data);
+        *buf = uv_buf_init(self->_buf, sizeof(self->_buf));
+    }
+
+    static void Recv(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const sockaddr *addr, unsigned flags) {
+        auto self = static_cast<Relay *>(handle->data);
+        if (nread <= 0 || !addr) {
+            return;
+        }
+        const bool toServer = handle == &self->_front;
+        if (toServer) {
+            memcpy(&self->_client, addr, sizeof(self->_client));
+        }
+        if (std::uniform_real_distribution<double>(0, 1)(self->_rng) < self->loss) {
+            ++self->dropped;
+            return;
+        }
+        const uint64_t at = uv_now(self->_loop) + self->delay + (self->jitter ? self->_rng() % self->jitter : 0);
+        self->_queue.emplace(at, Packet{toServer, std::string(buf->base, nread)});
+    }
+
+    static void Tick(uv_timer_t *handle) {
+        auto self = static_cast<Relay *>(handle->data);
+        const uint64_t now = uv_now(self->_loop);
+        while (!self->_queue.empty() && self->_queue.begin()->first <= now) {
+            auto &packet = self->_queue.begin()->second;
+            const uv_buf_t buf = uv_buf_init(&packet.data[0], static_cast<unsigned int>(packet.data.size()));
+            if (packet.toServer) {
+                uv_udp_try_send(&self->_back, &buf, 1, reinterpret_cast<const sockaddr *>(&self->_server));
+            } else {
+                uv_udp_try_send(&self->_front, &buf, 1, reinterpret_cast<const sockaddr *>(&self->_client));
+            }
+            ++self->forwarded;
+            self->_queue.erase(self->_queue.begin());
+        }
+    }
+
+private:
+    uv_loop_t *_loop = nullptr;
+    uv_udp_t _front{};
+    uv_udp_t _back{};
+    uv_timer_t _timer{};
+    sockaddr_in _server{};
+    sockaddr_in _client{};
+    std::mt19937 _rng{20261019};
+    std::multimap<uint64_t, Packet> _queue;
+    char _buf[65536];
+};
+
+class EchoServer : public Lcc::UdpServer, public Lcc::ServerImplement {
+public:
+    explicit EchoServer(uv_loop_t *loop) : UdpServer(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    bool _echo = true;
+    int _listen = 0;
+    int _sessions = 0;
+    int _closeErr = 0;
+    bool _shutdown = false;
+    unsigned int _lastSession = 0;
+    std::vector<std::string> _received;
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : err;
+    }
+
+    void IServerShutdown() override {
+        _shutdown = true;
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        ++_sessions;
+        _lastSession = session;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        if (_echo) {
+            SessionWrite(session, buf, size);
+        } else {
+            _received.emplace_back(buf, size);
+        }
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+        _closeErr = err;
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        --_sessions;
+    }
+};
+
+class Client : public Lcc::UdpClient, public Lcc::ClientImplement {
+public:
+    explicit Client(uv_loop_t *loop) : UdpClient(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    int _connected = 0;
+    bool _disconnected = false;
+    int _closeErr = 0;
+    std::string _error;
+    std::vector<std::string> _received;
+
+    bool IClientInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IClientReport(bool connected, const char *err) override {
+        _connected = connected ? 1 : -1;
+        _error = err ? err : "";
+    }
+
+    void IClientReceive(const char *buf, unsigned int size) override {
+        _received.emplace_back(buf, size);
+    }
+
+    void IClientBeforeDisconnect(int err, const char *errMsg) override {
+        _closeErr = err;
+    }
+
+    void IClientAfterDisconnect() override {
+        _disconnected = true;
+    }
+};
+
+static bool Connected(uv_loop_t *loop, Client &client, const std::string &url) {
+    client.Connect(url.c_str());
+    RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_connected != 0; }, &client);
+    return client._connected == 1;
+}
+
+static void Idle(Client &client) {
+    RunUntil(client._loop, [](void *arg) { return static_cast<Client *>(arg)->_disconnected; }, &client, 10000);
+}
+
+/**
+ * 报文接口测试: 两个Kcp通过内存中的有损链路互发, 使用虚拟时钟, 结果可重复
+ */
+class KcpPeer : public Lcc::KcpImplement {
+public:
+    Lcc::Kcp kcp;
+    KcpPeer *peer = nullptr;
+    std::multimap<uint32_t, std::string> *link = nullptr;
+    std::mt19937 *rng = nullptr;
+    uint32_t *clock = nullptr;
+    uint64_t sent = 0;
+    std::vector<std::string> received;
+
+    explicit KcpPeer(uint32_t conv) : kcp(conv, this) {
+    }
+
+    void IKcpOutput(const char *buf, unsigned int size) override {
+        ++sent;
+        // 30%丢包, 延迟20~50ms
+        if ((*rng)() % 100 < 30) {
+            return;
+        }
+        link->emplace(*clock + 20 + (*rng)() % 30, std::string(buf, size));
+    }
+
+    void IKcpReceive(const char *buf, unsigned int size) override {
+        received.emplace_back(buf, size);
+    }
+};
+
+static void KcpTest() {
+    std::mt19937 rng(7);
+    uint32_t clock = 1000;
+    std::multimap<uint32_t, std::string> toB, toA;
+    KcpPeer a(0x1234), b(0x1234);
+    a.peer = &b;
+    b.peer = &a;
+    a.link = &toB;
+    b.link = &toA;
+    a.rng = b.rng = &rng;
+    a.clock = b.clock = &clock;
+    CHECK(!a.kcp.Send(std::string(a.kcp.MaxMessageSize() + 1, 'x').data(), a.kcp.MaxMessageSize() + 1));
+    for (unsigned int n = 0; n < kMessages; ++n) {
+        const std::string message = Message(n);
+        CHECK(a.kcp.Send(message.data(), static_cast<unsigned int>(message.size())));
+        CHECK(b.kcp.Send(message.data(), static_cast<unsigned int>(message.size())));
+    }
+    const uint32_t deadline = clock + 600000;
+    while ((a.received.size() < kMessages || b.received.size() < kMessages) && clock < deadline) {
+        clock += 5;
+        for (auto link: {&toA, &toB}) {
+            auto &target = link == &toA ? a : b;
+            while (!link->empty() && link->begin()->first <= clock) {
+                CHECK(target.kcp.Input(link->begin()->second.data(),
+                                       static_cast<unsigned int>(link->begin()->second.size()), clock) == 0);
+                link->erase(link->begin());
+            }
+        }
+        a.kcp.Update(clock);
+        b.kcp.Update(clock);
+    }
+    CHECK(Mismatch(a.received, kMessages) == 0);
+    CHECK(Mismatch(b.received, kMessages) == 0);
+    CHECK(!a.kcp.IsDead() && !b.kcp.IsDead());
+    // 会话号不符与截断的报文
+    const char junk[Lcc::Kcp::kHeaderSize] = {1, 2, 3, 4, 81};
+    CHECK(a.kcp.Input(junk, sizeof(junk), clock) == UV_EPROTO);
+    CHECK(a.kcp.Input(junk, 8, clock) == UV_EPROTO);
+    // 关闭报文
+    std::multimap<uint32_t, std::string> fin;
+    rng.seed(99);
+    a.link = &fin;
+    a.kcp.SendFin(clock);
+    while (fin.empty()) {
+        a.kcp.SendFin(clock);
+    }
+    CHECK(b.kcp.Input(fin.begin()->second.data(), static_cast<unsigned int>(fin.begin()->second.size()), clock) ==
+          UV_EOF);
+    printf("kcp %u messages each way over 30%% loss: %u s virtual, %llu/%llu retransmits, rto %u ms\n", kMessages,
+           (clock - 1000) / 1000, static_cast<unsigned long long>(a.kcp.Retransmits()),
+           static_cast<unsigned long long>(b.kcp.Retransmits()), a.kcp.Rto());
+}
+
+static void TransportTest(uv_loop_t *loop) {
+    const std::string serverUrl = "udp://127.0.0.1:" + std::to_string(kServerPort);
+    const std::string relayUrl = "udp://127.0.0.1:" + std::to_string(kRelayPort);
+    Lcc::UdpOptions options;
+    options.idleTimeout = 2000;
+    options.connectTimeout = 500;
+    Relay relay;
+    relay.Start(loop, kRelayPort, kServerPort);
+    EchoServer server(loop);
+    server.SetOptions(options);
+    server.Listen(serverUrl.c_str());
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_listen != 0; }, &server));
+    CHECK(server._listen == 1);
+    CHECK(server.GetListenAddress().protocol == Lcc::Utils::HostProtocol::Udp);
+    CHECK(server.GetListenAddress().port == kServerPort);
+    // 20%丢包、15~35ms延迟并乱序时, 双向消息不丢不重且按序到达
+    {
+        relay.loss = 0.2;
+        relay.delay = 15;
+        relay.jitter = 20;
+        Client client(loop);
+        client.SetOptions(options);
+        CHECK(Connected(loop, client, relayUrl));
+        CHECK(client.GetSession() != 0);
+        const uint64_t begin = uv_hrtime();
+        size_t bytes = 0;
+        for (unsigned int n = 0; n < kMessages; ++n) {
+            const std::string message = Message(n);
+            bytes += message.size();
+            client.Write(message.data(), static_cast<unsigned int>(message.size()));
+        }
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_received.size() >= kMessages; },
+                       &client, 60000));
+        const double seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+        CHECK(Mismatch(client._received, kMessages) == 0);
+        Lcc::UdpStats stats{};
+        CHECK(client.GetStats(stats));
+        Lcc::UdpStats serverStats{};
+        CHECK(server.GetSessionStats(server._lastSession, serverStats));
+        const auto &batch = server.GetBatch();
+        printf("udp echo %u messages (%zu bytes) over 20%% loss: %.2f s, %.0f KB/s each way, "
+               "retransmits %llu/%llu, rto %u ms, %llu forwarded %llu dropped, %.1f packets per send call\n",
+               kMessages, bytes, seconds, bytes / seconds / 1024, static_cast<unsigned long long>(stats.retransmits),
+               static_cast<unsigned long long>(serverStats.retransmits), stats.rto,
+               static_cast<unsigned long long>(relay.forwarded), static_cast<unsigned long long>(relay.dropped),
+               batch.Calls() ? static_cast<double>(batch.Packets()) / batch.Calls() : 0.0);
+        // 关闭报文不保证送达, 检查关闭原因时不丢包
+        relay.loss = 0;
+        client.Shutdown();
+        Idle(client);
+        CHECK(client._disconnected && client._closeErr == 0);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server));
+        CHECK(server._closeErr == UV_EOF);
+        printf("echo ok\n");
+    }
+    // 关闭前写入的消息全部确认后才关闭
+    {
+        server._echo = false;
+        relay.loss = 0.2;
+        Client client(loop);
+        client.SetOptions(options);
+        CHECK(Connected(loop, client, relayUrl));
+        for (unsigned int n = 0; n < 50; ++n) {
+            const std::string message = Message(n);
+            client.Write(message.data(), static_cast<unsigned int>(message.size()));
+        }
+        client.Shutdown();
+        client.Write("late", 4);
+        Idle(client);
+        CHECK(client._disconnected && client._closeErr == 0);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server));
+        // 关闭报文丢失时服务端在空闲超时后关闭
+        CHECK(server._closeErr == UV_EOF || server._closeErr == UV_ETIMEDOUT);
+        CHECK(Mismatch(server._received, 50) == 0);
+        server._received.clear();
+        server._echo = true;
+        relay.loss = 0;
+        printf("flush on close ok\n");
+    }
+    // 服务端关闭会话
+    {
+        Client client(loop);
+        client.SetOptions(options);
+        CHECK(Connected(loop, client, relayUrl));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 1; }, &server));
+        server.ShutdownSession(server._lastSession);
+        Idle(client);
+        CHECK(client._disconnected && client._closeErr == UV_EOF);
+        CHECK(client.GetSession() == 0);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server));
+    }
+    // 超过单条上限
+    {
+        Client client(loop);
+        client.SetOptions(options);
+        CHECK(Connected(loop, client, relayUrl));
+        const std::string big(200000, 'x');
+        client.Write(big.data(), static_cast<unsigned int>(big.size()));
+        Idle(client);
+        CHECK(client._closeErr == UV_EMSGSIZE);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server));
+        CHECK(server._closeErr == UV_EOF);
+    }
+    // 链路中断: 两端都在空闲超时后关闭
+    {
+        Client client(loop);
+        client.SetOptions(options);
+        CHECK(Connected(loop, client, relayUrl));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 1; }, &server));
+        relay.loss = 1;
+        client.Write("lost", 4);
+        Idle(client);
+        CHECK(client._disconnected && client._closeErr == UV_ETIMEDOUT);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server));
+        CHECK(server._closeErr == UV_ETIMEDOUT);
+        printf("idle timeout ok\n");
+    }
+    // 握手超时
+    {
+        Client client(loop);
+        client.SetOptions(options);
+        CHECK(!Connected(loop, client, relayUrl));
+        CHECK(client._error == uv_strerror(UV_ETIMEDOUT));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->GetSession() == 0; }, &client));
+    }
+    // 端口不可达
+    {
+        Client client(loop);
+        client.SetOptions(options);
+        CHECK(!Connected(loop, client, "udp://127.0.0.1:" + std::to_string(kClosedPort)));
+        CHECK(client._error == uv_strerror(UV_ECONNREFUSED));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->GetSession() == 0; }, &client));
+    }
+    // 地址不是udp://时不连接
+    {
+        Client client(loop);
+        client.Connect(("tcp://127.0.0.1:" + std::to_string(kServerPort)).c_str());
+        CHECK(client.GetSession() == 0 && client._connected == 0);
+    }
+    relay.Stop();
+    server.Shutdown();
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_shutdown; }, &server));
+}
+
+int main(int argc, char *argv[]) {
+    KcpTest();
+    uv_loop_t *loop = uv_default_loop();
+    TransportTest(loop);
+    uv_run(loop, UV_RUN_DEFAULT);
+    CHECK(uv_loop_close(loop) == 0);
+    if (_failed) {
+        printf("reliable udp fail %u\n", _failed);
+        return 1;
+    }
+    printf("reliable udp ok\n");
+    return 0;
+}
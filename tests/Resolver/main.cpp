@@ -0,0 +1,287 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <uv.h>
+#include <network/Resolver.h>
+#include <network/NetMetrics.h>
+#include <network/TcpClient.h>
+#include <network/TcpServer.h>
+
+static const unsigned int kPort = 18435;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+static unsigned long long Resolves(Lcc::ResolveSource source) {
+    return Lcc::NetMetrics::Instance().resolves[static_cast<int>(source)].Value();
+}
+
+class Waiter : public Lcc::ResolveImplement {
+public:
+    int _reports = 0;
+    int _status = 1;
+    std::vector<Lcc::ResolvedAddress> _addresses;
+
+    void IResolveReport(int status, const std::vector<Lcc::ResolvedAddress> &addresses) override {
+        ++_reports;
+        _status = status;
+        _addresses = addresses;
+    }
+};
+
+static void RunUntil(uv_loop_t *loop, bool (*done)(void *), void *arg) {
+    while (!done(arg)) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+}
+
+static void LiteralTest() {
+    Lcc::ResolvedAddress address{};
+    CHECK(Lcc::Resolver::ParseLiteral("127.0.0.1", address));
+    CHECK(address.addr.sa_family == AF_INET && address.addr4.sin_addr.s_addr == htonl(INADDR_LOOPBACK));
+    CHECK(Lcc::Resolver::ParseLiteral("::1", address));
+    CHECK(address.addr.sa_family == AF_INET6 && address.addr6.sin6_addr.s6_addr[15] == 1);
+    CHECK(Lcc::Resolver::ParseLiteral("::ffff:10.0.0.1", address));
+    CHECK(!Lcc::Resolver::ParseLiteral("localhost", address));
+    CHECK(!Lcc::Resolver::ParseLiteral("256.0.0.1", address));
+    CHECK(!Lcc::Resolver::ParseLiteral("1.2.3", address));
+
+    // 数字地址不查询也不进缓存
+    auto &resolver = Lcc::Resolver::Local();
+    const size_t size = resolver.Size();
+    const auto literal = Resolves(Lcc::ResolveSource::Literal);
+    const auto query = Resolves(Lcc::ResolveSource::Query);
+    Waiter waiter;
+    int status = 1;
+    std::vector<Lcc::ResolvedAddress> addresses;
+    CHECK(resolver.Resolve(uv_default_loop(), "10.1.2.3", &waiter, status, addresses));
+    CHECK(status == 0 && addresses.size() == 1 && addresses[0].addr.sa_family == AF_INET);
+    CHECK(resolver.Resolve(uv_default_loop(), "fe80::1", &waiter, status, addresses));
+    CHECK(status == 0 && addresses.size() == 1 && addresses[0].addr.sa_family == AF_INET6);
+    CHECK(Resolves(Lcc::ResolveSource::Literal) == literal + 2);
+    CHECK(Resolves(Lcc::ResolveSource::Query) == query);
+    CHECK(resolver.Size() == size);
+    CHECK(waiter._reports == 0);
+}
+
+/**
+ * 并发查询合并, 完成后命中缓存, 到期后重新查询
+ */
+static void CacheTest(uv_loop_t *loop) {
+    auto &resolver = Lcc::Resolver::Local();
+    Lcc::ResolverOptions options;
+    options.ttl = 200;
+    resolver.SetOptions(options);
+    resolver.Clear();
+    const auto query = Resolves(Lcc::ResolveSource::Query);
+    const auto coalesced = Resolves(Lcc::ResolveSource::Coalesced);
+    const auto hit = Resolves(Lcc::ResolveSource::Hit);
+    Waiter first, second, canceled;
+    int status = 1;
+    std::vector<Lcc::ResolvedAddress> addresses;
+    CHECK(!resolver.Resolve(loop, "localhost", &first, status, addresses));
+    CHECK(!resolver.Resolve(loop, "localhost", &second, status, addresses));
+    CHECK(!resolver.Resolve(loop, "localhost", &canceled, status, addresses));
+    resolver.Cancel(&canceled);
+    CHECK(Resolves(Lcc::ResolveSource::Query) == query + 1);
+    CHECK(Resolves(Lcc::ResolveSource::Coalesced) == coalesced + 2);
+    RunUntil(loop, [](void *arg) { return static_cast<Waiter *>(arg)->_reports > 0; }, &second);
+    CHECK(first._reports == 1 && second._reports == 1 && canceled._reports == 0);
+    CHECK(first._status == 0 && !first._addresses.empty());
+    CHECK(second._addresses.size() == first._addresses.size());
+    // 结果去重, SOCK_STREAM之外的重复项不会出现
+    for (size_t i = 0; i < first._addresses.size(); ++i) {
+        for (size_t j = i + 1; j < first._addresses.size(); ++j) {
+            CHECK(memcmp(&first._addresses[i], &first._addresses[j], sizeof(Lcc::ResolvedAddress)) != 0);
+        }
+    }
+
+    CHECK(resolver.Resolve(loop, "localhost", &first, status, addresses));
+    CHECK(status == 0 && addresses.size() == first._addresses.size());
+    CHECK(Resolves(Lcc::ResolveSource::Hit) == hit + 1);
+    CHECK(first._reports == 1);
+
+    uv_sleep(options.ttl + 50);
+    CHECK(!resolver.Resolve(loop, "localhost", &first, status, addresses));
+    CHECK(Resolves(Lcc::ResolveSource::Query) == query + 2);
+    RunUntil(loop, [](void *arg) { return static_cast<Waiter *>(arg)->_reports > 1; }, &first);
+    CHECK(first._status == 0);
+    resolver.SetOptions(Lcc::ResolverOptions());
+}
+
+/**
+ * 失败结果同样缓存, 数量超出上限时淘汰
+ */
+static void NegativeTest(uv_loop_t *loop) {
+    auto &resolver = Lcc::Resolver::Local();
+    Lcc::ResolverOptions options;
+    options.capacity = 2;
+    resolver.SetOptions(options);
+    resolver.Clear();
+    const auto negative = Resolves(Lcc::ResolveSource::NegativeHit);
+    Waiter waiter;
+    int status = 1;
+    std::vector<Lcc::ResolvedAddress> addresses;
+    CHECK(!resolver.Resolve(loop, "lcc-missing.invalid", &waiter, status, addresses));
+    RunUntil(loop, [](void *arg) { return static_cast<Waiter *>(arg)->_reports > 0; }, &waiter);
+    CHECK(waiter._status < 0 && waiter._addresses.empty());
+    CHECK(resolver.Resolve(loop, "lcc-missing.invalid", &waiter, status, addresses));
+    CHECK(status == waiter._status && addresses.empty());
+    CHECK(Resolves(Lcc::ResolveSource::NegativeHit) == negative + 1);
+
+    const char *names[] = {"lcc-a.invalid", "lcc-b.invalid", "lcc-c.invalid"};
+    for (auto name: names) {
+        Waiter other;
+        CHECK(!resolver.Resolve(loop, name, &other, status, addresses));
+        RunUntil(loop, [](void *arg) { return static_cast<Waiter *>(arg)->_reports > 0; }, &other);
+        CHECK(resolver.Size() <= options.capacity);
+    }
+    resolver.SetOptions(Lcc::ResolverOptions());
+    resolver.Clear();
+    CHECK(resolver.Size() == 0);
+}
+
+class EchoServer : public Lcc::TcpServer, public Lcc::ServerImplement {
+public:
+    explicit EchoServer(uv_loop_t *loop) : TcpServer(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    int _listen = 0;
+    int _sessions = 0;
+    bool _shutdown = false;
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : err;
+    }
+
+    void IServerShutdown() override {
+        _shutdown = true;
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        ++_sessions;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        SessionWrite(session, buf, size);
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        --_sessions;
+    }
+};
+
+class EchoClient : public Lcc::TcpClient, public Lcc::ClientImplement {
+public:
+    explicit EchoClient(uv_loop_t *loop) : TcpClient(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    int _connected = 0;
+    bool _disconnected = false;
+    std::string _received;
+
+    bool IClientInit(Lcc::StreamHandle &handle) override {
+        handle.tcpSession = 1;
+        return handle.Init(_loop) == 0;
+    }
+
+    void IClientReport(bool connected, const char *err) override {
+        _connected = connected ? 1 : -1;
+    }
+
+    void IClientReceive(const char *buf, unsigned int size) override {
+        _received.append(buf, size);
+    }
+
+    void IClientBeforeDisconnect(int err, const char *errMsg) override {
+    }
+
+    void IClientAfterDisconnect() override {
+        _disconnected = true;
+    }
+};
+
+/**
+ * 经由解析器监听和连接, 主机名与IPv6字面量都可用
+ * @return 是否执行(本机不支持IPv6时跳过)
+ */
+static bool EchoTest(uv_loop_t *loop, const char *listen, const char *connect) {
+    EchoServer server(loop);
+    server.Listen(listen);
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_listen != 0; }, &server);
+    if (server._listen != 1) {
+        server.Shutdown();
+        RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_shutdown; }, &server);
+        return false;
+    }
+    EchoClient client(loop);
+    client.Connect(connect);
+    RunUntil(loop, [](void *arg) { return static_cast<EchoClient *>(arg)->_connected != 0; }, &client);
+    CHECK(client._connected == 1);
+    if (client._connected == 1) {
+        client.Write("ping", 4);
+        RunUntil(loop, [](void *arg) { return static_cast<EchoClient *>(arg)->_received.size() >= 4; }, &client);
+        CHECK(client._received == "ping");
+        client.Shutdown();
+        RunUntil(loop, [](void *arg) { return static_cast<EchoClient *>(arg)->_disconnected; }, &client);
+    }
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server);
+    server.Shutdown();
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_shutdown; }, &server);
+    return true;
+}
+
+/**
+ * 解析未完成时关闭, 不再回调已关闭的客户端
+ */
+static void ShutdownWhileResolving(uv_loop_t *loop) {
+    auto &resolver = Lcc::Resolver::Local();
+    resolver.Clear();
+    auto client = new EchoClient(loop);
+    client->Connect("tcp://localhost:1");
+    client->Shutdown();
+    // 同名查询并入客户端发起的查询, 完成时客户端已关闭
+    Waiter waiter;
+    int status = 1;
+    std::vector<Lcc::ResolvedAddress> addresses;
+    CHECK(!resolver.Resolve(loop, "localhost", &waiter, status, addresses));
+    RunUntil(loop, [](void *arg) { return static_cast<Waiter *>(arg)->_reports > 0; }, &waiter);
+    RunUntil(loop, [](void *arg) { return static_cast<EchoClient *>(arg)->GetSession() == 0; }, client);
+    CHECK(client->_connected == 0);
+    delete client;
+}
+
+int main(int argc, char *argv[]) {
+    uv_loop_t *loop = uv_default_loop();
+    LiteralTest();
+    CacheTest(loop);
+    NegativeTest(loop);
+    const std::string port = std::to_string(kPort);
+    CHECK(EchoTest(loop, ("tcp://localhost:" + port).c_str(), ("tcp://localhost:" + port).c_str()));
+    if (!EchoTest(loop, ("tcp://[::1]:" + port).c_str(), ("tcp://[::1]:" + port).c_str())) {
+        printf("ipv6 loopback unavailable, skipped\n");
+    }
+    ShutdownWhileResolving(loop);
+    uv_run(loop, UV_RUN_DEFAULT);
+    CHECK(uv_loop_close(loop) == 0);
+    if (_failed) {
+        printf("resolver fail %u\n", _failed);
+        return 1;
+    }
+    printf("resolver ok\n");
+    return 0;
+}
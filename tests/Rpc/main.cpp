@@ -0,0 +1,257 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <uv.h>
+#include <network/TcpClient.h>
+#include <network/TcpServer.h>
+#include <network/Dispatcher.h>
+#include <network/plugin/FramePlugin.h>
+
+static const char *kHost = "tcp://127.0.0.1:18434";
+static const unsigned short kMsgEcho = 1;
+static const unsigned short kMsgSilent = 2;
+static const unsigned short kMsgUnknown = 99;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+/**
+ * 回显请求, 负载直接指向接收缓冲区
+ */
+struct EchoRequest {
+    unsigned long long stamp;
+    Lcc::RpcSlice payload;
+
+    static bool Decode(Lcc::RpcReader &reader, EchoRequest &request) {
+        return reader.Read(request.stamp) && reader.Read(request.payload);
+    }
+};
+
+class RpcServer : public Lcc::TcpServer, public Lcc::ServerImplement, public Lcc::RpcImplement {
+public:
+    explicit RpcServer(uv_loop_t *loop) : TcpServer(this), _loop(loop), _listen(0), _endpoint(loop, this) {
+        _dispatcher.Register<kMsgEcho, EchoRequest, RpcServer, &RpcServer::OnEcho>();
+        _dispatcher.Register<kMsgSilent, RpcServer, &RpcServer::OnSilent>();
+    }
+
+    uv_loop_t *_loop;
+    int _listen;
+    Lcc::RpcEndpoint _endpoint;
+    Lcc::Dispatcher<RpcServer> _dispatcher;
+    std::string _reply;
+
+    Lcc::RpcEndpoint &GetRpcEndpoint() {
+        return _endpoint;
+    }
+
+    void OnEcho(unsigned int session, const Lcc::RpcMessage &msg, const EchoRequest &request) {
+        _reply.clear();
+        Lcc::RpcWriter(_reply).Write(request.stamp).Write(request.payload.data, request.payload.size);
+        _endpoint.Reply(session, msg, _reply.data(), static_cast<unsigned int>(_reply.size()));
+    }
+
+    void OnSilent(unsigned int session, const Lcc::RpcMessage &msg) {
+    }
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : -1;
+    }
+
+    void IServerShutdown() override {
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        if (!_endpoint.Receive(session, buf, size)) {
+            ShutdownSession(session);
+        }
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        _endpoint.SessionClosed(session);
+    }
+
+    void IRpcWrite(unsigned int session, const char *buf, unsigned int size) override {
+        SessionWrite(session, buf, size);
+    }
+
+    void IRpcReceive(unsigned int session, const Lcc::RpcMessage &msg) override {
+        if (!_dispatcher.Dispatch(*this, session, msg)) {
+            _endpoint.ReplyError(session, msg, UV_ENOSYS);
+        }
+    }
+
+    void IRpcResponse(unsigned int session, void *context, int status, const Lcc::RpcMessage &msg) override {
+    }
+};
+
+class RpcClient : public Lcc::TcpClient, public Lcc::ClientImplement, public Lcc::RpcImplement {
+public:
+    explicit RpcClient(uv_loop_t *loop) : TcpClient(this), _loop(loop), _connected(0), _disconnected(false),
+                                          _endpoint(loop, this), _remain(0), _done(0), _errors(0) {
+    }
+
+    uv_loop_t *_loop;
+    int _connected;
+    bool _disconnected;
+    Lcc::RpcEndpoint _endpoint;
+    // 回显压测: 每完成一个请求立即补发, 保持固定在途数
+    unsigned long long _remain;
+    unsigned long long _done;
+    unsigned long long _errors;
+    std::string _request;
+    // 最近一次非压测请求的结果
+    int _lastStatus = 1;
+
+    void SendEcho() {
+        _request.clear();
+        Lcc::RpcWriter(_request).Write(static_cast<unsigned long long>(_done)).Write("0123456789abcdef", 16);
+        --_remain;
+        _endpoint.Call(GetSession(), kMsgEcho, _request.data(), static_cast<unsigned int>(_request.size()), this, 1000);
+    }
+
+    bool IClientInit(Lcc::StreamHandle &handle) override {
+        handle.tcpSession = 1;
+        return handle.Init(_loop) == 0;
+    }
+
+    void IClientReport(bool connected, const char *err) override {
+        _connected = connected ? 1 : -1;
+    }
+
+    void IClientReceive(const char *buf, unsigned int size) override {
+        _endpoint.Receive(GetSession(), buf, size);
+    }
+
+    void IClientBeforeDisconnect(int err, const char *errMsg) override {
+        _endpoint.SessionClosed(1);
+    }
+
+    void IClientAfterDisconnect() override {
+        _disconnected = true;
+    }
+
+    void IRpcWrite(unsigned int session, const char *buf, unsigned int size) override {
+        Write(buf, size);
+    }
+
+    void IRpcReceive(unsigned int session, const Lcc::RpcMessage &msg) override {
+    }
+
+    void IRpcResponse(unsigned int session, void *context, int status, const Lcc::RpcMessage &msg) override {
+        if (context != this) {
+            _lastStatus = status;
+            return;
+        }
+        ++_done;
+        if (status != 0) {
+            ++_errors;
+            return;
+        }
+        EchoRequest reply{};
+        Lcc::RpcReader reader(msg);
+        if (!EchoRequest::Decode(reader, reply) || reply.payload.size != 16) {
+            ++_errors;
+        }
+        if (_remain > 0) {
+            SendEcho();
+        }
+    }
+};
+
+static void RunUntil(uv_loop_t *loop, bool (*done)(void *), void *arg) {
+    while (!done(arg)) {
+        uv_run(loop, UV_RUN_ONCE);
+    }
+}
+
+static int CallAndWait(uv_loop_t *loop, RpcClient &client, unsigned short id, const char *buf, unsigned int size,
+                       uint64_t timeout) {
+    client._lastStatus = 1;
+    CHECK(client._endpoint.Call(client.GetSession(), id, buf, size, nullptr, timeout) != 0);
+    RunUntil(loop, [](void *arg) { return static_cast<RpcClient *>(arg)->_lastStatus != 1; }, &client);
+    return client._lastStatus;
+}
+
+static void Benchmark(uv_loop_t *loop, RpcClient &client, unsigned int window, unsigned long long total) {
+    client._endpoint.ResetLatency();
+    client._remain = total;
+    client._done = client._errors = 0;
+    const uint64_t begin = uv_hrtime();
+    for (unsigned int n = 0; n < window; ++n) {
+        client.SendEcho();
+    }
+    RunUntil(loop, [](void *arg) {
+        auto client = static_cast<RpcClient *>(arg);
+        return client->_remain == 0 && client->_endpoint.PendingCount() == 0;
+    }, &client);
+    const double seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+    const Lcc::Utils::Histogram &latency = client._endpoint.Latency();
+    CHECK(client._done == total);
+    CHECK(client._errors == 0);
+    printf("window %3u: %llu calls, %.0f round-trips/s, p50 %.1f us, p99 %.1f us, max %.1f us\n", window, total,
+           total / seconds, latency.Percentile(50) / 1e3, latency.Percentile(99) / 1e3, latency.Max() / 1e3);
+}
+
+int main(int argc, char *argv[]) {
+    uv_loop_t *loop = uv_default_loop();
+    RpcServer server(loop);
+    auto serverFrame = new Lcc::FramePluginCreator;
+    serverFrame->Initialize(Lcc::FrameHeader::Varint, 0x10000);
+    server.Enable(serverFrame);
+    server.Listen(kHost);
+    RunUntil(loop, [](void *arg) { return static_cast<RpcServer *>(arg)->_listen != 0; }, &server);
+    CHECK(server._listen > 0);
+
+    RpcClient client(loop);
+    auto clientFrame = new Lcc::FramePluginCreator;
+    clientFrame->Initialize(Lcc::FrameHeader::Varint, 0x10000);
+    client.Enable(clientFrame);
+    client.Connect(kHost);
+    RunUntil(loop, [](void *arg) { return static_cast<RpcClient *>(arg)->_connected != 0; }, &client);
+    CHECK(client._connected > 0);
+
+    // 错误路径: 超时、未注册的消息、解码失败
+    const uint64_t begin = uv_now(loop);
+    CHECK(CallAndWait(loop, client, kMsgSilent, nullptr, 0, 20) == UV_ETIMEDOUT);
+    CHECK(uv_now(loop) - begin >= 20);
+    CHECK(CallAndWait(loop, client, kMsgUnknown, nullptr, 0, 1000) == UV_ENOSYS);
+    CHECK(CallAndWait(loop, client, kMsgEcho, "bad", 3, 1000) == UV_EPROTO);
+
+    Benchmark(loop, client, 1, 20000);
+    Benchmark(loop, client, 16, 100000);
+    Benchmark(loop, client, 256, 200000);
+
+    // 断开时在途请求以UV_ECONNRESET完成
+    client._lastStatus = 1;
+    client._endpoint.Call(client.GetSession(), kMsgSilent, nullptr, 0, nullptr, 1000);
+    client.Shutdown();
+    RunUntil(loop, [](void *arg) { return static_cast<RpcClient *>(arg)->_disconnected; }, &client);
+    CHECK(client._lastStatus == UV_ECONNRESET);
+    CHECK(client._endpoint.PendingCount() == 0);
+
+    client._endpoint.Release();
+    server._endpoint.Release();
+    server.Shutdown();
+    uv_run(loop, UV_RUN_DEFAULT);
+    uv_loop_close(loop);
+    if (_failed) {
+        printf("rpc fail %u\n", _failed);
+        return 1;
+    }
+    printf("rpc ok\n");
+    return 0;
+}
@@ -0,0 +1,372 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <uv.h>
+#include <network/ShmClient.h>
+#include <network/ShmServer.h>
+#include <network/TcpClient.h>
+#include <network/TcpServer.h>
+#include <network/plugin/FramePlugin.h>
+
+static const int kBenchPort = 18450;
+static const unsigned int kBenchSize = 64;
+static const unsigned int kPingPongs = 20000;
+static const unsigned int kMessages = 400000;
+static const unsigned int kWindow = 128;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+/**
+ * 回显服务端, 传输方式由模板参数决定, 回调与业务代码相同
+ */
+template<class Transport>
+class EchoServer : public Transport, public Lcc::ServerImplement {
+public:
+    explicit EchoServer(uv_loop_t *loop) : Transport(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    bool _echo = true;
+    int _listen = 0;
+    int _sessions = 0;
+    int _closeErr = 0;
+    bool _shutdown = false;
+    unsigned int _lastSession = 0;
+    std::vector<std::string> _received;
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : err;
+    }
+
+    void IServerShutdown() override {
+        _shutdown = true;
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        ++_sessions;
+        _lastSession = session;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        if (_echo) {
+            this->SessionWrite(session, buf, size);
+        } else {
+            _received.emplace_back(buf, size);
+        }
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+        _closeErr = err;
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        --_sessions;
+    }
+};
+
+template<class Transport>
+class Client : public Transport, public Lcc::ClientImplement {
+public:
+    explicit Client(uv_loop_t *loop) : Transport(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    int _connected = 0;
+    bool _disconnected = false;
+    int _closeErr = 0;
+    std::string _error;
+    std::vector<std::string> _received;
+    // 压测状态
+    unsigned int _target = 0;
+    unsigned int _sent = 0;
+    unsigned int _echoed = 0;
+    uint64_t _sentAt = 0;
+    std::vector<uint64_t> _latency;
+
+    bool IClientInit(Lcc::StreamHandle &handle) override {
+        handle.tcpSession = 1;
+        return handle.Init(_loop) == 0;
+    }
+
+    void IClientReport(bool connected, const char *err) override {
+        _connected = connected ? 1 : -1;
+        _error = err ? err : "";
+    }
+
+    void IClientReceive(const char *buf, unsigned int size) override {
+        if (_target == 0) {
+            _received.emplace_back(buf, size);
+            return;
+        }
+        ++_echoed;
+        if (_sentAt != 0) {
+            const uint64_t now = uv_hrtime();
+            _latency.push_back(now - _sentAt);
+            _sentAt = now;
+        }
+        if (_sent < _target) {
+            Send();
+        }
+    }
+
+    void IClientBeforeDisconnect(int err, const char *errMsg) override {
+        _closeErr = err;
+    }
+
+    void IClientAfterDisconnect() override {
+        _disconnected = true;
+    }
+
+    void Send() {
+        char message[kBenchSize];
+        memset(message, static_cast<int>(_sent & 0xff), sizeof(message));
+        ++_sent;
+        this->Write(message, sizeof(message));
+    }
+};
+
+using ShmEcho = EchoServer<Lcc::ShmServer>;
+using ShmPeer = Client<Lcc::ShmClient>;
+
+static bool RunUntil(uv_loop_t *loop, bool (*done)(void *), void *arg, uint64_t timeout = 5000) {
+    const uint64_t deadline = uv_now(loop) + timeout;
+    while (!done(arg)) {
+        if (uv_now(loop) > deadline) {
+            return false;
+        }
+        uv_run(loop, UV_RUN_ONCE);
+    }
+    return true;
+}
+
+template<class T>
+static bool Connected(uv_loop_t *loop, T &client, const std::string &url) {
+    client.Connect(url.c_str());
+    RunUntil(loop, [](void *arg) { return static_cast<T *>(arg)->_connected != 0; }, &client);
+    return client._connected == 1;
+}
+
+template<class T>
+static void Disconnect(uv_loop_t *loop, T &client) {
+    client.Shutdown();
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<T *>(arg)->GetSession() == 0; }, &client));
+}
+
+static std::string Message(unsigned int seq) {
+    return std::string(8 + (seq * 13) % 300, static_cast<char>('a' + seq % 26)) + std::to_string(seq);
+}
+
+/**
+ * 同一进程内的功能测试, 共享环取很小的容量以覆盖回绕与本地排队
+ */
+static void FunctionTest(uv_loop_t *loop, const std::string &url) {
+    ShmEcho server(loop);
+    server.Listen(url.c_str());
+    CHECK(server._listen == 1);
+    CHECK(server.GetListenAddress().protocol == Lcc::Utils::HostProtocol::Shm);
+    // 回显: 远超环容量的连续写入全部按序到达
+    {
+        ShmPeer client(loop);
+        client.SetCapacity(4096);
+        CHECK(Connected(loop, client, url));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmEcho *>(arg)->_sessions == 1; }, &server));
+        const unsigned int count = 5000;
+        for (unsigned int n = 0; n < count; ++n) {
+            const std::string message = Message(n);
+            client.Write(message.data(), static_cast<unsigned int>(message.size()));
+        }
+        CHECK(client.WriteQueueSize() > 4096);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmPeer *>(arg)->_received.size() >= 5000; }, &client));
+        CHECK(client._received.size() == count);
+        unsigned int bad = 0;
+        for (unsigned int n = 0; n < client._received.size(); ++n) {
+            bad += client._received[n] != Message(n);
+        }
+        CHECK(bad == 0);
+        CHECK(client.WriteQueueSize() == 0);
+        Disconnect(loop, client);
+        CHECK(client._disconnected && client._closeErr == 0);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmEcho *>(arg)->_sessions == 0; }, &server));
+        CHECK(server._closeErr == UV_EOF);
+        printf("echo ok\n");
+    }
+    // 关闭前写入的消息对端仍能收到
+    {
+        server._echo = false;
+        ShmPeer client(loop);
+        CHECK(Connected(loop, client, url));
+        client.Write("a", 1);
+        client.Write("bb", 2);
+        client.Write("", 0);
+        Disconnect(loop, client);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmEcho *>(arg)->_sessions == 0; }, &server));
+        CHECK(server._received.size() == 3);
+        if (server._received.size() == 3) {
+            CHECK(server._received[0] == "a" && server._received[1] == "bb" && server._received[2].empty());
+        }
+        server._echo = true;
+        printf("flush on close ok\n");
+    }
+    // 服务端关闭会话
+    {
+        ShmPeer client(loop);
+        CHECK(Connected(loop, client, url));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmEcho *>(arg)->_sessions == 1; }, &server));
+        server.ShutdownSession(server._lastSession);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmPeer *>(arg)->_disconnected; }, &client));
+        CHECK(client._closeErr == UV_EOF);
+        CHECK(client.GetSession() == 0);
+    }
+    // 超过单条上限
+    {
+        ShmPeer client(loop);
+        client.SetCapacity(4096);
+        CHECK(Connected(loop, client, url));
+        const std::string big(4096, 'x');
+        client.Write(big.data(), static_cast<unsigned int>(big.size()));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmPeer *>(arg)->_disconnected; }, &client));
+        CHECK(client._closeErr == UV_EMSGSIZE);
+    }
+    // 地址不是shm://时不连接
+    {
+        ShmPeer client(loop);
+        client.Connect("unix:///tmp/lcc-none.sock");
+        CHECK(client.GetSession() == 0);
+    }
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmEcho *>(arg)->_sessions == 0; }, &server));
+    server.Shutdown();
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmEcho *>(arg)->_shutdown; }, &server));
+    // 连接不存在的路径
+    {
+        ShmPeer client(loop);
+        CHECK(!Connected(loop, client, url));
+        CHECK(client._error == uv_strerror(UV_ENOENT));
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<ShmPeer *>(arg)->GetSession() == 0; }, &client));
+    }
+}
+
+/**
+ * 子进程: 同时提供共享内存与TCP回显, 父进程关闭通知套接字后退出
+ */
+static int BenchServer(const std::string &url, int notify) {
+    uv_loop_t *loop = uv_default_loop();
+    ShmEcho shm(loop);
+    shm.Listen(url.c_str());
+    EchoServer<Lcc::TcpServer> tcp(loop);
+    auto frame = new Lcc::FramePluginCreator;
+    frame->Initialize(Lcc::FrameHeader::Varint, 0x10000);
+    tcp.Enable(frame);
+    tcp.Listen(("tcp://127.0.0.1:" + std::to_string(kBenchPort)).c_str());
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer<Lcc::TcpServer> *>(arg)->_listen != 0; }, &tcp);
+    const char ready = (shm._listen == 1 && tcp._listen == 1) ? 'y' : 'n';
+    if (write(notify, &ready, 1) != 1 || ready != 'y') {
+        return 1;
+    }
+    uv_poll_t poll;
+    uv_poll_init(loop, &poll, notify);
+    struct Servers {
+        ShmEcho *shm;
+        EchoServer<Lcc::TcpServer> *tcp;
+    } servers{&shm, &tcp};
+    poll.data = &servers;
+    uv_poll_start(&poll, UV_READABLE | UV_DISCONNECT, [](uv_poll_t *handle, int status, int events) {
+        auto servers = static_cast<Servers *>(handle->data);
+        servers->shm->Shutdown();
+        servers->tcp->Shutdown();
+        uv_close(reinterpret_cast<uv_handle_t *>(handle), nullptr);
+    });
+    uv_run(loop, UV_RUN_DEFAULT);
+    return uv_loop_close(loop) == 0 ? 0 : 1;
+}
+
+/**
+ * 跨进程压测: 单条往返时延与保持窗口的吞吐
+ */
+template<class T>
+static void Benchmark(uv_loop_t *loop, const char *name, T &client, const std::string &url) {
+    CHECK(Connected(loop, client, url));
+    if (client._connected != 1) {
+        return;
+    }
+    // 往返时延: 同一时刻只有一条消息
+    client._target = kPingPongs;
+    client._sentAt = uv_hrtime();
+    client.Send();
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<T *>(arg)->_echoed == kPingPongs; }, &client, 30000));
+    std::vector<uint64_t> latency(client._latency);
+    std::sort(latency.begin(), latency.end());
+    // 吞吐: 保持窗口内的消息数
+    client._sentAt = 0;
+    client._sent = client._echoed = 0;
+    client._target = kMessages;
+    const uint64_t begin = uv_hrtime();
+    for (unsigned int n = 0; n < kWindow; ++n) {
+        client.Send();
+    }
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<T *>(arg)->_echoed == kMessages; }, &client, 30000));
+    const double seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+    if (!latency.empty()) {
+        printf("%-4s %u bytes: rtt p50 %6.1f us p99 %6.1f us, window %u: %10.0f msg/s\n", name, kBenchSize,
+               latency[latency.size() / 2] / 1e3, latency[latency.size() * 99 / 100] / 1e3, kWindow,
+               client._echoed / seconds);
+    }
+    Disconnect(loop, client);
+}
+
+int main(int argc, char *argv[]) {
+    // 对端退出后写入套接字会触发SIGPIPE
+    signal(SIGPIPE, SIG_IGN);
+    const std::string path = "/tmp/lcc-shm-" + std::to_string(getpid()) + ".sock";
+    const std::string url = "shm://" + path;
+    // 在创建事件循环前启动压测用的子进程
+    int notify[2];
+    CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, notify) == 0);
+    const pid_t child = fork();
+    if (child == 0) {
+        close(notify[1]);
+        _exit(BenchServer("shm://" + path + ".bench", notify[0]));
+    }
+    close(notify[0]);
+
+    uv_loop_t *loop = uv_default_loop();
+    FunctionTest(loop, url);
+
+    char ready = 0;
+    CHECK(read(notify[1], &ready, 1) == 1 && ready == 'y');
+    if (ready == 'y') {
+        ShmPeer shm(loop);
+        Benchmark(loop, "shm", shm, url + ".bench");
+        Client<Lcc::TcpClient> tcp(loop);
+        auto frame = new Lcc::FramePluginCreator;
+        frame->Initialize(Lcc::FrameHeader::Varint, 0x10000);
+        tcp.Enable(frame);
+        Benchmark(loop, "tcp", tcp, "tcp://127.0.0.1:" + std::to_string(kBenchPort));
+    }
+    close(notify[1]);
+    int status = 0;
+    CHECK(waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    uv_run(loop, UV_RUN_DEFAULT);
+    CHECK(uv_loop_close(loop) == 0);
+    if (_failed) {
+        printf("shm channel fail %u\n", _failed);
+        return 1;
+    }
+    printf("shm channel ok\n");
+    return 0;
+}
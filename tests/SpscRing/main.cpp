@@ -0,0 +1,203 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <buffer/SpscRing.h>
+#include <libuv/uv.h>
+#include <concurrentqueue.h>
+
+static const unsigned int kMessages = 2000000;
+static const unsigned int kBatch = 32;
+
+// 变长记录: 序号 + 填充
+static unsigned int MessageSize(unsigned int seq) {
+    return 8 + (seq * 7) % 249;
+}
+
+struct RingContext {
+    Lcc::SpscRing ring;
+};
+
+static void RingProducer(void *arg) {
+    auto ctx = static_cast<RingContext *>(arg);
+    for (unsigned int seq = 0; seq < kMessages; ++seq) {
+        const unsigned int size = MessageSize(seq);
+        char *data;
+        while (!(data = ctx->ring.Reserve(size))) {
+            ctx->ring.Publish();
+            std::this_thread::yield();
+        }
+        memcpy(data, &seq, sizeof(seq));
+        memset(data + sizeof(seq), static_cast<int>(seq & 0xff), size - sizeof(seq));
+        if (seq % kBatch == kBatch - 1) {
+            ctx->ring.Publish();
+        }
+    }
+    ctx->ring.Publish();
+}
+
+static bool BenchRing(double &seconds) {
+    RingContext ctx;
+    ctx.ring.Initialize(0x40000);
+    uv_thread_t producer;
+    const uint64_t begin = uv_hrtime();
+    uv_thread_create(&producer, RingProducer, &ctx);
+    unsigned int expect = 0;
+    Lcc::SpscSpan spans[64];
+    while (expect < kMessages) {
+        const unsigned int n = ctx.ring.Read(spans, 64);
+        if (n == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (unsigned int i = 0; i < n; ++i) {
+            unsigned int seq;
+            memcpy(&seq, spans[i].data, sizeof(seq));
+            if (seq != expect || spans[i].size != MessageSize(seq) ||
+                static_cast<unsigned char>(spans[i].data[spans[i].size - 1]) != (seq & 0xff)) {
+                printf("ring mismatch at %u\n", expect);
+                uv_thread_join(&producer);
+                return false;
+            }
+            ++expect;
+        }
+        ctx.ring.Release();
+    }
+    seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+    uv_thread_join(&producer);
+    return true;
+}
+
+static void QueueProducer(void *arg) {
+    auto queue = static_cast<moodycamel::ConcurrentQueue<void *> *>(arg);
+    for (unsigned int seq = 0; seq < kMessages; ++seq) {
+        const unsigned int size = MessageSize(seq);
+        auto data = static_cast<char *>(::malloc(size));
+        memcpy(data, &seq, sizeof(seq));
+        memset(data + sizeof(seq), static_cast<int>(seq & 0xff), size - sizeof(seq));
+        queue->enqueue(data);
+    }
+}
+
+static void BenchQueue(double &seconds) {
+    moodycamel::ConcurrentQueue<void *> queue;
+    uv_thread_t producer;
+    const uint64_t begin = uv_hrtime();
+    uv_thread_create(&producer, QueueProducer, &queue);
+    unsigned int received = 0;
+    void *messages[64];
+    while (received < kMessages) {
+        const size_t n = queue.try_dequeue_bulk(messages, 64);
+        if (n == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            ::free(messages[i]);
+        }
+        received += static_cast<unsigned int>(n);
+    }
+    seconds = static_cast<double>(uv_hrtime() - begin) / 1e9;
+    uv_thread_join(&producer);
+}
+
+/**
+ * 共享段中的一对环: 生产者写入两条记录后按case改写段内容, 消费者应先拿到完好的第一条, 再以UV_EPROTO拒绝第二条
+ */
+static bool CorruptCase(int which) {
+    static const unsigned int kCapacity = 256;
+    alignas(64) static char chunk[kCapacity];
+    static Lcc::SpscControl control;
+    memset(chunk, 0, sizeof(chunk));
+    // 从靠近末尾的位置开始, 第二条记录需要回绕
+    control.head.store(kCapacity - 48);
+    control.tail.store(kCapacity - 48);
+    Lcc::SpscRing producer;
+    Lcc::SpscRing consumer;
+    producer.Attach(&control, chunk, kCapacity);
+    consumer.Attach(&control, chunk, kCapacity);
+    const char first[16] = "first";
+    const char second[40] = "second";
+    producer.Write(first, sizeof(first));
+    producer.Write(second, sizeof(second));
+    producer.Publish();
+    auto header = [](unsigned int offset) {
+        return reinterpret_cast<unsigned int *>(chunk + offset);
+    };
+    // 第一条在kCapacity-48, 回绕标记在kCapacity-24, 第二条在0
+    switch (which) {
+        case 1:
+            // 长度超出单条记录上限, 按长度计算记录大小会回绕
+            *header(0) = 0xfffffff0U;
+            break;
+        case 2:
+            // 长度合法但超出已发布的范围
+            *header(0) = consumer.MaxRecordSize();
+            break;
+        case 3:
+            // 回绕后又是回绕标记
+            *header(0) = 0xffffffffU;
+            break;
+        case 4:
+            // 发布位置超出容量
+            control.tail.store(control.tail.load() + kCapacity);
+            break;
+        case 5:
+            // 回绕标记改为越过末尾的记录
+            *header(kCapacity - 24) = 20;
+            break;
+        default:
+            break;
+    }
+    Lcc::SpscSpan span{};
+    if (which == 4) {
+        // 位置本身不可信, 第一条也不返回
+        return !consumer.Peek(span) && consumer.LastErrCode() == UV_EPROTO;
+    }
+    if (!consumer.Peek(span) || span.size != sizeof(first) || strcmp(span.data, first) != 0) {
+        return false;
+    }
+    if (which == 0) {
+        return consumer.Peek(span) && span.size == sizeof(second) && strcmp(span.data, second) == 0 &&
+               !consumer.Peek(span) && consumer.LastErrCode() == 0;
+    }
+    // 出错后不再返回记录
+    return !consumer.Peek(span) && consumer.LastErrCode() == UV_EPROTO && !consumer.Peek(span);
+}
+
+static bool CorruptTest() {
+    for (int which = 0; which <= 5; ++which) {
+        if (!CorruptCase(which)) {
+            printf("spsc ring corrupt case %d fail\n", which);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    // 堆上分配同样按缓存行对齐, 生产者与消费者的位置不共享缓存行
+    auto heapRing = new Lcc::SpscRing;
+    const bool aligned = reinterpret_cast<uintptr_t>(heapRing) % 64 == 0;
+    delete heapRing;
+    if (!aligned || sizeof(Lcc::SpscControl) != 128) {
+        printf("spsc ring alignment fail\n");
+        return 1;
+    }
+    if (!CorruptTest()) {
+        return 1;
+    }
+    double ring = 0;
+    double queue = 0;
+    if (!BenchRing(ring)) {
+        return 1;
+    }
+    BenchQueue(queue);
+    printf("%-28s %12.0f msg/s\n", "SpscRing (batch publish)", kMessages / ring);
+    printf("%-28s %12.0f msg/s\n", "ConcurrentQueue + malloc", kMessages / queue);
+    return 0;
+}
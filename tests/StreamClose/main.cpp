@@ -0,0 +1,128 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <functional>
+#include <dirent.h>
+#include <network/TcpServer.h>
+
+static const char *kHost = "tcp://127.0.0.1:18437";
+static const unsigned int kPort = 18437;
+static const unsigned int kClients = 20;
+
+static unsigned int _failed = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("check fail: %s (line %d)\n", #cond, __LINE__); ++_failed; } } while (0)
+
+// 当前进程打开的文件描述符数量
+static int OpenFiles() {
+    int count = 0;
+    DIR *dir = opendir("/proc/self/fd");
+    if (!dir) {
+        return -1;
+    }
+    while (readdir(dir)) {
+        ++count;
+    }
+    closedir(dir);
+    return count;
+}
+
+static void RunUntil(uv_loop_t *loop, const std::function<bool()> &done) {
+    const uint64_t deadline = uv_hrtime() + 5000000000ULL;
+    while (!done() && uv_hrtime() < deadline) {
+        uv_run(loop, UV_RUN_NOWAIT);
+    }
+}
+
+class Server : public Lcc::TcpServer, public Lcc::ServerImplement {
+public:
+    explicit Server(uv_loop_t *loop) : Lcc::TcpServer(this), _loop(loop), listen(0), opened(0), resets(0), closed(0) {
+    }
+
+    uv_loop_t *_loop;
+    int listen;
+    unsigned int opened;
+    unsigned int resets;
+    unsigned int closed;
+
+protected:
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        listen = listened ? 1 : -1;
+    }
+
+    void IServerShutdown() override {
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        ++opened;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+        if (err == UV_ECONNRESET) {
+            ++resets;
+        }
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        ++closed;
+    }
+};
+
+/**
+ * 对端RST断开: 读错误会清除流的可写标记, uv_shutdown同步失败且不回调, 会话须直接关闭
+ */
+static void ResetTest(uv_loop_t *loop) {
+    Server server(loop);
+    server.Listen(kHost);
+    RunUntil(loop, [&] { return server.listen != 0; });
+    CHECK(server.listen > 0);
+    const int before = OpenFiles();
+
+    sockaddr_in addr{};
+    uv_ip4_addr("127.0.0.1", kPort, &addr);
+    uv_tcp_t clients[kClients];
+    uv_connect_t connects[kClients];
+    unsigned int connected = 0;
+    for (unsigned int n = 0; n < kClients; ++n) {
+        uv_tcp_init(loop, &clients[n]);
+        connects[n].data = &connected;
+        uv_tcp_connect(&connects[n], &clients[n], reinterpret_cast<const sockaddr *>(&addr), [](uv_connect_t *req, int status) {
+            if (status == 0) {
+                ++*static_cast<unsigned int *>(req->data);
+            }
+        });
+    }
+    RunUntil(loop, [&] { return connected == kClients && server.opened == kClients; });
+    CHECK(server.opened == kClients);
+    for (auto &client: clients) {
+        uv_tcp_close_reset(&client, nullptr);
+    }
+    RunUntil(loop, [&] { return server.closed == kClients; });
+    CHECK(server.resets == kClients);
+    CHECK(server.closed == kClients);
+    CHECK(OpenFiles() == before);
+
+    server.Shutdown();
+    uv_run(loop, UV_RUN_DEFAULT);
+    printf("reset close: %u/%u sessions closed\n", server.closed, kClients);
+}
+
+int main(int argc, char *argv[]) {
+    uv_loop_t *loop = uv_default_loop();
+    ResetTest(loop);
+    uv_loop_close(loop);
+    if (_failed) {
+        printf("stream close fail: %u\n", _failed);
+        return 1;
+    }
+    printf("stream close ok\n");
+    return 0;
+}
@@ -0,0 +1,240 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <condition_variable>
+#include <thread/TaskScheduler.h>
+
+static const unsigned int kItems = 200000;
+static const unsigned int kGrain = 64;
+
+// 模拟一次寻路/AI计算
+static unsigned long long Work(unsigned int i) {
+    unsigned long long h = i + 0x9e3779b97f4a7c15ULL;
+    for (int n = 0; n < 200; ++n) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+    }
+    return h & 1;
+}
+
+/**
+ * 对照组: 单互斥锁队列线程池
+ */
+class MutexPool {
+public:
+    explicit MutexPool(unsigned int workers) : _stop(false), _remaining(0), _sum(0) {
+        for (unsigned int n = 0; n < workers; ++n) {
+            _threads.emplace_back(&MutexPool::Run, this);
+        }
+    }
+
+    ~MutexPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cond.notify_all();
+        for (auto &thread: _threads) {
+            thread.join();
+        }
+    }
+
+    unsigned long long ParallelFor(unsigned int begin, unsigned int end, unsigned int grain) {
+        _sum = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (unsigned int i = begin; i < end; i += grain) {
+                _ranges.emplace_back(i, std::min(end, i + grain));
+                ++_remaining;
+            }
+        }
+        _cond.notify_all();
+        std::unique_lock<std::mutex> lock(_mutex);
+        _doneCond.wait(lock, [this] { return _remaining == 0; });
+        return _sum;
+    }
+
+private:
+    void Run() {
+        for (;;) {
+            std::pair<unsigned int, unsigned int> range;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cond.wait(lock, [this] { return _stop || !_ranges.empty(); });
+                if (_stop) {
+                    return;
+                }
+                range = _ranges.front();
+                _ranges.pop_front();
+            }
+            unsigned long long sum = 0;
+            for (unsigned int i = range.first; i < range.second; ++i) {
+                sum += Work(i);
+            }
+            _sum.fetch_add(sum);
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_remaining == 0) {
+                _doneCond.notify_all();
+            }
+        }
+    }
+
+private:
+    bool _stop;
+    unsigned int _remaining;
+    std::atomic<unsigned long long> _sum;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::condition_variable _doneCond;
+    std::deque<std::pair<unsigned int, unsigned int> > _ranges;
+    std::vector<std::thread> _threads;
+};
+
+/**
+ * 在工作线程事件循环上启动定时器, 验证任务内可以使用异步I/O
+ */
+class TimerTask : public Lcc::Task {
+public:
+    std::atomic<bool> fired{false};
+
+protected:
+    void ITaskExecute(Lcc::TaskWorker *worker) override {
+        uv_timer_init(worker->Loop(), &_timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t *>(&_timer), this);
+        uv_timer_start(&_timer, [](uv_timer_t *timer) {
+            auto self = static_cast<TimerTask *>(uv_handle_get_data(reinterpret_cast<const uv_handle_t *>(timer)));
+            self->fired = true;
+            uv_close(reinterpret_cast<uv_handle_t *>(timer), nullptr);
+        }, 10, 0);
+    }
+
+private:
+    uv_timer_t _timer{};
+};
+
+class ContinuationTask : public Lcc::Task {
+public:
+    std::atomic<bool> executed{false};
+
+protected:
+    void ITaskExecute(Lcc::TaskWorker *worker) override {
+        executed = true;
+    }
+};
+
+/**
+ * 占住工作线程, 使后续提交的任务在关闭时仍未执行
+ */
+class BlockTask : public Lcc::Task {
+protected:
+    void ITaskExecute(Lcc::TaskWorker *worker) override {
+        uv_sleep(50);
+    }
+};
+
+class CountTask : public Lcc::Task {
+public:
+    explicit CountTask(std::atomic<unsigned int> *released) : _released(released) {
+    }
+
+protected:
+    void ITaskExecute(Lcc::TaskWorker *worker) override {
+    }
+
+    void ITaskRelease() override {
+        _released->fetch_add(1);
+        delete this;
+    }
+
+private:
+    std::atomic<unsigned int> *_released;
+};
+
+int main(int argc, char *argv[]) {
+    unsigned long long expect = 0;
+    for (unsigned int i = 0; i < kItems; ++i) {
+        expect += Work(i);
+    }
+    printf("%-8s %16s %16s %12s\n", "workers", "steal(items/s)", "mutex(items/s)", "stolen");
+    const unsigned int workers[] = {1, 2, 4, 8, 16, 32, 64};
+    for (const unsigned int count: workers) {
+        Lcc::TaskScheduler scheduler;
+        if (!scheduler.Startup(count)) {
+            printf("scheduler startup fail\n");
+            return 1;
+        }
+        std::atomic<unsigned long long> sum(0);
+        uint64_t begin = uv_hrtime();
+        scheduler.ParallelFor(0, kItems, kGrain, [&sum](unsigned int i) {
+            sum.fetch_add(Work(i), std::memory_order_relaxed);
+        });
+        const double steal = static_cast<double>(uv_hrtime() - begin) / 1e9;
+        if (sum != expect) {
+            printf("work stealing result mismatch\n");
+            return 1;
+        }
+        unsigned long long stolen = 0;
+        for (unsigned int n = 0; n < scheduler.WorkerCount(); ++n) {
+            stolen += scheduler.GetWorker(n)->Stolen();
+        }
+        scheduler.Shutdown();
+
+        MutexPool pool(count);
+        begin = uv_hrtime();
+        if (pool.ParallelFor(0, kItems, kGrain) != expect) {
+            printf("mutex pool result mismatch\n");
+            return 1;
+        }
+        const double mutex = static_cast<double>(uv_hrtime() - begin) / 1e9;
+        printf("%-8u %16.0f %16.0f %12llu\n", count, kItems / steal, kItems / mutex, stolen);
+    }
+
+    // 任务组完成后的后续任务, 以及工作线程内的异步定时器
+    Lcc::TaskScheduler scheduler;
+    scheduler.Startup(2);
+    ContinuationTask continuation;
+    TimerTask timer;
+    Lcc::TaskGroup group;
+    group.Then(&continuation);
+    scheduler.Spawn(&timer, &group);
+    group.Wait(&scheduler);
+    while (!continuation.executed || !timer.fired) {
+        uv_sleep(1);
+    }
+    printf("continuation and worker timer ok\n");
+    scheduler.Shutdown();
+
+    // 关闭时未执行的任务也要计入任务组, 否则Wait永久阻塞
+    const unsigned int pending = 1000;
+    std::atomic<unsigned int> released(0);
+    BlockTask block;
+    Lcc::TaskGroup shutdownGroup;
+    scheduler.Startup(1);
+    scheduler.Spawn(&block, &shutdownGroup);
+    for (unsigned int n = 0; n < pending; ++n) {
+        scheduler.Spawn(new CountTask(&released), &shutdownGroup);
+    }
+    scheduler.Shutdown();
+    shutdownGroup.Wait(&scheduler);
+    if (shutdownGroup.Pending() != 0 || released != pending) {
+        printf("shutdown drain mismatch: pending %d, released %u\n", shutdownGroup.Pending(), released.load());
+        return 1;
+    }
+
+    // 没有工作线程时ParallelFor在调用线程内执行
+    unsigned long long inlineSum = 0;
+    scheduler.ParallelFor(0, 100, kGrain, [&](unsigned int i) {
+        inlineSum += i;
+    });
+    if (inlineSum != 4950) {
+        printf("inline parallel for mismatch\n");
+        return 1;
+    }
+    printf("shutdown drain and inline parallel for ok\n");
+    return 0;
+}
@@ -13,7 +13,7 @@ public:
 
     inline bool IClientInit(Lcc::StreamHandle &handle) override {
         handle.tcpSession = 1;
-        uv_tcp_init(g_loop, &handle.tcpHandle);
+        handle.Init(g_loop);
         return true;
     }
 
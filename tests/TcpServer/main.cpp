@@ -11,8 +11,8 @@ public:
     explicit TcpServer() : Lcc::TcpServer(this) {
     }
 
-    bool IServerInit(uv_tcp_t *handle) override {
-        uv_tcp_init(g_loop, handle);
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        handle.Init(g_loop);
         return true;
     }
 
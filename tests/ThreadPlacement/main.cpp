@@ -0,0 +1,91 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <vector>
+#include <pthread.h>
+#include <thread/Thread.h>
+#include <thread/Topology.h>
+
+class Thread : public Lcc::Thread {
+public:
+    explicit Thread(bool init) : _init(init) {
+    }
+
+    ~Thread() override = default;
+
+protected:
+    inline bool IInit() override {
+        if (!_init) {
+            return false;
+        }
+        char name[16] = {0};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        std::vector<char> mask(uv_cpumask_size() > 0 ? uv_cpumask_size() : 1, 0);
+        uv_thread_t self = uv_thread_self();
+        uv_thread_getaffinity(&self, mask.data(), mask.size());
+        printf("Thread::IInit name[%s] cpu[%d] affinity[", name, uv_thread_getcpu());
+        for (size_t n = 0; n < mask.size(); ++n) {
+            if (mask[n]) {
+                printf(" %zu", n);
+            }
+        }
+        printf(" ]\n");
+        return true;
+    }
+
+    inline void IMessage(void *message) override {
+    }
+
+    inline void IShutdown() override {
+        printf("Thread::IShutdown\n");
+    }
+
+private:
+    bool _init;
+};
+
+static void PrintOptions(const char *kind, const std::vector<Lcc::ThreadOptions> &options) {
+    for (const auto &it: options) {
+        printf("%s %-12s node[%d] cpus[", kind, it.name.c_str(), it.numaNode);
+        for (const int cpu: it.cpus) {
+            printf(" %d", cpu);
+        }
+        printf(" ]\n");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    Lcc::CpuTopology topology;
+    if (!topology.Load()) {
+        printf("/sys topology unavailable, fallback to uv_available_parallelism\n");
+    }
+    printf("cpus[%u] nodes[%u]\n", topology.CpuCount(), topology.NodeCount());
+    for (const auto &cpu: topology.Cpus()) {
+        printf("  cpu%-3d core[%d] package[%d] node[%d]\n", cpu.id, cpu.core, cpu.package, cpu.node);
+    }
+
+    std::vector<Lcc::ThreadOptions> network;
+    std::vector<Lcc::ThreadOptions> logic;
+    topology.Layout(2, 4, network, logic);
+    PrintOptions("network", network);
+    PrintOptions("logic  ", logic);
+
+    Lcc::ThreadOptions options = network.front();
+    options.stackSize = 0x40000;
+    Thread thread(true);
+    if (!thread.Startup(options)) {
+        printf("thread startup fail [%d]\n", thread.LastErrCode());
+        return 1;
+    }
+    thread.Shutdown();
+
+    // IInit失败时Startup应直接返回false
+    Thread failed(false);
+    if (failed.Startup()) {
+        printf("expect startup fail\n");
+        return 1;
+    }
+    printf("init failure handled\n");
+    return 0;
+}
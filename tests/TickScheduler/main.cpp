@@ -0,0 +1,193 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <csignal>
+#include <cstdio>
+#include <thread/Application.h>
+
+// 模拟一步逻辑计算
+static unsigned long long Work(unsigned int rounds) {
+    unsigned long long h = 0x9e3779b97f4a7c15ULL;
+    for (unsigned int n = 0; n < rounds; ++n) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+    }
+    return h;
+}
+
+class Application : public Lcc::Application {
+public:
+    Application(unsigned int seconds, unsigned long long stall, bool reset = false) : _seconds(seconds),
+        _stall(stall), _reset(reset), _begin(0), _sink(0) {
+    }
+
+    ~Application() override = default;
+
+    inline unsigned long long Elapsed() const { return _elapsed; }
+
+    inline unsigned long long Ticks() const { return _ticks; }
+
+    inline unsigned long long Gaps() const { return _gaps; }
+
+    using Lcc::Application::TickStepsAt;
+    using Lcc::Application::TickOffset;
+
+protected:
+    inline bool IInit() override {
+        _begin = uv_hrtime();
+        return true;
+    }
+
+    inline void IRun() override {
+    }
+
+    inline void IShutdown() override {
+        _elapsed = uv_hrtime() - _begin;
+    }
+
+    inline void ITickInput(const Lcc::TickContext &context) override {
+        _sink += Work(500);
+    }
+
+    inline void ITickSimulate(const Lcc::TickContext &context) override {
+        // 步序号从0开始连续递增, 与统计是否被清空无关
+        if (context.tick != _ticks) {
+            ++_gaps;
+        }
+        _ticks = context.tick + 1;
+        _sink += Work(5000);
+        // 在第1秒处制造一次卡顿, 验证追帧与丢帧
+        if (_stall && context.tick == static_cast<unsigned long long>(1.0 / context.dt)) {
+            uv_sleep(static_cast<unsigned int>(_stall));
+        }
+    }
+
+    inline void ITickBroadcast(const Lcc::TickContext &context) override {
+        _sink += Work(1000);
+        if (_reset && context.tick == static_cast<unsigned long long>(0.5 / context.dt)) {
+            ResetTickStats();
+        }
+        if (context.now - _begin >= _seconds * 1000000000ULL) {
+            Shutdown();
+        }
+    }
+
+    inline void ITickLate(unsigned long long lateness, unsigned long long cost) override {
+        printf("  late frame: lateness %.3fms cost %.3fms\n", lateness / 1e6, cost / 1e6);
+    }
+
+private:
+    unsigned int _seconds;
+    unsigned long long _stall;
+    bool _reset;
+    unsigned long long _begin;
+    unsigned long long _elapsed{0};
+    unsigned long long _ticks{0};
+    unsigned long long _gaps{0};
+    unsigned long long _sink;
+};
+
+static void Print(const char *name, const Lcc::Utils::Histogram &histogram) {
+    printf("  %-10s p50 %8.3fms p99 %8.3fms max %8.3fms\n", name, histogram.Percentile(50) / 1e6,
+           histogram.Percentile(99) / 1e6, histogram.Max() / 1e6);
+}
+
+static bool Run(unsigned int hz, unsigned int seconds, unsigned int stall, unsigned int catchUp,
+                bool reset = false) {
+    Application app(seconds, stall, reset);
+    Lcc::TickOptions options(hz);
+    options.maxCatchUp = catchUp;
+    if (!app.EnableTick(options)) {
+        printf("enable tick fail\n");
+        return false;
+    }
+    app.Run();
+    const Lcc::TickStats &stats = app.GetTickStats();
+    const double expect = app.Elapsed() / 1e9 * hz;
+    printf("%uHz stall %ums catch-up %u: ticks %llu (expect %.0f) frames %llu late %llu dropped %llu\n", hz, stall,
+           catchUp, stats.ticks, expect, stats.frames, stats.lateFrames, stats.droppedTicks);
+    printf("  over budget: input %llu simulate %llu broadcast %llu\n", stats.overBudget[0], stats.overBudget[1],
+           stats.overBudget[2]);
+    Print("lateness", stats.lateness);
+    Print("frame", stats.frame);
+    Print("input", stats.phases[static_cast<int>(Lcc::TickPhase::Input)]);
+    Print("simulate", stats.phases[static_cast<int>(Lcc::TickPhase::Simulate)]);
+    Print("broadcast", stats.phases[static_cast<int>(Lcc::TickPhase::Broadcast)]);
+    if (app.Gaps() != 0) {
+        printf("tick index not continuous: %llu gaps\n", app.Gaps());
+        return false;
+    }
+    if (reset) {
+        // 清空的只是统计, 之后的步序号照常递增
+        if (stats.ticks == 0 || stats.ticks >= app.Ticks() || app.Ticks() + 1 < expect) {
+            printf("tick index rewound by stats reset\n");
+            return false;
+        }
+        return true;
+    }
+    // 每帧至少推进一步, 否则计划时间不前进导致空转
+    if (stats.ticks < stats.frames) {
+        printf("frame without step detected\n");
+        return false;
+    }
+    // 未丢帧时步数应与墙钟严格对应
+    if (stats.droppedTicks == 0 && (stats.ticks + 1 < expect || stats.ticks > expect + 2)) {
+        printf("tick drift detected\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * 时间轴换算在长时间运行后不溢出, 结果与128位精确计算一致
+ */
+static bool TimelineTest() {
+    const unsigned int rates[] = {1, 20, 30, 60, 144, 1000};
+    const unsigned long long days[] = {0, 1, 213, 214, 1000, 100000};
+    for (const unsigned int hz: rates) {
+        for (const unsigned long long day: days) {
+            for (unsigned long long extra = 0; extra < 3 * hz; ++extra) {
+                const unsigned long long index = day * 86400ULL * hz + extra;
+                const unsigned __int128 exact = (static_cast<unsigned __int128>(index) * 1000000000ULL + hz - 1) / hz;
+                const unsigned long long offset = Application::TickOffset(index, hz);
+                if (offset != static_cast<unsigned long long>(exact)) {
+                    printf("tick offset overflow: %uHz index %llu\n", hz, index);
+                    return false;
+                }
+                // 到达计划时间时正好开始第index步, 早1纳秒还未开始
+                if (Application::TickStepsAt(offset, hz) != index ||
+                    (index > 0 && Application::TickStepsAt(offset - 1, hz) != index - 1)) {
+                    printf("tick steps mismatch: %uHz index %llu\n", hz, index);
+                    return false;
+                }
+            }
+        }
+    }
+    printf("timeline ok\n");
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    if (!TimelineTest()) {
+        return 1;
+    }
+    const unsigned int rates[] = {20, 30, 60};
+    for (const unsigned int hz: rates) {
+        if (!Run(hz, 2, 0, 5)) {
+            return 1;
+        }
+    }
+    // 卡顿可被追帧吸收
+    if (!Run(60, 2, 50, 5)) {
+        return 1;
+    }
+    // 卡顿超出追帧上限, 丢弃积压步数
+    if (!Run(60, 2, 200, 5)) {
+        return 1;
+    }
+    // 运行中清空统计
+    if (!Run(60, 1, 0, 5, true)) {
+        return 1;
+    }
+    return 0;
+}
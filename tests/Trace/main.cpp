@@ -0,0 +1,126 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <uv.h>
+#include <trace/Trace.h>
+
+static const char *kBinary = "trace_test.bin";
+static const char *kJson = "trace_test.json";
+static const unsigned int kEvents = 1000000;
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+static std::string ReadFile(const char *path) {
+    std::string content;
+    FILE *file = fopen(path, "rb");
+    if (file) {
+        char buf[4096];
+        size_t n = 0;
+        while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+            content.append(buf, n);
+        }
+        fclose(file);
+    }
+    return content;
+}
+
+static size_t Count(const std::string &text, const std::string &needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+static void TestRoundTrip() {
+    // 主线程: 一个包的读写全过程, 会话沿用当前作用域
+    Lcc::Trace::SetThreadName("net-0");
+    {
+        Lcc::Trace::Scope scope(7);
+        Lcc::Trace::Emit(Lcc::Trace::Stage::StreamRead, Lcc::Trace::Scope::Current(), 64);
+        Lcc::Trace::Emit(Lcc::Trace::Stage::WsRead, Lcc::Trace::Scope::Current(), 58);
+        Lcc::Trace::Emit(Lcc::Trace::Stage::UserReceive, Lcc::Trace::Scope::Current(), 58);
+        Lcc::Trace::Emit(Lcc::Trace::Stage::UserWrite, Lcc::Trace::Scope::Current(), 10);
+        Lcc::Trace::Emit(Lcc::Trace::Stage::StreamWrite, Lcc::Trace::Scope::Current(), 12);
+    }
+    CHECK(Lcc::Trace::Scope::Current() == 0);
+    Lcc::Trace::Emit(Lcc::Trace::Stage::WriteDone, 7, 12);
+
+    // 其他线程写入自己的缓冲, 退出后记录仍可转储
+    std::thread worker([]() {
+        Lcc::Trace::Emit(Lcc::Trace::Stage::StreamRead, 9, 100);
+    });
+    worker.join();
+
+    CHECK(Lcc::Trace::Dump(kBinary) == 0);
+    CHECK(Lcc::Trace::ConvertToJson(kBinary, kJson) == 0);
+    const std::string json = ReadFile(kJson);
+    CHECK(json.compare(0, 1, "{") == 0);
+    CHECK(json.find("\"traceEvents\":[") != std::string::npos);
+    CHECK(json.find("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"net-0\"}}") != std::string::npos);
+    CHECK(json.find("\"args\":{\"name\":\"session 7\"}") != std::string::npos);
+    CHECK(json.find("\"args\":{\"name\":\"session 9\"}") != std::string::npos);
+    CHECK(Count(json, "\"ph\":\"i\"") == 7);
+    CHECK(Count(json, "\"name\":\"UserReceive\"") == 1);
+    CHECK(json.find("\"name\":\"uv_write\",\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("\"tid\":7,\"args\":{\"bytes\":58,\"arg\":0}") != std::string::npos);
+    CHECK(json.find("\n]}\n") == json.size() - 4);
+
+    // 格式错误与文件不存在
+    CHECK(Lcc::Trace::ConvertToJson(kJson, "trace_bad.json") == UV_EINVAL);
+    CHECK(Lcc::Trace::ConvertToJson("trace_missing.bin", "trace_bad.json") == UV_ENOENT);
+    remove("trace_bad.json");
+    printf("round trip ok\n");
+}
+
+static void TestWrap() {
+    // 新线程按新的容量分配缓冲, 写满后只保留最新的记录
+    Lcc::Trace::SetCapacity(100);
+    std::thread worker([]() {
+        Lcc::Trace::SetThreadName("wrap");
+        for (unsigned int n = 0; n < 1000; ++n) {
+            Lcc::Trace::Emit(Lcc::Trace::Stage::FrameRead, 3, n);
+        }
+    });
+    worker.join();
+    Lcc::Trace::SetCapacity(0x10000);
+    CHECK(Lcc::Trace::Dump(kBinary) == 0);
+    CHECK(Lcc::Trace::ConvertToJson(kBinary, kJson) == 0);
+    const std::string json = ReadFile(kJson);
+    // 100向上取整为128
+    CHECK(Count(json, "\"name\":\"FrameRead\"") == 128);
+    CHECK(json.find("\"bytes\":999,") != std::string::npos);
+    CHECK(json.find("\"bytes\":871,") == std::string::npos);
+    CHECK(json.find("\"bytes\":872,") != std::string::npos);
+    printf("wrap ok\n");
+}
+
+static void BenchEmit() {
+    uint64_t best = ~0ULL;
+    for (int round = 0; round < 5; ++round) {
+        const uint64_t begin = uv_hrtime();
+        for (unsigned int n = 0; n < kEvents; ++n) {
+            Lcc::Trace::Emit(Lcc::Trace::Stage::StreamRead, n, n);
+        }
+        const uint64_t cost = uv_hrtime() - begin;
+        if (cost < best) {
+            best = cost;
+        }
+    }
+    printf("emit: %.2f ns/event\n", static_cast<double>(best) / kEvents);
+}
+
+int main(int argc, char *argv[]) {
+    TestRoundTrip();
+    TestWrap();
+    BenchEmit();
+    remove(kBinary);
+    remove(kJson);
+    return _failed ? 1 : 0;
+}
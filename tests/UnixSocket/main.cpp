@@ -0,0 +1,205 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <uv.h>
+#include <network/TcpClient.h>
+#include <network/TcpServer.h>
+#include <network/plugin/FramePlugin.h>
+#include <network/plugin/WebSocketPlugin.h>
+
+static unsigned int _failed = 0;
+
+#define CHECK(expr) do { if (!(expr)) { ++_failed; printf("check fail: %s (line %d)\n", #expr, __LINE__); } } while (0)
+
+class EchoServer : public Lcc::TcpServer, public Lcc::ServerImplement {
+public:
+    explicit EchoServer(uv_loop_t *loop) : TcpServer(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    // 按TCP初始化监听句柄, 用于检查类型不符
+    bool _forceTcp = false;
+    int _listen = 0;
+    int _sessions = 0;
+    bool _shutdown = false;
+
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        if (_forceTcp) {
+            return uv_tcp_init(_loop, &handle.tcpHandle) == 0;
+        }
+        return handle.Init(_loop) == 0;
+    }
+
+    void IServerListenReport(bool listened, int err, const char *errMsg) override {
+        _listen = listened ? 1 : err;
+    }
+
+    void IServerShutdown() override {
+        _shutdown = true;
+    }
+
+    void IServerSessionOpen(unsigned int session) override {
+        ++_sessions;
+    }
+
+    void IServerSessionReceive(unsigned int session, const char *buf, unsigned int size) override {
+        SessionWrite(session, buf, size);
+    }
+
+    void IServerSessionBeforeClose(unsigned int session, int err, const char *errMsg) override {
+    }
+
+    void IServerSessionAfterClose(unsigned int session) override {
+        --_sessions;
+    }
+};
+
+class Client : public Lcc::TcpClient, public Lcc::ClientImplement {
+public:
+    explicit Client(uv_loop_t *loop) : TcpClient(this), _loop(loop) {
+    }
+
+    uv_loop_t *_loop;
+    int _connected = 0;
+    bool _disconnected = false;
+    std::string _error;
+    std::vector<std::string> _received;
+
+    bool IClientInit(Lcc::StreamHandle &handle) override {
+        handle.tcpSession = 1;
+        return handle.Init(_loop) == 0;
+    }
+
+    void IClientReport(bool connected, const char *err) override {
+        _connected = connected ? 1 : -1;
+        _error = err ? err : "";
+    }
+
+    void IClientReceive(const char *buf, unsigned int size) override {
+        _received.emplace_back(buf, size);
+    }
+
+    void IClientBeforeDisconnect(int err, const char *errMsg) override {
+    }
+
+    void IClientAfterDisconnect() override {
+        _disconnected = true;
+    }
+};
+
+static bool RunUntil(uv_loop_t *loop, bool (*done)(void *), void *arg, uint64_t timeout = 5000) {
+    const uint64_t deadline = uv_now(loop) + timeout;
+    while (!done(arg)) {
+        if (uv_now(loop) > deadline) {
+            return false;
+        }
+        uv_run(loop, UV_RUN_ONCE);
+    }
+    return true;
+}
+
+static bool Listen(uv_loop_t *loop, EchoServer &server, const std::string &url) {
+    server.Listen(url.c_str());
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_listen != 0; }, &server);
+    return server._listen == 1;
+}
+
+static void CloseServer(uv_loop_t *loop, EchoServer &server) {
+    RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_sessions == 0; }, &server);
+    server.Shutdown();
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_shutdown; }, &server));
+}
+
+/**
+ * 连接后发送若干条消息, 检查逐条回显后关闭
+ */
+static void EchoMessages(uv_loop_t *loop, Client &client, const std::string &url) {
+    client.Connect(url.c_str());
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_connected != 0; }, &client));
+    CHECK(client._connected == 1);
+    const char *messages[] = {"hello", "unix", "socket"};
+    for (auto message: messages) {
+        client.Write(message, static_cast<unsigned int>(strlen(message)));
+    }
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_received.size() >= 3; }, &client));
+    CHECK(client._received.size() == 3);
+    for (size_t n = 0; n < client._received.size() && n < 3; ++n) {
+        CHECK(client._received[n] == messages[n]);
+    }
+    client.Shutdown();
+    CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_disconnected; }, &client));
+}
+
+int main(int argc, char *argv[]) {
+    // 对端关闭后写入管道会触发SIGPIPE(TCP同理), 与压测工具一样由进程忽略
+    signal(SIGPIPE, SIG_IGN);
+    uv_loop_t *loop = uv_default_loop();
+    const std::string path = "/tmp/lcc-test-" + std::to_string(getpid()) + ".sock";
+    const std::string url = "unix://" + path;
+
+    // 分帧插件: 两端按帧收发
+    {
+        EchoServer server(loop);
+        auto frame = new Lcc::FramePluginCreator;
+        frame->Initialize(Lcc::FrameHeader::Varint, 0x10000);
+        server.Enable(frame);
+        CHECK(Listen(loop, server, url));
+        CHECK(access(path.c_str(), F_OK) == 0);
+        CHECK(server.GetListenAddress().protocol == Lcc::Utils::HostProtocol::Unix);
+        Client client(loop);
+        frame = new Lcc::FramePluginCreator;
+        frame->Initialize(Lcc::FrameHeader::Varint, 0x10000);
+        client.Enable(frame);
+        EchoMessages(loop, client, url);
+        CloseServer(loop, server);
+        // 关闭监听时删除套接字文件
+        CHECK(access(path.c_str(), F_OK) != 0);
+        printf("frame over unix ok\n");
+    }
+    // WebSocket插件: 握手与消息帧同样经过管道
+    {
+        EchoServer server(loop);
+        auto websocket = new Lcc::WebSocketPluginCreator;
+        websocket->InitializeServerMode(Lcc::WebSocketOpcode::Binary);
+        server.Enable(websocket);
+        CHECK(Listen(loop, server, url));
+        Client client(loop);
+        websocket = new Lcc::WebSocketPluginCreator;
+        websocket->InitializeClientMode(Lcc::WebSocketOpcode::Binary, "localhost");
+        client.Enable(websocket);
+        EchoMessages(loop, client, url);
+        CloseServer(loop, server);
+        printf("websocket over unix ok\n");
+    }
+    // 连接不存在的路径
+    {
+        Client client(loop);
+        client.Connect(url.c_str());
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->_connected != 0; }, &client));
+        CHECK(client._connected == -1 && client._error == uv_strerror(UV_ENOENT));
+        RunUntil(loop, [](void *arg) { return static_cast<Client *>(arg)->GetSession() == 0; }, &client);
+    }
+    // 监听句柄未按管道初始化
+    {
+        EchoServer server(loop);
+        server._forceTcp = true;
+        CHECK(!Listen(loop, server, url));
+        CHECK(server._listen == UV_EINVAL);
+        CHECK(RunUntil(loop, [](void *arg) { return static_cast<EchoServer *>(arg)->_shutdown; }, &server));
+    }
+
+    uv_run(loop, UV_RUN_DEFAULT);
+    CHECK(uv_loop_close(loop) == 0);
+    if (_failed) {
+        printf("unix socket fail %u\n", _failed);
+        return 1;
+    }
+    printf("unix socket ok\n");
+    return 0;
+}
@@ -12,8 +12,8 @@ public:
     explicit WebSocketServer() : Lcc::TcpServer(this) {
     }
 
-    bool IServerInit(uv_tcp_t *handle) override {
-        uv_tcp_init(g_loop, handle);
+    bool IServerInit(Lcc::StreamHandle &handle) override {
+        handle.Init(g_loop);
         return true;
     }
 
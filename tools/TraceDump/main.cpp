@@ -0,0 +1,23 @@
+//
+// Created by liao on 2026/10/19.
+//
+#include <cstdio>
+#include <uv.h>
+#include <trace/Trace.h>
+
+/**
+ * 离线转换跟踪文件: TraceDump <trace.bin> <trace.json>
+ * 输出可直接拖入chrome://tracing或ui.perfetto.dev
+ */
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <trace.bin> <trace.json>\n", argv[0]);
+        return 2;
+    }
+    const int err = Lcc::Trace::ConvertToJson(argv[1], argv[2]);
+    if (err != 0) {
+        fprintf(stderr, "convert %s failed: %s\n", argv[1], uv_strerror(err));
+        return 1;
+    }
+    return 0;
+}